@@ -68,10 +68,11 @@
     #endif
 
 #else       /*LV_MEM_CUSTOM*/
-    #define LV_MEM_CUSTOM_INCLUDE <esp_heap_caps.h>
-    #define LV_MEM_CUSTOM_ALLOC(size)          heap_caps_malloc_prefer((size), 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
-    #define LV_MEM_CUSTOM_FREE(ptr)            heap_caps_free((ptr))
-    #define LV_MEM_CUSTOM_REALLOC(ptr, size)   heap_caps_realloc_prefer((ptr), (size), 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+    /*Size-class slabs for small blocks (internal RAM first), PSRAM-first heap for the rest*/
+    #define LV_MEM_CUSTOM_INCLUDE "lvgl_mem_pool.h"
+    #define LV_MEM_CUSTOM_ALLOC(size)          lvgl_mem_pool_alloc((size))
+    #define LV_MEM_CUSTOM_FREE(ptr)            lvgl_mem_pool_free((ptr))
+    #define LV_MEM_CUSTOM_REALLOC(ptr, size)   lvgl_mem_pool_realloc((ptr), (size))
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
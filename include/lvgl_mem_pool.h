@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+// C entry points of the LVGL allocator (src/ui/LvglMemPool.cpp), for lv_conf.h and the
+// generated screen runtime.
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *lvgl_mem_pool_alloc(size_t size);
+void *lvgl_mem_pool_realloc(void *ptr, size_t size);
+void lvgl_mem_pool_free(void *ptr);
+
+// Objects created between begin and end are kept in the screen's own slabs; close releases
+// those slabs once the screen's delete has emptied them.
+void lvgl_mem_pool_begin_screen(int screen_id);
+void lvgl_mem_pool_end_screen(void);
+void lvgl_mem_pool_close_screen(int screen_id);
+
+#ifdef __cplusplus
+}
+#endif
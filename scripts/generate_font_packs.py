@@ -0,0 +1,250 @@
+"""Pack the CJK UI fonts into LittleFS font files (data/fonts/*.bin).
+
+The source of truth stays the lv_font_conv output in src/ui/ui_font_noto_sans_sc_reg_*.c; the
+firmware no longer links those files (see build_src_filter) and draws the glyphs through
+src/ui/UiPackedFonts.cpp instead. Only glyphs that can actually be shown are kept: printable
+ASCII (readings, units, network names), every character of the UiStrings tables of the
+languages the font is used for, and the non-ASCII characters of string literals in src/ui.
+Each glyph records which languages' tables use it, so the firmware can preload one language's
+set when it is selected.
+
+The header carries a hash of the glyph table, and the same hashes are written to
+src/ui/generated/UiFontPackHashes.inc for the firmware built alongside, so a pack made for
+another build's strings is reported stale (and refused by the web upload) instead of quietly
+drawing a different glyph set.
+
+Layout (little endian), read by src/ui/UiFontPack.cpp:
+  header     28 bytes: magic "AFNT", version, glyph count, line height, base line,
+             underline position/thickness, bpp, kern scale, kern class counts, bitmap bytes,
+             glyph hash (32-bit FNV-1a of the glyph table)
+  glyphs     20 bytes each, sorted by code point
+  kerning    left class count x right class count int8 values
+  bitmaps    raw lv_font_fmt_txt bitmaps (plain format)
+"""
+
+import re
+import struct
+from pathlib import Path
+
+Import("env")
+
+PROJECT_DIR = Path(env.subst("$PROJECT_DIR"))
+UI_DIR = PROJECT_DIR / "src" / "ui"
+STRINGS_DIR = UI_DIR / "strings"
+OUT_DIR = PROJECT_DIR / "data" / "fonts"
+OUT_INC = UI_DIR / "generated" / "UiFontPackHashes.inc"
+
+# Generated font, pack file, languages whose text it draws, hash constant in OUT_INC.
+FONTS = (
+    ("ui_font_noto_sans_sc_reg_14.c", "noto_sans_sc_14.bin", ("zh",), "kNotoSansSc14GlyphHash"),
+    ("ui_font_noto_sans_sc_reg_18.c", "noto_sans_sc_18.bin", ("zh",), "kNotoSansSc18GlyphHash"),
+)
+
+# Bit per Config::Language (src/config/AppConfig.h).
+LANGUAGE_TABLES = (
+    ("en", 0),
+    ("de", 1),
+    ("es", 2),
+    ("fr", 3),
+    ("it", 4),
+    ("ptbr", 5),
+    ("nl", 6),
+    ("zh", 7),
+)
+
+MAGIC = b"AFNT"
+VERSION = 2
+HEADER = struct.Struct("<4sHHhhbbBBHBBII")
+GLYPH = struct.Struct("<IIHHBBbbBBBx")
+
+STRING_LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+COMMENT = re.compile(r"/\*.*?\*/", re.S)
+
+
+def fnv1a32(data: bytes) -> int:
+    value = 0x811C9DC5
+    for byte in data:
+        value = ((value ^ byte) * 0x01000193) & 0xFFFFFFFF
+    return value
+
+
+def decode_literal(body: str) -> str:
+    out = bytearray()
+    i = 0
+    while i < len(body):
+        ch = body[i]
+        if ch != "\\":
+            out += ch.encode("utf-8")
+            i += 1
+            continue
+        nxt = body[i + 1]
+        if nxt == "x":
+            j = i + 2
+            while j < len(body) and body[j] in "0123456789abcdefABCDEF":
+                j += 1
+            out.append(int(body[i + 2:j], 16) & 0xFF)
+            i = j
+            continue
+        out += {"n": b"\n", "t": b"\t", "\\": b"\\", '"': b'"', "'": b"'"}.get(nxt, nxt.encode("utf-8"))
+        i += 2
+    return out.decode("utf-8", errors="ignore")
+
+
+def literal_chars(path: Path) -> set:
+    text = path.read_text(encoding="utf-8-sig")
+    chars = set()
+    for match in STRING_LITERAL.finditer(text):
+        chars.update(decode_literal(match.group(1)))
+    return chars
+
+
+def array_body(source: str, name: str) -> str:
+    match = re.search(r"\b" + re.escape(name) + r"\[\]\s*=\s*\{(.*?)\n\};", source, re.S)
+    if not match:
+        raise RuntimeError(f"font packs: {name}[] not found")
+    return COMMENT.sub("", match.group(1))
+
+
+def int_list(body: str) -> list:
+    return [int(tok, 0) for tok in re.findall(r"-?(?:0x[0-9a-fA-F]+|\d+)", body)]
+
+
+def field(source: str, name: str) -> int:
+    match = re.search(r"\." + re.escape(name) + r"\s*=\s*(-?\d+)", source)
+    if not match:
+        raise RuntimeError(f"font packs: .{name} not found")
+    return int(match.group(1))
+
+
+def parse_font(path: Path) -> dict:
+    source = path.read_text(encoding="utf-8")
+    bitmap = bytes(int_list(array_body(source, "glyph_bitmap")))
+    dsc = [
+        tuple(int(v) for v in m)
+        for m in re.findall(
+            r"\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), \.box_h = (\d+), "
+            r"\.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}",
+            source,
+        )
+    ]
+
+    codepoints = {}
+    cmap_block = re.search(r"cmaps\[\]\s*=\s*\{(.*?)\n\};", source, re.S).group(1)
+    for cmap in re.finditer(
+        r"\.range_start = (\d+), \.range_length = (\d+), \.glyph_id_start = (\d+),\s*"
+        r"\.unicode_list = (\w+), \.glyph_id_ofs_list = (\w+), \.list_length = (\d+), \.type = (\w+)",
+        cmap_block,
+    ):
+        start, length, gid_start = int(cmap.group(1)), int(cmap.group(2)), int(cmap.group(3))
+        kind = cmap.group(7)
+        if kind == "LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY":
+            for i in range(length):
+                codepoints[start + i] = gid_start + i
+        elif kind == "LV_FONT_FMT_TXT_CMAP_SPARSE_TINY":
+            for i, ofs in enumerate(int_list(array_body(source, cmap.group(4)))):
+                codepoints[start + ofs] = gid_start + i
+        else:
+            raise RuntimeError(f"font packs: unsupported cmap {kind} in {path.name}")
+
+    if field(source, "bitmap_format") != 0:
+        raise RuntimeError(f"font packs: {path.name} uses a compressed bitmap format")
+
+    return {
+        "bitmap": bitmap,
+        "dsc": dsc,
+        "codepoints": codepoints,
+        "left": int_list(array_body(source, "kern_left_class_mapping")),
+        "right": int_list(array_body(source, "kern_right_class_mapping")),
+        "kern": int_list(array_body(source, "kern_class_values")),
+        "left_cnt": field(source, "left_class_cnt"),
+        "right_cnt": field(source, "right_class_cnt"),
+        "line_height": field(source, "line_height"),
+        "base_line": field(source, "base_line"),
+        "underline_position": field(source, "underline_position"),
+        "underline_thickness": field(source, "underline_thickness"),
+        "bpp": field(source, "bpp"),
+        "kern_scale": field(source, "kern_scale"),
+    }
+
+
+def glyph_languages() -> dict:
+    languages = {}
+    for suffix, bit in LANGUAGE_TABLES:
+        for ch in literal_chars(STRINGS_DIR / f"UiStrings.{suffix}.inc"):
+            languages[ord(ch)] = languages.get(ord(ch), 0) | (1 << bit)
+    return languages
+
+
+def wanted_codepoints(languages: dict, served: tuple) -> set:
+    mask = 0
+    for suffix, bit in LANGUAGE_TABLES:
+        if suffix in served:
+            mask |= 1 << bit
+    wanted = set(range(32, 127)) | {cp for cp, used_by in languages.items() if used_by & mask}
+    for path in sorted(UI_DIR.glob("*.cpp")):
+        wanted.update(ord(ch) for ch in literal_chars(path) if ord(ch) > 126)
+    return wanted
+
+
+def build_pack(font: dict, wanted: set, languages: dict) -> tuple:
+    dsc = font["dsc"]
+    bitmap = font["bitmap"]
+    glyphs = []
+    bitmaps = bytearray()
+    missing = sorted(cp for cp in wanted if cp not in font["codepoints"] and cp >= 32)
+    for cp in sorted(cp for cp in font["codepoints"] if cp in wanted):
+        gid = font["codepoints"][cp]
+        index, adv_w, box_w, box_h, ofs_x, ofs_y = dsc[gid]
+        end = dsc[gid + 1][0] if gid + 1 < len(dsc) else len(bitmap)
+        data = bitmap[index:end] if box_w and box_h else b""
+        left = font["left"][gid] if gid < len(font["left"]) else 0
+        right = font["right"][gid] if gid < len(font["right"]) else 0
+        glyphs.append(GLYPH.pack(cp, len(bitmaps), len(data), adv_w, box_w, box_h, ofs_x, ofs_y,
+                                 left, right, languages.get(cp, 0)))
+        bitmaps += data
+
+    kern = bytes(v & 0xFF for v in font["kern"])
+    if len(kern) != font["left_cnt"] * font["right_cnt"]:
+        raise RuntimeError("font packs: kern class table size mismatch")
+    table = b"".join(glyphs)
+    glyph_hash = fnv1a32(table)
+    header = HEADER.pack(MAGIC, VERSION, len(glyphs), font["line_height"], font["base_line"],
+                         font["underline_position"], font["underline_thickness"], font["bpp"], 0,
+                         font["kern_scale"], font["left_cnt"], font["right_cnt"], len(bitmaps),
+                         glyph_hash)
+    return header + table + kern + bytes(bitmaps), len(glyphs), missing, glyph_hash
+
+
+def render_hashes(hashes: list) -> bytes:
+    lines = ["// Auto-generated by scripts/generate_font_packs.py. Do not edit manually.", ""]
+    for name, value in hashes:
+        lines.append(f"constexpr uint32_t {name} = 0x{value:08X}u;")
+    return ("\n".join(lines) + "\n").encode("utf-8")
+
+
+def write_if_changed(path: Path, payload: bytes) -> bool:
+    if path.exists() and path.read_bytes() == payload:
+        return False
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_bytes(payload)
+    return True
+
+
+def main() -> None:
+    languages = glyph_languages()
+    hashes = []
+    for source_name, out_name, served, hash_name in FONTS:
+        wanted = wanted_codepoints(languages, served)
+        font = parse_font(UI_DIR / source_name)
+        payload, count, missing, glyph_hash = build_pack(font, wanted, languages)
+        hashes.append((hash_name, glyph_hash))
+        changed = write_if_changed(OUT_DIR / out_name, payload)
+        print(f"[font_packs] {out_name}: {count} of {len(font['codepoints'])} glyphs, "
+              f"{len(payload)} bytes, glyph hash {glyph_hash:08x}{' (updated)' if changed else ''}")
+        if missing:
+            sample = "".join(chr(cp) for cp in missing[:16])
+            print(f"[font_packs] {out_name}: {len(missing)} characters used by the UI have no glyph: {sample}")
+    write_if_changed(OUT_INC, render_hashes(hashes))
+
+
+main()
@@ -33,8 +33,10 @@ function Invoke-PioTest {
 }
 
 Invoke-PioTest @("test", "-e", "native_test")
+Invoke-PioTest @("test", "-e", "native_mqtt", "-f", "test_native_mqtt")
 Invoke-PioTest @("test", "-e", "native_test_sfa30_driver", "-f", "test_sfa30_driver")
 Invoke-PioTest @("test", "-e", "native_test_sfa40_driver", "-f", "test_sfa40_driver")
 Invoke-PioTest @("test", "-e", "native_test_dfr_optional_gas_driver", "-f", "test_dfr_optional_gas_driver")
+Invoke-PioTest @("test", "-e", "native_sensor_bench", "-f", "test_sensor_bench")
 
 exit 0
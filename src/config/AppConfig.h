@@ -90,6 +90,19 @@ namespace Config {
         }
     }
 
+    // JSON on <base>/state is always published (Home Assistant discovery points at it);
+    // JsonCbor additionally publishes the compact document on <base>/state/cbor.
+    enum class MqttStateEncoding : uint8_t {
+        Json = 0,
+        JsonCbor = 1,
+    };
+
+    inline MqttStateEncoding clampMqttStateEncoding(int value) {
+        return value == static_cast<int>(MqttStateEncoding::JsonCbor)
+                   ? MqttStateEncoding::JsonCbor
+                   : MqttStateEncoding::Json;
+    }
+
     constexpr uint8_t SEN66_ADDR = 0x6B;
     constexpr uint16_t SEN66_CMD_START = 0x0021;
     constexpr uint16_t SEN66_CMD_STOP = 0x0104;
@@ -382,6 +395,10 @@ namespace Config {
     constexpr uint32_t MQTT_RETRY_MEDIUM_MS = 2UL * 60UL * 1000UL;
     constexpr uint32_t MQTT_RETRY_LONG_MS = 10UL * 60UL * 1000UL;
     constexpr uint16_t MQTT_BUFFER_SIZE = 1024;
+    constexpr uint16_t MQTT_STATE_CBOR_BUFFER_SIZE = 512;
+    // Publish pacing: burst of MQTT_PUBLISH_BUCKET_CAPACITY messages, then one per refill step.
+    constexpr uint16_t MQTT_PUBLISH_BUCKET_CAPACITY = 8;
+    constexpr uint32_t MQTT_PUBLISH_TOKEN_REFILL_MS = 50;
     constexpr uint16_t MQTT_DEFAULT_PORT = Secrets::MQTT_PORT;
     constexpr const char *MQTT_DEFAULT_HOST = Secrets::MQTT_HOST;
     constexpr const char *MQTT_DEFAULT_USER = Secrets::MQTT_USER;
@@ -419,6 +436,72 @@ namespace Config {
     constexpr uint32_t BMP3XX_RECOVER_MS = 30UL * 1000UL;
     constexpr uint32_t BMP3XX_RECOVER_COOLDOWN_MS = 60UL * 1000UL;
     constexpr float BMP3XX_PRESSURE_ALPHA = 0.12f;
+    // Adaptive sensor polling: each sensor starts at its *_POLL_MS and doubles the interval
+    // after ADAPTIVE_POLL_STABLE_SAMPLES readings inside the noise band, up to *_POLL_SLOW_MS.
+    // Slow limits stay well under the stale thresholds so a backed-off sensor never expires.
+    constexpr uint8_t ADAPTIVE_POLL_STABLE_SAMPLES = 5;
+    constexpr uint32_t SEN66_POLL_SLOW_MS = 4000;
+    constexpr uint32_t SFA40_POLL_SLOW_MS = 4200;
+    constexpr uint32_t SFA3X_POLL_SLOW_MS = 6000;
+    constexpr uint32_t DFR_GAS_POLL_SLOW_MS = 9000;
+    constexpr uint32_t PRESSURE_POLL_SLOW_MS = 20000;
+    // A web client polling /api/state holds the fast rate this long after its last request.
+    constexpr uint32_t SENSOR_POLL_WEB_LEASE_MS = 15000;
+    // Noise bands: a reading further than this from the last reference snaps back to fast.
+    constexpr float ADAPTIVE_POLL_PM_BAND_UGM3 = 1.0f;
+    constexpr float ADAPTIVE_POLL_CO2_BAND_PPM = 15.0f;
+    constexpr float ADAPTIVE_POLL_INDEX_BAND = 3.0f;
+    constexpr float ADAPTIVE_POLL_TEMP_BAND_C = 0.15f;
+    constexpr float ADAPTIVE_POLL_HUM_BAND = 0.8f;
+    constexpr float ADAPTIVE_POLL_HCHO_BAND_PPB = 3.0f;
+    constexpr float ADAPTIVE_POLL_GAS_BAND_PPM = 0.5f;
+    constexpr float ADAPTIVE_POLL_PRESSURE_BAND_HPA = 0.2f;
+    static_assert(SEN66_POLL_SLOW_MS < SEN66_STALE_MS, "SEN66 slow poll must beat stale timeout");
+    static_assert(SFA40_POLL_SLOW_MS < SFA3X_STALE_MS, "SFA40 slow poll must beat stale timeout");
+    static_assert(SFA3X_POLL_SLOW_MS < SFA3X_STALE_MS, "SFA30 slow poll must beat stale timeout");
+    static_assert(DFR_GAS_POLL_SLOW_MS < DFR_GAS_STALE_MS, "DFR slow poll must beat stale timeout");
+    static_assert(PRESSURE_POLL_SLOW_MS < DPS310_STALE_MS &&
+                      PRESSURE_POLL_SLOW_MS < BMP580_STALE_MS &&
+                      PRESSURE_POLL_SLOW_MS < BMP3XX_STALE_MS,
+                  "pressure slow poll must beat stale timeout");
+    // Per-metric filter chain SensorManager runs on every fresh sample: median-of-N spike
+    // rejection, then an optional 1-D Kalman filter, then an EMA. If the median output moves
+    // more than reset_step away from the filtered value, the chain restarts at the new value
+    // so real steps (window opened, fan on) are not smeared out.
+    struct MetricFilterConfig {
+        uint8_t median_window;  // odd, 1 = off, at most METRIC_FILTER_MAX_MEDIAN
+        uint16_t ema_alpha_q15; // weight of the new sample, 0 = off
+        float kalman_q;         // process noise variance per sample, 0 = off
+        float kalman_r;         // measurement noise variance
+        float reset_step;       // 0 = never restart
+    };
+    constexpr uint8_t METRIC_FILTER_MAX_MEDIAN = 5;
+    constexpr MetricFilterConfig METRIC_FILTER_OFF = {1, 0, 0.0f, 0.0f, 0.0f};
+    constexpr MetricFilterConfig METRIC_FILTER_CO2 = {3, 13107, 0.0f, 0.0f, 150.0f};
+    constexpr MetricFilterConfig METRIC_FILTER_PM_MASS = {3, 9830, 0.0f, 0.0f, 25.0f};
+    constexpr MetricFilterConfig METRIC_FILTER_PM_NUMBER = {3, 9830, 0.0f, 0.0f, 50.0f};
+    constexpr MetricFilterConfig METRIC_FILTER_TEMP = {1, 0, 0.0004f, 0.01f, 1.0f};
+    constexpr MetricFilterConfig METRIC_FILTER_HUM = {1, 0, 0.01f, 0.25f, 5.0f};
+    constexpr MetricFilterConfig METRIC_FILTER_HCHO = {3, 9830, 0.0f, 0.0f, 20.0f};
+    constexpr MetricFilterConfig METRIC_FILTER_GAS = {3, 9830, 0.0f, 0.0f, 5.0f};
+    // VOC/NOx indices come out of Sensirion's gas index algorithm and pressure out of the
+    // driver's own EMA, so both only get the raw/filtered bookkeeping.
+    constexpr MetricFilterConfig METRIC_FILTER_INDEX = METRIC_FILTER_OFF;
+    constexpr MetricFilterConfig METRIC_FILTER_PRESSURE = METRIC_FILTER_OFF;
+    // Multi-source fusion (see FusedQuantity). Sigmas are the expected noise of a healthy
+    // sample; secondary temperature sources sit next to warm parts, so they only count after
+    // their offset to the SEN66 has been learned.
+    constexpr float FUSION_BIAS_ALPHA = 0.05f;
+    constexpr float FUSION_VARIANCE_ALPHA = 0.1f;
+    constexpr uint16_t FUSION_MAX_FAULTS = 8;
+    constexpr float FUSION_SEN66_TEMP_SIGMA_C = 0.1f;
+    constexpr float FUSION_PRESSURE_CHIP_TEMP_SIGMA_C = 0.3f;
+    constexpr float FUSION_RTC_TEMP_SIGMA_C = 0.5f;
+    constexpr float FUSION_BMP580_SIGMA_HPA = 0.05f;
+    constexpr float FUSION_BMP3XX_SIGMA_HPA = 0.08f;
+    constexpr float FUSION_DPS310_SIGMA_HPA = 0.06f;
+    // TimeManager reads the DS3231 temperature every RTC_STATUS_POLL_MS.
+    constexpr uint32_t FUSION_RTC_TEMP_STALE_MS = 2 * RTC_STATUS_POLL_MS + 15000;
     constexpr uint32_t DAC_HEALTH_CHECK_MS = 5000;
     constexpr uint8_t DAC_HEALTH_FAIL_THRESHOLD = 3;
     constexpr uint32_t DAC_RECOVER_COOLDOWN_MS = 30UL * 1000UL;
@@ -480,6 +563,7 @@ namespace Config {
         bool mqtt_user_enabled = Secrets::MQTT_USER_ENABLED;
         bool mqtt_discovery = Secrets::MQTT_DISCOVERY;
         bool mqtt_anonymous = Secrets::MQTT_ANONYMOUS;
+        MqttStateEncoding mqtt_state_encoding = MqttStateEncoding::Json;
 
         float temp_offset = 0.0f;
         float hum_offset = 0.0f;
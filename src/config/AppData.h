@@ -2,6 +2,23 @@
 #include <Arduino.h>
 #include <lvgl.h>
 
+// Acquisition sources feeding SensorData; every metric is stamped by the source it came from.
+enum SensorSource : uint8_t {
+    SENSOR_SOURCE_SEN66 = 0, // temperature, humidity, PM, CO2, VOC, NOx
+    SENSOR_SOURCE_HCHO,
+    SENSOR_SOURCE_CO,
+    SENSOR_SOURCE_OPTIONAL_GAS,
+    SENSOR_SOURCE_PRESSURE,
+    SENSOR_SOURCE_COUNT
+};
+
+// When the acquisition task picked up a source's latest sample: monotonic microseconds since
+// boot, plus wall-clock seconds if the clock was valid at that moment (0 otherwise).
+struct SampleStamp {
+    uint64_t ready_us = 0;
+    uint32_t epoch = 0;
+};
+
 struct SensorData {
     float temperature = 0.0f;
     float humidity = 0.0f;
@@ -45,6 +62,7 @@ struct SensorData {
     bool pressure_valid = false;
     bool pressure_delta_3h_valid = false;
     bool pressure_delta_24h_valid = false;
+    SampleStamp stamps[SENSOR_SOURCE_COUNT] = {};
 };
 
 struct AirQuality {
@@ -10,14 +10,19 @@
 #include <esp_display_panel.hpp>
 #include <esp_log.h>
 #include <esp_system.h>
+#include <memory>
+#include <new>
 
 #include "config/AppConfig.h"
+#include "core/BootGraph.h"
 #include "core/BootPolicy.h"
+#include "core/BootProfiler.h"
 #include "core/BootHelpers.h"
 #include "core/BootState.h"
 #include "core/BoardInit.h"
 #include "core/InitConfig.h"
 #include "core/Logger.h"
+#include "core/RetainedLog.h"
 #include "lvgl_v8_port.h"
 #include "ui/UiStrings.h"
 
@@ -40,6 +45,7 @@ struct DeferredWifiRuntimeState {
 };
 
 DeferredWifiRuntimeState g_deferred_wifi_runtime;
+uint32_t g_boot_trace_saved_revision = 0;
 
 const char *resetReasonName(esp_reset_reason_t reason) {
     switch (reason) {
@@ -62,6 +68,16 @@ const char *resetReasonName(esp_reset_reason_t reason) {
     }
 }
 
+void restore_boot_traces(StorageManager &storage) {
+    std::unique_ptr<BootProfiler::HistoryBlob> blob(new (std::nothrow) BootProfiler::HistoryBlob());
+    if (!blob || !storage.loadBlob(StorageManager::kBootTracePath, blob.get(), sizeof(*blob))) {
+        return;
+    }
+    if (!BootProfiler::instance().restore(*blob)) {
+        LOGW("Main", "stored boot traces unreadable, starting over");
+    }
+}
+
 void mqtt_sync_with_wifi_cb() {
     if (g_mqtt_manager) {
         g_mqtt_manager->syncWithWifi();
@@ -96,6 +112,8 @@ StorageManager::BootAction AppInit::handleBootState() {
                           boot_count,
                           safe_boot_stage,
                           Config::SAFE_BOOT_MAX_REBOOTS);
+    RetainedLog &retained = RetainedLog::instance();
+    retained.begin(reset_reason);
     LOGI("Main", "Reset reason: %d (%s), boot count: %u",
          reset_reason,
          resetReasonName(reset_reason),
@@ -103,6 +121,12 @@ StorageManager::BootAction AppInit::handleBootState() {
     if (boot_ui_auto_recovery_reboot) {
         LOGW("Main", "Previous boot ended with UI auto-recovery reboot");
     }
+    if (const RetainedLog::Previous *previous = retained.previous()) {
+        LOGI("Main", "previous boot left %u log lines and %u health samples",
+             static_cast<unsigned>(previous->line_count),
+             static_cast<unsigned>(previous->telemetry_count));
+        retained.queuePreviousEvents(millis());
+    }
     if (boot_action == StorageManager::BootAction::SafeRollback) {
         LOGW("Main", "SAFE BOOT: restoring last known good config");
     } else if (boot_action == StorageManager::BootAction::SafeFactoryReset) {
@@ -111,20 +135,41 @@ StorageManager::BootAction AppInit::handleBootState() {
     return boot_action;
 }
 
-bool AppInit::recoverI2cBus(gpio_num_t sda, gpio_num_t scl) {
-    boot_i2c_recovered = BootHelpers::recoverI2CBus(sda, scl);
+namespace {
+
+struct BootRun {
+    AppInit::Context &ctx;
+    StorageManager::BootAction boot_action;
+    esp_panel::board::Board *board;
+    bool lvgl_ready;
+};
+
+void boot_storage(void *arg) {
+    BootRun &run = *static_cast<BootRun *>(arg);
+    run.ctx.storage.begin(run.boot_action);
+    restore_boot_traces(run.ctx.storage);
+}
+
+void boot_i2c_recover(void *) {
+    boot_i2c_recovered = BootHelpers::recoverI2CBus(static_cast<gpio_num_t>(Config::I2C_SDA_PIN),
+                                                    static_cast<gpio_num_t>(Config::I2C_SCL_PIN));
     if (!boot_i2c_recovered) {
         LOGW("Main", "I2C bus recovery failed");
     } else {
         LOGI("Main", "I2C bus recovered");
     }
-    return boot_i2c_recovered;
 }
 
-void AppInit::initManagersAndConfig(Context &ctx, StorageManager::BootAction boot_action) {
-    ctx.storage.begin(boot_action);
-    ctx.networkManager.begin(ctx.storage);
-    ctx.mqttManager.begin(ctx.storage, ctx.networkManager, ctx.mqttRuntimeState);
+void boot_managers(void *arg) {
+    AppInit::Context &ctx = static_cast<BootRun *>(arg)->ctx;
+    {
+        BootProfiler::Scope network_stage("network");
+        ctx.networkManager.begin(ctx.storage);
+    }
+    {
+        BootProfiler::Scope mqtt_stage("mqtt");
+        ctx.mqttManager.begin(ctx.storage, ctx.networkManager, ctx.mqttRuntimeState);
+    }
 
     g_mqtt_manager = &ctx.mqttManager;
     ctx.networkManager.attachMqttContext(
@@ -151,6 +196,7 @@ void AppInit::initManagersAndConfig(Context &ctx, StorageManager::BootAction boo
     g_wifi_state_ctx.ui_controller = &ctx.uiController;
     ctx.networkManager.setStateChangeCallback(wifi_state_change_cb, &g_wifi_state_ctx);
 
+    BootProfiler::Scope prefs_stage("prefs");
     const auto &cfg = ctx.storage.config();
     UiStrings::setLanguage(cfg.language);
     ctx.temp_offset = cfg.temp_offset;
@@ -169,9 +215,7 @@ void AppInit::initManagersAndConfig(Context &ctx, StorageManager::BootAction boo
     ctx.timeManager.updateWifiState(ctx.networkManager.isEnabled(), ctx.networkManager.isConnected());
     ctx.mqttManager.syncWithWifi();
     const FanControl::Snapshot fan_snapshot = ctx.fanControl.snapshot();
-    ctx.mqttRuntimeState.update(ctx.currentData,
-                                fan_snapshot,
-                                ctx.sensorManager.isWarmupActive(),
+    ctx.mqttRuntimeState.update(fan_snapshot,
                                 ctx.night_mode,
                                 ctx.alert_blink_enabled,
                                 ctx.backlightManager.isOn(),
@@ -180,20 +224,85 @@ void AppInit::initManagersAndConfig(Context &ctx, StorageManager::BootAction boo
     ctx.connectivityRuntime.update(ctx.networkManager, ctx.mqttManager);
 }
 
-esp_panel::board::Board *AppInit::initBoardAndPeripherals(Context &ctx) {
-    esp_panel::board::Board *board = BoardInit::initBoard();
-    if (board == nullptr) {
+void boot_board(void *arg) {
+    BootRun &run = *static_cast<BootRun *>(arg);
+    run.board = BoardInit::initBoard();
+    if (run.board == nullptr) {
         LOGE("Main", "Board unavailable, skip display/backlight/touch init");
-        return nullptr;
+        return;
     }
-    ctx.backlightManager.attachBacklight(board->getBacklight());
-    ctx.timeManager.initRtc();
-    ctx.pressureHistory.load(ctx.storage, ctx.currentData);
-    ctx.chartsHistory.load(ctx.storage);
-    ctx.uiController.apply_auto_night_now();
-
+    run.ctx.backlightManager.attachBacklight(run.board->getBacklight());
     BootHelpers::logGt911Address();
-    ctx.sensorManager.begin(ctx.storage, ctx.temp_offset, ctx.hum_offset);
+}
+
+void boot_lvgl_port(void *arg) {
+    BootRun &run = *static_cast<BootRun *>(arg);
+    if (run.board == nullptr) {
+        LOGE("Main", "Skipping LVGL/UI: board init failed");
+        return;
+    }
+    LOGI("Main", "Initializing LVGL");
+    run.lvgl_ready = lvgl_port_init(run.board->getLCD(), run.board->getTouch());
+    if (!run.lvgl_ready) {
+        LOGE("Main", "LVGL init failed");
+    }
+}
+
+// The RTC and the sensors sit on the I2C driver that the board's touch bus installs.
+void boot_rtc(void *arg) {
+    BootRun &run = *static_cast<BootRun *>(arg);
+    if (run.board != nullptr) {
+        run.ctx.timeManager.initRtc();
+    }
+}
+
+// Staleness of the stored pressure history is judged against the RTC-restored clock.
+void boot_histories(void *arg) {
+    BootRun &run = *static_cast<BootRun *>(arg);
+    if (run.board == nullptr) {
+        return;
+    }
+    {
+        BootProfiler::Scope pressure_stage("pressure_hist");
+        run.ctx.pressureHistory.load(run.ctx.storage, run.ctx.currentData);
+    }
+    BootProfiler::Scope charts_stage("charts_hist");
+    run.ctx.chartsHistory.load(run.ctx.storage);
+}
+
+void boot_sensors(void *arg) {
+    BootRun &run = *static_cast<BootRun *>(arg);
+    if (run.board != nullptr) {
+        run.ctx.sensorManager.begin(run.ctx.storage, run.ctx.temp_offset, run.ctx.hum_offset);
+    }
+}
+
+// Builds the screens and shows the boot logo; nothing here reads sensor or fan state.
+void boot_ui(void *arg) {
+    BootRun &run = *static_cast<BootRun *>(arg);
+    UiController &ui = run.ctx.uiController;
+    if (run.board == nullptr) {
+        ui.setLvglReady(false);
+        return;
+    }
+    // Decided while the UI is still detached, so begin() builds the screens in the right theme.
+    ui.apply_auto_night_now();
+    ui.setLvglReady(run.lvgl_ready);
+    if (!run.lvgl_ready) {
+        return;
+    }
+    LOGI("Main", "Creating UI");
+    ui.begin();
+    BootProfiler::instance().armFirstFrame();
+    // Keep startup diagnostics, but mute low-level runtime touch/I2C spam.
+    esp_log_level_set("lcd_panel.io.i2c", ESP_LOG_NONE);
+    esp_log_level_set("Panel", ESP_LOG_NONE);
+}
+
+// Runs on the main task once both lanes have joined.
+void bind_first_data(BootRun &run) {
+    AppInit::Context &ctx = run.ctx;
+    BootProfiler::Scope stage("bind");
     ctx.fanControl.begin(ctx.storage.config().dac_auto_mode,
                          ctx.storage.config().dac_auto_armed);
     String dac_auto_json;
@@ -206,33 +315,71 @@ esp_panel::board::Board *AppInit::initBoardAndPeripherals(Context &ctx) {
             LOGW("Main", "DAC auto config parse failed, using defaults");
         }
     }
-    ctx.webRuntimeState.update(ctx.currentData, ctx.sensorManager.isWarmupActive(), ctx.fanControl);
+    // First sample: restored pressure history; the acquisition task continues from it.
+    ctx.sensorSnapshot.publish(ctx.currentData, ctx.sensorManager.isWarmupActive());
+    ctx.webRuntimeState.update(ctx.fanControl);
     ctx.chartsRuntimeState.update(ctx.chartsHistory);
+    if (run.lvgl_ready) {
+        ctx.uiController.bindInitialData();
+    }
+}
 
-    return board;
+} // namespace
+
+esp_panel::board::Board *AppInit::initSystem(Context &ctx, StorageManager::BootAction boot_action) {
+    BootRun run{ctx, boot_action, nullptr, false};
+    using Lane = BootGraph::Lane;
+    BootGraph graph;
+    const uint8_t storage = graph.add("storage", Lane::Aux, 0, boot_storage, &run);
+    const uint8_t i2c = graph.add("i2c_recover", Lane::Main, 0, boot_i2c_recover, &run);
+    const uint8_t managers =
+        graph.add("managers", Lane::Aux, BootGraph::bit(storage), boot_managers, &run);
+    const uint8_t board = graph.add("board", Lane::Main, BootGraph::bit(i2c), boot_board, &run);
+    const uint8_t lvgl =
+        graph.add("lvgl_port", Lane::Main, BootGraph::bit(board), boot_lvgl_port, &run);
+    const uint8_t rtc = graph.add("rtc", Lane::Aux, BootGraph::bit(board) | BootGraph::bit(managers),
+                                  boot_rtc, &run);
+    graph.add("histories", Lane::Aux, BootGraph::bit(storage) | BootGraph::bit(rtc),
+              boot_histories, &run);
+    graph.add("sensors", Lane::Aux, BootGraph::bit(board) | BootGraph::bit(managers),
+              boot_sensors, &run);
+    graph.add("ui", Lane::Main,
+              BootGraph::bit(lvgl) | BootGraph::bit(managers) | BootGraph::bit(rtc), boot_ui, &run);
+    graph.run();
+
+    if (run.board != nullptr) {
+        bind_first_data(run);
+    }
+    return run.board;
 }
 
-bool AppInit::initLvglAndUi(Context &ctx, esp_panel::board::Board *board) {
-    if (board == nullptr) {
-        LOGE("Main", "Skipping LVGL/UI: board init failed");
-        ctx.uiController.setLvglReady(false);
-        return false;
+void AppInit::finishBootTrace(StorageManager &storage) {
+    BootProfiler &profiler = BootProfiler::instance();
+    profiler.finish(boot_count, static_cast<uint8_t>(boot_reset_reason));
+    BootProfiler::Summary summary;
+    profiler.summary(summary);
+    LOGI("Main", "Boot took %lu ms", static_cast<unsigned long>(summary.total_us / 1000UL));
+    pollBootTrace(storage);
+}
+
+void AppInit::pollBootTrace(StorageManager &storage) {
+    BootProfiler &profiler = BootProfiler::instance();
+    const uint32_t revision = profiler.revision();
+    if (revision == g_boot_trace_saved_revision || !storage.isMounted()) {
+        return;
     }
-    LOGI("Main", "Initializing LVGL");
-    bool lvgl_ready = lvgl_port_init(board->getLCD(), board->getTouch());
-    if (!lvgl_ready) {
-        LOGE("Main", "LVGL init failed");
+    BootProfiler::Summary summary;
+    profiler.summary(summary);
+    if (!summary.finished) {
+        return;
     }
-
-    LOGI("Main", "Creating UI");
-    ctx.uiController.setLvglReady(lvgl_ready);
-    if (lvgl_ready) {
-        ctx.uiController.begin();
-        // Keep startup diagnostics, but mute low-level runtime touch/I2C spam.
-        esp_log_level_set("lcd_panel.io.i2c", ESP_LOG_NONE);
-        esp_log_level_set("Panel", ESP_LOG_NONE);
-    }
-    return lvgl_ready;
+    std::unique_ptr<BootProfiler::HistoryBlob> blob(new (std::nothrow) BootProfiler::HistoryBlob());
+    if (!blob) {
+        return;
+    }
+    profiler.fill(*blob);
+    storage.saveBlobAsync(StorageManager::kBootTracePath, blob.get(), sizeof(*blob));
+    g_boot_trace_saved_revision = revision;
 }
 
 void AppInit::pollDeferredRuntime() {
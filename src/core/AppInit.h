@@ -6,13 +6,12 @@
 
 #pragma once
 
-#include <driver/gpio.h>
-
 #include "config/AppData.h"
 #include "core/ChartsRuntimeState.h"
 #include "core/ConnectivityRuntime.h"
 #include "core/MqttRuntimeState.h"
 #include "core/NetworkCommandQueue.h"
+#include "core/SensorSnapshot.h"
 #include "core/WebRuntimeState.h"
 #include "modules/StorageManager.h"
 #include "modules/NetworkManager.h"
@@ -55,6 +54,7 @@ struct Context {
     PressureHistory &pressureHistory;
     ChartsHistory &chartsHistory;
     UiController &uiController;
+    SensorSnapshot &sensorSnapshot;
     SensorData &currentData;
     bool &night_mode;
     bool &temp_units_c;
@@ -66,10 +66,14 @@ struct Context {
 };
 
 StorageManager::BootAction handleBootState();
-bool recoverI2cBus(gpio_num_t sda, gpio_num_t scl);
-void initManagersAndConfig(Context &ctx, StorageManager::BootAction boot_action);
-esp_panel::board::Board *initBoardAndPeripherals(Context &ctx);
-bool initLvglAndUi(Context &ctx, esp_panel::board::Board *board);
+// Storage, managers, the RTC, history restore and the sensor probes run on a core-0 helper task
+// while this task recovers the I2C bus and brings up the board, LVGL and the screens. Both lanes
+// join before the first data is bound to the UI. Returns nullptr when the board is unavailable.
+esp_panel::board::Board *initSystem(Context &ctx, StorageManager::BootAction boot_action);
+// Closes the boot trace and persists it with the previous boots' traces.
+void finishBootTrace(StorageManager &storage);
+// Saves the trace again when the first frame or first reading lands after setup().
+void pollBootTrace(StorageManager &storage);
 void pollDeferredRuntime();
 
 } // namespace AppInit
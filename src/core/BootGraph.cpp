@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/BootGraph.h"
+
+#include "core/BootProfiler.h"
+#include "core/Logger.h"
+
+namespace {
+
+#ifndef UNIT_TEST
+// Storage mount, the config decode and the sensor drivers' probe paths all run on this stack.
+constexpr uint32_t kAuxStackSize = 12288;
+constexpr UBaseType_t kAuxPriority = 1;
+constexpr BaseType_t kAuxCore = 0;
+#endif
+
+} // namespace
+
+BootGraph::BootGraph() {
+#ifndef UNIT_TEST
+    done_ = xEventGroupCreateStatic(&done_buffer_);
+#endif
+}
+
+BootGraph::~BootGraph() {
+#ifdef UNIT_TEST
+    if (aux_thread_.joinable()) {
+        aux_thread_.join();
+    }
+#else
+    if (done_) {
+        vEventGroupDelete(done_);
+    }
+#endif
+}
+
+uint8_t BootGraph::add(const char *name, Lane lane, uint32_t deps, Fn fn, void *arg) {
+    if (count_ >= kMaxNodes || fn == nullptr) {
+        LOGE("Boot", "boot graph rejected %s", name ? name : "?");
+        return kInvalid;
+    }
+    // Only earlier nodes may be waited on; that ordering is what rules out deadlocks.
+    if ((deps & ~(bit(count_) - 1UL)) != 0) {
+        LOGE("Boot", "boot graph rejected %s: depends on a later node", name ? name : "?");
+        return kInvalid;
+    }
+    Node &node = nodes_[count_];
+    node.name = name;
+    node.lane = lane;
+    node.deps = deps;
+    node.fn = fn;
+    node.arg = arg;
+    return count_++;
+}
+
+bool BootGraph::run() {
+    bool has_aux = false;
+    for (uint8_t id = 0; id < count_; ++id) {
+        has_aux = has_aux || nodes_[id].lane == Lane::Aux;
+    }
+    if (!has_aux) {
+        runLane(Lane::Main);
+        return true;
+    }
+    if (!startAux()) {
+        LOGW("Boot", "boot helper task unavailable, running boot steps in order");
+        runInline();
+        return false;
+    }
+    runLane(Lane::Main);
+    joinAux();
+    return true;
+}
+
+void BootGraph::auxEntry(void *arg) {
+    BootGraph *graph = static_cast<BootGraph *>(arg);
+    graph->runLane(Lane::Aux);
+#ifndef UNIT_TEST
+    // The graph may be gone as soon as the waiter wakes, so nothing of it is touched after this.
+    TaskHandle_t waiter = graph->waiter_;
+    xTaskNotifyGive(waiter);
+    vTaskDelete(nullptr);
+#endif
+}
+
+void BootGraph::runLane(Lane lane) {
+    for (uint8_t id = 0; id < count_; ++id) {
+        if (nodes_[id].lane != lane) {
+            continue;
+        }
+        waitFor(nodes_[id].deps);
+        runNode(id);
+    }
+}
+
+void BootGraph::runInline() {
+    for (uint8_t id = 0; id < count_; ++id) {
+        runNode(id);
+    }
+}
+
+void BootGraph::runNode(uint8_t id) {
+    {
+        BootProfiler::Scope stage(nodes_[id].name);
+        nodes_[id].fn(nodes_[id].arg);
+    }
+    markDone(id);
+}
+
+void BootGraph::waitFor(uint32_t mask) {
+    if (mask == 0) {
+        return;
+    }
+#ifdef UNIT_TEST
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [&]() { return (done_ & mask) == mask; });
+#else
+    xEventGroupWaitBits(done_, static_cast<EventBits_t>(mask), pdFALSE, pdTRUE, portMAX_DELAY);
+#endif
+}
+
+void BootGraph::markDone(uint8_t id) {
+#ifdef UNIT_TEST
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ |= bit(id);
+    }
+    done_cv_.notify_all();
+#else
+    xEventGroupSetBits(done_, static_cast<EventBits_t>(bit(id)));
+#endif
+}
+
+bool BootGraph::startAux() {
+#ifdef UNIT_TEST
+    if (fail_aux_start_) {
+        fail_aux_start_ = false;
+        return false;
+    }
+    aux_thread_ = std::thread(auxEntry, this);
+    return true;
+#else
+    if (done_ == nullptr) {
+        return false;
+    }
+    waiter_ = xTaskGetCurrentTaskHandle();
+    const BaseType_t ok = xTaskCreatePinnedToCore(auxEntry,
+                                                  "boot_aux",
+                                                  kAuxStackSize,
+                                                  this,
+                                                  kAuxPriority,
+                                                  nullptr,
+                                                  kAuxCore);
+    return ok == pdPASS;
+#endif
+}
+
+void BootGraph::joinAux() {
+#ifdef UNIT_TEST
+    aux_thread_.join();
+#else
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#endif
+}
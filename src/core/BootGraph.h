@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/task.h>
+#endif
+
+// Boot steps as a dependency graph over two lanes. Main nodes run on the task that calls run();
+// Aux nodes run in order on a helper task on core 0. A node starts once every node in its
+// dependency mask has finished, and each node is one boot profiler stage.
+//
+// Dependencies must be nodes added earlier, so the graph cannot deadlock. If the helper task
+// cannot be started, every node runs inline in the order it was added.
+class BootGraph {
+public:
+    using Fn = void (*)(void *arg);
+    enum class Lane : uint8_t {
+        Main = 0,
+        Aux
+    };
+    static constexpr size_t kMaxNodes = 16;
+    static constexpr uint8_t kInvalid = 0xFF;
+
+    static uint32_t bit(uint8_t id) { return id < kMaxNodes ? (1UL << id) : 0; }
+
+    BootGraph();
+    ~BootGraph();
+
+    BootGraph(const BootGraph &) = delete;
+    BootGraph &operator=(const BootGraph &) = delete;
+
+    // Returns the node id, or kInvalid when the graph is full or a dependency is not an earlier
+    // node. A rejected node never runs; depending on it is a no-op.
+    uint8_t add(const char *name, Lane lane, uint32_t deps, Fn fn, void *arg);
+    // Returns once every node has finished. False when the aux lane had to run inline.
+    bool run();
+
+#ifdef UNIT_TEST
+    // Makes the next run() behave as if the helper task could not be created.
+    void failAuxStartForTest() { fail_aux_start_ = true; }
+#endif
+
+private:
+    struct Node {
+        const char *name;
+        Lane lane;
+        uint32_t deps;
+        Fn fn;
+        void *arg;
+    };
+
+    static void auxEntry(void *arg);
+    void runLane(Lane lane);
+    void runInline();
+    void runNode(uint8_t id);
+    void waitFor(uint32_t mask);
+    void markDone(uint8_t id);
+    bool startAux();
+    void joinAux();
+
+    Node nodes_[kMaxNodes] = {};
+    uint8_t count_ = 0;
+#ifdef UNIT_TEST
+    std::mutex mutex_{};
+    std::condition_variable done_cv_{};
+    uint32_t done_ = 0;
+    std::thread aux_thread_{};
+    bool fail_aux_start_ = false;
+#else
+    StaticEventGroup_t done_buffer_{};
+    EventGroupHandle_t done_ = nullptr;
+    TaskHandle_t waiter_ = nullptr;
+#endif
+};
@@ -14,6 +14,7 @@
 
 #include "config/AppConfig.h"
 #include "core/BootState.h"
+#include "core/I2cTelemetry.h"
 #include "core/Logger.h"
 
 namespace {
@@ -25,6 +26,7 @@ bool gt911_read_product_id(uint8_t addr, uint8_t *out, size_t len) {
         static_cast<uint8_t>(GT911_REG_PRODUCT_ID >> 8),
         static_cast<uint8_t>(GT911_REG_PRODUCT_ID & 0xFF)
     };
+    const uint32_t started_us = micros();
     esp_err_t err = i2c_master_write_read_device(
         I2C_PORT,
         addr,
@@ -34,6 +36,7 @@ bool gt911_read_product_id(uint8_t addr, uint8_t *out, size_t len) {
         len,
         pdMS_TO_TICKS(I2C_TIMEOUT_MS)
     );
+    I2cTelemetry::instance().record(addr, sizeof(reg) + len, err, started_us);
     return err == ESP_OK;
 }
 
@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/BootProfiler.h"
+
+#include <esp_timer.h>
+#include <string.h>
+
+#ifndef UNIT_TEST
+#include <freertos/task.h>
+#endif
+
+namespace {
+
+// Stages the calling task has open; each boot lane nests its own stages.
+thread_local uint8_t t_open_depth = 0;
+
+} // namespace
+
+BootProfiler &BootProfiler::instance() {
+    static BootProfiler profiler;
+    return profiler;
+}
+
+BootProfiler::BootProfiler() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+uint32_t BootProfiler::nowUs() {
+    // esp_timer counts from reset, so the first stage already shows how long ROM and the
+    // bootloader took.
+    return static_cast<uint32_t>(esp_timer_get_time());
+}
+
+uint8_t BootProfiler::currentCore() {
+#ifdef UNIT_TEST
+    return 0;
+#else
+    return static_cast<uint8_t>(xPortGetCoreID());
+#endif
+}
+
+uint8_t BootProfiler::begin(const char *name) {
+    const uint32_t now_us = nowUs();
+    lock();
+    if (current_.complete || current_.stage_count >= kMaxStages) {
+        if (!current_.complete && current_.dropped_stages < UINT8_MAX) {
+            current_.dropped_stages++;
+        }
+        unlock();
+        return kNoStage;
+    }
+    const uint8_t index = current_.stage_count++;
+    Stage &stage = current_.stages[index];
+    strncpy(stage.name, name ? name : "?", kNameLength - 1);
+    stage.name[kNameLength - 1] = '\0';
+    stage.depth = t_open_depth++;
+    stage.core = currentCore();
+    stage.start_us = now_us;
+    stage.duration_us = 0;
+    unlock();
+    return index;
+}
+
+void BootProfiler::end(uint8_t index) {
+    const uint32_t now_us = nowUs();
+    lock();
+    if (index < current_.stage_count && current_.stages[index].duration_us == 0) {
+        Stage &stage = current_.stages[index];
+        // A stage that took under 1 us still reads as closed.
+        stage.duration_us = now_us > stage.start_us ? now_us - stage.start_us : 1;
+        if (t_open_depth > 0) {
+            t_open_depth--;
+        }
+    }
+    unlock();
+}
+
+void BootProfiler::finish(uint32_t boot_count, uint8_t reset_reason) {
+    const uint32_t now_us = nowUs();
+    lock();
+    if (!current_.complete) {
+        current_.boot_count = boot_count;
+        current_.reset_reason = reset_reason;
+        current_.total_us = now_us;
+        current_.complete = true;
+        revision_.fetch_add(1, std::memory_order_release);
+    }
+    unlock();
+}
+
+void BootProfiler::armFirstFrame() {
+    if (first_frame_us_.load(std::memory_order_relaxed) == 0) {
+        frame_armed_.store(true, std::memory_order_release);
+    }
+}
+
+void BootProfiler::noteFrame() {
+    if (!frame_armed_.load(std::memory_order_relaxed) ||
+        !frame_armed_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    first_frame_us_.store(nowUs(), std::memory_order_relaxed);
+    revision_.fetch_add(1, std::memory_order_release);
+}
+
+void BootProfiler::noteFirstReading() {
+    if (first_reading_us_.load(std::memory_order_relaxed) != 0) {
+        return;
+    }
+    uint32_t expected = 0;
+    if (first_reading_us_.compare_exchange_strong(expected, nowUs(), std::memory_order_relaxed)) {
+        revision_.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void BootProfiler::copyCurrent(Trace &out) const {
+    out = current_;
+    out.first_frame_us = first_frame_us_.load(std::memory_order_relaxed);
+    out.first_reading_us = first_reading_us_.load(std::memory_order_relaxed);
+}
+
+void BootProfiler::current(Trace &out) const {
+    lock();
+    copyCurrent(out);
+    unlock();
+}
+
+void BootProfiler::summary(Summary &out) const {
+    lock();
+    out.finished = current_.complete;
+    out.total_us = current_.total_us;
+    out.has_previous = previous_count_ > 0;
+    out.previous_total_us = out.has_previous ? previous_[0].total_us : 0;
+    unlock();
+}
+
+size_t BootProfiler::previousCount() const {
+    lock();
+    const size_t count = previous_count_;
+    unlock();
+    return count;
+}
+
+bool BootProfiler::previous(size_t index, Trace &out) const {
+    lock();
+    const bool found = index < previous_count_;
+    if (found) {
+        out = previous_[index];
+    }
+    unlock();
+    return found;
+}
+
+bool BootProfiler::restore(const HistoryBlob &blob) {
+    lock();
+    previous_count_ = 0;
+    if (blob.magic != kBlobMagic || blob.version != kBlobVersion || blob.count > kHistoryDepth) {
+        unlock();
+        return false;
+    }
+    for (size_t i = 0; i < blob.count && previous_count_ < kHistoryDepth - 1; ++i) {
+        const Trace &trace = blob.traces[i];
+        if (!trace.complete || trace.stage_count > kMaxStages) {
+            continue;
+        }
+        previous_[previous_count_] = trace;
+        for (size_t s = 0; s < trace.stage_count; ++s) {
+            previous_[previous_count_].stages[s].name[kNameLength - 1] = '\0';
+        }
+        previous_count_++;
+    }
+    unlock();
+    return true;
+}
+
+void BootProfiler::fill(HistoryBlob &blob) const {
+    memset(&blob, 0, sizeof(blob));
+    blob.magic = kBlobMagic;
+    blob.version = kBlobVersion;
+    lock();
+    size_t count = 0;
+    if (current_.complete) {
+        copyCurrent(blob.traces[count++]);
+    }
+    for (size_t i = 0; i < previous_count_ && count < kHistoryDepth; ++i) {
+        blob.traces[count++] = previous_[i];
+    }
+    unlock();
+    blob.count = static_cast<uint16_t>(count);
+}
+
+void BootProfiler::reset() {
+    lock();
+    current_ = Trace{};
+    previous_count_ = 0;
+    t_open_depth = 0;
+    frame_armed_.store(false, std::memory_order_relaxed);
+    first_frame_us_.store(0, std::memory_order_relaxed);
+    first_reading_us_.store(0, std::memory_order_relaxed);
+    revision_.fetch_add(1, std::memory_order_release);
+    unlock();
+}
+
+void BootProfiler::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void BootProfiler::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// Boot trace: named stages with start time and duration in microseconds since reset, nested by
+// the order each task opens them, so stages running on both cores during boot nest on their own.
+// setup() calls finish() once the device is usable; the finished trace and the ones kept from
+// previous boots are what /api/diag and the boot diag screen show. The first frame and the first
+// sensor reading usually land after finish() and are recorded as milestones on the same trace.
+class BootProfiler {
+public:
+    static constexpr size_t kMaxStages = 28;
+    static constexpr size_t kNameLength = 14; // including the terminator
+    // Traces persisted across boots, the current one included.
+    static constexpr size_t kHistoryDepth = 4;
+    static constexpr uint8_t kNoStage = 0xFF;
+
+    struct Stage {
+        char name[kNameLength];
+        uint8_t depth;
+        uint8_t core;
+        uint32_t start_us;
+        uint32_t duration_us; // 0 while the stage is still open
+    };
+    struct Trace {
+        uint32_t boot_count;
+        uint32_t total_us; // reset until finish()
+        uint32_t first_frame_us;   // 0 until reached
+        uint32_t first_reading_us; // 0 until reached
+        uint8_t reset_reason;
+        uint8_t stage_count;
+        uint8_t dropped_stages; // begin() calls past kMaxStages
+        bool complete;
+        Stage stages[kMaxStages];
+    };
+    // Totals only, for callers that cannot spare a Trace on their stack.
+    struct Summary {
+        bool finished;
+        uint32_t total_us;
+        bool has_previous;
+        uint32_t previous_total_us; // the boot before this one
+    };
+    // Persisted form: the current trace first, then older boots.
+    struct HistoryBlob {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t count;
+        Trace traces[kHistoryDepth];
+    };
+
+    // Times the enclosing block as one stage.
+    class Scope {
+    public:
+        explicit Scope(const char *name) : index_(instance().begin(name)) {}
+        ~Scope() { instance().end(index_); }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        uint8_t index_;
+    };
+
+    static BootProfiler &instance();
+
+    // Returns kNoStage once the trace is full or finished; end() ignores it.
+    uint8_t begin(const char *name);
+    void end(uint8_t index);
+    // Closes the trace. Stages still open keep running until their end() but no new ones start.
+    void finish(uint32_t boot_count, uint8_t reset_reason);
+
+    // The next noteFrame() records the first frame; call once the boot screen is built so a
+    // flush of the empty default screen does not count. noteFrame() runs on every LVGL flush
+    // and does not take the lock.
+    void armFirstFrame();
+    void noteFrame();
+    void noteFirstReading();
+    // Changes whenever finish() or a milestone changes what fill() would write.
+    uint32_t revision() const { return revision_.load(std::memory_order_acquire); }
+
+    void current(Trace &out) const;
+    void summary(Summary &out) const;
+    // Index 0 is the boot before this one.
+    size_t previousCount() const;
+    bool previous(size_t index, Trace &out) const;
+
+    // Returns false and keeps no previous traces when the blob is not ours.
+    bool restore(const HistoryBlob &blob);
+    void fill(HistoryBlob &blob) const;
+
+    void reset();
+
+private:
+    BootProfiler();
+
+    void lock() const;
+    void unlock() const;
+    static uint32_t nowUs();
+    static uint8_t currentCore();
+    void copyCurrent(Trace &out) const;
+
+    static constexpr uint32_t kBlobMagic = 0x42545243u; // "BTRC"
+    static constexpr uint16_t kBlobVersion = 2;
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    Trace current_{};
+    Trace previous_[kHistoryDepth - 1]{};
+    size_t previous_count_ = 0;
+    std::atomic<bool> frame_armed_{false};
+    std::atomic<uint32_t> first_frame_us_{0};
+    std::atomic<uint32_t> first_reading_us_{0};
+    std::atomic<uint32_t> revision_{0};
+};
@@ -0,0 +1,305 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/ConfigSnapshot.h"
+
+#include <string.h>
+#include <type_traits>
+
+namespace ConfigSnapshot {
+
+namespace {
+
+constexpr uint8_t kMagic[4] = {'C', 'F', 'G', 'S'};
+constexpr size_t kHeaderSize = 8;      // magic, version, entry count
+constexpr size_t kEntryHeaderSize = 3; // tag, u16 length
+
+// The one list of fields and their tags, shared by the encoder and the decoder. Append new
+// fields with a fresh tag; never renumber or reuse one.
+template <typename StoredConfig, typename Visitor>
+void visit_fields(StoredConfig &c, Visitor &v) {
+    v(1, c.wifi_ssid);
+    v(2, c.wifi_pass);
+    v(3, c.wifi_enabled);
+
+    v(10, c.mqtt_host);
+    v(11, c.mqtt_port);
+    v(12, c.mqtt_user);
+    v(13, c.mqtt_pass);
+    v(14, c.mqtt_base_topic);
+    v(15, c.mqtt_device_name);
+    v(16, c.mqtt_user_enabled);
+    v(17, c.mqtt_discovery);
+    v(18, c.mqtt_anonymous);
+    v(19, c.mqtt_state_encoding);
+
+    v(30, c.temp_offset);
+    v(31, c.hum_offset);
+    v(32, c.units_c);
+    v(33, c.units_mdy);
+    v(34, c.night_mode);
+    v(35, c.header_status_enabled);
+    v(36, c.led_indicators);
+    v(37, c.alert_blink);
+    v(38, c.asc_enabled);
+    v(39, c.pressure_altitude_set);
+    v(40, c.pressure_altitude_m);
+    v(41, c.web_display_name);
+    v(42, c.language);
+
+    v(50, c.backlight_timeout_s);
+    v(51, c.backlight_schedule_enabled);
+    v(52, c.backlight_alarm_wake);
+    v(53, c.backlight_sleep_hour);
+    v(54, c.backlight_sleep_minute);
+    v(55, c.backlight_wake_hour);
+    v(56, c.backlight_wake_minute);
+
+    v(60, c.auto_night_enabled);
+    v(61, c.auto_night_start_hour);
+    v(62, c.auto_night_start_minute);
+    v(63, c.auto_night_end_hour);
+    v(64, c.auto_night_end_minute);
+
+    v(70, c.ntp_enabled);
+    v(71, c.ntp_server);
+    v(72, c.tz_name);
+    v(73, c.tz_index);
+    v(74, c.time_format_24h);
+    v(75, c.rtc_mode);
+
+    v(80, c.dac_auto_mode);
+    v(81, c.dac_auto_armed);
+
+    v(90, c.theme.valid);
+    v(91, c.theme.screen_bg);
+    v(92, c.theme.card_bg);
+    v(93, c.theme.card_border);
+    v(94, c.theme.text_primary);
+    v(95, c.theme.shadow_color);
+    v(96, c.theme.shadow_enabled);
+    v(97, c.theme.gradient_enabled);
+    v(98, c.theme.gradient_color);
+    v(99, c.theme.gradient_direction);
+    v(100, c.theme.screen_gradient_enabled);
+    v(101, c.theme.screen_gradient_color);
+    v(102, c.theme.screen_gradient_direction);
+}
+
+void put_u16(uint8_t *out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+uint16_t get_u16(const uint8_t *in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+// Scalars are stored little-endian at their in-memory width; enums as their underlying type.
+template <typename T>
+typename std::enable_if<std::is_enum<T>::value, uint64_t>::type to_bits(T value) {
+    return static_cast<uint64_t>(static_cast<typename std::underlying_type<T>::type>(value));
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, uint64_t>::type to_bits(T value) {
+    return static_cast<uint64_t>(value);
+}
+
+inline uint64_t to_bits(float value) {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template <typename T>
+typename std::enable_if<std::is_enum<T>::value, T>::type from_bits(uint64_t bits) {
+    return static_cast<T>(static_cast<typename std::underlying_type<T>::type>(bits));
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, T>::type from_bits(uint64_t bits) {
+    return static_cast<T>(bits);
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, T>::type from_bits(uint64_t bits) {
+    const uint32_t raw = static_cast<uint32_t>(bits);
+    float value = 0.0f;
+    memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+template <typename T>
+void store_scalar(const T &value, uint8_t *out) {
+    const uint64_t bits = to_bits(value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
+
+template <typename T>
+T load_scalar(const uint8_t *in) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bits |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return from_bits<T>(bits);
+}
+
+struct SizeCounter {
+    size_t bytes = kHeaderSize;
+
+    void operator()(uint8_t, const String &value) {
+        bytes += kEntryHeaderSize + value.length();
+    }
+    template <typename T>
+    void operator()(uint8_t, const T &) {
+        bytes += kEntryHeaderSize + sizeof(T);
+    }
+};
+
+struct Writer {
+    Writer(uint8_t *buffer, size_t size) : out(buffer), capacity(size) {}
+
+    uint8_t *out;
+    size_t capacity;
+    size_t pos = kHeaderSize;
+    uint16_t count = 0;
+    bool ok = true;
+
+    uint8_t *entry(uint8_t tag, size_t len) {
+        if (!ok || len > 0xFFFF || capacity - pos < kEntryHeaderSize + len) {
+            ok = false;
+            return nullptr;
+        }
+        out[pos] = tag;
+        put_u16(out + pos + 1, static_cast<uint16_t>(len));
+        uint8_t *value = out + pos + kEntryHeaderSize;
+        pos += kEntryHeaderSize + len;
+        count++;
+        return value;
+    }
+    void operator()(uint8_t tag, const String &value) {
+        uint8_t *dest = entry(tag, value.length());
+        if (dest && value.length() > 0) {
+            memcpy(dest, value.c_str(), value.length());
+        }
+    }
+    template <typename T>
+    void operator()(uint8_t tag, const T &value) {
+        uint8_t *dest = entry(tag, sizeof(T));
+        if (dest) {
+            store_scalar(value, dest);
+        }
+    }
+};
+
+struct Reader {
+    Reader(const uint8_t *data, size_t size) : entries(data), len(size) {}
+
+    const uint8_t *entries;
+    size_t len;
+    size_t cursor = 0;
+
+    // The encoder writes tags in ascending order, so the entry after the last hit is almost
+    // always the next one asked for; the wrap-around keeps hand-ordered records working.
+    bool find(uint8_t tag, const uint8_t *&value, size_t &value_len) {
+        size_t pos = cursor;
+        for (int pass = 0; pass < 2; ++pass) {
+            const size_t stop = pass == 0 ? len : cursor;
+            while (pos < stop) {
+                const size_t entry_len = get_u16(entries + pos + 1);
+                const size_t next = pos + kEntryHeaderSize + entry_len;
+                if (entries[pos] == tag) {
+                    value = entries + pos + kEntryHeaderSize;
+                    value_len = entry_len;
+                    cursor = next < len ? next : 0;
+                    return true;
+                }
+                pos = next;
+            }
+            pos = 0;
+        }
+        return false;
+    }
+    void operator()(uint8_t tag, String &field) {
+        const uint8_t *value = nullptr;
+        size_t value_len = 0;
+        if (find(tag, value, value_len)) {
+            field = String(reinterpret_cast<const char *>(value), value_len);
+        }
+    }
+    template <typename T>
+    void operator()(uint8_t tag, T &field) {
+        const uint8_t *value = nullptr;
+        size_t value_len = 0;
+        // A width change would come with a new tag; a mismatch here means leave the default.
+        if (find(tag, value, value_len) && value_len == sizeof(T)) {
+            field = load_scalar<T>(value);
+        }
+    }
+};
+
+} // namespace
+
+size_t encodedSize(const Config::StoredConfig &config) {
+    SizeCounter counter;
+    visit_fields(config, counter);
+    return counter.bytes;
+}
+
+size_t encode(const Config::StoredConfig &config, uint8_t *out, size_t capacity) {
+    if (!out || capacity < kHeaderSize) {
+        return 0;
+    }
+    Writer writer(out, capacity);
+    visit_fields(config, writer);
+    if (!writer.ok) {
+        return 0;
+    }
+    memcpy(out, kMagic, sizeof(kMagic));
+    put_u16(out + 4, kVersion);
+    put_u16(out + 6, writer.count);
+    return writer.pos;
+}
+
+bool decode(const uint8_t *data, size_t len, Config::StoredConfig &config) {
+    if (!data || len < kHeaderSize || memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+        get_u16(data + 4) != kVersion) {
+        return false;
+    }
+    // Walk every entry once up front so the reader never has to bounds-check.
+    const uint16_t count = get_u16(data + 6);
+    const uint8_t *entries = data + kHeaderSize;
+    const size_t entries_len = len - kHeaderSize;
+    size_t pos = 0;
+    for (uint16_t i = 0; i < count; ++i) {
+        if (entries_len - pos < kEntryHeaderSize) {
+            return false;
+        }
+        const size_t entry_len = get_u16(entries + pos + 1);
+        if (entries_len - pos - kEntryHeaderSize < entry_len) {
+            return false;
+        }
+        pos += kEntryHeaderSize + entry_len;
+    }
+    if (pos != entries_len) {
+        return false;
+    }
+
+    Config::StoredConfig decoded = config;
+    Reader reader(entries, entries_len);
+    visit_fields(decoded, reader);
+    decoded.language = Config::clampLanguage(static_cast<int>(decoded.language));
+    decoded.rtc_mode = Config::clampRtcMode(static_cast<int>(decoded.rtc_mode));
+    decoded.mqtt_state_encoding =
+        Config::clampMqttStateEncoding(static_cast<int>(decoded.mqtt_state_encoding));
+    config = decoded;
+    return true;
+}
+
+} // namespace ConfigSnapshot
@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "config/AppConfig.h"
+
+// Binary form of Config::StoredConfig, loaded at boot instead of parsing JSON. After a small
+// header every field is a (tag, length, value) entry: firmware that adds a field gives it a new
+// tag, older firmware skips tags it does not know, and a field missing from the record keeps its
+// default. Tags are never reused. Integrity is left to the record store's CRC.
+namespace ConfigSnapshot {
+
+constexpr uint16_t kVersion = 1;
+
+size_t encodedSize(const Config::StoredConfig &config);
+// Returns the number of bytes written, or 0 if `capacity` is too small.
+size_t encode(const Config::StoredConfig &config, uint8_t *out, size_t capacity);
+// Applies every known entry on top of `config`. Returns false and leaves `config` untouched
+// when the header or any entry is malformed.
+bool decode(const uint8_t *data, size_t len, Config::StoredConfig &config);
+
+} // namespace ConfigSnapshot
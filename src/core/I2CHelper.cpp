@@ -7,6 +7,7 @@
 #include "I2CHelper.h"
 #include <Arduino.h>
 #include "config/AppConfig.h"
+#include "core/I2cTelemetry.h"
 
 namespace I2C {
 
@@ -25,6 +26,14 @@ uint8_t crc8(const uint8_t *data, size_t len) {
     return crc;
 }
 
+bool check_crc(uint8_t addr, const uint8_t *word) {
+    if (crc8(word, 2) == word[2]) {
+        return true;
+    }
+    I2cTelemetry::instance().recordCrcFailure(addr);
+    return false;
+}
+
 esp_err_t write_cmd(uint8_t addr, uint16_t cmd, const uint8_t *params, size_t len) {
     if (len > 0 && !params) {
         return ESP_ERR_INVALID_ARG;
@@ -44,23 +53,56 @@ esp_err_t write_cmd(uint8_t addr, uint16_t cmd, const uint8_t *params, size_t le
         i2c_master_write(handle, params, len, true);
     }
     i2c_master_stop(handle);
+    const uint32_t started_us = micros();
     esp_err_t err = i2c_master_cmd_begin(
         Config::I2C_PORT,
         handle,
         pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
     );
     i2c_cmd_link_delete(handle);
+    I2cTelemetry::instance().record(addr, sizeof(cmd_bytes) + len, err, started_us);
     return err;
 }
 
 esp_err_t read_bytes(uint8_t addr, uint8_t *data, size_t len) {
-    return i2c_master_read_from_device(
+    const uint32_t started_us = micros();
+    const esp_err_t err = i2c_master_read_from_device(
+        Config::I2C_PORT,
+        addr,
+        data,
+        len,
+        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
+    );
+    I2cTelemetry::instance().record(addr, len, err, started_us);
+    return err;
+}
+
+esp_err_t write_bytes(uint8_t addr, const uint8_t *data, size_t len) {
+    const uint32_t started_us = micros();
+    const esp_err_t err = i2c_master_write_to_device(
         Config::I2C_PORT,
         addr,
         data,
         len,
         pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
     );
+    I2cTelemetry::instance().record(addr, len, err, started_us);
+    return err;
+}
+
+esp_err_t read_register(uint8_t addr, uint8_t reg, uint8_t *data, size_t len) {
+    const uint32_t started_us = micros();
+    const esp_err_t err = i2c_master_write_read_device(
+        Config::I2C_PORT,
+        addr,
+        &reg,
+        1,
+        data,
+        len,
+        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
+    );
+    I2cTelemetry::instance().record(addr, 1 + len, err, started_us);
+    return err;
 }
 
 } // namespace I2C
@@ -10,6 +10,11 @@
 
 namespace I2C {
     uint8_t crc8(const uint8_t *data, size_t len);
+    // Verifies one Sensirion word (two data bytes followed by their CRC) and counts failures
+    // against addr in the bus telemetry.
+    bool check_crc(uint8_t addr, const uint8_t *word);
     esp_err_t write_cmd(uint8_t addr, uint16_t cmd, const uint8_t *params, size_t len);
     esp_err_t read_bytes(uint8_t addr, uint8_t *data, size_t len);
+    esp_err_t write_bytes(uint8_t addr, const uint8_t *data, size_t len);
+    esp_err_t read_register(uint8_t addr, uint8_t reg, uint8_t *data, size_t len);
 }
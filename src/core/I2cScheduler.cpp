@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/I2cScheduler.h"
+
+#include <string.h>
+
+#include "core/I2CHelper.h"
+
+void I2cTransaction::reset(uint8_t address) {
+    address_ = address;
+    state_ = State::Idle;
+    error_ = Error::None;
+    step_count_ = 0;
+    next_step_ = 0;
+    due_ms_ = 0;
+    submitted_ms_ = 0;
+    tx_len_ = 0;
+    rx_len_ = 0;
+}
+
+bool I2cTransaction::appendStep(const Step &step) {
+    if (state_ != State::Idle || step_count_ >= kMaxSteps) {
+        return false;
+    }
+    steps_[step_count_++] = step;
+    return true;
+}
+
+bool I2cTransaction::hasReadStep() const {
+    for (uint8_t i = 0; i < step_count_; ++i) {
+        if (steps_[i].kind == StepKind::Read || steps_[i].kind == StepKind::ReadRegister) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool I2cTransaction::addCommand(uint16_t cmd, const uint8_t *params, size_t len) {
+    if ((len > 0 && !params) || tx_len_ + 2 + len > kMaxWriteBytes) {
+        return false;
+    }
+    Step step;
+    step.kind = StepKind::Command;
+    step.offset = tx_len_;
+    step.len = static_cast<uint8_t>(len);
+    if (!appendStep(step)) {
+        return false;
+    }
+    tx_[tx_len_++] = static_cast<uint8_t>(cmd >> 8);
+    tx_[tx_len_++] = static_cast<uint8_t>(cmd & 0xFF);
+    if (len > 0) {
+        memcpy(&tx_[tx_len_], params, len);
+        tx_len_ = static_cast<uint8_t>(tx_len_ + len);
+    }
+    return true;
+}
+
+bool I2cTransaction::addWrite(const uint8_t *data, size_t len) {
+    if (!data || len == 0 || tx_len_ + len > kMaxWriteBytes) {
+        return false;
+    }
+    Step step;
+    step.kind = StepKind::Write;
+    step.offset = tx_len_;
+    step.len = static_cast<uint8_t>(len);
+    if (!appendStep(step)) {
+        return false;
+    }
+    memcpy(&tx_[tx_len_], data, len);
+    tx_len_ = static_cast<uint8_t>(tx_len_ + len);
+    return true;
+}
+
+bool I2cTransaction::addWait(uint32_t ms) {
+    Step step;
+    step.kind = StepKind::Wait;
+    step.wait_ms = ms;
+    return appendStep(step);
+}
+
+bool I2cTransaction::addRead(size_t len) {
+    if (len == 0 || len > kMaxReadBytes || hasReadStep()) {
+        return false;
+    }
+    Step step;
+    step.kind = StepKind::Read;
+    step.len = static_cast<uint8_t>(len);
+    return appendStep(step);
+}
+
+bool I2cTransaction::addReadRegister(uint8_t reg, size_t len) {
+    if (len == 0 || len > kMaxReadBytes || hasReadStep()) {
+        return false;
+    }
+    Step step;
+    step.kind = StepKind::ReadRegister;
+    step.len = static_cast<uint8_t>(len);
+    step.reg = reg;
+    return appendStep(step);
+}
+
+bool I2cTransaction::decodeWords(uint16_t *out, size_t words) const {
+    if (!out || state_ != State::Done || words * 3 > rx_len_) {
+        return false;
+    }
+    for (size_t i = 0; i < words; ++i) {
+        const uint8_t *p = &rx_[i * 3];
+        if (!I2C::check_crc(address_, p)) {
+            return false;
+        }
+        out[i] = (static_cast<uint16_t>(p[0]) << 8) | p[1];
+    }
+    return true;
+}
+
+void I2cTransaction::release() {
+    if (state_ == State::Pending) {
+        return;
+    }
+    state_ = State::Idle;
+    error_ = Error::None;
+    next_step_ = 0;
+}
+
+I2cScheduler &I2cScheduler::instance() {
+    static I2cScheduler scheduler;
+    return scheduler;
+}
+
+bool I2cScheduler::submit(I2cTransaction &txn, uint32_t now_ms) {
+    if (txn.state_ != I2cTransaction::State::Idle || txn.step_count_ == 0 ||
+        active_count_ >= kMaxActive) {
+        return false;
+    }
+    txn.state_ = I2cTransaction::State::Pending;
+    txn.error_ = I2cTransaction::Error::None;
+    txn.next_step_ = 0;
+    txn.due_ms_ = now_ms;
+    txn.submitted_ms_ = now_ms;
+    txn.rx_len_ = 0;
+    active_[active_count_++] = &txn;
+    if (!blockedByEarlier(active_count_ - 1)) {
+        advance(txn, now_ms);
+        if (!txn.isPending()) {
+            removeAt(active_count_ - 1);
+        }
+    }
+    return true;
+}
+
+void I2cScheduler::cancel(I2cTransaction &txn) {
+    for (size_t i = 0; i < active_count_; ++i) {
+        if (active_[i] == &txn) {
+            removeAt(i);
+            txn.state_ = I2cTransaction::State::Failed;
+            txn.error_ = I2cTransaction::Error::Cancelled;
+            return;
+        }
+    }
+}
+
+void I2cScheduler::poll(uint32_t now_ms) {
+    size_t i = 0;
+    while (i < active_count_) {
+        I2cTransaction &txn = *active_[i];
+        if (!blockedByEarlier(i)) {
+            advance(txn, now_ms);
+        }
+        if (txn.isPending()) {
+            ++i;
+        } else {
+            // Removal shifts later entries down, so a waiter on the same address is
+            // visited next at the same index.
+            removeAt(i);
+        }
+    }
+}
+
+void I2cScheduler::reset() {
+    for (size_t i = 0; i < active_count_; ++i) {
+        active_[i] = nullptr;
+    }
+    active_count_ = 0;
+}
+
+bool I2cScheduler::isAddressBusy(uint8_t address) const {
+    for (size_t i = 0; i < active_count_; ++i) {
+        if (active_[i]->address_ == address) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool I2cScheduler::blockedByEarlier(size_t index) const {
+    const uint8_t address = active_[index]->address_;
+    for (size_t i = 0; i < index; ++i) {
+        if (active_[i]->address_ == address) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void I2cScheduler::advance(I2cTransaction &txn, uint32_t now_ms) {
+    using Step = I2cTransaction::Step;
+    using StepKind = I2cTransaction::StepKind;
+
+    while (txn.next_step_ < txn.step_count_) {
+        if (static_cast<int32_t>(now_ms - txn.due_ms_) < 0) {
+            return;
+        }
+        const Step &step = txn.steps_[txn.next_step_++];
+        esp_err_t err = ESP_OK;
+        switch (step.kind) {
+            case StepKind::Command: {
+                const uint16_t cmd = (static_cast<uint16_t>(txn.tx_[step.offset]) << 8) |
+                                     txn.tx_[step.offset + 1];
+                err = I2C::write_cmd(txn.address_,
+                                     cmd,
+                                     step.len > 0 ? &txn.tx_[step.offset + 2] : nullptr,
+                                     step.len);
+                break;
+            }
+            case StepKind::Write:
+                err = I2C::write_bytes(txn.address_, &txn.tx_[step.offset], step.len);
+                break;
+            case StepKind::Wait:
+                txn.due_ms_ = now_ms + step.wait_ms;
+                break;
+            case StepKind::Read:
+                err = I2C::read_bytes(txn.address_, txn.rx_, step.len);
+                break;
+            case StepKind::ReadRegister:
+                err = I2C::read_register(txn.address_, step.reg, txn.rx_, step.len);
+                break;
+        }
+        if (err != ESP_OK) {
+            txn.state_ = I2cTransaction::State::Failed;
+            txn.error_ = (step.kind == StepKind::Read || step.kind == StepKind::ReadRegister)
+                             ? I2cTransaction::Error::Read
+                             : I2cTransaction::Error::Write;
+            return;
+        }
+        if (step.kind == StepKind::Read || step.kind == StepKind::ReadRegister) {
+            txn.rx_len_ = step.len;
+        }
+    }
+    // A trailing wait keeps the device reserved until its command has finished executing.
+    if (static_cast<int32_t>(now_ms - txn.due_ms_) < 0) {
+        return;
+    }
+    txn.state_ = I2cTransaction::State::Done;
+}
+
+void I2cScheduler::removeAt(size_t index) {
+    for (size_t i = index + 1; i < active_count_; ++i) {
+        active_[i - 1] = active_[i];
+    }
+    active_[--active_count_] = nullptr;
+}
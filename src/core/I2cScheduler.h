@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// One device exchange described as steps (command, write, wait, read). The scheduler issues
+// each step once it is due, so a driver never sleeps between a command and its response.
+class I2cTransaction {
+public:
+    static constexpr size_t kMaxSteps = 4;
+    static constexpr size_t kMaxWriteBytes = 26;
+    static constexpr size_t kMaxReadBytes = 32;
+
+    enum class State : uint8_t {
+        Idle = 0,
+        Pending,
+        Done,
+        Failed,
+    };
+
+    enum class Error : uint8_t {
+        None = 0,
+        Write,
+        Read,
+        Cancelled,
+    };
+
+    // Clears all steps and targets a new device. Must not be called while pending.
+    void reset(uint8_t address);
+    // Sensirion-style 16-bit command with optional parameter bytes.
+    bool addCommand(uint16_t cmd, const uint8_t *params = nullptr, size_t len = 0);
+    bool addWrite(const uint8_t *data, size_t len);
+    bool addWait(uint32_t ms);
+    // At most one read per transaction; the bytes land in data().
+    bool addRead(size_t len);
+    bool addReadRegister(uint8_t reg, size_t len);
+
+    // Decodes the read buffer as CRC-protected 16-bit words.
+    bool decodeWords(uint16_t *out, size_t words) const;
+
+    // Returns a finished transaction to Idle so it can be reused.
+    void release();
+
+    State state() const { return state_; }
+    Error error() const { return error_; }
+    bool isPending() const { return state_ == State::Pending; }
+    bool isFinished() const { return state_ == State::Done || state_ == State::Failed; }
+    bool succeeded() const { return state_ == State::Done; }
+    uint8_t address() const { return address_; }
+    const uint8_t *data() const { return rx_; }
+    size_t dataLen() const { return rx_len_; }
+    uint32_t submittedMs() const { return submitted_ms_; }
+
+private:
+    friend class I2cScheduler;
+
+    enum class StepKind : uint8_t {
+        Command = 0,
+        Write,
+        Wait,
+        Read,
+        ReadRegister,
+    };
+
+    struct Step {
+        StepKind kind = StepKind::Wait;
+        uint8_t offset = 0;
+        uint8_t len = 0;
+        uint8_t reg = 0;
+        uint32_t wait_ms = 0;
+    };
+
+    bool appendStep(const Step &step);
+    bool hasReadStep() const;
+
+    uint8_t address_ = 0;
+    State state_ = State::Idle;
+    Error error_ = Error::None;
+    Step steps_[kMaxSteps] = {};
+    uint8_t step_count_ = 0;
+    uint8_t next_step_ = 0;
+    uint32_t due_ms_ = 0;
+    uint32_t submitted_ms_ = 0;
+    uint8_t tx_[kMaxWriteBytes] = {};
+    uint8_t tx_len_ = 0;
+    uint8_t rx_[kMaxReadBytes] = {};
+    uint8_t rx_len_ = 0;
+};
+
+// Runs submitted transactions without blocking. Transactions to the same address run in
+// submission order; different devices interleave while one of them is waiting.
+// Single-threaded: submit(), cancel() and poll() belong to the sensor polling context.
+class I2cScheduler {
+public:
+    static constexpr size_t kMaxActive = 8;
+
+    static I2cScheduler &instance();
+
+    // Queues the transaction and issues every step that is already due.
+    bool submit(I2cTransaction &txn, uint32_t now_ms);
+    void cancel(I2cTransaction &txn);
+    void poll(uint32_t now_ms);
+    void reset();
+
+    size_t activeCount() const { return active_count_; }
+    bool isAddressBusy(uint8_t address) const;
+
+private:
+    I2cScheduler() = default;
+
+    bool blockedByEarlier(size_t index) const;
+    void advance(I2cTransaction &txn, uint32_t now_ms);
+    void removeAt(size_t index);
+
+    I2cTransaction *active_[kMaxActive] = {};
+    size_t active_count_ = 0;
+};
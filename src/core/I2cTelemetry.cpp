@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/I2cTelemetry.h"
+
+#include <Arduino.h>
+#include <driver/i2c.h>
+
+namespace {
+
+constexpr uint32_t kLatencyLimitsUs[I2cDeviceStats::kLatencyBuckets - 1] = {
+    250, 500, 1000, 2000, 5000, 10000, 25000,
+};
+
+size_t latency_bucket(uint32_t latency_us) {
+    for (size_t i = 0; i < I2cDeviceStats::kLatencyBuckets - 1; ++i) {
+        if (latency_us < kLatencyLimitsUs[i]) {
+            return i;
+        }
+    }
+    return I2cDeviceStats::kLatencyBuckets - 1;
+}
+
+} // namespace
+
+I2cTelemetry &I2cTelemetry::instance() {
+    static I2cTelemetry telemetry;
+    return telemetry;
+}
+
+I2cTelemetry::I2cTelemetry() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+uint32_t I2cTelemetry::latencyBucketLimitUs(size_t bucket) {
+    if (bucket >= I2cDeviceStats::kLatencyBuckets - 1) {
+        return 0;
+    }
+    return kLatencyLimitsUs[bucket];
+}
+
+void I2cTelemetry::record(uint8_t address, size_t bytes, int err, uint32_t started_us) {
+    const uint32_t latency_us = micros() - started_us;
+    const uint32_t now_ms = millis();
+
+    lock();
+    rollWindow(now_ms);
+    window_busy_us_ += latency_us;
+    busy_total_us_ += latency_us;
+
+    I2cDeviceStats *device = findOrAdd(address);
+    if (!device) {
+        stats_.untracked_transactions++;
+        unlock();
+        return;
+    }
+    device->transactions++;
+    if (err == ESP_OK) {
+        device->bytes += static_cast<uint32_t>(bytes);
+    } else if (err == ESP_FAIL) {
+        // The legacy driver reports a missing ACK as a plain ESP_FAIL.
+        device->nacks++;
+    } else if (err == ESP_ERR_TIMEOUT) {
+        device->timeouts++;
+    } else {
+        device->errors++;
+    }
+    device->latency_hist[latency_bucket(latency_us)]++;
+    if (latency_us > device->max_latency_us) {
+        device->max_latency_us = latency_us;
+    }
+    unlock();
+}
+
+void I2cTelemetry::recordCrcFailure(uint8_t address) {
+    lock();
+    I2cDeviceStats *device = findOrAdd(address);
+    if (device) {
+        device->crc_failures++;
+    }
+    unlock();
+}
+
+void I2cTelemetry::snapshot(I2cTelemetrySnapshot &out) {
+    lock();
+    rollWindow(millis());
+    stats_.busy_total_ms = static_cast<uint32_t>(busy_total_us_ / 1000ULL);
+    out = stats_;
+    unlock();
+}
+
+void I2cTelemetry::reset() {
+    lock();
+    stats_ = I2cTelemetrySnapshot{};
+    window_start_ms_ = millis();
+    window_busy_us_ = 0;
+    busy_total_us_ = 0;
+    unlock();
+}
+
+void I2cTelemetry::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void I2cTelemetry::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
+
+I2cDeviceStats *I2cTelemetry::findOrAdd(uint8_t address) {
+    for (size_t i = 0; i < stats_.device_count; ++i) {
+        if (stats_.devices[i].address == address) {
+            return &stats_.devices[i];
+        }
+    }
+    if (stats_.device_count >= I2cTelemetrySnapshot::kMaxDevices) {
+        return nullptr;
+    }
+    I2cDeviceStats &device = stats_.devices[stats_.device_count++];
+    device = I2cDeviceStats{};
+    device.address = address;
+    return &device;
+}
+
+void I2cTelemetry::rollWindow(uint32_t now_ms) {
+    const uint32_t elapsed_ms = now_ms - window_start_ms_;
+    if (elapsed_ms < kWindowMs) {
+        return;
+    }
+    // A gap longer than one window means the bus sat idle for a whole second since.
+    uint32_t permille = 0;
+    if (elapsed_ms < 2 * kWindowMs) {
+        permille = window_busy_us_ / kWindowMs;
+        if (permille > 1000) {
+            permille = 1000;
+        }
+    }
+    stats_.busy_permille = permille;
+    if (permille > stats_.busy_peak_permille) {
+        stats_.busy_peak_permille = permille;
+    }
+    window_start_ms_ = now_ms;
+    window_busy_us_ = 0;
+}
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+struct I2cDeviceStats {
+    static constexpr size_t kLatencyBuckets = 8;
+
+    uint8_t address = 0;
+    uint32_t transactions = 0;
+    uint32_t bytes = 0;
+    uint32_t nacks = 0;
+    uint32_t timeouts = 0;
+    uint32_t errors = 0;
+    uint32_t crc_failures = 0;
+    uint32_t max_latency_us = 0;
+    uint32_t latency_hist[kLatencyBuckets] = {};
+};
+
+struct I2cTelemetrySnapshot {
+    static constexpr size_t kMaxDevices = 12;
+
+    I2cDeviceStats devices[kMaxDevices] = {};
+    size_t device_count = 0;
+    // Transactions for addresses that did not fit the table.
+    uint32_t untracked_transactions = 0;
+    // Bus busy time in the last complete one-second window, and the worst window seen.
+    uint32_t busy_permille = 0;
+    uint32_t busy_peak_permille = 0;
+    uint32_t busy_total_ms = 0;
+};
+
+// Per-address counters for every I2C exchange. Fed by the I2C helpers and by drivers that
+// talk to the bus directly; read by the diagnostics API. Safe to call from any task.
+class I2cTelemetry {
+public:
+    static I2cTelemetry &instance();
+
+    // Upper bound of each latency bucket in microseconds; the last bucket is open-ended.
+    static uint32_t latencyBucketLimitUs(size_t bucket);
+
+    // started_us is micros() taken just before the transfer; bytes excludes the address byte.
+    void record(uint8_t address, size_t bytes, int err, uint32_t started_us);
+    void recordCrcFailure(uint8_t address);
+
+    void snapshot(I2cTelemetrySnapshot &out);
+    void reset();
+
+private:
+    I2cTelemetry();
+
+    void lock() const;
+    void unlock() const;
+    I2cDeviceStats *findOrAdd(uint8_t address);
+    void rollWindow(uint32_t now_ms);
+
+    static constexpr uint32_t kWindowMs = 1000;
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    I2cTelemetrySnapshot stats_{};
+    uint32_t window_start_ms_ = 0;
+    uint32_t window_busy_us_ = 0;
+    uint64_t busy_total_us_ = 0;
+};
@@ -6,15 +6,202 @@
 
 #include "core/Logger.h"
 #include "core/MqttEventQueue.h"
+#include "core/RetainedLog.h"
 #include "core/SystemEventPolicy.h"
 #include "core/SystemLogFilter.h"
 
+#include <esp_timer.h>
 #include <stdio.h>
 #include <string.h>
 
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
 namespace {
 constexpr size_t kLogBufferSize = 256;
 constexpr uint32_t kRecentDedupWindowMs = 30000;
+// Per core. A power of two, so ticket % kRingSlots stays continuous across the 32-bit wrap.
+constexpr uint32_t kRingSlots = 32;
+constexpr size_t kRingCount = 2;
+constexpr uint8_t kFlagMqttCapture = 0x01;
+// A %s argument leaves this much room for the arguments after it.
+constexpr size_t kStringReserveBytes = 10;
+
+#ifndef UNIT_TEST
+constexpr uint32_t kDrainTaskStackSize = 4096;
+constexpr UBaseType_t kDrainTaskPriority = 1;
+constexpr BaseType_t kDrainTaskCore = 0;
+constexpr uint32_t kDrainIntervalMs = 20;
+#endif
+
+struct LogRecord {
+    uint32_t ms;
+    uint32_t us;
+    const char *tag;
+    const char *fmt;
+    uint8_t level;
+    uint8_t flags;
+    uint8_t arg_size;
+    uint8_t args[Logger::kArgBytes];
+};
+
+// The ticket is the slot's ring position while a producer fills it and position + 1 once the
+// record is complete; the drain re-reads it after copying to catch a producer that lapped it.
+// Producers claim, fill and publish a slot under the ring's lock, so a preempted producer can
+// never be lapped by another one halfway through a record.
+struct LogSlot {
+    std::atomic<uint32_t> ticket{0};
+    LogRecord record;
+};
+
+struct LogRing {
+    std::atomic<uint32_t> head{0};
+    uint32_t tail = 0;
+#ifdef UNIT_TEST
+    std::mutex lock;
+#else
+    portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+#endif
+    LogSlot slots[kRingSlots];
+};
+
+LogRing g_rings[kRingCount];
+// Drain side: the next record of each ring, held back until it is the oldest of all rings.
+LogRecord g_lookahead[kRingCount];
+bool g_lookahead_valid[kRingCount] = {};
+std::atomic<uint32_t> g_recorded{0};
+std::atomic<uint32_t> g_dropped{0};
+uint32_t g_dropped_reported = 0;
+
+#ifdef UNIT_TEST
+std::mutex g_drain_mutex;
+#else
+StaticSemaphore_t g_drain_mutex_buffer;
+SemaphoreHandle_t g_drain_mutex = nullptr;
+TaskHandle_t g_drain_task = nullptr;
+#endif
+
+size_t current_ring() {
+#ifdef UNIT_TEST
+    return 0;
+#else
+    return static_cast<size_t>(xPortGetCoreID()) % kRingCount;
+#endif
+}
+
+uint32_t now_ms() {
+#if defined(ARDUINO)
+    return millis();
+#else
+    return 0;
+#endif
+}
+
+void lock_drain() {
+#ifdef UNIT_TEST
+    g_drain_mutex.lock();
+#else
+    if (g_drain_mutex) {
+        xSemaphoreTake(g_drain_mutex, portMAX_DELAY);
+    }
+#endif
+}
+
+// Held only while one record is copied in: no preemption, and the other core spins.
+void lock_ring(LogRing &ring) {
+#ifdef UNIT_TEST
+    ring.lock.lock();
+#else
+    portENTER_CRITICAL(&ring.lock);
+#endif
+}
+
+void unlock_ring(LogRing &ring) {
+#ifdef UNIT_TEST
+    ring.lock.unlock();
+#else
+    portEXIT_CRITICAL(&ring.lock);
+#endif
+}
+
+bool try_lock_drain() {
+#ifdef UNIT_TEST
+    return g_drain_mutex.try_lock();
+#else
+    return !g_drain_mutex || xSemaphoreTake(g_drain_mutex, 0) == pdTRUE;
+#endif
+}
+
+void unlock_drain() {
+#ifdef UNIT_TEST
+    g_drain_mutex.unlock();
+#else
+    if (g_drain_mutex) {
+        xSemaphoreGive(g_drain_mutex);
+    }
+#endif
+}
+
+// Copies the ring's oldest complete record into |out|. Records a producer overwrote before the
+// drain got to them are counted as dropped. False when the next record is not complete yet.
+bool take_record(LogRing &ring, LogRecord &out) {
+    for (;;) {
+        const uint32_t head = ring.head.load(std::memory_order_acquire);
+        if (head == ring.tail) {
+            return false;
+        }
+        if (head - ring.tail > kRingSlots) {
+            g_dropped.fetch_add(head - kRingSlots - ring.tail, std::memory_order_relaxed);
+            ring.tail = head - kRingSlots;
+        }
+        LogSlot &slot = ring.slots[ring.tail % kRingSlots];
+        const uint32_t expected = ring.tail + 1;
+        const uint32_t before = slot.ticket.load(std::memory_order_acquire);
+        if (before != expected) {
+            if (static_cast<int32_t>(before - expected) < 0) {
+                return false;
+            }
+            g_dropped.fetch_add(1, std::memory_order_relaxed);
+            ring.tail++;
+            continue;
+        }
+        memcpy(&out, &slot.record, sizeof(out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const bool torn = slot.ticket.load(std::memory_order_relaxed) != expected;
+        ring.tail++;
+        if (torn || out.arg_size > sizeof(out.args)) {
+            g_dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        return true;
+    }
+}
+
+// Oldest record across the rings, by the microsecond stamp taken when it was logged.
+bool next_record(LogRecord &out) {
+    size_t best = kRingCount;
+    for (size_t i = 0; i < kRingCount; ++i) {
+        if (!g_lookahead_valid[i]) {
+            g_lookahead_valid[i] = take_record(g_rings[i], g_lookahead[i]);
+        }
+        if (g_lookahead_valid[i] &&
+            (best == kRingCount ||
+             static_cast<int32_t>(g_lookahead[i].us - g_lookahead[best].us) < 0)) {
+            best = i;
+        }
+    }
+    if (best == kRingCount) {
+        return false;
+    }
+    out = g_lookahead[best];
+    g_lookahead_valid[best] = false;
+    return true;
+}
 
 bool storeRecentInBuffer(Logger::RecentEntry *buffer,
                          size_t capacity,
@@ -87,6 +274,7 @@ HardwareSerial *Logger::serial_ = &Serial;
 Logger::Level Logger::level_ = Logger::Info;
 bool Logger::serial_output_enabled_ = true;
 bool Logger::sensors_serial_output_enabled_ = true;
+std::atomic<bool> Logger::deferred_{false};
 Logger::RecentEntry Logger::recent_[Logger::kRecentCapacity];
 size_t Logger::recent_head_ = 0;
 size_t Logger::recent_count_ = 0;
@@ -98,6 +286,11 @@ uint32_t Logger::recent_alert_seq_ = 0;
 void Logger::begin(HardwareSerial &serial, Level level) {
     serial_ = &serial;
     level_ = level;
+#ifndef UNIT_TEST
+    if (!g_drain_mutex) {
+        g_drain_mutex = xSemaphoreCreateMutexStatic(&g_drain_mutex_buffer);
+    }
+#endif
 }
 
 void Logger::setLevel(Level level) {
@@ -139,21 +332,127 @@ const char *Logger::levelName(Level level) {
     }
 }
 
-void Logger::log(Level level, const char *tag, const char *fmt, ...) {
-    va_list args;
-    va_start(args, fmt);
-    vlog(level, tag, fmt, args);
-    va_end(args);
+bool Logger::ArgWriter::put(ArgKind kind, const void *value, size_t length) {
+    if (truncated || size + 1 + length > sizeof(data)) {
+        truncated = true;
+        return false;
+    }
+    data[size++] = kind;
+    memcpy(&data[size], value, length);
+    size = static_cast<uint8_t>(size + length);
+    return true;
+}
+
+void Logger::ArgWriter::int32(uint32_t value) {
+    put(ArgInt32, &value, sizeof(value));
 }
 
-void Logger::vlog(Level level, const char *tag, const char *fmt, va_list args) {
-    if (level > level_) {
+void Logger::ArgWriter::int64(uint64_t value) {
+    put(ArgInt64, &value, sizeof(value));
+}
+
+void Logger::ArgWriter::real(double value) {
+    put(ArgDouble, &value, sizeof(value));
+}
+
+void Logger::ArgWriter::pointer(const void *value) {
+    const uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+    put(ArgPointer, &address, sizeof(address));
+}
+
+void Logger::ArgWriter::string(const char *value) {
+    if (!value) {
+        value = "(null)";
+    }
+    const size_t room = sizeof(data) - size;
+    if (truncated || room < 2) {
+        truncated = true;
         return;
     }
+    size_t limit = room - 2;
+    if (limit > kStringReserveBytes * 2) {
+        limit -= kStringReserveBytes;
+    }
+    if (limit > UINT8_MAX) {
+        limit = UINT8_MAX;
+    }
+    size_t length = 0;
+    while (length < limit && value[length] != '\0') {
+        length++;
+    }
+    data[size++] = ArgString;
+    data[size++] = static_cast<uint8_t>(length);
+    memcpy(&data[size], value, length);
+    size = static_cast<uint8_t>(size + length);
+}
+
+void Logger::record(Level level, const char *tag, const char *fmt, const ArgWriter &args) {
+    const uint32_t ms = now_ms();
+    const uint32_t us = static_cast<uint32_t>(esp_timer_get_time());
+    const bool mirror = MqttEventQueue::instance().captureEnabled();
+
+    LogRing &ring = g_rings[current_ring()];
+    lock_ring(ring);
+    const uint32_t ticket = ring.head.fetch_add(1, std::memory_order_acq_rel);
+    LogSlot &slot = ring.slots[ticket % kRingSlots];
+    slot.ticket.store(ticket, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    LogRecord &rec = slot.record;
+    rec.ms = ms;
+    rec.us = us;
+    rec.tag = tag;
+    rec.fmt = fmt;
+    rec.level = static_cast<uint8_t>(level);
+    rec.flags = mirror ? kFlagMqttCapture : 0;
+    rec.arg_size = args.size;
+    memcpy(rec.args, args.data, args.size);
+    slot.ticket.store(ticket + 1, std::memory_order_release);
+    unlock_ring(ring);
+    g_recorded.fetch_add(1, std::memory_order_relaxed);
+
+    // Warnings and errors reach RTC memory before this call returns: a panic or task watchdog
+    // reset can come before the drain task runs again, and it is the lines just ahead of one
+    // that the retained log is for. Only the part that fits a retained line is formatted.
+    if (level <= Warn) {
+        char retained[sizeof(RetainedLog::Line::message)];
+        formatArgs(fmt, args.data, args.size, retained, sizeof(retained));
+        RetainedLog::instance().append(level, tag, retained, ms);
+    }
+
+    // Someone already draining picks this record up before they let go of the lock.
+    if (!deferred_.load(std::memory_order_acquire) && try_lock_drain()) {
+        drainLocked();
+        unlock_drain();
+    }
+}
 
-    char buffer[kLogBufferSize];
-    vsnprintf(buffer, sizeof(buffer), fmt, args);
+void Logger::drain() {
+    lock_drain();
+    drainLocked();
+    unlock_drain();
+}
+
+void Logger::drainLocked() {
+    char message[kLogBufferSize];
+    LogRecord rec;
+    while (next_record(rec)) {
+        formatArgs(rec.fmt, rec.args, rec.arg_size, message, sizeof(message));
+        emit(static_cast<Level>(rec.level), rec.tag, message, rec.ms,
+             (rec.flags & kFlagMqttCapture) != 0);
+    }
+    const uint32_t dropped = g_dropped.load(std::memory_order_relaxed);
+    if (dropped != g_dropped_reported) {
+        snprintf(message, sizeof(message), "%lu log records dropped",
+                 static_cast<unsigned long>(dropped - g_dropped_reported));
+        g_dropped_reported = dropped;
+        const uint32_t ms = now_ms();
+        RetainedLog::instance().append(Warn, "Log", message, ms);
+        emit(Warn, "Log", message, ms, true);
+    }
+}
 
+void Logger::emit(Level level, const char *tag, const char *message, uint32_t ms,
+                  bool mirror_to_mqtt) {
     bool print_to_serial = (serial_ && serial_output_enabled_);
     if (print_to_serial && !sensors_serial_output_enabled_ && tag && strcmp(tag, "Sensors") == 0) {
         print_to_serial = false;
@@ -169,18 +468,220 @@ void Logger::vlog(Level level, const char *tag, const char *fmt, va_list args) {
             serial_->print(']');
         }
         serial_->print(' ');
-        serial_->println(buffer);
+        serial_->println(message);
     }
 
-    storeRecent(level, tag, buffer);
+    storeRecent(level, tag, message, ms, mirror_to_mqtt);
+    if (level > Warn) {
+        // Warnings and errors were retained when they were recorded.
+        RetainedLog::instance().append(level, tag, message, ms);
+    }
 }
 
-void Logger::storeRecent(Level level, const char *tag, const char *message) {
-    uint32_t now_ms = 0;
-#if defined(ARDUINO)
-    now_ms = millis();
-#endif
+size_t Logger::formatArgs(const char *fmt, const uint8_t *args, size_t arg_size, char *out,
+                          size_t out_size) {
+    if (!out || out_size == 0) {
+        return 0;
+    }
+    size_t len = 0;
+    size_t pos = 0;
+    // Yields the next packed argument; false once they run out.
+    auto next_arg = [&](uint8_t &kind, const uint8_t *&value, size_t &length) -> bool {
+        if (pos >= arg_size) {
+            return false;
+        }
+        kind = args[pos++];
+        switch (kind) {
+            case ArgInt32:
+                length = sizeof(uint32_t);
+                break;
+            case ArgInt64:
+            case ArgDouble:
+            case ArgPointer:
+                length = sizeof(uint64_t);
+                break;
+            case ArgString:
+                if (pos >= arg_size) {
+                    return false;
+                }
+                length = args[pos++];
+                break;
+            default:
+                pos = arg_size;
+                return false;
+        }
+        if (pos + length > arg_size) {
+            pos = arg_size;
+            return false;
+        }
+        value = &args[pos];
+        pos += length;
+        return true;
+    };
+    auto append = [&](const char *text) {
+        while (*text && len + 1 < out_size) {
+            out[len++] = *text++;
+        }
+    };
+
+    const char *p = fmt ? fmt : "";
+    char spec[24];
+    char piece[kLogBufferSize];
+    while (*p && len + 1 < out_size) {
+        if (*p != '%') {
+            out[len++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[len++] = '%';
+            p += 2;
+            continue;
+        }
+        size_t spec_len = 0;
+        spec[spec_len++] = *p++;
+        auto add_spec = [&](char c) {
+            if (spec_len + 4 < sizeof(spec)) {
+                spec[spec_len++] = c;
+            }
+        };
+        // '*' takes its value from the arguments, like printf does.
+        auto add_number = [&]() {
+            if (*p == '*') {
+                ++p;
+                uint8_t kind = 0;
+                const uint8_t *value = nullptr;
+                size_t length = 0;
+                int32_t number = 0;
+                if (next_arg(kind, value, length) && kind == ArgInt32) {
+                    memcpy(&number, value, sizeof(number));
+                }
+                char digits[12];
+                snprintf(digits, sizeof(digits), "%ld", static_cast<long>(number));
+                for (const char *d = digits; *d; ++d) {
+                    add_spec(*d);
+                }
+                return;
+            }
+            while (*p >= '0' && *p <= '9') {
+                add_spec(*p++);
+            }
+        };
+        while (*p && strchr("-+ #0", *p)) {
+            add_spec(*p++);
+        }
+        add_number();
+        if (*p == '.') {
+            add_spec(*p++);
+            add_number();
+        }
+        // The packed width replaces whatever length modifier the format used.
+        while (*p && strchr("hlLqjzt", *p)) {
+            ++p;
+        }
+        const char conv = *p;
+        if (conv == '\0') {
+            break;
+        }
+        ++p;
+
+        uint8_t kind = 0;
+        const uint8_t *value = nullptr;
+        size_t length = 0;
+        const bool has_arg = conv != 'n' && next_arg(kind, value, length);
+        bool ok = false;
+        uint64_t bits = 0;
+        if (has_arg && kind != ArgString) {
+            memcpy(&bits, value, length);
+        }
+        switch (conv) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X': {
+                if (!has_arg || kind == ArgDouble || kind == ArgString) {
+                    break;
+                }
+                const bool is_signed = conv == 'd' || conv == 'i';
+                if (kind == ArgInt32) {
+                    add_spec(conv);
+                    spec[spec_len] = '\0';
+                    const uint32_t word = static_cast<uint32_t>(bits);
+                    if (is_signed) {
+                        snprintf(piece, sizeof(piece), spec, static_cast<int>(static_cast<int32_t>(word)));
+                    } else {
+                        snprintf(piece, sizeof(piece), spec, static_cast<unsigned>(word));
+                    }
+                } else {
+                    add_spec('l');
+                    add_spec('l');
+                    add_spec(conv);
+                    spec[spec_len] = '\0';
+                    if (is_signed) {
+                        snprintf(piece, sizeof(piece), spec, static_cast<long long>(bits));
+                    } else {
+                        snprintf(piece, sizeof(piece), spec, static_cast<unsigned long long>(bits));
+                    }
+                }
+                ok = true;
+                break;
+            }
+            case 'c':
+                if (has_arg && kind == ArgInt32) {
+                    add_spec(conv);
+                    spec[spec_len] = '\0';
+                    snprintf(piece, sizeof(piece), spec, static_cast<int>(bits));
+                    ok = true;
+                }
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                if (has_arg && kind == ArgDouble) {
+                    double real = 0.0;
+                    memcpy(&real, value, sizeof(real));
+                    add_spec(conv);
+                    spec[spec_len] = '\0';
+                    snprintf(piece, sizeof(piece), spec, real);
+                    ok = true;
+                }
+                break;
+            case 's':
+                if (has_arg && kind == ArgString) {
+                    char text[UINT8_MAX + 1];
+                    memcpy(text, value, length);
+                    text[length] = '\0';
+                    add_spec(conv);
+                    spec[spec_len] = '\0';
+                    snprintf(piece, sizeof(piece), spec, text);
+                    ok = true;
+                }
+                break;
+            case 'p':
+                if (has_arg && kind == ArgPointer) {
+                    snprintf(piece, sizeof(piece), "0x%llx", static_cast<unsigned long long>(bits));
+                    ok = true;
+                }
+                break;
+            case 'n':
+                continue;
+            default:
+                break;
+        }
+        append(ok ? piece : "?");
+    }
+    out[len] = '\0';
+    return len;
+}
 
+void Logger::storeRecent(Level level, const char *tag, const char *message, uint32_t now_ms,
+                         bool mirror_to_mqtt) {
     char tag_buf[sizeof(RecentEntry::tag)];
     char message_buf[sizeof(RecentEntry::message)];
     tag_buf[0] = '\0';
@@ -199,7 +700,7 @@ void Logger::storeRecent(Level level, const char *tag, const char *message) {
         storeRecentInBuffer(recent_, kRecentCapacity, recent_head_, recent_count_,
                             level, tag_buf, message_buf, now_ms);
 
-    if (stored_recent) {
+    if (stored_recent && mirror_to_mqtt) {
         RecentEntry entry{};
         entry.ms = now_ms;
         entry.level = level;
@@ -208,7 +709,7 @@ void Logger::storeRecent(Level level, const char *tag, const char *message) {
         strncpy(entry.message, message_buf, sizeof(entry.message) - 1);
         entry.message[sizeof(entry.message) - 1] = '\0';
         if (SystemEventPolicy::shouldEmit(entry)) {
-            MqttEventQueue::instance().enqueueIfCapturing(entry);
+            MqttEventQueue::instance().enqueue(entry);
         }
     }
 
@@ -232,21 +733,77 @@ void Logger::storeRecent(Level level, const char *tag, const char *message) {
     }
 }
 
+#ifndef UNIT_TEST
+void Logger::drainTaskMain(void *) {
+    for (;;) {
+        drain();
+        vTaskDelay(pdMS_TO_TICKS(kDrainIntervalMs));
+    }
+}
+#endif
+
+bool Logger::startDrainTask() {
+#ifdef UNIT_TEST
+    return false;
+#else
+    if (g_drain_task != nullptr) {
+        return true;
+    }
+    if (!g_drain_mutex) {
+        g_drain_mutex = xSemaphoreCreateMutexStatic(&g_drain_mutex_buffer);
+    }
+    TaskHandle_t created = nullptr;
+    const BaseType_t ok = xTaskCreatePinnedToCore(drainTaskMain,
+                                                  "log",
+                                                  kDrainTaskStackSize,
+                                                  nullptr,
+                                                  kDrainTaskPriority,
+                                                  &created,
+                                                  kDrainTaskCore);
+    if (ok != pdPASS || created == nullptr) {
+        return false;
+    }
+    g_drain_task = created;
+    deferred_.store(true, std::memory_order_release);
+    return true;
+#endif
+}
+
+void Logger::stats(Stats &out) {
+    out.recorded = g_recorded.load(std::memory_order_relaxed);
+    out.dropped = g_dropped.load(std::memory_order_relaxed);
+}
+
 size_t Logger::copyRecent(RecentEntry *out, size_t max_entries) {
-    return copyRecentFromBuffer(recent_, kRecentCapacity, recent_head_, recent_count_, out, max_entries);
+    lock_drain();
+    drainLocked();
+    const size_t copied =
+        copyRecentFromBuffer(recent_, kRecentCapacity, recent_head_, recent_count_, out, max_entries);
+    unlock_drain();
+    return copied;
 }
 
 size_t Logger::copyRecentAlerts(RecentEntry *out, size_t max_entries) {
-    return copyRecentFromBuffer(recent_alerts_, kRecentAlertCapacity,
-                                recent_alert_head_, recent_alert_count_, out, max_entries);
+    lock_drain();
+    drainLocked();
+    const size_t copied = copyRecentFromBuffer(recent_alerts_, kRecentAlertCapacity,
+                                               recent_alert_head_, recent_alert_count_, out,
+                                               max_entries);
+    unlock_drain();
+    return copied;
 }
 
 uint32_t Logger::latestRecentAlertSeq() {
-    return recent_alert_seq_;
+    lock_drain();
+    drainLocked();
+    const uint32_t seq = recent_alert_seq_;
+    unlock_drain();
+    return seq;
 }
 
 #ifdef UNIT_TEST
 void Logger::resetRecentForTest() {
+    lock_drain();
     memset(recent_, 0, sizeof(recent_));
     memset(recent_alerts_, 0, sizeof(recent_alerts_));
     recent_head_ = 0;
@@ -254,5 +811,15 @@ void Logger::resetRecentForTest() {
     recent_alert_head_ = 0;
     recent_alert_count_ = 0;
     recent_alert_seq_ = 0;
+    for (size_t i = 0; i < kRingCount; ++i) {
+        g_rings[i].tail = g_rings[i].head.load();
+        g_lookahead_valid[i] = false;
+    }
+    g_dropped_reported = g_dropped.load();
+    unlock_drain();
+}
+
+void Logger::setDeferredForTest(bool deferred) {
+    deferred_.store(deferred);
 }
 #endif
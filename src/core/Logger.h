@@ -7,9 +7,20 @@
 #pragma once
 
 #include <Arduino.h>
+#include <atomic>
 #include <stddef.h>
-#include <stdarg.h>
+#include <stdint.h>
+#include <type_traits>
 
+// log() does not format. It stores the tag and format pointers, the arguments packed by type and
+// a timestamp as one record in a lock-free ring for the calling core. drain() formats records
+// oldest first onto serial and into the recent/alert buffers and the MQTT event queue. The drain
+// task calls it periodically, and readers call it before they look: copyRecent(),
+// copyRecentAlerts() and the MQTT event publisher. Until startDrainTask() succeeds, log() drains
+// inline, so early boot output and native tests behave as before.
+//
+// Tags and formats must outlive the record (string literals do). %s arguments are copied, up to
+// what fits in the record.
 class Logger {
 public:
     enum Level {
@@ -27,6 +38,11 @@ public:
         char message[192] = {0};
     };
 
+    struct Stats {
+        uint32_t recorded;
+        uint32_t dropped; // overwritten or torn before a drain reached them
+    };
+
     static void begin(HardwareSerial &serial = Serial, Level level = Info);
     static void setLevel(Level level);
     static Level level();
@@ -34,24 +50,99 @@ public:
     static bool serialOutputEnabled();
     static void setSensorsSerialOutputEnabled(bool enabled);
     static bool sensorsSerialOutputEnabled();
-    static void log(Level level, const char *tag, const char *fmt, ...);
+
+    template <typename... Args>
+    static void log(Level level, const char *tag, const char *fmt, Args... args) {
+        if (level > level_) {
+            return;
+        }
+        ArgWriter writer;
+        packArgs(writer, args...);
+        record(level, tag, fmt, writer);
+    }
+
+    static bool startDrainTask();
+    static void drain();
+    static void stats(Stats &out);
+
     static size_t copyRecent(RecentEntry *out, size_t max_entries);
     static size_t copyRecentAlerts(RecentEntry *out, size_t max_entries);
     static uint32_t latestRecentAlertSeq();
 
 #ifdef UNIT_TEST
     static void resetRecentForTest();
+    // Leaves records in the rings until something drains them, as once the drain task runs.
+    static void setDeferredForTest(bool deferred);
 #endif
 
+    static constexpr size_t kArgBytes = 96;
+
 private:
+    enum ArgKind : uint8_t {
+        ArgInt32 = 1,
+        ArgInt64,
+        ArgDouble,
+        ArgString,
+        ArgPointer
+    };
+
+    struct ArgWriter {
+        uint8_t data[kArgBytes];
+        uint8_t size = 0;
+        bool truncated = false;
+
+        void int32(uint32_t value);
+        void int64(uint64_t value);
+        void real(double value);
+        void string(const char *value);
+        void pointer(const void *value);
+
+    private:
+        bool put(ArgKind kind, const void *value, size_t length);
+    };
+
+    static void packArgs(ArgWriter &) {}
+    template <typename T, typename... Rest>
+    static void packArgs(ArgWriter &writer, T first, Rest... rest) {
+        packArg(writer, first);
+        packArgs(writer, rest...);
+    }
+
+    static void packArg(ArgWriter &writer, const char *value) { writer.string(value); }
+    static void packArg(ArgWriter &writer, char *value) { writer.string(value); }
+    static void packArg(ArgWriter &writer, double value) { writer.real(value); }
+    static void packArg(ArgWriter &writer, std::nullptr_t) { writer.pointer(nullptr); }
+    template <typename T>
+    static void packArg(ArgWriter &writer, T *value) { writer.pointer(value); }
+    // Integers keep the width they had after varargs promotion, so %ld and %lld still line up.
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    packArg(ArgWriter &writer, T value) {
+        if (sizeof(T) > sizeof(uint32_t)) {
+            writer.int64(static_cast<uint64_t>(value));
+        } else {
+            writer.int32(static_cast<uint32_t>(value));
+        }
+    }
+
     static const char *levelName(Level level);
-    static void vlog(Level level, const char *tag, const char *fmt, va_list args);
-    static void storeRecent(Level level, const char *tag, const char *message);
+    static void record(Level level, const char *tag, const char *fmt, const ArgWriter &args);
+    static void drainLocked();
+    static void emit(Level level, const char *tag, const char *message, uint32_t ms,
+                     bool mirror_to_mqtt);
+    static size_t formatArgs(const char *fmt, const uint8_t *args, size_t arg_size, char *out,
+                             size_t out_size);
+    static void storeRecent(Level level, const char *tag, const char *message, uint32_t now_ms,
+                            bool mirror_to_mqtt);
+#ifndef UNIT_TEST
+    static void drainTaskMain(void *arg);
+#endif
 
     static HardwareSerial *serial_;
     static Level level_;
     static bool serial_output_enabled_;
     static bool sensors_serial_output_enabled_;
+    static std::atomic<bool> deferred_;
     static constexpr size_t kRecentCapacity = 64;
     static constexpr size_t kRecentAlertCapacity = 32;
     static RecentEntry recent_[kRecentCapacity];
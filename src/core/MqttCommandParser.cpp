@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/MqttCommandParser.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config/AppConfig.h"
+
+namespace MqttCommandParser {
+
+namespace {
+
+constexpr const char *kCommandSegment = "/command/";
+
+bool parse_uint8_in_range(const char *text, uint8_t min_value, uint8_t max_value, uint8_t &out) {
+    if (!text || text[0] == '\0') {
+        return false;
+    }
+    char *end = nullptr;
+    const long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0') {
+        return false;
+    }
+    if (parsed < static_cast<long>(min_value) || parsed > static_cast<long>(max_value)) {
+        return false;
+    }
+    out = static_cast<uint8_t>(parsed);
+    return true;
+}
+
+bool equals_ignore_case(const char *a, const char *b) {
+    if (!a || !b) {
+        return false;
+    }
+    while (*a && *b) {
+        if (tolower(static_cast<unsigned char>(*a)) != tolower(static_cast<unsigned char>(*b))) {
+            return false;
+        }
+        ++a;
+        ++b;
+    }
+    return (*a == '\0' && *b == '\0');
+}
+
+bool parse_fan_timer_seconds(const char *text, uint32_t &out_seconds) {
+    if (!text || text[0] == '\0') {
+        return false;
+    }
+    for (size_t i = 0; i < kFanTimerOptionCount; ++i) {
+        if (equals_ignore_case(text, kFanTimerOptions[i])) {
+            out_seconds = (i == 0) ? Config::DAC_TIMER_NONE_S : Config::DAC_TIMER_PRESETS_S[i - 1];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_fan_mode_option(const char *text, FanHaMode &out_mode) {
+    if (!text || text[0] == '\0') {
+        return false;
+    }
+    if (equals_ignore_case(text, kFanModeOptions[0])) {
+        out_mode = FanHaMode::Auto;
+        return true;
+    }
+    if (equals_ignore_case(text, kFanModeOptions[1])) {
+        out_mode = FanHaMode::Stopped;
+        return true;
+    }
+    if (equals_ignore_case(text, kFanModeOptions[2])) {
+        out_mode = FanHaMode::Manual;
+        return true;
+    }
+    return false;
+}
+
+bool payload_is_exact(const char *payload, const char *expected) {
+    return payload && expected && strcmp(payload, expected) == 0;
+}
+
+void trim_ascii(char *text) {
+    if (!text) {
+        return;
+    }
+    char *start = text;
+    while (*start && isspace(static_cast<unsigned char>(*start))) {
+        ++start;
+    }
+    char *end = start + strlen(start);
+    while (end > start && isspace(static_cast<unsigned char>(*(end - 1)))) {
+        --end;
+    }
+    size_t len = static_cast<size_t>(end - start);
+    if (start != text) {
+        memmove(text, start, len);
+    }
+    text[len] = '\0';
+}
+
+const char *command_name(const char *topic, const char *base_topic) {
+    if (!topic || !base_topic) {
+        return nullptr;
+    }
+    const size_t base_len = strlen(base_topic);
+    if (strncmp(topic, base_topic, base_len) != 0) {
+        return nullptr;
+    }
+    const char *suffix = topic + base_len;
+    const size_t segment_len = strlen(kCommandSegment);
+    if (strncmp(suffix, kCommandSegment, segment_len) != 0) {
+        return nullptr;
+    }
+    return suffix + segment_len;
+}
+
+} // namespace
+
+bool payloadIsOn(const char *payload) {
+    if (!payload) {
+        return false;
+    }
+    if (equals_ignore_case(payload, "ON") || strcmp(payload, "1") == 0 ||
+        equals_ignore_case(payload, "TRUE") || equals_ignore_case(payload, "PRESS")) {
+        return true;
+    }
+    return false;
+}
+
+bool payloadIsOff(const char *payload) {
+    if (!payload) {
+        return false;
+    }
+    if (equals_ignore_case(payload, "OFF") || strcmp(payload, "0") == 0 ||
+        equals_ignore_case(payload, "FALSE")) {
+        return true;
+    }
+    return false;
+}
+
+Result parse(const char *topic,
+             const uint8_t *payload,
+             size_t length,
+             const char *base_topic,
+             bool auto_night_enabled,
+             MqttPendingCommands &out) {
+    const char *cmd = command_name(topic, base_topic);
+    if (!cmd) {
+        return Result::Ignored;
+    }
+
+    char msg[32];
+    size_t copy_len = length < (sizeof(msg) - 1) ? length : (sizeof(msg) - 1);
+    if (payload && copy_len > 0) {
+        memcpy(msg, payload, copy_len);
+    } else {
+        copy_len = 0;
+    }
+    msg[copy_len] = '\0';
+    trim_ascii(msg);
+
+    const bool is_on = payloadIsOn(msg);
+    const bool is_off = payloadIsOff(msg);
+
+    if (strcmp(cmd, "night_mode") == 0) {
+        if (auto_night_enabled) {
+            return Result::NightModeLocked;
+        }
+        if (is_on || is_off) {
+            out.night_mode_value = is_on;
+            out.night_mode = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "alert_blink") == 0) {
+        if (is_on || is_off) {
+            out.alert_blink_value = is_on;
+            out.alert_blink = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "backlight") == 0) {
+        if (is_on || is_off) {
+            out.backlight_value = is_on;
+            out.backlight = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "fan_mode") == 0) {
+        FanHaMode mode = FanHaMode::Stopped;
+        if (parse_fan_mode_option(msg, mode)) {
+            out.fan_mode_value = mode;
+            out.fan_mode = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "fan_auto") == 0) {
+        if (payload_is_exact(msg, "AUTO") || is_on) {
+            out.fan_mode_value = FanHaMode::Auto;
+            out.fan_mode = true;
+            return Result::Pending;
+        }
+        if (is_off) {
+            out.fan_mode_value = FanHaMode::Stopped;
+            out.fan_mode = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "fan_manual") == 0) {
+        if (payload_is_exact(msg, "MANUAL") || is_on) {
+            out.fan_mode_value = FanHaMode::Manual;
+            out.fan_mode = true;
+            return Result::Pending;
+        }
+        if (is_off) {
+            out.fan_mode_value = FanHaMode::Stopped;
+            out.fan_mode = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "fan_stop") == 0) {
+        if (payload_is_exact(msg, "STOP") || is_on || is_off) {
+            out.fan_mode_value = FanHaMode::Stopped;
+            out.fan_mode = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "fan_manual_percent") == 0) {
+        uint8_t percent = 0;
+        if (parse_uint8_in_range(msg, 10, 100, percent) && (percent % 10u) == 0u) {
+            out.fan_manual_speed_value = static_cast<uint8_t>(percent / 10u);
+            out.fan_manual_speed = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "fan_manual_speed") == 0) {
+        uint8_t speed = 0;
+        if (parse_uint8_in_range(msg, 1, 10, speed)) {
+            out.fan_manual_speed_value = speed;
+            out.fan_manual_speed = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "fan") == 0) {
+        if (is_on) {
+            out.fan_mode_value = FanHaMode::Manual;
+            out.fan_mode = true;
+            return Result::Pending;
+        }
+        if (is_off) {
+            out.fan_mode_value = FanHaMode::Stopped;
+            out.fan_mode = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "fan_percentage") == 0) {
+        uint8_t speed = 0;
+        if (parse_uint8_in_range(msg, 0, 100, speed)) {
+            if (speed == 0) {
+                out.fan_mode_value = FanHaMode::Stopped;
+                out.fan_mode = true;
+            } else {
+                uint32_t manual_step = (static_cast<uint32_t>(speed) + 9u) / 10u;
+                if (manual_step < 1u) {
+                    manual_step = 1u;
+                } else if (manual_step > 10u) {
+                    manual_step = 10u;
+                }
+                out.fan_manual_speed_value = static_cast<uint8_t>(manual_step);
+                out.fan_manual_speed = true;
+            }
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "fan_timer") == 0) {
+        uint32_t timer_seconds = 0;
+        if (parse_fan_timer_seconds(msg, timer_seconds)) {
+            out.fan_timer_seconds = timer_seconds;
+            out.fan_timer = true;
+            return Result::Pending;
+        }
+    } else if (strcmp(cmd, "restart") == 0) {
+        if (is_on) {
+            out.restart = true;
+            return Result::Pending;
+        }
+    }
+    return Result::Ignored;
+}
+
+} // namespace MqttCommandParser
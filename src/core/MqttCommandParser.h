@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/MqttRuntimeState.h"
+
+namespace MqttCommandParser {
+
+enum class Result : uint8_t {
+    Ignored = 0,
+    Pending,
+    NightModeLocked,
+};
+
+constexpr const char *kFanTimerOptions[] = {
+    "Off",
+    "10 min",
+    "30 min",
+    "1 h",
+    "2 h",
+    "4 h",
+    "8 h",
+};
+constexpr size_t kFanTimerOptionCount = sizeof(kFanTimerOptions) / sizeof(kFanTimerOptions[0]);
+
+constexpr const char *kFanModeOptions[] = {
+    "Auto",
+    "Stopped",
+    "Manual",
+};
+constexpr size_t kFanModeOptionCount = sizeof(kFanModeOptions) / sizeof(kFanModeOptions[0]);
+
+bool payloadIsOn(const char *payload);
+bool payloadIsOff(const char *payload);
+
+// Maps <base_topic>/command/<name> plus payload onto pending commands. Only fields for a
+// recognised command are written to `out`; it is left untouched otherwise.
+Result parse(const char *topic,
+             const uint8_t *payload,
+             size_t length,
+             const char *base_topic,
+             bool auto_night_enabled,
+             MqttPendingCommands &out);
+
+} // namespace MqttCommandParser
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/MqttConnectionPolicy.h"
+
+#include "config/AppConfig.h"
+
+namespace MqttConnectionPolicy {
+
+namespace {
+
+constexpr int kMqttConnectTimeoutShortMs = 3000;
+constexpr int kMqttConnectTimeoutSlowMs = 3000;
+constexpr uint8_t kMqttLongRetryLogEveryAttempts = 6;
+
+} // namespace
+
+uint8_t retryStageForAttempts(uint32_t failed_attempts) {
+    if (failed_attempts <= Config::MQTT_RETRY_SHORT_ATTEMPTS) {
+        return 0;
+    }
+    const uint32_t medium_limit =
+        static_cast<uint32_t>(Config::MQTT_RETRY_SHORT_ATTEMPTS) +
+        static_cast<uint32_t>(Config::MQTT_RETRY_MEDIUM_ATTEMPTS);
+    if (failed_attempts <= medium_limit) {
+        return 1;
+    }
+    return 2;
+}
+
+uint32_t retryDelayMsForAttempts(uint32_t failed_attempts) {
+    switch (retryStageForAttempts(failed_attempts)) {
+        case 0: return Config::MQTT_RETRY_MS;
+        case 1: return Config::MQTT_RETRY_MEDIUM_MS;
+        default: return Config::MQTT_RETRY_LONG_MS;
+    }
+}
+
+bool shouldLogConnectFailure(uint32_t failed_attempts) {
+    const uint8_t stage = retryStageForAttempts(failed_attempts);
+    if (stage < 2) {
+        return true;
+    }
+    const uint32_t long_stage_attempt =
+        failed_attempts -
+        (static_cast<uint32_t>(Config::MQTT_RETRY_SHORT_ATTEMPTS) +
+         static_cast<uint32_t>(Config::MQTT_RETRY_MEDIUM_ATTEMPTS));
+    return long_stage_attempt <= 1 ||
+           (long_stage_attempt % kMqttLongRetryLogEveryAttempts) == 0;
+}
+
+int connectTimeoutMsForAttempts(uint32_t failed_attempts) {
+    return retryStageForAttempts(failed_attempts) >= 1
+               ? kMqttConnectTimeoutSlowMs
+               : kMqttConnectTimeoutShortMs;
+}
+
+bool connectAttemptDue(uint32_t failed_attempts, uint32_t last_attempt_ms, uint32_t now_ms) {
+    const bool immediate_first_attempt = (failed_attempts == 0 && last_attempt_ms == 0);
+    return immediate_first_attempt ||
+           (now_ms - last_attempt_ms >= retryDelayMsForAttempts(failed_attempts));
+}
+
+bool statePublishDue(bool requested, uint32_t last_publish_ms, uint32_t now_ms) {
+    return requested || (now_ms - last_publish_ms >= Config::MQTT_PUBLISH_MS);
+}
+
+} // namespace MqttConnectionPolicy
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stdint.h>
+
+namespace MqttConnectionPolicy {
+
+// 0 = short (30 s), 1 = medium (2 min), 2 = long (10 min) retry stage.
+uint8_t retryStageForAttempts(uint32_t failed_attempts);
+uint32_t retryDelayMsForAttempts(uint32_t failed_attempts);
+bool shouldLogConnectFailure(uint32_t failed_attempts);
+int connectTimeoutMsForAttempts(uint32_t failed_attempts);
+bool connectAttemptDue(uint32_t failed_attempts, uint32_t last_attempt_ms, uint32_t now_ms);
+bool statePublishDue(bool requested, uint32_t last_publish_ms, uint32_t now_ms);
+
+} // namespace MqttConnectionPolicy
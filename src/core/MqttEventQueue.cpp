@@ -72,6 +72,18 @@ bool MqttEventQueue::peek(Logger::RecentEntry &out) const {
     return true;
 }
 
+bool MqttEventQueue::peekAt(size_t index, Logger::RecentEntry &out) const {
+    lock();
+    if (index >= count_) {
+        unlock();
+        return false;
+    }
+    const size_t start = (head_ + kCapacity - count_) % kCapacity;
+    out = entries_[(start + index) % kCapacity];
+    unlock();
+    return true;
+}
+
 bool MqttEventQueue::discardFront() {
     lock();
     if (count_ == 0) {
@@ -83,6 +95,22 @@ bool MqttEventQueue::discardFront() {
     return true;
 }
 
+bool MqttEventQueue::discardAt(size_t index) {
+    lock();
+    if (index >= count_) {
+        unlock();
+        return false;
+    }
+    const size_t start = (head_ + kCapacity - count_) % kCapacity;
+    for (size_t i = index; i + 1 < count_; ++i) {
+        entries_[(start + i) % kCapacity] = entries_[(start + i + 1) % kCapacity];
+    }
+    head_ = (head_ + kCapacity - 1) % kCapacity;
+    count_--;
+    unlock();
+    return true;
+}
+
 bool MqttEventQueue::pop(Logger::RecentEntry &out) {
     lock();
     if (count_ == 0) {
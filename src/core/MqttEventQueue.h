@@ -36,8 +36,13 @@ public:
     bool hasPending() const;
     size_t size() const;
     bool peek(Logger::RecentEntry &out) const;
+    // Index 0 is the oldest entry.
+    bool peekAt(size_t index, Logger::RecentEntry &out) const;
     bool discardFront();
+    bool discardAt(size_t index);
     bool pop(Logger::RecentEntry &out);
+    // False inside a CapturePause; the logger samples it when a record is made.
+    bool captureEnabled() const;
 
 private:
     MqttEventQueue();
@@ -46,7 +51,6 @@ private:
     void unlock() const;
     void pauseCapture();
     void resumeCapture();
-    bool captureEnabled() const;
 
     static constexpr size_t kCapacity = 24;
 
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/MqttPublishScheduler.h"
+
+namespace {
+
+size_t class_index(MqttPublishClass cls) {
+    const size_t index = static_cast<size_t>(cls);
+    return index < kMqttPublishClassCount ? index : 0;
+}
+
+} // namespace
+
+void MqttPublishScheduler::configure(uint16_t bucket_capacity, uint32_t refill_ms) {
+    capacity_ = bucket_capacity > 0 ? bucket_capacity : 1;
+    refill_ms_ = refill_ms > 0 ? refill_ms : 1;
+    if (tokens_ > capacity_) {
+        tokens_ = capacity_;
+    }
+    stats_.bucket_capacity = capacity_;
+    stats_.tokens = tokens_;
+}
+
+void MqttPublishScheduler::reset(uint32_t now_ms) {
+    for (size_t i = 0; i < kMqttPublishClassCount; ++i) {
+        stats_.classes[i].depth = 0;
+        pending_since_ms_[i] = 0;
+        held_[i] = false;
+    }
+    tokens_ = capacity_;
+    last_refill_ms_ = now_ms;
+    throttled_ = false;
+    stats_.tokens = tokens_;
+}
+
+void MqttPublishScheduler::setDepth(MqttPublishClass cls, uint16_t depth, uint32_t now_ms) {
+    const size_t index = class_index(cls);
+    MqttPublishClassStats &entry = stats_.classes[index];
+    if (entry.depth == 0 && depth > 0) {
+        pending_since_ms_[index] = now_ms;
+    }
+    entry.depth = depth;
+    if (depth == 0) {
+        held_[index] = false;
+    }
+}
+
+void MqttPublishScheduler::requestLatest(MqttPublishClass cls, uint32_t now_ms) {
+    const size_t index = class_index(cls);
+    if (stats_.classes[index].depth > 0) {
+        stats_.classes[index].coalesced++;
+        return;
+    }
+    setDepth(cls, 1, now_ms);
+}
+
+bool MqttPublishScheduler::next(uint32_t now_ms, bool low_priority_paused, MqttPublishClass &out) {
+    refill(now_ms);
+    for (size_t i = 0; i < kMqttPublishClassCount; ++i) {
+        if (stats_.classes[i].depth == 0) {
+            continue;
+        }
+        const MqttPublishClass cls = static_cast<MqttPublishClass>(i);
+        if (low_priority_paused && isLowPriority(cls)) {
+            if (!held_[i]) {
+                held_[i] = true;
+                stats_.classes[i].paused++;
+            }
+            continue;
+        }
+        held_[i] = false;
+        if (tokens_ == 0) {
+            if (!throttled_) {
+                throttled_ = true;
+                stats_.throttled++;
+            }
+            return false;
+        }
+        throttled_ = false;
+        out = cls;
+        return true;
+    }
+    return false;
+}
+
+void MqttPublishScheduler::markSent(MqttPublishClass cls, uint32_t now_ms, uint16_t messages) {
+    const size_t index = class_index(cls);
+    MqttPublishClassStats &entry = stats_.classes[index];
+    if (messages == 0) {
+        return;
+    }
+    tokens_ = tokens_ > messages ? static_cast<uint16_t>(tokens_ - messages) : 0;
+    stats_.tokens = tokens_;
+    entry.sent += messages;
+    const uint32_t latency_ms = now_ms - pending_since_ms_[index];
+    entry.last_latency_ms = latency_ms;
+    if (latency_ms > entry.max_latency_ms) {
+        entry.max_latency_ms = latency_ms;
+    }
+    entry.depth = entry.depth > messages ? static_cast<uint16_t>(entry.depth - messages) : 0;
+}
+
+uint16_t MqttPublishScheduler::depth(MqttPublishClass cls) const {
+    return stats_.classes[class_index(cls)].depth;
+}
+
+bool MqttPublishScheduler::hasLowPriorityPending() const {
+    for (size_t i = 0; i < kMqttPublishClassCount; ++i) {
+        if (stats_.classes[i].depth > 0 && isLowPriority(static_cast<MqttPublishClass>(i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MqttPublishScheduler::isLowPriority(MqttPublishClass cls) {
+    return cls == MqttPublishClass::Discovery || cls == MqttPublishClass::Backfill;
+}
+
+const char *MqttPublishScheduler::className(MqttPublishClass cls) {
+    switch (cls) {
+        case MqttPublishClass::Alert: return "alert";
+        case MqttPublishClass::State: return "state";
+        case MqttPublishClass::Discovery: return "discovery";
+        case MqttPublishClass::Backfill: return "backfill";
+        default: return "unknown";
+    }
+}
+
+void MqttPublishScheduler::refill(uint32_t now_ms) {
+    const uint32_t elapsed = now_ms - last_refill_ms_;
+    if (elapsed < refill_ms_) {
+        return;
+    }
+    const uint32_t steps = elapsed / refill_ms_;
+    last_refill_ms_ += steps * refill_ms_;
+    const uint32_t refilled = static_cast<uint32_t>(tokens_) + steps;
+    tokens_ = refilled >= capacity_ ? capacity_ : static_cast<uint16_t>(refilled);
+    if (tokens_ == capacity_) {
+        last_refill_ms_ = now_ms;
+    }
+    stats_.tokens = tokens_;
+}
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Highest priority first.
+enum class MqttPublishClass : uint8_t {
+    Alert = 0,
+    State,
+    Discovery,
+    Backfill,
+    Count,
+};
+
+constexpr size_t kMqttPublishClassCount = static_cast<size_t>(MqttPublishClass::Count);
+
+struct MqttPublishClassStats {
+    uint16_t depth = 0;
+    uint32_t sent = 0;
+    // Requests folded into a message that was already waiting.
+    uint32_t coalesced = 0;
+    // Times the class was held back by a low-priority pause.
+    uint32_t paused = 0;
+    // Time from the class becoming non-empty to a send.
+    uint32_t last_latency_ms = 0;
+    uint32_t max_latency_ms = 0;
+};
+
+struct MqttPublishStats {
+    MqttPublishClassStats classes[kMqttPublishClassCount]{};
+    uint16_t tokens = 0;
+    uint16_t bucket_capacity = 0;
+    // Times work was left waiting because the bucket was empty.
+    uint32_t throttled = 0;
+};
+
+// Decides which class of MQTT message goes out next. Payloads stay with the caller; the
+// scheduler only tracks how many messages of each class are waiting and paces them through
+// a token bucket.
+class MqttPublishScheduler {
+public:
+    void configure(uint16_t bucket_capacity, uint32_t refill_ms);
+    // Drops pending work and refills the bucket, e.g. after a reconnect.
+    void reset(uint32_t now_ms);
+
+    void setDepth(MqttPublishClass cls, uint16_t depth, uint32_t now_ms);
+    // Marks a single latest-value message pending; while one is waiting, further requests
+    // coalesce into it.
+    void requestLatest(MqttPublishClass cls, uint32_t now_ms);
+
+    // Highest-priority class with work and a token. Low-priority classes are skipped while
+    // `low_priority_paused` is set.
+    bool next(uint32_t now_ms, bool low_priority_paused, MqttPublishClass &out);
+    void markSent(MqttPublishClass cls, uint32_t now_ms, uint16_t messages = 1);
+
+    uint16_t depth(MqttPublishClass cls) const;
+    uint16_t tokens() const { return tokens_; }
+    bool hasLowPriorityPending() const;
+    const MqttPublishStats &stats() const { return stats_; }
+
+    static bool isLowPriority(MqttPublishClass cls);
+    static const char *className(MqttPublishClass cls);
+
+private:
+    void refill(uint32_t now_ms);
+
+    MqttPublishStats stats_{};
+    uint32_t pending_since_ms_[kMqttPublishClassCount]{};
+    bool held_[kMqttPublishClassCount]{};
+    uint16_t capacity_ = 1;
+    uint16_t tokens_ = 1;
+    uint32_t refill_ms_ = 1;
+    uint32_t last_refill_ms_ = 0;
+    bool throttled_ = false;
+};
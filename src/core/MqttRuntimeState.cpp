@@ -6,23 +6,19 @@
 
 #include "core/MqttRuntimeState.h"
 
-MqttRuntimeState::MqttRuntimeState() {
+MqttRuntimeState::MqttRuntimeState(const SensorSnapshot &sensors) : sensors_(sensors) {
 #ifndef UNIT_TEST
     mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
 #endif
 }
 
-void MqttRuntimeState::update(const SensorData &data,
-                              const FanStateSnapshot &fan,
-                              bool gas_warmup,
+void MqttRuntimeState::update(const FanStateSnapshot &fan,
                               bool night_mode,
                               bool alert_blink,
                               bool backlight_on,
                               bool auto_night_enabled) {
     lock();
-    snapshot_.data = data;
     snapshot_.fan = fan;
-    snapshot_.gas_warmup = gas_warmup;
     snapshot_.night_mode = night_mode;
     snapshot_.alert_blink = alert_blink;
     snapshot_.backlight_on = backlight_on;
@@ -41,6 +37,10 @@ MqttRuntimeSnapshot MqttRuntimeState::snapshot() const {
     lock();
     MqttRuntimeSnapshot copy = snapshot_;
     unlock();
+    SensorSample sample;
+    copy.sensor_generation = sensors_.read(sample);
+    copy.data = sample.data;
+    copy.gas_warmup = sample.gas_warmup;
     return copy;
 }
 
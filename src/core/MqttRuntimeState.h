@@ -16,6 +16,7 @@
 #endif
 
 #include "config/AppData.h"
+#include "core/SensorSnapshot.h"
 #include "modules/FanStateSnapshot.h"
 
 struct MqttRuntimeSnapshot {
@@ -26,6 +27,7 @@ struct MqttRuntimeSnapshot {
     bool alert_blink = false;
     bool backlight_on = false;
     bool auto_night_enabled = false;
+    uint32_t sensor_generation = 0;
 };
 
 enum class FanHaMode : uint8_t {
@@ -52,11 +54,11 @@ struct MqttPendingCommands {
 
 class MqttRuntimeState {
 public:
-    MqttRuntimeState();
+    // Sensor readings come straight from the acquisition snapshot; update() only carries
+    // the UI-owned state.
+    explicit MqttRuntimeState(const SensorSnapshot &sensors);
 
-    void update(const SensorData &data,
-                const FanStateSnapshot &fan,
-                bool gas_warmup,
+    void update(const FanStateSnapshot &fan,
                 bool night_mode,
                 bool alert_blink,
                 bool backlight_on,
@@ -78,6 +80,7 @@ private:
     mutable StaticSemaphore_t mutex_buffer_{};
     mutable SemaphoreHandle_t mutex_ = nullptr;
 #endif
+    const SensorSnapshot &sensors_;
     MqttRuntimeSnapshot snapshot_{};
     MqttPendingCommands pending_commands_{};
     std::atomic<bool> publish_after_update_{false};
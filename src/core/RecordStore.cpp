@@ -0,0 +1,652 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/RecordStore.h"
+
+#include <string.h>
+
+#include "core/Logger.h"
+
+namespace {
+
+// Log layout: file header, then records of
+//   u16 magic | u8 flags | u8 key_len | u32 sequence | u32 len | key | data | u32 crc32
+// with the CRC covering everything after the magic. All integers are little endian.
+constexpr uint8_t kFileMagic[4] = {'R', 'L', 'O', 'G'};
+constexpr uint16_t kFileVersion = 1;
+constexpr size_t kFileHeaderSize = 8;
+constexpr uint16_t kRecordMagic = 0x5352;
+constexpr size_t kRecordHeaderSize = 12;
+constexpr size_t kRecordTrailerSize = 4;
+constexpr uint8_t kFlagCommit = 0x01;
+constexpr uint8_t kFlagTombstone = 0x02;
+constexpr size_t kChunkSize = 128;
+
+// Lifetime wear counters, rewritten by every compaction. Not a valid storage path, so it never
+// collides with caller keys.
+constexpr const char *kWearKey = "#wear";
+struct WearRecord {
+    uint32_t version = 1;
+    uint32_t compactions = 0;
+    uint64_t lifetime_bytes = 0;
+};
+
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len) {
+    static const uint32_t kTable[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+        0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc = kTable[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = kTable[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+void put_u16(uint8_t *out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void put_u32(uint8_t *out, uint32_t value) {
+    for (size_t i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint16_t get_u16(const uint8_t *in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+uint32_t get_u32(const uint8_t *in) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+void encode_header(uint8_t *out, uint8_t flags, size_t key_len, uint32_t sequence, size_t len) {
+    put_u16(out, kRecordMagic);
+    out[2] = flags;
+    out[3] = static_cast<uint8_t>(key_len);
+    put_u32(out + 4, sequence);
+    put_u32(out + 8, static_cast<uint32_t>(len));
+}
+
+size_t record_size(size_t key_len, size_t len) {
+    return kRecordHeaderSize + key_len + len + kRecordTrailerSize;
+}
+
+bool valid_key(const char *key) {
+    if (!key) {
+        return false;
+    }
+    const size_t len = strlen(key);
+    return len > 0 && len <= RecordStore::kMaxKeyLen && key[0] != kWearKey[0];
+}
+
+} // namespace
+
+bool RecordStore::Batch::put(const char *key, const void *data, size_t len) {
+    if (count_ >= kMaxBatch || !valid_key(key) || (!data && len > 0)) {
+        return false;
+    }
+    ops_[count_++] = {key, static_cast<const uint8_t *>(data), len, false};
+    return true;
+}
+
+bool RecordStore::Batch::remove(const char *key) {
+    if (count_ >= kMaxBatch || !valid_key(key)) {
+        return false;
+    }
+    ops_[count_++] = {key, nullptr, 0, true};
+    return true;
+}
+
+RecordStore::RecordStore() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+bool RecordStore::begin(RecordMedium &medium) {
+    lock();
+    medium_ = &medium;
+    for (Entry &entry : entries_) {
+        entry = Entry{};
+    }
+    end_ = 0;
+    cursor_ = 0;
+    tail_dirty_ = false;
+    sequence_ = 0;
+    wear_base_bytes_ = 0;
+    wear_base_compactions_ = 0;
+    compactions_ = 0;
+    stats_ = Stats{};
+    if (!medium.open() || !scan()) {
+        medium_ = nullptr;
+        unlock();
+        LOGE("Storage", "record log unavailable");
+        return false;
+    }
+    loadWear();
+    stats_.mounted = true;
+    if (tail_dirty_) {
+        LOGW("Storage", "record log: dropping %lu bytes after the last commit",
+             static_cast<unsigned long>(stats_.dropped_tail_bytes));
+        if (!compactLocked()) {
+            LOGW("Storage", "record log repair failed, retrying on next write");
+        }
+    }
+    unlock();
+    return true;
+}
+
+void RecordStore::end() {
+    lock();
+    medium_ = nullptr;
+    stats_.mounted = false;
+    unlock();
+}
+
+bool RecordStore::isMounted() const {
+    lock();
+    const bool mounted = stats_.mounted;
+    unlock();
+    return mounted;
+}
+
+bool RecordStore::contains(const char *key) const {
+    lock();
+    const bool found = valid_key(key) && find(key) != nullptr;
+    unlock();
+    return found;
+}
+
+bool RecordStore::length(const char *key, size_t &len) const {
+    lock();
+    const Entry *entry = valid_key(key) ? find(key) : nullptr;
+    if (entry) {
+        len = entry->len;
+    }
+    unlock();
+    return entry != nullptr;
+}
+
+bool RecordStore::read(const char *key, void *out, size_t len) {
+    if (!out && len > 0) {
+        return false;
+    }
+    lock();
+    const Entry *entry = (stats_.mounted && valid_key(key)) ? find(key) : nullptr;
+    const bool ok = entry && entry->len == len && verify(*entry, static_cast<uint8_t *>(out));
+    unlock();
+    return ok;
+}
+
+bool RecordStore::put(const char *key, const void *data, size_t len) {
+    Batch batch;
+    return batch.put(key, data, len) && commit(batch);
+}
+
+bool RecordStore::remove(const char *key) {
+    Batch batch;
+    return batch.remove(key) && commit(batch);
+}
+
+bool RecordStore::commit(const Batch &batch) {
+    lock();
+    const bool ok = commitLocked(batch);
+    unlock();
+    return ok;
+}
+
+bool RecordStore::needsCompaction() const {
+    lock();
+    bool needed = false;
+    if (stats_.mounted) {
+        const size_t live = liveBytesLocked();
+        const size_t slack = live > kCompactSlackBytes ? live : kCompactSlackBytes;
+        needed = tail_dirty_ || end_ > live + slack;
+    }
+    unlock();
+    return needed;
+}
+
+bool RecordStore::compact() {
+    lock();
+    const bool ok = stats_.mounted && compactLocked();
+    unlock();
+    return ok;
+}
+
+void RecordStore::stats(Stats &out) const {
+    lock();
+    out = stats_;
+    out.file_bytes = static_cast<uint32_t>(end_);
+    out.live_bytes = static_cast<uint32_t>(liveBytesLocked());
+    out.sequence = sequence_;
+    out.lifetime_bytes = wear_base_bytes_ + stats_.bytes_written;
+    out.compactions = wear_base_compactions_ + compactions_;
+    uint16_t keys = 0;
+    for (const Entry &entry : entries_) {
+        if (entry.used && strcmp(entry.key, kWearKey) != 0) {
+            keys++;
+        }
+    }
+    out.keys = keys;
+    unlock();
+}
+
+RecordStore::Entry *RecordStore::find(const char *key) {
+    for (Entry &entry : entries_) {
+        if (entry.used && strcmp(entry.key, key) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const RecordStore::Entry *RecordStore::find(const char *key) const {
+    for (const Entry &entry : entries_) {
+        if (entry.used && strcmp(entry.key, key) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+RecordStore::Entry *RecordStore::claim(const char *key) {
+    Entry *entry = find(key);
+    if (entry) {
+        return entry;
+    }
+    for (Entry &slot : entries_) {
+        if (!slot.used) {
+            strncpy(slot.key, key, kMaxKeyLen);
+            slot.key[kMaxKeyLen] = '\0';
+            slot.used = true;
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+bool RecordStore::scan() {
+    const size_t size = medium_->size();
+    if (size == 0) {
+        uint8_t header[kFileHeaderSize] = {};
+        memcpy(header, kFileMagic, sizeof(kFileMagic));
+        put_u16(header + 4, kFileVersion);
+        if (!appendBytes(header, sizeof(header)) || !medium_->sync()) {
+            return false;
+        }
+        end_ = cursor_;
+        return true;
+    }
+    cursor_ = size;
+    uint8_t header[kFileHeaderSize] = {};
+    if (size < kFileHeaderSize || !medium_->read(0, header, sizeof(header)) ||
+        memcmp(header, kFileMagic, sizeof(kFileMagic)) != 0 ||
+        get_u16(header + 4) != kFileVersion) {
+        // Unknown content: start over rather than guess.
+        stats_.dropped_tail_bytes = static_cast<uint32_t>(size);
+        tail_dirty_ = true;
+        return true;
+    }
+
+    struct Staged {
+        char key[kMaxKeyLen + 1];
+        uint32_t offset;
+        uint32_t len;
+        bool remove;
+    };
+    Staged staged[kMaxBatch];
+    size_t staged_count = 0;
+    uint32_t staged_sequence = 0;
+    size_t pos = kFileHeaderSize;
+    end_ = pos;
+
+    uint8_t chunk[kChunkSize];
+    while (pos + kRecordHeaderSize + kRecordTrailerSize <= size) {
+        uint8_t record[kRecordHeaderSize];
+        if (!medium_->read(pos, record, sizeof(record)) || get_u16(record) != kRecordMagic) {
+            break;
+        }
+        const uint8_t flags = record[2];
+        const size_t key_len = record[3];
+        const uint32_t sequence = get_u32(record + 4);
+        const size_t len = get_u32(record + 8);
+        if (key_len == 0 || key_len > kMaxKeyLen || len > size ||
+            pos + record_size(key_len, len) > size) {
+            break;
+        }
+        char key[kMaxKeyLen + 1] = {};
+        if (!medium_->read(pos + kRecordHeaderSize, key, key_len)) {
+            break;
+        }
+        uint32_t crc = crc32_update(0, record + 2, kRecordHeaderSize - 2);
+        crc = crc32_update(crc, reinterpret_cast<const uint8_t *>(key), key_len);
+        const size_t data_offset = pos + kRecordHeaderSize + key_len;
+        bool read_ok = true;
+        for (size_t done = 0; done < len && read_ok;) {
+            const size_t step = (len - done) < kChunkSize ? (len - done) : kChunkSize;
+            read_ok = medium_->read(data_offset + done, chunk, step);
+            crc = crc32_update(crc, chunk, step);
+            done += step;
+        }
+        uint8_t trailer[kRecordTrailerSize];
+        if (!read_ok || !medium_->read(data_offset + len, trailer, sizeof(trailer))) {
+            break;
+        }
+        if (get_u32(trailer) != crc) {
+            stats_.crc_errors++;
+            break;
+        }
+
+        // A batch cut short by a failed write is followed by a newer one; forget it.
+        if (staged_count > 0 && sequence != staged_sequence) {
+            staged_count = 0;
+        }
+        if (staged_count >= kMaxBatch) {
+            break;
+        }
+        Staged &op = staged[staged_count++];
+        memcpy(op.key, key, sizeof(op.key));
+        op.offset = static_cast<uint32_t>(pos);
+        op.len = static_cast<uint32_t>(len);
+        op.remove = (flags & kFlagTombstone) != 0;
+        staged_sequence = sequence;
+        if (sequence > sequence_) {
+            sequence_ = sequence;
+        }
+        pos += record_size(key_len, len);
+
+        if (flags & kFlagCommit) {
+            for (size_t i = 0; i < staged_count; ++i) {
+                if (staged[i].remove) {
+                    Entry *entry = find(staged[i].key);
+                    if (entry) {
+                        entry->used = false;
+                    }
+                    continue;
+                }
+                Entry *entry = claim(staged[i].key);
+                if (!entry) {
+                    LOGW("Storage", "record log: index full, skipping %s", staged[i].key);
+                    continue;
+                }
+                entry->offset = staged[i].offset;
+                entry->len = staged[i].len;
+            }
+            staged_count = 0;
+            end_ = pos;
+        }
+    }
+    stats_.dropped_tail_bytes = static_cast<uint32_t>(size - end_);
+    tail_dirty_ = size != end_;
+    return true;
+}
+
+bool RecordStore::verify(const Entry &entry, uint8_t *out) {
+    const size_t key_len = strlen(entry.key);
+    uint8_t record[kRecordHeaderSize];
+    char key[kMaxKeyLen + 1] = {};
+    uint8_t trailer[kRecordTrailerSize];
+    bool ok = medium_->read(entry.offset, record, sizeof(record)) &&
+              get_u16(record) == kRecordMagic && record[3] == key_len &&
+              get_u32(record + 8) == entry.len &&
+              medium_->read(entry.offset + kRecordHeaderSize, key, key_len) &&
+              memcmp(key, entry.key, key_len) == 0;
+    if (ok) {
+        uint32_t crc = crc32_update(0, record + 2, kRecordHeaderSize - 2);
+        crc = crc32_update(crc, reinterpret_cast<const uint8_t *>(key), key_len);
+        ok = streamData(entry, crc, out, false) &&
+             medium_->read(entry.offset + record_size(key_len, entry.len) - kRecordTrailerSize,
+                           trailer, sizeof(trailer)) &&
+             get_u32(trailer) == crc;
+    }
+    if (!ok) {
+        stats_.crc_errors++;
+        LOGW("Storage", "record log: %s failed verification", entry.key);
+    }
+    return ok;
+}
+
+bool RecordStore::compactLocked() {
+    // Check every live record first so a damaged one is dropped instead of carried over.
+    for (Entry &entry : entries_) {
+        if (entry.used && !verify(entry, nullptr)) {
+            entry.used = false;
+        }
+    }
+    if (!medium_->beginRewrite()) {
+        return false;
+    }
+    cursor_ = 0;
+    const uint32_t sequence = sequence_ + 1;
+    uint8_t header[kFileHeaderSize] = {};
+    memcpy(header, kFileMagic, sizeof(kFileMagic));
+    put_u16(header + 4, kFileVersion);
+    bool ok = appendBytes(header, sizeof(header));
+
+    uint32_t offsets[kMaxKeys] = {};
+    for (size_t i = 0; i < kMaxKeys && ok; ++i) {
+        const Entry &entry = entries_[i];
+        if (!entry.used || strcmp(entry.key, kWearKey) == 0) {
+            continue;
+        }
+        offsets[i] = static_cast<uint32_t>(cursor_);
+        ok = copyRecord(entry, 0, sequence);
+    }
+    WearRecord wear;
+    wear.compactions = wear_base_compactions_ + compactions_ + 1;
+    // Includes the wear record itself, so the total read back at mount matches the live one.
+    wear.lifetime_bytes = wear_base_bytes_ + stats_.bytes_written +
+                          record_size(strlen(kWearKey), sizeof(wear));
+    const size_t wear_offset = cursor_;
+    ok = ok && appendRecord(kWearKey, reinterpret_cast<const uint8_t *>(&wear), sizeof(wear),
+                            kFlagCommit, sequence);
+    if (!ok || !medium_->commitRewrite()) {
+        medium_->abortRewrite();
+        cursor_ = medium_->size();
+        tail_dirty_ = tail_dirty_ || cursor_ != end_;
+        LOGW("Storage", "record log compaction failed");
+        return false;
+    }
+
+    for (size_t i = 0; i < kMaxKeys; ++i) {
+        Entry &entry = entries_[i];
+        if (entry.used && strcmp(entry.key, kWearKey) != 0) {
+            entry.offset = offsets[i];
+        }
+    }
+    Entry *wear_entry = claim(kWearKey);
+    if (wear_entry) {
+        wear_entry->offset = static_cast<uint32_t>(wear_offset);
+        wear_entry->len = sizeof(wear);
+    }
+    sequence_ = sequence;
+    end_ = cursor_;
+    tail_dirty_ = false;
+    compactions_++;
+    return true;
+}
+
+bool RecordStore::commitLocked(const Batch &batch) {
+    if (!stats_.mounted || !medium_) {
+        return false;
+    }
+    // Removing a key that is not stored is a no-op, not a tombstone. Like LittleFS.remove(),
+    // a commit that ends up writing nothing reports false.
+    const Batch::Op *ops[kMaxBatch];
+    size_t count = 0;
+    size_t new_keys = 0;
+    for (size_t i = 0; i < batch.count_; ++i) {
+        const Batch::Op &op = batch.ops_[i];
+        const bool stored = find(op.key) != nullptr;
+        if (op.remove && !stored) {
+            continue;
+        }
+        if (!op.remove && !stored) {
+            bool repeated = false;
+            for (size_t j = 0; j < count; ++j) {
+                repeated = repeated || strcmp(ops[j]->key, op.key) == 0;
+            }
+            new_keys += repeated ? 0 : 1;
+        }
+        ops[count++] = &op;
+    }
+    if (count == 0) {
+        return false;
+    }
+    size_t free_keys = 0;
+    for (const Entry &entry : entries_) {
+        free_keys += entry.used ? 0 : 1;
+    }
+    if (new_keys > free_keys) {
+        LOGW("Storage", "record log: index full");
+        return false;
+    }
+    // Never append behind bytes a later scan would stop at.
+    if (tail_dirty_ && !compactLocked()) {
+        return false;
+    }
+
+    const uint32_t sequence = sequence_ + 1;
+    uint32_t offsets[kMaxBatch] = {};
+    bool ok = true;
+    for (size_t i = 0; i < count && ok; ++i) {
+        const uint8_t flags = static_cast<uint8_t>((i + 1 == count ? kFlagCommit : 0) |
+                                                   (ops[i]->remove ? kFlagTombstone : 0));
+        offsets[i] = static_cast<uint32_t>(cursor_);
+        ok = appendRecord(ops[i]->key, ops[i]->data, ops[i]->len, flags, sequence);
+    }
+    ok = ok && medium_->sync();
+    if (!ok) {
+        tail_dirty_ = true;
+        LOGW("Storage", "record log append failed");
+        return false;
+    }
+
+    sequence_ = sequence;
+    end_ = cursor_;
+    for (size_t i = 0; i < count; ++i) {
+        if (ops[i]->remove) {
+            Entry *entry = find(ops[i]->key);
+            if (entry) {
+                entry->used = false;
+            }
+            continue;
+        }
+        Entry *entry = claim(ops[i]->key);
+        entry->offset = offsets[i];
+        entry->len = static_cast<uint32_t>(ops[i]->len);
+    }
+    return true;
+}
+
+bool RecordStore::appendRecord(const char *key, const uint8_t *data, size_t len, uint8_t flags,
+                               uint32_t sequence) {
+    const size_t key_len = strlen(key);
+    uint8_t record[kRecordHeaderSize];
+    encode_header(record, flags, key_len, sequence, len);
+    uint32_t crc = crc32_update(0, record + 2, kRecordHeaderSize - 2);
+    crc = crc32_update(crc, reinterpret_cast<const uint8_t *>(key), key_len);
+    crc = crc32_update(crc, data, len);
+    uint8_t trailer[kRecordTrailerSize];
+    put_u32(trailer, crc);
+    stats_.records_written++;
+    return appendBytes(record, sizeof(record)) && appendBytes(key, key_len) &&
+           (len == 0 || appendBytes(data, len)) && appendBytes(trailer, sizeof(trailer));
+}
+
+bool RecordStore::copyRecord(const Entry &entry, uint8_t flags, uint32_t sequence) {
+    const size_t key_len = strlen(entry.key);
+    uint8_t record[kRecordHeaderSize];
+    encode_header(record, flags, key_len, sequence, entry.len);
+    uint32_t crc = crc32_update(0, record + 2, kRecordHeaderSize - 2);
+    crc = crc32_update(crc, reinterpret_cast<const uint8_t *>(entry.key), key_len);
+    if (!appendBytes(record, sizeof(record)) || !appendBytes(entry.key, key_len) ||
+        !streamData(entry, crc, nullptr, true)) {
+        return false;
+    }
+    uint8_t trailer[kRecordTrailerSize];
+    put_u32(trailer, crc);
+    stats_.records_written++;
+    return appendBytes(trailer, sizeof(trailer));
+}
+
+bool RecordStore::streamData(const Entry &entry, uint32_t &crc, uint8_t *out, bool copy) {
+    const size_t data_offset = entry.offset + kRecordHeaderSize + strlen(entry.key);
+    uint8_t chunk[kChunkSize];
+    for (size_t done = 0; done < entry.len;) {
+        const size_t step = (entry.len - done) < kChunkSize ? (entry.len - done) : kChunkSize;
+        uint8_t *target = out ? out + done : chunk;
+        if (!medium_->read(data_offset + done, target, step)) {
+            return false;
+        }
+        crc = crc32_update(crc, target, step);
+        if (copy && !appendBytes(target, step)) {
+            return false;
+        }
+        done += step;
+    }
+    return true;
+}
+
+bool RecordStore::appendBytes(const void *data, size_t len) {
+    if (!medium_->append(data, len)) {
+        return false;
+    }
+    cursor_ += len;
+    stats_.bytes_written += static_cast<uint32_t>(len);
+    return true;
+}
+
+void RecordStore::loadWear() {
+    const Entry *entry = find(kWearKey);
+    WearRecord wear;
+    if (!entry || entry->len != sizeof(wear) ||
+        !verify(*entry, reinterpret_cast<uint8_t *>(&wear)) || wear.version != 1) {
+        return;
+    }
+    wear_base_bytes_ = wear.lifetime_bytes;
+    wear_base_compactions_ = wear.compactions;
+}
+
+size_t RecordStore::liveBytesLocked() const {
+    size_t live = kFileHeaderSize;
+    for (const Entry &entry : entries_) {
+        if (entry.used) {
+            live += record_size(strlen(entry.key), entry.len);
+        }
+    }
+    return live;
+}
+
+void RecordStore::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void RecordStore::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// Append-only byte medium under RecordStore. Appends become durable at sync(). Between
+// beginRewrite() and commitRewrite() appends build a replacement next to the live log, which
+// commitRewrite() swaps in atomically; reads keep seeing the live log until then.
+class RecordMedium {
+public:
+    virtual ~RecordMedium() = default;
+
+    virtual bool open() = 0;
+    virtual size_t size() const = 0;
+    virtual bool read(size_t offset, void *out, size_t len) = 0;
+    virtual bool append(const void *data, size_t len) = 0;
+    virtual bool sync() = 0;
+
+    virtual bool beginRewrite() = 0;
+    virtual bool commitRewrite() = 0;
+    virtual void abortRewrite() = 0;
+};
+
+// Backed by a single LittleFS file on device and by memory in host tests.
+std::unique_ptr<RecordMedium> createDefaultRecordMedium();
+
+// Log-structured key/value store: every put appends a record (header, key, data, CRC32) to one
+// medium and an in-memory index points at the newest copy of each key. Records written by one
+// commit share a sequence number and only the last carries the commit flag, so a batch is
+// applied entirely or not at all after a power cut. Superseded records are reclaimed by
+// compact(), which also persists the lifetime wear counters.
+class RecordStore {
+public:
+    static constexpr size_t kMaxKeys = 12;
+    static constexpr size_t kMaxKeyLen = 31;
+    static constexpr size_t kMaxBatch = 8;
+    // Compaction starts once dead records outweigh live ones by this much.
+    static constexpr size_t kCompactSlackBytes = 64 * 1024;
+
+    class Batch {
+    public:
+        bool put(const char *key, const void *data, size_t len);
+        bool remove(const char *key);
+        size_t size() const { return count_; }
+
+    private:
+        friend class RecordStore;
+        struct Op {
+            const char *key = nullptr;
+            const uint8_t *data = nullptr;
+            size_t len = 0;
+            bool remove = false;
+        };
+        Op ops_[kMaxBatch];
+        size_t count_ = 0;
+    };
+
+    struct Stats {
+        uint32_t file_bytes = 0;
+        uint32_t live_bytes = 0;
+        uint16_t keys = 0;
+        uint32_t sequence = 0;
+        uint32_t records_written = 0; // since boot
+        uint32_t bytes_written = 0;   // since boot, appends and rewrites
+        uint64_t lifetime_bytes = 0;  // across reboots, persisted at each compaction
+        uint32_t compactions = 0;     // across reboots
+        uint32_t crc_errors = 0;
+        uint32_t dropped_tail_bytes = 0; // torn or corrupt bytes found at mount
+        bool mounted = false;
+    };
+
+    RecordStore();
+
+    // Scans the log and rebuilds the index. A torn tail is dropped by compacting right away.
+    bool begin(RecordMedium &medium);
+    void end();
+    bool isMounted() const;
+
+    bool contains(const char *key) const;
+    bool length(const char *key, size_t &len) const;
+    // Exact-size read; fails on size mismatch or CRC error.
+    bool read(const char *key, void *out, size_t len);
+
+    bool put(const char *key, const void *data, size_t len);
+    bool remove(const char *key);
+    bool commit(const Batch &batch);
+
+    bool needsCompaction() const;
+    bool compact();
+
+    void stats(Stats &out) const;
+
+private:
+    struct Entry {
+        char key[kMaxKeyLen + 1] = {};
+        uint32_t offset = 0; // of the record header
+        uint32_t len = 0;
+        bool used = false;
+    };
+
+    void lock() const;
+    void unlock() const;
+    Entry *find(const char *key);
+    const Entry *find(const char *key) const;
+    Entry *claim(const char *key);
+    bool scan();
+    bool verify(const Entry &entry, uint8_t *out);
+    bool compactLocked();
+    bool commitLocked(const Batch &batch);
+    bool appendRecord(const char *key, const uint8_t *data, size_t len, uint8_t flags,
+                      uint32_t sequence);
+    bool copyRecord(const Entry &entry, uint8_t flags, uint32_t sequence);
+    bool streamData(const Entry &entry, uint32_t &crc, uint8_t *out, bool copy);
+    bool appendBytes(const void *data, size_t len);
+    void loadWear();
+    size_t liveBytesLocked() const;
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    RecordMedium *medium_ = nullptr;
+    Entry entries_[kMaxKeys];
+    size_t end_ = 0;    // bytes of the live log covered by committed records
+    size_t cursor_ = 0; // next append offset in the log or the rewrite in progress
+    bool tail_dirty_ = false;
+    uint32_t sequence_ = 0;
+    uint64_t wear_base_bytes_ = 0;    // lifetime bytes loaded from the wear record
+    uint32_t wear_base_compactions_ = 0;
+    uint32_t compactions_ = 0;        // since boot
+    Stats stats_{};
+};
@@ -0,0 +1,307 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/RetainedLog.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "core/MqttEventQueue.h"
+
+#ifndef UNIT_TEST
+#include <esp_attr.h>
+#endif
+
+namespace {
+
+constexpr uint32_t kMagic = 0x524C4F47; // "RLOG"
+constexpr uint16_t kVersion = 1;
+constexpr const char *kEventTag = "PrevBoot";
+
+struct LineSlot {
+    uint32_t seq;
+    RetainedLog::Line line;
+    uint32_t crc;
+};
+
+struct TelemetrySlot {
+    uint32_t seq;
+    RetainedLog::Telemetry sample;
+    uint32_t crc;
+};
+
+struct Region {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t header_crc;
+    LineSlot lines[RetainedLog::kLineCapacity];
+    TelemetrySlot telemetry[RetainedLog::kTelemetryCapacity];
+};
+
+// Survives every reset but power loss; holds noise after power-on until begin() claims it.
+#ifdef UNIT_TEST
+Region g_region;
+#else
+RTC_NOINIT_ATTR Region g_region;
+#endif
+
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len) {
+    static const uint32_t kTable[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+        0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc = kTable[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = kTable[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+// Everything in front of the trailing crc field.
+template <typename T>
+uint32_t slot_crc(const T &slot) {
+    return crc32_update(0, reinterpret_cast<const uint8_t *>(&slot), offsetof(T, crc));
+}
+
+uint32_t header_crc(const Region &region) {
+    return crc32_update(0, reinterpret_cast<const uint8_t *>(&region), offsetof(Region, header_crc));
+}
+
+template <typename T>
+bool slot_valid(const T &slot, size_t index, size_t capacity) {
+    return slot.seq != 0 && (slot.seq - 1) % capacity == index && slot.crc == slot_crc(slot);
+}
+
+// Slot indexes ordered by sequence number, oldest first.
+template <typename T>
+size_t collect_valid(const T *slots, size_t capacity, size_t *order) {
+    size_t count = 0;
+    for (size_t i = 0; i < capacity; ++i) {
+        if (!slot_valid(slots[i], i, capacity)) {
+            continue;
+        }
+        size_t pos = count++;
+        while (pos > 0 && slots[order[pos - 1]].seq > slots[i].seq) {
+            order[pos] = order[pos - 1];
+            pos--;
+        }
+        order[pos] = i;
+    }
+    return count;
+}
+
+void copy_text(char *dst, size_t dst_size, const char *src) {
+    if (dst_size == 0) {
+        return;
+    }
+    if (!src) {
+        src = "";
+    }
+    strncpy(dst, src, dst_size - 1);
+    dst[dst_size - 1] = '\0';
+}
+
+const char *reset_reason_name(esp_reset_reason_t reason) {
+    switch (reason) {
+        case ESP_RST_PANIC: return "panic";
+        case ESP_RST_INT_WDT: return "interrupt watchdog";
+        case ESP_RST_TASK_WDT: return "task watchdog";
+        case ESP_RST_WDT: return "watchdog";
+        case ESP_RST_BROWNOUT: return "brownout";
+        case ESP_RST_SW: return "restart";
+        default: return "reset";
+    }
+}
+
+} // namespace
+
+RetainedLog &RetainedLog::instance() {
+    static RetainedLog log;
+    return log;
+}
+
+RetainedLog::RetainedLog() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+bool RetainedLog::isCrash(esp_reset_reason_t reason) {
+    switch (reason) {
+        case ESP_RST_PANIC:
+        case ESP_RST_INT_WDT:
+        case ESP_RST_TASK_WDT:
+        case ESP_RST_WDT:
+        case ESP_RST_BROWNOUT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void RetainedLog::begin(esp_reset_reason_t reset_reason) {
+    previous_ = Previous{};
+    has_previous_ = false;
+    if (g_region.magic == kMagic && g_region.version == kVersion &&
+        g_region.size == sizeof(Region) && g_region.header_crc == header_crc(g_region)) {
+        size_t order[kLineCapacity > kTelemetryCapacity ? kLineCapacity : kTelemetryCapacity];
+        previous_.line_count = collect_valid(g_region.lines, kLineCapacity, order);
+        for (size_t i = 0; i < previous_.line_count; ++i) {
+            Line line = g_region.lines[order[i]].line;
+            line.tag[sizeof(Line::tag) - 1] = '\0';
+            line.message[sizeof(Line::message) - 1] = '\0';
+            // Info lines are appended by the drain, after warnings recorded later than them.
+            size_t pos = i;
+            while (pos > 0 && previous_.lines[pos - 1].ms > line.ms) {
+                previous_.lines[pos] = previous_.lines[pos - 1];
+                pos--;
+            }
+            previous_.lines[pos] = line;
+        }
+        previous_.telemetry_count = collect_valid(g_region.telemetry, kTelemetryCapacity, order);
+        for (size_t i = 0; i < previous_.telemetry_count; ++i) {
+            previous_.telemetry[i] = g_region.telemetry[order[i]].sample;
+        }
+        previous_.ended_by = reset_reason;
+        previous_.crashed = isCrash(reset_reason);
+        has_previous_ = previous_.line_count > 0 || previous_.telemetry_count > 0;
+    }
+
+    memset(static_cast<void *>(&g_region), 0, sizeof(g_region));
+    g_region.magic = kMagic;
+    g_region.version = kVersion;
+    g_region.size = sizeof(Region);
+    g_region.header_crc = header_crc(g_region);
+    line_seq_ = 0;
+    telemetry_seq_ = 0;
+    last_telemetry_ms_ = 0;
+    last_loop_us_ = 0;
+    loop_max_us_ = 0;
+    active_ = true;
+}
+
+const RetainedLog::Previous *RetainedLog::previous() const {
+    return has_previous_ ? &previous_ : nullptr;
+}
+
+size_t RetainedLog::queuePreviousEvents(uint32_t now_ms) {
+    if (!has_previous_ || !previous_.crashed) {
+        return 0;
+    }
+    MqttEventQueue &queue = MqttEventQueue::instance();
+    Logger::RecentEntry entry{};
+    entry.ms = now_ms;
+    entry.level = Logger::Error;
+    copy_text(entry.tag, sizeof(entry.tag), kEventTag);
+
+    uint32_t uptime_ms = 0;
+    if (previous_.telemetry_count > 0) {
+        uptime_ms = previous_.telemetry[previous_.telemetry_count - 1].uptime_ms;
+    }
+    if (previous_.line_count > 0 && previous_.lines[previous_.line_count - 1].ms > uptime_ms) {
+        uptime_ms = previous_.lines[previous_.line_count - 1].ms;
+    }
+    int len = snprintf(entry.message, sizeof(entry.message), "previous boot ended by %s after %lu s",
+                       reset_reason_name(previous_.ended_by),
+                       static_cast<unsigned long>(uptime_ms / 1000UL));
+    if (previous_.telemetry_count > 0 && len > 0 && static_cast<size_t>(len) < sizeof(entry.message)) {
+        const Telemetry &last = previous_.telemetry[previous_.telemetry_count - 1];
+        snprintf(entry.message + len, sizeof(entry.message) - len,
+                 "; heap min %lu B, loop max %lu ms",
+                 static_cast<unsigned long>(last.heap_min_free),
+                 static_cast<unsigned long>(last.loop_max_us / 1000UL));
+    }
+    queue.enqueue(entry);
+    size_t queued = 1;
+
+    for (size_t i = 0; i < previous_.line_count; ++i) {
+        const Line &line = previous_.lines[i];
+        if (line.level > Logger::Warn) {
+            continue;
+        }
+        entry.level = line.level;
+        snprintf(entry.message, sizeof(entry.message), "%s: %s", line.tag, line.message);
+        queue.enqueue(entry);
+        queued++;
+    }
+    return queued;
+}
+
+void RetainedLog::append(Logger::Level level, const char *tag, const char *message, uint32_t ms) {
+    if (!active_ || level == Logger::Debug) {
+        return;
+    }
+    LineSlot staged{};
+    staged.line.ms = ms;
+    staged.line.level = level;
+    copy_text(staged.line.tag, sizeof(staged.line.tag), tag);
+    copy_text(staged.line.message, sizeof(staged.line.message), message);
+    lock();
+    staged.seq = ++line_seq_;
+    staged.crc = slot_crc(staged);
+    g_region.lines[(staged.seq - 1) % kLineCapacity] = staged;
+    unlock();
+}
+
+void RetainedLog::noteLoop(uint32_t now_us) {
+    if (last_loop_us_ != 0) {
+        const uint32_t gap = now_us - last_loop_us_;
+        if (gap > loop_max_us_) {
+            loop_max_us_ = gap;
+        }
+    }
+    last_loop_us_ = now_us;
+}
+
+void RetainedLog::pollTelemetry(uint32_t now_ms, uint32_t heap_free, uint32_t heap_min_free,
+                                uint32_t sensor_age_ms) {
+    if (!active_ || (telemetry_seq_ != 0 && now_ms - last_telemetry_ms_ < kTelemetryIntervalMs)) {
+        return;
+    }
+    last_telemetry_ms_ = now_ms;
+    TelemetrySlot staged{};
+    staged.seq = ++telemetry_seq_;
+    staged.sample.uptime_ms = now_ms;
+    staged.sample.heap_free = heap_free;
+    staged.sample.heap_min_free = heap_min_free;
+    staged.sample.loop_max_us = loop_max_us_;
+    staged.sample.sensor_age_ms = sensor_age_ms;
+    staged.crc = slot_crc(staged);
+    g_region.telemetry[(staged.seq - 1) % kTelemetryCapacity] = staged;
+    loop_max_us_ = 0;
+}
+
+void RetainedLog::lock() {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void RetainedLog::unlock() {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
+
+#ifdef UNIT_TEST
+void RetainedLog::corruptLineForTest(uint32_t seq) {
+    LineSlot &slot = g_region.lines[(seq - 1) % kLineCapacity];
+    if (slot.seq == seq) {
+        slot.line.message[0] ^= 0x01;
+    }
+}
+#endif
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <esp_system.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+#include "core/Logger.h"
+
+// The last log lines and a few periodic health snapshots, kept in RTC memory that survives
+// panics, watchdog and software resets (not power loss). begin() moves whatever the previous
+// boot left there into ordinary RAM and starts a fresh region for this boot.
+//
+// Every slot carries its own sequence number and CRC, so a reset in the middle of a write costs
+// that slot only. Warnings and errors are written by the task that logs them, before the log
+// call returns; info lines arrive from the log drain and may land after later warnings, so
+// recovered lines are ordered by their timestamp.
+class RetainedLog {
+public:
+    static constexpr size_t kLineCapacity = 16;
+    static constexpr size_t kTelemetryCapacity = 4;
+    static constexpr uint32_t kTelemetryIntervalMs = 15000;
+
+    struct Line {
+        uint32_t ms = 0;
+        Logger::Level level = Logger::Info;
+        char tag[16] = {0};
+        char message[80] = {0};
+    };
+
+    struct Telemetry {
+        uint32_t uptime_ms = 0;
+        uint32_t heap_free = 0;
+        uint32_t heap_min_free = 0;
+        uint32_t loop_max_us = 0;   // longest gap between main loop passes since the last sample
+        uint32_t sensor_age_ms = 0; // since the UI last saw a new sensor sample
+    };
+
+    struct Previous {
+        esp_reset_reason_t ended_by = ESP_RST_UNKNOWN;
+        bool crashed = false;
+        Line lines[kLineCapacity];
+        size_t line_count = 0; // oldest first
+        Telemetry telemetry[kTelemetryCapacity];
+        size_t telemetry_count = 0; // oldest first
+    };
+
+    static RetainedLog &instance();
+    static bool isCrash(esp_reset_reason_t reason);
+
+    // Once per boot, before anything is appended. |reset_reason| is how the previous boot ended.
+    void begin(esp_reset_reason_t reset_reason);
+    // Nothing, or what the previous boot left behind.
+    const Previous *previous() const;
+    // Queues a summary and the previous boot's warnings and errors as MQTT events when it
+    // crashed; they go out once the broker is connected. Returns the number queued.
+    size_t queuePreviousEvents(uint32_t now_ms);
+
+    // Any task. Debug lines are not kept.
+    void append(Logger::Level level, const char *tag, const char *message, uint32_t ms);
+    // Main loop only.
+    void noteLoop(uint32_t now_us);
+    void pollTelemetry(uint32_t now_ms, uint32_t heap_free, uint32_t heap_min_free,
+                       uint32_t sensor_age_ms);
+
+#ifdef UNIT_TEST
+    // Flips a bit in the stored copy of line |seq|, as a reset halfway through its write would.
+    void corruptLineForTest(uint32_t seq);
+#endif
+
+private:
+    RetainedLog();
+
+    void lock();
+    void unlock();
+
+#ifdef UNIT_TEST
+    std::mutex mutex_{};
+#else
+    StaticSemaphore_t mutex_buffer_{};
+    SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    bool active_ = false;
+    bool has_previous_ = false;
+    Previous previous_{};
+    uint32_t line_seq_ = 0;
+    uint32_t telemetry_seq_ = 0;
+    uint32_t last_telemetry_ms_ = 0;
+    uint32_t last_loop_us_ = 0;
+    uint32_t loop_max_us_ = 0;
+};
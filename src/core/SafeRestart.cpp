@@ -14,6 +14,7 @@
 #include <stdlib.h>
 
 #include "core/Logger.h"
+#include "core/StorageWriter.h"
 
 namespace {
 
@@ -21,6 +22,8 @@ constexpr uint32_t kCore0RestartTaskStackBytes = 4096;
 constexpr uint32_t kCore0RestartTaskStackWords =
     kCore0RestartTaskStackBytes / sizeof(StackType_t);
 constexpr UBaseType_t kCore0RestartTaskPriority = configMAX_PRIORITIES - 1;
+// Enough for a charts blob on a worn filesystem; a restart must not hang on storage.
+constexpr uint32_t kStorageFlushTimeoutMs = 3000;
 TaskHandle_t core0_restart_task_handle = nullptr;
 
 #if (configSUPPORT_STATIC_ALLOCATION == 1)
@@ -81,6 +84,11 @@ bool safe_restart_init() {
 }
 
 [[noreturn]] void safe_restart_via_core0() {
+    // Queued histories and config would otherwise be lost, or cut mid-rename by the reset.
+    if (!StorageWriter::instance().flush(kStorageFlushTimeoutMs)) {
+        LOGW("Restart", "restarting with storage writes pending");
+    }
+
     if (esp_cpu_get_core_id() == 0) {
         hard_restart_fallback();
     }
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/SensorAcquisition.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "config/AppConfig.h"
+#include "core/BootProfiler.h"
+#include "core/ChartsRuntimeState.h"
+#include "core/Logger.h"
+#include "core/SensorCommandQueue.h"
+#include "core/SensorSnapshot.h"
+#include "core/SensorTiming.h"
+#include "core/Watchdog.h"
+#include "modules/ChartsHistory.h"
+#include "modules/PressureHistory.h"
+#include "modules/SensorManager.h"
+#include "web/WebRuntime.h"
+
+namespace {
+
+constexpr uint32_t kSensorTaskStackSize = 8192;
+// Above the network task on the same core so a slow broker or HTTP exchange does not
+// push back the next sensor read; each pass is short and sleeps between iterations.
+constexpr UBaseType_t kSensorTaskPriority = 2;
+constexpr BaseType_t kSensorTaskCore = 0;
+constexpr uint32_t kSensorTaskDelayMs = 10;
+constexpr uint32_t kSensorTaskOtaDelayMs = 50;
+
+TaskHandle_t g_sensor_task_handle = nullptr;
+
+void sensor_acquisition_task(void *arg) {
+    auto *ctx = static_cast<SensorAcquisition::Context *>(arg);
+    if (!Watchdog::subscribeCurrentTask()) {
+        LOGW("Main", "sensor task is not subscribed to Task WDT");
+    }
+    LOGI("Main", "Sensor task running on core: %d", xPortGetCoreID());
+    for (;;) {
+        Watchdog::kick();
+        // The main loop used to skip acquisition during OTA; keep the bus quiet the same way.
+        if (WebHandlersIsOtaBusy()) {
+            vTaskDelay(pdMS_TO_TICKS(kSensorTaskOtaDelayMs));
+            continue;
+        }
+        SensorAcquisition::pollOnce(*ctx);
+        Watchdog::kick();
+        vTaskDelay(pdMS_TO_TICKS(kSensorTaskDelayMs));
+    }
+}
+
+} // namespace
+
+bool SensorAcquisition::start(Context &ctx) {
+    if (g_sensor_task_handle != nullptr) {
+        return true;
+    }
+
+    // Continue from whatever boot published (pressure history, restored deltas).
+    SensorSample seed;
+    ctx.sensorSnapshot.read(seed);
+    ctx.data = seed.data;
+
+    TaskHandle_t created = nullptr;
+    const BaseType_t ok = xTaskCreatePinnedToCore(sensor_acquisition_task,
+                                                  "sensors",
+                                                  kSensorTaskStackSize,
+                                                  &ctx,
+                                                  kSensorTaskPriority,
+                                                  &created,
+                                                  kSensorTaskCore);
+    if (ok != pdPASS || created == nullptr) {
+        LOGE("Main", "failed to start sensor task");
+        return false;
+    }
+
+    g_sensor_task_handle = created;
+    return true;
+}
+
+bool SensorAcquisition::isRunning() {
+    return g_sensor_task_handle != nullptr;
+}
+
+void SensorAcquisition::pollOnce(Context &ctx) {
+    applyPendingCommands(ctx);
+    const SensorManager::PollResult result = ctx.sensorManager.poll(ctx.data,
+                                                                    ctx.storage,
+                                                                    ctx.pressureHistory,
+                                                                    ctx.co2_asc_enabled);
+    ctx.chartsHistory.update(ctx.data, ctx.storage);
+    ctx.chartsRuntimeState.update(ctx.chartsHistory);
+    if (result.data_changed || result.warmup_changed) {
+        ctx.sensorSnapshot.publish(ctx.data, ctx.sensorManager.isWarmupActive());
+        SensorTiming::instance().noteDelivered(SensorTiming::STAGE_SNAPSHOT, ctx.data,
+                                               SensorTiming::nowUs());
+    }
+    if (result.data_changed) {
+        BootProfiler::instance().noteFirstReading();
+    }
+}
+
+void SensorAcquisition::applyPendingCommands(Context &ctx) {
+    SensorCommandQueue &queue = SensorCommandQueue::instance();
+    SensorManager &sensors = ctx.sensorManager;
+
+    SensorCommandQueue::Offsets offsets;
+    if (queue.takeOffsets(offsets)) {
+        sensors.setOffsets(offsets.temp_offset, offsets.hum_offset);
+    }
+
+    if (queue.takeVocReset()) {
+        sensors.clearVocState(ctx.storage);
+        if (!sensors.isOk()) {
+            LOGW("Sensors", "SEN66 not ready for VOC reset");
+        } else if (!sensors.deviceReset()) {
+            LOGW("Sensors", "SEN66 device reset failed");
+        } else {
+            sensors.scheduleRetry(Config::SEN66_START_RETRY_MS);
+            LOGI("Sensors", "SEN66 device reset done");
+        }
+    }
+
+    bool asc_enabled = false;
+    if (queue.takeAsc(asc_enabled)) {
+        SensorCommandQueue::AscResult result;
+        result.requested_enabled = asc_enabled;
+        result.ok = sensors.setAscEnabled(asc_enabled);
+        queue.publishAscResult(result);
+    }
+
+    SensorCommandQueue::Frc frc;
+    if (queue.takeFrc(frc)) {
+        SensorCommandQueue::FrcResult result;
+        result.ok = sensors.calibrateFrc(frc.ref_ppm, frc.has_pressure, frc.pressure_hpa,
+                                         result.correction);
+        queue.publishFrcResult(result);
+    }
+}
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include "config/AppData.h"
+
+class ChartsHistory;
+class ChartsRuntimeState;
+class PressureHistory;
+class SensorManager;
+class SensorSnapshot;
+class StorageManager;
+
+namespace SensorAcquisition {
+
+struct Context {
+    SensorManager &sensorManager;
+    StorageManager &storage;
+    PressureHistory &pressureHistory;
+    ChartsHistory &chartsHistory;
+    ChartsRuntimeState &chartsRuntimeState;
+    SensorSnapshot &sensorSnapshot;
+    const bool &co2_asc_enabled;
+    // Working copy owned by the acquisition context; everyone else reads the snapshot.
+    SensorData data{};
+};
+
+bool start(Context &ctx);
+bool isRunning();
+// One acquisition pass; the main loop calls this when the task could not be started.
+void pollOnce(Context &ctx);
+
+// Runs the sensor commands posted to SensorCommandQueue; pollOnce() starts with it, so the
+// commands land between poll passes on whichever thread acquires.
+void applyPendingCommands(Context &ctx);
+
+} // namespace SensorAcquisition
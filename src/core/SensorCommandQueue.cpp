@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/SensorCommandQueue.h"
+
+SensorCommandQueue &SensorCommandQueue::instance() {
+    static SensorCommandQueue queue;
+    return queue;
+}
+
+SensorCommandQueue::SensorCommandQueue() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+void SensorCommandQueue::clear() {
+    lock();
+    offsets_pending_ = false;
+    voc_reset_pending_ = false;
+    asc_pending_ = false;
+    frc_pending_ = false;
+    asc_result_ready_ = false;
+    frc_result_ready_ = false;
+    unlock();
+}
+
+void SensorCommandQueue::postOffsets(float temp_offset, float hum_offset) {
+    lock();
+    offsets_.temp_offset = temp_offset;
+    offsets_.hum_offset = hum_offset;
+    offsets_pending_ = true;
+    unlock();
+}
+
+void SensorCommandQueue::postVocReset() {
+    lock();
+    voc_reset_pending_ = true;
+    unlock();
+}
+
+void SensorCommandQueue::postAsc(bool enabled) {
+    lock();
+    asc_enabled_ = enabled;
+    asc_pending_ = true;
+    asc_result_ready_ = false;
+    unlock();
+}
+
+void SensorCommandQueue::postFrc(const Frc &request) {
+    lock();
+    frc_ = request;
+    frc_pending_ = true;
+    frc_result_ready_ = false;
+    unlock();
+}
+
+bool SensorCommandQueue::takeOffsets(Offsets &out) {
+    lock();
+    if (!offsets_pending_) {
+        unlock();
+        return false;
+    }
+    out = offsets_;
+    offsets_pending_ = false;
+    unlock();
+    return true;
+}
+
+bool SensorCommandQueue::takeVocReset() {
+    lock();
+    const bool pending = voc_reset_pending_;
+    voc_reset_pending_ = false;
+    unlock();
+    return pending;
+}
+
+bool SensorCommandQueue::takeAsc(bool &enabled) {
+    lock();
+    if (!asc_pending_) {
+        unlock();
+        return false;
+    }
+    enabled = asc_enabled_;
+    asc_pending_ = false;
+    unlock();
+    return true;
+}
+
+bool SensorCommandQueue::takeFrc(Frc &out) {
+    lock();
+    if (!frc_pending_) {
+        unlock();
+        return false;
+    }
+    out = frc_;
+    frc_pending_ = false;
+    unlock();
+    return true;
+}
+
+void SensorCommandQueue::publishAscResult(const AscResult &result) {
+    lock();
+    // A newer request supersedes this outcome; its own result follows.
+    if (!asc_pending_) {
+        asc_result_ = result;
+        asc_result_ready_ = true;
+    }
+    unlock();
+}
+
+void SensorCommandQueue::publishFrcResult(const FrcResult &result) {
+    lock();
+    if (!frc_pending_) {
+        frc_result_ = result;
+        frc_result_ready_ = true;
+    }
+    unlock();
+}
+
+bool SensorCommandQueue::takeAscResult(AscResult &out) {
+    lock();
+    if (!asc_result_ready_) {
+        unlock();
+        return false;
+    }
+    out = asc_result_;
+    asc_result_ready_ = false;
+    unlock();
+    return true;
+}
+
+bool SensorCommandQueue::takeFrcResult(FrcResult &out) {
+    lock();
+    if (!frc_result_ready_) {
+        unlock();
+        return false;
+    }
+    out = frc_result_;
+    frc_result_ready_ = false;
+    unlock();
+    return true;
+}
+
+void SensorCommandQueue::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void SensorCommandQueue::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// Sensor control requests (offsets, VOC reset, ASC, FRC) posted by the UI and web handlers
+// and run by the acquisition task between poll passes. Posting never waits for I2C; the
+// lock only guards the slots. Each kind keeps the latest request, and the ASC and FRC
+// outcomes are handed back once through take*Result().
+class SensorCommandQueue {
+public:
+    struct Offsets {
+        float temp_offset = 0.0f;
+        float hum_offset = 0.0f;
+    };
+
+    struct Frc {
+        uint16_t ref_ppm = 0;
+        bool has_pressure = false;
+        float pressure_hpa = 0.0f;
+    };
+
+    struct AscResult {
+        bool requested_enabled = false;
+        bool ok = false;
+    };
+
+    struct FrcResult {
+        bool ok = false;
+        uint16_t correction = 0;
+    };
+
+    static SensorCommandQueue &instance();
+
+    void clear();
+
+    void postOffsets(float temp_offset, float hum_offset);
+    void postVocReset();
+    void postAsc(bool enabled);
+    void postFrc(const Frc &request);
+
+    // Acquisition side.
+    bool takeOffsets(Offsets &out);
+    bool takeVocReset();
+    bool takeAsc(bool &enabled);
+    bool takeFrc(Frc &out);
+    void publishAscResult(const AscResult &result);
+    void publishFrcResult(const FrcResult &result);
+
+    // Requester side.
+    bool takeAscResult(AscResult &out);
+    bool takeFrcResult(FrcResult &out);
+
+private:
+    SensorCommandQueue();
+
+    void lock() const;
+    void unlock() const;
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    Offsets offsets_{};
+    bool offsets_pending_ = false;
+    bool voc_reset_pending_ = false;
+    bool asc_enabled_ = false;
+    bool asc_pending_ = false;
+    Frc frc_{};
+    bool frc_pending_ = false;
+    AscResult asc_result_{};
+    bool asc_result_ready_ = false;
+    FrcResult frc_result_{};
+    bool frc_result_ready_ = false;
+};
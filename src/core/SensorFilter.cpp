@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/SensorFilter.h"
+
+#include <math.h>
+
+namespace {
+
+constexpr int32_t kQ15One = 1 << 15;
+constexpr float kFixedScale = static_cast<float>(1 << MetricFilter::kFracBits);
+constexpr float kFixedLimit = 2.0e9f;
+
+int32_t to_fixed(float value) {
+    float scaled = value * kFixedScale;
+    if (scaled > kFixedLimit) {
+        scaled = kFixedLimit;
+    } else if (scaled < -kFixedLimit) {
+        scaled = -kFixedLimit;
+    }
+    return static_cast<int32_t>(lroundf(scaled));
+}
+
+float from_fixed(int32_t value) {
+    return static_cast<float>(value) / kFixedScale;
+}
+
+// Variances carry twice the fraction bits of the values they describe.
+int64_t variance_to_fixed(float variance) {
+    if (!(variance > 0.0f)) {
+        return 0;
+    }
+    return static_cast<int64_t>(llroundf(variance * kFixedScale * kFixedScale));
+}
+
+// Rounded (value * q15) >> 15 without relying on how >> treats negative numbers.
+int32_t mul_q15(int32_t value, int32_t q15) {
+    const int64_t product = static_cast<int64_t>(value) * q15;
+    const int64_t half = kQ15One / 2;
+    return static_cast<int32_t>(product >= 0 ? (product + half) / kQ15One
+                                             : -((-product + half) / kQ15One));
+}
+
+} // namespace
+
+void MetricFilter::configure(const Config::MetricFilterConfig &config) {
+    uint8_t window = config.median_window;
+    if (window < 1) {
+        window = 1;
+    } else if (window > Config::METRIC_FILTER_MAX_MEDIAN) {
+        window = Config::METRIC_FILTER_MAX_MEDIAN;
+    }
+    median_window_ = window;
+    ema_alpha_q15_ = config.ema_alpha_q15 >= kQ15One ? kQ15One : config.ema_alpha_q15;
+    reset_step_ = config.reset_step > 0.0f ? to_fixed(config.reset_step) : 0;
+    kalman_q_ = variance_to_fixed(config.kalman_q);
+    kalman_r_ = variance_to_fixed(config.kalman_r);
+    kalman_ = kalman_q_ > 0 && kalman_r_ > 0;
+    reset();
+}
+
+void MetricFilter::reset() {
+    window_count_ = 0;
+    window_idx_ = 0;
+    primed_ = false;
+    kalman_p_ = 0;
+    kalman_x_ = 0;
+    output_ = 0;
+}
+
+void MetricFilter::restart(int32_t value) {
+    for (uint8_t i = 0; i < median_window_; ++i) {
+        window_[i] = value;
+    }
+    window_count_ = median_window_;
+    window_idx_ = 0;
+    kalman_x_ = value;
+    kalman_p_ = kalman_r_;
+    output_ = value;
+    primed_ = true;
+}
+
+int32_t MetricFilter::median(int32_t sample) {
+    if (median_window_ <= 1) {
+        return sample;
+    }
+    window_[window_idx_] = sample;
+    window_idx_ = static_cast<uint8_t>((window_idx_ + 1) % median_window_);
+    if (window_count_ < median_window_) {
+        ++window_count_;
+    }
+
+    int32_t sorted[Config::METRIC_FILTER_MAX_MEDIAN];
+    for (uint8_t i = 0; i < window_count_; ++i) {
+        const int32_t value = window_[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            --j;
+        }
+        sorted[j] = value;
+    }
+    return sorted[window_count_ / 2];
+}
+
+float MetricFilter::apply(float raw) {
+    if (!isfinite(raw)) {
+        return raw;
+    }
+    const int32_t sample = to_fixed(raw);
+    if (!primed_) {
+        restart(sample);
+        return raw;
+    }
+
+    const int32_t rejected = median(sample);
+    if (reset_step_ > 0) {
+        const int32_t step = rejected - output_;
+        if (step > reset_step_ || step < -reset_step_) {
+            restart(rejected);
+            return from_fixed(output_);
+        }
+    }
+
+    int32_t value = rejected;
+    if (kalman_) {
+        kalman_p_ += kalman_q_;
+        const int32_t gain_q15 =
+            static_cast<int32_t>((kalman_p_ * kQ15One) / (kalman_p_ + kalman_r_));
+        kalman_x_ += mul_q15(value - kalman_x_, gain_q15);
+        kalman_p_ = (kalman_p_ * (kQ15One - gain_q15)) / kQ15One;
+        value = kalman_x_;
+    }
+    if (ema_alpha_q15_ > 0) {
+        value = output_ + mul_q15(value - output_, ema_alpha_q15_);
+    }
+    output_ = value;
+    return from_fixed(output_);
+}
+
+SensorFilters &SensorFilters::instance() {
+    static SensorFilters filters;
+    return filters;
+}
+
+const char *SensorFilters::metricName(Metric metric) {
+    switch (metric) {
+        case METRIC_CO2:
+            return "co2";
+        case METRIC_PM05:
+            return "pm05";
+        case METRIC_PM1:
+            return "pm1";
+        case METRIC_PM25:
+            return "pm25";
+        case METRIC_PM4:
+            return "pm4";
+        case METRIC_PM10:
+            return "pm10";
+        case METRIC_TEMPERATURE:
+            return "temperature";
+        case METRIC_HUMIDITY:
+            return "humidity";
+        case METRIC_VOC:
+            return "voc_index";
+        case METRIC_NOX:
+            return "nox_index";
+        case METRIC_HCHO:
+            return "hcho";
+        case METRIC_CO:
+            return "co";
+        case METRIC_OPTIONAL_GAS:
+            return "optional_gas";
+        case METRIC_PRESSURE:
+            return "pressure";
+        case METRIC_COUNT:
+        default:
+            return "unknown";
+    }
+}
+
+const Config::MetricFilterConfig &SensorFilters::defaultConfig(Metric metric) {
+    switch (metric) {
+        case METRIC_CO2:
+            return Config::METRIC_FILTER_CO2;
+        case METRIC_PM05:
+            return Config::METRIC_FILTER_PM_NUMBER;
+        case METRIC_PM1:
+        case METRIC_PM25:
+        case METRIC_PM4:
+        case METRIC_PM10:
+            return Config::METRIC_FILTER_PM_MASS;
+        case METRIC_TEMPERATURE:
+            return Config::METRIC_FILTER_TEMP;
+        case METRIC_HUMIDITY:
+            return Config::METRIC_FILTER_HUM;
+        case METRIC_VOC:
+        case METRIC_NOX:
+            return Config::METRIC_FILTER_INDEX;
+        case METRIC_HCHO:
+            return Config::METRIC_FILTER_HCHO;
+        case METRIC_CO:
+        case METRIC_OPTIONAL_GAS:
+            return Config::METRIC_FILTER_GAS;
+        case METRIC_PRESSURE:
+            return Config::METRIC_FILTER_PRESSURE;
+        case METRIC_COUNT:
+        default:
+            return Config::METRIC_FILTER_OFF;
+    }
+}
+
+void SensorFilters::publish(Metric metric, bool valid, float raw, float value) {
+    if (metric >= METRIC_COUNT) {
+        return;
+    }
+    raw_[metric].store(raw, std::memory_order_relaxed);
+    value_[metric].store(value, std::memory_order_relaxed);
+    valid_[metric].store(valid, std::memory_order_relaxed);
+}
+
+void SensorFilters::snapshot(Snapshot &out) const {
+    for (size_t i = 0; i < METRIC_COUNT; ++i) {
+        Entry &entry = out.metrics[i];
+        entry.valid = valid_[i].load(std::memory_order_relaxed);
+        entry.raw = raw_[i].load(std::memory_order_relaxed);
+        entry.value = value_[i].load(std::memory_order_relaxed);
+    }
+}
+
+void SensorFilters::reset() {
+    for (size_t i = 0; i < METRIC_COUNT; ++i) {
+        valid_[i].store(false, std::memory_order_relaxed);
+        raw_[i].store(0.0f, std::memory_order_relaxed);
+        value_[i].store(0.0f, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "config/AppConfig.h"
+
+// Filter chain for one metric (see Config::MetricFilterConfig). State is fixed-point with
+// kFracBits fraction bits so a sample costs a few integer ops and no allocation; values are
+// limited to about +/-8e6 units, which covers every metric the sensors report.
+class MetricFilter {
+public:
+    static constexpr int kFracBits = 8;
+
+    void configure(const Config::MetricFilterConfig &config);
+    // Feeds one fresh, valid sample and returns the filtered value. The first sample after
+    // configure() or reset() passes through unchanged.
+    float apply(float raw);
+    // Drops all history, e.g. when the metric goes invalid.
+    void reset();
+    bool primed() const { return primed_; }
+    // Last value apply() returned.
+    float value() const { return static_cast<float>(output_) / (1 << kFracBits); }
+
+private:
+    int32_t median(int32_t sample);
+    void restart(int32_t value);
+
+    int32_t window_[Config::METRIC_FILTER_MAX_MEDIAN] = {};
+    uint8_t median_window_ = 1;
+    uint8_t window_count_ = 0;
+    uint8_t window_idx_ = 0;
+    bool primed_ = false;
+    int32_t ema_alpha_q15_ = 0;
+    int32_t reset_step_ = 0;
+    bool kalman_ = false;
+    int64_t kalman_q_ = 0;
+    int64_t kalman_r_ = 0;
+    int64_t kalman_p_ = 0;
+    int32_t kalman_x_ = 0;
+    int32_t output_ = 0;
+};
+
+// Last raw and filtered value per metric, published by the acquisition task for /api/diag.
+class SensorFilters {
+public:
+    enum Metric : uint8_t {
+        METRIC_CO2 = 0,
+        METRIC_PM05,
+        METRIC_PM1,
+        METRIC_PM25,
+        METRIC_PM4,
+        METRIC_PM10,
+        METRIC_TEMPERATURE,
+        METRIC_HUMIDITY,
+        METRIC_VOC,
+        METRIC_NOX,
+        METRIC_HCHO,
+        METRIC_CO,
+        METRIC_OPTIONAL_GAS,
+        METRIC_PRESSURE,
+        METRIC_COUNT
+    };
+
+    struct Entry {
+        bool valid = false;
+        float raw = 0.0f;
+        float value = 0.0f;
+    };
+    struct Snapshot {
+        Entry metrics[METRIC_COUNT] = {};
+    };
+
+    static SensorFilters &instance();
+    static const char *metricName(Metric metric);
+    static const Config::MetricFilterConfig &defaultConfig(Metric metric);
+
+    void publish(Metric metric, bool valid, float raw, float value);
+    void snapshot(Snapshot &out) const;
+    void reset();
+
+private:
+    SensorFilters() = default;
+
+    std::atomic<bool> valid_[METRIC_COUNT] = {};
+    std::atomic<float> raw_[METRIC_COUNT] = {};
+    std::atomic<float> value_[METRIC_COUNT] = {};
+};
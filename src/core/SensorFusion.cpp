@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/SensorFusion.h"
+
+#include <math.h>
+
+#include "config/AppConfig.h"
+
+void FusedQuantity::reset() {
+    for (Source &source : sources_) {
+        source = Source();
+    }
+    count_ = 0;
+    has_fused_ = false;
+    fused_ = 0.0f;
+}
+
+size_t FusedQuantity::addSource(const SourceConfig &config) {
+    if (count_ >= kMaxSources) {
+        return kMaxSources;
+    }
+    Source &source = sources_[count_];
+    source = Source();
+    source.config = config;
+    // The reference defines the scale; it never needs an offset.
+    source.calibrated = (count_ == 0);
+    return count_++;
+}
+
+void FusedQuantity::update(size_t source_idx, float value, uint32_t sample_ms) {
+    if (source_idx >= count_ || !isfinite(value)) {
+        return;
+    }
+    Source &source = sources_[source_idx];
+    if (source_idx != 0) {
+        const Source &reference = sources_[0];
+        if (usable(reference, sample_ms)) {
+            const float offset = value - reference.value;
+            if (!source.calibrated) {
+                source.bias = offset;
+                source.calibrated = true;
+            } else {
+                source.bias += Config::FUSION_BIAS_ALPHA * (offset - source.bias);
+            }
+        }
+    }
+    if (has_fused_ && trusted(source)) {
+        const float residual = (value - source.bias) - fused_;
+        source.variance += Config::FUSION_VARIANCE_ALPHA * (residual * residual - source.variance);
+    }
+    source.value = value;
+    source.sample_ms = sample_ms;
+    source.has_value = true;
+    if (source.faults > 0) {
+        --source.faults;
+    }
+}
+
+void FusedQuantity::noteFaults(size_t source_idx, uint16_t count) {
+    if (source_idx >= count_) {
+        return;
+    }
+    Source &source = sources_[source_idx];
+    const uint32_t faults = static_cast<uint32_t>(source.faults) + count;
+    source.faults = faults > Config::FUSION_MAX_FAULTS ? Config::FUSION_MAX_FAULTS
+                                                       : static_cast<uint16_t>(faults);
+}
+
+void FusedQuantity::drop(size_t source_idx) {
+    if (source_idx < count_) {
+        sources_[source_idx].has_value = false;
+    }
+}
+
+bool FusedQuantity::trusted(const Source &source) const {
+    return source.calibrated || !source.config.needs_reference;
+}
+
+bool FusedQuantity::usable(const Source &source, uint32_t now_ms) const {
+    return source.has_value &&
+           trusted(source) &&
+           now_ms - source.sample_ms <= source.config.stale_ms;
+}
+
+float FusedQuantity::weight(const Source &source) const {
+    const float sigma = source.config.sigma;
+    const float health = ldexpf(1.0f, -static_cast<int>(source.faults));
+    return health / (sigma * sigma + source.variance);
+}
+
+bool FusedQuantity::fuse(uint32_t now_ms, float &out) {
+    float weight_sum = 0.0f;
+    float acc = 0.0f;
+    for (size_t i = 0; i < count_; ++i) {
+        const Source &source = sources_[i];
+        if (!usable(source, now_ms)) {
+            continue;
+        }
+        const float w = weight(source);
+        weight_sum += w;
+        acc += w * (source.value - source.bias);
+    }
+    if (!(weight_sum > 0.0f)) {
+        return false;
+    }
+    fused_ = acc / weight_sum;
+    has_fused_ = true;
+    out = fused_;
+    return true;
+}
+
+void FusedQuantity::sourceState(size_t source_idx, uint32_t now_ms, SourceState &out) const {
+    out = SourceState();
+    if (source_idx >= count_) {
+        return;
+    }
+    const Source &source = sources_[source_idx];
+    out.name = source.config.name;
+    out.fresh = usable(source, now_ms);
+    out.calibrated = source.calibrated;
+    out.value = source.value;
+    out.bias = source.bias;
+    out.sigma = sqrtf(source.config.sigma * source.config.sigma + source.variance);
+    out.faults = source.faults;
+    if (!out.fresh) {
+        return;
+    }
+    float weight_sum = 0.0f;
+    for (size_t i = 0; i < count_; ++i) {
+        if (usable(sources_[i], now_ms)) {
+            weight_sum += weight(sources_[i]);
+        }
+    }
+    out.weight = weight_sum > 0.0f ? weight(source) / weight_sum : 0.0f;
+}
+
+SensorFusion &SensorFusion::instance() {
+    static SensorFusion fusion;
+    return fusion;
+}
+
+const char *SensorFusion::quantityName(Quantity quantity) {
+    switch (quantity) {
+        case QUANTITY_TEMPERATURE:
+            return "temperature";
+        case QUANTITY_PRESSURE:
+            return "pressure";
+        case QUANTITY_COUNT:
+        default:
+            return "unknown";
+    }
+}
+
+void SensorFusion::publish(Quantity quantity, const FusedQuantity &fused, bool valid,
+                           float value, uint32_t now_ms) {
+    if (quantity >= QUANTITY_COUNT) {
+        return;
+    }
+    QuantitySlot &slot = quantities_[quantity];
+    const size_t count = fused.sourceCount();
+    for (size_t i = 0; i < count; ++i) {
+        FusedQuantity::SourceState state;
+        fused.sourceState(i, now_ms, state);
+        SourceSlot &source = slot.sources[i];
+        source.name.store(state.name, std::memory_order_relaxed);
+        source.fresh.store(state.fresh, std::memory_order_relaxed);
+        source.calibrated.store(state.calibrated, std::memory_order_relaxed);
+        source.value.store(state.value, std::memory_order_relaxed);
+        source.bias.store(state.bias, std::memory_order_relaxed);
+        source.sigma.store(state.sigma, std::memory_order_relaxed);
+        source.weight.store(state.weight, std::memory_order_relaxed);
+        source.faults.store(state.faults, std::memory_order_relaxed);
+    }
+    slot.source_count.store(static_cast<uint8_t>(count), std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.valid.store(valid, std::memory_order_relaxed);
+}
+
+void SensorFusion::snapshot(Snapshot &out) const {
+    for (size_t q = 0; q < QUANTITY_COUNT; ++q) {
+        const QuantitySlot &slot = quantities_[q];
+        Snapshot::Entry &quantity = out.quantities[q];
+        quantity.valid = slot.valid.load(std::memory_order_relaxed);
+        quantity.value = slot.value.load(std::memory_order_relaxed);
+        quantity.source_count = slot.source_count.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < FusedQuantity::kMaxSources; ++i) {
+            const SourceSlot &source = slot.sources[i];
+            FusedQuantity::SourceState &state = quantity.sources[i];
+            state.name = source.name.load(std::memory_order_relaxed);
+            state.fresh = source.fresh.load(std::memory_order_relaxed);
+            state.calibrated = source.calibrated.load(std::memory_order_relaxed);
+            state.value = source.value.load(std::memory_order_relaxed);
+            state.bias = source.bias.load(std::memory_order_relaxed);
+            state.sigma = source.sigma.load(std::memory_order_relaxed);
+            state.weight = source.weight.load(std::memory_order_relaxed);
+            state.faults = source.faults.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void SensorFusion::reset() {
+    for (QuantitySlot &slot : quantities_) {
+        slot.valid.store(false, std::memory_order_relaxed);
+        slot.value.store(0.0f, std::memory_order_relaxed);
+        slot.source_count.store(0, std::memory_order_relaxed);
+    }
+    rtc_pending_.store(false, std::memory_order_relaxed);
+}
+
+void SensorFusion::postRtcTemperature(float celsius, uint32_t now_ms) {
+    rtc_temperature_.store(celsius, std::memory_order_relaxed);
+    rtc_sample_ms_.store(now_ms, std::memory_order_relaxed);
+    rtc_pending_.store(true, std::memory_order_release);
+}
+
+bool SensorFusion::takeRtcTemperature(float &celsius, uint32_t &sample_ms) {
+    if (!rtc_pending_.exchange(false, std::memory_order_acquire)) {
+        return false;
+    }
+    celsius = rtc_temperature_.load(std::memory_order_relaxed);
+    sample_ms = rtc_sample_ms_.load(std::memory_order_relaxed);
+    return true;
+}
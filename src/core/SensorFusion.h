@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+// One physical quantity measured by several sensors. Source 0 is the reference: every other
+// source learns its offset to it while both are fresh, so losing the reference moves the
+// fused value by no more than the residual error of the survivors. Each source is weighted
+// by 1 / (sigma^2 + residual variance), scaled down by its recent fault count, and drops out
+// once its last sample is older than its stale_ms.
+class FusedQuantity {
+public:
+    static constexpr size_t kMaxSources = 4;
+
+    struct SourceConfig {
+        const char *name;
+        float sigma;          // noise of a healthy sample, in the quantity's unit
+        uint32_t stale_ms;
+        bool needs_reference; // only counts once its offset to source 0 has been learned
+    };
+    struct SourceState {
+        const char *name = nullptr;
+        bool fresh = false;
+        bool calibrated = false;
+        float value = 0.0f;
+        float bias = 0.0f;
+        float sigma = 0.0f;
+        float weight = 0.0f; // share of the fused value, 0..1
+        uint16_t faults = 0;
+    };
+
+    void reset();
+    // Returns the source index, or kMaxSources when the table is full.
+    size_t addSource(const SourceConfig &config);
+    size_t sourceCount() const { return count_; }
+
+    void update(size_t source, float value, uint32_t sample_ms);
+    // An out-of-range sample or missed read; each one halves the source's weight until
+    // good samples work the count back down.
+    void noteFaults(size_t source, uint16_t count = 1);
+    // The driver no longer vouches for its last value.
+    void drop(size_t source);
+
+    bool fuse(uint32_t now_ms, float &out);
+    void sourceState(size_t source, uint32_t now_ms, SourceState &out) const;
+
+private:
+    struct Source {
+        SourceConfig config = {nullptr, 1.0f, 0, false};
+        bool has_value = false;
+        bool calibrated = false;
+        float value = 0.0f;
+        uint32_t sample_ms = 0;
+        float bias = 0.0f;
+        float variance = 0.0f;
+        uint16_t faults = 0;
+    };
+
+    bool trusted(const Source &source) const;
+    bool usable(const Source &source, uint32_t now_ms) const;
+    float weight(const Source &source) const;
+
+    Source sources_[kMaxSources];
+    size_t count_ = 0;
+    bool has_fused_ = false;
+    float fused_ = 0.0f;
+};
+
+// Per-source fusion state for /api/diag, plus an inbox for sources owned by other tasks
+// (the RTC temperature is read by TimeManager on the main loop).
+class SensorFusion {
+public:
+    enum Quantity : uint8_t {
+        QUANTITY_TEMPERATURE = 0,
+        QUANTITY_PRESSURE,
+        QUANTITY_COUNT
+    };
+
+    struct Snapshot {
+        struct Entry {
+            bool valid = false;
+            float value = 0.0f;
+            size_t source_count = 0;
+            FusedQuantity::SourceState sources[FusedQuantity::kMaxSources] = {};
+        };
+        Entry quantities[QUANTITY_COUNT] = {};
+    };
+
+    static SensorFusion &instance();
+    static const char *quantityName(Quantity quantity);
+
+    void publish(Quantity quantity, const FusedQuantity &fused, bool valid, float value,
+                 uint32_t now_ms);
+    void snapshot(Snapshot &out) const;
+    void reset();
+
+    void postRtcTemperature(float celsius, uint32_t now_ms);
+    bool takeRtcTemperature(float &celsius, uint32_t &sample_ms);
+
+private:
+    struct SourceSlot {
+        std::atomic<const char *> name{nullptr};
+        std::atomic<bool> fresh{false};
+        std::atomic<bool> calibrated{false};
+        std::atomic<float> value{0.0f};
+        std::atomic<float> bias{0.0f};
+        std::atomic<float> sigma{0.0f};
+        std::atomic<float> weight{0.0f};
+        std::atomic<uint16_t> faults{0};
+    };
+    struct QuantitySlot {
+        std::atomic<bool> valid{false};
+        std::atomic<float> value{0.0f};
+        std::atomic<uint8_t> source_count{0};
+        SourceSlot sources[FusedQuantity::kMaxSources];
+    };
+
+    SensorFusion() = default;
+
+    QuantitySlot quantities_[QUANTITY_COUNT];
+    std::atomic<float> rtc_temperature_{0.0f};
+    std::atomic<uint32_t> rtc_sample_ms_{0};
+    std::atomic<bool> rtc_pending_{false};
+};
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/SensorHealth.h"
+
+void SensorHealth::reset() {
+    restart();
+    last_recover_ms_ = 0;
+    miss_count_ = 0;
+    recover_count_ = 0;
+}
+
+void SensorHealth::restart() {
+    has_sample_ = false;
+    last_sample_ms_ = 0;
+    no_data_ = false;
+    no_data_since_ms_ = 0;
+}
+
+void SensorHealth::noteSample(uint32_t now_ms) {
+    has_sample_ = true;
+    last_sample_ms_ = now_ms;
+    no_data_ = false;
+}
+
+bool SensorHealth::noteMiss(uint32_t now_ms) {
+    if (miss_count_ < UINT16_MAX) {
+        ++miss_count_;
+    }
+    if (!no_data_) {
+        no_data_ = true;
+        no_data_since_ms_ = now_ms;
+    }
+    return now_ms - no_data_since_ms_ >= recover_ms_;
+}
+
+bool SensorHealth::takeRecoverSlot(uint32_t now_ms) {
+    if (now_ms - last_recover_ms_ < recover_cooldown_ms_) {
+        return false;
+    }
+    last_recover_ms_ = now_ms;
+    if (recover_count_ < UINT16_MAX) {
+        ++recover_count_;
+    }
+    return true;
+}
+
+bool SensorHealth::isStale(uint32_t now_ms) const {
+    return has_sample_ && now_ms - last_sample_ms_ > stale_ms_;
+}
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stdint.h>
+
+// Stale/recover bookkeeping for one sensor. A sample older than stale_ms is stale; a no-data
+// streak of recover_ms asks the driver to re-init, at most once per recover_cooldown_ms.
+class SensorHealth {
+public:
+    constexpr SensorHealth(uint32_t stale_ms, uint32_t recover_ms, uint32_t recover_cooldown_ms)
+        : stale_ms_(stale_ms), recover_ms_(recover_ms), recover_cooldown_ms_(recover_cooldown_ms) {}
+
+    // Forget everything, including the last recovery attempt (driver begin()).
+    void reset();
+    // The sensor was (re)started: no sample yet and no no-data streak.
+    void restart();
+    void noteSample(uint32_t now_ms);
+    // A pass that produced no sample. Returns true once the no-data streak reaches recover_ms.
+    bool noteMiss(uint32_t now_ms);
+    // Cooldown gate for a recovery attempt; consumes the slot when it returns true.
+    bool takeRecoverSlot(uint32_t now_ms);
+
+    bool hasSample() const { return has_sample_; }
+    bool isStale(uint32_t now_ms) const;
+    uint32_t lastSampleMs() const { return has_sample_ ? last_sample_ms_ : 0; }
+    uint32_t staleMs() const { return stale_ms_; }
+    uint16_t missCount() const { return miss_count_; }
+    uint16_t recoverCount() const { return recover_count_; }
+
+private:
+    uint32_t stale_ms_;
+    uint32_t recover_ms_;
+    uint32_t recover_cooldown_ms_;
+    uint32_t last_sample_ms_ = 0;
+    uint32_t no_data_since_ms_ = 0;
+    uint32_t last_recover_ms_ = 0;
+    uint16_t miss_count_ = 0;
+    uint16_t recover_count_ = 0;
+    bool has_sample_ = false;
+    bool no_data_ = false;
+};
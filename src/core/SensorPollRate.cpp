@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/SensorPollRate.h"
+
+#include <math.h>
+
+#include "config/AppConfig.h"
+
+void AdaptivePollRate::configure(uint32_t fast_ms, uint32_t slow_ms) {
+    fast_ms_ = fast_ms;
+    slow_ms_ = slow_ms < fast_ms ? fast_ms : slow_ms;
+    interval_ms_ = fast_ms_;
+    stable_count_ = 0;
+    reference_count_ = 0;
+}
+
+bool AdaptivePollRate::observe(const float *values, const float *bands, size_t count) {
+    if (!values || !bands || count == 0) {
+        return false;
+    }
+    if (count > kMaxChannels) {
+        count = kMaxChannels;
+    }
+
+    bool changed = reference_count_ != count;
+    for (size_t i = 0; i < count && !changed; ++i) {
+        const bool value_valid = isfinite(values[i]);
+        const bool reference_valid = isfinite(reference_[i]);
+        if (value_valid != reference_valid) {
+            changed = true;
+        } else if (value_valid && fabsf(values[i] - reference_[i]) > bands[i]) {
+            changed = true;
+        }
+    }
+
+    const uint32_t previous_ms = interval_ms_;
+    if (changed) {
+        for (size_t i = 0; i < count; ++i) {
+            reference_[i] = values[i];
+        }
+        reference_count_ = count;
+        stable_count_ = 0;
+        interval_ms_ = fast_ms_;
+        return interval_ms_ != previous_ms;
+    }
+
+    if (++stable_count_ < Config::ADAPTIVE_POLL_STABLE_SAMPLES) {
+        return false;
+    }
+    stable_count_ = 0;
+    if (interval_ms_ < slow_ms_) {
+        interval_ms_ = (interval_ms_ > slow_ms_ / 2) ? slow_ms_ : interval_ms_ * 2;
+    }
+    return interval_ms_ != previous_ms;
+}
+
+bool AdaptivePollRate::boost() {
+    stable_count_ = 0;
+    if (interval_ms_ == fast_ms_) {
+        return false;
+    }
+    interval_ms_ = fast_ms_;
+    return true;
+}
+
+SensorPollRates &SensorPollRates::instance() {
+    static SensorPollRates rates;
+    return rates;
+}
+
+const char *SensorPollRates::sensorName(Sensor sensor) {
+    switch (sensor) {
+        case SENSOR_SEN66:
+            return "sen66";
+        case SENSOR_HCHO:
+            return "hcho";
+        case SENSOR_CO:
+            return "co";
+        case SENSOR_OPTIONAL_GAS:
+            return "optional_gas";
+        case SENSOR_PRESSURE:
+            return "pressure";
+        case SENSOR_COUNT:
+        default:
+            return "unknown";
+    }
+}
+
+const char *SensorPollRates::demandName(Demand demand) {
+    switch (demand) {
+        case DEMAND_GRAPH:
+            return "graph";
+        case DEMAND_FAN_AUTO:
+            return "fan_auto";
+        case DEMAND_WEB_LIVE:
+            return "web_live";
+        default:
+            return "unknown";
+    }
+}
+
+void SensorPollRates::setDemand(Demand demand, bool active) {
+    if (active) {
+        demand_.fetch_or(static_cast<uint8_t>(demand), std::memory_order_relaxed);
+    } else {
+        demand_.fetch_and(static_cast<uint8_t>(~demand), std::memory_order_relaxed);
+    }
+}
+
+void SensorPollRates::noteWebLive(uint32_t now_ms) {
+    web_live_ms_.store(now_ms, std::memory_order_relaxed);
+    web_live_seen_.store(true, std::memory_order_relaxed);
+}
+
+uint8_t SensorPollRates::demand(uint32_t now_ms) const {
+    uint8_t mask = demand_.load(std::memory_order_relaxed);
+    if (web_live_seen_.load(std::memory_order_relaxed) &&
+        now_ms - web_live_ms_.load(std::memory_order_relaxed) < Config::SENSOR_POLL_WEB_LEASE_MS) {
+        mask |= DEMAND_WEB_LIVE;
+    }
+    return mask;
+}
+
+void SensorPollRates::publish(Sensor sensor, bool active, const AdaptivePollRate &rate) {
+    if (sensor >= SENSOR_COUNT) {
+        return;
+    }
+    active_[sensor].store(active, std::memory_order_relaxed);
+    interval_ms_[sensor].store(rate.intervalMs(), std::memory_order_relaxed);
+    fast_ms_[sensor].store(rate.fastMs(), std::memory_order_relaxed);
+    slow_ms_[sensor].store(rate.slowMs(), std::memory_order_relaxed);
+}
+
+void SensorPollRates::snapshot(Snapshot &out, uint32_t now_ms) const {
+    for (size_t i = 0; i < SENSOR_COUNT; ++i) {
+        Entry &entry = out.sensors[i];
+        entry.active = active_[i].load(std::memory_order_relaxed);
+        entry.interval_ms = interval_ms_[i].load(std::memory_order_relaxed);
+        entry.fast_ms = fast_ms_[i].load(std::memory_order_relaxed);
+        entry.slow_ms = slow_ms_[i].load(std::memory_order_relaxed);
+    }
+    out.demand = demand(now_ms);
+}
+
+void SensorPollRates::reset() {
+    demand_.store(0, std::memory_order_relaxed);
+    web_live_seen_.store(false, std::memory_order_relaxed);
+    web_live_ms_.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < SENSOR_COUNT; ++i) {
+        active_[i].store(false, std::memory_order_relaxed);
+        interval_ms_[i].store(0, std::memory_order_relaxed);
+        fast_ms_[i].store(0, std::memory_order_relaxed);
+        slow_ms_[i].store(0, std::memory_order_relaxed);
+    }
+}
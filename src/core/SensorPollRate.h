@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+// Poll interval for one sensor. Starts at fast_ms; after Config::ADAPTIVE_POLL_STABLE_SAMPLES
+// readings in a row stay inside their noise band the interval doubles, up to slow_ms. Any
+// reading outside the band snaps straight back to fast_ms.
+class AdaptivePollRate {
+public:
+    static constexpr size_t kMaxChannels = 6;
+
+    void configure(uint32_t fast_ms, uint32_t slow_ms);
+    // One fresh sample. Channel i has changed when it is more than bands[i] away from the
+    // reference taken at the last change, or when it turns valid/invalid (NaN). Drift that
+    // builds up slowly therefore still trips the band. Returns true if the interval changed.
+    bool observe(const float *values, const float *bands, size_t count);
+    // Back to fast_ms without moving the reference; used while a consumer wants full rate.
+    bool boost();
+
+    uint32_t intervalMs() const { return interval_ms_; }
+    uint32_t fastMs() const { return fast_ms_; }
+    uint32_t slowMs() const { return slow_ms_; }
+    bool backedOff() const { return interval_ms_ > fast_ms_; }
+
+private:
+    uint32_t fast_ms_ = 0;
+    uint32_t slow_ms_ = 0;
+    uint32_t interval_ms_ = 0;
+    uint8_t stable_count_ = 0;
+    size_t reference_count_ = 0;
+    float reference_[kMaxChannels] = {};
+};
+
+// Shared between the acquisition task, which publishes the effective rates, and the UI, web
+// and fan code, which ask for full-rate data while they are showing or acting on it.
+class SensorPollRates {
+public:
+    enum Sensor : uint8_t {
+        SENSOR_SEN66 = 0,
+        SENSOR_HCHO,
+        SENSOR_CO,
+        SENSOR_OPTIONAL_GAS,
+        SENSOR_PRESSURE,
+        SENSOR_COUNT
+    };
+    enum Demand : uint8_t {
+        DEMAND_GRAPH = 1u << 0,
+        DEMAND_FAN_AUTO = 1u << 1,
+        DEMAND_WEB_LIVE = 1u << 2,
+    };
+    static constexpr uint8_t kDemandAll = DEMAND_GRAPH | DEMAND_FAN_AUTO | DEMAND_WEB_LIVE;
+
+    struct Entry {
+        bool active = false;
+        uint32_t interval_ms = 0;
+        uint32_t fast_ms = 0;
+        uint32_t slow_ms = 0;
+    };
+    struct Snapshot {
+        Entry sensors[SENSOR_COUNT] = {};
+        uint8_t demand = 0;
+    };
+
+    static SensorPollRates &instance();
+    static const char *sensorName(Sensor sensor);
+    static const char *demandName(Demand demand);
+
+    // Level-triggered consumers (graph screen, fan auto mode) set and clear their bit.
+    void setDemand(Demand demand, bool active);
+    // Web clients poll, so each request renews a lease of Config::SENSOR_POLL_WEB_LEASE_MS.
+    void noteWebLive(uint32_t now_ms);
+    uint8_t demand(uint32_t now_ms) const;
+
+    void publish(Sensor sensor, bool active, const AdaptivePollRate &rate);
+    void snapshot(Snapshot &out, uint32_t now_ms) const;
+    void reset();
+
+private:
+    SensorPollRates() = default;
+
+    std::atomic<uint8_t> demand_{0};
+    std::atomic<bool> web_live_seen_{false};
+    std::atomic<uint32_t> web_live_ms_{0};
+    std::atomic<bool> active_[SENSOR_COUNT] = {};
+    std::atomic<uint32_t> interval_ms_[SENSOR_COUNT] = {};
+    std::atomic<uint32_t> fast_ms_[SENSOR_COUNT] = {};
+    std::atomic<uint32_t> slow_ms_[SENSOR_COUNT] = {};
+};
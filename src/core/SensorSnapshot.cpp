@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/SensorSnapshot.h"
+
+#ifdef UNIT_TEST
+#include <thread>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace {
+
+void wait_for_writer() {
+#ifdef UNIT_TEST
+    std::this_thread::yield();
+#else
+    // A reader may outrank the acquisition task on the same core; sleeping one tick lets
+    // the interrupted publish finish instead of spinning on it forever.
+    vTaskDelay(1);
+#endif
+}
+
+} // namespace
+
+void SensorSnapshot::publish(const SensorData &data, bool gas_warmup) {
+    const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    sample_.data = data;
+    sample_.gas_warmup = gas_warmup;
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+uint32_t SensorSnapshot::read(SensorSample &out) const {
+    for (;;) {
+        const uint32_t before = sequence_.load(std::memory_order_acquire);
+        if ((before & 1U) != 0) {
+            wait_for_writer();
+            continue;
+        }
+        out = sample_;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == before) {
+            return before >> 1;
+        }
+    }
+}
+
+bool SensorSnapshot::readIfNewer(SensorSample &out, uint32_t &seen_generation) const {
+    if (generation() == seen_generation) {
+        return false;
+    }
+    seen_generation = read(out);
+    return true;
+}
@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include "config/AppData.h"
+
+struct SensorSample {
+    SensorData data;
+    bool gas_warmup = false;
+};
+
+// Latest completed sensor sample, published by the acquisition task with a sequence lock.
+// Readers never block the writer; they copy the sample and retry if a publish overlapped.
+// The generation grows by one per publish, so a consumer can compare it with the last value
+// it handled and skip the copy entirely when nothing is new.
+class SensorSnapshot {
+public:
+    // Single writer only.
+    void publish(const SensorData &data, bool gas_warmup);
+
+    // Copies the latest sample and returns its generation.
+    uint32_t read(SensorSample &out) const;
+    // Copies only when a sample newer than seen_generation exists; updates seen_generation.
+    bool readIfNewer(SensorSample &out, uint32_t &seen_generation) const;
+
+    uint32_t generation() const { return sequence_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    // Odd while a publish is in progress.
+    std::atomic<uint32_t> sequence_{0};
+    SensorSample sample_{};
+};
@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/SensorTiming.h"
+
+#include <esp_timer.h>
+#include <time.h>
+
+#include "config/AppConfig.h"
+
+#ifdef UNIT_TEST
+#include "TimeMock.h"
+#endif
+
+namespace {
+
+// Same 1/16 gain RFC 3550 uses for interarrival jitter; also used for the averages.
+constexpr uint32_t kSmoothingShift = 4;
+
+uint32_t clamp_us(uint64_t value) {
+    return value > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(value);
+}
+
+uint32_t smooth(uint32_t average, uint32_t sample, bool first) {
+    if (first) {
+        return sample;
+    }
+    const int64_t delta = static_cast<int64_t>(sample) - static_cast<int64_t>(average);
+    return static_cast<uint32_t>(static_cast<int64_t>(average) +
+                                 delta / (1 << kSmoothingShift));
+}
+
+} // namespace
+
+SensorTiming &SensorTiming::instance() {
+    static SensorTiming timing;
+    return timing;
+}
+
+const char *SensorTiming::sourceName(SensorSource source) {
+    switch (source) {
+        case SENSOR_SOURCE_SEN66:
+            return "sen66";
+        case SENSOR_SOURCE_HCHO:
+            return "hcho";
+        case SENSOR_SOURCE_CO:
+            return "co";
+        case SENSOR_SOURCE_OPTIONAL_GAS:
+            return "optional_gas";
+        case SENSOR_SOURCE_PRESSURE:
+            return "pressure";
+        case SENSOR_SOURCE_COUNT:
+        default:
+            return "unknown";
+    }
+}
+
+const char *SensorTiming::stageName(Stage stage) {
+    switch (stage) {
+        case STAGE_SNAPSHOT:
+            return "snapshot";
+        case STAGE_MQTT:
+            return "mqtt";
+        case STAGE_WEB:
+            return "web";
+        case STAGE_COUNT:
+        default:
+            return "unknown";
+    }
+}
+
+uint64_t SensorTiming::nowUs() {
+    return static_cast<uint64_t>(esp_timer_get_time());
+}
+
+uint32_t SensorTiming::nowEpoch() {
+#ifdef UNIT_TEST
+    const time_t now = mockNow();
+#else
+    const time_t now = time(nullptr);
+#endif
+    return now > Config::TIME_VALID_EPOCH ? static_cast<uint32_t>(now) : 0;
+}
+
+void SensorTiming::stamp(SensorData &data, SensorSource source, uint64_t now_us,
+                         uint32_t now_epoch) {
+    if (source >= SENSOR_SOURCE_COUNT) {
+        return;
+    }
+    data.stamps[source].ready_us = now_us;
+    data.stamps[source].epoch = now_epoch;
+
+    IntervalSlot &slot = intervals_[source];
+    const uint64_t previous_us = slot.previous_us;
+    slot.previous_us = now_us;
+    if (previous_us == 0 || now_us <= previous_us) {
+        return;
+    }
+    const uint32_t interval_us = clamp_us(now_us - previous_us);
+    const uint32_t count = slot.count.load(std::memory_order_relaxed);
+    const bool first = (count == 0);
+    if (!first) {
+        const uint32_t last_us = slot.last_us.load(std::memory_order_relaxed);
+        const uint32_t deviation_us =
+            interval_us > last_us ? interval_us - last_us : last_us - interval_us;
+        const uint32_t jitter_us = slot.jitter_us.load(std::memory_order_relaxed);
+        slot.jitter_us.store(smooth(jitter_us, deviation_us, false), std::memory_order_relaxed);
+    }
+    const uint32_t min_us = slot.min_us.load(std::memory_order_relaxed);
+    if (first || interval_us < min_us) {
+        slot.min_us.store(interval_us, std::memory_order_relaxed);
+    }
+    if (interval_us > slot.max_us.load(std::memory_order_relaxed)) {
+        slot.max_us.store(interval_us, std::memory_order_relaxed);
+    }
+    slot.avg_us.store(smooth(slot.avg_us.load(std::memory_order_relaxed), interval_us, first),
+                      std::memory_order_relaxed);
+    slot.last_us.store(interval_us, std::memory_order_relaxed);
+    slot.count.store(count + 1, std::memory_order_relaxed);
+}
+
+void SensorTiming::noteDelivered(Stage stage, const SensorData &data, uint64_t now_us) {
+    if (stage >= STAGE_COUNT) {
+        return;
+    }
+    LatencySlot &slot = latency_[stage];
+    for (size_t i = 0; i < SENSOR_SOURCE_COUNT; ++i) {
+        const uint64_t ready_us = data.stamps[i].ready_us;
+        if (ready_us == 0 || ready_us == slot.seen_us[i] || now_us < ready_us) {
+            continue;
+        }
+        slot.seen_us[i] = ready_us;
+        const uint32_t latency_us = clamp_us(now_us - ready_us);
+        const uint32_t count = slot.count.load(std::memory_order_relaxed);
+        if (latency_us > slot.max_us.load(std::memory_order_relaxed)) {
+            slot.max_us.store(latency_us, std::memory_order_relaxed);
+        }
+        slot.avg_us.store(smooth(slot.avg_us.load(std::memory_order_relaxed), latency_us,
+                                 count == 0),
+                          std::memory_order_relaxed);
+        slot.last_us.store(latency_us, std::memory_order_relaxed);
+        slot.count.store(count + 1, std::memory_order_relaxed);
+    }
+}
+
+void SensorTiming::snapshot(Snapshot &out) const {
+    for (size_t i = 0; i < SENSOR_SOURCE_COUNT; ++i) {
+        const IntervalSlot &slot = intervals_[i];
+        IntervalStats &stats = out.intervals[i];
+        stats.count = slot.count.load(std::memory_order_relaxed);
+        stats.last_us = slot.last_us.load(std::memory_order_relaxed);
+        stats.min_us = slot.min_us.load(std::memory_order_relaxed);
+        stats.max_us = slot.max_us.load(std::memory_order_relaxed);
+        stats.avg_us = slot.avg_us.load(std::memory_order_relaxed);
+        stats.jitter_us = slot.jitter_us.load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const LatencySlot &slot = latency_[i];
+        LatencyStats &stats = out.latency[i];
+        stats.count = slot.count.load(std::memory_order_relaxed);
+        stats.last_us = slot.last_us.load(std::memory_order_relaxed);
+        stats.max_us = slot.max_us.load(std::memory_order_relaxed);
+        stats.avg_us = slot.avg_us.load(std::memory_order_relaxed);
+    }
+}
+
+void SensorTiming::reset() {
+    for (IntervalSlot &slot : intervals_) {
+        slot.previous_us = 0;
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.last_us.store(0, std::memory_order_relaxed);
+        slot.min_us.store(0, std::memory_order_relaxed);
+        slot.max_us.store(0, std::memory_order_relaxed);
+        slot.avg_us.store(0, std::memory_order_relaxed);
+        slot.jitter_us.store(0, std::memory_order_relaxed);
+    }
+    for (LatencySlot &slot : latency_) {
+        for (uint64_t &seen : slot.seen_us) {
+            seen = 0;
+        }
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.last_us.store(0, std::memory_order_relaxed);
+        slot.max_us.store(0, std::memory_order_relaxed);
+        slot.avg_us.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "config/AppData.h"
+
+// Freshness accounting for SensorData::stamps. The acquisition task stamps each source when a
+// new sample arrives, which also feeds the per-source interval and jitter statistics; every
+// consumer reports when a sample reached it, and the first delivery of each stamp per stage
+// becomes one latency observation. Statistics are lock-free so /api/diag can read them from
+// the web task.
+class SensorTiming {
+public:
+    enum Stage : uint8_t {
+        STAGE_SNAPSHOT = 0, // published to SensorSnapshot for UI, web and MQTT
+        STAGE_MQTT,         // state document handed to the broker
+        STAGE_WEB,          // /api/state response built
+        STAGE_COUNT
+    };
+
+    struct IntervalStats {
+        uint32_t count = 0;
+        uint32_t last_us = 0;
+        uint32_t min_us = 0;
+        uint32_t max_us = 0;
+        uint32_t avg_us = 0;    // exponentially smoothed, 1/16 per sample
+        uint32_t jitter_us = 0; // RFC 3550 style smoothed |interval - previous interval|
+    };
+    struct LatencyStats {
+        uint32_t count = 0;
+        uint32_t last_us = 0;
+        uint32_t max_us = 0;
+        uint32_t avg_us = 0;
+    };
+    struct Snapshot {
+        IntervalStats intervals[SENSOR_SOURCE_COUNT] = {};
+        LatencyStats latency[STAGE_COUNT] = {};
+    };
+
+    static SensorTiming &instance();
+    static const char *sourceName(SensorSource source);
+    static const char *stageName(Stage stage);
+
+    // Monotonic microseconds since boot; does not wrap like micros().
+    static uint64_t nowUs();
+    // Wall-clock seconds, or 0 while the clock has not been set.
+    static uint32_t nowEpoch();
+
+    // Acquisition task only.
+    void stamp(SensorData &data, SensorSource source, uint64_t now_us, uint32_t now_epoch);
+    // One caller per stage. Stamps already seen by this stage are ignored, so consumers can
+    // report every pass without skewing the numbers towards slow-moving sources.
+    void noteDelivered(Stage stage, const SensorData &data, uint64_t now_us);
+
+    void snapshot(Snapshot &out) const;
+    void reset();
+
+private:
+    struct IntervalSlot {
+        uint64_t previous_us = 0; // writer-only
+        std::atomic<uint32_t> count{0};
+        std::atomic<uint32_t> last_us{0};
+        std::atomic<uint32_t> min_us{0};
+        std::atomic<uint32_t> max_us{0};
+        std::atomic<uint32_t> avg_us{0};
+        std::atomic<uint32_t> jitter_us{0};
+    };
+    struct LatencySlot {
+        uint64_t seen_us[SENSOR_SOURCE_COUNT] = {}; // writer-only
+        std::atomic<uint32_t> count{0};
+        std::atomic<uint32_t> last_us{0};
+        std::atomic<uint32_t> max_us{0};
+        std::atomic<uint32_t> avg_us{0};
+    };
+
+    SensorTiming() = default;
+
+    IntervalSlot intervals_[SENSOR_SOURCE_COUNT];
+    LatencySlot latency_[STAGE_COUNT];
+};
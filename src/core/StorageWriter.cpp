@@ -0,0 +1,410 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/StorageWriter.h"
+
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/Logger.h"
+
+namespace {
+
+#ifndef UNIT_TEST
+constexpr uint32_t kWriterTaskStackSize = 6144;
+// Below the sensor and network tasks: a slow erase only delays the file, never a reading.
+constexpr UBaseType_t kWriterTaskPriority = 1;
+constexpr BaseType_t kWriterTaskCore = 0;
+constexpr uint32_t kWaitPollMs = 5;
+#endif
+constexpr uint32_t kSlowWriteMs = 250;
+
+// Callbacks run after the lock is released, when the slot may already be reused.
+struct Completion {
+    char path[StorageWriter::kMaxPathLen] = {};
+    StorageWriter::Callback callback = nullptr;
+    void *ctx = nullptr;
+
+    void set(const char *slot_path, StorageWriter::Callback cb, void *cb_ctx) {
+        strncpy(path, slot_path, sizeof(path) - 1);
+        callback = cb;
+        ctx = cb_ctx;
+    }
+    void run(StorageWriter::Result result) const {
+        if (callback) {
+            callback(path, result, ctx);
+        }
+    }
+};
+
+} // namespace
+
+StorageWriter &StorageWriter::instance() {
+    static StorageWriter writer;
+    return writer;
+}
+
+StorageWriter::StorageWriter() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+bool StorageWriter::start(WriteFn write, void *ctx) {
+    if (!write) {
+        return false;
+    }
+    lock();
+    write_ = write;
+    write_ctx_ = ctx;
+    unlock();
+#ifndef UNIT_TEST
+    if (task_ == nullptr) {
+        TaskHandle_t created = nullptr;
+        const BaseType_t ok = xTaskCreatePinnedToCore(taskMain,
+                                                      "storage",
+                                                      kWriterTaskStackSize,
+                                                      this,
+                                                      kWriterTaskPriority,
+                                                      &created,
+                                                      kWriterTaskCore);
+        if (ok != pdPASS || created == nullptr) {
+            LOGE("Storage", "failed to start storage writer task");
+            return false;
+        }
+        task_ = created;
+    }
+#endif
+    lock();
+    running_ = true;
+    unlock();
+    return true;
+}
+
+bool StorageWriter::isRunning() const {
+    lock();
+    const bool running = running_;
+    unlock();
+    return running;
+}
+
+void StorageWriter::setIdleHook(IdleHook hook, void *ctx) {
+    lock();
+    idle_hook_ = hook;
+    idle_ctx_ = ctx;
+    unlock();
+}
+
+bool StorageWriter::submit(const char *path, const void *data, size_t len,
+                           Callback callback, void *callback_ctx) {
+    if (!path || !data || strlen(path) >= kMaxPathLen) {
+        return false;
+    }
+    Completion superseded;
+    lock();
+    if (!running_) {
+        unlock();
+        return false;
+    }
+    Slot *target = nullptr;
+    Slot *free_slot = nullptr;
+    for (Slot &slot : slots_) {
+        if (slot.state == SlotState::Queued && strcmp(slot.path, path) == 0) {
+            target = &slot;
+            break;
+        }
+        if (slot.state == SlotState::Free && free_slot == nullptr) {
+            free_slot = &slot;
+        }
+    }
+    const bool coalesce = (target != nullptr);
+    if (!coalesce) {
+        target = free_slot;
+    }
+    if (!target || !reserve(*target, len)) {
+        stats_.rejected++;
+        unlock();
+        return false;
+    }
+    if (coalesce) {
+        // Keeps its place in the queue; only the bytes and the completion change.
+        superseded.set(target->path, target->callback, target->callback_ctx);
+        stats_.coalesced++;
+    } else {
+        strncpy(target->path, path, kMaxPathLen - 1);
+        target->path[kMaxPathLen - 1] = '\0';
+        target->sequence = next_sequence_++;
+        target->state = SlotState::Queued;
+    }
+    memcpy(target->buffer, data, len);
+    target->len = len;
+    target->callback = callback;
+    target->callback_ctx = callback_ctx;
+    stats_.submitted++;
+    unlock();
+
+    superseded.run(Result::Superseded);
+    wake();
+    return true;
+}
+
+void StorageWriter::discard(const char *path) {
+    if (!path) {
+        return;
+    }
+    Completion dropped;
+    lock();
+    for (Slot &slot : slots_) {
+        if (slot.state == SlotState::Queued && strcmp(slot.path, path) == 0) {
+            dropped.set(slot.path, slot.callback, slot.callback_ctx);
+            slot.callback = nullptr;
+            slot.state = SlotState::Free;
+            break;
+        }
+    }
+    unlock();
+    dropped.run(Result::Discarded);
+    settle(path);
+}
+
+void StorageWriter::discardAll() {
+    Completion dropped[kSlots];
+    size_t dropped_count = 0;
+    lock();
+    for (Slot &slot : slots_) {
+        if (slot.state != SlotState::Queued) {
+            continue;
+        }
+        if (slot.callback) {
+            dropped[dropped_count++].set(slot.path, slot.callback, slot.callback_ctx);
+        }
+        slot.callback = nullptr;
+        slot.state = SlotState::Free;
+    }
+    unlock();
+    for (size_t i = 0; i < dropped_count; ++i) {
+        dropped[i].run(Result::Discarded);
+    }
+    for (;;) {
+        lock();
+        bool writing = false;
+        for (const Slot &slot : slots_) {
+            writing = writing || slot.state == SlotState::Writing;
+        }
+        unlock();
+        if (!writing) {
+            return;
+        }
+        waitBriefly();
+    }
+}
+
+void StorageWriter::settle(const char *path) {
+    if (!path) {
+        return;
+    }
+    while (isWriting(path)) {
+        waitBriefly();
+    }
+}
+
+bool StorageWriter::flush(uint32_t timeout_ms) {
+#ifdef UNIT_TEST
+    // No task in host tests: flushing means doing the writes here.
+    (void)timeout_ms;
+    while (writeNext()) {
+    }
+    runIdleHook();
+    return true;
+#else
+    const uint32_t start_ms = millis();
+    for (;;) {
+        lock();
+        const size_t pending = pendingLocked();
+        unlock();
+        if (pending == 0) {
+            return true;
+        }
+        if (millis() - start_ms >= timeout_ms) {
+            LOGW("Storage", "flush timed out with %u writes pending",
+                 static_cast<unsigned>(pending));
+            return false;
+        }
+        wake();
+        waitBriefly();
+    }
+#endif
+}
+
+bool StorageWriter::writeNext() {
+    lock();
+    Slot *next = nullptr;
+    for (Slot &slot : slots_) {
+        if (slot.state != SlotState::Queued) {
+            continue;
+        }
+        if (!next || static_cast<int32_t>(slot.sequence - next->sequence) < 0) {
+            next = &slot;
+        }
+    }
+    if (!next || !write_) {
+        unlock();
+        return false;
+    }
+    next->state = SlotState::Writing;
+    const WriteFn write = write_;
+    void *write_ctx = write_ctx_;
+    unlock();
+
+    // The slot is ours while Writing: submit() never touches it and discard() waits for it.
+    const uint32_t start_ms = millis();
+    const bool ok = write(next->path, next->buffer, next->len, write_ctx);
+    const uint32_t elapsed_ms = millis() - start_ms;
+    if (!ok) {
+        LOGW("Storage", "background write of %s failed", next->path);
+    } else if (elapsed_ms >= kSlowWriteMs) {
+        LOGD("Storage", "background write of %s took %lu ms", next->path,
+             static_cast<unsigned long>(elapsed_ms));
+    }
+
+    Completion done;
+    lock();
+    done.set(next->path, next->callback, next->callback_ctx);
+    next->callback = nullptr;
+    next->state = SlotState::Free;
+    if (ok) {
+        stats_.written++;
+    } else {
+        stats_.failed++;
+    }
+    stats_.last_write_ms = elapsed_ms;
+    if (elapsed_ms > stats_.max_write_ms) {
+        stats_.max_write_ms = elapsed_ms;
+    }
+    unlock();
+
+    done.run(ok ? Result::Written : Result::Failed);
+    return true;
+}
+
+void StorageWriter::stats(Stats &out) const {
+    lock();
+    out = stats_;
+    out.pending = static_cast<uint8_t>(pendingLocked());
+    unlock();
+}
+
+#ifdef UNIT_TEST
+void StorageWriter::resetForTest() {
+    lock();
+    for (Slot &slot : slots_) {
+        free(slot.buffer);
+        slot = Slot{};
+    }
+    write_ = nullptr;
+    write_ctx_ = nullptr;
+    idle_hook_ = nullptr;
+    idle_ctx_ = nullptr;
+    running_ = false;
+    next_sequence_ = 0;
+    stats_ = Stats{};
+    unlock();
+}
+#endif
+
+bool StorageWriter::reserve(Slot &slot, size_t len) {
+    if (len <= slot.capacity) {
+        return true;
+    }
+    // Grow-only: the same few paths are saved over and over, so buffers settle quickly.
+    uint8_t *grown = static_cast<uint8_t *>(realloc(slot.buffer, len));
+    if (!grown) {
+        return false;
+    }
+    slot.buffer = grown;
+    slot.capacity = len;
+    return true;
+}
+
+bool StorageWriter::isWriting(const char *path) const {
+    lock();
+    bool writing = false;
+    for (const Slot &slot : slots_) {
+        if (slot.state == SlotState::Writing && strcmp(slot.path, path) == 0) {
+            writing = true;
+            break;
+        }
+    }
+    unlock();
+    return writing;
+}
+
+size_t StorageWriter::pendingLocked() const {
+    size_t pending = 0;
+    for (const Slot &slot : slots_) {
+        if (slot.state != SlotState::Free) {
+            pending++;
+        }
+    }
+    return pending;
+}
+
+void StorageWriter::runIdleHook() {
+    lock();
+    const IdleHook hook = idle_hook_;
+    void *ctx = idle_ctx_;
+    unlock();
+    if (hook) {
+        hook(ctx);
+    }
+}
+
+void StorageWriter::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void StorageWriter::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
+
+void StorageWriter::wake() {
+#ifndef UNIT_TEST
+    if (task_ != nullptr) {
+        xTaskNotifyGive(task_);
+    }
+#endif
+}
+
+void StorageWriter::waitBriefly() {
+#ifndef UNIT_TEST
+    vTaskDelay(pdMS_TO_TICKS(kWaitPollMs));
+#endif
+}
+
+#ifndef UNIT_TEST
+void StorageWriter::taskMain(void *param) {
+    auto *writer = static_cast<StorageWriter *>(param);
+    for (;;) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (writer->writeNext()) {
+        }
+        writer->runIdleHook();
+    }
+}
+#endif
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+// Background writer for LittleFS blobs. Callers hand over a path and bytes; the data is copied
+// into a per-slot buffer that is kept for reuse, and a low priority task on core 0 performs the
+// actual write through the function given to start(). A request for a path that is still waiting
+// replaces the queued bytes (last writer wins), so periodic savers never stack up. submit()
+// returns false when the writer is not running or every slot is busy; the caller then writes
+// synchronously.
+class StorageWriter {
+public:
+    enum class Result : uint8_t {
+        Written,
+        Failed,
+        Superseded, // a newer submit() for the same path replaced this one
+        Discarded   // dropped by discard()/discardAll() before it was written
+    };
+
+    using WriteFn = bool (*)(const char *path, const uint8_t *data, size_t len, void *ctx);
+    // Runs on the writer task for Written/Failed and on the calling task otherwise.
+    using Callback = void (*)(const char *path, Result result, void *ctx);
+    using IdleHook = void (*)(void *ctx);
+
+    struct Stats {
+        uint32_t submitted = 0;
+        uint32_t coalesced = 0;
+        uint32_t rejected = 0; // queue full, caller fell back to a synchronous write
+        uint32_t written = 0;
+        uint32_t failed = 0;
+        uint32_t last_write_ms = 0;
+        uint32_t max_write_ms = 0;
+        uint8_t pending = 0;
+    };
+
+    static constexpr size_t kSlots = 6;
+    static constexpr size_t kMaxPathLen = 32;
+
+    static StorageWriter &instance();
+
+    bool start(WriteFn write, void *ctx);
+    bool isRunning() const;
+    // Runs on the writer task each time the queue drains; used for housekeeping such as
+    // compaction that should never block a caller.
+    void setIdleHook(IdleHook hook, void *ctx);
+
+    bool submit(const char *path, const void *data, size_t len,
+                Callback callback = nullptr, void *callback_ctx = nullptr);
+    // Drops a queued request for path and waits for one that is being written. Synchronous
+    // writers call this first so an older queued copy cannot land after theirs.
+    void discard(const char *path);
+    void discardAll();
+    // Waits for an in-flight write of path without touching queued ones.
+    void settle(const char *path);
+    // Waits until nothing is queued or in flight; false on timeout.
+    bool flush(uint32_t timeout_ms);
+    // Writes the oldest queued request on the calling task. Returns false when idle.
+    bool writeNext();
+
+    void stats(Stats &out) const;
+
+#ifdef UNIT_TEST
+    void resetForTest();
+#endif
+
+private:
+    enum class SlotState : uint8_t { Free, Queued, Writing };
+
+    struct Slot {
+        char path[kMaxPathLen] = {};
+        uint8_t *buffer = nullptr;
+        size_t capacity = 0;
+        size_t len = 0;
+        uint32_t sequence = 0;
+        Callback callback = nullptr;
+        void *callback_ctx = nullptr;
+        SlotState state = SlotState::Free;
+    };
+
+    StorageWriter();
+
+    void lock() const;
+    void unlock() const;
+    void wake();
+    void waitBriefly();
+    bool reserve(Slot &slot, size_t len);
+    bool isWriting(const char *path) const;
+    size_t pendingLocked() const;
+    void runIdleHook();
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    static void taskMain(void *param);
+
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+    TaskHandle_t task_ = nullptr;
+#endif
+    WriteFn write_ = nullptr;
+    void *write_ctx_ = nullptr;
+    IdleHook idle_hook_ = nullptr;
+    void *idle_ctx_ = nullptr;
+    bool running_ = false;
+    uint32_t next_sequence_ = 0;
+    Slot slots_[kSlots];
+    Stats stats_{};
+};
@@ -0,0 +1,307 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/TaskProfiler.h"
+
+#include <string.h>
+
+#include "core/Logger.h"
+
+#ifndef UNIT_TEST
+#include <esp_heap_caps.h>
+#include <freertos/task.h>
+#endif
+
+namespace {
+
+constexpr const char *kTag = "Prof";
+
+// Scheduler names of the watched tasks, in Watched order.
+constexpr const char *kWatchedTaskNames[TaskProfiler::kWatchedCount] = {
+    "network", "lvgl", "httpd", "loopTask", "sensors", "log",
+};
+constexpr const char *kWatchedDisplayNames[TaskProfiler::kWatchedCount] = {
+    "network", "lvgl", "httpd", "main", "sensors", "log",
+};
+
+void copy_name(char *dst, const char *src) {
+    strncpy(dst, src ? src : "?", TaskProfiler::kNameLength - 1);
+    dst[TaskProfiler::kNameLength - 1] = '\0';
+}
+
+// The scheduler does not keep the list in any useful order; busiest first reads best.
+void insert_by_cpu(TaskProfiler::Task *tasks, size_t &count, const TaskProfiler::Task &task) {
+    size_t pos = count++;
+    while (pos > 0 && task.cpu_permille != TaskProfiler::kNoCpu &&
+           (tasks[pos - 1].cpu_permille == TaskProfiler::kNoCpu ||
+            tasks[pos - 1].cpu_permille < task.cpu_permille)) {
+        tasks[pos] = tasks[pos - 1];
+        pos--;
+    }
+    tasks[pos] = task;
+}
+
+void capture(TaskProfiler::Raw &raw) {
+#ifdef UNIT_TEST
+    (void)raw;
+#else
+    raw.heap.internal_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    raw.heap.internal_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    raw.heap.internal_largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    raw.heap.psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    raw.heap.psram_largest = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+
+#if configUSE_TRACE_FACILITY
+    // Only the main loop samples, so one static buffer is enough and keeps it off the loop stack.
+    static TaskStatus_t statuses[TaskProfiler::kMaxTasks];
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    const UBaseType_t count = uxTaskGetSystemState(statuses, TaskProfiler::kMaxTasks, &total);
+    if (count == 0) {
+        return;
+    }
+    TaskHandle_t idle[TaskProfiler::kCores] = {nullptr, nullptr};
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS && core < (BaseType_t)TaskProfiler::kCores; ++core) {
+        idle[core] = xTaskGetIdleTaskHandleForCore(core);
+    }
+    raw.has_tasks = true;
+    raw.task_count = count;
+#if configGENERATE_RUN_TIME_STATS
+    raw.has_runtime = true;
+    raw.total_runtime = static_cast<uint32_t>(total);
+#endif
+    for (UBaseType_t i = 0; i < count; ++i) {
+        const TaskStatus_t &status = statuses[i];
+        TaskProfiler::RawTask &task = raw.tasks[i];
+        copy_name(task.name, status.pcTaskName);
+        task.id = status.xTaskNumber;
+#if configGENERATE_RUN_TIME_STATS
+        task.runtime = static_cast<uint32_t>(status.ulRunTimeCounter);
+#endif
+        // ESP-IDF counts stack in bytes.
+        task.stack_free = status.usStackHighWaterMark;
+        const BaseType_t core = xTaskGetCoreID(status.xHandle);
+        task.core = (core >= 0 && core < (BaseType_t)TaskProfiler::kCores) ? static_cast<int8_t>(core) : -1;
+        for (size_t c = 0; c < TaskProfiler::kCores; ++c) {
+            if (status.xHandle == idle[c]) {
+                task.idle = true;
+                task.core = static_cast<int8_t>(c);
+            }
+        }
+    }
+#endif
+#endif
+}
+
+} // namespace
+
+TaskProfiler &TaskProfiler::instance() {
+    static TaskProfiler profiler;
+    return profiler;
+}
+
+TaskProfiler::TaskProfiler() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+const char *TaskProfiler::watchedName(size_t index) {
+    return index < kWatchedCount ? kWatchedDisplayNames[index] : "?";
+}
+
+uint8_t TaskProfiler::fragmentationPct(uint32_t free_bytes, uint32_t largest_block) {
+    if (free_bytes == 0 || largest_block >= free_bytes) {
+        return 0;
+    }
+    return static_cast<uint8_t>(100u - static_cast<uint32_t>(
+                                           (static_cast<uint64_t>(largest_block) * 100u) / free_bytes));
+}
+
+void TaskProfiler::setThresholds(const Thresholds &thresholds) {
+    lock();
+    thresholds_ = thresholds;
+    unlock();
+}
+
+void TaskProfiler::poll(uint32_t now_ms) {
+    if (polled_ && now_ms - last_poll_ms_ < kSampleIntervalMs) {
+        return;
+    }
+    polled_ = true;
+    last_poll_ms_ = now_ms;
+    static Raw raw;
+    raw = Raw{};
+    capture(raw);
+    ingest(now_ms, raw);
+}
+
+void TaskProfiler::ingest(uint32_t now_ms, const Raw &raw) {
+    lock();
+    Snapshot &s = current_;
+    s.valid = true;
+    s.ms = now_ms;
+    s.sample_count++;
+    s.heap = raw.heap;
+    s.internal_frag_pct = fragmentationPct(raw.heap.internal_free, raw.heap.internal_largest);
+    s.psram_frag_pct = fragmentationPct(raw.heap.psram_free, raw.heap.psram_largest);
+    for (size_t c = 0; c < kCores; ++c) {
+        s.core_busy_permille[c] = kNoCpu;
+    }
+    for (size_t w = 0; w < kWatchedCount; ++w) {
+        s.watched_stack_free[w] = kNoStack;
+    }
+
+    const size_t raw_count = raw.task_count < kMaxTasks ? raw.task_count : kMaxTasks;
+    const uint32_t elapsed = raw.total_runtime - prev_total_runtime_;
+    const bool has_cpu = raw.has_tasks && raw.has_runtime && has_prev_runtime_ && elapsed != 0;
+    s.task_count = 0;
+    if (raw.has_tasks) {
+        for (size_t i = 0; i < raw_count; ++i) {
+            const RawTask &in = raw.tasks[i];
+            Task task{};
+            copy_name(task.name, in.name);
+            task.core = in.core;
+            task.stack_free = in.stack_free;
+            task.idle = in.idle;
+            if (has_cpu) {
+                // A task started since the last sample counts from zero.
+                uint32_t before = 0;
+                for (size_t p = 0; p < prev_count_; ++p) {
+                    if (prev_ids_[p] == in.id) {
+                        before = prev_runtime_[p];
+                        break;
+                    }
+                }
+                const uint64_t share = (static_cast<uint64_t>(in.runtime - before) * 1000u) / elapsed;
+                task.cpu_permille = static_cast<uint16_t>(share > 1000u ? 1000u : share);
+                if (in.idle && in.core >= 0 && static_cast<size_t>(in.core) < kCores) {
+                    s.core_busy_permille[in.core] = static_cast<uint16_t>(1000u - task.cpu_permille);
+                }
+            }
+            insert_by_cpu(s.tasks, s.task_count, task);
+            for (size_t w = 0; w < kWatchedCount; ++w) {
+                if (strcmp(task.name, kWatchedTaskNames[w]) == 0) {
+                    s.watched_stack_free[w] = task.stack_free;
+                }
+            }
+        }
+        for (size_t i = 0; i < raw_count; ++i) {
+            prev_ids_[i] = raw.tasks[i].id;
+            prev_runtime_[i] = raw.tasks[i].runtime;
+        }
+        prev_count_ = raw_count;
+    }
+    prev_total_runtime_ = raw.total_runtime;
+    has_prev_runtime_ = raw.has_tasks && raw.has_runtime;
+
+    Point point{};
+    point.ms = now_ms;
+    for (size_t c = 0; c < kCores; ++c) {
+        point.core_busy_permille[c] = s.core_busy_permille[c];
+    }
+    point.internal_free = raw.heap.internal_free;
+    point.internal_largest = raw.heap.internal_largest;
+    point.psram_free = raw.heap.psram_free;
+    for (size_t w = 0; w < kWatchedCount; ++w) {
+        if (s.watched_stack_free[w] < point.stack_min) {
+            point.stack_min = s.watched_stack_free[w];
+        }
+    }
+    if (s.window_count == kWindowDepth) {
+        memmove(&s.window[0], &s.window[1], sizeof(Point) * (kWindowDepth - 1));
+        s.window_count--;
+    }
+    s.window[s.window_count++] = point;
+
+    updateAlerts(raw.has_tasks);
+    unlock();
+}
+
+void TaskProfiler::updateAlerts(bool has_tasks) {
+    Snapshot &s = current_;
+    if (has_tasks) {
+        for (size_t w = 0; w < kWatchedCount; ++w) {
+            const uint32_t bit = 1u << w;
+            const uint32_t free_bytes = s.watched_stack_free[w];
+            if (free_bytes == kNoStack) {
+                s.alerts &= ~bit;
+            } else if (!(s.alerts & bit) && free_bytes < thresholds_.stack_free_bytes) {
+                s.alerts |= bit;
+                LOGW(kTag, "%s stack low: %lu B free", kWatchedDisplayNames[w],
+                     static_cast<unsigned long>(free_bytes));
+            } else if ((s.alerts & bit) &&
+                       free_bytes >= thresholds_.stack_free_bytes * kHysteresisPct / 100u) {
+                // A high-water mark only rises again when the task was restarted.
+                s.alerts &= ~bit;
+            }
+        }
+    }
+
+    const uint32_t internal_free = s.heap.internal_free;
+    if (!(s.alerts & AlertInternalHeap) && internal_free < thresholds_.internal_free_bytes) {
+        s.alerts |= AlertInternalHeap;
+        LOGW(kTag, "internal heap low: %lu B free, min %lu B",
+             static_cast<unsigned long>(internal_free),
+             static_cast<unsigned long>(s.heap.internal_min_free));
+    } else if ((s.alerts & AlertInternalHeap) &&
+               internal_free >= thresholds_.internal_free_bytes * kHysteresisPct / 100u) {
+        s.alerts &= ~AlertInternalHeap;
+        LOGI(kTag, "internal heap recovered: %lu B free", static_cast<unsigned long>(internal_free));
+    }
+
+    const uint32_t largest = s.heap.internal_largest;
+    if (!(s.alerts & AlertInternalBlock) && largest < thresholds_.internal_block_bytes) {
+        s.alerts |= AlertInternalBlock;
+        LOGW(kTag, "internal heap fragmented: largest block %lu B of %lu B free (%u%%)",
+             static_cast<unsigned long>(largest), static_cast<unsigned long>(internal_free),
+             static_cast<unsigned>(s.internal_frag_pct));
+    } else if ((s.alerts & AlertInternalBlock) &&
+               largest >= thresholds_.internal_block_bytes * kHysteresisPct / 100u) {
+        s.alerts &= ~AlertInternalBlock;
+        LOGI(kTag, "internal heap largest block back to %lu B", static_cast<unsigned long>(largest));
+    }
+}
+
+bool TaskProfiler::snapshot(Snapshot &out) const {
+    lock();
+    out = current_;
+    unlock();
+    return out.valid;
+}
+
+#ifdef UNIT_TEST
+void TaskProfiler::resetForTest() {
+    lock();
+    thresholds_ = Thresholds{};
+    current_ = Snapshot{};
+    last_poll_ms_ = 0;
+    polled_ = false;
+    prev_count_ = 0;
+    prev_total_runtime_ = 0;
+    has_prev_runtime_ = false;
+    unlock();
+}
+#endif
+
+void TaskProfiler::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void TaskProfiler::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
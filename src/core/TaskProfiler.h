@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// Periodic scheduler and heap profile: CPU share of every task since the previous sample, stack
+// high-water marks, internal and PSRAM heap with their largest free blocks. The last samples are
+// kept as a rolling window for /api/diag and the diag screen. Crossing a stack or internal heap
+// threshold logs a warning once; it clears again with some headroom, so a value hovering at the
+// threshold does not flood the log.
+class TaskProfiler {
+public:
+    static constexpr size_t kMaxTasks = 32;
+    static constexpr size_t kNameLength = 16; // including the terminator
+    static constexpr size_t kWindowDepth = 12;
+    static constexpr size_t kCores = 2;
+    static constexpr uint32_t kSampleIntervalMs = 5000;
+    static constexpr uint16_t kNoCpu = UINT16_MAX;
+    static constexpr uint32_t kNoStack = UINT32_MAX;
+
+    // Tasks whose stacks are watched and raise alerts; "main" is the Arduino loop task.
+    enum Watched : uint8_t {
+        WatchNetwork = 0,
+        WatchLvgl,
+        WatchHttpd,
+        WatchMain,
+        WatchSensors,
+        WatchLog,
+        kWatchedCount
+    };
+
+    enum Alert : uint32_t {
+        AlertInternalHeap = 1u << kWatchedCount,
+        AlertInternalBlock = 1u << (kWatchedCount + 1),
+    };
+
+    struct Thresholds {
+        uint32_t stack_free_bytes = 1024;
+        uint32_t internal_free_bytes = 24u * 1024u;
+        uint32_t internal_block_bytes = 8u * 1024u;
+    };
+
+    struct Heap {
+        uint32_t internal_free = 0;
+        uint32_t internal_min_free = 0;
+        uint32_t internal_largest = 0;
+        uint32_t psram_free = 0;
+        uint32_t psram_largest = 0;
+    };
+
+    // One pass over the scheduler. poll() fills it on the device; tests feed it to ingest().
+    struct RawTask {
+        char name[kNameLength] = {0};
+        uint32_t id = 0;
+        uint32_t runtime = 0;    // run time counter, wraps
+        uint32_t stack_free = 0; // high-water mark, bytes
+        int8_t core = -1;        // -1 when not pinned
+        bool idle = false;
+    };
+
+    struct Raw {
+        RawTask tasks[kMaxTasks];
+        size_t task_count = 0;
+        bool has_tasks = false;   // false when the task list did not fit
+        bool has_runtime = false; // false without FreeRTOS run time stats
+        uint32_t total_runtime = 0;
+        Heap heap{};
+    };
+
+    struct Task {
+        char name[kNameLength] = {0};
+        int8_t core = -1;
+        uint16_t cpu_permille = kNoCpu; // of one core, so all tasks add up to kCores * 1000
+        uint32_t stack_free = 0;
+        bool idle = false;
+    };
+
+    struct Point {
+        uint32_t ms = 0;
+        uint16_t core_busy_permille[kCores] = {kNoCpu, kNoCpu};
+        uint32_t internal_free = 0;
+        uint32_t internal_largest = 0;
+        uint32_t psram_free = 0;
+        uint32_t stack_min = kNoStack; // lowest watched stack
+    };
+
+    struct Snapshot {
+        bool valid = false;
+        uint32_t ms = 0;
+        uint32_t sample_count = 0;
+        Task tasks[kMaxTasks];
+        size_t task_count = 0; // busiest first
+        uint16_t core_busy_permille[kCores] = {kNoCpu, kNoCpu};
+        uint32_t watched_stack_free[kWatchedCount] = {kNoStack, kNoStack, kNoStack,
+                                                     kNoStack, kNoStack, kNoStack};
+        Heap heap{};
+        uint8_t internal_frag_pct = 0;
+        uint8_t psram_frag_pct = 0;
+        Point window[kWindowDepth];
+        size_t window_count = 0; // oldest first
+        uint32_t alerts = 0;     // bit i: watched stack i, plus Alert bits
+    };
+
+    static TaskProfiler &instance();
+    static const char *watchedName(size_t index);
+    // 0 when nothing is free, else the share of free memory outside the largest block.
+    static uint8_t fragmentationPct(uint32_t free_bytes, uint32_t largest_block);
+
+    void setThresholds(const Thresholds &thresholds);
+    // Main loop. Samples at most once per kSampleIntervalMs.
+    void poll(uint32_t now_ms);
+    void ingest(uint32_t now_ms, const Raw &raw);
+    bool snapshot(Snapshot &out) const;
+
+#ifdef UNIT_TEST
+    void resetForTest();
+#endif
+
+private:
+    TaskProfiler();
+
+    void lock() const;
+    void unlock() const;
+    // Called with the lock held, after current_ holds the new sample.
+    void updateAlerts(bool has_tasks);
+
+    static constexpr uint32_t kHysteresisPct = 150;
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    Thresholds thresholds_{};
+    Snapshot current_{};
+    uint32_t last_poll_ms_ = 0;
+    bool polled_ = false;
+    // Run time counters from the previous sample, to turn totals into shares.
+    uint32_t prev_ids_[kMaxTasks] = {0};
+    uint32_t prev_runtime_[kMaxTasks] = {0};
+    size_t prev_count_ = 0;
+    uint32_t prev_total_runtime_ = 0;
+    bool has_prev_runtime_ = false;
+};
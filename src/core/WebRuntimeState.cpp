@@ -6,23 +6,26 @@
 
 #include "core/WebRuntimeState.h"
 
-WebRuntimeState::WebRuntimeState() {
+WebRuntimeState::WebRuntimeState(const SensorSnapshot &sensors) : sensors_(sensors) {
     mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
 }
 
-void WebRuntimeState::update(const SensorData &data, bool gas_warmup, const FanControl &fan_control) {
+void WebRuntimeState::update(const FanControl &fan_control) {
     const FanControl::Snapshot fan_snapshot = fan_control.snapshot();
     lock();
-    snapshot_.data = data;
-    snapshot_.gas_warmup = gas_warmup;
-    snapshot_.fan = fan_snapshot;
+    fan_ = fan_snapshot;
     unlock();
 }
 
 WebRuntimeSnapshot WebRuntimeState::snapshot() const {
+    WebRuntimeSnapshot copy;
     lock();
-    WebRuntimeSnapshot copy = snapshot_;
+    copy.fan = fan_;
     unlock();
+    SensorSample sample;
+    copy.sensor_generation = sensors_.read(sample);
+    copy.data = sample.data;
+    copy.gas_warmup = sample.gas_warmup;
     return copy;
 }
 
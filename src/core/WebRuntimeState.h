@@ -10,19 +10,23 @@
 #include <freertos/semphr.h>
 
 #include "config/AppData.h"
+#include "core/SensorSnapshot.h"
 #include "modules/FanControl.h"
 
 struct WebRuntimeSnapshot {
     SensorData data;
     bool gas_warmup = false;
     FanControl::Snapshot fan{};
+    uint32_t sensor_generation = 0;
 };
 
 class WebRuntimeState {
 public:
-    WebRuntimeState();
+    // Sensor readings are read lock-free from the acquisition snapshot; only the fan state
+    // is copied in by the main loop.
+    explicit WebRuntimeState(const SensorSnapshot &sensors);
 
-    void update(const SensorData &data, bool gas_warmup, const FanControl &fan_control);
+    void update(const FanControl &fan_control);
     WebRuntimeSnapshot snapshot() const;
 
 private:
@@ -31,5 +35,6 @@ private:
 
     mutable StaticSemaphore_t mutex_buffer_{};
     mutable SemaphoreHandle_t mutex_ = nullptr;
-    WebRuntimeSnapshot snapshot_{};
+    const SensorSnapshot &sensors_;
+    FanControl::Snapshot fan_{};
 };
@@ -11,6 +11,7 @@
 #include <math.h>
 
 #include "config/AppConfig.h"
+#include "core/I2CHelper.h"
 #include "core/Logger.h"
 
 namespace {
@@ -47,9 +48,7 @@ bool Bmp3xx::begin() {
     raw_temperature_ = 0;
     raw_pressure_ = 0;
     last_poll_ms_ = 0;
-    last_data_ms_ = 0;
-    no_data_since_ms_ = 0;
-    last_recover_ms_ = 0;
+    health_.reset();
     pressure_valid_ = false;
     has_new_data_ = false;
     variant_ = Variant::Unknown;
@@ -79,27 +78,11 @@ bool Bmp3xx::detect(uint8_t addr) {
 
 bool Bmp3xx::writeU8(uint8_t reg, uint8_t value) {
     uint8_t data[2] = {reg, value};
-    esp_err_t err = i2c_master_write_to_device(
-        Config::I2C_PORT,
-        addr_,
-        data,
-        sizeof(data),
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::write_bytes(addr_, data, sizeof(data)) == ESP_OK;
 }
 
 bool Bmp3xx::readBytes(uint8_t reg, uint8_t *buf, size_t len) {
-    esp_err_t err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        addr_,
-        &reg,
-        1,
-        buf,
-        len,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::read_register(addr_, reg, buf, len) == ESP_OK;
 }
 
 bool Bmp3xx::readU8(uint8_t reg, uint8_t &value) {
@@ -302,24 +285,21 @@ bool Bmp3xx::start() {
     pressure_valid_ = false;
     pressure_has_ = false;
     has_new_data_ = false;
-    no_data_since_ms_ = 0;
-    last_data_ms_ = 0;
+    health_.restart();
     return true;
 }
 
 void Bmp3xx::tryRecover(uint32_t now, const char *reason) {
-    if (now - last_recover_ms_ < Config::BMP3XX_RECOVER_COOLDOWN_MS) {
+    if (!health_.takeRecoverSlot(now)) {
         return;
     }
-    last_recover_ms_ = now;
     Logger::log(Logger::Warn, "BMP3xx", "%s - reinit", reason);
     bool ok = start();
     if (ok) {
         Logger::log(Logger::Info, "BMP3xx", "%s recovery OK", variantLabel());
         ok_ = true;
         pressure_has_ = false;
-        no_data_since_ms_ = 0;
-        last_data_ms_ = 0;
+        health_.restart();
         pressure_valid_ = false;
     } else {
         LOGW("BMP3xx", "recovery failed");
@@ -328,13 +308,11 @@ void Bmp3xx::tryRecover(uint32_t now, const char *reason) {
 }
 
 void Bmp3xx::handleNoData(uint32_t now, const char *reason) {
-    if (no_data_since_ms_ == 0) {
-        no_data_since_ms_ = now;
-    }
-    if (last_data_ms_ != 0 && (now - last_data_ms_) > Config::BMP3XX_STALE_MS) {
+    const bool recover_due = health_.noteMiss(now);
+    if (health_.isStale(now)) {
         pressure_valid_ = false;
     }
-    if (now - no_data_since_ms_ >= Config::BMP3XX_RECOVER_MS) {
+    if (recover_due) {
         tryRecover(now, reason);
     }
 }
@@ -345,7 +323,7 @@ void Bmp3xx::poll() {
         tryRecover(now, "not ready");
         return;
     }
-    if (now - last_poll_ms_ < Config::BMP3XX_POLL_MS) {
+    if (now - last_poll_ms_ < poll_interval_ms_) {
         return;
     }
     last_poll_ms_ = now;
@@ -372,7 +350,6 @@ void Bmp3xx::poll() {
     }
 
     temperature_c_ = temperature_c;
-    no_data_since_ms_ = 0;
 
     if (!pressure_has_) {
         pressure_filtered_ = pressure_hpa;
@@ -382,7 +359,7 @@ void Bmp3xx::poll() {
                               (pressure_hpa - pressure_filtered_);
     }
 
-    last_data_ms_ = now;
+    health_.noteSample(now);
     pressure_valid_ = true;
     has_new_data_ = true;
 }
@@ -9,6 +9,7 @@
 #include <driver/i2c.h>
 
 #include "config/AppConfig.h"
+#include "core/I2CHelper.h"
 
 namespace {
 
@@ -18,16 +19,7 @@ constexpr uint8_t kBmp3xxOsrReservedMask = 0xC0;
 constexpr uint8_t kBmp3xxOdrReservedMask = 0xE0;
 
 bool read_register(uint8_t addr, uint8_t reg, uint8_t &value) {
-    const esp_err_t err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        addr,
-        &reg,
-        1,
-        &value,
-        1,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::read_register(addr, reg, &value, 1) == ESP_OK;
 }
 
 bool has_no_reserved_bits(uint8_t addr, uint8_t reg, uint8_t reserved_mask) {
@@ -10,6 +10,7 @@
 #include <math.h>
 
 #include "config/AppConfig.h"
+#include "core/I2CHelper.h"
 #include "core/Logger.h"
 
 namespace {
@@ -55,9 +56,7 @@ bool Bmp580::begin() {
     raw_temperature_ = 0;
     raw_pressure_ = 0;
     last_poll_ms_ = 0;
-    last_data_ms_ = 0;
-    no_data_since_ms_ = 0;
-    last_recover_ms_ = 0;
+    health_.reset();
     pressure_valid_ = false;
     has_new_data_ = false;
     variant_ = Variant::Unknown;
@@ -67,15 +66,7 @@ bool Bmp580::begin() {
 bool Bmp580::detect(uint8_t addr) {
     uint8_t reg = Config::BMP580_REG_CHIP_ID;
     uint8_t value = 0;
-    esp_err_t err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        addr,
-        &reg,
-        1,
-        &value,
-        1,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
+    const esp_err_t err = I2C::read_register(addr, reg, &value, 1);
     if (err != ESP_OK) {
         return false;
     }
@@ -95,27 +86,11 @@ bool Bmp580::detect(uint8_t addr) {
 
 bool Bmp580::writeU8(uint8_t reg, uint8_t value) {
     uint8_t data[2] = { reg, value };
-    esp_err_t err = i2c_master_write_to_device(
-        Config::I2C_PORT,
-        addr_,
-        data,
-        sizeof(data),
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::write_bytes(addr_, data, sizeof(data)) == ESP_OK;
 }
 
 bool Bmp580::readBytes(uint8_t reg, uint8_t *buf, size_t len) {
-    esp_err_t err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        addr_,
-        &reg,
-        1,
-        buf,
-        len,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::read_register(addr_, reg, buf, len) == ESP_OK;
 }
 
 bool Bmp580::readU8(uint8_t reg, uint8_t &value) {
@@ -242,24 +217,21 @@ bool Bmp580::start() {
     pressure_valid_ = false;
     pressure_has_ = false;
     has_new_data_ = false;
-    no_data_since_ms_ = 0;
-    last_data_ms_ = 0;
+    health_.restart();
     return true;
 }
 
 void Bmp580::tryRecover(uint32_t now, const char *reason) {
-    if (now - last_recover_ms_ < Config::BMP580_RECOVER_COOLDOWN_MS) {
+    if (!health_.takeRecoverSlot(now)) {
         return;
     }
-    last_recover_ms_ = now;
     Logger::log(Logger::Warn, "BMP58x", "%s - reinit", reason);
     bool ok = start();
     if (ok) {
         Logger::log(Logger::Info, "BMP58x", "%s recovery OK", variantLabel());
         ok_ = true;
         pressure_has_ = false;
-        no_data_since_ms_ = 0;
-        last_data_ms_ = 0;
+        health_.restart();
         pressure_valid_ = false;
     } else {
         LOGW("BMP58x", "recovery failed");
@@ -268,13 +240,11 @@ void Bmp580::tryRecover(uint32_t now, const char *reason) {
 }
 
 void Bmp580::handleNoData(uint32_t now, const char *reason) {
-    if (no_data_since_ms_ == 0) {
-        no_data_since_ms_ = now;
-    }
-    if (last_data_ms_ != 0 && (now - last_data_ms_) > Config::BMP580_STALE_MS) {
+    const bool recover_due = health_.noteMiss(now);
+    if (health_.isStale(now)) {
         pressure_valid_ = false;
     }
-    if (now - no_data_since_ms_ >= Config::BMP580_RECOVER_MS) {
+    if (recover_due) {
         tryRecover(now, reason);
     }
 }
@@ -285,7 +255,7 @@ void Bmp580::poll() {
         tryRecover(now, "not ready");
         return;
     }
-    if (now - last_poll_ms_ < Config::BMP580_POLL_MS) {
+    if (now - last_poll_ms_ < poll_interval_ms_) {
         return;
     }
     last_poll_ms_ = now;
@@ -308,7 +278,6 @@ void Bmp580::poll() {
     }
 
     temperature_c_ = temperature_c;
-    no_data_since_ms_ = 0;
 
     if (!pressure_has_) {
         pressure_filtered_ = pressure_hpa;
@@ -318,7 +287,7 @@ void Bmp580::poll() {
                               (pressure_hpa - pressure_filtered_);
     }
 
-    last_data_ms_ = now;
+    health_.noteSample(now);
     pressure_valid_ = true;
     has_new_data_ = true;
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 #include <Arduino.h>
+#include "config/AppConfig.h"
+#include "core/SensorHealth.h"
 
 class Bmp580 {
 public:
@@ -18,10 +20,12 @@ public:
     bool begin();
     bool start();
     void poll();
+    void setPollIntervalMs(uint32_t interval_ms) { poll_interval_ms_ = interval_ms; }
     bool takeNewData(float &pressure_hpa, float &temperature_c);
     bool isOk() const { return ok_; }
     bool isPressureValid() const { return pressure_valid_; }
-    uint32_t lastDataMs() const { return last_data_ms_; }
+    uint32_t lastDataMs() const { return health_.lastSampleMs(); }
+    const SensorHealth &health() const { return health_; }
     Variant variant() const { return variant_; }
     const char *variantLabel() const;
     void invalidate();
@@ -47,9 +51,10 @@ private:
     int32_t raw_temperature_ = 0;
     uint32_t raw_pressure_ = 0;
     uint32_t last_poll_ms_ = 0;
-    uint32_t last_data_ms_ = 0;
-    uint32_t no_data_since_ms_ = 0;
-    uint32_t last_recover_ms_ = 0;
+    uint32_t poll_interval_ms_ = Config::BMP580_POLL_MS;
+    SensorHealth health_{Config::BMP580_STALE_MS,
+                         Config::BMP580_RECOVER_MS,
+                         Config::BMP580_RECOVER_COOLDOWN_MS};
     bool pressure_valid_ = false;
     bool has_new_data_ = false;
     Variant variant_ = Variant::Unknown;
@@ -11,6 +11,7 @@
 #include <string.h>
 
 #include "config/AppConfig.h"
+#include "core/I2cTelemetry.h"
 #include "core/Logger.h"
 
 namespace {
@@ -20,6 +21,7 @@ constexpr uint8_t kFrameLen = 9;
 } // namespace
 
 bool DfrMultiGasSensor::begin() {
+    cancelExchange();
     present_ = false;
     data_valid_ = false;
     warned_type_mismatch_ = false;
@@ -46,6 +48,7 @@ bool DfrMultiGasSensor::begin() {
 }
 
 bool DfrMultiGasSensor::start() {
+    cancelExchange();
     last_retry_ms_ = millis();
     if (!pingAddress()) {
         if (start_attempts_ < UINT8_MAX) {
@@ -115,11 +118,13 @@ bool DfrMultiGasSensor::start() {
         last_passive_failure_reason_ = FailureReason::None;
     }
 
-    FailureReason passive_failure = FailureReason::None;
-    if (!setPassiveMode(&passive_failure)) {
-        last_passive_failure_reason_ = passive_failure;
-        LOGW(config_.log_tag, "failed to set passive mode (%s), sensor may fail subsequent reads",
-             failureReasonLabel(passive_failure));
+    // The mode change is acknowledged DFR_GAS_CMD_DELAY_MS later; poll() picks the ack up.
+    const uint32_t now = millis();
+    if (!submitFrame(Config::DFR_GAS_CMD_CHANGE_MODE, Config::DFR_GAS_MODE_PASSIVE,
+                     Exchange::PassiveStart, now)) {
+        finishPassiveStart(FailureReason::I2cWrite);
+    } else if (read_txn_.isFinished()) {
+        finishExchange(now);
     }
     return true;
 }
@@ -145,6 +150,19 @@ void DfrMultiGasSensor::poll() {
         return;
     }
 
+    I2cScheduler::instance().poll(now);
+    if (read_txn_.isPending()) {
+        return;
+    }
+    if (read_txn_.isFinished()) {
+        const Exchange exchange = exchange_;
+        finishExchange(now);
+        // A freshly started sensor goes straight on to its first read.
+        if (exchange != Exchange::PassiveStart) {
+            return;
+        }
+    }
+
     if (fail_cooldown_active_) {
         if (now - fail_cooldown_started_ms_ < Config::DFR_GAS_FAIL_COOLDOWN_MS) {
             return;
@@ -152,54 +170,41 @@ void DfrMultiGasSensor::poll() {
 
         fail_cooldown_active_ = false;
         fail_cooldown_started_ms_ = 0;
-        FailureReason passive_failure = FailureReason::None;
-        if (!setPassiveMode(&passive_failure)) {
-            last_passive_failure_reason_ = passive_failure;
-            if (cooldown_recover_fail_count_ < UINT8_MAX) {
-                ++cooldown_recover_fail_count_;
-            }
-            if (cooldown_recover_fail_count_ >= Config::DFR_GAS_MAX_COOLDOWN_RECOVERY_FAILS) {
-                const bool address_still_present = pingAddress();
-                if (address_still_present || isInStartupFaultGrace(now)) {
-                    LOGW(config_.log_tag,
-                         "cooldown recovery failed %u times (%s), keeping sensor present",
-                         static_cast<unsigned>(cooldown_recover_fail_count_),
-                         failureReasonLabel(passive_failure));
-                    cooldown_recover_fail_count_ = 0;
-                    fail_cooldown_active_ = true;
-                    fail_cooldown_started_ms_ = now;
-                    last_poll_ms_ = now;
-                    return;
-                } else {
-                    LOGW(config_.log_tag,
-                         "cooldown recovery failed %u times (%s), marking sensor not present",
-                         static_cast<unsigned>(cooldown_recover_fail_count_),
-                         failureReasonLabel(passive_failure));
-                    present_ = false;
-                    data_valid_ = false;
-                    ppm_ = 0.0f;
-                    gas_type_ = GasType::None;
-                    raw_gas_type_ = 0;
-                    fail_count_ = 0;
-                    warmup_started_ = false;
-                    warmup_started_ms_ = 0;
-                    warned_type_mismatch_ = false;
-                    fail_cooldown_active_ = false;
-                    fail_cooldown_started_ms_ = 0;
-                    cooldown_recover_fail_count_ = 0;
-                    last_retry_ms_ = now;
-                }
-                return;
-            }
-            fail_cooldown_active_ = true;
-            fail_cooldown_started_ms_ = now;
-            LOGW(config_.log_tag, "cooldown elapsed, passive mode restore failed (%s, %u/%u)",
-                 failureReasonLabel(passive_failure),
-                 static_cast<unsigned>(cooldown_recover_fail_count_),
-                 static_cast<unsigned>(Config::DFR_GAS_MAX_COOLDOWN_RECOVERY_FAILS));
-            return;
+        if (!submitFrame(Config::DFR_GAS_CMD_CHANGE_MODE, Config::DFR_GAS_MODE_PASSIVE,
+                         Exchange::PassiveRecover, now)) {
+            finishPassiveRecover(FailureReason::I2cWrite, now);
+        } else if (read_txn_.isFinished()) {
+            finishExchange(now);
         }
+        return;
+    }
+
+    if (data_valid_ && last_data_ms_ != 0 &&
+        (now - last_data_ms_ > Config::DFR_GAS_STALE_MS)) {
+        data_valid_ = false;
+    }
+
+    if (now - last_poll_ms_ < poll_interval_ms_) {
+        return;
+    }
+    last_poll_ms_ = now;
+
+    if (submitFrame(Config::DFR_GAS_CMD_READ_GAS, 0, Exchange::GasRead, now) &&
+        read_txn_.isFinished()) {
+        finishExchange(now);
+    }
+}
+
+void DfrMultiGasSensor::finishPassiveStart(FailureReason passive_failure) {
+    if (passive_failure != FailureReason::None) {
+        last_passive_failure_reason_ = passive_failure;
+        LOGW(config_.log_tag, "failed to set passive mode (%s), sensor may fail subsequent reads",
+             failureReasonLabel(passive_failure));
+    }
+}
 
+void DfrMultiGasSensor::finishPassiveRecover(FailureReason passive_failure, uint32_t now) {
+    if (passive_failure == FailureReason::None) {
         cooldown_recover_fail_count_ = 0;
         fail_count_ = 0;
         last_passive_failure_reason_ = FailureReason::None;
@@ -209,20 +214,124 @@ void DfrMultiGasSensor::poll() {
         return;
     }
 
-    if (data_valid_ && last_data_ms_ != 0 &&
-        (now - last_data_ms_ > Config::DFR_GAS_STALE_MS)) {
-        data_valid_ = false;
+    last_passive_failure_reason_ = passive_failure;
+    if (cooldown_recover_fail_count_ < UINT8_MAX) {
+        ++cooldown_recover_fail_count_;
+    }
+    if (cooldown_recover_fail_count_ < Config::DFR_GAS_MAX_COOLDOWN_RECOVERY_FAILS) {
+        fail_cooldown_active_ = true;
+        fail_cooldown_started_ms_ = now;
+        LOGW(config_.log_tag, "cooldown elapsed, passive mode restore failed (%s, %u/%u)",
+             failureReasonLabel(passive_failure),
+             static_cast<unsigned>(cooldown_recover_fail_count_),
+             static_cast<unsigned>(Config::DFR_GAS_MAX_COOLDOWN_RECOVERY_FAILS));
+        return;
     }
 
-    if (now - last_poll_ms_ < Config::DFR_GAS_POLL_MS) {
+    const bool address_still_present = pingAddress();
+    if (address_still_present || isInStartupFaultGrace(now)) {
+        LOGW(config_.log_tag,
+             "cooldown recovery failed %u times (%s), keeping sensor present",
+             static_cast<unsigned>(cooldown_recover_fail_count_),
+             failureReasonLabel(passive_failure));
+        cooldown_recover_fail_count_ = 0;
+        fail_cooldown_active_ = true;
+        fail_cooldown_started_ms_ = now;
+        last_poll_ms_ = now;
         return;
     }
-    last_poll_ms_ = now;
+    LOGW(config_.log_tag,
+         "cooldown recovery failed %u times (%s), marking sensor not present",
+         static_cast<unsigned>(cooldown_recover_fail_count_),
+         failureReasonLabel(passive_failure));
+    present_ = false;
+    data_valid_ = false;
+    ppm_ = 0.0f;
+    gas_type_ = GasType::None;
+    raw_gas_type_ = 0;
+    fail_count_ = 0;
+    warmup_started_ = false;
+    warmup_started_ms_ = 0;
+    warned_type_mismatch_ = false;
+    fail_cooldown_active_ = false;
+    fail_cooldown_started_ms_ = 0;
+    cooldown_recover_fail_count_ = 0;
+    last_retry_ms_ = now;
+}
 
+bool DfrMultiGasSensor::submitFrame(uint8_t command, uint8_t arg0, Exchange exchange,
+                                    uint32_t now_ms) {
+    uint8_t frame[kFrameLen] = {0};
+    buildFrame(command, arg0, 0, 0, 0, 0, frame);
+    uint8_t tx[kFrameLen + 1] = {0};
+    tx[0] = 0x00;
+    memcpy(&tx[1], frame, kFrameLen);
+
+    exchange_ = exchange;
+    read_txn_.reset(config_.address);
+    read_txn_.addWrite(tx, sizeof(tx));
+    read_txn_.addWait(Config::DFR_GAS_CMD_DELAY_MS);
+    read_txn_.addReadRegister(0x00, kFrameLen);
+    return I2cScheduler::instance().submit(read_txn_, now_ms);
+}
+
+void DfrMultiGasSensor::finishExchange(uint32_t now) {
+    if (exchange_ == Exchange::GasRead) {
+        finishGasRead(now);
+        return;
+    }
+    FailureReason passive_failure = FailureReason::None;
+    switch (read_txn_.error()) {
+        case I2cTransaction::Error::Cancelled:
+            read_txn_.release();
+            return;
+        case I2cTransaction::Error::Write:
+            passive_failure = FailureReason::I2cWrite;
+            break;
+        case I2cTransaction::Error::Read:
+            passive_failure = FailureReason::I2cRead;
+            break;
+        case I2cTransaction::Error::None:
+        default:
+            decodePassiveAck(read_txn_.data(), passive_failure);
+            break;
+    }
+    read_txn_.release();
+    if (exchange_ == Exchange::PassiveStart) {
+        finishPassiveStart(passive_failure);
+    } else {
+        finishPassiveRecover(passive_failure, now);
+    }
+}
+
+void DfrMultiGasSensor::cancelExchange() {
+    I2cScheduler::instance().cancel(read_txn_);
+    read_txn_.release();
+}
+
+void DfrMultiGasSensor::finishGasRead(uint32_t now) {
     float ppm = 0.0f;
     uint8_t gas_type = 0;
     FailureReason read_failure = FailureReason::None;
-    if (!readGasConcentration(ppm, gas_type, read_failure)) {
+    bool read_ok = false;
+    switch (read_txn_.error()) {
+        case I2cTransaction::Error::Cancelled:
+            read_txn_.release();
+            return;
+        case I2cTransaction::Error::Write:
+            read_failure = FailureReason::I2cWrite;
+            break;
+        case I2cTransaction::Error::Read:
+            read_failure = FailureReason::I2cRead;
+            break;
+        case I2cTransaction::Error::None:
+        default:
+            read_ok = decodeGasFrame(read_txn_.data(), ppm, gas_type, read_failure);
+            break;
+    }
+    read_txn_.release();
+
+    if (!read_ok) {
         last_read_failure_reason_ = read_failure;
         if (fail_count_ < UINT8_MAX) {
             ++fail_count_;
@@ -243,7 +352,7 @@ void DfrMultiGasSensor::poll() {
     cooldown_recover_fail_count_ = 0;
     fail_count_ = 0;
     last_read_failure_reason_ = FailureReason::None;
-    last_data_ms_ = now;
+    last_data_ms_ = last_poll_ms_;
     raw_gas_type_ = gas_type;
     gas_type_ = mapGasType(gas_type);
 
@@ -371,62 +480,29 @@ bool DfrMultiGasSensor::pingAddress() {
     i2c_master_start(cmd);
     i2c_master_write_byte(cmd, (config_.address << 1) | I2C_MASTER_WRITE, true);
     i2c_master_stop(cmd);
+    const uint32_t started_us = micros();
     esp_err_t err = i2c_master_cmd_begin(
         Config::I2C_PORT,
         cmd,
         pdMS_TO_TICKS(Config::DFR_GAS_I2C_TIMEOUT_MS)
     );
     i2c_cmd_link_delete(cmd);
+    I2cTelemetry::instance().record(config_.address, 0, err, started_us);
     return err == ESP_OK;
 }
 
-bool DfrMultiGasSensor::setPassiveMode(FailureReason *failure_reason) {
-    if (failure_reason) {
-        *failure_reason = FailureReason::None;
-    }
-    uint8_t tx[kFrameLen] = {0};
-    buildFrame(Config::DFR_GAS_CMD_CHANGE_MODE, Config::DFR_GAS_MODE_PASSIVE, 0, 0, 0, 0, tx);
-
-    uint8_t rx[kFrameLen] = {0};
-    if (!transact(tx, rx, failure_reason)) {
-        return false;
-    }
-    if (rx[0] != 0xFF || rx[1] != Config::DFR_GAS_CMD_CHANGE_MODE) {
-        if (failure_reason) {
-            *failure_reason = FailureReason::BadHeader;
-        }
-        return false;
-    }
-    // Some DFR firmware revisions sum bytes 1..6 instead of the documented 1..7.
-    if (rx[8] != checksum7(rx) && rx[8] != checksum6(rx)) {
-        if (failure_reason) {
-            *failure_reason = FailureReason::BadChecksum;
-        }
-        return false;
-    }
-    if (rx[2] != 0x01 && failure_reason) {
-        *failure_reason = FailureReason::CommandRejected;
-    }
-    return rx[2] == 0x01;
-}
-
-bool DfrMultiGasSensor::readGasConcentration(float &ppm,
-                                             uint8_t &gas_type,
-                                             FailureReason &failure_reason) {
+bool DfrMultiGasSensor::decodeGasFrame(const uint8_t *rx,
+                                       float &ppm,
+                                       uint8_t &gas_type,
+                                       FailureReason &failure_reason) const {
     failure_reason = FailureReason::None;
-    uint8_t tx[kFrameLen] = {0};
-    buildFrame(Config::DFR_GAS_CMD_READ_GAS, 0, 0, 0, 0, 0, tx);
-
-    uint8_t rx[kFrameLen] = {0};
-    if (!transact(tx, rx, &failure_reason)) {
-        return false;
-    }
     if (rx[0] != 0xFF || rx[1] != Config::DFR_GAS_CMD_READ_GAS) {
         failure_reason = FailureReason::BadHeader;
         return false;
     }
     // Some DFR firmware revisions sum bytes 1..6 instead of the documented 1..7.
     if (rx[8] != checksum7(rx) && rx[8] != checksum6(rx)) {
+        I2cTelemetry::instance().recordCrcFailure(config_.address);
         failure_reason = FailureReason::BadChecksum;
         return false;
     }
@@ -448,46 +524,24 @@ bool DfrMultiGasSensor::readGasConcentration(float &ppm,
     return true;
 }
 
-bool DfrMultiGasSensor::transact(const uint8_t *tx_frame,
-                                 uint8_t *rx_frame,
-                                 FailureReason *failure_reason) {
-    if (failure_reason) {
-        *failure_reason = FailureReason::None;
+bool DfrMultiGasSensor::decodePassiveAck(const uint8_t *rx,
+                                         FailureReason &failure_reason) const {
+    failure_reason = FailureReason::None;
+    if (rx[0] != 0xFF || rx[1] != Config::DFR_GAS_CMD_CHANGE_MODE) {
+        failure_reason = FailureReason::BadHeader;
+        return false;
     }
-    uint8_t tx[kFrameLen + 1] = {0};
-    tx[0] = 0x00;
-    memcpy(&tx[1], tx_frame, kFrameLen);
-
-    esp_err_t err = i2c_master_write_to_device(
-        Config::I2C_PORT,
-        config_.address,
-        tx,
-        sizeof(tx),
-        pdMS_TO_TICKS(Config::DFR_GAS_I2C_TIMEOUT_MS)
-    );
-    if (err != ESP_OK) {
-        if (failure_reason) {
-            *failure_reason = FailureReason::I2cWrite;
-        }
+    // Some DFR firmware revisions sum bytes 1..6 instead of the documented 1..7.
+    if (rx[8] != checksum7(rx) && rx[8] != checksum6(rx)) {
+        I2cTelemetry::instance().recordCrcFailure(config_.address);
+        failure_reason = FailureReason::BadChecksum;
         return false;
     }
-
-    delay(Config::DFR_GAS_CMD_DELAY_MS);
-
-    uint8_t reg = 0x00;
-    err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        config_.address,
-        &reg,
-        1,
-        rx_frame,
-        kFrameLen,
-        pdMS_TO_TICKS(Config::DFR_GAS_I2C_TIMEOUT_MS)
-    );
-    if (err != ESP_OK && failure_reason) {
-        *failure_reason = FailureReason::I2cRead;
+    if (rx[2] != 0x01) {
+        failure_reason = FailureReason::CommandRejected;
+        return false;
     }
-    return err == ESP_OK;
+    return true;
 }
 
 bool DfrMultiGasSensor::isInStartupFaultGrace(uint32_t now_ms) const {
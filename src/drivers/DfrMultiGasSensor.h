@@ -7,6 +7,9 @@
 #pragma once
 
 #include <Arduino.h>
+#include "config/AppConfig.h"
+
+#include "core/I2cScheduler.h"
 
 struct DfrMultiGasSensorConfig {
     const char *log_tag = "";
@@ -37,6 +40,7 @@ public:
     bool begin();
     bool start();
     void poll();
+    void setPollIntervalMs(uint32_t interval_ms) { poll_interval_ms_ = interval_ms; }
 
     bool isPresent() const { return present_; }
     bool isDataValid() const { return data_valid_; }
@@ -66,11 +70,24 @@ private:
         CommandRejected,
     };
 
+    // What the single in-flight exchange on read_txn_ is for.
+    enum class Exchange : uint8_t {
+        GasRead = 0,
+        PassiveStart,
+        PassiveRecover,
+    };
+
     bool isGasTypeAccepted(uint8_t gas_type_raw) const;
     bool pingAddress();
-    bool setPassiveMode(FailureReason *failure_reason = nullptr);
-    bool readGasConcentration(float &ppm, uint8_t &gas_type, FailureReason &failure_reason);
-    bool transact(const uint8_t *tx_frame, uint8_t *rx_frame, FailureReason *failure_reason = nullptr);
+    bool submitFrame(uint8_t command, uint8_t arg0, Exchange exchange, uint32_t now_ms);
+    void finishExchange(uint32_t now_ms);
+    void finishGasRead(uint32_t now_ms);
+    void finishPassiveStart(FailureReason passive_failure);
+    void finishPassiveRecover(FailureReason passive_failure, uint32_t now_ms);
+    bool decodeGasFrame(const uint8_t *rx, float &ppm, uint8_t &gas_type,
+                        FailureReason &failure_reason) const;
+    bool decodePassiveAck(const uint8_t *rx, FailureReason &failure_reason) const;
+    void cancelExchange();
     bool isInStartupFaultGrace(uint32_t now_ms) const;
     static const char *failureReasonLabel(FailureReason reason);
     static uint8_t checksum7(const uint8_t *frame);
@@ -94,6 +111,7 @@ private:
     bool warmup_started_ = false;
     uint32_t warmup_started_ms_ = 0;
     uint32_t last_poll_ms_ = 0;
+    uint32_t poll_interval_ms_ = Config::DFR_GAS_POLL_MS;
     uint32_t last_data_ms_ = 0;
     uint32_t last_retry_ms_ = 0;
     bool fail_cooldown_active_ = false;
@@ -106,4 +124,6 @@ private:
     bool start_retry_exhausted_logged_ = false;
     FailureReason last_read_failure_reason_ = FailureReason::None;
     FailureReason last_passive_failure_reason_ = FailureReason::None;
+    I2cTransaction read_txn_;
+    Exchange exchange_ = Exchange::GasRead;
 };
@@ -9,6 +9,7 @@
 #include <math.h>
 #include "core/Logger.h"
 #include "config/AppConfig.h"
+#include "core/I2CHelper.h"
 
 bool Dps310::begin() {
     ok_ = false;
@@ -30,9 +31,7 @@ bool Dps310::begin() {
     raw_temperature_ = 0;
     raw_pressure_ = 0;
     last_poll_ms_ = 0;
-    last_data_ms_ = 0;
-    no_data_since_ms_ = 0;
-    last_recover_ms_ = 0;
+    health_.reset();
     pressure_valid_ = false;
     has_new_data_ = false;
     return true;
@@ -48,15 +47,7 @@ int32_t Dps310::twosComplement(int32_t val, uint8_t bits) {
 bool Dps310::detect(uint8_t addr) {
     uint8_t reg = Config::DPS310_PRODREVID;
     uint8_t value = 0;
-    esp_err_t err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        addr,
-        &reg,
-        1,
-        &value,
-        1,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
+    const esp_err_t err = I2C::read_register(addr, reg, &value, 1);
     if (err != ESP_OK) {
         return false;
     }
@@ -69,27 +60,11 @@ bool Dps310::detect(uint8_t addr) {
 
 bool Dps310::writeU8(uint8_t reg, uint8_t value) {
     uint8_t data[2] = { reg, value };
-    esp_err_t err = i2c_master_write_to_device(
-        Config::I2C_PORT,
-        addr_,
-        data,
-        sizeof(data),
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::write_bytes(addr_, data, sizeof(data)) == ESP_OK;
 }
 
 bool Dps310::readBytes(uint8_t reg, uint8_t *buf, size_t len) {
-    esp_err_t err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        addr_,
-        &reg,
-        1,
-        buf,
-        len,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::read_register(addr_, reg, buf, len) == ESP_OK;
 }
 
 bool Dps310::readU8(uint8_t reg, uint8_t &value) {
@@ -315,25 +290,22 @@ bool Dps310::start() {
     ok_ = true;
     pressure_valid_ = false;
     pressure_has_ = false;
-    no_data_since_ms_ = 0;
-    last_data_ms_ = 0;
+    health_.restart();
     has_new_data_ = false;
     return true;
 }
 
 void Dps310::tryRecover(uint32_t now, const char *reason) {
-    if (now - last_recover_ms_ < Config::DPS310_RECOVER_COOLDOWN_MS) {
+    if (!health_.takeRecoverSlot(now)) {
         return;
     }
-    last_recover_ms_ = now;
     Logger::log(Logger::Warn, "DPS310", "%s - reinit", reason);
     bool ok = start();
     if (ok) {
         LOGI("DPS310", "recovery OK");
         ok_ = true;
         pressure_has_ = false;
-        no_data_since_ms_ = 0;
-        last_data_ms_ = 0;
+        health_.restart();
         pressure_valid_ = false;
     } else {
         LOGW("DPS310", "recovery failed");
@@ -342,13 +314,11 @@ void Dps310::tryRecover(uint32_t now, const char *reason) {
 }
 
 void Dps310::handleNoData(uint32_t now, const char *reason) {
-    if (no_data_since_ms_ == 0) {
-        no_data_since_ms_ = now;
-    }
-    if (last_data_ms_ != 0 && (now - last_data_ms_) > Config::DPS310_STALE_MS) {
+    const bool recover_due = health_.noteMiss(now);
+    if (health_.isStale(now)) {
         pressure_valid_ = false;
     }
-    if (now - no_data_since_ms_ >= Config::DPS310_RECOVER_MS) {
+    if (recover_due) {
         tryRecover(now, reason);
     }
 }
@@ -359,7 +329,7 @@ void Dps310::poll() {
         tryRecover(now, "not ready");
         return;
     }
-    if (now - last_poll_ms_ < Config::DPS310_POLL_MS) {
+    if (now - last_poll_ms_ < poll_interval_ms_) {
         return;
     }
     last_poll_ms_ = now;
@@ -386,7 +356,6 @@ void Dps310::poll() {
         return;
     }
     temperature_c_ = temperature_c;
-    no_data_since_ms_ = 0;
 
     if (!pressure_has_) {
         pressure_filtered_ = pressure_hpa;
@@ -396,7 +365,7 @@ void Dps310::poll() {
                               (pressure_hpa - pressure_filtered_);
     }
 
-    last_data_ms_ = now;
+    health_.noteSample(now);
     pressure_valid_ = true;
     has_new_data_ = true;
 }
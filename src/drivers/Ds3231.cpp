@@ -10,6 +10,7 @@
 #include <string.h>
 
 #include "config/AppConfig.h"
+#include "core/I2CHelper.h"
 
 namespace {
 
@@ -97,16 +98,7 @@ bool Ds3231::read(uint8_t reg, uint8_t *buf, size_t len) {
     if (!buf || len == 0) {
         return false;
     }
-    const esp_err_t err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        Config::DS3231_ADDR,
-        &reg,
-        1,
-        buf,
-        len,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::read_register(Config::DS3231_ADDR, reg, buf, len) == ESP_OK;
 }
 
 bool Ds3231::write(uint8_t reg, const uint8_t *buf, size_t len) {
@@ -116,14 +108,7 @@ bool Ds3231::write(uint8_t reg, const uint8_t *buf, size_t len) {
     uint8_t data[19] = { 0 };
     data[0] = reg;
     memcpy(&data[1], buf, len);
-    const esp_err_t err = i2c_master_write_to_device(
-        Config::I2C_PORT,
-        Config::DS3231_ADDR,
-        data,
-        len + 1,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::write_bytes(Config::DS3231_ADDR, data, len + 1) == ESP_OK;
 }
 
 bool Ds3231::readTime(tm &out, bool &osc_stop, bool &valid) {
@@ -219,3 +204,14 @@ bool Ds3231::isBatteryLow(bool &low) {
     low = false;
     return false;
 }
+
+bool Ds3231::readTemperature(float &celsius) {
+    uint8_t raw[2] = {};
+    if (!read(Config::DS3231_REG_TEMP_MSB, raw, sizeof(raw))) {
+        return false;
+    }
+    const int16_t quarter_degrees =
+        static_cast<int16_t>(static_cast<int8_t>(raw[0]) * 4 + (raw[1] >> 6));
+    celsius = static_cast<float>(quarter_degrees) * 0.25f;
+    return true;
+}
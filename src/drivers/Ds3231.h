@@ -24,6 +24,8 @@ public:
     bool writeTime(const tm &utc_tm);
     bool clearOscillatorStop();
     bool isBatteryLow(bool &low);
+    // Die temperature from the TCXO sensor, 0.25 C steps, refreshed by the chip every 64 s.
+    bool readTemperature(float &celsius);
     static const char *label() { return "DS3231"; }
 
 private:
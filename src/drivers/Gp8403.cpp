@@ -9,6 +9,7 @@
 #include <driver/i2c.h>
 
 #include "config/AppConfig.h"
+#include "core/I2CHelper.h"
 
 bool Gp8403::begin(uint8_t address) {
     address_ = address;
@@ -78,14 +79,7 @@ bool Gp8403::writeRegister(uint8_t reg, const uint8_t *data, size_t len) {
         tx[1 + i] = data[i];
     }
 
-    const esp_err_t err = i2c_master_write_to_device(
-        Config::I2C_PORT,
-        address_,
-        tx,
-        len + 1,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::write_bytes(address_, tx, len + 1) == ESP_OK;
 }
 
 bool Gp8403::readRegister(uint8_t reg, uint8_t &value) {
@@ -93,16 +87,7 @@ bool Gp8403::readRegister(uint8_t reg, uint8_t &value) {
         return false;
     }
 
-    const esp_err_t err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        address_,
-        &reg,
-        1,
-        &value,
-        1,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::read_register(address_, reg, &value, 1) == ESP_OK;
 }
 
 uint8_t Gp8403::channelRegister(uint8_t channel) const {
@@ -8,6 +8,7 @@
 #include <driver/i2c.h>
 #include <string.h>
 #include "config/AppConfig.h"
+#include "core/I2CHelper.h"
 
 namespace {
 
@@ -95,16 +96,7 @@ bool Pcf8523::read(uint8_t reg, uint8_t *buf, size_t len) {
     if (!buf || len == 0) {
         return false;
     }
-    esp_err_t err = i2c_master_write_read_device(
-        Config::I2C_PORT,
-        Config::PCF8523_ADDR,
-        &reg,
-        1,
-        buf,
-        len,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::read_register(Config::PCF8523_ADDR, reg, buf, len) == ESP_OK;
 }
 
 bool Pcf8523::write(uint8_t reg, const uint8_t *buf, size_t len) {
@@ -114,14 +106,7 @@ bool Pcf8523::write(uint8_t reg, const uint8_t *buf, size_t len) {
     uint8_t data[8] = { 0 };
     data[0] = reg;
     memcpy(&data[1], buf, len);
-    esp_err_t err = i2c_master_write_to_device(
-        Config::I2C_PORT,
-        Config::PCF8523_ADDR,
-        data,
-        len + 1,
-        pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
-    );
-    return err == ESP_OK;
+    return I2C::write_bytes(Config::PCF8523_ADDR, data, len + 1) == ESP_OK;
 }
 
 bool Pcf8523::readTime(tm &out, bool &osc_stop, bool &valid) {
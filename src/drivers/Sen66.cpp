@@ -24,9 +24,30 @@ bool sen66StateUnknownAfterBoot() {
     return boot_reset_reason != ESP_RST_POWERON;
 }
 
+void encodeWord(uint16_t word, uint8_t *out) {
+    out[0] = static_cast<uint8_t>(word >> 8);
+    out[1] = static_cast<uint8_t>(word & 0xFF);
+    out[2] = I2C::crc8(out, 2);
+}
+
+void encodeWords(const uint16_t *words, size_t count, uint8_t *out) {
+    for (size_t i = 0; i < count; ++i) {
+        encodeWord(words[i], &out[i * 3]);
+    }
+}
+
+void encodeTempOffsetWords(float offset_c, float slope, uint16_t time_constant_s, uint16_t slot,
+                           uint16_t *words) {
+    words[0] = static_cast<uint16_t>(static_cast<int16_t>(lroundf(offset_c * 200.0f)));
+    words[1] = static_cast<uint16_t>(static_cast<int16_t>(lroundf(slope * 10000.0f)));
+    words[2] = time_constant_s;
+    words[3] = slot;
+}
+
 } // namespace
 
 bool Sen66::begin() {
+    cancelPendingIo();
     ok_ = false;
     busy_ = false;
     measuring_ = false;
@@ -46,7 +67,6 @@ bool Sen66::begin() {
     temp_offset_hw_value_ = 0.0f;
     co2_invalid_logged_ = false;
     co2_invalid_since_ms_ = 0;
-    resetCo2Smoother();
     asc_default_known_ = sen66AscDefaultsKnownAfterReset();
     measurement_state_unknown_ = sen66StateUnknownAfterBoot();
     return true;
@@ -56,6 +76,7 @@ void Sen66::setOffsets(float temp_offset, float hum_offset) {
     temp_offset_ = temp_offset;
     hum_offset_ = hum_offset;
     if (ok_ && !busy_) {
+        cancelPendingIo();
         if (!applyTempOffsetParams()) {
             LOGW("SEN66", "temp offset set failed");
         }
@@ -75,20 +96,36 @@ void Sen66::saveVocState(StorageManager &storage) {
         return;
     }
     uint32_t now = millis();
-    if (now - last_voc_state_save_ms_ < Config::SEN66_VOC_STATE_SAVE_MS) {
+    I2cScheduler::instance().poll(now);
+    if (voc_txn_.isPending()) {
         return;
     }
-    uint8_t state[Config::SEN66_VOC_STATE_LEN] = {};
-    if (!getVocState(state, sizeof(state))) {
-        LOGW("SEN66", "VOC state read failed");
+    if (voc_txn_.isFinished()) {
+        uint16_t words[4] = {};
+        const bool read_ok = voc_txn_.decodeWords(words, 4);
+        voc_txn_.release();
         last_voc_state_save_ms_ = now;
+        if (!read_ok) {
+            LOGW("SEN66", "VOC state read failed");
+            return;
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            voc_state_[i * 2] = static_cast<uint8_t>(words[i] >> 8);
+            voc_state_[i * 2 + 1] = static_cast<uint8_t>(words[i] & 0xFF);
+        }
+        voc_state_valid_ = true;
+        storage.saveVocState(voc_state_, sizeof(voc_state_));
+        LOGD("SEN66", "VOC state saved");
         return;
     }
-    memcpy(voc_state_, state, sizeof(voc_state_));
-    voc_state_valid_ = true;
-    storage.saveVocState(voc_state_, sizeof(voc_state_));
-    last_voc_state_save_ms_ = now;
-    LOGD("SEN66", "VOC state saved");
+    if (now - last_voc_state_save_ms_ < Config::SEN66_VOC_STATE_SAVE_MS) {
+        return;
+    }
+    voc_txn_.reset(Config::SEN66_ADDR);
+    voc_txn_.addCommand(Config::SEN66_CMD_VOC_STATE);
+    voc_txn_.addWait(Config::SEN66_CMD_DELAY_MS);
+    voc_txn_.addRead(4 * 3);
+    I2cScheduler::instance().submit(voc_txn_, now);
 }
 
 void Sen66::clearVocState(StorageManager &storage) {
@@ -102,12 +139,8 @@ void Sen66::scheduleRetry(uint32_t delay_ms) {
 }
 
 bool Sen66::writeCmdWithWord(uint16_t cmd, uint16_t word) {
-    uint8_t params[3] = {
-        static_cast<uint8_t>(word >> 8),
-        static_cast<uint8_t>(word & 0xFF),
-        0
-    };
-    params[2] = I2C::crc8(params, 2);
+    uint8_t params[3] = {};
+    encodeWord(word, params);
     return I2C::write_cmd(Config::SEN66_ADDR, cmd, params, sizeof(params)) == ESP_OK;
 }
 
@@ -116,12 +149,7 @@ bool Sen66::writeCmdWithWords(uint16_t cmd, const uint16_t *words, size_t count)
         return false;
     }
     uint8_t params[8 * 3] = {};
-    for (size_t i = 0; i < count; ++i) {
-        const size_t off = i * 3;
-        params[off] = static_cast<uint8_t>(words[i] >> 8);
-        params[off + 1] = static_cast<uint8_t>(words[i] & 0xFF);
-        params[off + 2] = I2C::crc8(&params[off], 2);
-    }
+    encodeWords(words, count, params);
     return I2C::write_cmd(Config::SEN66_ADDR, cmd, params, count * 3) == ESP_OK;
 }
 
@@ -134,14 +162,8 @@ bool Sen66::setAmbientPressure(uint16_t hpa) {
 }
 
 bool Sen66::setTemperatureOffsetParams(float offset_c, float slope, uint16_t time_constant_s, uint16_t slot) {
-    const int16_t offset_scaled = static_cast<int16_t>(lroundf(offset_c * 200.0f));
-    const int16_t slope_scaled = static_cast<int16_t>(lroundf(slope * 10000.0f));
-    const uint16_t words[4] = {
-        static_cast<uint16_t>(offset_scaled),
-        static_cast<uint16_t>(slope_scaled),
-        time_constant_s,
-        slot
-    };
+    uint16_t words[4] = {};
+    encodeTempOffsetWords(offset_c, slope, time_constant_s, slot, words);
     if (!writeCmdWithWords(Config::SEN66_CMD_TEMP_OFFSET, words, 4)) {
         return false;
     }
@@ -163,22 +185,6 @@ bool Sen66::applyTempOffsetParams() {
     return true;
 }
 
-bool Sen66::getDataReady(bool &ready) {
-    uint8_t buf[3];
-    if (I2C::write_cmd(Config::SEN66_ADDR, Config::SEN66_CMD_DATA_READY, nullptr, 0) != ESP_OK) {
-        return false;
-    }
-    delay(Config::SEN66_CMD_DELAY_MS);
-    if (I2C::read_bytes(Config::SEN66_ADDR, buf, sizeof(buf)) != ESP_OK) {
-        return false;
-    }
-    if (I2C::crc8(buf, 2) != buf[2]) {
-        return false;
-    }
-    ready = (buf[1] == 0x01);
-    return true;
-}
-
 bool Sen66::readWords(uint16_t cmd, uint16_t *out, size_t words, uint32_t delay_ms) {
     if (I2C::write_cmd(Config::SEN66_ADDR, cmd, nullptr, 0) != ESP_OK) {
         return false;
@@ -194,7 +200,7 @@ bool Sen66::readWords(uint16_t cmd, uint16_t *out, size_t words, uint32_t delay_
     }
     for (size_t i = 0; i < words; ++i) {
         const uint8_t *p = &buf[i * 3];
-        if (I2C::crc8(p, 2) != p[2]) {
+        if (!I2C::check_crc(Config::SEN66_ADDR, p)) {
             return false;
         }
         out[i] = (static_cast<uint16_t>(p[0]) << 8) | p[1];
@@ -202,42 +208,17 @@ bool Sen66::readWords(uint16_t cmd, uint16_t *out, size_t words, uint32_t delay_
     return true;
 }
 
-bool Sen66::getVocState(uint8_t *state, size_t len) {
-    if (!state || len < Config::SEN66_VOC_STATE_LEN) {
-        return false;
-    }
-    uint16_t words[4];
-    if (!readWords(Config::SEN66_CMD_VOC_STATE, words, 4, Config::SEN66_CMD_DELAY_MS)) {
-        return false;
-    }
-    for (size_t i = 0; i < 4; ++i) {
-        state[i * 2] = static_cast<uint8_t>(words[i] >> 8);
-        state[i * 2 + 1] = static_cast<uint8_t>(words[i] & 0xFF);
-    }
-    return true;
-}
-
-bool Sen66::setVocState(const uint8_t *state, size_t len) {
-    if (!state || len < Config::SEN66_VOC_STATE_LEN) {
-        return false;
-    }
-    uint16_t words[4];
-    for (size_t i = 0; i < 4; ++i) {
-        words[i] = (static_cast<uint16_t>(state[i * 2]) << 8) |
-                   static_cast<uint16_t>(state[i * 2 + 1]);
-    }
-    if (!writeCmdWithWords(Config::SEN66_CMD_VOC_STATE, words, 4)) {
-        return false;
-    }
-    delay(Config::SEN66_CMD_DELAY_MS);
-    return true;
-}
-
 bool Sen66::deviceReset() {
+    cancelPendingIo();
     if (I2C::write_cmd(Config::SEN66_ADDR, Config::SEN66_CMD_DEVICE_RESET, nullptr, 0) != ESP_OK) {
         return false;
     }
     delay(Config::SEN66_DEVICE_RESET_DELAY_MS);
+    clearAfterReset();
+    return true;
+}
+
+void Sen66::clearAfterReset() {
     ok_ = false;
     measuring_ = false;
     measure_start_ms_ = 0;
@@ -249,18 +230,8 @@ bool Sen66::deviceReset() {
     fail_count_ = 0;
     co2_invalid_logged_ = false;
     co2_invalid_since_ms_ = 0;
-    resetCo2Smoother();
     asc_default_known_ = true;
     measurement_state_unknown_ = false;
-    return true;
-}
-
-void Sen66::resetCo2Smoother() {
-    co2_first_ = true;
-    co2_idx_ = 0;
-    for (int &reading : co2_readings_) {
-        reading = 400;
-    }
 }
 
 float Sen66::desiredTempCorrectionC() const {
@@ -274,43 +245,20 @@ bool Sen66::isWarmupActive() const {
     return (millis() - measure_start_ms_) < Config::SEN66_GAS_WARMUP_MS;
 }
 
-int Sen66::smoothCo2(int new_val) {
-    if (co2_first_) {
-        for (int i = 0; i < 5; i++) {
-            co2_readings_[i] = new_val;
-        }
-        co2_first_ = false;
-    }
-
-    long sum = 0;
-    for (int i = 0; i < 5; i++) {
-        sum += co2_readings_[i];
-    }
-    int avg = static_cast<int>(sum / 5);
-
-    if (abs(new_val - avg) > 150) {
-        for (int i = 0; i < 5; i++) {
-            co2_readings_[i] = new_val;
-        }
-        return new_val;
-    }
-
-    co2_readings_[co2_idx_] = new_val;
-    co2_idx_ = (co2_idx_ + 1) % 5;
-
-    sum = 0;
-    for (int i = 0; i < 5; i++) {
-        sum += co2_readings_[i];
-    }
-    return static_cast<int>(sum / 5);
-}
-
 bool Sen66::readValues(SensorData &out) {
     uint16_t words[9];
     if (!readWords(Config::SEN66_CMD_READ_VALUES, words, 9, Config::SEN66_CMD_DELAY_MS)) {
         return false;
     }
+    decodeValues(words, out);
+    if (!readNumberConcentration(out)) {
+        out.pm05_valid = false;
+        out.pm05 = 0.0f;
+    }
+    return true;
+}
 
+void Sen66::decodeValues(const uint16_t *words, SensorData &out) {
     const uint16_t pm1_raw = words[0];
     const uint16_t pm25_raw = words[1];
     const uint16_t pm4_raw = words[2];
@@ -351,11 +299,6 @@ bool Sen66::readValues(SensorData &out) {
         out.pm10 = 0.0f;
     }
 
-    if (!readNumberConcentration(out)) {
-        out.pm05_valid = false;
-        out.pm05 = 0.0f;
-    }
-
     out.pm_valid = out.pm1_valid || out.pm25_valid || out.pm4_valid || out.pm10_valid;
 
     out.hum_valid = (rh_raw != 0x7FFF);
@@ -396,7 +339,7 @@ bool Sen66::readValues(SensorData &out) {
 
     out.co2_valid = (co2_raw != 0xFFFF);
     if (out.co2_valid) {
-        out.co2 = smoothCo2(static_cast<int>(co2_raw));
+        out.co2 = static_cast<int>(co2_raw);
         co2_invalid_since_ms_ = 0;
         co2_invalid_logged_ = false;
     } else {
@@ -409,8 +352,6 @@ bool Sen66::readValues(SensorData &out) {
             co2_invalid_logged_ = true;
         }
     }
-
-    return true;
 }
 
 bool Sen66::readNumberConcentration(SensorData &out) {
@@ -418,7 +359,11 @@ bool Sen66::readNumberConcentration(SensorData &out) {
     if (!readWords(Config::SEN66_CMD_READ_NUM_CONC, words, 5, Config::SEN66_CMD_DELAY_MS)) {
         return false;
     }
+    decodeNumberConcentration(words, out);
+    return true;
+}
 
+void Sen66::decodeNumberConcentration(const uint16_t *words, SensorData &out) {
     const uint16_t pm05_raw = words[0];
     out.pm05_valid = (pm05_raw != 0xFFFF);
     if (out.pm05_valid) {
@@ -426,14 +371,13 @@ bool Sen66::readNumberConcentration(SensorData &out) {
     } else {
         out.pm05 = 0.0f;
     }
-
-    return true;
 }
 
 bool Sen66::stop() {
     if (!measuring_) {
         return true;
     }
+    cancelPendingIo();
     if (I2C::write_cmd(Config::SEN66_ADDR, Config::SEN66_CMD_STOP, nullptr, 0) != ESP_OK) {
         return false;
     }
@@ -530,7 +474,7 @@ bool Sen66::performFrc(uint16_t ref_ppm, uint16_t &correction) {
     if (I2C::read_bytes(Config::SEN66_ADDR, buf, sizeof(buf)) != ESP_OK) {
         return false;
     }
-    if (I2C::crc8(buf, 2) != buf[2]) {
+    if (!I2C::check_crc(Config::SEN66_ADDR, buf)) {
         return false;
     }
     correction = (static_cast<uint16_t>(buf[0]) << 8) | buf[1];
@@ -541,6 +485,10 @@ void Sen66::updatePressure(float pressure_hpa) {
     if (!ok_ || busy_) {
         return;
     }
+    finishPressureUpdate();
+    if (pressure_txn_.isPending()) {
+        return;
+    }
     if (!isfinite(pressure_hpa)) {
         return;
     }
@@ -557,93 +505,347 @@ void Sen66::updatePressure(float pressure_hpa) {
         hpa = Config::SEN66_PRESSURE_MAX_HPA;
     }
 
-    if (setAmbientPressure(hpa)) {
-        last_pressure_hpa_ = hpa;
-        last_pressure_ms_ = now;
+    uint8_t params[3] = {};
+    encodeWord(hpa, params);
+    pressure_txn_.reset(Config::SEN66_ADDR);
+    pressure_txn_.addCommand(Config::SEN66_CMD_AMBIENT_PRESSURE, params, sizeof(params));
+    pressure_txn_.addWait(Config::SEN66_CMD_DELAY_MS);
+    pressure_pending_hpa_ = hpa;
+    if (I2cScheduler::instance().submit(pressure_txn_, now)) {
+        finishPressureUpdate();
+    }
+}
+
+void Sen66::finishPressureUpdate() {
+    if (!pressure_txn_.isFinished()) {
+        return;
+    }
+    if (pressure_txn_.succeeded()) {
+        last_pressure_hpa_ = pressure_pending_hpa_;
+        last_pressure_ms_ = pressure_txn_.submittedMs();
         pressure_fail_count_ = 0;
-    } else {
+    } else if (pressure_txn_.error() != I2cTransaction::Error::Cancelled) {
         if (++pressure_fail_count_ == 3) {
             LOGW("SEN66", "ambient pressure set failed");
             pressure_fail_count_ = 0;
         }
     }
+    pressure_txn_.release();
 }
 
-bool Sen66::forceIdle() {
-    if (!measuring_ && !measurement_state_unknown_) {
-        return true;
+void Sen66::cancelPendingIo() {
+    I2cScheduler &bus = I2cScheduler::instance();
+    bus.cancel(poll_txn_);
+    poll_txn_.release();
+    poll_step_ = PollStep::Idle;
+    bus.cancel(pressure_txn_);
+    pressure_txn_.release();
+    bus.cancel(voc_txn_);
+    voc_txn_.release();
+    bus.cancel(start_txn_);
+    start_txn_.release();
+    if (start_step_ != StartStep::Idle) {
+        LOGW("SEN66", "start sequence interrupted");
+        finishStart(false);
     }
-    if (measurement_state_unknown_) {
-        LOGI("SEN66", "forcing idle after warm restart");
+}
+
+bool Sen66::beginStart(bool asc_enabled) {
+    if (start_step_ != StartStep::Idle) {
+        return false;
     }
-    for (int attempt = 0; attempt < 3; ++attempt) {
-        if (I2C::write_cmd(Config::SEN66_ADDR, Config::SEN66_CMD_STOP, nullptr, 0) == ESP_OK) {
-            delay(Config::SEN66_STOP_DELAY_MS);
-            measuring_ = false;
-            measurement_state_unknown_ = false;
-            return true;
+    cancelPendingIo();
+    busy_ = true;
+    start_result_ = StartResult::None;
+    start_asc_enabled_ = asc_enabled;
+    stop_attempt_ = 0;
+    const uint32_t now = millis();
+    if (measuring_ || measurement_state_unknown_) {
+        if (measurement_state_unknown_) {
+            LOGI("SEN66", "forcing idle after warm restart");
         }
-        delay(Config::SEN66_CMD_DELAY_MS);
+        submitStartStep(StartStep::Stop, 0, now);
+    } else {
+        submitStartStep(StartStep::TempOffset, 0, now);
     }
-    if (measurement_state_unknown_) {
-        LOGW("SEN66", "STOP failed while resyncing state, resetting sensor");
-        if (deviceReset()) {
-            return true;
+    advanceStart(now);
+    return true;
+}
+
+Sen66::StartResult Sen66::takeStartResult() {
+    const StartResult result = start_result_;
+    start_result_ = StartResult::None;
+    return result;
+}
+
+// Each step is one scheduled exchange; |lead_wait_ms| spaces out a retry of the previous one.
+bool Sen66::submitStartStep(StartStep step, uint32_t lead_wait_ms, uint32_t now) {
+    start_txn_.reset(Config::SEN66_ADDR);
+    if (lead_wait_ms > 0) {
+        start_txn_.addWait(lead_wait_ms);
+    }
+    switch (step) {
+        case StartStep::Stop:
+            start_txn_.addCommand(Config::SEN66_CMD_STOP);
+            start_txn_.addWait(Config::SEN66_STOP_DELAY_MS);
+            break;
+        case StartStep::Reset:
+            start_txn_.addCommand(Config::SEN66_CMD_DEVICE_RESET);
+            start_txn_.addWait(Config::SEN66_DEVICE_RESET_DELAY_MS);
+            break;
+        case StartStep::TempOffset: {
+            start_temp_correction_ = desiredTempCorrectionC();
+            uint16_t words[4] = {};
+            encodeTempOffsetWords(start_temp_correction_,
+                                  Config::SEN66_TEMP_OFFSET_SLOPE,
+                                  Config::SEN66_TEMP_OFFSET_TIME_S,
+                                  Config::SEN66_TEMP_OFFSET_SLOT,
+                                  words);
+            uint8_t params[4 * 3] = {};
+            encodeWords(words, 4, params);
+            start_txn_.addCommand(Config::SEN66_CMD_TEMP_OFFSET, params, sizeof(params));
+            start_txn_.addWait(Config::SEN66_CMD_DELAY_MS);
+            break;
         }
+        case StartStep::VocState: {
+            uint16_t words[4] = {};
+            for (size_t i = 0; i < 4; ++i) {
+                words[i] = (static_cast<uint16_t>(voc_state_[i * 2]) << 8) |
+                           static_cast<uint16_t>(voc_state_[i * 2 + 1]);
+            }
+            uint8_t params[4 * 3] = {};
+            encodeWords(words, 4, params);
+            start_txn_.addCommand(Config::SEN66_CMD_VOC_STATE, params, sizeof(params));
+            start_txn_.addWait(Config::SEN66_CMD_DELAY_MS);
+            break;
+        }
+        case StartStep::AscRead:
+        case StartStep::AscVerify:
+            start_txn_.addCommand(Config::SEN66_CMD_ASC);
+            start_txn_.addWait(Config::SEN66_CMD_DELAY_MS);
+            start_txn_.addRead(3);
+            break;
+        case StartStep::AscWrite: {
+            uint8_t params[3] = {};
+            encodeWord(start_asc_enabled_ ? 1 : 0, params);
+            start_txn_.addCommand(Config::SEN66_CMD_ASC, params, sizeof(params));
+            start_txn_.addWait(Config::SEN66_ASC_SETTLE_DELAY_MS);
+            break;
+        }
+        case StartStep::AscStatus:
+            start_txn_.addCommand(Config::SEN66_CMD_READ_STATUS);
+            start_txn_.addWait(Config::SEN66_CMD_DELAY_MS);
+            start_txn_.addRead(2 * 3);
+            break;
+        case StartStep::Measure:
+            start_txn_.addCommand(Config::SEN66_CMD_START);
+            start_txn_.addWait(Config::SEN66_START_DELAY_MS);
+            break;
+        case StartStep::Idle:
+        default:
+            return false;
     }
-    return false;
+    start_step_ = step;
+    if (!I2cScheduler::instance().submit(start_txn_, now)) {
+        start_txn_.release();
+        finishStart(false);
+        return false;
+    }
+    return true;
 }
 
-bool Sen66::start(bool asc_enabled) {
-    busy_ = true;
-    if (!forceIdle()) {
-        ok_ = false;
-        measuring_ = false;
-        busy_ = false;
-        return false;
+void Sen66::advanceStart(uint32_t now) {
+    while (start_step_ != StartStep::Idle && start_txn_.isFinished()) {
+        finishStartStep(now);
     }
-    if (!applyTempOffsetParams()) {
-        LOGW("SEN66", "temp offset set failed");
-    } else {
-        LOGI("SEN66",
-             "temp compensation via HW: base %.1f C, user %.1f C",
-             Config::BASE_TEMP_OFFSET,
-             temp_offset_);
+}
+
+void Sen66::finishStartStep(uint32_t now) {
+    const StartStep step = start_step_;
+    const bool ok = start_txn_.succeeded();
+    uint16_t words[2] = {};
+    const bool read_ok = start_txn_.decodeWords(words, step == StartStep::AscStatus ? 2 : 1);
+    start_txn_.release();
+
+    switch (step) {
+        case StartStep::Stop:
+            if (ok) {
+                measuring_ = false;
+                measurement_state_unknown_ = false;
+                submitStartStep(StartStep::TempOffset, 0, now);
+            } else if (++stop_attempt_ < 3) {
+                submitStartStep(StartStep::Stop, Config::SEN66_CMD_DELAY_MS, now);
+            } else if (measurement_state_unknown_) {
+                LOGW("SEN66", "STOP failed while resyncing state, resetting sensor");
+                submitStartStep(StartStep::Reset, 0, now);
+            } else {
+                finishStart(false);
+            }
+            break;
+        case StartStep::Reset:
+            if (!ok) {
+                finishStart(false);
+                break;
+            }
+            clearAfterReset();
+            submitStartStep(StartStep::TempOffset, 0, now);
+            break;
+        case StartStep::TempOffset:
+            if (ok) {
+                temp_offset_hw_active_ = true;
+                temp_offset_hw_value_ = start_temp_correction_;
+                LOGI("SEN66",
+                     "temp compensation via HW: base %.1f C, user %.1f C",
+                     Config::BASE_TEMP_OFFSET,
+                     temp_offset_);
+            } else {
+                LOGW("SEN66", "temp offset set failed");
+            }
+            continueAfterTempOffset(now);
+            break;
+        case StartStep::VocState:
+            if (ok) {
+                LOGI("SEN66", "VOC state restored");
+            } else {
+                LOGW("SEN66", "VOC state restore failed");
+            }
+            continueWithAsc(now);
+            break;
+        case StartStep::AscRead: {
+            AscProgress &asc = asc_progress_;
+            asc.initial_read_ok = read_ok;
+            asc.initial_value = read_ok && words[0] == 1;
+            if (read_ok && asc.initial_value == start_asc_enabled_) {
+                continueAfterAsc(true, now);
+                break;
+            }
+            asc.verify_read_failures = read_ok ? 0 : 1;
+            asc.saw_verify_value = read_ok;
+            asc.last_verify_value = asc.initial_value;
+            submitStartStep(StartStep::AscWrite, 0, now);
+            break;
+        }
+        case StartStep::AscWrite: {
+            AscProgress &asc = asc_progress_;
+            if (ok) {
+                asc.verify_attempt = 0;
+                submitStartStep(StartStep::AscVerify, 0, now);
+            } else {
+                ++asc.write_failures;
+                if (++asc.write_attempt < Config::SEN66_ASC_WRITE_ATTEMPTS) {
+                    submitStartStep(StartStep::AscWrite, Config::SEN66_ASC_RETRY_DELAY_MS, now);
+                } else {
+                    submitStartStep(StartStep::AscStatus, 0, now);
+                }
+            }
+            break;
+        }
+        case StartStep::AscVerify: {
+            AscProgress &asc = asc_progress_;
+            if (read_ok) {
+                asc.saw_verify_value = true;
+                asc.last_verify_value = words[0] == 1;
+                if (asc.last_verify_value == start_asc_enabled_) {
+                    continueAfterAsc(true, now);
+                    break;
+                }
+            } else {
+                ++asc.verify_read_failures;
+            }
+            if (++asc.verify_attempt < Config::SEN66_ASC_VERIFY_ATTEMPTS) {
+                submitStartStep(StartStep::AscVerify, Config::SEN66_ASC_RETRY_DELAY_MS, now);
+            } else if (++asc.write_attempt < Config::SEN66_ASC_WRITE_ATTEMPTS) {
+                submitStartStep(StartStep::AscWrite, Config::SEN66_ASC_RETRY_DELAY_MS, now);
+            } else {
+                submitStartStep(StartStep::AscStatus, Config::SEN66_ASC_RETRY_DELAY_MS, now);
+            }
+            break;
+        }
+        case StartStep::AscStatus: {
+            const AscProgress &asc = asc_progress_;
+            const uint32_t status =
+                (static_cast<uint32_t>(words[0]) << 16) | static_cast<uint32_t>(words[1]);
+            LOGW("SEN66",
+                 "ASC apply detail: target=%s initial_read=%s write_failures=%u verify_read_failures=%u last_verify=%s%s",
+                 start_asc_enabled_ ? "enable" : "disable",
+                 asc.initial_read_ok ? (asc.initial_value ? "enabled" : "disabled") : "failed",
+                 static_cast<unsigned>(asc.write_failures),
+                 static_cast<unsigned>(asc.verify_read_failures),
+                 asc.saw_verify_value ? (asc.last_verify_value ? "enabled" : "disabled") : "n/a",
+                 read_ok ? "" : ", status=read-failed");
+            if (read_ok && status != 0) {
+                LOGW("SEN66", "ASC apply device status: 0x%08lX", static_cast<unsigned long>(status));
+            }
+            continueAfterAsc(false, now);
+            break;
+        }
+        case StartStep::Measure:
+            if (!ok) {
+                finishStart(false);
+                break;
+            }
+            measuring_ = true;
+            measurement_state_unknown_ = false;
+            if (measure_start_ms_ == 0) {
+                measure_start_ms_ = now;
+            }
+            last_voc_state_save_ms_ = now;
+            asc_default_known_ = false;
+            finishStart(true);
+            break;
+        case StartStep::Idle:
+        default:
+            break;
     }
+}
+
+void Sen66::continueAfterTempOffset(uint32_t now) {
     if (voc_state_valid_) {
-        if (!setVocState(voc_state_, sizeof(voc_state_))) {
-            LOGW("SEN66", "VOC state restore failed");
-        } else {
-            LOGI("SEN66", "VOC state restored");
-        }
+        submitStartStep(StartStep::VocState, 0, now);
+    } else {
+        continueWithAsc(now);
     }
-    if (asc_enabled && asc_default_known_) {
+}
+
+void Sen66::continueWithAsc(uint32_t now) {
+    if (start_asc_enabled_ && asc_default_known_) {
         // ASC is volatile and defaults to enabled after a hard reset.
         Logger::log(Logger::Info, "SEN66", "ASC enabled (default after reset)");
-    } else if (!setAscRaw(asc_enabled)) {
-        Logger::log(Logger::Warn, "SEN66",
-                    "ASC set failed (%s)",
-                    asc_enabled ? "enable" : "disable");
-    } else {
+        submitStartStep(StartStep::Measure, 0, now);
+        return;
+    }
+    asc_progress_ = AscProgress{};
+    submitStartStep(StartStep::AscRead, 0, now);
+}
+
+void Sen66::continueAfterAsc(bool applied, uint32_t now) {
+    if (applied) {
         Logger::log(Logger::Info, "SEN66",
                     "ASC %s",
-                    asc_enabled ? "enabled" : "disabled");
+                    start_asc_enabled_ ? "enabled" : "disabled");
+    } else {
+        Logger::log(Logger::Warn, "SEN66",
+                    "ASC set failed (%s)",
+                    start_asc_enabled_ ? "enable" : "disable");
     }
-    if (!startMeasurement()) {
-        ok_ = false;
-        busy_ = false;
-        return false;
+    submitStartStep(StartStep::Measure, 0, now);
+}
+
+void Sen66::finishStart(bool started) {
+    start_step_ = StartStep::Idle;
+    ok_ = started;
+    if (!started) {
+        measuring_ = false;
     }
-    asc_default_known_ = false;
-    ok_ = true;
     busy_ = false;
-    return true;
+    start_result_ = started ? StartResult::Started : StartResult::Failed;
 }
 
 bool Sen66::setAscEnabled(bool enabled) {
     if (!ok_) {
         return false;
     }
+    cancelPendingIo();
     busy_ = true;
     bool was_measuring = measuring_;
     if (was_measuring && !stop()) {
@@ -672,6 +874,7 @@ bool Sen66::calibrateFRC(uint16_t ref_ppm, bool has_pressure, float pressure_hpa
     if (!ok_) {
         return false;
     }
+    cancelPendingIo();
     busy_ = true;
     if (!stop()) {
         LOGW("SEN66", "stop failed for FRC");
@@ -720,62 +923,129 @@ bool Sen66::readStatus(uint32_t &status) {
     return true;
 }
 
-void Sen66::poll(SensorData &data, bool &changed) {
-    changed = false;
-    if (!ok_ || busy_ || !measuring_) {
-        return;
+void Sen66::handleStatus(uint32_t status) {
+    if (status != status_last_) {
+        if (status != 0) {
+            Logger::log(Logger::Debug, "SEN66", "status: 0x%08lX",
+                        static_cast<unsigned long>(status));
+        }
+        Sen66Status::Transition transitions[8] = {};
+        const size_t transition_count =
+            Sen66Status::collectTransitions(status_last_,
+                                            status,
+                                            transitions,
+                                            sizeof(transitions) / sizeof(transitions[0]));
+        for (size_t i = 0; i < transition_count; ++i) {
+            Logger::log(transitions[i].level, "SEN66", "%s", transitions[i].message);
+        }
     }
-    uint32_t now = millis();
-    if (now - last_poll_ms_ < Config::SEN66_POLL_MS) {
-        return;
+    status_last_ = status;
+}
+
+bool Sen66::submitRead(uint16_t cmd, size_t words, PollStep step, uint32_t now) {
+    poll_txn_.reset(Config::SEN66_ADDR);
+    poll_txn_.addCommand(cmd);
+    poll_txn_.addWait(Config::SEN66_CMD_DELAY_MS);
+    poll_txn_.addRead(words * 3);
+    if (!I2cScheduler::instance().submit(poll_txn_, now)) {
+        poll_step_ = PollStep::Idle;
+        return false;
     }
-    last_poll_ms_ = now;
+    poll_step_ = step;
+    poll_word_count_ = static_cast<uint8_t>(words);
+    return true;
+}
 
-    if (now - last_status_ms_ >= Config::SEN66_STATUS_MS) {
-        uint32_t status = 0;
-        if (readStatus(status)) {
-            if (status != status_last_) {
-                if (status != 0) {
-                    Logger::log(Logger::Debug, "SEN66", "status: 0x%08lX",
-                                static_cast<unsigned long>(status));
+void Sen66::finishPollStep(SensorData &data, bool &changed, uint32_t now) {
+    const PollStep step = poll_step_;
+    poll_step_ = PollStep::Idle;
+    uint16_t words[9] = {};
+    const bool read_ok = poll_txn_.decodeWords(words, poll_word_count_);
+    poll_txn_.release();
+
+    switch (step) {
+        case PollStep::Status:
+            if (read_ok) {
+                handleStatus((static_cast<uint32_t>(words[0]) << 16) |
+                             static_cast<uint32_t>(words[1]));
+            }
+            last_status_ms_ = poll_started_ms_;
+            submitRead(Config::SEN66_CMD_DATA_READY, 1, PollStep::DataReady, now);
+            break;
+        case PollStep::DataReady:
+            if (!read_ok) {
+                if (++fail_count_ == 3) {
+                    LOGW("SEN66", "data ready read failed");
+                    fail_count_ = 0;
                 }
-                Sen66Status::Transition transitions[8] = {};
-                const size_t transition_count =
-                    Sen66Status::collectTransitions(status_last_,
-                                                    status,
-                                                    transitions,
-                                                    sizeof(transitions) / sizeof(transitions[0]));
-                for (size_t i = 0; i < transition_count; ++i) {
-                    Logger::log(transitions[i].level, "SEN66", "%s", transitions[i].message);
+                break;
+            }
+            if ((words[0] & 0xFF) == 0x01) {
+                submitRead(Config::SEN66_CMD_READ_VALUES, 9, PollStep::Values, now);
+            }
+            break;
+        case PollStep::Values:
+            if (!read_ok) {
+                if (++fail_count_ == 3) {
+                    LOGW("SEN66", "read values failed");
+                    fail_count_ = 0;
                 }
+                break;
             }
-            status_last_ = status;
+            memcpy(pending_values_, words, sizeof(pending_values_));
+            submitRead(Config::SEN66_CMD_READ_NUM_CONC, 5, PollStep::NumberConcentration, now);
+            break;
+        case PollStep::NumberConcentration: {
+            SensorData newData = data;
+            decodeValues(pending_values_, newData);
+            if (read_ok) {
+                decodeNumberConcentration(words, newData);
+            } else {
+                newData.pm05_valid = false;
+                newData.pm05 = 0.0f;
+            }
+            changed = (memcmp(&data, &newData, sizeof(SensorData)) != 0);
+            data = newData;
+            last_data_ms_ = poll_started_ms_;
+            fail_count_ = 0;
+            break;
         }
-        last_status_ms_ = now;
+        case PollStep::Idle:
+        default:
+            break;
     }
+}
 
-    bool ready = false;
-    if (!getDataReady(ready)) {
-        if (++fail_count_ == 3) {
-            LOGW("SEN66", "data ready read failed");
-            fail_count_ = 0;
-        }
+void Sen66::poll(SensorData &data, bool &changed) {
+    changed = false;
+    if (start_step_ != StartStep::Idle) {
+        const uint32_t now = millis();
+        I2cScheduler::instance().poll(now);
+        advanceStart(now);
         return;
     }
-    if (!ready) {
+    if (!ok_ || busy_ || !measuring_) {
         return;
     }
+    uint32_t now = millis();
+    I2cScheduler::instance().poll(now);
+    finishPressureUpdate();
 
-    SensorData newData = data;
-    if (readValues(newData)) {
-        changed = (memcmp(&data, &newData, sizeof(SensorData)) != 0);
-        data = newData;
-        last_data_ms_ = now;
-        fail_count_ = 0;
-    } else {
-        if (++fail_count_ == 3) {
-            LOGW("SEN66", "read values failed");
-            fail_count_ = 0;
+    if (poll_step_ == PollStep::Idle) {
+        if (now - last_poll_ms_ < poll_interval_ms_) {
+            return;
         }
+        last_poll_ms_ = now;
+        poll_started_ms_ = now;
+        // One cycle: optional status, data-ready, values, number concentration. Each step
+        // is a command, a SEN66_CMD_DELAY_MS wait and a read issued by later polls.
+        if (now - last_status_ms_ >= Config::SEN66_STATUS_MS) {
+            submitRead(Config::SEN66_CMD_READ_STATUS, 2, PollStep::Status, now);
+        } else {
+            submitRead(Config::SEN66_CMD_DATA_READY, 1, PollStep::DataReady, now);
+        }
+    }
+    while (poll_step_ != PollStep::Idle && poll_txn_.isFinished()) {
+        finishPollStep(data, changed, now);
     }
 }
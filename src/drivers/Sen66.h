@@ -10,9 +10,16 @@
 class StorageManager;
 #include "config/AppConfig.h"
 #include "config/AppData.h"
+#include "core/I2cScheduler.h"
 
 class Sen66 {
 public:
+    enum class StartResult : uint8_t {
+        None = 0,
+        Started,
+        Failed,
+    };
+
     bool begin();
     void setOffsets(float temp_offset, float hum_offset);
     void loadVocState(StorageManager &storage);
@@ -21,9 +28,14 @@ public:
     void scheduleRetry(uint32_t delay_ms);
     uint32_t retryAtMs() const { return retry_at_ms_; }
 
-    bool start(bool asc_enabled);
+    // Starts the stop/configure/start sequence on the I2C scheduler. poll() advances it and
+    // the sensor reports busy until takeStartResult() has an outcome.
+    bool beginStart(bool asc_enabled);
+    // The outcome of the last start sequence, once; None while it is still running.
+    StartResult takeStartResult();
     bool stop();
     void poll(SensorData &data, bool &changed);
+    void setPollIntervalMs(uint32_t interval_ms) { poll_interval_ms_ = interval_ms; }
     bool readValues(SensorData &out);
     bool calibrateFRC(uint16_t ref_ppm, bool has_pressure, float pressure_hpa, uint16_t &correction);
     void updatePressure(float pressure_hpa);
@@ -37,24 +49,66 @@ public:
     uint32_t lastDataMs() const { return last_data_ms_; }
 
 private:
+    enum class PollStep : uint8_t {
+        Idle = 0,
+        Status,
+        DataReady,
+        Values,
+        NumberConcentration,
+    };
+
+    enum class StartStep : uint8_t {
+        Idle = 0,
+        Stop,
+        Reset,
+        TempOffset,
+        VocState,
+        AscRead,
+        AscWrite,
+        AscVerify,
+        AscStatus,
+        Measure,
+    };
+
+    // Bookkeeping for the ASC write/verify retries, kept for the failure detail log.
+    struct AscProgress {
+        bool initial_read_ok = false;
+        bool initial_value = false;
+        uint8_t write_attempt = 0;
+        uint8_t verify_attempt = 0;
+        uint8_t write_failures = 0;
+        uint8_t verify_read_failures = 0;
+        bool saw_verify_value = false;
+        bool last_verify_value = false;
+    };
+
     bool writeCmdWithWord(uint16_t cmd, uint16_t word);
     bool writeCmdWithWords(uint16_t cmd, const uint16_t *words, size_t count);
     bool setAmbientPressure(uint16_t hpa);
-    bool getDataReady(bool &ready);
     bool readWords(uint16_t cmd, uint16_t *out, size_t words, uint32_t delay_ms);
-    bool getVocState(uint8_t *state, size_t len);
-    bool setVocState(const uint8_t *state, size_t len);
     bool readStatus(uint32_t &status);
     bool setTemperatureOffsetParams(float offset_c, float slope, uint16_t time_constant_s, uint16_t slot);
     bool applyTempOffsetParams();
     bool startMeasurement();
-    bool forceIdle();
-    void resetCo2Smoother();
     bool setAscRaw(bool enabled);
     bool getAsc(bool &enabled);
     bool performFrc(uint16_t ref_ppm, uint16_t &correction);
     bool readNumberConcentration(SensorData &out);
-    int smoothCo2(int new_val);
+    void decodeValues(const uint16_t *words, SensorData &out);
+    void decodeNumberConcentration(const uint16_t *words, SensorData &out);
+    bool submitRead(uint16_t cmd, size_t words, PollStep step, uint32_t now);
+    void finishPollStep(SensorData &data, bool &changed, uint32_t now);
+    void handleStatus(uint32_t status);
+    void finishPressureUpdate();
+    void cancelPendingIo();
+    void clearAfterReset();
+    bool submitStartStep(StartStep step, uint32_t lead_wait_ms, uint32_t now);
+    void advanceStart(uint32_t now);
+    void finishStartStep(uint32_t now);
+    void continueAfterTempOffset(uint32_t now);
+    void continueWithAsc(uint32_t now);
+    void continueAfterAsc(bool applied, uint32_t now);
+    void finishStart(bool started);
     float desiredTempCorrectionC() const;
 
     float temp_offset_ = 0.0f;
@@ -63,6 +117,7 @@ private:
     bool busy_ = false;
     bool measuring_ = false;
     uint32_t last_poll_ms_ = 0;
+    uint32_t poll_interval_ms_ = Config::SEN66_POLL_MS;
     uint32_t last_status_ms_ = 0;
     uint8_t fail_count_ = 0;
     uint32_t status_last_ = 0;
@@ -81,9 +136,25 @@ private:
 
     bool co2_invalid_logged_ = false;
     uint32_t co2_invalid_since_ms_ = 0;
-    bool co2_first_ = true;
-    int co2_readings_[5] = { 400, 400, 400, 400, 400 };
-    int co2_idx_ = 0;
     bool asc_default_known_ = false;
     bool measurement_state_unknown_ = false;
+
+    // Periodic reads and the start sequence go through the I2C scheduler so poll() never
+    // sleeps between a command and its response; user-triggered ASC and FRC changes stay
+    // synchronous.
+    I2cTransaction poll_txn_;
+    PollStep poll_step_ = PollStep::Idle;
+    uint8_t poll_word_count_ = 0;
+    uint32_t poll_started_ms_ = 0;
+    uint16_t pending_values_[9] = {};
+    I2cTransaction pressure_txn_;
+    uint16_t pressure_pending_hpa_ = 0;
+    I2cTransaction voc_txn_;
+    I2cTransaction start_txn_;
+    StartStep start_step_ = StartStep::Idle;
+    StartResult start_result_ = StartResult::None;
+    bool start_asc_enabled_ = false;
+    uint8_t stop_attempt_ = 0;
+    float start_temp_correction_ = 0.0f;
+    AscProgress asc_progress_{};
 };
@@ -11,6 +11,7 @@
 #include "config/AppConfig.h"
 #include "core/BootState.h"
 #include "core/I2CHelper.h"
+#include "core/I2cTelemetry.h"
 #include "core/Logger.h"
 
 namespace {
@@ -22,6 +23,7 @@ bool sfa30StateUnknownAfterBoot() {
 } // namespace
 
 bool Sfa30::begin() {
+    cancelRead();
     ok_ = true;
     measuring_ = false;
     measurement_state_unknown_ = sfa30StateUnknownAfterBoot();
@@ -59,6 +61,7 @@ void Sfa30::start() {
     if (measuring_ && !measurement_state_unknown_) {
         return;
     }
+    cancelRead();
     if (!probe()) {
         ok_ = false;
         LOGW(label(), "detect failed (%s)", errorCauseLabel());
@@ -96,6 +99,7 @@ void Sfa30::stop() {
     if (!measuring_ && !measurement_state_unknown_) {
         return;
     }
+    cancelRead();
     if (!writeCmd(Config::SFA3X_CMD_STOP)) {
         measurement_state_unknown_ = true;
         return;
@@ -120,13 +124,49 @@ void Sfa30::poll() {
         return;
     }
     const uint32_t now = millis();
-    if (now - last_poll_ms_ < Config::SFA3X_POLL_MS) {
+    I2cScheduler &bus = I2cScheduler::instance();
+    bus.poll(now);
+    if (read_txn_.isPending()) {
+        return;
+    }
+    if (read_txn_.isFinished()) {
+        finishRead();
+        return;
+    }
+    if (now - last_poll_ms_ < poll_interval_ms_) {
         return;
     }
     last_poll_ms_ = now;
 
-    float hcho_ppb = 0.0f;
-    if (!readData(hcho_ppb)) {
+    read_txn_.reset(Config::SFA3X_ADDR);
+    read_txn_.addCommand(Config::SFA3X_CMD_READ_VALUES);
+    read_txn_.addWait(Config::SFA3X_READ_DELAY_MS);
+    read_txn_.addRead(3 * 3);
+    if (bus.submit(read_txn_, now) && read_txn_.isFinished()) {
+        finishRead();
+    }
+}
+
+void Sfa30::finishRead() {
+    uint16_t words[3] = {};
+    bool read_ok = false;
+    if (read_txn_.error() == I2cTransaction::Error::Cancelled) {
+        read_txn_.release();
+        return;
+    }
+    if (read_txn_.error() == I2cTransaction::Error::Write) {
+        last_error_cause_ = ErrorCause::ReadCommand;
+    } else if (read_txn_.error() == I2cTransaction::Error::Read) {
+        last_error_cause_ = ErrorCause::ReadBytes;
+    } else if (!read_txn_.decodeWords(words, 3)) {
+        last_error_cause_ = ErrorCause::ReadCrc;
+    } else {
+        read_ok = true;
+    }
+    read_txn_.release();
+
+    const float hcho_ppb = static_cast<int16_t>(words[0]) / 5.0f;
+    if (!read_ok) {
         if (++fail_count_ == 3) {
             if (status_ != Status::Absent) {
                 status_ = Status::Fault;
@@ -144,10 +184,15 @@ void Sfa30::poll() {
         last_hcho_ppb_ = hcho_ppb;
         data_valid_ = true;
         has_new_data_ = true;
-        last_data_ms_ = now;
+        last_data_ms_ = last_poll_ms_;
     }
 }
 
+void Sfa30::cancelRead() {
+    I2cScheduler::instance().cancel(read_txn_);
+    read_txn_.release();
+}
+
 bool Sfa30::takeNewData(float &hcho_ppb) {
     if (!has_new_data_ || !data_valid_) {
         return false;
@@ -227,7 +272,7 @@ bool Sfa30::readWords(uint16_t cmd, uint16_t *out, size_t words, uint32_t delay_
     }
     for (size_t i = 0; i < words; ++i) {
         const uint8_t *p = &buf[i * 3];
-        if (I2C::crc8(p, 2) != p[2]) {
+        if (!I2C::check_crc(Config::SFA3X_ADDR, p)) {
             last_error_cause_ = ErrorCause::ReadCrc;
             return false;
         }
@@ -262,12 +307,14 @@ bool Sfa30::pingAddress() {
     i2c_master_start(cmd);
     i2c_master_write_byte(cmd, (Config::SFA3X_ADDR << 1) | I2C_MASTER_WRITE, true);
     i2c_master_stop(cmd);
+    const uint32_t started_us = micros();
     const esp_err_t err = i2c_master_cmd_begin(
         Config::I2C_PORT,
         cmd,
         pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
     );
     i2c_cmd_link_delete(cmd);
+    I2cTelemetry::instance().record(Config::SFA3X_ADDR, 0, err, started_us);
     return err == ESP_OK;
 }
 
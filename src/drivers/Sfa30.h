@@ -7,6 +7,9 @@
 #pragma once
 
 #include <Arduino.h>
+#include "config/AppConfig.h"
+
+#include "core/I2cScheduler.h"
 
 class Sfa30 {
 public:
@@ -22,6 +25,7 @@ public:
     void stop();
     bool readData(float &hcho_ppb);
     void poll();
+    void setPollIntervalMs(uint32_t interval_ms) { poll_interval_ms_ = interval_ms; }
     bool isDataValid() const { return data_valid_; }
     bool isOk() const { return status_ == Status::Ok; }
     bool isPresent() const { return status_ != Status::Absent; }
@@ -46,6 +50,8 @@ private:
 
     bool detectSensor();
     bool readWords(uint16_t cmd, uint16_t *out, size_t words, uint32_t delay_ms);
+    void finishRead();
+    void cancelRead();
     bool ensureIdleBeforeStart();
     bool pingAddress();
     bool writeCmd(uint16_t cmd);
@@ -60,9 +66,11 @@ private:
     bool has_new_data_ = false;
     float last_hcho_ppb_ = 0.0f;
     uint32_t last_poll_ms_ = 0;
+    uint32_t poll_interval_ms_ = Config::SFA3X_POLL_MS;
     uint32_t warmup_deadline_ms_ = 0;
     uint32_t last_data_ms_ = 0;
     uint8_t fail_count_ = 0;
     Status status_ = Status::Absent;
     ErrorCause last_error_cause_ = ErrorCause::None;
+    I2cTransaction read_txn_;
 };
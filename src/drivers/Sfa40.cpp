@@ -11,6 +11,7 @@
 #include "config/AppConfig.h"
 #include "core/BootState.h"
 #include "core/I2CHelper.h"
+#include "core/I2cTelemetry.h"
 #include "core/Logger.h"
 
 namespace {
@@ -245,7 +246,7 @@ void Sfa40::poll() {
     if (static_cast<int32_t>(now - next_measurement_read_ms_) < 0) {
         return;
     }
-    if (now - last_poll_ms_ < Config::SFA40_POLL_MS) {
+    if (now - last_poll_ms_ < poll_interval_ms_) {
         return;
     }
     last_poll_ms_ = now;
@@ -349,7 +350,7 @@ bool Sfa40::readWords(uint16_t cmd, uint16_t *out, size_t words, uint32_t delay_
     }
     for (size_t i = 0; i < words; ++i) {
         const uint8_t *p = &buf[i * 3];
-        if (I2C::crc8(p, 2) != p[2]) {
+        if (!I2C::check_crc(Config::SFA3X_ADDR, p)) {
             last_error_cause_ = ErrorCause::ReadCrc;
             return false;
         }
@@ -401,12 +402,14 @@ bool Sfa40::pingAddress() {
     i2c_master_start(cmd);
     i2c_master_write_byte(cmd, (Config::SFA3X_ADDR << 1) | I2C_MASTER_WRITE, true);
     i2c_master_stop(cmd);
+    const uint32_t started_us = micros();
     const esp_err_t err = i2c_master_cmd_begin(
         Config::I2C_PORT,
         cmd,
         pdMS_TO_TICKS(Config::I2C_TIMEOUT_MS)
     );
     i2c_cmd_link_delete(cmd);
+    I2cTelemetry::instance().record(Config::SFA3X_ADDR, 0, err, started_us);
     return err == ESP_OK;
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include "config/AppConfig.h"
 
 class Sfa40 {
 public:
@@ -31,6 +32,7 @@ public:
     bool startSelfTest();
     SelfTestStatus readSelfTestStatus(uint16_t &raw_result);
     void poll();
+    void setPollIntervalMs(uint32_t interval_ms) { poll_interval_ms_ = interval_ms; }
     bool isDataValid() const { return data_valid_; }
     bool isOk() const { return status_ == Status::Ok; }
     bool isPresent() const { return status_ != Status::Absent; }
@@ -78,6 +80,7 @@ private:
     bool has_new_data_ = false;
     float last_hcho_ppb_ = 0.0f;
     uint32_t last_poll_ms_ = 0;
+    uint32_t poll_interval_ms_ = Config::SFA40_POLL_MS;
     uint32_t next_measurement_read_ms_ = 0;
     uint32_t last_data_ms_ = 0;
     uint8_t fail_count_ = 0;
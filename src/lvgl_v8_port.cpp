@@ -7,12 +7,16 @@
 #include "esp_timer.h"
 #include "esp_debug_helpers.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
 #include <atomic>
 #include <string.h>
 #undef ESP_UTILS_LOG_TAG
 #define ESP_UTILS_LOG_TAG "LvPort"
 #include "esp_lib_utils.h"
+#include "core/BootProfiler.h"
 #include "core/BootState.h"
+#include "ui/UiCardBackdrop.h"
+#include "ui/UiCardCache.h"
 #include "lvgl_v8_port.h"
 
 using namespace esp_panel::drivers;
@@ -51,6 +55,9 @@ static volatile uint32_t lvgl_diag_vsync_count = 0;
 static volatile uint32_t lvgl_diag_vsync_last_ms = 0;
 static volatile uint32_t lvgl_diag_lock_fail_count = 0;
 static volatile uint32_t lvgl_diag_touch_read_error_count = 0;
+static volatile uint32_t lvgl_diag_frame_count = 0;
+static volatile uint32_t lvgl_diag_frame_us_avg = 0;
+static volatile uint32_t lvgl_diag_frame_us_max = 0;
 static constexpr uint32_t LVGL_TOUCH_POLL_INTERVAL_MS = 12;
 static constexpr uint32_t LVGL_TOUCH_READ_RETRY_DELAY_MS = 2;
 static constexpr uint32_t LVGL_TOUCH_ERROR_STREAK_WINDOW_MS = 1200;
@@ -86,6 +93,22 @@ static inline void lvgl_diag_mark_flush()
 {
     lvgl_diag_flush_last_ms = get_rtos_ms();
     ++lvgl_diag_flush_count;
+    BootProfiler::instance().noteFrame();
+}
+
+// One lv_timer_handler() pass that flushed pixels. Running average over ~16 frames.
+static inline void lvgl_diag_mark_frame(uint32_t frame_us)
+{
+    const uint32_t count = lvgl_diag_frame_count + 1;
+    const uint32_t avg = lvgl_diag_frame_us_avg;
+    lvgl_diag_frame_us_avg = (count == 1) ? frame_us
+                                          : static_cast<uint32_t>(static_cast<int32_t>(avg) +
+                                                                  (static_cast<int32_t>(frame_us) -
+                                                                   static_cast<int32_t>(avg)) / 16);
+    if (frame_us > lvgl_diag_frame_us_max) {
+        lvgl_diag_frame_us_max = frame_us;
+    }
+    lvgl_diag_frame_count = count;
 }
 
 static inline uint32_t lvgl_diag_age_ms(uint32_t now_ms, uint32_t stamp_ms)
@@ -1094,7 +1117,14 @@ static void lvgl_port_task(void *arg)
 
         if (lvgl_port_lock(-1)) {
             lvgl_diag_mark_timer_handler();
+            const uint32_t flush_before = lvgl_diag_flush_count;
+            const int64_t handler_start_us = esp_timer_get_time();
             task_delay_ms = lv_timer_handler();
+            if (lvgl_diag_flush_count != flush_before) {
+                const uint32_t frame_us = static_cast<uint32_t>(esp_timer_get_time() - handler_start_us);
+                lvgl_diag_mark_frame(frame_us);
+                UiCardBackdrop::endFrame(frame_us);
+            }
             lvgl_port_unlock();
         }
         if (task_delay_ms > LVGL_PORT_TASK_MAX_DELAY_MS) {
@@ -1280,6 +1310,14 @@ bool lvgl_port_get_diagnostics(lvgl_port_diagnostics_t *out)
     out->lock_fail_count = lvgl_diag_lock_fail_count;
     out->touch_read_error_count = lvgl_diag_touch_read_error_count;
     out->paused = lvgl_port_paused.load(std::memory_order_acquire);
+    out->frame_count = lvgl_diag_frame_count;
+    out->frame_us_avg = lvgl_diag_frame_us_avg;
+    out->frame_us_max = lvgl_diag_frame_us_max;
+
+    UiCardCache::Stats cards;
+    UiCardCache::instance().stats(cards);
+    out->card_frame_us_cached = cards.frame_us_cached;
+    out->card_frame_us_direct = cards.frame_us_direct;
 
     return true;
 }
@@ -259,6 +259,11 @@ typedef struct {
     uint32_t lock_fail_count;
     uint32_t touch_read_error_count;
     bool paused;
+    uint32_t frame_count;          // lv_timer_handler() passes that flushed pixels
+    uint32_t frame_us_avg;
+    uint32_t frame_us_max;
+    uint32_t card_frame_us_cached; // average frame drawing cards from the background cache
+    uint32_t card_frame_us_direct; // average probe frame drawing the same cards directly
 } lvgl_port_diagnostics_t;
 
 /**
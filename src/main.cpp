@@ -12,6 +12,7 @@
 
 #include "core/AppInit.h"
 #include "core/BootPolicy.h"
+#include "core/BootProfiler.h"
 #include "core/ChartsRuntimeState.h"
 #include "core/ConnectivityRuntime.h"
 #include "core/Logger.h"
@@ -19,7 +20,11 @@
 #include "core/MqttRuntimeState.h"
 #include "core/NetworkCommandQueue.h"
 #include "core/NetworkPlane.h"
+#include "core/RetainedLog.h"
 #include "core/SafeRestart.h"
+#include "core/SensorAcquisition.h"
+#include "core/SensorSnapshot.h"
+#include "core/TaskProfiler.h"
 #include "core/WebRuntimeState.h"
 #include "core/Watchdog.h"
 
@@ -46,16 +51,18 @@ namespace {
 
 using namespace Config;
 
+// UI-side copy of the latest sample; the acquisition task works on its own copy.
 SensorData currentData;
+SensorSnapshot sensorSnapshot;
 StorageManager storage;
 PressureHistory pressureHistory;
 ChartsHistory chartsHistory;
 AuraNetworkManager networkManager;
 MqttManager mqttManager;
 ConnectivityRuntime connectivityRuntime;
-MqttRuntimeState mqttRuntimeState;
+MqttRuntimeState mqttRuntimeState(sensorSnapshot);
 ChartsRuntimeState chartsRuntimeState;
-WebRuntimeState webRuntimeState;
+WebRuntimeState webRuntimeState(sensorSnapshot);
 NetworkCommandQueue networkCommandQueue;
 WebUiBridge webUiBridge;
 SensorManager sensorManager;
@@ -89,7 +96,7 @@ UiContext ui_context{
     webUiBridge,
     networkCommandQueue,
     sensorManager,
-    chartsHistory,
+    chartsRuntimeState,
     timeManager,
     themeManager,
     backlightManager,
@@ -114,6 +121,18 @@ NetworkPlane::Context network_plane_context{
     networkCommandQueue,
     webUiBridge
 };
+SensorAcquisition::Context sensor_acquisition_context{
+    sensorManager,
+    storage,
+    pressureHistory,
+    chartsHistory,
+    chartsRuntimeState,
+    sensorSnapshot,
+    co2_asc_enabled
+};
+SensorSample ui_sensor_sample;
+uint32_t ui_sensor_generation = 0;
+uint32_t ui_sensor_seen_ms = 0;
 bool ota_window_active = false;
 bool ota_lvgl_quiesced = false;
 uint32_t ota_quiesce_due_ms = 0;
@@ -122,6 +141,7 @@ uint32_t ota_pause_requested_ms = 0;
 bool ota_pause_wait_warned = false;
 bool ota_resume_pending = false;
 bool network_plane_running = false;
+bool sensor_task_running = false;
 
 void quiesce_network_for_restart() {
     const wifi_mode_t wifi_mode = WiFi.getMode();
@@ -137,7 +157,10 @@ void quiesce_network_for_restart() {
 
 void setup()
 {
-    delay(3000);
+    {
+        BootProfiler::Scope stage("start_delay");
+        delay(3000);
+    }
     Serial.begin(115200);
     Logger::begin(Serial, static_cast<Logger::Level>(Config::LOG_LEVEL));
     Logger::setSerialOutputEnabled(Config::LOG_SERIAL_OUTPUT);
@@ -155,8 +178,6 @@ void setup()
     boot_start_ms = millis();
 
     StorageManager::BootAction boot_action = AppInit::handleBootState();
-    AppInit::recoverI2cBus(static_cast<gpio_num_t>(I2C_SDA_PIN),
-                           static_cast<gpio_num_t>(I2C_SCL_PIN));
 
     AppInit::Context init_ctx{
         storage,
@@ -177,6 +198,7 @@ void setup()
         pressureHistory,
         chartsHistory,
         uiController,
+        sensorSnapshot,
         currentData,
         night_mode,
         temp_units_c,
@@ -187,24 +209,37 @@ void setup()
         hum_offset
     };
 
-    AppInit::initManagersAndConfig(init_ctx, boot_action);
-    auto *board = AppInit::initBoardAndPeripherals(init_ctx);
-    AppInit::initLvglAndUi(init_ctx, board);
+    AppInit::initSystem(init_ctx, boot_action);
     memoryMonitor.logNow("boot");
 
+    BootProfiler &profiler = BootProfiler::instance();
+    const uint8_t tasks_stage = profiler.begin("tasks");
     Watchdog::setup(TASK_WDT_TIMEOUT_MS);
+    if (!Logger::startDrainTask()) {
+        LOGW("Log", "log drain task unavailable, formatting log lines inline");
+    }
     if (!safe_restart_init()) {
         LOGW("Restart", "Core0 restart task init failed; controlled restart requests will abort");
     }
+    if (!storage.startWriter()) {
+        LOGW("Storage", "storage writer unavailable, saving synchronously");
+    }
     webUiBridge.setDispatchMode(WebUiBridge::DispatchMode::DeferredReply);
     network_plane_running = NetworkPlane::start(network_plane_context);
     if (!network_plane_running) {
         LOGW("Main", "network task unavailable, falling back to main-loop networking");
     }
+    sensor_task_running = SensorAcquisition::start(sensor_acquisition_context);
+    if (!sensor_task_running) {
+        LOGW("Main", "sensor task unavailable, falling back to main-loop acquisition");
+    }
+    profiler.end(tasks_stage);
+    AppInit::finishBootTrace(storage);
 }
 
 void loop()
 {
+    RetainedLog::instance().noteLoop(micros());
     if (WebHandlersConsumeRestartRequest()) {
         LOGI("OTA", "restarting now (main loop)");
         WebHandlersBeginRestartShutdown();
@@ -291,12 +326,17 @@ void loop()
         return;
     }
 
-    SensorManager::PollResult sensor_poll =
-        sensorManager.poll(currentData, storage, pressureHistory, co2_asc_enabled);
+    if (!sensor_task_running) {
+        SensorAcquisition::pollOnce(sensor_acquisition_context);
+    }
+    // A sample is published only when readings or warmup changed.
+    SensorManager::PollResult sensor_poll;
+    if (sensorSnapshot.readIfNewer(ui_sensor_sample, ui_sensor_generation)) {
+        currentData = ui_sensor_sample.data;
+        sensor_poll.data_changed = true;
+        ui_sensor_seen_ms = millis();
+    }
     uiController.onSensorPoll(sensor_poll);
-    chartsHistory.update(currentData, storage);
-    chartsRuntimeState.update(chartsHistory);
-    webRuntimeState.update(currentData, sensorManager.isWarmupActive(), fanControl);
     if (!network_plane_running) {
         networkCommandQueue.processAll(networkManager, mqttManager, connectivityRuntime);
         networkManager.poll();
@@ -312,12 +352,10 @@ void loop()
                            safe_boot_stage);
     TimeManager::PollResult time_poll = timeManager.poll(now);
     uiController.onTimePoll(time_poll);
-    fanControl.poll(now, &currentData, sensorManager.isWarmupActive());
+    fanControl.poll(now, &sensorSnapshot);
     const FanControl::Snapshot fan_snapshot = fanControl.snapshot();
-    webRuntimeState.update(currentData, sensorManager.isWarmupActive(), fanControl);
-    mqttRuntimeState.update(currentData,
-                            fan_snapshot,
-                            sensorManager.isWarmupActive(),
+    webRuntimeState.update(fanControl);
+    mqttRuntimeState.update(fan_snapshot,
                             night_mode,
                             alert_blink_enabled,
                             backlightManager.isOn(),
@@ -327,7 +365,11 @@ void loop()
         connectivityRuntime.update(networkManager, mqttManager);
     }
     storage.poll(now);
+    AppInit::pollBootTrace(storage);
     memoryMonitor.poll(now);
+    TaskProfiler::instance().poll(now);
+    RetainedLog::instance().pollTelemetry(now, ESP.getFreeHeap(), ESP.getMinFreeHeap(),
+                                          now - ui_sensor_seen_ms);
     uiController.poll(now);
     Watchdog::kick();
     delay(10);
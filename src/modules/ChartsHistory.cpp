@@ -108,7 +108,7 @@ void ChartsHistory::saveIfDue(StorageManager &storage, uint32_t now_ms) {
     last_save_ms_ = now_ms;
     state_.magic = kChartsHistoryMagic;
     state_.version = kChartsHistoryVersion;
-    storage.saveBlobAtomic(StorageManager::kChartsPath, &state_, sizeof(state_));
+    storage.saveBlobAsync(StorageManager::kChartsPath, &state_, sizeof(state_));
 }
 
 ChartsHistory::Sample ChartsHistory::makeSample(const SensorData &data) const {
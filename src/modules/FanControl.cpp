@@ -11,6 +11,8 @@
 #include "config/AppConfig.h"
 #include "config/AppData.h"
 #include "core/Logger.h"
+#include "core/SensorPollRate.h"
+#include "core/SensorSnapshot.h"
 
 namespace {
 
@@ -69,6 +71,10 @@ void FanControl::publishSnapshot() {
     snapshot_.stop_at_ms = stop_at_ms_;
     snapshot_.auto_config = auto_config_;
     unlockSync();
+    // Auto demand tracks live readings, so hold the sensors at full rate while it drives the fan.
+    SensorPollRates::instance().setDemand(SensorPollRates::DEMAND_FAN_AUTO,
+                                          mode_ == Mode::Auto && available_ && auto_config_.enabled &&
+                                              !manual_override_active_ && !auto_resume_blocked_);
 }
 
 bool FanControl::isAvailable() const {
@@ -268,7 +274,7 @@ void FanControl::begin(bool auto_mode_preference, bool auto_armed_preference) {
     publishSnapshot();
 }
 
-void FanControl::poll(uint32_t now_ms, const SensorData *sensor_data, bool gas_warmup) {
+void FanControl::poll(uint32_t now_ms, const SensorSnapshot *sensors) {
     ensureSyncPrimitives();
 
     PendingCommands pending;
@@ -417,8 +423,8 @@ void FanControl::poll(uint32_t now_ms, const SensorData *sensor_data, bool gas_w
 
     if (mode_ == Mode::Auto && available_ && !manual_override_active_ && !auto_resume_blocked_) {
         uint8_t demand_percent = 0;
-        if (auto_config_.enabled && sensor_data != nullptr) {
-            demand_percent = evaluateAutoDemandPercent(*sensor_data, gas_warmup);
+        if (auto_config_.enabled && sensors != nullptr) {
+            demand_percent = autoDemandPercent(*sensors);
         }
         const uint16_t target_mv = percentToMillivolts(demand_percent);
 
@@ -616,6 +622,7 @@ void FanControl::applyRequestAutoStart() {
 void FanControl::applyAutoConfig(const DacAutoConfig &config) {
     auto_config_ = config;
     DacAutoConfigJson::sanitize(auto_config_);
+    auto_demand_stale_ = true;
 }
 
 FanControl::InitStatus FanControl::tryInitialize(uint32_t now_ms, const char *&failure_reason) {
@@ -715,6 +722,17 @@ uint16_t FanControl::percentToMillivolts(uint8_t percent) const {
     return static_cast<uint16_t>(mv / 100u);
 }
 
+uint8_t FanControl::autoDemandPercent(const SensorSnapshot &sensors) {
+    if (!auto_demand_stale_ && sensors.generation() == auto_sensor_generation_) {
+        return auto_demand_percent_;
+    }
+    SensorSample sample;
+    auto_sensor_generation_ = sensors.read(sample);
+    auto_demand_percent_ = evaluateAutoDemandPercent(sample.data, sample.gas_warmup);
+    auto_demand_stale_ = false;
+    return auto_demand_percent_;
+}
+
 uint8_t FanControl::evaluateAutoDemandPercent(const SensorData &data, bool gas_warmup) const {
     uint8_t demand = 0;
 
@@ -15,6 +15,7 @@
 #include "drivers/Gp8403.h"
 
 struct SensorData;
+class SensorSnapshot;
 
 class FanControl {
 public:
@@ -29,7 +30,7 @@ public:
     using Snapshot = FanStateSnapshot;
 
     void begin(bool auto_mode_preference, bool auto_armed_preference);
-    void poll(uint32_t now_ms, const SensorData *sensor_data, bool gas_warmup);
+    void poll(uint32_t now_ms, const SensorSnapshot *sensors);
 
     void setMode(Mode mode);
     void setManualStep(uint8_t step);
@@ -91,6 +92,7 @@ private:
     void applyStopState(bool output_known);
     uint16_t stepToMillivolts(uint8_t step) const;
     uint16_t percentToMillivolts(uint8_t percent) const;
+    uint8_t autoDemandPercent(const SensorSnapshot &sensors);
     uint8_t evaluateAutoDemandPercent(const SensorData &data, bool gas_warmup) const;
     static uint8_t maxPercent(uint8_t a, uint8_t b) { return (a > b) ? a : b; }
 
@@ -118,6 +120,10 @@ private:
     bool auto_resume_blocked_ = false;
     bool boot_auto_resume_pending_ = false;
     uint32_t boot_auto_resume_due_ms_ = 0;
+    // Auto demand is re-evaluated only for a new sensor sample or a config change.
+    uint32_t auto_sensor_generation_ = 0;
+    uint8_t auto_demand_percent_ = 0;
+    bool auto_demand_stale_ = true;
 
     mutable SemaphoreHandle_t sync_mutex_ = nullptr;
     PendingCommands pending_commands_{};
@@ -6,15 +6,17 @@
 
 #include "modules/MqttManager.h"
 
-#include <ctype.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ESPmDNS.h>
 #include <WiFi.h>
-#include <esp_event.h>
 #include "core/Logger.h"
+#include "core/MqttCommandParser.h"
+#include "core/MqttConnectionPolicy.h"
 #include "core/MqttEventQueue.h"
+#include "core/MqttPublishScheduler.h"
+#include "core/SensorTiming.h"
 #include "core/SystemEventPolicy.h"
 #include "core/WifiPowerSaveGuard.h"
 #include "modules/MqttPayloadBuilder.h"
@@ -29,25 +31,7 @@ MqttManager *g_mqtt = nullptr;
 constexpr size_t kTopicBufferSize = 256;
 constexpr uint32_t kMqttMdnsSuccessCacheMs = 5UL * 60UL * 1000UL;
 constexpr uint32_t kMqttMdnsFailureCacheMs = 60UL * 1000UL;
-constexpr int kMqttConnectTimeoutShortMs = 3000;
-constexpr int kMqttConnectTimeoutSlowMs = 3000;
 constexpr uint16_t kMqttKeepaliveSeconds = 120;
-constexpr uint8_t kMqttLongRetryLogEveryAttempts = 6;
-constexpr size_t kMaxQueuedEventPublishesPerPoll = 4;
-constexpr const char *kFanTimerOptions[] = {
-    "Off",
-    "10 min",
-    "30 min",
-    "1 h",
-    "2 h",
-    "4 h",
-    "8 h",
-};
-constexpr const char *kFanModeOptions[] = {
-    "Auto",
-    "Stopped",
-    "Manual",
-};
 
 void append_json_escaped(String &out, const char *value) {
     if (!value) {
@@ -91,60 +75,6 @@ const char *retry_delay_label(uint32_t delay_ms) {
     return "10 minutes";
 }
 
-bool should_log_connect_failure(uint32_t failed_attempts) {
-    const uint8_t stage = MqttManager::retryStageForAttempts(failed_attempts);
-    if (stage < 2) {
-        return true;
-    }
-    const uint32_t long_stage_attempt =
-        failed_attempts -
-        (static_cast<uint32_t>(Config::MQTT_RETRY_SHORT_ATTEMPTS) +
-         static_cast<uint32_t>(Config::MQTT_RETRY_MEDIUM_ATTEMPTS));
-    return long_stage_attempt <= 1 ||
-           (long_stage_attempt % kMqttLongRetryLogEveryAttempts) == 0;
-}
-
-int connect_timeout_ms_for_attempts(uint32_t failed_attempts) {
-    return MqttManager::retryStageForAttempts(failed_attempts) >= 1
-               ? kMqttConnectTimeoutSlowMs
-               : kMqttConnectTimeoutShortMs;
-}
-
-void append_buffer_to_string(String &out, const char *data, size_t length) {
-    if (!data || length == 0) {
-        return;
-    }
-    for (size_t i = 0; i < length; ++i) {
-        out += data[i];
-    }
-}
-
-void build_state_topic(char *out, size_t out_size, const String &base) {
-    snprintf(out, out_size, "%s/state", base.c_str());
-}
-
-void build_events_topic(char *out, size_t out_size, const String &base) {
-    snprintf(out, out_size, "%s/events", base.c_str());
-}
-
-void build_availability_topic(char *out, size_t out_size, const String &base) {
-    snprintf(out, out_size, "%s/status", base.c_str());
-}
-
-void build_night_mode_availability_topic(char *out, size_t out_size, const String &base) {
-    snprintf(out, out_size, "%s/availability/night_mode", base.c_str());
-}
-
-void build_command_topic(char *out, size_t out_size, const String &base, const char *command) {
-    snprintf(out, out_size, "%s/command/%s", base.c_str(), command);
-}
-
-void build_discovery_topic(char *out, size_t out_size, const char *component,
-                           const String &device_id, const char *object_id) {
-    snprintf(out, out_size, "homeassistant/%s/%s_%s/config",
-             component, device_id.c_str(), object_id);
-}
-
 void append_discovery_object_id(String &payload,
                                 const String &base_topic,
                                 const char *object_id) {
@@ -155,124 +85,20 @@ void append_discovery_object_id(String &payload,
     payload += "\"";
 }
 
-bool parse_uint8_in_range(const char *text, uint8_t min_value, uint8_t max_value, uint8_t &out) {
-    if (!text || text[0] == '\0') {
-        return false;
-    }
-    char *end = nullptr;
-    const long parsed = strtol(text, &end, 10);
-    if (end == text || *end != '\0') {
-        return false;
-    }
-    if (parsed < static_cast<long>(min_value) || parsed > static_cast<long>(max_value)) {
-        return false;
-    }
-    out = static_cast<uint8_t>(parsed);
-    return true;
-}
-
-bool equals_ignore_case(const char *a, const char *b) {
-    if (!a || !b) {
-        return false;
-    }
-    while (*a && *b) {
-        if (tolower(static_cast<unsigned char>(*a)) != tolower(static_cast<unsigned char>(*b))) {
-            return false;
-        }
-        ++a;
-        ++b;
-    }
-    return (*a == '\0' && *b == '\0');
-}
-
-bool parse_fan_timer_seconds(const char *text, uint32_t &out_seconds) {
-    if (!text || text[0] == '\0') {
-        return false;
-    }
-    for (size_t i = 0; i < sizeof(kFanTimerOptions) / sizeof(kFanTimerOptions[0]); ++i) {
-        if (equals_ignore_case(text, kFanTimerOptions[i])) {
-            out_seconds = (i == 0) ? Config::DAC_TIMER_NONE_S : Config::DAC_TIMER_PRESETS_S[i - 1];
-            return true;
-        }
-    }
-    return false;
-}
-
-bool parse_fan_mode_option(const char *text, FanHaMode &out_mode) {
-    if (!text || text[0] == '\0') {
-        return false;
-    }
-    if (equals_ignore_case(text, kFanModeOptions[0])) {
-        out_mode = FanHaMode::Auto;
-        return true;
-    }
-    if (equals_ignore_case(text, kFanModeOptions[1])) {
-        out_mode = FanHaMode::Stopped;
-        return true;
-    }
-    if (equals_ignore_case(text, kFanModeOptions[2])) {
-        out_mode = FanHaMode::Manual;
-        return true;
-    }
-    return false;
-}
-
-bool payload_is_exact(const char *payload, const char *expected) {
-    return payload && expected && strcmp(payload, expected) == 0;
-}
-
-void trim_ascii(char *text) {
-    if (!text) {
-        return;
-    }
-    char *start = text;
-    while (*start && isspace(static_cast<unsigned char>(*start))) {
-        ++start;
-    }
-    char *end = start + strlen(start);
-    while (end > start && isspace(static_cast<unsigned char>(*(end - 1)))) {
-        --end;
-    }
-    size_t len = static_cast<size_t>(end - start);
-    if (start != text) {
-        memmove(text, start, len);
-    }
-    text[len] = '\0';
-}
-
 } // namespace
 
-MqttManager::MqttManager() {
+MqttManager::MqttManager() : transport_(createDefaultMqttTransport()) {
+    publish_scheduler_.configure(Config::MQTT_PUBLISH_BUCKET_CAPACITY,
+                                 Config::MQTT_PUBLISH_TOKEN_REFILL_MS);
     command_context_mutex_ = xSemaphoreCreateMutexStatic(&command_context_mutex_buffer_);
 }
 
-uint8_t MqttManager::retryStageForAttempts(uint32_t failed_attempts) {
-    if (failed_attempts <= Config::MQTT_RETRY_SHORT_ATTEMPTS) {
-        return 0;
-    }
-    const uint32_t medium_limit =
-        static_cast<uint32_t>(Config::MQTT_RETRY_SHORT_ATTEMPTS) +
-        static_cast<uint32_t>(Config::MQTT_RETRY_MEDIUM_ATTEMPTS);
-    if (failed_attempts <= medium_limit) {
-        return 1;
-    }
-    return 2;
-}
-
-uint32_t MqttManager::retryDelayMsForAttempts(uint32_t failed_attempts) {
-    switch (retryStageForAttempts(failed_attempts)) {
-        case 0: return Config::MQTT_RETRY_MS;
-        case 1: return Config::MQTT_RETRY_MEDIUM_MS;
-        default: return Config::MQTT_RETRY_LONG_MS;
-    }
-}
-
 uint8_t MqttManager::retryStage() const {
-    return retryStageForAttempts(mqtt_connect_attempts_);
+    return MqttConnectionPolicy::retryStageForAttempts(mqtt_connect_attempts_);
 }
 
 uint32_t MqttManager::retryDelayMs() const {
-    return retryDelayMsForAttempts(mqtt_connect_attempts_);
+    return MqttConnectionPolicy::retryDelayMsForAttempts(mqtt_connect_attempts_);
 }
 
 void MqttManager::begin(StorageManager &storage,
@@ -353,13 +179,13 @@ void MqttManager::stopClient() {
     mqtt_connecting_ = false;
     mqtt_connected_ = false;
 
-    if (!client_) {
+    if (!transport_->isActive()) {
         mqtt_client_started_ = false;
         return;
     }
 
     if (mqtt_client_started_) {
-        esp_mqtt_client_disconnect(client_);
+        transport_->disconnect();
         return;
     }
     mqtt_client_needs_destroy_ = true;
@@ -368,58 +194,33 @@ void MqttManager::stopClient() {
 void MqttManager::destroyClient() {
     mqtt_connection_signal_.store(static_cast<uint8_t>(ConnectionSignal::None),
                                   std::memory_order_release);
-    mqtt_active_client_.store(nullptr, std::memory_order_release);
-    if (client_) {
-        esp_mqtt_client_destroy(client_);
-        client_ = nullptr;
-    }
+    transport_->destroy();
     mqtt_client_started_ = false;
     mqtt_client_needs_destroy_ = false;
     mqtt_connecting_ = false;
     mqtt_connected_ = false;
     mqtt_manual_stop_ = false;
-    mqtt_event_topic_.clear();
-    mqtt_event_payload_.clear();
 }
 
 bool MqttManager::connectTransport(const char *client_id, const char *will_topic) {
     destroyClient();
 
-    esp_mqtt_client_config_t config = {};
-    config.broker.address.hostname = mqtt_broker_endpoint_buf_;
-    config.broker.address.port = mqtt_port_;
-    config.broker.address.transport = MQTT_TRANSPORT_OVER_TCP;
-    config.credentials.client_id = client_id;
+    MqttTransportConfig config;
+    config.host = mqtt_broker_endpoint_buf_;
+    config.port = mqtt_port_;
+    config.client_id = client_id;
     if (!mqtt_anonymous_ && mqtt_user_.length()) {
-        config.credentials.username = mqtt_user_.c_str();
-        config.credentials.authentication.password = mqtt_pass_.c_str();
-    }
-    config.session.last_will.topic = will_topic;
-    config.session.last_will.msg = Config::MQTT_AVAIL_OFFLINE;
-    config.session.last_will.msg_len = static_cast<int>(strlen(Config::MQTT_AVAIL_OFFLINE));
-    config.session.last_will.qos = 0;
-    config.session.last_will.retain = 1;
-    config.session.keepalive = kMqttKeepaliveSeconds;
-    config.network.timeout_ms = connect_timeout_ms_for_attempts(mqtt_connect_attempts_);
-    config.network.disable_auto_reconnect = true;
-    config.buffer.size = Config::MQTT_BUFFER_SIZE;
-    config.buffer.out_size = Config::MQTT_BUFFER_SIZE;
-
-    client_ = esp_mqtt_client_init(&config);
-    if (!client_) {
-        LOGW("MQTT", "esp_mqtt_client_init failed");
-        return false;
+        config.username = mqtt_user_.c_str();
+        config.password = mqtt_pass_.c_str();
     }
-    if (esp_mqtt_client_register_event(client_, MQTT_EVENT_ANY,
-                                       &MqttManager::staticEventHandler, this) != ESP_OK) {
-        LOGW("MQTT", "esp_mqtt_client_register_event failed");
-        destroyClient();
-        return false;
-    }
-    mqtt_active_client_.store(client_, std::memory_order_release);
-    if (esp_mqtt_client_start(client_) != ESP_OK) {
-        mqtt_active_client_.store(nullptr, std::memory_order_release);
-        LOGW("MQTT", "esp_mqtt_client_start failed");
+    config.will_topic = will_topic;
+    config.will_payload = Config::MQTT_AVAIL_OFFLINE;
+    config.will_retain = true;
+    config.keepalive_s = kMqttKeepaliveSeconds;
+    config.timeout_ms = MqttConnectionPolicy::connectTimeoutMsForAttempts(mqtt_connect_attempts_);
+    config.buffer_size = Config::MQTT_BUFFER_SIZE;
+
+    if (!transport_->start(config, &MqttManager::staticTransportEventHandler, this)) {
         destroyClient();
         return false;
     }
@@ -432,34 +233,22 @@ bool MqttManager::connectTransport(const char *client_id, const char *will_topic
 }
 
 bool MqttManager::publishMessage(const char *topic, const char *payload, bool retain) {
-    if (!client_ || !mqtt_connected_) {
-        return false;
-    }
-    return esp_mqtt_client_publish(client_,
-                                   topic,
-                                   payload ? payload : "",
-                                   0,
-                                   0,
-                                   retain ? 1 : 0) >= 0;
+    const char *body = payload ? payload : "";
+    return publishMessage(topic, reinterpret_cast<const uint8_t *>(body), strlen(body), retain);
 }
 
 bool MqttManager::publishMessage(const char *topic, const uint8_t *payload, size_t length, bool retain) {
-    if (!client_ || !mqtt_connected_) {
+    if (!transport_->isActive() || !mqtt_connected_) {
         return false;
     }
-    return esp_mqtt_client_publish(client_,
-                                   topic,
-                                   reinterpret_cast<const char *>(payload),
-                                   static_cast<int>(length),
-                                   0,
-                                   retain ? 1 : 0) >= 0;
+    return transport_->publish(topic, payload, length, retain);
 }
 
 bool MqttManager::subscribeTopic(const char *topic) {
-    if (!client_ || !mqtt_connected_) {
+    if (!transport_->isActive() || !mqtt_connected_) {
         return false;
     }
-    return esp_mqtt_client_subscribe(client_, topic, 0) >= 0;
+    return transport_->subscribe(topic);
 }
 
 bool MqttManager::prepareBrokerEndpoint(BrokerEndpoint &endpoint) {
@@ -530,6 +319,9 @@ void MqttManager::publishDiscoverySensor(const char *object_id, const char *name
     if (!mqtt_connected_) {
         return;
     }
+    if (!takeDiscoverySlot()) {
+        return;
+    }
     const String entity_object_id =
         MqttPayloadBuilder::buildDiscoveryEntityObjectId(mqtt_base_topic_, object_id);
     String payload = MqttPayloadBuilder::buildDiscoverySensorPayload(
@@ -546,7 +338,8 @@ void MqttManager::publishDiscoverySensor(const char *object_id, const char *name
         icon);
 
     char topic[kTopicBufferSize];
-    build_discovery_topic(topic, sizeof(topic), "sensor", mqtt_device_id_, object_id);
+    MqttPayloadBuilder::buildDiscoveryTopic(topic, sizeof(topic),
+                                            "sensor", mqtt_device_id_, object_id);
     publishMessage(topic, payload.c_str(), true);
 }
 
@@ -558,6 +351,9 @@ void MqttManager::publishDiscoveryBinarySensor(const char *object_id,
     if (!mqtt_connected_) {
         return;
     }
+    if (!takeDiscoverySlot()) {
+        return;
+    }
     String payload;
     payload.reserve(520);
     payload = "{";
@@ -569,10 +365,10 @@ void MqttManager::publishDiscoveryBinarySensor(const char *object_id,
     append_json_escaped(payload, object_id);
     payload += "\",\"state_topic\":\"";
     char topic[kTopicBufferSize];
-    build_state_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildStateTopic(topic, sizeof(topic), mqtt_base_topic_);
     append_json_escaped(payload, topic);
     payload += "\",\"availability_topic\":\"";
-    build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
     append_json_escaped(payload, topic);
     payload += "\",\"payload_available\":\"";
     payload += Config::MQTT_AVAIL_ONLINE;
@@ -602,7 +398,8 @@ void MqttManager::publishDiscoveryBinarySensor(const char *object_id,
     payload += "\",\"manufacturer\":\"21CNCStudio\",\"model\":\"Project Aura\"}";
     payload += "}";
 
-    build_discovery_topic(topic, sizeof(topic), "binary_sensor", mqtt_device_id_, object_id);
+    MqttPayloadBuilder::buildDiscoveryTopic(topic, sizeof(topic),
+                                            "binary_sensor", mqtt_device_id_, object_id);
     publishMessage(topic, payload.c_str(), true);
 }
 
@@ -611,6 +408,9 @@ void MqttManager::publishDiscoverySwitch(const char *object_id, const char *name
     if (!mqtt_connected_) {
         return;
     }
+    if (!takeDiscoverySlot()) {
+        return;
+    }
     String payload;
     payload.reserve(640); // Switch payload includes availability array; keep headroom.
     payload = "{";
@@ -622,21 +422,21 @@ void MqttManager::publishDiscoverySwitch(const char *object_id, const char *name
     append_json_escaped(payload, object_id);
     payload += "\",\"state_topic\":\"";
     char topic[kTopicBufferSize];
-    build_state_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildStateTopic(topic, sizeof(topic), mqtt_base_topic_);
     append_json_escaped(payload, topic);
     payload += "\",\"command_topic\":\"";
-    build_command_topic(topic, sizeof(topic), mqtt_base_topic_, object_id);
+    MqttPayloadBuilder::buildCommandTopic(topic, sizeof(topic), mqtt_base_topic_, object_id);
     append_json_escaped(payload, topic);
     if (strcmp(object_id, "night_mode") == 0) {
         payload += "\",\"availability\":[{\"topic\":\"";
-        build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+        MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
         append_json_escaped(payload, topic);
         payload += "\",\"payload_available\":\"";
         payload += Config::MQTT_AVAIL_ONLINE;
         payload += "\",\"payload_not_available\":\"";
         payload += Config::MQTT_AVAIL_OFFLINE;
         payload += "\"},{\"topic\":\"";
-        build_night_mode_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+        MqttPayloadBuilder::buildNightModeAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
         append_json_escaped(payload, topic);
         payload += "\",\"payload_available\":\"";
         payload += Config::MQTT_AVAIL_ONLINE;
@@ -646,7 +446,7 @@ void MqttManager::publishDiscoverySwitch(const char *object_id, const char *name
         payload += ",\"availability_mode\":\"all\"";
     } else {
         payload += "\",\"availability_topic\":\"";
-        build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+        MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
         append_json_escaped(payload, topic);
         payload += "\",\"payload_available\":\"";
         payload += Config::MQTT_AVAIL_ONLINE;
@@ -674,7 +474,8 @@ void MqttManager::publishDiscoverySwitch(const char *object_id, const char *name
     payload += "\",\"manufacturer\":\"21CNCStudio\",\"model\":\"Project Aura\"}";
     payload += "}";
 
-    build_discovery_topic(topic, sizeof(topic), "switch", mqtt_device_id_, object_id);
+    MqttPayloadBuilder::buildDiscoveryTopic(topic, sizeof(topic),
+                                            "switch", mqtt_device_id_, object_id);
     publishMessage(topic, payload.c_str(), true);
 }
 
@@ -686,6 +487,9 @@ void MqttManager::publishDiscoverySelect(const char *object_id, const char *name
     if (!mqtt_connected_) {
         return;
     }
+    if (!takeDiscoverySlot()) {
+        return;
+    }
     String payload;
     payload.reserve(720);
     payload = "{";
@@ -697,13 +501,13 @@ void MqttManager::publishDiscoverySelect(const char *object_id, const char *name
     append_json_escaped(payload, object_id);
     payload += "\",\"state_topic\":\"";
     char topic[kTopicBufferSize];
-    build_state_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildStateTopic(topic, sizeof(topic), mqtt_base_topic_);
     append_json_escaped(payload, topic);
     payload += "\",\"command_topic\":\"";
-    build_command_topic(topic, sizeof(topic), mqtt_base_topic_, object_id);
+    MqttPayloadBuilder::buildCommandTopic(topic, sizeof(topic), mqtt_base_topic_, object_id);
     append_json_escaped(payload, topic);
     payload += "\",\"availability_topic\":\"";
-    build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
     append_json_escaped(payload, topic);
     payload += "\",\"payload_available\":\"";
     payload += Config::MQTT_AVAIL_ONLINE;
@@ -738,7 +542,8 @@ void MqttManager::publishDiscoverySelect(const char *object_id, const char *name
     payload += "\",\"manufacturer\":\"21CNCStudio\",\"model\":\"Project Aura\"}";
     payload += "}";
 
-    build_discovery_topic(topic, sizeof(topic), "select", mqtt_device_id_, object_id);
+    MqttPayloadBuilder::buildDiscoveryTopic(topic, sizeof(topic),
+                                            "select", mqtt_device_id_, object_id);
     publishMessage(topic, payload.c_str(), true);
 }
 
@@ -749,6 +554,9 @@ void MqttManager::publishDiscoveryNumber(const char *object_id, const char *name
     if (!mqtt_connected_) {
         return;
     }
+    if (!takeDiscoverySlot()) {
+        return;
+    }
     String payload;
     payload.reserve(720);
     payload = "{";
@@ -760,13 +568,13 @@ void MqttManager::publishDiscoveryNumber(const char *object_id, const char *name
     append_json_escaped(payload, object_id);
     payload += "\",\"state_topic\":\"";
     char topic[kTopicBufferSize];
-    build_state_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildStateTopic(topic, sizeof(topic), mqtt_base_topic_);
     append_json_escaped(payload, topic);
     payload += "\",\"command_topic\":\"";
-    build_command_topic(topic, sizeof(topic), mqtt_base_topic_, object_id);
+    MqttPayloadBuilder::buildCommandTopic(topic, sizeof(topic), mqtt_base_topic_, object_id);
     append_json_escaped(payload, topic);
     payload += "\",\"availability_topic\":\"";
-    build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
     append_json_escaped(payload, topic);
     payload += "\",\"payload_available\":\"";
     payload += Config::MQTT_AVAIL_ONLINE;
@@ -802,7 +610,8 @@ void MqttManager::publishDiscoveryNumber(const char *object_id, const char *name
     payload += "\",\"manufacturer\":\"21CNCStudio\",\"model\":\"Project Aura\"}";
     payload += "}";
 
-    build_discovery_topic(topic, sizeof(topic), "number", mqtt_device_id_, object_id);
+    MqttPayloadBuilder::buildDiscoveryTopic(topic, sizeof(topic),
+                                            "number", mqtt_device_id_, object_id);
     publishMessage(topic, payload.c_str(), true);
 }
 
@@ -811,6 +620,9 @@ void MqttManager::publishDiscoveryButton(const char *object_id, const char *name
     if (!mqtt_connected_) {
         return;
     }
+    if (!takeDiscoverySlot()) {
+        return;
+    }
     String payload;
     payload.reserve(420); // Button payload is smaller but still avoid reallocs.
     payload = "{";
@@ -822,12 +634,12 @@ void MqttManager::publishDiscoveryButton(const char *object_id, const char *name
     append_json_escaped(payload, object_id);
     payload += "\",\"command_topic\":\"";
     char topic[kTopicBufferSize];
-    build_command_topic(topic, sizeof(topic), mqtt_base_topic_, object_id);
+    MqttPayloadBuilder::buildCommandTopic(topic, sizeof(topic), mqtt_base_topic_, object_id);
     append_json_escaped(payload, topic);
     payload += "\",\"payload_press\":\"";
     append_json_escaped(payload, payload_press);
     payload += "\",\"availability_topic\":\"";
-    build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
     append_json_escaped(payload, topic);
     payload += "\"";
     append_discovery_object_id(payload, mqtt_base_topic_, object_id);
@@ -843,7 +655,8 @@ void MqttManager::publishDiscoveryButton(const char *object_id, const char *name
     payload += "\",\"manufacturer\":\"21CNCStudio\",\"model\":\"Project Aura\"}";
     payload += "}";
 
-    build_discovery_topic(topic, sizeof(topic), "button", mqtt_device_id_, object_id);
+    MqttPayloadBuilder::buildDiscoveryTopic(topic, sizeof(topic),
+                                            "button", mqtt_device_id_, object_id);
     publishMessage(topic, payload.c_str(), true);
 }
 
@@ -851,6 +664,9 @@ void MqttManager::publishDiscoveryEventSensor() {
     if (!mqtt_connected_) {
         return;
     }
+    if (!takeDiscoverySlot()) {
+        return;
+    }
 
     String payload;
     payload.reserve(640);
@@ -861,7 +677,7 @@ void MqttManager::publishDiscoveryEventSensor() {
     payload += "_events\"";
 
     char topic[kTopicBufferSize];
-    build_events_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildEventsTopic(topic, sizeof(topic), mqtt_base_topic_);
     payload += ",\"state_topic\":\"";
     append_json_escaped(payload, topic);
     payload += "\",\"json_attributes_topic\":\"";
@@ -869,7 +685,7 @@ void MqttManager::publishDiscoveryEventSensor() {
     payload += "\",\"value_template\":\"{{ value_json.message }}\"";
     payload += ",\"force_update\":true";
     payload += ",\"availability_topic\":\"";
-    build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
     append_json_escaped(payload, topic);
     payload += "\",\"payload_available\":\"";
     payload += Config::MQTT_AVAIL_ONLINE;
@@ -884,30 +700,49 @@ void MqttManager::publishDiscoveryEventSensor() {
     payload += "\",\"manufacturer\":\"21CNCStudio\",\"model\":\"Project Aura\"}";
     payload += "}";
 
-    build_discovery_topic(topic, sizeof(topic), "sensor", mqtt_device_id_, "events");
+    MqttPayloadBuilder::buildDiscoveryTopic(topic, sizeof(topic),
+                                            "sensor", mqtt_device_id_, "events");
     publishMessage(topic, payload.c_str(), true);
 }
 
-void MqttManager::publishDiscovery(const MqttRuntimeSnapshot &runtime) {
-    if (!mqtt_discovery_ || mqtt_discovery_sent_ || !mqtt_connected_) {
-        return;
+bool MqttManager::takeDiscoverySlot() {
+    const uint16_t index = discovery_slot_index_++;
+    if (index < discovery_cursor_ || discovery_slot_sent_ >= discovery_slot_budget_) {
+        return false;
+    }
+    discovery_slot_sent_++;
+    return true;
+}
+
+uint16_t MqttManager::publishDiscovery(const MqttRuntimeSnapshot &runtime, uint16_t budget) {
+    if (!mqtt_discovery_ || mqtt_discovery_sent_ || !mqtt_connected_ || budget == 0) {
+        return 0;
     }
+    // Discovery goes out in slices sized by the publish budget: every call walks the same
+    // entity list, skips what earlier slices sent and stops when the budget is spent.
+    if (discovery_cursor_ > 0 && runtime.fan.present != discovery_fan_present_) {
+        discovery_cursor_ = 0;
+    }
+    discovery_fan_present_ = runtime.fan.present;
+    discovery_slot_index_ = 0;
+    discovery_slot_budget_ = budget;
+    discovery_slot_sent_ = 0;
+
     const auto clear_discovery = [&](const char *component, const char *object_id) {
+        if (!takeDiscoverySlot()) {
+            return;
+        }
         char topic[kTopicBufferSize];
-        build_discovery_topic(topic, sizeof(topic), component, mqtt_device_id_, object_id);
+        MqttPayloadBuilder::buildDiscoveryTopic(topic, sizeof(topic),
+                                                component, mqtt_device_id_, object_id);
         publishMessage(topic, "", true);
     };
     // Remove legacy PM4 discovery entity variant (retained) from older firmware versions.
-    char legacy_topic[kTopicBufferSize];
-    build_discovery_topic(legacy_topic, sizeof(legacy_topic), "sensor", mqtt_device_id_, "pm4_0");
-    publishMessage(legacy_topic, "", true);
+    clear_discovery("sensor", "pm4_0");
     // Remove retained config from earlier event entity experiments.
-    build_discovery_topic(legacy_topic, sizeof(legacy_topic), "event", mqtt_device_id_, "events");
-    publishMessage(legacy_topic, "", true);
-    build_discovery_topic(legacy_topic, sizeof(legacy_topic), "event", mqtt_device_id_, "air_events");
-    publishMessage(legacy_topic, "", true);
-    build_discovery_topic(legacy_topic, sizeof(legacy_topic), "sensor", mqtt_device_id_, "air_events");
-    publishMessage(legacy_topic, "", true);
+    clear_discovery("event", "events");
+    clear_discovery("event", "air_events");
+    clear_discovery("sensor", "air_events");
 
     publishDiscoverySensor("temperature", "Temperature", "\\u00b0C",
                            "temperature", "measurement", "{{ value_json.temp }}", "");
@@ -985,16 +820,16 @@ void MqttManager::publishDiscovery(const MqttRuntimeSnapshot &runtime) {
                                "mdi:stop-circle-outline");
         publishDiscoverySelect("fan_mode", "Ventilation Mode",
                                "{{ value_json.fan_control_mode }}",
-                               kFanModeOptions,
-                               sizeof(kFanModeOptions) / sizeof(kFanModeOptions[0]),
+                               MqttCommandParser::kFanModeOptions,
+                               MqttCommandParser::kFanModeOptionCount,
                                "mdi:fan-cog");
         publishDiscoveryNumber("fan_manual_percent", "Ventilation Speed",
                                "{{ value_json.fan_manual_percent }}",
                                10, 100, 10, "slider", "mdi:fan");
         publishDiscoverySelect("fan_timer", "Ventilation Timer",
                                "{{ value_json.fan_timer }}",
-                               kFanTimerOptions,
-                               sizeof(kFanTimerOptions) / sizeof(kFanTimerOptions[0]),
+                               MqttCommandParser::kFanTimerOptions,
+                               MqttCommandParser::kFanTimerOptionCount,
                                "mdi:timer-outline");
         publishDiscoverySensor("fan_timer_remaining", "Ventilation Timer Remaining", "",
                                "", "", "{{ value_json.fan_timer_remaining }}",
@@ -1027,8 +862,17 @@ void MqttManager::publishDiscovery(const MqttRuntimeSnapshot &runtime) {
     }
     publishDiscoveryButton("restart", "Restart", "PRESS", "mdi:restart");
     publishDiscoveryEventSensor();
-    mqtt_discovery_sent_ = true;
-    publishNightModeAvailability();
+
+    const uint16_t sent = discovery_slot_sent_;
+    discovery_total_ = discovery_slot_index_;
+    if (static_cast<uint32_t>(discovery_cursor_) + sent >= discovery_total_) {
+        discovery_cursor_ = 0;
+        mqtt_discovery_sent_ = true;
+        publishNightModeAvailability();
+    } else {
+        discovery_cursor_ = static_cast<uint16_t>(discovery_cursor_ + sent);
+    }
+    return sent;
 }
 
 void MqttManager::publishNightModeAvailability() {
@@ -1036,14 +880,14 @@ void MqttManager::publishNightModeAvailability() {
         return;
     }
     char topic[kTopicBufferSize];
-    build_night_mode_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildNightModeAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
     const char *payload = auto_night_enabled_ ? Config::MQTT_AVAIL_OFFLINE : Config::MQTT_AVAIL_ONLINE;
     publishMessage(topic, payload, true);
 }
 
-void MqttManager::publishState(const MqttRuntimeSnapshot &runtime) {
+uint16_t MqttManager::publishState(const MqttRuntimeSnapshot &runtime) {
     if (!mqtt_connected_) {
-        return;
+        return 0;
     }
     const bool pressure_altitude_set =
         storage_ ? storage_->config().pressure_altitude_set : false;
@@ -1061,19 +905,45 @@ void MqttManager::publishState(const MqttRuntimeSnapshot &runtime) {
         pressure_altitude_m);
     if (payload_len == 0) {
         Logger::log(Logger::Warn, "MQTT", "state payload build failed");
-        return;
+        return 0;
     }
 
     char topic[kTopicBufferSize];
-    build_state_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildStateTopic(topic, sizeof(topic), mqtt_base_topic_);
     bool published = publishMessage(topic,
                                     reinterpret_cast<const uint8_t *>(mqtt_state_payload_buf_),
                                     payload_len,
                                     true);
+    uint16_t messages = published ? 1 : 0;
+
+    if (published && storage_ &&
+        storage_->config().mqtt_state_encoding == Config::MqttStateEncoding::JsonCbor) {
+        const size_t cbor_len = MqttPayloadBuilder::buildStatePayloadCbor(
+            mqtt_state_cbor_buf_, sizeof(mqtt_state_cbor_buf_),
+            runtime.data,
+            runtime.fan,
+            runtime.gas_warmup,
+            runtime.night_mode,
+            runtime.alert_blink,
+            runtime.backlight_on,
+            pressure_altitude_set,
+            pressure_altitude_m);
+        if (cbor_len == 0) {
+            LOGW("MQTT", "CBOR state payload build failed");
+        } else {
+            MqttPayloadBuilder::buildStateCborTopic(topic, sizeof(topic), mqtt_base_topic_);
+            published = publishMessage(topic, mqtt_state_cbor_buf_, cbor_len, true);
+            if (published) {
+                messages++;
+            }
+        }
+    }
 
     if (published) {
         mqtt_fail_count_ = 0;
         mqtt_last_publish_ms_ = millis();
+        SensorTiming::instance().noteDelivered(SensorTiming::STAGE_MQTT, runtime.data,
+                                               SensorTiming::nowUs());
     } else {
         mqtt_fail_count_++;
         Logger::log(Logger::Warn, "MQTT", "publish failed (%u/%u)",
@@ -1085,48 +955,152 @@ void MqttManager::publishState(const MqttRuntimeSnapshot &runtime) {
             mqtt_fail_count_ = 0;
         }
     }
+    return published ? messages : 0;
 }
 
-void MqttManager::publishQueuedEvents(size_t max_events) {
-    if (!mqtt_connected_ || max_events == 0) {
-        return;
+bool MqttManager::publishQueuedEvent(size_t index) {
+    if (!mqtt_connected_) {
+        return false;
     }
 
     char topic[kTopicBufferSize];
-    build_events_topic(topic, sizeof(topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildEventsTopic(topic, sizeof(topic), mqtt_base_topic_);
 
     MqttEventQueue::CapturePause capture_pause;
-    for (size_t i = 0; i < max_events; ++i) {
-        Logger::RecentEntry entry{};
-        if (!MqttEventQueue::instance().peek(entry)) {
-            break;
-        }
+    Logger::RecentEntry entry{};
+    if (!MqttEventQueue::instance().peekAt(index, entry)) {
+        return false;
+    }
 
-        String payload;
-        payload.reserve(320);
-        payload = "{";
-        payload += "\"ts_ms\":";
-        payload += String(entry.ms);
-        payload += ",\"level\":\"";
-        payload += SystemEventPolicy::levelText(entry.level);
-        payload += "\",\"severity\":\"";
-        payload += SystemEventPolicy::severityText(entry.level);
-        payload += "\",\"type\":\"";
-        append_json_escaped(payload, SystemEventPolicy::typeText(entry));
-        payload += "\",\"message\":\"";
-        append_json_escaped(payload, SystemEventPolicy::messageText(entry));
-        payload += "\"}";
-
-        if (!publishMessage(topic, payload.c_str(), false)) {
-            LOGW("MQTT", "event publish failed, reconnecting");
-            stopClient();
-            break;
+    String payload;
+    payload.reserve(320);
+    payload = "{";
+    payload += "\"ts_ms\":";
+    payload += String(entry.ms);
+    payload += ",\"level\":\"";
+    payload += SystemEventPolicy::levelText(entry.level);
+    payload += "\",\"severity\":\"";
+    payload += SystemEventPolicy::severityText(entry.level);
+    payload += "\",\"type\":\"";
+    append_json_escaped(payload, SystemEventPolicy::typeText(entry));
+    payload += "\",\"message\":\"";
+    append_json_escaped(payload, SystemEventPolicy::messageText(entry));
+    payload += "\"}";
+
+    if (!publishMessage(topic, payload.c_str(), false)) {
+        LOGW("MQTT", "event publish failed, reconnecting");
+        stopClient();
+        return false;
+    }
+    return MqttEventQueue::instance().discardAt(index);
+}
+
+size_t MqttManager::countBackfillEvents() const {
+    // Events captured before the current session sit at the front of the FIFO.
+    const MqttEventQueue &queue = MqttEventQueue::instance();
+    size_t count = 0;
+    Logger::RecentEntry entry{};
+    while (queue.peekAt(count, entry) &&
+           static_cast<int32_t>(mqtt_connected_since_ms_ - entry.ms) > 0) {
+        count++;
+    }
+    return count;
+}
+
+void MqttManager::runPublishScheduler(const MqttRuntimeSnapshot &runtime, uint32_t now) {
+    if (mqtt_publish_requested_) {
+        mqtt_publish_requested_ = false;
+        publish_scheduler_.requestLatest(MqttPublishClass::State, now);
+    } else if (publish_scheduler_.depth(MqttPublishClass::State) == 0 &&
+               MqttConnectionPolicy::statePublishDue(false, mqtt_last_publish_ms_, now)) {
+        publish_scheduler_.requestLatest(MqttPublishClass::State, now);
+    }
+
+    uint16_t discovery_depth = 0;
+    if (mqtt_discovery_ && !mqtt_discovery_sent_) {
+        discovery_depth = discovery_total_ > discovery_cursor_
+                              ? static_cast<uint16_t>(discovery_total_ - discovery_cursor_)
+                              : 1;
+    }
+    publish_scheduler_.setDepth(MqttPublishClass::Discovery, discovery_depth, now);
+
+    // Events logged since the last drain are still unformatted records; pull them in first.
+    Logger::drain();
+    const size_t queued_events = MqttEventQueue::instance().size();
+    const size_t backfill_events = countBackfillEvents();
+    publish_scheduler_.setDepth(MqttPublishClass::Backfill,
+                                static_cast<uint16_t>(backfill_events), now);
+    publish_scheduler_.setDepth(MqttPublishClass::Alert,
+                                static_cast<uint16_t>(queued_events - backfill_events), now);
+
+    // Web transfers only hold back discovery and backfill; alerts and state keep flowing.
+    const bool web_paused = WebHandlersShouldPauseMqttPublish();
+    MqttPublishClass next = MqttPublishClass::Count;
+    while (mqtt_connected_ && publish_scheduler_.next(now, web_paused, next)) {
+        switch (next) {
+            case MqttPublishClass::Alert: {
+                const size_t backfill = countBackfillEvents();
+                if (!publishQueuedEvent(backfill)) {
+                    publish_scheduler_.setDepth(MqttPublishClass::Alert, 0, now);
+                    break;
+                }
+                publish_scheduler_.markSent(next, now);
+                break;
+            }
+            case MqttPublishClass::State: {
+                const uint16_t messages = publishState(runtime);
+                if (messages == 0) {
+                    publish_scheduler_.setDepth(MqttPublishClass::State, 0, now);
+                    break;
+                }
+                publish_scheduler_.markSent(next, now, messages);
+                break;
+            }
+            case MqttPublishClass::Discovery: {
+                const uint16_t sent = publishDiscovery(runtime, publish_scheduler_.tokens());
+                if (sent == 0) {
+                    publish_scheduler_.setDepth(MqttPublishClass::Discovery, 0, now);
+                    break;
+                }
+                publish_scheduler_.markSent(next, now, sent);
+                publish_scheduler_.setDepth(
+                    MqttPublishClass::Discovery,
+                    mqtt_discovery_sent_ ? 0
+                                         : static_cast<uint16_t>(discovery_total_ - discovery_cursor_),
+                    now);
+                break;
+            }
+            case MqttPublishClass::Backfill:
+                if (!publishQueuedEvent(0)) {
+                    publish_scheduler_.setDepth(MqttPublishClass::Backfill, 0, now);
+                    break;
+                }
+                publish_scheduler_.markSent(next, now);
+                break;
+            default:
+                break;
         }
+    }
 
-        if (!MqttEventQueue::instance().discardFront()) {
-            break;
+    if (web_paused && publish_scheduler_.hasLowPriorityPending()) {
+        if (!mqtt_publish_deferred_by_web_) {
+            WebHandlersNoteMqttPublishDeferred();
+            mqtt_publish_deferred_by_web_ = true;
         }
+    } else {
+        mqtt_publish_deferred_by_web_ = false;
     }
+
+    lockCommandContext();
+    publish_stats_ = publish_scheduler_.stats();
+    unlockCommandContext();
+}
+
+MqttPublishStats MqttManager::publishStats() const {
+    lockCommandContext();
+    const MqttPublishStats stats = publish_stats_;
+    unlockCommandContext();
+    return stats;
 }
 
 bool MqttManager::connectClient() {
@@ -1143,8 +1117,8 @@ bool MqttManager::connectClient() {
         if (mqtt_connect_attempts_ < UINT32_MAX) {
             mqtt_connect_attempts_++;
         }
-        if (log_details && should_log_connect_failure(mqtt_connect_attempts_)) {
-            uint32_t delay_ms = retryDelayMsForAttempts(mqtt_connect_attempts_);
+        if (log_details && MqttConnectionPolicy::shouldLogConnectFailure(mqtt_connect_attempts_)) {
+            uint32_t delay_ms = MqttConnectionPolicy::retryDelayMsForAttempts(mqtt_connect_attempts_);
             Logger::log(Logger::Warn, "MQTT",
                         "connect failed rc=%d (attempt %lu), retry in %s",
                         rc,
@@ -1186,7 +1160,7 @@ bool MqttManager::connectClient() {
 
     const char *client_id = mqtt_device_id_.c_str();
     char will_topic[kTopicBufferSize];
-    build_availability_topic(will_topic, sizeof(will_topic), mqtt_base_topic_);
+    MqttPayloadBuilder::buildAvailabilityTopic(will_topic, sizeof(will_topic), mqtt_base_topic_);
     WifiPowerSaveGuard wifi_ps_guard;
     wifi_ps_guard.suspend();
     mqtt_connection_signal_.store(static_cast<uint8_t>(ConnectionSignal::None),
@@ -1202,28 +1176,6 @@ bool MqttManager::connectClient() {
     return true;
 }
 
-bool MqttManager::payloadIsOn(const char *payload) {
-    if (!payload) {
-        return false;
-    }
-    if (equals_ignore_case(payload, "ON") || strcmp(payload, "1") == 0 ||
-        equals_ignore_case(payload, "TRUE") || equals_ignore_case(payload, "PRESS")) {
-        return true;
-    }
-    return false;
-}
-
-bool MqttManager::payloadIsOff(const char *payload) {
-    if (!payload) {
-        return false;
-    }
-    if (equals_ignore_case(payload, "OFF") || strcmp(payload, "0") == 0 ||
-        equals_ignore_case(payload, "FALSE")) {
-        return true;
-    }
-    return false;
-}
-
 void MqttManager::handleIncomingMessage(const char *topic, const uint8_t *payload, size_t length) {
     String base_topic;
     bool auto_night_enabled = false;
@@ -1232,232 +1184,44 @@ void MqttManager::handleIncomingMessage(const char *topic, const uint8_t *payloa
     auto_night_enabled = auto_night_enabled_;
     unlockCommandContext();
 
-    String t(topic ? topic : "");
-    char msg[32];
-    size_t copy_len = length < (sizeof(msg) - 1) ? length : (sizeof(msg) - 1);
-    if (payload && copy_len > 0) {
-        memcpy(msg, payload, copy_len);
-    }
-    msg[copy_len] = '\0';
-    trim_ascii(msg);
-    if (!t.startsWith(base_topic)) {
-        return;
-    }
-    String suffix = t.substring(base_topic.length());
-    if (!suffix.startsWith("/command/")) {
-        return;
-    }
-    String cmd = suffix.substring(strlen("/command/"));
-    bool is_on = payloadIsOn(msg);
-    bool is_off = payloadIsOff(msg);
     MqttPendingCommands pending_update;
-    bool has_pending_update = false;
-
-    if (cmd == "night_mode") {
-        if (auto_night_enabled) {
-            LOGI("MQTT", "night mode ignored (auto night enabled)");
-            return;
-        }
-        if (is_on || is_off) {
-            pending_update.night_mode_value = is_on;
-            pending_update.night_mode = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "alert_blink") {
-        if (is_on || is_off) {
-            pending_update.alert_blink_value = is_on;
-            pending_update.alert_blink = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "backlight") {
-        if (is_on || is_off) {
-            pending_update.backlight_value = is_on;
-            pending_update.backlight = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "fan_mode") {
-        FanHaMode mode = FanHaMode::Stopped;
-        if (parse_fan_mode_option(msg, mode)) {
-            pending_update.fan_mode_value = mode;
-            pending_update.fan_mode = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "fan_auto") {
-        if (payload_is_exact(msg, "AUTO") || is_on) {
-            pending_update.fan_mode_value = FanHaMode::Auto;
-            pending_update.fan_mode = true;
-            has_pending_update = true;
-        } else if (is_off) {
-            pending_update.fan_mode_value = FanHaMode::Stopped;
-            pending_update.fan_mode = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "fan_manual") {
-        if (payload_is_exact(msg, "MANUAL") || is_on) {
-            pending_update.fan_mode_value = FanHaMode::Manual;
-            pending_update.fan_mode = true;
-            has_pending_update = true;
-        } else if (is_off) {
-            pending_update.fan_mode_value = FanHaMode::Stopped;
-            pending_update.fan_mode = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "fan_stop") {
-        if (payload_is_exact(msg, "STOP") || is_on || is_off) {
-            pending_update.fan_mode_value = FanHaMode::Stopped;
-            pending_update.fan_mode = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "fan_manual_percent") {
-        uint8_t percent = 0;
-        if (parse_uint8_in_range(msg, 10, 100, percent) && (percent % 10u) == 0u) {
-            pending_update.fan_manual_speed_value = static_cast<uint8_t>(percent / 10u);
-            pending_update.fan_manual_speed = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "fan_manual_speed") {
-        uint8_t speed = 0;
-        if (parse_uint8_in_range(msg, 1, 10, speed)) {
-            pending_update.fan_manual_speed_value = speed;
-            pending_update.fan_manual_speed = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "fan") {
-        if (is_on) {
-            pending_update.fan_mode_value = FanHaMode::Manual;
-            pending_update.fan_mode = true;
-            has_pending_update = true;
-        } else if (is_off) {
-            pending_update.fan_mode_value = FanHaMode::Stopped;
-            pending_update.fan_mode = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "fan_percentage") {
-        uint8_t speed = 0;
-        if (parse_uint8_in_range(msg, 0, 100, speed)) {
-            if (speed == 0) {
-                pending_update.fan_mode_value = FanHaMode::Stopped;
-                pending_update.fan_mode = true;
-            } else {
-                uint32_t manual_step = (static_cast<uint32_t>(speed) + 9u) / 10u;
-                if (manual_step < 1u) {
-                    manual_step = 1u;
-                } else if (manual_step > 10u) {
-                    manual_step = 10u;
-                }
-                pending_update.fan_manual_speed_value = static_cast<uint8_t>(manual_step);
-                pending_update.fan_manual_speed = true;
-            }
-            has_pending_update = true;
-        } else if (parse_uint8_in_range(msg, 0, 10, speed)) {
-            if (speed == 0) {
-                pending_update.fan_mode_value = FanHaMode::Stopped;
-                pending_update.fan_mode = true;
-            } else {
-                pending_update.fan_manual_speed_value = speed;
-                pending_update.fan_manual_speed = true;
-            }
-            has_pending_update = true;
-        }
-    } else if (cmd == "fan_timer") {
-        uint32_t timer_seconds = 0;
-        if (parse_fan_timer_seconds(msg, timer_seconds)) {
-            pending_update.fan_timer_seconds = timer_seconds;
-            pending_update.fan_timer = true;
-            has_pending_update = true;
-        }
-    } else if (cmd == "restart") {
-        if (is_on) {
-            pending_update.restart = true;
-            has_pending_update = true;
-        }
+    const MqttCommandParser::Result result = MqttCommandParser::parse(
+        topic, payload, length, base_topic.c_str(), auto_night_enabled, pending_update);
+    if (result == MqttCommandParser::Result::NightModeLocked) {
+        LOGI("MQTT", "night mode ignored (auto night enabled)");
+        return;
     }
-
-    if (has_pending_update && runtime_state_) {
+    if (result == MqttCommandParser::Result::Pending && runtime_state_) {
         runtime_state_->mergePendingCommands(pending_update);
     }
 }
 
-void MqttManager::handleEvent(esp_mqtt_event_handle_t event) {
-    if (!event) {
-        return;
-    }
-    const esp_mqtt_client_handle_t active_client =
-        mqtt_active_client_.load(std::memory_order_acquire);
-    if (!active_client || event->client != active_client) {
-        return;
-    }
-
-    switch (event->event_id) {
-        case MQTT_EVENT_CONNECTED: {
+void MqttManager::handleTransportEvent(const MqttTransportEvent &event) {
+    switch (event.type) {
+        case MqttTransportEventType::Connected:
             mqtt_connection_signal_.store(static_cast<uint8_t>(ConnectionSignal::Connected),
                                           std::memory_order_release);
             break;
-        }
-        case MQTT_EVENT_DISCONNECTED: {
+        case MqttTransportEventType::Disconnected:
             mqtt_connection_signal_.store(static_cast<uint8_t>(ConnectionSignal::Disconnected),
                                           std::memory_order_release);
             break;
-        }
-        case MQTT_EVENT_ERROR: {
-            int error_rc = -1;
-            if (event->error_handle) {
-                const esp_mqtt_error_codes_t *error = event->error_handle;
-                if (error->error_type == MQTT_ERROR_TYPE_CONNECTION_REFUSED) {
-                    error_rc = static_cast<int>(error->connect_return_code);
-                } else if (error->error_type == MQTT_ERROR_TYPE_TCP_TRANSPORT &&
-                           error->esp_transport_sock_errno != 0) {
-                    error_rc = -error->esp_transport_sock_errno;
-                }
-                mqtt_last_error_rc_.store(error_rc, std::memory_order_release);
-                Logger::log(Logger::Warn, "MQTT",
-                            "error event type=%d rc=%d tls=%d stack=%d sock=%d",
-                            static_cast<int>(error->error_type),
-                            error_rc,
-                            static_cast<int>(error->esp_tls_last_esp_err),
-                            static_cast<int>(error->esp_tls_stack_err),
-                            static_cast<int>(error->esp_transport_sock_errno));
-            } else {
-                mqtt_last_error_rc_.store(error_rc, std::memory_order_release);
-                LOGW("MQTT", "error event without details");
-            }
-            break;
-        }
-        case MQTT_EVENT_DATA: {
-            if (event->current_data_offset == 0) {
-                mqtt_event_topic_.clear();
-                mqtt_event_payload_.clear();
-                mqtt_event_topic_.reserve(event->topic_len > 0 ? static_cast<size_t>(event->topic_len) : 0);
-                mqtt_event_payload_.reserve(event->total_data_len > 0 ? static_cast<size_t>(event->total_data_len) : static_cast<size_t>(event->data_len));
-                append_buffer_to_string(mqtt_event_topic_, event->topic, static_cast<size_t>(event->topic_len));
-            }
-            append_buffer_to_string(mqtt_event_payload_, event->data, static_cast<size_t>(event->data_len));
-            const int received_end = event->current_data_offset + event->data_len;
-            if (event->total_data_len <= 0 || received_end >= event->total_data_len) {
-                handleIncomingMessage(mqtt_event_topic_.c_str(),
-                                      reinterpret_cast<const uint8_t *>(mqtt_event_payload_.c_str()),
-                                      mqtt_event_payload_.length());
-                mqtt_event_topic_.clear();
-                mqtt_event_payload_.clear();
-            }
+        case MqttTransportEventType::Error:
+            mqtt_last_error_rc_.store(event.error_rc, std::memory_order_release);
             break;
-        }
-        default:
+        case MqttTransportEventType::Message:
+            handleIncomingMessage(event.topic, event.payload, event.payload_len);
             break;
     }
 }
 
-void MqttManager::staticEventHandler(void *handler_args, esp_event_base_t base, int32_t event_id,
-                                     void *event_data) {
-    (void)base;
-    (void)event_id;
-
-    MqttManager *manager = static_cast<MqttManager *>(handler_args);
+void MqttManager::staticTransportEventHandler(void *context, const MqttTransportEvent &event) {
+    MqttManager *manager = static_cast<MqttManager *>(context);
     if (!manager) {
         manager = g_mqtt;
     }
     if (manager) {
-        manager->handleEvent(static_cast<esp_mqtt_event_handle_t>(event_data));
+        manager->handleTransportEvent(event);
     }
 }
 
@@ -1471,7 +1235,7 @@ void MqttManager::updateOtaQuiesceState() {
             mqtt_publish_requested_ = true;
             ui_dirty_ = true;
             LOGI("MQTT", "suspending for OTA");
-            if (client_) {
+            if (transport_->isActive()) {
                 stopClient();
             }
         }
@@ -1499,8 +1263,8 @@ void MqttManager::poll(MqttRuntimeState &runtime_state) {
         if (mqtt_connect_attempts_ < UINT32_MAX) {
             mqtt_connect_attempts_++;
         }
-        if (should_log_connect_failure(mqtt_connect_attempts_)) {
-            uint32_t delay_ms = retryDelayMsForAttempts(mqtt_connect_attempts_);
+        if (MqttConnectionPolicy::shouldLogConnectFailure(mqtt_connect_attempts_)) {
+            uint32_t delay_ms = MqttConnectionPolicy::retryDelayMsForAttempts(mqtt_connect_attempts_);
             Logger::log(Logger::Warn, "MQTT",
                         "connect failed rc=%d (attempt %lu), retry in %s",
                         rc,
@@ -1519,14 +1283,18 @@ void MqttManager::poll(MqttRuntimeState &runtime_state) {
         mqtt_fail_count_ = 0;
         mqtt_connect_attempts_ = 0;
         mqtt_last_error_rc_.store(0, std::memory_order_release);
+        mqtt_connected_since_ms_ = millis();
+        publish_scheduler_.reset(mqtt_connected_since_ms_);
         ui_dirty_ = true;
 
         char subscribe_topic[kTopicBufferSize];
-        snprintf(subscribe_topic, sizeof(subscribe_topic), "%s/command/#", mqtt_base_topic_.c_str());
+        MqttPayloadBuilder::buildCommandTopic(subscribe_topic, sizeof(subscribe_topic),
+                                              mqtt_base_topic_, "#");
         subscribeTopic(subscribe_topic);
 
         char will_topic[kTopicBufferSize];
-        build_availability_topic(will_topic, sizeof(will_topic), mqtt_base_topic_);
+        MqttPayloadBuilder::buildAvailabilityTopic(will_topic, sizeof(will_topic),
+                                                   mqtt_base_topic_);
         publishMessage(will_topic, Config::MQTT_AVAIL_ONLINE, true);
         publishNightModeAvailability();
         mqtt_publish_requested_ = true;
@@ -1550,9 +1318,9 @@ void MqttManager::poll(MqttRuntimeState &runtime_state) {
             mqtt_manual_stop_ = false;
         }
     }
-    if (mqtt_client_needs_destroy_ && client_) {
+    if (mqtt_client_needs_destroy_ && transport_->isActive()) {
         if (mqtt_client_started_) {
-            esp_mqtt_client_stop(client_);
+            transport_->stop();
             mqtt_client_started_ = false;
         }
         destroyClient();
@@ -1576,10 +1344,10 @@ void MqttManager::poll(MqttRuntimeState &runtime_state) {
         mqtt_publish_deferred_by_web_ = false;
         if (mqtt_connected_) {
             char topic[kTopicBufferSize];
-            build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+            MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
             publishMessage(topic, Config::MQTT_AVAIL_OFFLINE, true);
         }
-        if (client_) {
+        if (transport_->isActive()) {
             stopClient();
         }
         mqtt_fail_count_ = 0;
@@ -1598,10 +1366,10 @@ void MqttManager::poll(MqttRuntimeState &runtime_state) {
         if (mqtt_connected_) {
             LOGW("MQTT", "network unavailable, disconnecting gracefully");
             char topic[kTopicBufferSize];
-            build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+            MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), mqtt_base_topic_);
             publishMessage(topic, Config::MQTT_AVAIL_OFFLINE, true);
         }
-        if (client_) {
+        if (transport_->isActive()) {
             stopClient();
         }
         mqtt_fail_count_ = 0;
@@ -1628,10 +1396,8 @@ void MqttManager::poll(MqttRuntimeState &runtime_state) {
             return;
         }
         uint32_t now = millis();
-        uint32_t retry_delay = retryDelayMsForAttempts(mqtt_connect_attempts_);
-        const bool immediate_first_attempt =
-            (mqtt_connect_attempts_ == 0 && mqtt_last_attempt_ms_ == 0);
-        if (immediate_first_attempt || (now - mqtt_last_attempt_ms_ >= retry_delay)) {
+        if (MqttConnectionPolicy::connectAttemptDue(mqtt_connect_attempts_,
+                                                    mqtt_last_attempt_ms_, now)) {
             if (WebHandlersShouldPauseMqttConnect()) {
                 if (!mqtt_connect_deferred_by_web_) {
                     WebHandlersNoteMqttConnectDeferred();
@@ -1645,34 +1411,8 @@ void MqttManager::poll(MqttRuntimeState &runtime_state) {
         }
         return;
     }
-    uint32_t now = millis();
-    const bool publish_due =
-        mqtt_publish_requested_ || (now - mqtt_last_publish_ms_ >= Config::MQTT_PUBLISH_MS);
-    const bool discovery_due = mqtt_discovery_ && !mqtt_discovery_sent_;
-    const bool events_due = MqttEventQueue::instance().hasPending();
-    if (discovery_due || publish_due || events_due) {
-        if (WebHandlersShouldPauseMqttPublish()) {
-            if (!mqtt_publish_deferred_by_web_) {
-                WebHandlersNoteMqttPublishDeferred();
-                mqtt_publish_deferred_by_web_ = true;
-            }
-            return;
-        }
-        mqtt_publish_deferred_by_web_ = false;
-        if (discovery_due) {
-            publishDiscovery(runtime);
-        }
-    } else {
-        mqtt_publish_deferred_by_web_ = false;
-    }
     mqtt_connect_deferred_by_web_ = false;
-    if (publish_due) {
-        mqtt_publish_requested_ = false;
-        publishState(runtime);
-    }
-    if (mqtt_connected_ && events_due) {
-        publishQueuedEvents(kMaxQueuedEventPublishesPerPoll);
-    }
+    runPublishScheduler(runtime, millis());
 }
 
 void MqttManager::syncWithWifi() {
@@ -1691,11 +1431,12 @@ void MqttManager::syncWithWifi() {
             if (mqtt_connected_) {
                 if (wifi_ready) {
                     char topic[kTopicBufferSize];
-                    build_availability_topic(topic, sizeof(topic), mqtt_base_topic_);
+                    MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic),
+                                                               mqtt_base_topic_);
                     publishMessage(topic, Config::MQTT_AVAIL_OFFLINE, true);
                 }
             }
-            if (client_) {
+            if (transport_->isActive()) {
                 stopClient();
             }
             mqtt_fail_count_ = 0;
@@ -1713,10 +1454,11 @@ void MqttManager::requestReconnect() {
     mqtt_connect_deferred_by_web_ = false;
     mqtt_publish_deferred_by_web_ = false;
     mqtt_discovery_sent_ = false;
+    discovery_cursor_ = 0;
     mqtt_last_attempt_ms_ = 0;
     mqtt_mdns_cache_valid_ = false;
     mqtt_last_error_rc_.store(0, std::memory_order_release);
-    if (client_) {
+    if (transport_->isActive()) {
         stopClient();
     }
     ui_dirty_ = true;
@@ -1730,6 +1472,7 @@ void MqttManager::setUserEnabled(bool enabled) {
     mqtt_connect_deferred_by_web_ = false;
     mqtt_publish_deferred_by_web_ = false;
     mqtt_discovery_sent_ = false;
+    discovery_cursor_ = 0;
     mqtt_connect_attempts_ = 0;
     if (storage_) {
         storage_->saveMqttEnabled(mqtt_user_enabled_);
@@ -1773,6 +1516,7 @@ void MqttManager::applySavedSettings(const String &host,
     unlockCommandContext();
 
     mqtt_discovery_sent_ = false;
+    discovery_cursor_ = 0;
     mqtt_connect_attempts_ = 0;
     mqtt_fail_count_ = 0;
     mqtt_last_attempt_ms_ = 0;
@@ -1783,7 +1527,7 @@ void MqttManager::applySavedSettings(const String &host,
     mqtt_publish_requested_ = false;
     refreshHostBuffer();
     setupClient();
-    if (client_) {
+    if (transport_->isActive()) {
         stopClient();
     }
     ui_dirty_ = true;
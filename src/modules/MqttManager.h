@@ -7,16 +7,18 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 #include <Arduino.h>
 #include <WiFi.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
-#include <mqtt_client.h>
 #include "config/AppConfig.h"
 #include "config/AppData.h"
+#include "core/MqttPublishScheduler.h"
 #include "core/MqttRuntimeState.h"
 #include "modules/MqttRuntime.h"
+#include "modules/MqttTransport.h"
 
 class StorageManager;
 class AuraNetworkManager;
@@ -48,8 +50,7 @@ public:
     uint32_t connectAttempts() const { return mqtt_connect_attempts_; }
     uint8_t retryStage() const override;
     uint32_t retryDelayMs() const;
-    static uint8_t retryStageForAttempts(uint32_t failed_attempts);
-    static uint32_t retryDelayMsForAttempts(uint32_t failed_attempts);
+    MqttPublishStats publishStats() const override;
     bool isUiDirty() const { return ui_dirty_.load(std::memory_order_acquire); }
     void clearUiDirty() { ui_dirty_.store(false, std::memory_order_release); }
     void markUiDirty() { ui_dirty_.store(true, std::memory_order_release); }
@@ -95,7 +96,6 @@ private:
     bool publishMessage(const char *topic, const uint8_t *payload, size_t length, bool retain);
     bool subscribeTopic(const char *topic);
     bool connectClient();
-    void handleEvent(esp_mqtt_event_handle_t event);
     void publishDiscoverySensor(const char *object_id, const char *name,
                                 const char *unit, const char *device_class,
                                 const char *state_class, const char *value_template,
@@ -116,18 +116,19 @@ private:
                                 const char *payload_press, const char *icon);
     void publishDiscoveryEventSensor();
     void publishNightModeAvailability();
-    void publishDiscovery(const MqttRuntimeSnapshot &runtime);
-    void publishState(const MqttRuntimeSnapshot &runtime);
-    void publishQueuedEvents(size_t max_events);
+    bool takeDiscoverySlot();
+    uint16_t publishDiscovery(const MqttRuntimeSnapshot &runtime, uint16_t budget);
+    uint16_t publishState(const MqttRuntimeSnapshot &runtime);
+    bool publishQueuedEvent(size_t index);
+    size_t countBackfillEvents() const;
+    void runPublishScheduler(const MqttRuntimeSnapshot &runtime, uint32_t now);
     void updateOtaQuiesceState();
     void lockCommandContext() const;
     void unlockCommandContext() const;
 
     void handleIncomingMessage(const char *topic, const uint8_t *payload, size_t length);
-    static void staticEventHandler(void *handler_args, esp_event_base_t base, int32_t event_id,
-                                   void *event_data);
-    static bool payloadIsOn(const char *payload);
-    static bool payloadIsOff(const char *payload);
+    void handleTransportEvent(const MqttTransportEvent &event);
+    static void staticTransportEventHandler(void *context, const MqttTransportEvent &event);
 
     enum class ConnectionSignal : uint8_t {
         None = 0,
@@ -138,9 +139,8 @@ private:
     StorageManager *storage_ = nullptr;
     AuraNetworkManager *network_ = nullptr;
     MqttRuntimeState *runtime_state_ = nullptr;
-    esp_mqtt_client_handle_t client_ = nullptr;
+    std::unique_ptr<MqttTransport> transport_;
     std::atomic<bool> ui_dirty_{false};
-    std::atomic<esp_mqtt_client_handle_t> mqtt_active_client_{nullptr};
     std::atomic<uint8_t> mqtt_connection_signal_{static_cast<uint8_t>(ConnectionSignal::None)};
     std::atomic<int> mqtt_last_error_rc_{0};
     mutable StaticSemaphore_t command_context_mutex_buffer_{};
@@ -152,6 +152,7 @@ private:
     char mqtt_host_buf_[kMqttHostBufferSize] = {0};
     char mqtt_broker_endpoint_buf_[kMqttHostBufferSize] = {0};
     char mqtt_state_payload_buf_[kMqttStatePayloadBufferSize] = {0};
+    uint8_t mqtt_state_cbor_buf_[Config::MQTT_STATE_CBOR_BUFFER_SIZE] = {0};
     uint16_t mqtt_port_ = Config::MQTT_DEFAULT_PORT;
     String mqtt_user_;
     String mqtt_pass_;
@@ -163,6 +164,15 @@ private:
     bool mqtt_discovery_ = true;
     bool mqtt_anonymous_ = false;
     bool mqtt_discovery_sent_ = false;
+    uint16_t discovery_cursor_ = 0;
+    uint16_t discovery_total_ = 0;
+    uint16_t discovery_slot_index_ = 0;
+    uint16_t discovery_slot_budget_ = 0;
+    uint16_t discovery_slot_sent_ = 0;
+    bool discovery_fan_present_ = false;
+    MqttPublishScheduler publish_scheduler_;
+    MqttPublishStats publish_stats_{};
+    uint32_t mqtt_connected_since_ms_ = 0;
     uint32_t mqtt_last_attempt_ms_ = 0;
     uint32_t mqtt_last_publish_ms_ = 0;
     bool mqtt_publish_requested_ = false;
@@ -177,9 +187,6 @@ private:
     bool mqtt_ota_suspended_ = false;
     bool mqtt_manual_stop_ = false;
     bool mqtt_client_needs_destroy_ = false;
-    // MQTT_EVENT_DATA may arrive in chunks; these buffers belong only to the esp-mqtt event task.
-    String mqtt_event_topic_;
-    String mqtt_event_payload_;
     String mqtt_mdns_cache_host_;
     IPAddress mqtt_mdns_cache_ip_;
     uint32_t mqtt_mdns_cache_ts_ms_ = 0;
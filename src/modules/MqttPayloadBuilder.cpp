@@ -88,14 +88,6 @@ void append_json_escaped(String &out, const String &value) {
     append_json_escaped(out, value.c_str());
 }
 
-void build_state_topic(char *out, size_t out_size, const String &base) {
-    snprintf(out, out_size, "%s/state", base.c_str());
-}
-
-void build_availability_topic(char *out, size_t out_size, const String &base) {
-    snprintf(out, out_size, "%s/status", base.c_str());
-}
-
 bool string_is_empty(const String &text) {
     return text.length() == 0;
 }
@@ -398,8 +390,422 @@ const char *optional_gas_type_text(const SensorData &data) {
                : nullptr;
 }
 
+// Indexed by StateField; tags are part of the compact wire format, so keep this append-only.
+constexpr const char *kStateFieldKeys[] = {
+    "version",
+    "temp",
+    "humidity",
+    "dew_point",
+    "absolute_humidity",
+    "co2",
+    "aqi",
+    "co",
+    "optional_gas",
+    "optional_gas_type",
+    "nh3",
+    "o3",
+    "so2",
+    "no2",
+    "h2s",
+    "voc_index",
+    "nox_index",
+    "hcho",
+    "pm05",
+    "pm1",
+    "pm4",
+    "pm25",
+    "pm10",
+    "pressure",
+    "pressure_absolute",
+    "pressure_delta_3h",
+    "pressure_delta_24h",
+    "fan_present",
+    "fan_available",
+    "fan_running",
+    "fan_manual_running",
+    "fan_fault",
+    "fan_auto",
+    "fan_stopped",
+    "fan_mode",
+    "fan_control_mode",
+    "fan_timer",
+    "fan_timer_remaining",
+    "fan_manual_speed",
+    "fan_manual_percent",
+    "fan_status",
+    "fan_output_percent",
+    "fan_output_mv",
+    "night_mode",
+    "alert_blink",
+    "air_status",
+    "main_issue",
+    "backlight",
+    "sample_ts",
+};
+static_assert(sizeof(kStateFieldKeys) / sizeof(kStateFieldKeys[0]) ==
+                  static_cast<size_t>(StateField::Count),
+              "kStateFieldKeys must list every StateField");
+
+class JsonStateSink {
+public:
+    JsonStateSink(char *out, size_t out_size) : writer_(out, out_size) {}
+
+    bool begin() { return writer_.appendf("{"); }
+    bool end() { return writer_.appendf("}"); }
+    size_t size() const { return writer_.size(); }
+
+    bool addInt(StateField field, bool valid, int value) {
+        if (!appendKey(field)) {
+            return false;
+        }
+        return valid ? writer_.appendf("%d", value) : writer_.appendf("null");
+    }
+
+    bool addUint(StateField field, bool valid, uint32_t value) {
+        if (!appendKey(field)) {
+            return false;
+        }
+        return valid ? writer_.appendf("%lu", static_cast<unsigned long>(value))
+                     : writer_.appendf("null");
+    }
+
+    bool addFloat(StateField field, bool valid, float value, int decimals) {
+        if (!appendKey(field)) {
+            return false;
+        }
+        return valid ? writer_.appendf("%.*f", decimals, static_cast<double>(value))
+                     : writer_.appendf("null");
+    }
+
+    bool addBool(StateField field, bool value) {
+        return appendKey(field) && writer_.appendf("\"%s\"", value ? "ON" : "OFF");
+    }
+
+    bool addText(StateField field, const char *value) {
+        return appendKey(field) && writer_.appendf("\"%s\"", value ? value : "");
+    }
+
+    bool addNullableText(StateField field, const char *value) {
+        if (!appendKey(field)) {
+            return false;
+        }
+        if (!value || value[0] == '\0') {
+            return writer_.appendf("null");
+        }
+        return writer_.appendf("\"%s\"", value);
+    }
+
+private:
+    bool appendKey(StateField field) {
+        const bool ok = writer_.appendf("%s\"%s\":", first_ ? "" : ",", stateFieldKey(field));
+        first_ = false;
+        return ok;
+    }
+
+    BufferWriter writer_;
+    bool first_ = true;
+};
+
+// RFC 8949 encoder limited to what the state document needs: an indefinite-length map keyed
+// by StateField tags with int, float32, bool, null and text values.
+class CborStateSink {
+public:
+    CborStateSink(uint8_t *out, size_t out_size) : out_(out), out_size_(out_size) {}
+
+    bool begin() {
+        return writeByte(kCborMapIndefinite) &&
+               writeKey(StateField::Version) &&
+               writeHead(kCborMajorUnsigned, kStateCborVersion);
+    }
+    bool end() { return writeByte(kCborBreak); }
+    size_t size() const { return failed_ ? 0 : used_; }
+
+    bool addInt(StateField field, bool valid, int value) {
+        if (!writeKey(field)) {
+            return false;
+        }
+        if (!valid) {
+            return writeByte(kCborNull);
+        }
+        if (value < 0) {
+            return writeHead(kCborMajorNegative, static_cast<uint32_t>(-(value + 1)));
+        }
+        return writeHead(kCborMajorUnsigned, static_cast<uint32_t>(value));
+    }
+
+    bool addUint(StateField field, bool valid, uint32_t value) {
+        if (!writeKey(field)) {
+            return false;
+        }
+        return valid ? writeHead(kCborMajorUnsigned, value) : writeByte(kCborNull);
+    }
+
+    bool addFloat(StateField field, bool valid, float value, int decimals) {
+        (void)decimals; // Precision is a JSON presentation detail; float32 carries the raw value.
+        if (!writeKey(field)) {
+            return false;
+        }
+        if (!valid) {
+            return writeByte(kCborNull);
+        }
+        uint32_t bits = 0;
+        memcpy(&bits, &value, sizeof(bits));
+        return writeByte(kCborFloat32) && writeBigEndian(bits, 4);
+    }
+
+    bool addBool(StateField field, bool value) {
+        return writeKey(field) && writeByte(value ? kCborTrue : kCborFalse);
+    }
+
+    bool addText(StateField field, const char *value) {
+        return writeKey(field) && writeText(value ? value : "");
+    }
+
+    bool addNullableText(StateField field, const char *value) {
+        if (!writeKey(field)) {
+            return false;
+        }
+        if (!value || value[0] == '\0') {
+            return writeByte(kCborNull);
+        }
+        return writeText(value);
+    }
+
+private:
+    static constexpr uint8_t kCborMajorUnsigned = 0;
+    static constexpr uint8_t kCborMajorNegative = 1;
+    static constexpr uint8_t kCborMajorText = 3;
+    static constexpr uint8_t kCborMapIndefinite = 0xBF;
+    static constexpr uint8_t kCborFalse = 0xF4;
+    static constexpr uint8_t kCborTrue = 0xF5;
+    static constexpr uint8_t kCborNull = 0xF6;
+    static constexpr uint8_t kCborFloat32 = 0xFA;
+    static constexpr uint8_t kCborBreak = 0xFF;
+
+    bool writeByte(uint8_t value) {
+        if (!out_ || failed_ || used_ >= out_size_) {
+            failed_ = true;
+            return false;
+        }
+        out_[used_++] = value;
+        return true;
+    }
+
+    bool writeBigEndian(uint32_t value, size_t bytes) {
+        for (size_t i = bytes; i > 0; --i) {
+            if (!writeByte(static_cast<uint8_t>(value >> ((i - 1) * 8)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool writeHead(uint8_t major, uint32_t value) {
+        const uint8_t prefix = static_cast<uint8_t>(major << 5);
+        if (value < 24) {
+            return writeByte(static_cast<uint8_t>(prefix | value));
+        }
+        if (value <= 0xFF) {
+            return writeByte(static_cast<uint8_t>(prefix | 24)) && writeBigEndian(value, 1);
+        }
+        if (value <= 0xFFFF) {
+            return writeByte(static_cast<uint8_t>(prefix | 25)) && writeBigEndian(value, 2);
+        }
+        return writeByte(static_cast<uint8_t>(prefix | 26)) && writeBigEndian(value, 4);
+    }
+
+    bool writeKey(StateField field) {
+        return writeHead(kCborMajorUnsigned, static_cast<uint32_t>(field));
+    }
+
+    bool writeText(const char *value) {
+        const size_t len = strlen(value);
+        if (!writeHead(kCborMajorText, static_cast<uint32_t>(len))) {
+            return false;
+        }
+        if (len > out_size_ - used_) {
+            failed_ = true;
+            return false;
+        }
+        memcpy(out_ + used_, value, len);
+        used_ += len;
+        return true;
+    }
+
+    uint8_t *out_ = nullptr;
+    size_t out_size_ = 0;
+    size_t used_ = 0;
+    bool failed_ = false;
+};
+
+// Wall-clock second of the newest sample behind the document; null until one arrives with the
+// clock set. One field for the whole state keeps the JSON inside MQTT_BUFFER_SIZE; per-source
+// ages stay on /api/state.
+uint32_t latest_sample_epoch(const SensorData &data) {
+    uint32_t latest = 0;
+    for (size_t i = 0; i < SENSOR_SOURCE_COUNT; ++i) {
+        if (data.stamps[i].epoch > latest) {
+            latest = data.stamps[i].epoch;
+        }
+    }
+    return latest;
+}
+
+template <typename Sink>
+bool emit_state_fields(Sink &sink,
+                       const SensorData &data,
+                       const FanStateSnapshot &fan,
+                       bool gas_warmup,
+                       bool night_mode,
+                       bool alert_blink,
+                       bool backlight_on,
+                       bool pressure_altitude_set,
+                       int16_t pressure_altitude_m) {
+    float dew_c = NAN;
+    bool dew_valid = data.temp_valid && data.hum_valid;
+    if (dew_valid) {
+        dew_c = compute_dew_point_c(data.temperature, data.humidity);
+        dew_valid = isfinite(dew_c);
+    }
+    float ah_gm3 = NAN;
+    bool ah_valid = data.temp_valid && data.hum_valid;
+    if (ah_valid) {
+        ah_gm3 = MathUtils::compute_absolute_humidity_gm3(data.temperature, data.humidity);
+        ah_valid = isfinite(ah_gm3);
+    }
+    const AirQualityEngine::Result aqi = AirQualityEngine::evaluate(data, gas_warmup);
+    const uint32_t sample_epoch = latest_sample_epoch(data);
+    const float pressure_published =
+        pressure_to_publish(data.pressure, pressure_altitude_set, pressure_altitude_m);
+    const float pressure_delta_3h_published =
+        pressure_delta_to_publish(data.pressure_delta_3h,
+                                  pressure_altitude_set,
+                                  pressure_altitude_m);
+    const float pressure_delta_24h_published =
+        pressure_delta_to_publish(data.pressure_delta_24h,
+                                  pressure_altitude_set,
+                                  pressure_altitude_m);
+
+    if (!sink.begin() ||
+        !sink.addFloat(StateField::Temp, data.temp_valid, data.temperature, 1) ||
+        !sink.addFloat(StateField::Humidity, data.hum_valid, data.humidity, 1) ||
+        !sink.addFloat(StateField::DewPoint, dew_valid, dew_c, 1) ||
+        !sink.addFloat(StateField::AbsoluteHumidity, ah_valid, ah_gm3, 1) ||
+        !sink.addInt(StateField::Co2, data.co2_valid, data.co2) ||
+        !sink.addInt(StateField::Aqi, aqi.valid, aqi.score)) {
+        return false;
+    }
+    const bool co_valid = data.co_sensor_present &&
+                          data.co_valid &&
+                          isfinite(data.co_ppm) &&
+                          data.co_ppm >= 0.0f;
+    const bool nh3_valid = optional_gas_value_valid_for_type(data, OptionalGasType::NH3);
+    const bool so2_valid = optional_gas_value_valid_for_type(data, OptionalGasType::SO2);
+    const bool no2_valid = optional_gas_value_valid_for_type(data, OptionalGasType::NO2);
+    const bool h2s_valid = optional_gas_value_valid_for_type(data, OptionalGasType::H2S);
+    const bool o3_valid = optional_gas_value_valid_for_type(data, OptionalGasType::O3);
+    const bool optional_gas_valid = optional_gas_value_valid(data);
+    const bool voc_publish_valid = !gas_warmup && data.voc_valid;
+    const bool nox_publish_valid = !gas_warmup && data.nox_valid;
+    const bool fan_output_valid = fan.present && fan.output_known;
+    const bool fan_manual_speed_valid = fan.present;
+    const uint8_t fan_manual_speed = compute_fan_manual_speed(fan);
+    const uint8_t fan_manual_percent = compute_fan_manual_percent(fan);
+    const uint8_t fan_output_percent = compute_fan_output_percent(fan);
+    const uint32_t fan_timer_remaining = fan_timer_remaining_seconds(fan, millis());
+    char fan_timer_remaining_text[24];
+    format_fan_timer_remaining(fan_timer_remaining_text,
+                               sizeof(fan_timer_remaining_text),
+                               fan_timer_remaining);
+    if (!sink.addFloat(StateField::Co, co_valid, data.co_ppm, 1) ||
+        !sink.addFloat(StateField::OptionalGas, optional_gas_valid, data.optional_gas_ppm, 1) ||
+        !sink.addNullableText(StateField::OptionalGasType, optional_gas_type_text(data)) ||
+        !sink.addFloat(StateField::Nh3, nh3_valid, data.nh3_ppm, 1) ||
+        !sink.addFloat(StateField::O3, o3_valid, data.optional_gas_ppm, 1) ||
+        !sink.addFloat(StateField::So2, so2_valid, data.optional_gas_ppm, 1) ||
+        !sink.addFloat(StateField::No2, no2_valid, data.optional_gas_ppm, 1) ||
+        !sink.addFloat(StateField::H2s, h2s_valid, data.optional_gas_ppm, 1) ||
+        !sink.addInt(StateField::VocIndex, voc_publish_valid, data.voc_index) ||
+        !sink.addInt(StateField::NoxIndex, nox_publish_valid, data.nox_index) ||
+        !sink.addFloat(StateField::Hcho, data.hcho_valid, data.hcho, 1) ||
+        !sink.addFloat(StateField::Pm05, data.pm05_valid, data.pm05, 1) ||
+        !sink.addFloat(StateField::Pm1, data.pm1_valid, data.pm1, 1) ||
+        !sink.addFloat(StateField::Pm4, data.pm4_valid, data.pm4, 1) ||
+        !sink.addFloat(StateField::Pm25, data.pm25_valid, data.pm25, 1) ||
+        !sink.addFloat(StateField::Pm10, data.pm10_valid, data.pm10, 1) ||
+        !sink.addFloat(StateField::Pressure, data.pressure_valid, pressure_published, 1) ||
+        !sink.addFloat(StateField::PressureAbsolute, data.pressure_valid, data.pressure, 1) ||
+        !sink.addFloat(StateField::PressureDelta3h, data.pressure_delta_3h_valid, pressure_delta_3h_published, 1) ||
+        !sink.addFloat(StateField::PressureDelta24h, data.pressure_delta_24h_valid, pressure_delta_24h_published, 1) ||
+        !sink.addBool(StateField::FanPresent, fan.present) ||
+        !sink.addBool(StateField::FanAvailable, fan.available) ||
+        !sink.addBool(StateField::FanRunning, fan.running) ||
+        !sink.addBool(StateField::FanManualRunning, fan_manual_running(fan)) ||
+        !sink.addBool(StateField::FanFault, fan.faulted) ||
+        !sink.addBool(StateField::FanAuto, fan_auto_enabled(fan)) ||
+        !sink.addBool(StateField::FanStopped, fan_stopped(fan)) ||
+        !sink.addText(StateField::FanMode, fan_mode_text(fan.mode)) ||
+        !sink.addText(StateField::FanControlMode, fan_control_mode_text(fan)) ||
+        !sink.addText(StateField::FanTimer, fan_timer_text(fan.selected_timer_s)) ||
+        !sink.addText(StateField::FanTimerRemaining, fan_timer_remaining_text) ||
+        !sink.addInt(StateField::FanManualSpeed, fan_manual_speed_valid, fan_manual_speed) ||
+        !sink.addInt(StateField::FanManualPercent, fan_manual_speed_valid, fan_manual_percent) ||
+        !sink.addText(StateField::FanStatus, fan_status_text(fan)) ||
+        !sink.addInt(StateField::FanOutputPercent, fan_output_valid, fan_output_percent) ||
+        !sink.addInt(StateField::FanOutputMv, fan_output_valid, fan.output_mv) ||
+        !sink.addBool(StateField::NightMode, night_mode) ||
+        !sink.addBool(StateField::AlertBlink, alert_blink) ||
+        !sink.addText(StateField::AirStatus, air_status_text(aqi)) ||
+        !sink.addText(StateField::MainIssue, main_issue_text(aqi)) ||
+        !sink.addBool(StateField::Backlight, backlight_on) ||
+        !sink.addUint(StateField::SampleTs, sample_epoch != 0, sample_epoch) ||
+        !sink.end()) {
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace
 
+const char *stateFieldKey(StateField field) {
+    const size_t index = static_cast<size_t>(field);
+    if (index >= static_cast<size_t>(StateField::Count)) {
+        return nullptr;
+    }
+    return kStateFieldKeys[index];
+}
+
+void buildStateTopic(char *out, size_t out_size, const String &base) {
+    snprintf(out, out_size, "%s/state", base.c_str());
+}
+
+void buildStateCborTopic(char *out, size_t out_size, const String &base) {
+    snprintf(out, out_size, "%s/state/cbor", base.c_str());
+}
+
+void buildEventsTopic(char *out, size_t out_size, const String &base) {
+    snprintf(out, out_size, "%s/events", base.c_str());
+}
+
+void buildAvailabilityTopic(char *out, size_t out_size, const String &base) {
+    snprintf(out, out_size, "%s/status", base.c_str());
+}
+
+void buildNightModeAvailabilityTopic(char *out, size_t out_size, const String &base) {
+    snprintf(out, out_size, "%s/availability/night_mode", base.c_str());
+}
+
+void buildCommandTopic(char *out, size_t out_size, const String &base, const char *command) {
+    snprintf(out, out_size, "%s/command/%s", base.c_str(), command);
+}
+
+void buildDiscoveryTopic(char *out, size_t out_size, const char *component,
+                         const String &device_id, const char *object_id) {
+    snprintf(out, out_size, "homeassistant/%s/%s_%s/config",
+             component, device_id.c_str(), object_id);
+}
+
 String buildDiscoveryEntityObjectId(const String &base_topic,
                                     const char *object_id) {
     String entity_object_id;
@@ -439,14 +845,14 @@ String buildDiscoverySensorPayload(const String &device_id,
     append_json_escaped(payload, object_id);
     payload += "\",\"state_topic\":\"";
     char topic[256];
-    build_state_topic(topic, sizeof(topic), base_topic);
+    buildStateTopic(topic, sizeof(topic), base_topic);
     append_json_escaped(payload, topic);
     if (entity_object_id && entity_object_id[0] != '\0') {
         payload += "\",\"object_id\":\"";
         append_json_escaped(payload, entity_object_id);
     }
     payload += "\",\"availability_topic\":\"";
-    build_availability_topic(topic, sizeof(topic), base_topic);
+    buildAvailabilityTopic(topic, sizeof(topic), base_topic);
     append_json_escaped(payload, topic);
     payload += "\",\"payload_available\":\"";
     payload += Config::MQTT_AVAIL_ONLINE;
@@ -589,164 +995,44 @@ size_t buildStatePayload(char *out,
                          bool backlight_on,
                          bool pressure_altitude_set,
                          int16_t pressure_altitude_m) {
-    BufferWriter payload(out, out_size);
-    if (!payload.appendf("{")) {
+    JsonStateSink sink(out, out_size);
+    if (!emit_state_fields(sink,
+                           data,
+                           fan,
+                           gas_warmup,
+                           night_mode,
+                           alert_blink,
+                           backlight_on,
+                           pressure_altitude_set,
+                           pressure_altitude_m)) {
         return 0;
     }
-    bool first = true;
-    auto add_int = [&](const char *key, bool valid, int value) {
-        if (!payload.appendf("%s\"%s\":", first ? "" : ",", key)) {
-            return false;
-        }
-        first = false;
-        if (valid) {
-            return payload.appendf("%d", value);
-        } else {
-            return payload.appendf("null");
-        }
-    };
-    auto add_float = [&](const char *key, bool valid, float value, int decimals) {
-        if (!payload.appendf("%s\"%s\":", first ? "" : ",", key)) {
-            return false;
-        }
-        first = false;
-        if (valid) {
-            return payload.appendf("%.*f", decimals, static_cast<double>(value));
-        } else {
-            return payload.appendf("null");
-        }
-    };
-    auto add_bool = [&](const char *key, bool value) {
-        if (!payload.appendf("%s\"%s\":\"%s\"",
-                             first ? "" : ",",
-                             key,
-                             value ? "ON" : "OFF")) {
-            return false;
-        }
-        first = false;
-        return true;
-    };
-    auto add_cstr = [&](const char *key, const char *value) {
-        if (!payload.appendf("%s\"%s\":\"%s\"",
-                             first ? "" : ",",
-                             key,
-                             value ? value : "")) {
-            return false;
-        }
-        first = false;
-        return true;
-    };
-    auto add_nullable_cstr = [&](const char *key, const char *value) {
-        if (!payload.appendf("%s\"%s\":", first ? "" : ",", key)) {
-            return false;
-        }
-        first = false;
-        if (!value || value[0] == '\0') {
-            return payload.appendf("null");
-        }
-        return payload.appendf("\"%s\"", value);
-    };
-
-    float dew_c = NAN;
-    bool dew_valid = data.temp_valid && data.hum_valid;
-    if (dew_valid) {
-        dew_c = compute_dew_point_c(data.temperature, data.humidity);
-        dew_valid = isfinite(dew_c);
-    }
-    float ah_gm3 = NAN;
-    bool ah_valid = data.temp_valid && data.hum_valid;
-    if (ah_valid) {
-        ah_gm3 = MathUtils::compute_absolute_humidity_gm3(data.temperature, data.humidity);
-        ah_valid = isfinite(ah_gm3);
-    }
-    const AirQualityEngine::Result aqi = AirQualityEngine::evaluate(data, gas_warmup);
-    const float pressure_published =
-        pressure_to_publish(data.pressure, pressure_altitude_set, pressure_altitude_m);
-    const float pressure_delta_3h_published =
-        pressure_delta_to_publish(data.pressure_delta_3h,
-                                  pressure_altitude_set,
-                                  pressure_altitude_m);
-    const float pressure_delta_24h_published =
-        pressure_delta_to_publish(data.pressure_delta_24h,
-                                  pressure_altitude_set,
-                                  pressure_altitude_m);
+    return sink.size();
+}
 
-    if (!add_float("temp", data.temp_valid, data.temperature, 1) ||
-        !add_float("humidity", data.hum_valid, data.humidity, 1) ||
-        !add_float("dew_point", dew_valid, dew_c, 1) ||
-        !add_float("absolute_humidity", ah_valid, ah_gm3, 1) ||
-        !add_int("co2", data.co2_valid, data.co2) ||
-        !add_int("aqi", aqi.valid, aqi.score)) {
-        return 0;
-    }
-    const bool co_valid = data.co_sensor_present &&
-                          data.co_valid &&
-                          isfinite(data.co_ppm) &&
-                          data.co_ppm >= 0.0f;
-    const bool nh3_valid = optional_gas_value_valid_for_type(data, OptionalGasType::NH3);
-    const bool so2_valid = optional_gas_value_valid_for_type(data, OptionalGasType::SO2);
-    const bool no2_valid = optional_gas_value_valid_for_type(data, OptionalGasType::NO2);
-    const bool h2s_valid = optional_gas_value_valid_for_type(data, OptionalGasType::H2S);
-    const bool o3_valid = optional_gas_value_valid_for_type(data, OptionalGasType::O3);
-    const bool optional_gas_valid = optional_gas_value_valid(data);
-    const bool voc_publish_valid = !gas_warmup && data.voc_valid;
-    const bool nox_publish_valid = !gas_warmup && data.nox_valid;
-    const bool fan_output_valid = fan.present && fan.output_known;
-    const bool fan_manual_speed_valid = fan.present;
-    const uint8_t fan_manual_speed = compute_fan_manual_speed(fan);
-    const uint8_t fan_manual_percent = compute_fan_manual_percent(fan);
-    const uint8_t fan_output_percent = compute_fan_output_percent(fan);
-    const uint32_t fan_timer_remaining = fan_timer_remaining_seconds(fan, millis());
-    char fan_timer_remaining_text[24];
-    format_fan_timer_remaining(fan_timer_remaining_text,
-                               sizeof(fan_timer_remaining_text),
-                               fan_timer_remaining);
-    if (!add_float("co", co_valid, data.co_ppm, 1) ||
-        !add_float("optional_gas", optional_gas_valid, data.optional_gas_ppm, 1) ||
-        !add_nullable_cstr("optional_gas_type", optional_gas_type_text(data)) ||
-        !add_float("nh3", nh3_valid, data.nh3_ppm, 1) ||
-        !add_float("o3", o3_valid, data.optional_gas_ppm, 1) ||
-        !add_float("so2", so2_valid, data.optional_gas_ppm, 1) ||
-        !add_float("no2", no2_valid, data.optional_gas_ppm, 1) ||
-        !add_float("h2s", h2s_valid, data.optional_gas_ppm, 1) ||
-        !add_int("voc_index", voc_publish_valid, data.voc_index) ||
-        !add_int("nox_index", nox_publish_valid, data.nox_index) ||
-        !add_float("hcho", data.hcho_valid, data.hcho, 1) ||
-        !add_float("pm05", data.pm05_valid, data.pm05, 1) ||
-        !add_float("pm1", data.pm1_valid, data.pm1, 1) ||
-        !add_float("pm4", data.pm4_valid, data.pm4, 1) ||
-        !add_float("pm25", data.pm25_valid, data.pm25, 1) ||
-        !add_float("pm10", data.pm10_valid, data.pm10, 1) ||
-        !add_float("pressure", data.pressure_valid, pressure_published, 1) ||
-        !add_float("pressure_absolute", data.pressure_valid, data.pressure, 1) ||
-        !add_float("pressure_delta_3h", data.pressure_delta_3h_valid, pressure_delta_3h_published, 1) ||
-        !add_float("pressure_delta_24h", data.pressure_delta_24h_valid, pressure_delta_24h_published, 1) ||
-        !add_bool("fan_present", fan.present) ||
-        !add_bool("fan_available", fan.available) ||
-        !add_bool("fan_running", fan.running) ||
-        !add_bool("fan_manual_running", fan_manual_running(fan)) ||
-        !add_bool("fan_fault", fan.faulted) ||
-        !add_bool("fan_auto", fan_auto_enabled(fan)) ||
-        !add_bool("fan_stopped", fan_stopped(fan)) ||
-        !add_cstr("fan_mode", fan_mode_text(fan.mode)) ||
-        !add_cstr("fan_control_mode", fan_control_mode_text(fan)) ||
-        !add_cstr("fan_timer", fan_timer_text(fan.selected_timer_s)) ||
-        !add_cstr("fan_timer_remaining", fan_timer_remaining_text) ||
-        !add_int("fan_manual_speed", fan_manual_speed_valid, fan_manual_speed) ||
-        !add_int("fan_manual_percent", fan_manual_speed_valid, fan_manual_percent) ||
-        !add_cstr("fan_status", fan_status_text(fan)) ||
-        !add_int("fan_output_percent", fan_output_valid, fan_output_percent) ||
-        !add_int("fan_output_mv", fan_output_valid, fan.output_mv) ||
-        !add_bool("night_mode", night_mode) ||
-        !add_bool("alert_blink", alert_blink) ||
-        !add_cstr("air_status", air_status_text(aqi)) ||
-        !add_cstr("main_issue", main_issue_text(aqi)) ||
-        !add_bool("backlight", backlight_on) ||
-        !payload.appendf("}")) {
+size_t buildStatePayloadCbor(uint8_t *out,
+                             size_t out_size,
+                             const SensorData &data,
+                             const FanStateSnapshot &fan,
+                             bool gas_warmup,
+                             bool night_mode,
+                             bool alert_blink,
+                             bool backlight_on,
+                             bool pressure_altitude_set,
+                             int16_t pressure_altitude_m) {
+    CborStateSink sink(out, out_size);
+    if (!emit_state_fields(sink,
+                           data,
+                           fan,
+                           gas_warmup,
+                           night_mode,
+                           alert_blink,
+                           backlight_on,
+                           pressure_altitude_set,
+                           pressure_altitude_m)) {
         return 0;
     }
-
-    return payload.size();
+    return sink.size();
 }
 
 size_t buildStatePayload(char *out,
@@ -13,6 +13,78 @@
 
 namespace MqttPayloadBuilder {
 
+// Version of the compact (CBOR) state document published next to the JSON state topic.
+constexpr uint8_t kStateCborVersion = 1;
+
+// State document fields shared by the JSON and CBOR encoders. The numeric value is the CBOR map
+// key, so new fields must only ever be appended before Count.
+enum class StateField : uint8_t {
+    Version = 0,
+    Temp,
+    Humidity,
+    DewPoint,
+    AbsoluteHumidity,
+    Co2,
+    Aqi,
+    Co,
+    OptionalGas,
+    OptionalGasType,
+    Nh3,
+    O3,
+    So2,
+    No2,
+    H2s,
+    VocIndex,
+    NoxIndex,
+    Hcho,
+    Pm05,
+    Pm1,
+    Pm4,
+    Pm25,
+    Pm10,
+    Pressure,
+    PressureAbsolute,
+    PressureDelta3h,
+    PressureDelta24h,
+    FanPresent,
+    FanAvailable,
+    FanRunning,
+    FanManualRunning,
+    FanFault,
+    FanAuto,
+    FanStopped,
+    FanMode,
+    FanControlMode,
+    FanTimer,
+    FanTimerRemaining,
+    FanManualSpeed,
+    FanManualPercent,
+    FanStatus,
+    FanOutputPercent,
+    FanOutputMv,
+    NightMode,
+    AlertBlink,
+    AirStatus,
+    MainIssue,
+    Backlight,
+    SampleTs,
+    Count,
+};
+
+// JSON key for a state field; nullptr for out-of-range values.
+const char *stateFieldKey(StateField field);
+
+// Topic layout under the device base topic (and the Home Assistant discovery prefix). The
+// firmware and the host MQTT harness both build their topics here.
+void buildStateTopic(char *out, size_t out_size, const String &base);
+void buildStateCborTopic(char *out, size_t out_size, const String &base);
+void buildEventsTopic(char *out, size_t out_size, const String &base);
+void buildAvailabilityTopic(char *out, size_t out_size, const String &base);
+void buildNightModeAvailabilityTopic(char *out, size_t out_size, const String &base);
+void buildCommandTopic(char *out, size_t out_size, const String &base, const char *command);
+void buildDiscoveryTopic(char *out, size_t out_size, const char *component,
+                         const String &device_id, const char *object_id);
+
 String buildDiscoveryEntityObjectId(const String &base_topic,
                                     const char *object_id);
 
@@ -96,5 +168,18 @@ size_t buildStatePayload(char *out,
                          bool pressure_altitude_set,
                          int16_t pressure_altitude_m);
 
+// Same fields as buildStatePayload(), encoded as a CBOR map keyed by StateField tags.
+// Returns 0 when the buffer is too small.
+size_t buildStatePayloadCbor(uint8_t *out,
+                             size_t out_size,
+                             const SensorData &data,
+                             const FanStateSnapshot &fan,
+                             bool gas_warmup,
+                             bool night_mode,
+                             bool alert_blink,
+                             bool backlight_on,
+                             bool pressure_altitude_set,
+                             int16_t pressure_altitude_m);
+
 } // namespace MqttPayloadBuilder
 
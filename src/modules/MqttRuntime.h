@@ -8,10 +8,13 @@
 
 #include <stdint.h>
 
+#include "core/MqttPublishScheduler.h"
+
 class MqttRuntime {
 public:
     virtual ~MqttRuntime() = default;
 
     virtual bool isConnected() = 0;
     virtual uint8_t retryStage() const = 0;
+    virtual MqttPublishStats publishStats() const = 0;
 };
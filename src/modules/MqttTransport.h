@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+struct MqttTransportConfig {
+    const char *host = nullptr;
+    uint16_t port = 0;
+    const char *client_id = nullptr;
+    // nullptr username selects anonymous login.
+    const char *username = nullptr;
+    const char *password = nullptr;
+    const char *will_topic = nullptr;
+    const char *will_payload = nullptr;
+    bool will_retain = true;
+    uint16_t keepalive_s = 0;
+    int timeout_ms = 0;
+    size_t buffer_size = 0;
+};
+
+enum class MqttTransportEventType : uint8_t {
+    Connected = 0,
+    Disconnected,
+    Error,
+    Message,
+};
+
+struct MqttTransportEvent {
+    MqttTransportEventType type = MqttTransportEventType::Error;
+    // Error only: broker refusal code, negated socket errno, or -1 when unknown.
+    int error_rc = 0;
+    // Message only: topic is NUL-terminated, payload is the fully reassembled message.
+    const char *topic = nullptr;
+    const uint8_t *payload = nullptr;
+    size_t payload_len = 0;
+};
+
+// Owns one broker client at a time. Events are delivered from the transport's own context
+// (the esp-mqtt task on device), never re-entrantly from start()/publish().
+class MqttTransport {
+public:
+    using EventCallback = void (*)(void *context, const MqttTransportEvent &event);
+
+    virtual ~MqttTransport() = default;
+
+    // Replaces any previous client and begins an asynchronous connect.
+    virtual bool start(const MqttTransportConfig &config, EventCallback callback, void *context) = 0;
+    // Graceful disconnect; a Disconnected event follows.
+    virtual void disconnect() = 0;
+    // Stops the network loop without waiting for the broker.
+    virtual void stop() = 0;
+    // Releases the client; no events are delivered afterwards.
+    virtual void destroy() = 0;
+    virtual bool isActive() const = 0;
+    virtual bool publish(const char *topic, const uint8_t *payload, size_t length, bool retain) = 0;
+    virtual bool subscribe(const char *topic) = 0;
+    virtual const char *name() const = 0;
+};
+
+std::unique_ptr<MqttTransport> createDefaultMqttTransport();
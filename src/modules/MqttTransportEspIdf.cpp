@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "modules/MqttTransport.h"
+
+#include <Arduino.h>
+#include <atomic>
+#include <string.h>
+
+#include <esp_event.h>
+#include <mqtt_client.h>
+
+#include "core/Logger.h"
+
+namespace {
+
+void append_buffer_to_string(String &out, const char *data, size_t length) {
+    if (!data || length == 0) {
+        return;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        out += data[i];
+    }
+}
+
+} // namespace
+
+class EspMqttTransport final : public MqttTransport {
+public:
+    ~EspMqttTransport() override { destroy(); }
+
+    bool start(const MqttTransportConfig &config, EventCallback callback, void *context) override {
+        destroy();
+        callback_ = callback;
+        context_ = context;
+
+        esp_mqtt_client_config_t esp_config = {};
+        esp_config.broker.address.hostname = config.host;
+        esp_config.broker.address.port = config.port;
+        esp_config.broker.address.transport = MQTT_TRANSPORT_OVER_TCP;
+        esp_config.credentials.client_id = config.client_id;
+        if (config.username) {
+            esp_config.credentials.username = config.username;
+            esp_config.credentials.authentication.password = config.password;
+        }
+        esp_config.session.last_will.topic = config.will_topic;
+        esp_config.session.last_will.msg = config.will_payload;
+        esp_config.session.last_will.msg_len =
+            config.will_payload ? static_cast<int>(strlen(config.will_payload)) : 0;
+        esp_config.session.last_will.qos = 0;
+        esp_config.session.last_will.retain = config.will_retain ? 1 : 0;
+        esp_config.session.keepalive = config.keepalive_s;
+        esp_config.network.timeout_ms = config.timeout_ms;
+        esp_config.network.disable_auto_reconnect = true;
+        esp_config.buffer.size = static_cast<int>(config.buffer_size);
+        esp_config.buffer.out_size = static_cast<int>(config.buffer_size);
+
+        client_ = esp_mqtt_client_init(&esp_config);
+        if (!client_) {
+            LOGW("MQTT", "esp_mqtt_client_init failed");
+            return false;
+        }
+        if (esp_mqtt_client_register_event(client_, MQTT_EVENT_ANY,
+                                           &EspMqttTransport::staticEventHandler, this) != ESP_OK) {
+            LOGW("MQTT", "esp_mqtt_client_register_event failed");
+            destroy();
+            return false;
+        }
+        active_client_.store(client_, std::memory_order_release);
+        if (esp_mqtt_client_start(client_) != ESP_OK) {
+            active_client_.store(nullptr, std::memory_order_release);
+            LOGW("MQTT", "esp_mqtt_client_start failed");
+            destroy();
+            return false;
+        }
+        started_ = true;
+        return true;
+    }
+
+    void disconnect() override {
+        if (client_ && started_) {
+            esp_mqtt_client_disconnect(client_);
+        }
+    }
+
+    void stop() override {
+        if (client_ && started_) {
+            esp_mqtt_client_stop(client_);
+        }
+        started_ = false;
+    }
+
+    void destroy() override {
+        active_client_.store(nullptr, std::memory_order_release);
+        if (client_) {
+            esp_mqtt_client_destroy(client_);
+            client_ = nullptr;
+        }
+        started_ = false;
+        event_topic_.clear();
+        event_payload_.clear();
+    }
+
+    bool isActive() const override { return client_ != nullptr; }
+
+    bool publish(const char *topic, const uint8_t *payload, size_t length, bool retain) override {
+        if (!client_) {
+            return false;
+        }
+        return esp_mqtt_client_publish(client_,
+                                       topic,
+                                       payload ? reinterpret_cast<const char *>(payload) : "",
+                                       static_cast<int>(length),
+                                       0,
+                                       retain ? 1 : 0) >= 0;
+    }
+
+    bool subscribe(const char *topic) override {
+        if (!client_) {
+            return false;
+        }
+        return esp_mqtt_client_subscribe(client_, topic, 0) >= 0;
+    }
+
+    const char *name() const override { return "esp-mqtt"; }
+
+private:
+    static void staticEventHandler(void *handler_args,
+                                   esp_event_base_t base,
+                                   int32_t event_id,
+                                   void *event_data) {
+        (void)base;
+        (void)event_id;
+        EspMqttTransport *transport = static_cast<EspMqttTransport *>(handler_args);
+        if (transport) {
+            transport->handleEvent(static_cast<esp_mqtt_event_handle_t>(event_data));
+        }
+    }
+
+    void emit(const MqttTransportEvent &event) {
+        if (callback_) {
+            callback_(context_, event);
+        }
+    }
+
+    void handleEvent(esp_mqtt_event_handle_t event) {
+        if (!event) {
+            return;
+        }
+        const esp_mqtt_client_handle_t active_client =
+            active_client_.load(std::memory_order_acquire);
+        if (!active_client || event->client != active_client) {
+            return;
+        }
+
+        MqttTransportEvent out{};
+        switch (event->event_id) {
+            case MQTT_EVENT_CONNECTED:
+                out.type = MqttTransportEventType::Connected;
+                emit(out);
+                break;
+            case MQTT_EVENT_DISCONNECTED:
+                out.type = MqttTransportEventType::Disconnected;
+                emit(out);
+                break;
+            case MQTT_EVENT_ERROR: {
+                int error_rc = -1;
+                if (event->error_handle) {
+                    const esp_mqtt_error_codes_t *error = event->error_handle;
+                    if (error->error_type == MQTT_ERROR_TYPE_CONNECTION_REFUSED) {
+                        error_rc = static_cast<int>(error->connect_return_code);
+                    } else if (error->error_type == MQTT_ERROR_TYPE_TCP_TRANSPORT &&
+                               error->esp_transport_sock_errno != 0) {
+                        error_rc = -error->esp_transport_sock_errno;
+                    }
+                    Logger::log(Logger::Warn, "MQTT",
+                                "error event type=%d rc=%d tls=%d stack=%d sock=%d",
+                                static_cast<int>(error->error_type),
+                                error_rc,
+                                static_cast<int>(error->esp_tls_last_esp_err),
+                                static_cast<int>(error->esp_tls_stack_err),
+                                static_cast<int>(error->esp_transport_sock_errno));
+                } else {
+                    LOGW("MQTT", "error event without details");
+                }
+                out.type = MqttTransportEventType::Error;
+                out.error_rc = error_rc;
+                emit(out);
+                break;
+            }
+            case MQTT_EVENT_DATA: {
+                // MQTT_EVENT_DATA may arrive in chunks; these buffers belong only to the
+                // esp-mqtt event task.
+                if (event->current_data_offset == 0) {
+                    event_topic_.clear();
+                    event_payload_.clear();
+                    event_topic_.reserve(event->topic_len > 0 ? static_cast<size_t>(event->topic_len) : 0);
+                    event_payload_.reserve(event->total_data_len > 0
+                                               ? static_cast<size_t>(event->total_data_len)
+                                               : static_cast<size_t>(event->data_len));
+                    append_buffer_to_string(event_topic_, event->topic,
+                                            static_cast<size_t>(event->topic_len));
+                }
+                append_buffer_to_string(event_payload_, event->data,
+                                        static_cast<size_t>(event->data_len));
+                const int received_end = event->current_data_offset + event->data_len;
+                if (event->total_data_len <= 0 || received_end >= event->total_data_len) {
+                    out.type = MqttTransportEventType::Message;
+                    out.topic = event_topic_.c_str();
+                    out.payload = reinterpret_cast<const uint8_t *>(event_payload_.c_str());
+                    out.payload_len = event_payload_.length();
+                    emit(out);
+                    event_topic_.clear();
+                    event_payload_.clear();
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    esp_mqtt_client_handle_t client_ = nullptr;
+    std::atomic<esp_mqtt_client_handle_t> active_client_{nullptr};
+    bool started_ = false;
+    EventCallback callback_ = nullptr;
+    void *context_ = nullptr;
+    String event_topic_;
+    String event_payload_;
+};
+
+std::unique_ptr<MqttTransport> createDefaultMqttTransport() {
+    return std::unique_ptr<MqttTransport>(new EspMqttTransport());
+}
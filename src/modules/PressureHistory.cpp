@@ -124,7 +124,7 @@ void PressureHistory::saveIfDue(StorageManager &storage, uint32_t now_ms) {
     blob.index = static_cast<uint16_t>(index_);
     blob.count = static_cast<uint16_t>(count_);
     memcpy(blob.history, history_, sizeof(history_));
-    storage.saveBlobAtomic(StorageManager::kPressurePath, &blob, sizeof(blob));
+    storage.saveBlobAsync(StorageManager::kPressurePath, &blob, sizeof(blob));
 }
 
 void PressureHistory::append(float pressure, SensorData &data) {
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "core/RecordStore.h"
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include "core/Logger.h"
+
+namespace {
+
+constexpr const char *kLogPath = "/records.log";
+constexpr const char *kRewritePath = "/records.log.tmp";
+
+} // namespace
+
+// One LittleFS file. Appends go through a handle that stays open until sync(), so a commit of
+// any number of records costs a single metadata update; reads use a separate handle that is
+// dropped whenever the file changes underneath it.
+class LittleFsRecordMedium final : public RecordMedium {
+public:
+    ~LittleFsRecordMedium() override {
+        closeReader();
+        if (writer_) {
+            writer_.close();
+        }
+    }
+
+    bool open() override {
+        closeReader();
+        if (writer_) {
+            writer_.close();
+        }
+        rewriting_ = false;
+        // A finished rewrite whose swap was interrupted is the newest copy.
+        if (!LittleFS.exists(kLogPath) && LittleFS.exists(kRewritePath)) {
+            LittleFS.rename(kRewritePath, kLogPath);
+        }
+        if (LittleFS.exists(kRewritePath)) {
+            LittleFS.remove(kRewritePath);
+        }
+        size_ = 0;
+        if (LittleFS.exists(kLogPath)) {
+            File file = LittleFS.open(kLogPath, FILE_READ);
+            if (!file) {
+                return false;
+            }
+            size_ = file.size();
+            file.close();
+        }
+        return true;
+    }
+
+    size_t size() const override { return size_; }
+
+    bool read(size_t offset, void *out, size_t len) override {
+        if (offset > size_ || len > size_ - offset) {
+            return false;
+        }
+        if (!reader_) {
+            reader_ = LittleFS.open(kLogPath, FILE_READ);
+            if (!reader_) {
+                return false;
+            }
+        }
+        if (!reader_.seek(offset)) {
+            return false;
+        }
+        return reader_.read(static_cast<uint8_t *>(out), len) == len;
+    }
+
+    bool append(const void *data, size_t len) override {
+        if (!writer_) {
+            writer_ = LittleFS.open(rewriting_ ? kRewritePath : kLogPath,
+                                    rewriting_ ? FILE_WRITE : FILE_APPEND);
+            if (!writer_) {
+                return false;
+            }
+        }
+        const size_t written = writer_.write(static_cast<const uint8_t *>(data), len);
+        if (rewriting_) {
+            rewrite_size_ += written;
+        } else {
+            size_ += written;
+            closeReader();
+        }
+        return written == len;
+    }
+
+    bool sync() override {
+        if (!writer_) {
+            return true;
+        }
+        writer_.flush();
+        writer_.close();
+        return true;
+    }
+
+    bool beginRewrite() override {
+        if (writer_) {
+            writer_.close();
+        }
+        rewriting_ = true;
+        rewrite_size_ = 0;
+        writer_ = LittleFS.open(kRewritePath, FILE_WRITE);
+        if (!writer_) {
+            rewriting_ = false;
+            return false;
+        }
+        return true;
+    }
+
+    bool commitRewrite() override {
+        if (!rewriting_ || !writer_) {
+            return false;
+        }
+        writer_.flush();
+        writer_.close();
+        closeReader();
+        rewriting_ = false;
+        if (!LittleFS.rename(kRewritePath, kLogPath)) {
+            // Some VFS layers refuse to rename over an existing file. open() finishes the swap
+            // if power fails between these two steps.
+            LittleFS.remove(kLogPath);
+            if (!LittleFS.rename(kRewritePath, kLogPath)) {
+                LOGE("Storage", "record log swap failed");
+                return false;
+            }
+        }
+        size_ = rewrite_size_;
+        return true;
+    }
+
+    void abortRewrite() override {
+        if (writer_) {
+            writer_.close();
+        }
+        rewriting_ = false;
+        // After a half-done swap the replacement is the only copy left.
+        if (LittleFS.exists(kLogPath)) {
+            LittleFS.remove(kRewritePath);
+        }
+    }
+
+private:
+    void closeReader() {
+        if (reader_) {
+            reader_.close();
+        }
+    }
+
+    File reader_;
+    File writer_;
+    size_t size_ = 0;
+    size_t rewrite_size_ = 0;
+    bool rewriting_ = false;
+};
+
+std::unique_ptr<RecordMedium> createDefaultRecordMedium() {
+    return std::unique_ptr<RecordMedium>(new LittleFsRecordMedium());
+}
@@ -8,8 +8,10 @@
 
 #include <math.h>
 #include <stdio.h>
+#include "core/BootProfiler.h"
 #include "core/BootState.h"
 #include "core/Logger.h"
+#include "core/SensorTiming.h"
 #include "config/AppConfig.h"
 #include "modules/PressureHistory.h"
 #include "modules/StorageManager.h"
@@ -78,11 +80,11 @@ bool sync_ppm_sensor_fields(bool sensor_present,
     return changed;
 }
 
-bool sync_co_fields(SensorData &data, const Sen0466 &co_sensor) {
+bool sync_co_fields(SensorData &data, const Sen0466 &co_sensor, float co_ppm) {
     return sync_ppm_sensor_fields(co_sensor.isPresent(),
                                   co_sensor.isWarmupActive(),
                                   co_sensor.isDataValid(),
-                                  co_sensor.coPpm(),
+                                  co_ppm,
                                   Config::SEN0466_CO_MIN_PPM,
                                   Config::SEN0466_CO_MAX_PPM,
                                   data.co_sensor_present,
@@ -91,13 +93,15 @@ bool sync_co_fields(SensorData &data, const Sen0466 &co_sensor) {
                                   data.co_ppm);
 }
 
-bool sync_optional_gas_fields(SensorData &data, const DfrOptionalGasSensor &optional_gas) {
+bool sync_optional_gas_fields(SensorData &data,
+                              const DfrOptionalGasSensor &optional_gas,
+                              float optional_gas_ppm) {
     const DfrOptionalGasSensor::OptionalGasType gas_type = optional_gas.optionalGasType();
     const bool sensor_present = optional_gas.isPresent() &&
                                 gas_type != DfrOptionalGasSensor::OptionalGasType::None;
     const bool sensor_warmup = sensor_present && optional_gas.isWarmupActive();
     const bool sensor_valid = sensor_present && optional_gas.isDataValid();
-    const float sensor_ppm = sensor_present ? optional_gas.ppm() : 0.0f;
+    const float sensor_ppm = sensor_present ? optional_gas_ppm : 0.0f;
     const float min_ppm = DfrOptionalGasSensor::minPpmForType(gas_type);
     const float max_ppm = DfrOptionalGasSensor::maxPpmForType(gas_type);
 
@@ -272,7 +276,7 @@ bool apply_sanity_filters(SensorData &data, float hcho_min_ppb, float hcho_max_p
     return changed;
 }
 
-bool invalidate_sen66_fields(SensorData &data) {
+bool invalidate_sen66_fields(SensorData &data, bool keep_temperature) {
     bool changed = false;
 
     auto clear_float = [&](bool &valid, float &value) {
@@ -291,7 +295,9 @@ bool invalidate_sen66_fields(SensorData &data) {
         }
     };
 
-    clear_float(data.temp_valid, data.temperature);
+    if (!keep_temperature) {
+        clear_float(data.temp_valid, data.temperature);
+    }
     clear_float(data.hum_valid, data.humidity);
     clear_float(data.pm05_valid, data.pm05);
     clear_float(data.pm1_valid, data.pm1);
@@ -575,36 +581,77 @@ void log_soft_warnings(const SensorData &data, bool gas_warmup) {
                               nox_band);
 }
 
+float poll_channel(bool valid, float value) {
+    return valid ? value : NAN;
+}
+
+// A new sample is news even when its values repeat: consumers need the fresh stamp.
+void stamp_sample(SensorData &data, SensorSource source, SensorManager::PollResult &result) {
+    SensorTiming::instance().stamp(data, source, SensorTiming::nowUs(), SensorTiming::nowEpoch());
+    result.data_changed = true;
+}
+
+void log_poll_rate_change(const char *name, const AdaptivePollRate &rate) {
+    LOGD("Sensors", "%s poll interval %u ms%s",
+         name,
+         static_cast<unsigned>(rate.intervalMs()),
+         rate.backedOff() ? " (stable)" : "");
+}
+
 } // namespace
 
 void SensorManager::begin(StorageManager &storage, float temp_offset, float hum_offset) {
+    BootProfiler &profiler = BootProfiler::instance();
+    uint8_t stage = profiler.begin("sen66");
     sen66_.begin();
     sen66_.setOffsets(temp_offset, hum_offset);
     sen66_.loadVocState(storage);
+    profiler.end(stage);
     sen66_start_attempts_ = 0;
     sen66_retry_exhausted_logged_ = false;
 
+    // Every pressure chip that answers is started and fused; the first one found stays the
+    // primary for the label and the fusion reference.
+    pressure_sensor_ = PRESSURE_NONE;
+    for (PressureSource &source : pressure_sources_) {
+        source = PressureSource();
+    }
+    stage = profiler.begin("bmp58x");
     bmp580_.begin();
-    if (bmp580_.start()) {
+    const bool bmp580_ok = bmp580_.start();
+    profiler.end(stage);
+    if (bmp580_ok) {
+        pressure_sources_[PRESSURE_BMP58X].active = true;
         pressure_sensor_ = PRESSURE_BMP58X;
         Logger::log(Logger::Info, "Sensors", "%s OK", bmp580_.variantLabel());
-    } else {
-        bmp3xx_.begin();
-        if (bmp3xx_.start()) {
+    }
+    stage = profiler.begin("bmp3xx");
+    bmp3xx_.begin();
+    const bool bmp3xx_ok = bmp3xx_.start();
+    profiler.end(stage);
+    if (bmp3xx_ok) {
+        pressure_sources_[PRESSURE_BMP3XX].active = true;
+        if (pressure_sensor_ == PRESSURE_NONE) {
             pressure_sensor_ = PRESSURE_BMP3XX;
-            Logger::log(Logger::Info, "Sensors", "%s OK", bmp3xx_.variantLabel());
-        } else {
-            dps310_.begin();
-            if (dps310_.start()) {
-                pressure_sensor_ = PRESSURE_DPS310;
-                LOGI("Sensors", "DPS310 OK");
-            } else {
-                pressure_sensor_ = PRESSURE_NONE;
-                LOGW("Sensors", "Pressure sensor not found");
-            }
         }
+        Logger::log(Logger::Info, "Sensors", "%s OK", bmp3xx_.variantLabel());
+    }
+    stage = profiler.begin("dps310");
+    dps310_.begin();
+    const bool dps310_ok = dps310_.start();
+    profiler.end(stage);
+    if (dps310_ok) {
+        pressure_sources_[PRESSURE_DPS310].active = true;
+        if (pressure_sensor_ == PRESSURE_NONE) {
+            pressure_sensor_ = PRESSURE_DPS310;
+        }
+        LOGI("Sensors", "DPS310 OK");
+    }
+    if (pressure_sensor_ == PRESSURE_NONE) {
+        LOGW("Sensors", "Pressure sensor not found");
     }
 
+    stage = profiler.begin("hcho");
     hcho_sensor_type_ = HCHO_SENSOR_NONE;
     const bool hcho_warm_restart = (boot_reset_reason != ESP_RST_POWERON);
     bool sfa30_identified = false;
@@ -654,9 +701,13 @@ void SensorManager::begin(StorageManager &storage, float temp_offset, float hum_
     }
     sfa_warmup_active_last_ = currentHchoWarmupActive();
     sfa_status_last_ = currentHchoStatus();
+    profiler.end(stage);
 
+    stage = profiler.begin("sen0466");
     sen0466_.begin();
-    if (sen0466_.start()) {
+    const bool sen0466_ok = sen0466_.start();
+    profiler.end(stage);
+    if (sen0466_ok) {
         Logger::log(Logger::Info, "Sensors", "%s OK at 0x%02X",
                     sen0466_.label(),
                     static_cast<unsigned>(sen0466_.address()));
@@ -664,8 +715,11 @@ void SensorManager::begin(StorageManager &storage, float temp_offset, float hum_
         Logger::log(Logger::Info, "Sensors", "%s not installed", sen0466_.label());
     }
 
+    stage = profiler.begin("optional_gas");
     optional_gas_.begin();
-    if (optional_gas_.start()) {
+    const bool optional_gas_ok = optional_gas_.start();
+    profiler.end(stage);
+    if (optional_gas_ok) {
         Logger::log(Logger::Info, "Sensors", "%s slot detected at 0x%02X, validating gas type",
                     optional_gas_.label(),
                     static_cast<unsigned>(optional_gas_.address()));
@@ -677,6 +731,9 @@ void SensorManager::begin(StorageManager &storage, float temp_offset, float hum_
     Logger::log(Logger::Info, "Sensors",
                 "SEN66 startup delay %u ms",
                 static_cast<unsigned>(Config::SEN66_STARTUP_GRACE_MS));
+    configurePollRates();
+    configureFilters();
+    configureFusion();
 }
 
 SensorManager::PollResult SensorManager::poll(SensorData &data,
@@ -684,8 +741,22 @@ SensorManager::PollResult SensorManager::poll(SensorData &data,
                                               PressureHistory &pressure_history,
                                               bool co2_asc_enabled) {
     PollResult result;
+    FreshSamples fresh;
+    applyPollRates(millis());
     bool sen66_changed = false;
     sen66_.poll(data, sen66_changed);
+    const uint32_t sen66_data_ms = sen66_.lastDataMs();
+    if (sen66_data_ms != 0 && sen66_data_ms != sen66_sample_ms_) {
+        sen66_sample_ms_ = sen66_data_ms;
+        fresh.sen66 = true;
+        stamp_sample(data, SENSOR_SOURCE_SEN66, result);
+        filterSen66Sample(data);
+        if (data.temp_valid) {
+            temperature_fusion_.update(sen66_temp_source_, data.temperature, sen66_data_ms);
+        } else {
+            temperature_fusion_.drop(sen66_temp_source_);
+        }
+    }
     if (sen66_changed) {
         result.data_changed = true;
     }
@@ -713,88 +784,96 @@ SensorManager::PollResult SensorManager::poll(SensorData &data,
         result.data_changed = true;
     }
     float hcho_ppb = 0.0f;
-    if (currentHchoTakeNewData(hcho_ppb)) {
-        data.hcho = hcho_ppb;
+    fresh.hcho = currentHchoTakeNewData(hcho_ppb);
+    if (fresh.hcho) {
+        data.hcho = filterSample(SensorFilters::METRIC_HCHO, !sfa_warmup_now, hcho_ppb);
         data.hcho_valid = !sfa_warmup_now;
-        result.data_changed = true;
+        stamp_sample(data, SENSOR_SOURCE_HCHO, result);
     }
 
     sen0466_.poll();
     optional_gas_.poll();
+    const uint32_t co_last_ms = sen0466_.lastDataMs();
+    if (co_last_ms != 0 && co_last_ms != co_sample_ms_) {
+        co_sample_ms_ = co_last_ms;
+        fresh.co = true;
+        stamp_sample(data, SENSOR_SOURCE_CO, result);
+    }
+    const uint32_t optional_gas_last_ms = optional_gas_.lastDataMs();
+    if (optional_gas_last_ms != 0 && optional_gas_last_ms != optional_gas_sample_ms_) {
+        optional_gas_sample_ms_ = optional_gas_last_ms;
+        fresh.optional_gas = true;
+        stamp_sample(data, SENSOR_SOURCE_OPTIONAL_GAS, result);
+    }
+
+    const uint32_t fusion_now = millis();
+    if (feedPressureChip(bmp580_, PRESSURE_BMP58X, Config::DPS310_PRESSURE_MIN_HPA,
+                         Config::DPS310_PRESSURE_MAX_HPA, fusion_now)) {
+        fresh.pressure = true;
+    }
+    if (feedPressureChip(bmp3xx_, PRESSURE_BMP3XX, Config::BMP3XX_PRESSURE_MIN_HPA,
+                         Config::BMP3XX_PRESSURE_MAX_HPA, fusion_now)) {
+        fresh.pressure = true;
+    }
+    if (feedPressureChip(dps310_, PRESSURE_DPS310, Config::DPS310_PRESSURE_MIN_HPA,
+                         Config::DPS310_PRESSURE_MAX_HPA, fusion_now)) {
+        fresh.pressure = true;
+    }
+    float rtc_temp_c = 0.0f;
+    uint32_t rtc_temp_ms = 0;
+    if (SensorFusion::instance().takeRtcTemperature(rtc_temp_c, rtc_temp_ms)) {
+        temperature_fusion_.update(rtc_temp_source_, rtc_temp_c, rtc_temp_ms);
+    }
 
     float pressure_hpa = 0.0f;
-    float temperature_c = 0.0f;
-    bool pressure_valid = false;
-    bool pressure_new = false;
-    float pressure_min_hpa = Config::DPS310_PRESSURE_MIN_HPA;
-    float pressure_max_hpa = Config::DPS310_PRESSURE_MAX_HPA;
-    if (pressure_sensor_ == PRESSURE_BMP58X) {
-        bmp580_.poll();
-        if (bmp580_.takeNewData(pressure_hpa, temperature_c)) {
-            pressure_new = true;
-        }
-        pressure_valid = bmp580_.isPressureValid();
-    } else if (pressure_sensor_ == PRESSURE_BMP3XX) {
-        bmp3xx_.poll();
-        if (bmp3xx_.takeNewData(pressure_hpa, temperature_c)) {
-            pressure_new = true;
-        }
-        pressure_valid = bmp3xx_.isPressureValid();
-        pressure_min_hpa = Config::BMP3XX_PRESSURE_MIN_HPA;
-        pressure_max_hpa = Config::BMP3XX_PRESSURE_MAX_HPA;
-    } else if (pressure_sensor_ == PRESSURE_DPS310) {
-        dps310_.poll();
-        if (dps310_.takeNewData(pressure_hpa, temperature_c)) {
-            pressure_new = true;
-        }
-        pressure_valid = dps310_.isPressureValid();
-    }
-    if (pressure_new) {
-        if (!isfinite(pressure_hpa) ||
-            pressure_hpa < pressure_min_hpa ||
-            pressure_hpa > pressure_max_hpa) {
+    const bool pressure_fused = pressure_fusion_.fuse(fusion_now, pressure_hpa);
+    if (fresh.pressure && pressure_fused) {
+        pressure_hpa = filterSample(SensorFilters::METRIC_PRESSURE, true, pressure_hpa);
+        data.pressure = pressure_hpa;
+        data.pressure_valid = true;
+        pressure_history.update(pressure_hpa, data, storage);
+        sen66_.updatePressure(pressure_hpa);
+        stamp_sample(data, SENSOR_SOURCE_PRESSURE, result);
+    } else if (!pressure_fused && hasPressureChip() && (data.pressure_valid || fresh.pressure)) {
+        // Every chip is stale, out of range or disowned by its driver.
+        filterSample(SensorFilters::METRIC_PRESSURE, false, data.pressure);
+        if (fresh.pressure) {
             data.pressure = 0.0f;
-            data.pressure_valid = false;
-            data.pressure_delta_3h_valid = false;
-            data.pressure_delta_24h_valid = false;
-        } else {
-            data.pressure = pressure_hpa;
-            data.pressure_valid = true;
-            pressure_history.update(pressure_hpa, data, storage);
-            sen66_.updatePressure(pressure_hpa);
         }
-        result.data_changed = true;
-    }
-
-    if (data.pressure_valid && pressure_sensor_ != PRESSURE_NONE && !pressure_valid) {
         data.pressure_valid = false;
         data.pressure_delta_3h_valid = false;
         data.pressure_delta_24h_valid = false;
         result.data_changed = true;
     }
+    SensorFusion::instance().publish(SensorFusion::QUANTITY_PRESSURE, pressure_fusion_,
+                                     data.pressure_valid, data.pressure, fusion_now);
 
     uint32_t now = millis();
     if (!sen66_.isOk() &&
         !sen66_.isBusy() &&
         sen66_start_attempts_ < Config::SEN66_MAX_START_ATTEMPTS &&
         now >= sen66_.retryAtMs()) {
-        if (sen66_.start(co2_asc_enabled)) {
-            LOGI("Sensors", "SEN66 OK");
-            sen66_start_attempts_ = 0;
-            sen66_retry_exhausted_logged_ = false;
-        } else {
-            if (sen66_start_attempts_ < UINT8_MAX) {
-                ++sen66_start_attempts_;
-            }
-            LOGW("Sensors", "SEN66 not found (%u/%u)",
-                 static_cast<unsigned>(sen66_start_attempts_),
-                 static_cast<unsigned>(Config::SEN66_MAX_START_ATTEMPTS));
-            if (sen66_start_attempts_ < Config::SEN66_MAX_START_ATTEMPTS) {
-                sen66_.scheduleRetry(Config::SEN66_START_RETRY_MS);
-            } else if (!sen66_retry_exhausted_logged_) {
-                LOGW("Sensors", "SEN66 start attempts exhausted, stop probing until reboot");
-                sen66_retry_exhausted_logged_ = true;
-            }
+        // The start sequence runs on the I2C scheduler through sen66_.poll(); its outcome is
+        // picked up below on a later pass.
+        sen66_.beginStart(co2_asc_enabled);
+    }
+    const Sen66::StartResult sen66_start = sen66_.takeStartResult();
+    if (sen66_start == Sen66::StartResult::Started) {
+        LOGI("Sensors", "SEN66 OK");
+        sen66_start_attempts_ = 0;
+        sen66_retry_exhausted_logged_ = false;
+    } else if (sen66_start == Sen66::StartResult::Failed) {
+        if (sen66_start_attempts_ < UINT8_MAX) {
+            ++sen66_start_attempts_;
+        }
+        LOGW("Sensors", "SEN66 not found (%u/%u)",
+             static_cast<unsigned>(sen66_start_attempts_),
+             static_cast<unsigned>(Config::SEN66_MAX_START_ATTEMPTS));
+        if (sen66_start_attempts_ < Config::SEN66_MAX_START_ATTEMPTS) {
+            sen66_.scheduleRetry(Config::SEN66_START_RETRY_MS);
+        } else if (!sen66_retry_exhausted_logged_) {
+            LOGW("Sensors", "SEN66 start attempts exhausted, stop probing until reboot");
+            sen66_retry_exhausted_logged_ = true;
         }
     }
 
@@ -804,19 +883,37 @@ SensorManager::PollResult SensorManager::poll(SensorData &data,
         result.warmup_changed = true;
     }
 
-    if (sync_co_fields(data, sen0466_)) {
+    const float co_ppm = filteredValue(SensorFilters::METRIC_CO,
+                                       fresh.co,
+                                       sen0466_.isDataValid(),
+                                       sen0466_.coPpm());
+    if (sync_co_fields(data, sen0466_, co_ppm)) {
         result.data_changed = true;
     }
-    if (sync_optional_gas_fields(data, optional_gas_)) {
+    const float optional_gas_ppm = filteredValue(SensorFilters::METRIC_OPTIONAL_GAS,
+                                                 fresh.optional_gas,
+                                                 optional_gas_.isDataValid(),
+                                                 optional_gas_.ppm());
+    if (sync_optional_gas_fields(data, optional_gas_, optional_gas_ppm)) {
         result.data_changed = true;
     }
 
+    // Temperature keeps flowing from the other sources while the SEN66 is stale.
+    float fused_temp_c = 0.0f;
+    const bool temp_fused = temperature_fusion_.fuse(now, fused_temp_c);
     uint32_t sen66_last_ms = sen66_.lastDataMs();
     if (sen66_last_ms != 0 && (now - sen66_last_ms > Config::SEN66_STALE_MS)) {
-        if (invalidate_sen66_fields(data)) {
+        if (invalidate_sen66_fields(data, temp_fused)) {
             result.data_changed = true;
         }
     }
+    if (temp_fused && (!data.temp_valid || fabsf(data.temperature - fused_temp_c) > 0.005f)) {
+        data.temperature = fused_temp_c;
+        data.temp_valid = true;
+        result.data_changed = true;
+    }
+    SensorFusion::instance().publish(SensorFusion::QUANTITY_TEMPERATURE, temperature_fusion_,
+                                     temp_fused, fused_temp_c, now);
     uint32_t sfa_last_ms = currentHchoLastDataMs();
     if (data.hcho_valid && sfa_last_ms != 0 &&
         (now - sfa_last_ms > Config::SFA3X_STALE_MS)) {
@@ -829,19 +926,266 @@ SensorManager::PollResult SensorManager::poll(SensorData &data,
         result.data_changed = true;
     }
     log_soft_warnings(data, warmup_now);
+    observePollRates(data, fresh);
 
     return result;
 }
 
-bool SensorManager::isPressureOk() const {
+bool SensorManager::deviceReset() {
+    resetSen66Filters();
+    return sen66_.deviceReset();
+}
+
+void SensorManager::configureFilters() {
+    for (size_t i = 0; i < SensorFilters::METRIC_COUNT; ++i) {
+        const SensorFilters::Metric metric = static_cast<SensorFilters::Metric>(i);
+        filters_[i].configure(SensorFilters::defaultConfig(metric));
+        SensorFilters::instance().publish(metric, false, 0.0f, 0.0f);
+    }
+}
+
+float SensorManager::filterSample(SensorFilters::Metric metric, bool valid, float raw) {
+    MetricFilter &filter = filters_[metric];
+    if (!valid || !isfinite(raw)) {
+        filter.reset();
+        SensorFilters::instance().publish(metric, false, raw, raw);
+        return raw;
+    }
+    const float value = filter.apply(raw);
+    SensorFilters::instance().publish(metric, true, raw, value);
+    return value;
+}
+
+float SensorManager::filteredValue(SensorFilters::Metric metric, bool fresh, bool valid, float raw) {
+    if (fresh || !valid) {
+        return filterSample(metric, valid, raw);
+    }
+    // Between samples the driver still reports the last raw value; keep serving the
+    // filtered one so the field does not flip back and forth on every pass.
+    const MetricFilter &filter = filters_[metric];
+    return filter.primed() ? filter.value() : raw;
+}
+
+void SensorManager::filterSen66Sample(SensorData &data) {
+    data.pm05 = filterSample(SensorFilters::METRIC_PM05, data.pm05_valid, data.pm05);
+    data.pm1 = filterSample(SensorFilters::METRIC_PM1, data.pm1_valid, data.pm1);
+    data.pm25 = filterSample(SensorFilters::METRIC_PM25, data.pm25_valid, data.pm25);
+    data.pm4 = filterSample(SensorFilters::METRIC_PM4, data.pm4_valid, data.pm4);
+    data.pm10 = filterSample(SensorFilters::METRIC_PM10, data.pm10_valid, data.pm10);
+    data.temperature =
+        filterSample(SensorFilters::METRIC_TEMPERATURE, data.temp_valid, data.temperature);
+    data.humidity = filterSample(SensorFilters::METRIC_HUMIDITY, data.hum_valid, data.humidity);
+    data.co2 = static_cast<int>(lroundf(filterSample(SensorFilters::METRIC_CO2,
+                                                     data.co2_valid,
+                                                     static_cast<float>(data.co2))));
+    data.voc_index = static_cast<int>(lroundf(filterSample(SensorFilters::METRIC_VOC,
+                                                           data.voc_valid,
+                                                           static_cast<float>(data.voc_index))));
+    data.nox_index = static_cast<int>(lroundf(filterSample(SensorFilters::METRIC_NOX,
+                                                           data.nox_valid,
+                                                           static_cast<float>(data.nox_index))));
+}
+
+void SensorManager::resetSen66Filters() {
+    static const SensorFilters::Metric kSen66Metrics[] = {
+        SensorFilters::METRIC_CO2,
+        SensorFilters::METRIC_PM05,
+        SensorFilters::METRIC_PM1,
+        SensorFilters::METRIC_PM25,
+        SensorFilters::METRIC_PM4,
+        SensorFilters::METRIC_PM10,
+        SensorFilters::METRIC_TEMPERATURE,
+        SensorFilters::METRIC_HUMIDITY,
+        SensorFilters::METRIC_VOC,
+        SensorFilters::METRIC_NOX,
+    };
+    for (SensorFilters::Metric metric : kSen66Metrics) {
+        filters_[metric].reset();
+    }
+}
+
+void SensorManager::configureFusion() {
+    struct ChipSource {
+        PressureSensorType type;
+        const char *name;
+        float sigma_hpa;
+        uint32_t stale_ms;
+    };
+    static const ChipSource kChips[] = {
+        {PRESSURE_BMP58X, "bmp58x", Config::FUSION_BMP580_SIGMA_HPA, Config::BMP580_STALE_MS},
+        {PRESSURE_BMP3XX, "bmp3xx", Config::FUSION_BMP3XX_SIGMA_HPA, Config::BMP3XX_STALE_MS},
+        {PRESSURE_DPS310, "dps310", Config::FUSION_DPS310_SIGMA_HPA, Config::DPS310_STALE_MS},
+    };
+
+    temperature_fusion_.reset();
+    pressure_fusion_.reset();
+    sen66_temp_source_ = temperature_fusion_.addSource(
+        {"sen66", Config::FUSION_SEN66_TEMP_SIGMA_C, Config::SEN66_STALE_MS, false});
+    for (const ChipSource &chip : kChips) {
+        PressureSource &source = pressure_sources_[chip.type];
+        source.misses_seen = 0;
+        if (!source.active) {
+            continue;
+        }
+        // Probe order puts the primary chip first, which makes it the pressure reference.
+        source.pressure =
+            pressure_fusion_.addSource({chip.name, chip.sigma_hpa, chip.stale_ms, false});
+        source.temperature = temperature_fusion_.addSource(
+            {chip.name, Config::FUSION_PRESSURE_CHIP_TEMP_SIGMA_C, chip.stale_ms, true});
+    }
+    rtc_temp_source_ = temperature_fusion_.addSource(
+        {"ds3231", Config::FUSION_RTC_TEMP_SIGMA_C, Config::FUSION_RTC_TEMP_STALE_MS, true});
+}
+
+template <typename Driver>
+bool SensorManager::feedPressureChip(Driver &driver, PressureSensorType type,
+                                     float min_hpa, float max_hpa, uint32_t now_ms) {
+    PressureSource &source = pressure_sources_[type];
+    if (!source.active) {
+        return false;
+    }
+    driver.poll();
+
+    // Reads the driver missed since the last pass count against the chip's weight.
+    const uint16_t misses = driver.health().missCount();
+    if (misses != source.misses_seen) {
+        const uint16_t new_misses = static_cast<uint16_t>(misses - source.misses_seen);
+        pressure_fusion_.noteFaults(source.pressure, new_misses);
+        temperature_fusion_.noteFaults(source.temperature, new_misses);
+        source.misses_seen = misses;
+    }
+
+    float pressure_hpa = 0.0f;
+    float temperature_c = 0.0f;
+    const bool fresh = driver.takeNewData(pressure_hpa, temperature_c);
+    if (fresh) {
+        if (!isfinite(pressure_hpa) || pressure_hpa < min_hpa || pressure_hpa > max_hpa) {
+            pressure_fusion_.noteFaults(source.pressure);
+            pressure_fusion_.drop(source.pressure);
+        } else {
+            pressure_fusion_.update(source.pressure, pressure_hpa, now_ms);
+        }
+        temperature_fusion_.update(source.temperature, temperature_c, now_ms);
+    }
+    if (!driver.isPressureValid()) {
+        pressure_fusion_.drop(source.pressure);
+        temperature_fusion_.drop(source.temperature);
+    }
+    return fresh;
+}
+
+void SensorManager::configurePollRates() {
+    sen66_rate_.configure(Config::SEN66_POLL_MS, Config::SEN66_POLL_SLOW_MS);
+    if (hcho_sensor_type_ == HCHO_SENSOR_SFA30) {
+        hcho_rate_.configure(Config::SFA3X_POLL_MS, Config::SFA3X_POLL_SLOW_MS);
+    } else {
+        hcho_rate_.configure(Config::SFA40_POLL_MS, Config::SFA40_POLL_SLOW_MS);
+    }
+    co_rate_.configure(Config::DFR_GAS_POLL_MS, Config::DFR_GAS_POLL_SLOW_MS);
+    optional_gas_rate_.configure(Config::DFR_GAS_POLL_MS, Config::DFR_GAS_POLL_SLOW_MS);
+    uint32_t pressure_fast_ms = Config::DPS310_POLL_MS;
     if (pressure_sensor_ == PRESSURE_BMP58X) {
-        return bmp580_.isOk();
+        pressure_fast_ms = Config::BMP580_POLL_MS;
+    } else if (pressure_sensor_ == PRESSURE_BMP3XX) {
+        pressure_fast_ms = Config::BMP3XX_POLL_MS;
     }
-    if (pressure_sensor_ == PRESSURE_BMP3XX) {
-        return bmp3xx_.isOk();
+    pressure_rate_.configure(pressure_fast_ms, Config::PRESSURE_POLL_SLOW_MS);
+    sen66_sample_ms_ = 0;
+    co_sample_ms_ = 0;
+    optional_gas_sample_ms_ = 0;
+}
+
+void SensorManager::applyPollRates(uint32_t now_ms) {
+    // Someone is watching or acting on live values: hold every sensor at its fast rate.
+    if (SensorPollRates::instance().demand(now_ms) != 0) {
+        sen66_rate_.boost();
+        hcho_rate_.boost();
+        co_rate_.boost();
+        optional_gas_rate_.boost();
+        pressure_rate_.boost();
+    }
+    sen66_.setPollIntervalMs(sen66_rate_.intervalMs());
+    sfa40_.setPollIntervalMs(hcho_rate_.intervalMs());
+    sfa30_.setPollIntervalMs(hcho_rate_.intervalMs());
+    sen0466_.setPollIntervalMs(co_rate_.intervalMs());
+    optional_gas_.setPollIntervalMs(optional_gas_rate_.intervalMs());
+    bmp580_.setPollIntervalMs(pressure_rate_.intervalMs());
+    bmp3xx_.setPollIntervalMs(pressure_rate_.intervalMs());
+    dps310_.setPollIntervalMs(pressure_rate_.intervalMs());
+}
+
+void SensorManager::observePollRates(const SensorData &data, const FreshSamples &fresh) {
+    if (fresh.sen66) {
+        const float values[] = {
+            poll_channel(data.pm25_valid, data.pm25),
+            poll_channel(data.co2_valid, static_cast<float>(data.co2)),
+            poll_channel(data.voc_valid, static_cast<float>(data.voc_index)),
+            poll_channel(data.nox_valid, static_cast<float>(data.nox_index)),
+            poll_channel(data.temp_valid, data.temperature),
+            poll_channel(data.hum_valid, data.humidity),
+        };
+        const float bands[] = {
+            Config::ADAPTIVE_POLL_PM_BAND_UGM3,
+            Config::ADAPTIVE_POLL_CO2_BAND_PPM,
+            Config::ADAPTIVE_POLL_INDEX_BAND,
+            Config::ADAPTIVE_POLL_INDEX_BAND,
+            Config::ADAPTIVE_POLL_TEMP_BAND_C,
+            Config::ADAPTIVE_POLL_HUM_BAND,
+        };
+        static_assert(sizeof(values) / sizeof(values[0]) <= AdaptivePollRate::kMaxChannels,
+                      "SEN66 poll channels exceed AdaptivePollRate capacity");
+        if (sen66_rate_.observe(values, bands, sizeof(values) / sizeof(values[0]))) {
+            log_poll_rate_change("SEN66", sen66_rate_);
+        }
     }
-    if (pressure_sensor_ == PRESSURE_DPS310) {
-        return dps310_.isOk();
+    if (fresh.hcho) {
+        const float value = poll_channel(data.hcho_valid, data.hcho);
+        const float band = Config::ADAPTIVE_POLL_HCHO_BAND_PPB;
+        if (hcho_rate_.observe(&value, &band, 1)) {
+            log_poll_rate_change(hchoSensorLabel(), hcho_rate_);
+        }
+    }
+    if (fresh.co) {
+        const float value = poll_channel(data.co_valid, data.co_ppm);
+        const float band = Config::ADAPTIVE_POLL_GAS_BAND_PPM;
+        if (co_rate_.observe(&value, &band, 1)) {
+            log_poll_rate_change(sen0466_.label(), co_rate_);
+        }
+    }
+    if (fresh.optional_gas) {
+        const float value = poll_channel(data.optional_gas_valid, data.optional_gas_ppm);
+        const float band = Config::ADAPTIVE_POLL_GAS_BAND_PPM;
+        if (optional_gas_rate_.observe(&value, &band, 1)) {
+            log_poll_rate_change(optional_gas_.label(), optional_gas_rate_);
+        }
+    }
+    if (fresh.pressure) {
+        const float value = poll_channel(data.pressure_valid, data.pressure);
+        const float band = Config::ADAPTIVE_POLL_PRESSURE_BAND_HPA;
+        if (pressure_rate_.observe(&value, &band, 1)) {
+            log_poll_rate_change("Pressure", pressure_rate_);
+        }
+    }
+
+    SensorPollRates &rates = SensorPollRates::instance();
+    rates.publish(SensorPollRates::SENSOR_SEN66, sen66_.isOk(), sen66_rate_);
+    rates.publish(SensorPollRates::SENSOR_HCHO, hcho_sensor_type_ != HCHO_SENSOR_NONE, hcho_rate_);
+    rates.publish(SensorPollRates::SENSOR_CO, sen0466_.isPresent(), co_rate_);
+    rates.publish(SensorPollRates::SENSOR_OPTIONAL_GAS, optional_gas_.isPresent(), optional_gas_rate_);
+    rates.publish(SensorPollRates::SENSOR_PRESSURE, pressure_sensor_ != PRESSURE_NONE, pressure_rate_);
+}
+
+bool SensorManager::isPressureOk() const {
+    return (pressure_sources_[PRESSURE_BMP58X].active && bmp580_.isOk()) ||
+           (pressure_sources_[PRESSURE_BMP3XX].active && bmp3xx_.isOk()) ||
+           (pressure_sources_[PRESSURE_DPS310].active && dps310_.isOk());
+}
+
+bool SensorManager::hasPressureChip() const {
+    for (const PressureSource &source : pressure_sources_) {
+        if (source.active) {
+            return true;
+        }
     }
     return false;
 }
@@ -8,6 +8,9 @@
 
 #include <Arduino.h>
 #include "config/AppData.h"
+#include "core/SensorFilter.h"
+#include "core/SensorFusion.h"
+#include "core/SensorPollRate.h"
 #include "drivers/Bmp3xx.h"
 #include "drivers/Bmp580.h"
 #include "drivers/DfrOptionalGasSensor.h"
@@ -76,14 +79,14 @@ public:
     PressureSensorType pressureSensorType() const { return pressure_sensor_; }
     const char *pressureSensorLabel() const;
     const char *hchoSensorLabel() const;
-    bool deviceReset() { return sen66_.deviceReset(); }
+    bool deviceReset();
     void scheduleRetry(uint32_t delay_ms) {
         sen66_start_attempts_ = 0;
         sen66_retry_exhausted_logged_ = false;
         sen66_.scheduleRetry(delay_ms);
     }
     uint32_t retryAtMs() const { return sen66_.retryAtMs(); }
-    bool start(bool asc_enabled) { return sen66_.start(asc_enabled); }
+    bool beginStart(bool asc_enabled) { return sen66_.beginStart(asc_enabled); }
     bool isWarmupActive() const { return sen66_.isWarmupActive(); }
     uint32_t lastDataMs() const { return sen66_.lastDataMs(); }
     bool setAscEnabled(bool enabled) { return sen66_.setAscEnabled(enabled); }
@@ -95,6 +98,25 @@ public:
     void clearVocState(StorageManager &storage);
 
 private:
+    static constexpr uint8_t PRESSURE_SENSOR_SLOTS = PRESSURE_BMP3XX + 1;
+
+    // A pressure chip that started in begin() and its rows in the fusion tables.
+    struct PressureSource {
+        bool active = false;
+        size_t pressure = FusedQuantity::kMaxSources;
+        size_t temperature = FusedQuantity::kMaxSources;
+        uint16_t misses_seen = 0;
+    };
+
+    // Which sensors delivered a new sample during this poll.
+    struct FreshSamples {
+        bool sen66 = false;
+        bool hcho = false;
+        bool co = false;
+        bool optional_gas = false;
+        bool pressure = false;
+    };
+
     SfaStatus currentHchoStatus() const;
     bool currentHchoWarmupActive() const;
     bool currentHchoTakeNewData(float &hcho_ppb);
@@ -102,6 +124,19 @@ private:
     uint32_t currentHchoLastDataMs() const;
     float currentHchoMinPpb() const;
     float currentHchoMaxPpb() const;
+    void configurePollRates();
+    void applyPollRates(uint32_t now_ms);
+    void observePollRates(const SensorData &data, const FreshSamples &fresh);
+    void configureFilters();
+    float filterSample(SensorFilters::Metric metric, bool valid, float raw);
+    float filteredValue(SensorFilters::Metric metric, bool fresh, bool valid, float raw);
+    void filterSen66Sample(SensorData &data);
+    void resetSen66Filters();
+    void configureFusion();
+    template <typename Driver>
+    bool feedPressureChip(Driver &driver, PressureSensorType type,
+                          float min_hpa, float max_hpa, uint32_t now_ms);
+    bool hasPressureChip() const;
 
     Bmp3xx bmp3xx_;
     Bmp580 bmp580_;
@@ -118,4 +153,18 @@ private:
     uint8_t sen66_start_attempts_ = 0;
     bool sen66_retry_exhausted_logged_ = false;
     PressureSensorType pressure_sensor_ = PRESSURE_NONE;
+    AdaptivePollRate sen66_rate_;
+    AdaptivePollRate hcho_rate_;
+    AdaptivePollRate co_rate_;
+    AdaptivePollRate optional_gas_rate_;
+    AdaptivePollRate pressure_rate_;
+    uint32_t sen66_sample_ms_ = 0;
+    uint32_t co_sample_ms_ = 0;
+    uint32_t optional_gas_sample_ms_ = 0;
+    MetricFilter filters_[SensorFilters::METRIC_COUNT];
+    PressureSource pressure_sources_[PRESSURE_SENSOR_SLOTS];
+    FusedQuantity temperature_fusion_;
+    FusedQuantity pressure_fusion_;
+    size_t sen66_temp_source_ = FusedQuantity::kMaxSources;
+    size_t rtc_temp_source_ = FusedQuantity::kMaxSources;
 };
@@ -6,16 +6,16 @@
 
 #include "StorageManager.h"
 
+#include <new>
 #include <string.h>
+#include "core/ConfigSnapshot.h"
 #include "core/Logger.h"
+#include "core/StorageWriter.h"
 
 #ifndef UNIT_TEST
 #include <LittleFS.h>
 #include <ArduinoJson.h>
-#else
-#include <map>
-#include <string>
-#include <vector>
+#include "core/BootProfiler.h"
 #endif
 
 namespace {
@@ -33,64 +33,24 @@ int16_t clampPressureAltitudeM(int value) {
 }
 
 #ifdef UNIT_TEST
-std::map<std::string, std::vector<uint8_t>> g_blob_store;
 bool g_force_save_failure = false;
 #endif
 
 #ifndef UNIT_TEST
-bool replaceFileAtomic(const char *tmp_path, const char *final_path) {
-    String backup = String(final_path) + ".bak";
-    if (LittleFS.exists(backup)) {
-        LittleFS.remove(backup);
-    }
-    if (LittleFS.exists(final_path)) {
-        if (!LittleFS.rename(final_path, backup)) {
-            LittleFS.remove(final_path);
-        }
-    }
-    if (!LittleFS.rename(tmp_path, final_path)) {
-        if (LittleFS.exists(backup)) {
-            LittleFS.rename(backup, final_path);
-        }
-        LittleFS.remove(tmp_path);
-        return false;
-    }
-    if (LittleFS.exists(backup)) {
-        LittleFS.remove(backup);
-    }
-    return true;
-}
-
-bool copyFileAtomic(const char *src_path, const char *dst_path) {
-    if (!src_path || !dst_path) {
-        return false;
-    }
-    File in = LittleFS.open(src_path, FILE_READ);
-    if (!in) {
-        return false;
-    }
-    String tmp = String(dst_path) + ".tmp";
-    File out = LittleFS.open(tmp, FILE_WRITE);
-    if (!out) {
-        in.close();
-        return false;
-    }
-    uint8_t buffer[512];
-    while (in.available()) {
-        size_t read = in.read(buffer, sizeof(buffer));
-        if (read == 0) {
-            break;
-        }
-        if (out.write(buffer, read) != read) {
-            in.close();
-            out.close();
-            LittleFS.remove(tmp);
-            return false;
-        }
-    }
-    in.close();
-    out.close();
-    return replaceFileAtomic(tmp.c_str(), dst_path);
+// Files written by firmware that predates the record log; imported once, then deleted.
+const char *const kLegacyPaths[] = {
+    StorageManager::kConfigPath,
+    StorageManager::kLastGoodPath,
+    StorageManager::kVocStatePath,
+    StorageManager::kPressurePath,
+    StorageManager::kChartsPath,
+    StorageManager::kDacAutoPath,
+};
+
+void removeLegacyFile(const char *path) {
+    LittleFS.remove(path);
+    LittleFS.remove(String(path) + ".tmp");
+    LittleFS.remove(String(path) + ".bak");
 }
 
 void readString(const ArduinoJson::JsonObject &obj, const char *key, String &out) {
@@ -120,9 +80,10 @@ void StorageManager::begin(BootAction action) {
     lkg_start_ms_ = 0;
     mounted_ = false;
     config_loaded_ = false;
+    medium_ = createDefaultRecordMedium();
 #ifdef UNIT_TEST
     g_force_save_failure = false;
-    g_blob_store.clear();
+    records_.begin(*medium_);
     if (action == BootAction::SafeRollback) {
         restoreLastGood();
     } else if (action == BootAction::SafeFactoryReset) {
@@ -131,11 +92,18 @@ void StorageManager::begin(BootAction action) {
     mounted_ = true;
     config_loaded_ = true;
 #else
-    if (!LittleFS.begin(true, "/littlefs", 10, "littlefs")) {
-        LOGE("Storage", "LittleFS mount failed");
-        return;
+    {
+        BootProfiler::Scope stage("fs_mount");
+        if (!LittleFS.begin(true, "/littlefs", 10, "littlefs")) {
+            LOGE("Storage", "LittleFS mount failed");
+            return;
+        }
+        if (!records_.begin(*medium_)) {
+            return;
+        }
     }
     mounted_ = true;
+    migrateLegacyFiles();
     if (action == BootAction::SafeRollback) {
         if (!restoreLastGood()) {
             LOGW("Storage", "last good config missing, factory reset");
@@ -147,6 +115,7 @@ void StorageManager::begin(BootAction action) {
         LOGW("Storage", "factory reset requested");
         clearAll();
     }
+    BootProfiler::Scope stage("config_load");
     bool loaded = loadConfig();
     if (loaded) {
         lkg_pending_ = true;
@@ -155,6 +124,15 @@ void StorageManager::begin(BootAction action) {
 #endif
 }
 
+bool StorageManager::startWriter() {
+    if (!mounted_) {
+        return false;
+    }
+    StorageWriter &writer = StorageWriter::instance();
+    writer.setIdleHook(&StorageManager::onWriterIdle, this);
+    return writer.start(&StorageManager::writeBlobNow, this);
+}
+
 const Config::StoredConfig &StorageManager::config() const {
     return config_;
 }
@@ -176,6 +154,17 @@ void StorageManager::requestSave() {
 }
 
 void StorageManager::poll(uint32_t now_ms) {
+    if (!StorageWriter::instance().isRunning()) {
+        compactIfNeeded();
+    }
+    const uint8_t write_state = config_write_state_.exchange(CONFIG_WRITE_IDLE);
+    if (write_state == CONFIG_WRITE_OK) {
+        noteConfigSaved(now_ms);
+    } else if (write_state == CONFIG_WRITE_FAILED) {
+        LOGW("Storage", "background config save failed, retrying");
+        last_save_ms_ = now_ms;
+        markDirty();
+    }
     if (!dirty_) {
         if (lkg_pending_ &&
             (now_ms - lkg_start_ms_) >= Config::LAST_GOOD_COMMIT_DELAY_MS) {
@@ -191,20 +180,25 @@ void StorageManager::poll(uint32_t now_ms) {
     if (now_ms - last_save_ms_ < debounce_ms_) {
         return;
     }
+    if (StorageWriter::instance().isRunning()) {
+        saveConfigDeferred(now_ms);
+        return;
+    }
     saveConfigInternal();
 }
 
 void StorageManager::clearAll() {
-#ifndef UNIT_TEST
-    LittleFS.remove(kConfigPath);
-    LittleFS.remove(kLastGoodPath);
-    LittleFS.remove(kVocStatePath);
-    LittleFS.remove(kPressurePath);
-    LittleFS.remove(kChartsPath);
-    LittleFS.remove(kDacAutoPath);
-#else
-    g_blob_store.clear();
-#endif
+    StorageWriter::instance().discardAll();
+    // One commit, so a power cut cannot leave a half-reset device.
+    RecordStore::Batch batch;
+    batch.remove(kConfigSnapshotPath);
+    batch.remove(kConfigPath);
+    batch.remove(kLastGoodPath);
+    batch.remove(kVocStatePath);
+    batch.remove(kPressurePath);
+    batch.remove(kChartsPath);
+    batch.remove(kDacAutoPath);
+    records_.commit(batch);
     config_ = Config::StoredConfig{};
     dirty_ = false;
     last_save_ms_ = 0;
@@ -214,35 +208,30 @@ void StorageManager::clearAll() {
 }
 
 bool StorageManager::commitLastGood() {
-#ifndef UNIT_TEST
-    if (!LittleFS.exists(kConfigPath)) {
-        return false;
-    }
-    return copyFileAtomic(kConfigPath, kLastGoodPath);
-#else
-    auto it = g_blob_store.find(kConfigPath);
-    if (it == g_blob_store.end()) {
+    StorageWriter::instance().settle(kConfigSnapshotPath);
+    Config::StoredConfig stored;
+    String text;
+    if (!loadSnapshot(stored) || !serializeConfigJson(stored, text)) {
         return false;
     }
-    g_blob_store[kLastGoodPath] = it->second;
-    return true;
-#endif
+    return records_.put(kLastGoodPath, text.c_str(), text.length());
 }
 
 bool StorageManager::restoreLastGood() {
-#ifndef UNIT_TEST
-    if (!LittleFS.exists(kLastGoodPath)) {
-        return false;
-    }
-    return copyFileAtomic(kLastGoodPath, kConfigPath);
-#else
-    auto it = g_blob_store.find(kLastGoodPath);
-    if (it == g_blob_store.end()) {
+    StorageWriter::instance().discard(kConfigSnapshotPath);
+    String text;
+    if (!loadText(kLastGoodPath, text)) {
         return false;
     }
-    g_blob_store[kConfigPath] = it->second;
-    return true;
-#endif
+    // Put back as JSON; loadConfig() turns it into a snapshot again.
+    RecordStore::Batch batch;
+    batch.put(kConfigPath, text.c_str(), text.length());
+    batch.remove(kConfigSnapshotPath);
+    return records_.commit(batch);
+}
+
+void StorageManager::recordStats(RecordStore::Stats &out) const {
+    records_.stats(out);
 }
 
 void StorageManager::loadWiFiSettings(String &ssid, String &pass, bool &enabled) {
@@ -354,7 +343,7 @@ bool StorageManager::loadVocState(uint8_t *out, size_t len) const {
 }
 
 bool StorageManager::saveVocState(const uint8_t *data, size_t len) {
-    return saveBlobAtomic(kVocStatePath, data, len);
+    return saveBlobAsync(kVocStatePath, data, len);
 }
 
 void StorageManager::clearVocState() {
@@ -362,267 +351,341 @@ void StorageManager::clearVocState() {
 }
 
 bool StorageManager::loadBlob(const char *path, void *out, size_t len) const {
-#ifndef UNIT_TEST
     if (!path || !out) {
         return false;
     }
-    File file = LittleFS.open(path, FILE_READ);
-    if (!file) {
-        return false;
-    }
-    if (static_cast<size_t>(file.size()) != len) {
-        file.close();
-        return false;
-    }
-    size_t read = file.readBytes(reinterpret_cast<char *>(out), len);
-    file.close();
-    return read == len;
-#else
-    auto it = g_blob_store.find(path ? path : "");
-    if (it == g_blob_store.end()) {
-        return false;
-    }
-    if (it->second.size() != len) {
-        return false;
-    }
-    memcpy(out, it->second.data(), len);
-    return true;
-#endif
+    return records_.read(path, out, len);
 }
 
 bool StorageManager::saveBlobAtomic(const char *path, const void *data, size_t len) {
-#ifndef UNIT_TEST
     if (!path || !data) {
         return false;
     }
-    String tmp = String(path) + ".tmp";
-    File file = LittleFS.open(tmp, FILE_WRITE);
-    if (!file) {
+    StorageWriter::instance().discard(path);
+    return writeBlobNow(path, reinterpret_cast<const uint8_t *>(data), len, this);
+}
+
+bool StorageManager::saveBlobAsync(const char *path, const void *data, size_t len,
+                                   StorageWriter::Callback callback, void *callback_ctx) {
+    if (!path || !data) {
         return false;
     }
-    size_t written = file.write(reinterpret_cast<const uint8_t *>(data), len);
-    file.close();
-    if (written != len) {
-        LittleFS.remove(tmp);
-        return false;
+    if (StorageWriter::instance().submit(path, data, len, callback, callback_ctx)) {
+        return true;
     }
-    return replaceFileAtomic(tmp.c_str(), path);
-#else
-    if (!path || !data) {
+    const bool ok = saveBlobAtomic(path, data, len);
+    if (callback) {
+        callback(path,
+                 ok ? StorageWriter::Result::Written : StorageWriter::Result::Failed,
+                 callback_ctx);
+    }
+    return ok;
+}
+
+bool StorageManager::writeBlobNow(const char *path, const uint8_t *data, size_t len, void *ctx) {
+#ifdef UNIT_TEST
+    if (g_force_save_failure && strcmp(path, kConfigSnapshotPath) == 0) {
         return false;
     }
-    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
-    g_blob_store[path] = std::vector<uint8_t>(bytes, bytes + len);
-    return true;
 #endif
+    auto *self = static_cast<StorageManager *>(ctx);
+    return self->records_.put(path, data, len);
 }
 
 bool StorageManager::removeBlob(const char *path) {
-#ifndef UNIT_TEST
     if (!path) {
         return false;
     }
-    return LittleFS.remove(path);
-#else
-    if (!path) {
-        return false;
-    }
-    return g_blob_store.erase(path) > 0;
-#endif
+    StorageWriter::instance().discard(path);
+    return records_.remove(path);
 }
 
 bool StorageManager::loadText(const char *path, String &out) const {
-#ifndef UNIT_TEST
-    if (!path) {
+    size_t len = 0;
+    if (!path || !records_.length(path, len)) {
         return false;
     }
-    File file = LittleFS.open(path, FILE_READ);
-    if (!file) {
+    std::unique_ptr<char[]> buffer(new (std::nothrow) char[len]);
+    if (!buffer || !records_.read(path, buffer.get(), len)) {
         return false;
     }
-    out = file.readString();
-    file.close();
+    out = String(buffer.get(), len);
     return true;
-#else
-    auto it = g_blob_store.find(path ? path : "");
-    if (it == g_blob_store.end()) {
-        return false;
-    }
-    out = String(reinterpret_cast<const char *>(it->second.data()), it->second.size());
-    return true;
-#endif
 }
 
 bool StorageManager::saveTextAtomic(const char *path, const String &text) {
-#ifndef UNIT_TEST
     if (!path) {
         return false;
     }
-    String tmp = String(path) + ".tmp";
-    File file = LittleFS.open(tmp, FILE_WRITE);
-    if (!file) {
+    StorageWriter::instance().discard(path);
+    return writeBlobNow(path, reinterpret_cast<const uint8_t *>(text.c_str()), text.length(),
+                        this);
+}
+
+bool StorageManager::loadConfig() {
+    Config::StoredConfig loaded;
+    if (loadSnapshot(loaded)) {
+        return applyLoadedConfig(loaded);
+    }
+#ifndef UNIT_TEST
+    if (!records_.contains(kConfigPath)) {
+        LOGI("Storage", "config not found, using defaults");
+        config_loaded_ = false;
         return false;
     }
-    size_t written = file.print(text);
-    file.close();
-    if (written != text.length()) {
-        LittleFS.remove(tmp);
+    String text;
+    loaded = Config::StoredConfig{};
+    if (!loadText(kConfigPath, text)) {
+        LOGW("Storage", "config read failed");
+        config_loaded_ = false;
         return false;
     }
-    return replaceFileAtomic(tmp.c_str(), path);
-#else
-    if (!path) {
+    if (!parseConfigJson(text, loaded)) {
+        config_loaded_ = false;
         return false;
     }
-    const char *chars = text.c_str();
-    g_blob_store[path] = std::vector<uint8_t>(chars, chars + text.length());
+    applyLoadedConfig(loaded);
+
+    // Migrated lazily, in one commit: a power cut leaves the JSON or the snapshot, never neither.
+    std::unique_ptr<uint8_t[]> snapshot;
+    size_t len = 0;
+    if (encodeConfig(snapshot, len)) {
+        RecordStore::Batch batch;
+        batch.put(kConfigSnapshotPath, snapshot.get(), len);
+        batch.remove(kConfigPath);
+        if (records_.commit(batch)) {
+            LOGI("Storage", "config migrated to binary snapshot");
+        }
+    }
+    return true;
+#else
+    config_loaded_ = true;
     return true;
 #endif
 }
 
-bool StorageManager::loadConfig() {
-#ifndef UNIT_TEST
-    if (!LittleFS.exists(kConfigPath)) {
-        LOGI("Storage", "config not found, using defaults");
-        config_loaded_ = false;
+bool StorageManager::loadSnapshot(Config::StoredConfig &out) const {
+    size_t len = 0;
+    if (!records_.length(kConfigSnapshotPath, len)) {
         return false;
     }
-    File file = LittleFS.open(kConfigPath, FILE_READ);
-    if (!file) {
-        LOGW("Storage", "config open failed");
-        config_loaded_ = false;
+    std::unique_ptr<uint8_t[]> buffer(new (std::nothrow) uint8_t[len]);
+    if (!buffer || !records_.read(kConfigSnapshotPath, buffer.get(), len)) {
+        return false;
+    }
+    if (!ConfigSnapshot::decode(buffer.get(), len, out)) {
+        LOGW("Storage", "config snapshot not readable");
         return false;
     }
+    return true;
+}
+
+bool StorageManager::applyLoadedConfig(Config::StoredConfig &loaded) {
+    const int16_t clamped_pressure_altitude_m = clampPressureAltitudeM(loaded.pressure_altitude_m);
+    const bool pressure_altitude_clamped = (clamped_pressure_altitude_m != loaded.pressure_altitude_m);
+    loaded.pressure_altitude_m = clamped_pressure_altitude_m;
+
+    config_ = loaded;
+    if (pressure_altitude_clamped) {
+        markDirty();
+    }
+    config_loaded_ = true;
+    return true;
+}
+
+#ifndef UNIT_TEST
+bool StorageManager::parseConfigJson(const String &text, Config::StoredConfig &out) {
 #if ARDUINOJSON_VERSION_MAJOR >= 7
     ArduinoJson::JsonDocument doc;
 #else
     ArduinoJson::DynamicJsonDocument doc(4096);
 #endif
-    ArduinoJson::DeserializationError err = ArduinoJson::deserializeJson(doc, file);
-    file.close();
+    ArduinoJson::DeserializationError err = ArduinoJson::deserializeJson(doc, text);
     if (err) {
         LOGW("Storage", "config parse failed: %s", err.c_str());
-        config_loaded_ = false;
         return false;
     }
-    Config::StoredConfig loaded;
     ArduinoJson::JsonObject root = doc.as<ArduinoJson::JsonObject>();
 
     ArduinoJson::JsonObject wifi = root["wifi"].as<ArduinoJson::JsonObject>();
     if (!wifi.isNull()) {
-        readValue(wifi, "enabled", loaded.wifi_enabled);
-        readString(wifi, "ssid", loaded.wifi_ssid);
-        readString(wifi, "pass", loaded.wifi_pass);
+        readValue(wifi, "enabled", out.wifi_enabled);
+        readString(wifi, "ssid", out.wifi_ssid);
+        readString(wifi, "pass", out.wifi_pass);
     }
 
     ArduinoJson::JsonObject mqtt = root["mqtt"].as<ArduinoJson::JsonObject>();
     if (!mqtt.isNull()) {
-        readString(mqtt, "host", loaded.mqtt_host);
-        readValue(mqtt, "port", loaded.mqtt_port);
-        readString(mqtt, "user", loaded.mqtt_user);
-        readString(mqtt, "pass", loaded.mqtt_pass);
-        readString(mqtt, "base", loaded.mqtt_base_topic);
-        readString(mqtt, "name", loaded.mqtt_device_name);
-        readValue(mqtt, "enabled", loaded.mqtt_user_enabled);
-        readValue(mqtt, "discovery", loaded.mqtt_discovery);
-        readValue(mqtt, "anonymous", loaded.mqtt_anonymous);
+        readString(mqtt, "host", out.mqtt_host);
+        readValue(mqtt, "port", out.mqtt_port);
+        readString(mqtt, "user", out.mqtt_user);
+        readString(mqtt, "pass", out.mqtt_pass);
+        readString(mqtt, "base", out.mqtt_base_topic);
+        readString(mqtt, "name", out.mqtt_device_name);
+        readValue(mqtt, "enabled", out.mqtt_user_enabled);
+        readValue(mqtt, "discovery", out.mqtt_discovery);
+        readValue(mqtt, "anonymous", out.mqtt_anonymous);
         if (mqtt["anonymous"].isNull()) {
-            loaded.mqtt_anonymous =
-                (loaded.mqtt_user.length() == 0 && loaded.mqtt_pass.length() == 0);
+            out.mqtt_anonymous =
+                (out.mqtt_user.length() == 0 && out.mqtt_pass.length() == 0);
         }
+        int state_encoding_raw = static_cast<int>(Config::MqttStateEncoding::Json);
+        readValue(mqtt, "state_encoding", state_encoding_raw);
+        out.mqtt_state_encoding = Config::clampMqttStateEncoding(state_encoding_raw);
     }
 
     ArduinoJson::JsonObject ui = root["ui"].as<ArduinoJson::JsonObject>();
     if (!ui.isNull()) {
-        readValue(ui, "temp_offset", loaded.temp_offset);
-        readValue(ui, "hum_offset", loaded.hum_offset);
-        readValue(ui, "units_c", loaded.units_c);
-        readValue(ui, "units_mdy", loaded.units_mdy);
-        readValue(ui, "night_mode", loaded.night_mode);
-        readValue(ui, "header_status_enabled", loaded.header_status_enabled);
-        readValue(ui, "led_indicators", loaded.led_indicators);
-        readValue(ui, "alert_blink", loaded.alert_blink);
-        readValue(ui, "asc_enabled", loaded.asc_enabled);
-        readValue(ui, "pressure_altitude_set", loaded.pressure_altitude_set);
-        readValue(ui, "pressure_altitude_m", loaded.pressure_altitude_m);
-        readString(ui, "display_name", loaded.web_display_name);
+        readValue(ui, "temp_offset", out.temp_offset);
+        readValue(ui, "hum_offset", out.hum_offset);
+        readValue(ui, "units_c", out.units_c);
+        readValue(ui, "units_mdy", out.units_mdy);
+        readValue(ui, "night_mode", out.night_mode);
+        readValue(ui, "header_status_enabled", out.header_status_enabled);
+        readValue(ui, "led_indicators", out.led_indicators);
+        readValue(ui, "alert_blink", out.alert_blink);
+        readValue(ui, "asc_enabled", out.asc_enabled);
+        readValue(ui, "pressure_altitude_set", out.pressure_altitude_set);
+        readValue(ui, "pressure_altitude_m", out.pressure_altitude_m);
+        readString(ui, "display_name", out.web_display_name);
         int lang_raw = static_cast<int>(Config::Language::EN);
         readValue(ui, "lang", lang_raw);
-        loaded.language = Config::clampLanguage(lang_raw);
+        out.language = Config::clampLanguage(lang_raw);
     }
 
     ArduinoJson::JsonObject backlight = root["backlight"].as<ArduinoJson::JsonObject>();
     if (!backlight.isNull()) {
-        readValue(backlight, "timeout_s", loaded.backlight_timeout_s);
-        readValue(backlight, "schedule_enabled", loaded.backlight_schedule_enabled);
-        readValue(backlight, "alarm_wake", loaded.backlight_alarm_wake);
-        readValue(backlight, "sleep_hour", loaded.backlight_sleep_hour);
-        readValue(backlight, "sleep_minute", loaded.backlight_sleep_minute);
-        readValue(backlight, "wake_hour", loaded.backlight_wake_hour);
-        readValue(backlight, "wake_minute", loaded.backlight_wake_minute);
+        readValue(backlight, "timeout_s", out.backlight_timeout_s);
+        readValue(backlight, "schedule_enabled", out.backlight_schedule_enabled);
+        readValue(backlight, "alarm_wake", out.backlight_alarm_wake);
+        readValue(backlight, "sleep_hour", out.backlight_sleep_hour);
+        readValue(backlight, "sleep_minute", out.backlight_sleep_minute);
+        readValue(backlight, "wake_hour", out.backlight_wake_hour);
+        readValue(backlight, "wake_minute", out.backlight_wake_minute);
     }
 
     ArduinoJson::JsonObject auto_night = root["auto_night"].as<ArduinoJson::JsonObject>();
     if (!auto_night.isNull()) {
-        readValue(auto_night, "enabled", loaded.auto_night_enabled);
-        readValue(auto_night, "start_hour", loaded.auto_night_start_hour);
-        readValue(auto_night, "start_minute", loaded.auto_night_start_minute);
-        readValue(auto_night, "end_hour", loaded.auto_night_end_hour);
-        readValue(auto_night, "end_minute", loaded.auto_night_end_minute);
+        readValue(auto_night, "enabled", out.auto_night_enabled);
+        readValue(auto_night, "start_hour", out.auto_night_start_hour);
+        readValue(auto_night, "start_minute", out.auto_night_start_minute);
+        readValue(auto_night, "end_hour", out.auto_night_end_hour);
+        readValue(auto_night, "end_minute", out.auto_night_end_minute);
     }
 
     ArduinoJson::JsonObject time = root["time"].as<ArduinoJson::JsonObject>();
     if (!time.isNull()) {
-        readValue(time, "ntp_enabled", loaded.ntp_enabled);
-        readString(time, "ntp_server", loaded.ntp_server);
-        readString(time, "tz_name", loaded.tz_name);
-        readValue(time, "tz_idx", loaded.tz_index);
-        readValue(time, "format_24h", loaded.time_format_24h);
+        readValue(time, "ntp_enabled", out.ntp_enabled);
+        readString(time, "ntp_server", out.ntp_server);
+        readString(time, "tz_name", out.tz_name);
+        readValue(time, "tz_idx", out.tz_index);
+        readValue(time, "format_24h", out.time_format_24h);
         int rtc_mode_raw = static_cast<int>(Config::RtcMode::Auto);
         readValue(time, "rtc_mode", rtc_mode_raw);
-        loaded.rtc_mode = Config::clampRtcMode(rtc_mode_raw);
+        out.rtc_mode = Config::clampRtcMode(rtc_mode_raw);
     }
 
     ArduinoJson::JsonObject dac = root["dac"].as<ArduinoJson::JsonObject>();
     if (!dac.isNull()) {
-        readValue(dac, "auto_mode", loaded.dac_auto_mode);
-        readValue(dac, "auto_armed", loaded.dac_auto_armed);
+        readValue(dac, "auto_mode", out.dac_auto_mode);
+        readValue(dac, "auto_armed", out.dac_auto_armed);
     }
 
     ArduinoJson::JsonObject theme = root["theme"].as<ArduinoJson::JsonObject>();
     if (!theme.isNull()) {
-        readValue(theme, "valid", loaded.theme.valid);
-        readValue(theme, "screen_bg", loaded.theme.screen_bg);
-        readValue(theme, "card_bg", loaded.theme.card_bg);
-        readValue(theme, "card_border", loaded.theme.card_border);
-        readValue(theme, "text_primary", loaded.theme.text_primary);
-        readValue(theme, "shadow_color", loaded.theme.shadow_color);
-        readValue(theme, "shadow_enabled", loaded.theme.shadow_enabled);
-        readValue(theme, "gradient_enabled", loaded.theme.gradient_enabled);
-        readValue(theme, "gradient_color", loaded.theme.gradient_color);
-        readValue(theme, "gradient_direction", loaded.theme.gradient_direction);
-        readValue(theme, "screen_gradient_enabled", loaded.theme.screen_gradient_enabled);
-        readValue(theme, "screen_gradient_color", loaded.theme.screen_gradient_color);
-        readValue(theme, "screen_gradient_direction", loaded.theme.screen_gradient_direction);
+        readValue(theme, "valid", out.theme.valid);
+        readValue(theme, "screen_bg", out.theme.screen_bg);
+        readValue(theme, "card_bg", out.theme.card_bg);
+        readValue(theme, "card_border", out.theme.card_border);
+        readValue(theme, "text_primary", out.theme.text_primary);
+        readValue(theme, "shadow_color", out.theme.shadow_color);
+        readValue(theme, "shadow_enabled", out.theme.shadow_enabled);
+        readValue(theme, "gradient_enabled", out.theme.gradient_enabled);
+        readValue(theme, "gradient_color", out.theme.gradient_color);
+        readValue(theme, "gradient_direction", out.theme.gradient_direction);
+        readValue(theme, "screen_gradient_enabled", out.theme.screen_gradient_enabled);
+        readValue(theme, "screen_gradient_color", out.theme.screen_gradient_color);
+        readValue(theme, "screen_gradient_direction", out.theme.screen_gradient_direction);
     }
 
-    const int16_t clamped_pressure_altitude_m = clampPressureAltitudeM(loaded.pressure_altitude_m);
-    const bool pressure_altitude_clamped = (clamped_pressure_altitude_m != loaded.pressure_altitude_m);
-    loaded.pressure_altitude_m = clamped_pressure_altitude_m;
+    return true;
+}
+#endif
 
-    config_ = loaded;
-    if (pressure_altitude_clamped) {
-        markDirty();
+bool StorageManager::saveConfigInternal() {
+    std::unique_ptr<uint8_t[]> snapshot;
+    size_t len = 0;
+    if (!encodeConfig(snapshot, len)) {
+        return false;
     }
-    config_loaded_ = true;
+    // A queued debounced save holds older settings; this one supersedes it.
+    StorageWriter::instance().discard(kConfigSnapshotPath);
+    if (!writeBlobNow(kConfigSnapshotPath, snapshot.get(), len, this)) {
+        return false;
+    }
+    dirty_ = false;
+    noteConfigSaved(millis());
     return true;
-#else
+}
+
+void StorageManager::saveConfigDeferred(uint32_t now_ms) {
+    std::unique_ptr<uint8_t[]> snapshot;
+    size_t len = 0;
+    last_save_ms_ = now_ms;
+    if (!encodeConfig(snapshot, len)) {
+        return;
+    }
+    // Cleared up front so edits made while the write is queued schedule another save.
+    dirty_ = false;
+    saveBlobAsync(kConfigSnapshotPath, snapshot.get(), len, &StorageManager::onConfigWritten,
+                  this);
+}
+
+void StorageManager::onConfigWritten(const char *, StorageWriter::Result result, void *ctx) {
+    auto *self = static_cast<StorageManager *>(ctx);
+    if (result == StorageWriter::Result::Written) {
+        self->config_write_state_.store(CONFIG_WRITE_OK);
+    } else if (result == StorageWriter::Result::Failed) {
+        self->config_write_state_.store(CONFIG_WRITE_FAILED);
+    }
+}
+
+void StorageManager::onWriterIdle(void *ctx) {
+    static_cast<StorageManager *>(ctx)->compactIfNeeded();
+}
+
+void StorageManager::compactIfNeeded() {
+    if (!records_.needsCompaction()) {
+        return;
+    }
+    const uint32_t start_ms = millis();
+    if (records_.compact()) {
+        LOGI("Storage", "record log compacted in %lu ms",
+             static_cast<unsigned long>(millis() - start_ms));
+    } else {
+        LOGW("Storage", "record log compaction failed");
+    }
+}
+
+void StorageManager::noteConfigSaved(uint32_t now_ms) {
     config_loaded_ = true;
-    return true;
-#endif
+    last_save_ms_ = now_ms;
+    lkg_pending_ = true;
+    lkg_start_ms_ = now_ms;
 }
 
-bool StorageManager::saveConfigInternal() {
+bool StorageManager::encodeConfig(std::unique_ptr<uint8_t[]> &out, size_t &len) {
+    config_.pressure_altitude_m = clampPressureAltitudeM(config_.pressure_altitude_m);
+    const size_t size = ConfigSnapshot::encodedSize(config_);
+    out.reset(new (std::nothrow) uint8_t[size]);
+    if (!out) {
+        return false;
+    }
+    len = ConfigSnapshot::encode(config_, out.get(), size);
+    return len > 0;
+}
+
+bool StorageManager::serializeConfigJson(const Config::StoredConfig &config, String &out) {
 #ifndef UNIT_TEST
 #if ARDUINOJSON_VERSION_MAJOR >= 7
     ArduinoJson::JsonDocument doc;
@@ -632,112 +695,115 @@ bool StorageManager::saveConfigInternal() {
     ArduinoJson::JsonObject root = doc.to<ArduinoJson::JsonObject>();
 
     ArduinoJson::JsonObject wifi = root["wifi"].to<ArduinoJson::JsonObject>();
-    wifi["enabled"] = config_.wifi_enabled;
-    wifi["ssid"] = config_.wifi_ssid;
-    wifi["pass"] = config_.wifi_pass;
+    wifi["enabled"] = config.wifi_enabled;
+    wifi["ssid"] = config.wifi_ssid;
+    wifi["pass"] = config.wifi_pass;
 
     ArduinoJson::JsonObject mqtt = root["mqtt"].to<ArduinoJson::JsonObject>();
-    mqtt["host"] = config_.mqtt_host;
-    mqtt["port"] = config_.mqtt_port;
-    mqtt["user"] = config_.mqtt_user;
-    mqtt["pass"] = config_.mqtt_pass;
-    mqtt["base"] = config_.mqtt_base_topic;
-    mqtt["name"] = config_.mqtt_device_name;
-    mqtt["enabled"] = config_.mqtt_user_enabled;
-    mqtt["discovery"] = config_.mqtt_discovery;
-    mqtt["anonymous"] = config_.mqtt_anonymous;
+    mqtt["host"] = config.mqtt_host;
+    mqtt["port"] = config.mqtt_port;
+    mqtt["user"] = config.mqtt_user;
+    mqtt["pass"] = config.mqtt_pass;
+    mqtt["base"] = config.mqtt_base_topic;
+    mqtt["name"] = config.mqtt_device_name;
+    mqtt["enabled"] = config.mqtt_user_enabled;
+    mqtt["discovery"] = config.mqtt_discovery;
+    mqtt["anonymous"] = config.mqtt_anonymous;
+    mqtt["state_encoding"] = static_cast<uint8_t>(config.mqtt_state_encoding);
 
     ArduinoJson::JsonObject ui = root["ui"].to<ArduinoJson::JsonObject>();
-    ui["temp_offset"] = config_.temp_offset;
-    ui["hum_offset"] = config_.hum_offset;
-    ui["units_c"] = config_.units_c;
-    ui["units_mdy"] = config_.units_mdy;
-    ui["night_mode"] = config_.night_mode;
-    ui["header_status_enabled"] = config_.header_status_enabled;
-    ui["led_indicators"] = config_.led_indicators;
-    ui["alert_blink"] = config_.alert_blink;
-    ui["asc_enabled"] = config_.asc_enabled;
-    ui["pressure_altitude_set"] = config_.pressure_altitude_set;
-    config_.pressure_altitude_m = clampPressureAltitudeM(config_.pressure_altitude_m);
-    ui["pressure_altitude_m"] = config_.pressure_altitude_m;
-    ui["display_name"] = config_.web_display_name;
-    ui["lang"] = static_cast<uint8_t>(config_.language);
+    ui["temp_offset"] = config.temp_offset;
+    ui["hum_offset"] = config.hum_offset;
+    ui["units_c"] = config.units_c;
+    ui["units_mdy"] = config.units_mdy;
+    ui["night_mode"] = config.night_mode;
+    ui["header_status_enabled"] = config.header_status_enabled;
+    ui["led_indicators"] = config.led_indicators;
+    ui["alert_blink"] = config.alert_blink;
+    ui["asc_enabled"] = config.asc_enabled;
+    ui["pressure_altitude_set"] = config.pressure_altitude_set;
+    ui["pressure_altitude_m"] = clampPressureAltitudeM(config.pressure_altitude_m);
+    ui["display_name"] = config.web_display_name;
+    ui["lang"] = static_cast<uint8_t>(config.language);
 
     ArduinoJson::JsonObject backlight = root["backlight"].to<ArduinoJson::JsonObject>();
-    backlight["timeout_s"] = config_.backlight_timeout_s;
-    backlight["schedule_enabled"] = config_.backlight_schedule_enabled;
-    backlight["alarm_wake"] = config_.backlight_alarm_wake;
-    backlight["sleep_hour"] = config_.backlight_sleep_hour;
-    backlight["sleep_minute"] = config_.backlight_sleep_minute;
-    backlight["wake_hour"] = config_.backlight_wake_hour;
-    backlight["wake_minute"] = config_.backlight_wake_minute;
+    backlight["timeout_s"] = config.backlight_timeout_s;
+    backlight["schedule_enabled"] = config.backlight_schedule_enabled;
+    backlight["alarm_wake"] = config.backlight_alarm_wake;
+    backlight["sleep_hour"] = config.backlight_sleep_hour;
+    backlight["sleep_minute"] = config.backlight_sleep_minute;
+    backlight["wake_hour"] = config.backlight_wake_hour;
+    backlight["wake_minute"] = config.backlight_wake_minute;
 
     ArduinoJson::JsonObject auto_night = root["auto_night"].to<ArduinoJson::JsonObject>();
-    auto_night["enabled"] = config_.auto_night_enabled;
-    auto_night["start_hour"] = config_.auto_night_start_hour;
-    auto_night["start_minute"] = config_.auto_night_start_minute;
-    auto_night["end_hour"] = config_.auto_night_end_hour;
-    auto_night["end_minute"] = config_.auto_night_end_minute;
+    auto_night["enabled"] = config.auto_night_enabled;
+    auto_night["start_hour"] = config.auto_night_start_hour;
+    auto_night["start_minute"] = config.auto_night_start_minute;
+    auto_night["end_hour"] = config.auto_night_end_hour;
+    auto_night["end_minute"] = config.auto_night_end_minute;
 
     ArduinoJson::JsonObject time = root["time"].to<ArduinoJson::JsonObject>();
-    time["ntp_enabled"] = config_.ntp_enabled;
-    time["ntp_server"] = config_.ntp_server;
-    time["tz_name"] = config_.tz_name;
-    time["tz_idx"] = config_.tz_index;
-    time["format_24h"] = config_.time_format_24h;
-    time["rtc_mode"] = static_cast<uint8_t>(config_.rtc_mode);
+    time["ntp_enabled"] = config.ntp_enabled;
+    time["ntp_server"] = config.ntp_server;
+    time["tz_name"] = config.tz_name;
+    time["tz_idx"] = config.tz_index;
+    time["format_24h"] = config.time_format_24h;
+    time["rtc_mode"] = static_cast<uint8_t>(config.rtc_mode);
 
     ArduinoJson::JsonObject dac = root["dac"].to<ArduinoJson::JsonObject>();
-    dac["auto_mode"] = config_.dac_auto_mode;
-    dac["auto_armed"] = config_.dac_auto_armed;
+    dac["auto_mode"] = config.dac_auto_mode;
+    dac["auto_armed"] = config.dac_auto_armed;
 
     ArduinoJson::JsonObject theme = root["theme"].to<ArduinoJson::JsonObject>();
-    theme["valid"] = config_.theme.valid;
-    theme["screen_bg"] = config_.theme.screen_bg;
-    theme["card_bg"] = config_.theme.card_bg;
-    theme["card_border"] = config_.theme.card_border;
-    theme["text_primary"] = config_.theme.text_primary;
-    theme["shadow_color"] = config_.theme.shadow_color;
-    theme["shadow_enabled"] = config_.theme.shadow_enabled;
-    theme["gradient_enabled"] = config_.theme.gradient_enabled;
-    theme["gradient_color"] = config_.theme.gradient_color;
-    theme["gradient_direction"] = config_.theme.gradient_direction;
-    theme["screen_gradient_enabled"] = config_.theme.screen_gradient_enabled;
-    theme["screen_gradient_color"] = config_.theme.screen_gradient_color;
-    theme["screen_gradient_direction"] = config_.theme.screen_gradient_direction;
-
-    String tmp = String(kConfigPath) + ".tmp";
-    File file = LittleFS.open(tmp, FILE_WRITE);
-    if (!file) {
-        return false;
-    }
-    if (ArduinoJson::serializeJson(doc, file) == 0) {
-        file.close();
-        LittleFS.remove(tmp);
-        return false;
-    }
-    file.close();
-    if (!replaceFileAtomic(tmp.c_str(), kConfigPath)) {
-        return false;
-    }
-    config_loaded_ = true;
-    last_save_ms_ = millis();
-    dirty_ = false;
-    lkg_pending_ = true;
-    lkg_start_ms_ = last_save_ms_;
-    return true;
+    theme["valid"] = config.theme.valid;
+    theme["screen_bg"] = config.theme.screen_bg;
+    theme["card_bg"] = config.theme.card_bg;
+    theme["card_border"] = config.theme.card_border;
+    theme["text_primary"] = config.theme.text_primary;
+    theme["shadow_color"] = config.theme.shadow_color;
+    theme["shadow_enabled"] = config.theme.shadow_enabled;
+    theme["gradient_enabled"] = config.theme.gradient_enabled;
+    theme["gradient_color"] = config.theme.gradient_color;
+    theme["gradient_direction"] = config.theme.gradient_direction;
+    theme["screen_gradient_enabled"] = config.theme.screen_gradient_enabled;
+    theme["screen_gradient_color"] = config.theme.screen_gradient_color;
+    theme["screen_gradient_direction"] = config.theme.screen_gradient_direction;
+
+    out = "";
+    return ArduinoJson::serializeJson(doc, out) > 0;
 #else
-    if (g_force_save_failure) {
-        return false;
-    }
-    last_save_ms_ = millis();
-    dirty_ = false;
-    lkg_pending_ = true;
-    lkg_start_ms_ = last_save_ms_;
+    (void)config;
+    out = "{}";
     return true;
 #endif
 }
 
+#ifndef UNIT_TEST
+void StorageManager::migrateLegacyFiles() {
+    for (const char *path : kLegacyPaths) {
+        if (!LittleFS.exists(path)) {
+            continue;
+        }
+        if (!records_.contains(path)) {
+            File file = LittleFS.open(path, FILE_READ);
+            if (!file) {
+                continue;
+            }
+            const size_t len = file.size();
+            std::unique_ptr<uint8_t[]> buffer(new (std::nothrow) uint8_t[len]);
+            const bool read_ok = buffer && file.read(buffer.get(), len) == len;
+            file.close();
+            if (!read_ok || !records_.put(path, buffer.get(), len)) {
+                LOGW("Storage", "failed to import %s", path);
+                continue;
+            }
+            LOGI("Storage", "imported %s into record log", path);
+        }
+        removeLegacyFile(path);
+    }
+}
+#endif
+
 #ifdef UNIT_TEST
 void StorageManager::setTestForceSaveFailure(bool enabled) {
     g_force_save_failure = enabled;
@@ -6,7 +6,11 @@
 
 #pragma once
 #include <Arduino.h>
+#include <atomic>
+#include <memory>
 #include "config/AppConfig.h"
+#include "core/RecordStore.h"
+#include "core/StorageWriter.h"
 
 class StorageManager {
 public:
@@ -17,6 +21,8 @@ public:
     };
 
     void begin(BootAction action = BootAction::Normal);
+    // Moves periodic saves (VOC state, histories, debounced config) to the background writer.
+    bool startWriter();
     const Config::StoredConfig &config() const;
     Config::StoredConfig &config();
     bool saveConfig(bool force = false);
@@ -49,26 +55,59 @@ public:
 
     bool loadBlob(const char *path, void *out, size_t len) const;
     bool saveBlobAtomic(const char *path, const void *data, size_t len);
+    // Queued on the background writer; written synchronously when it is not running or full.
+    bool saveBlobAsync(const char *path, const void *data, size_t len,
+                       StorageWriter::Callback callback = nullptr, void *callback_ctx = nullptr);
     bool removeBlob(const char *path);
     bool loadText(const char *path, String &out) const;
     bool saveTextAtomic(const char *path, const String &text);
+    void recordStats(RecordStore::Stats &out) const;
 
 #ifdef UNIT_TEST
     static void setTestForceSaveFailure(bool enabled);
 #endif
 
+    // The live config is a binary snapshot; JSON is kept for the last-known-good copy and is
+    // only read back from kConfigPath when migrating or restoring.
+    static constexpr const char *kConfigSnapshotPath = "/config.bin";
     static constexpr const char *kConfigPath = "/config.json";
     static constexpr const char *kLastGoodPath = "/config.last_good.json";
     static constexpr const char *kVocStatePath = "/voc_state.bin";
     static constexpr const char *kPressurePath = "/pressure.bin";
     static constexpr const char *kChartsPath = "/charts.bin";
     static constexpr const char *kDacAutoPath = "/dac_auto.json";
+    static constexpr const char *kBootTracePath = "/boot_trace.bin";
 
 private:
     bool loadConfig();
+    bool loadSnapshot(Config::StoredConfig &out) const;
+    bool applyLoadedConfig(Config::StoredConfig &loaded);
     bool saveConfigInternal();
+    bool encodeConfig(std::unique_ptr<uint8_t[]> &out, size_t &len);
+    static bool serializeConfigJson(const Config::StoredConfig &config, String &out);
+#ifndef UNIT_TEST
+    static bool parseConfigJson(const String &text, Config::StoredConfig &out);
+#endif
+    void saveConfigDeferred(uint32_t now_ms);
+    void noteConfigSaved(uint32_t now_ms);
     void markDirty();
+    void compactIfNeeded();
+#ifndef UNIT_TEST
+    void migrateLegacyFiles();
+#endif
+    static bool writeBlobNow(const char *path, const uint8_t *data, size_t len, void *ctx);
+    static void onConfigWritten(const char *path, StorageWriter::Result result, void *ctx);
+    static void onWriterIdle(void *ctx);
+
+    enum ConfigWriteState : uint8_t {
+        CONFIG_WRITE_IDLE = 0,
+        CONFIG_WRITE_OK,
+        CONFIG_WRITE_FAILED
+    };
 
+    // Every path above is a key in one record log rather than a file of its own.
+    std::unique_ptr<RecordMedium> medium_;
+    mutable RecordStore records_;
     Config::StoredConfig config_{}; 
     bool dirty_ = false;
     uint32_t last_save_ms_ = 0;
@@ -77,4 +116,6 @@ private:
     uint32_t lkg_start_ms_ = 0;
     bool mounted_ = false;
     bool config_loaded_ = false;
+    // Set by the writer task, consumed by poll().
+    std::atomic<uint8_t> config_write_state_{CONFIG_WRITE_IDLE};
 };
@@ -15,6 +15,7 @@
 #include <esp_sntp.h>
 
 #include "core/Logger.h"
+#include "core/SensorFusion.h"
 #ifdef UNIT_TEST
 #include "TimeMock.h"
 #endif
@@ -849,6 +850,12 @@ TimeManager::PollResult TimeManager::pollRtcStatus(uint32_t now_ms) {
         rtc_present_ = true;
     }
 
+    // The DS3231 carries its own temperature sensor; SensorManager fuses it as a fallback.
+    float rtc_temp_c = 0.0f;
+    if (rtc_type_ == RtcType::Ds3231 && ds3231_.readTemperature(rtc_temp_c)) {
+        SensorFusion::instance().postRtcTemperature(rtc_temp_c, now_ms);
+    }
+
     return result;
 }
 
@@ -10,6 +10,12 @@
 
 namespace BootDiagPolicy {
 
+enum class Stage : uint8_t {
+    Logo,
+    Diag,
+    Main,
+};
+
 inline bool sen66Pending(bool sensor_ok, bool sensor_busy, uint32_t retry_at_ms, uint32_t now_ms) {
     return !sensor_ok && (sensor_busy || (retry_at_ms != 0 && now_ms < retry_at_ms));
 }
@@ -21,4 +27,24 @@ inline bool shouldAutoAdvance(bool has_errors,
     return !has_errors && !sen66_pending && elapsed_ms >= auto_advance_ms;
 }
 
+// Where the boot flow goes from `stage` after `elapsed_ms` on it. Diagnostics always follow the
+// logo: their screen is built by that navigation, so this must not depend on it existing yet.
+inline Stage nextStage(Stage stage,
+                       uint32_t elapsed_ms,
+                       uint32_t logo_ms,
+                       bool has_errors,
+                       bool sen66_pending,
+                       uint32_t auto_advance_ms) {
+    switch (stage) {
+        case Stage::Logo:
+            return elapsed_ms >= logo_ms ? Stage::Diag : Stage::Logo;
+        case Stage::Diag:
+            return shouldAutoAdvance(has_errors, sen66_pending, elapsed_ms, auto_advance_ms)
+                       ? Stage::Main
+                       : Stage::Diag;
+        default:
+            return Stage::Main;
+    }
+}
+
 } // namespace BootDiagPolicy
@@ -0,0 +1,447 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "ui/LvglMemPool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lvgl_mem_pool.h"
+
+#ifndef UNIT_TEST
+#include <esp_heap_caps.h>
+#endif
+
+namespace {
+
+constexpr size_t kClassSizes[LvglMemPool::kClassCount] = {16, 32, 64, 128, 256};
+static_assert(kClassSizes[LvglMemPool::kClassCount - 1] == LvglMemPool::kMaxBlockSize,
+              "largest class must match kMaxBlockSize");
+
+int class_index(size_t size) {
+    for (size_t i = 0; i < LvglMemPool::kClassCount; ++i) {
+        if (size <= kClassSizes[i]) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+uint8_t *slab_memory(bool internal) {
+#ifdef UNIT_TEST
+    (void)internal;
+    return static_cast<uint8_t *>(malloc(LvglMemPool::kSlabBytes));
+#else
+    const uint32_t caps = (internal ? MALLOC_CAP_INTERNAL : MALLOC_CAP_SPIRAM) | MALLOC_CAP_8BIT;
+    return static_cast<uint8_t *>(heap_caps_malloc(LvglMemPool::kSlabBytes, caps));
+#endif
+}
+
+void *heap_alloc(size_t size) {
+#ifdef UNIT_TEST
+    return malloc(size);
+#else
+    return heap_caps_malloc_prefer(size, 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT,
+                                   MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#endif
+}
+
+void *heap_realloc(void *ptr, size_t size) {
+#ifdef UNIT_TEST
+    return realloc(ptr, size);
+#else
+    return heap_caps_realloc_prefer(ptr, size, 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT,
+                                    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#endif
+}
+
+void heap_free(void *ptr) {
+#ifdef UNIT_TEST
+    free(ptr);
+#else
+    heap_caps_free(ptr);
+#endif
+}
+
+// In front of every general heap block, so free() and realloc() know what to take off which
+// arena. 8 bytes keep the block as aligned as the heap returned it.
+struct HeapHeader {
+    uint32_t size;
+    uint8_t arena;
+    uint8_t reserved[3];
+};
+static_assert(sizeof(HeapHeader) == 8, "HeapHeader must keep 8-byte alignment");
+
+HeapHeader *heap_header(void *block) {
+    return reinterpret_cast<HeapHeader *>(static_cast<uint8_t *>(block) - sizeof(HeapHeader));
+}
+
+uint8_t arena_from_screen(int screen_id) {
+    if (screen_id <= 0 || screen_id >= LvglMemPool::kMaxArenas) {
+        return LvglMemPool::kSharedArena;
+    }
+    return static_cast<uint8_t>(screen_id);
+}
+
+} // namespace
+
+LvglMemPool &LvglMemPool::instance() {
+    static LvglMemPool pool;
+    return pool;
+}
+
+LvglMemPool::LvglMemPool() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+size_t LvglMemPool::classSize(size_t size) {
+    const int cls = class_index(size);
+    return cls < 0 ? 0 : kClassSizes[cls];
+}
+
+void *LvglMemPool::alloc(size_t size) {
+    lock();
+    void *block = allocLocked(size, arena_);
+    unlock();
+    return block;
+}
+
+void *LvglMemPool::realloc(void *ptr, size_t size) {
+    if (!ptr) {
+        return alloc(size);
+    }
+    if (size == 0) {
+        free(ptr);
+        return nullptr;
+    }
+    lock();
+    const Slab *slab = findSlab(ptr);
+    if (!slab) {
+        allocs_++;
+        HeapHeader *header = heap_header(ptr);
+        const uint32_t old_size = header->size;
+        const uint8_t arena = header->arena;
+        header = static_cast<HeapHeader *>(heap_realloc(header, sizeof(HeapHeader) + size));
+        void *moved = nullptr;
+        if (header) {
+            header->size = static_cast<uint32_t>(size);
+            uncharge(arena, old_size);
+            arena_bytes_[arena] += static_cast<uint32_t>(size);
+            moved = header + 1;
+        }
+        unlock();
+        return moved;
+    }
+    const size_t old_size = kClassSizes[slab->cls];
+    if (class_index(size) == slab->cls) {
+        allocs_++;
+        unlock();
+        return ptr;
+    }
+    // The grown or shrunk block stays with the screen that owns the original.
+    void *moved = allocLocked(size, slab->arena);
+    unlock();
+    if (!moved) {
+        return nullptr;
+    }
+    memcpy(moved, ptr, old_size < size ? old_size : size);
+    free(ptr);
+    return moved;
+}
+
+void LvglMemPool::free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    lock();
+    Slab *slab = findSlab(ptr);
+    if (!slab) {
+        HeapHeader *header = heap_header(ptr);
+        uncharge(header->arena, header->size);
+        heap_free(header);
+        if (heap_live_ > 0) {
+            heap_live_--;
+        }
+        unlock();
+        return;
+    }
+    *static_cast<void **>(ptr) = slab->free_list;
+    slab->free_list = ptr;
+    slab->used--;
+    used_[slab->cls]--;
+    uncharge(slab->arena, kClassSizes[slab->cls]);
+    if (slab->used == 0 && arenaClosed(slab->arena)) {
+        releaseSlab(slab);
+    }
+    unlock();
+}
+
+void LvglMemPool::beginArena(uint8_t arena) {
+    if (arena >= kMaxArenas) {
+        arena = kSharedArena;
+    }
+    lock();
+    arena_ = arena;
+    closed_arenas_ &= ~(1u << arena);
+    unlock();
+}
+
+void LvglMemPool::endArena() {
+    lock();
+    arena_ = kSharedArena;
+    unlock();
+}
+
+void LvglMemPool::closeArena(uint8_t arena) {
+    if (arena == kSharedArena || arena >= kMaxArenas) {
+        return;
+    }
+    lock();
+    closed_arenas_ |= 1u << arena;
+    for (size_t i = slab_count_; i > 0; --i) {
+        Slab &slab = slabs_[i - 1];
+        if (slab.arena == arena && slab.used == 0) {
+            releaseSlab(&slab);
+        }
+    }
+    unlock();
+}
+
+uint32_t LvglMemPool::arenaBytes(uint8_t arena) const {
+    if (arena == kSharedArena || arena >= kMaxArenas) {
+        return 0;
+    }
+    lock();
+    const uint32_t bytes = arena_bytes_[arena];
+    unlock();
+    return bytes;
+}
+
+void LvglMemPool::stats(Stats &out) const {
+    out = Stats{};
+    lock();
+    uint32_t slab_bytes = 0;
+    uint32_t free_bytes = 0;
+    for (size_t c = 0; c < kClassCount; ++c) {
+        ClassStats &cls = out.classes[c];
+        cls.block_size = static_cast<uint16_t>(kClassSizes[c]);
+        cls.used = used_[c];
+        cls.peak_used = peak_used_[c];
+    }
+    for (size_t i = 0; i < slab_count_; ++i) {
+        const Slab &slab = slabs_[i];
+        ClassStats &cls = out.classes[slab.cls];
+        cls.slabs++;
+        cls.free += slab.capacity - slab.used;
+        if (slab.internal) {
+            cls.internal_slabs++;
+            out.slab_bytes_internal += kSlabBytes;
+        } else {
+            out.slab_bytes_psram += kSlabBytes;
+        }
+        slab_bytes += kSlabBytes;
+        free_bytes += (slab.capacity - slab.used) * kClassSizes[slab.cls];
+    }
+    out.allocs = allocs_;
+    out.heap_live = heap_live_;
+    out.slab_misses = slab_misses_;
+    out.slabs_released = slabs_released_;
+    unlock();
+    out.frag_pct = slab_bytes == 0 ? 0 : static_cast<uint8_t>((static_cast<uint64_t>(free_bytes) * 100u) / slab_bytes);
+}
+
+#ifdef UNIT_TEST
+void LvglMemPool::resetForTest() {
+    lock();
+    for (size_t i = 0; i < slab_count_; ++i) {
+        heap_free(slabs_[i].base);
+        slabs_[i] = Slab{};
+    }
+    slab_count_ = 0;
+    arena_ = kSharedArena;
+    closed_arenas_ = 0;
+    memset(arena_bytes_, 0, sizeof(arena_bytes_));
+    memset(used_, 0, sizeof(used_));
+    memset(peak_used_, 0, sizeof(peak_used_));
+    internal_bytes_ = 0;
+    allocs_ = 0;
+    heap_live_ = 0;
+    slab_misses_ = 0;
+    slabs_released_ = 0;
+    unlock();
+}
+#endif
+
+void *LvglMemPool::allocLocked(size_t size, uint8_t arena) {
+    const int cls = class_index(size);
+    allocs_++;
+    if (cls >= 0) {
+        Slab *slab = slabWithRoom(static_cast<uint8_t>(cls), arena);
+        if (!slab) {
+            slab = addSlab(static_cast<uint8_t>(cls), arena);
+        }
+        if (slab) {
+            arena_bytes_[arena] += kClassSizes[cls];
+            return take(*slab);
+        }
+        slab_misses_++;
+    }
+    HeapHeader *header = static_cast<HeapHeader *>(heap_alloc(sizeof(HeapHeader) + size));
+    if (!header) {
+        return nullptr;
+    }
+    header->size = static_cast<uint32_t>(size);
+    header->arena = arena;
+    heap_live_++;
+    arena_bytes_[arena] += static_cast<uint32_t>(size);
+    return header + 1;
+}
+
+void LvglMemPool::uncharge(uint8_t arena, uint32_t bytes) {
+    arena_bytes_[arena] = arena_bytes_[arena] > bytes ? arena_bytes_[arena] - bytes : 0;
+}
+
+LvglMemPool::Slab *LvglMemPool::findSlab(const void *ptr) {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    size_t lo = 0;
+    size_t hi = slab_count_;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (reinterpret_cast<uintptr_t>(slabs_[mid].base) <= addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        return nullptr;
+    }
+    Slab &slab = slabs_[lo - 1];
+    return addr < reinterpret_cast<uintptr_t>(slab.base) + kSlabBytes ? &slab : nullptr;
+}
+
+LvglMemPool::Slab *LvglMemPool::slabWithRoom(uint8_t cls, uint8_t arena) {
+    for (size_t i = 0; i < slab_count_; ++i) {
+        Slab &slab = slabs_[i];
+        if (slab.cls == cls && slab.arena == arena && (slab.free_list || slab.untouched > 0)) {
+            return &slab;
+        }
+    }
+    return nullptr;
+}
+
+LvglMemPool::Slab *LvglMemPool::addSlab(uint8_t cls, uint8_t arena) {
+    if (slab_count_ >= kMaxSlabs) {
+        return nullptr;
+    }
+    bool internal = internal_bytes_ + kSlabBytes <= kInternalBudgetBytes;
+    uint8_t *base = slab_memory(internal);
+    if (!base && internal) {
+        internal = false;
+        base = slab_memory(false);
+    }
+    if (!base) {
+        return nullptr;
+    }
+    size_t pos = slab_count_;
+    while (pos > 0 && reinterpret_cast<uintptr_t>(slabs_[pos - 1].base) > reinterpret_cast<uintptr_t>(base)) {
+        slabs_[pos] = slabs_[pos - 1];
+        pos--;
+    }
+    slab_count_++;
+    Slab &slab = slabs_[pos];
+    slab = Slab{};
+    slab.base = base;
+    slab.capacity = static_cast<uint16_t>(kSlabBytes / kClassSizes[cls]);
+    slab.untouched = slab.capacity;
+    slab.cls = cls;
+    slab.arena = arena;
+    slab.internal = internal;
+    if (internal) {
+        internal_bytes_ += kSlabBytes;
+    }
+    return &slab;
+}
+
+void LvglMemPool::releaseSlab(Slab *slab) {
+    heap_free(slab->base);
+    if (slab->internal) {
+        internal_bytes_ -= kSlabBytes;
+    }
+    slabs_released_++;
+    const size_t index = static_cast<size_t>(slab - slabs_);
+    for (size_t i = index + 1; i < slab_count_; ++i) {
+        slabs_[i - 1] = slabs_[i];
+    }
+    slab_count_--;
+    slabs_[slab_count_] = Slab{};
+}
+
+void *LvglMemPool::take(Slab &slab) {
+    void *block;
+    if (slab.free_list) {
+        block = slab.free_list;
+        slab.free_list = *static_cast<void **>(block);
+    } else {
+        block = slab.base + static_cast<size_t>(slab.capacity - slab.untouched) * kClassSizes[slab.cls];
+        slab.untouched--;
+    }
+    slab.used++;
+    if (++used_[slab.cls] > peak_used_[slab.cls]) {
+        peak_used_[slab.cls] = used_[slab.cls];
+    }
+    return block;
+}
+
+bool LvglMemPool::arenaClosed(uint8_t arena) const {
+    return arena != kSharedArena && (closed_arenas_ & (1u << arena)) != 0;
+}
+
+void LvglMemPool::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void LvglMemPool::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
+
+extern "C" void *lvgl_mem_pool_alloc(size_t size) {
+    return LvglMemPool::instance().alloc(size);
+}
+
+extern "C" void *lvgl_mem_pool_realloc(void *ptr, size_t size) {
+    return LvglMemPool::instance().realloc(ptr, size);
+}
+
+extern "C" void lvgl_mem_pool_free(void *ptr) {
+    LvglMemPool::instance().free(ptr);
+}
+
+extern "C" void lvgl_mem_pool_begin_screen(int screen_id) {
+    LvglMemPool::instance().beginArena(arena_from_screen(screen_id));
+}
+
+extern "C" void lvgl_mem_pool_end_screen(void) {
+    LvglMemPool::instance().endArena();
+}
+
+extern "C" void lvgl_mem_pool_close_screen(int screen_id) {
+    LvglMemPool::instance().closeArena(arena_from_screen(screen_id));
+}
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// Allocator behind LV_MEM_CUSTOM (see include/lvgl_mem_pool.h). Objects, styles and label
+// texts up to kMaxBlockSize come from fixed-size blocks carved out of kSlabBytes slabs, one
+// free list per slab; anything larger goes to the general heap, PSRAM first, as before.
+// Slabs are placed in internal RAM until kInternalBudgetBytes is used, then in PSRAM.
+//
+// While a screen is being built its blocks are taken from slabs of that screen's arena, so the
+// screen does not share slabs with anything else. Closing the arena on unload hands each of its
+// slabs back to the heap as soon as the asynchronous delete has emptied it: a screen that is
+// opened and closed all day costs a few 2 KiB heap blocks instead of hundreds of small ones.
+class LvglMemPool {
+public:
+    static constexpr size_t kClassCount = 5;
+    static constexpr size_t kMaxBlockSize = 256;
+    static constexpr size_t kSlabBytes = 2048;
+    static constexpr size_t kMaxSlabs = 128;
+    static constexpr size_t kInternalBudgetBytes = 40u * 1024u;
+    static constexpr uint8_t kMaxArenas = 32; // 0 is shared; screens use their screen id
+    static constexpr uint8_t kSharedArena = 0;
+
+    struct ClassStats {
+        uint16_t block_size = 0;
+        uint16_t slabs = 0;
+        uint16_t internal_slabs = 0;
+        uint32_t used = 0;
+        uint32_t free = 0;
+        uint32_t peak_used = 0;
+    };
+
+    struct Stats {
+        ClassStats classes[kClassCount];
+        uint32_t slab_bytes_internal = 0;
+        uint32_t slab_bytes_psram = 0;
+        uint32_t allocs = 0;         // allocation and reallocation calls since boot
+        uint32_t heap_live = 0;      // blocks currently on the general heap
+        uint32_t slab_misses = 0;    // small requests the heap served because no slab was left
+        uint32_t slabs_released = 0; // slabs handed back after their arena closed
+        uint8_t frag_pct = 0;        // free share of the slab space
+    };
+
+    static LvglMemPool &instance();
+    // Block size of the smallest class that holds size, 0 when it goes to the general heap.
+    static size_t classSize(size_t size);
+
+    void *alloc(size_t size);
+    void *realloc(void *ptr, size_t size);
+    void free(void *ptr);
+
+    // LVGL thread. Blocks allocated between begin and end belong to the arena.
+    void beginArena(uint8_t arena);
+    void endArena();
+    // The arena's objects are being deleted; release its slabs as they empty.
+    void closeArena(uint8_t arena);
+    // Bytes the arena's live blocks take (slab blocks at their class size, heap blocks as
+    // requested): what the screen costs to keep resident.
+    uint32_t arenaBytes(uint8_t arena) const;
+
+    void stats(Stats &out) const;
+
+#ifdef UNIT_TEST
+    void resetForTest();
+#endif
+
+private:
+    struct Slab {
+        uint8_t *base = nullptr;
+        void *free_list = nullptr;
+        uint16_t capacity = 0;
+        uint16_t untouched = 0; // blocks past the free list that were never handed out
+        uint16_t used = 0;
+        uint8_t cls = 0;
+        uint8_t arena = 0;
+        bool internal = false;
+    };
+
+    LvglMemPool();
+
+    void lock() const;
+    void unlock() const;
+    // Called with the lock held.
+    void *allocLocked(size_t size, uint8_t arena);
+    void uncharge(uint8_t arena, uint32_t bytes);
+    Slab *findSlab(const void *ptr);
+    Slab *slabWithRoom(uint8_t cls, uint8_t arena);
+    Slab *addSlab(uint8_t cls, uint8_t arena);
+    void releaseSlab(Slab *slab);
+    void *take(Slab &slab);
+    bool arenaClosed(uint8_t arena) const;
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    // Sorted by base address so free() can find the owner with a binary search.
+    Slab slabs_[kMaxSlabs];
+    size_t slab_count_ = 0;
+    uint8_t arena_ = kSharedArena;
+    uint32_t closed_arenas_ = 0;
+    uint32_t arena_bytes_[kMaxArenas] = {0};
+    uint32_t used_[kClassCount] = {0};
+    uint32_t peak_used_[kClassCount] = {0};
+    uint32_t internal_bytes_ = 0;
+    uint32_t allocs_ = 0;
+    uint32_t heap_live_ = 0;
+    uint32_t slab_misses_ = 0;
+    uint32_t slabs_released_ = 0;
+};
@@ -9,6 +9,7 @@
 #include "core/Logger.h"
 #include "ui/ui.h"
 #include "ui/styles.h"
+#include "ui/UiCardCache.h"
 
 namespace {
 
@@ -223,6 +224,8 @@ void ThemeManager::applyPreview(const ThemeColors &colors) {
                                          ? colors.screen_gradient_direction
                                          : LV_GRAD_DIR_NONE);
 
+    // Cached card backgrounds were drawn with the old colours.
+    UiCardCache::instance().invalidate();
     lv_obj_report_style_change(text);
     lv_obj_report_style_change(card);
     lv_obj_report_style_change(screen);
@@ -247,6 +250,8 @@ void ThemeManager::applyMain(const ThemeColors &colors) {
                                          ? colors.screen_gradient_direction
                                          : LV_GRAD_DIR_NONE);
 
+    // Time the new cards cached against drawn directly for a few hundred frames, then stop.
+    UiCardCache::instance().startProbing();
     lv_obj_report_style_change(text);
     lv_obj_report_style_change(card);
     lv_obj_report_style_change(screen);
@@ -12,9 +12,12 @@
 #include <WiFi.h>
 #include <esp_heap_caps.h>
 
+#include "core/BootProfiler.h"
 #include "core/BootState.h"
 #include "core/AppVersion.h"
 #include "core/Logger.h"
+#include "core/RetainedLog.h"
+#include "lvgl_mem_pool.h"
 #include "modules/FanControl.h"
 #include "modules/StorageManager.h"
 #include "ui/BootDiagPolicy.h"
@@ -137,6 +140,8 @@ void UiBootFlow::releaseBootScreens(UiController &owner) {
     if (boot_diag && lv_obj_is_valid(boot_diag)) {
         lv_obj_del_async(boot_diag);
     }
+    lvgl_mem_pool_close_screen(SCREEN_ID_PAGE_BOOT_LOGO);
+    lvgl_mem_pool_close_screen(SCREEN_ID_PAGE_BOOT_DIAG);
 
     clearBootObjectRefs(owner);
     owner.screen_events_bound_[SCREEN_ID_PAGE_BOOT_LOGO] = false;
@@ -231,6 +236,26 @@ void UiBootFlow::updateBootDiag(UiController &owner, uint32_t now_ms) {
         } else if (is_brownout_reset(boot_reset_reason)) {
             append_error_line(error_lines, sizeof(error_lines), error_len, "Brownout reset detected");
         }
+        const RetainedLog::Previous *previous = RetainedLog::instance().previous();
+        if (previous && previous->crashed) {
+            char prev_line[128];
+            if (previous->telemetry_count > 0) {
+                const RetainedLog::Telemetry &last = previous->telemetry[previous->telemetry_count - 1];
+                snprintf(prev_line, sizeof(prev_line), "Prev boot @%lus: heap min %luk, loop max %lums",
+                         static_cast<unsigned long>(last.uptime_ms / 1000UL),
+                         static_cast<unsigned long>(last.heap_min_free / 1024UL),
+                         static_cast<unsigned long>(last.loop_max_us / 1000UL));
+                append_error_line(error_lines, sizeof(error_lines), error_len, prev_line);
+            }
+            for (size_t i = previous->line_count; i-- > 0;) {
+                const RetainedLog::Line &line = previous->lines[i];
+                if (line.level <= Logger::Warn) {
+                    snprintf(prev_line, sizeof(prev_line), "Last: [%s] %s", line.tag, line.message);
+                    append_error_line(error_lines, sizeof(error_lines), error_len, prev_line);
+                    break;
+                }
+            }
+        }
     }
     if (objects.lbl_diag_heap) {
         size_t free_bytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
@@ -253,6 +278,21 @@ void UiBootFlow::updateBootDiag(UiController &owner, uint32_t now_ms) {
     if (!owner.storage.isMounted()) {
         append_error_line(error_lines, sizeof(error_lines), error_len, "Storage not mounted");
     }
+    if (objects.lbl_diag_boot) {
+        BootProfiler::Summary boot_trace;
+        BootProfiler::instance().summary(boot_trace);
+        if (!boot_trace.finished) {
+            snprintf(buf, sizeof(buf), "--");
+        } else if (boot_trace.has_previous) {
+            snprintf(buf, sizeof(buf), "%lu ms (prev %lu ms)",
+                     static_cast<unsigned long>(boot_trace.total_us / 1000UL),
+                     static_cast<unsigned long>(boot_trace.previous_total_us / 1000UL));
+        } else {
+            snprintf(buf, sizeof(buf), "%lu ms",
+                     static_cast<unsigned long>(boot_trace.total_us / 1000UL));
+        }
+        owner.safe_label_set_text(objects.lbl_diag_boot, buf);
+    }
     if (objects.lbl_diag_i2c) {
         owner.safe_label_set_text(objects.lbl_diag_i2c,
                                   boot_i2c_recovered ? UiText::BootDiagRecovered() : UiText::BootDiagFail());
@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "ui/UiCardBackdrop.h"
+
+#include <string.h>
+
+#include "ui/UiCardCache.h"
+#include "ui/styles.h"
+
+#ifdef UNIT_TEST
+#include <chrono>
+#else
+#include <esp_timer.h>
+#endif
+
+namespace {
+
+constexpr size_t kMaxPending = 4;
+constexpr size_t kBuildsPerFrame = 1;
+constexpr lv_coord_t kMaxSide = 1024;
+
+struct Backdrop {
+    UiCardCache::Key key{};
+    lv_draw_rect_dsc_t dsc;
+    lv_coord_t card_w = 0;
+    lv_coord_t card_h = 0;
+    lv_coord_t ext = 0; // shadow reach past the card on every side
+};
+
+Backdrop pending_[kMaxPending];
+size_t pending_count_ = 0;
+lv_obj_t *canvas_ = nullptr;
+
+uint32_t now_us() {
+#ifdef UNIT_TEST
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+#else
+    return static_cast<uint32_t>(esp_timer_get_time());
+#endif
+}
+
+uint32_t pack(uint32_t lo, uint32_t hi) {
+    return (lo & 0xFFFFu) | (hi << 16);
+}
+
+lv_coord_t side(const Backdrop &b, lv_coord_t card) {
+    return static_cast<lv_coord_t>(card + 2 * b.ext);
+}
+
+bool worth_caching(const lv_draw_rect_dsc_t &dsc) {
+    if (dsc.bg_img_src != nullptr || dsc.blend_mode != LV_BLEND_MODE_NORMAL) {
+        return false;
+    }
+    const bool shadow = dsc.shadow_opa > LV_OPA_MIN && dsc.shadow_width > 0;
+    const bool gradient = dsc.bg_opa > LV_OPA_MIN && dsc.bg_grad.dir != LV_GRAD_DIR_NONE;
+    return shadow || gradient;
+}
+
+// Everything lv_draw_rect would put under the card's children, minus the outline, which is
+// left to LVGL, and the border when the style draws it after the children.
+bool describe(const lv_area_t &coords, const lv_draw_rect_dsc_t &dsc, Backdrop &out) {
+    out = Backdrop{};
+    out.dsc = dsc;
+    out.dsc.outline_opa = LV_OPA_TRANSP;
+    if (dsc.border_post) {
+        out.dsc.border_opa = LV_OPA_TRANSP;
+    }
+    lv_draw_rect_dsc_t &d = out.dsc;
+    if (d.shadow_opa > LV_OPA_MIN && d.shadow_width > 0) {
+        const lv_coord_t ofs = LV_MAX(LV_ABS(d.shadow_ofs_x), LV_ABS(d.shadow_ofs_y));
+        out.ext = static_cast<lv_coord_t>(d.shadow_width / 2 + 1 + LV_MAX(d.shadow_spread, 0) + ofs);
+    } else {
+        d.shadow_opa = LV_OPA_TRANSP;
+    }
+    out.card_w = lv_area_get_width(&coords);
+    out.card_h = lv_area_get_height(&coords);
+    if (out.card_w <= 0 || out.card_h <= 0 || side(out, out.card_w) > kMaxSide ||
+        side(out, out.card_h) > kMaxSide) {
+        return false;
+    }
+
+    uint32_t *w = out.key.words;
+    w[0] = pack(out.card_w, out.card_h);
+    w[1] = pack(d.radius, out.ext);
+    w[2] = pack(d.bg_color.full, d.bg_opa | (d.bg_grad.dir << 8));
+    w[3] = pack(d.bg_grad.stops[0].color.full, d.bg_grad.stops[0].frac | (d.bg_grad.stops[1].frac << 8));
+    w[4] = pack(d.bg_grad.stops[1].color.full, d.bg_grad.stops_count | (d.bg_grad.dither << 8));
+    w[5] = pack(d.border_color.full, d.border_opa | (d.border_side << 8));
+    w[6] = pack(d.border_width, d.shadow_width);
+    w[7] = pack(d.shadow_color.full, d.shadow_opa);
+    w[8] = pack(static_cast<uint16_t>(d.shadow_ofs_x), static_cast<uint16_t>(d.shadow_ofs_y));
+    w[9] = static_cast<uint16_t>(d.shadow_spread);
+    return true;
+}
+
+uint32_t image_bytes(const Backdrop &b) {
+    return LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(side(b, b.card_w), side(b, b.card_h));
+}
+
+void queue(const Backdrop &b) {
+    for (size_t i = 0; i < pending_count_; ++i) {
+        if (memcmp(pending_[i].key.words, b.key.words, sizeof(b.key.words)) == 0) {
+            return;
+        }
+    }
+    if (pending_count_ < kMaxPending) {
+        pending_[pending_count_++] = b;
+    }
+}
+
+void build(const Backdrop &b) {
+    UiCardCache &cache = UiCardCache::instance();
+    const uint32_t start_us = now_us();
+    uint8_t *pixels = cache.insert(b.key, image_bytes(b));
+    if (!pixels) {
+        return;
+    }
+    if (!canvas_) {
+        // A detached screen: never loaded, only used to draw into the cache buffers.
+        canvas_ = lv_canvas_create(nullptr);
+    }
+    memset(pixels, 0, image_bytes(b)); // fully transparent
+    lv_canvas_set_buffer(canvas_, pixels, side(b, b.card_w), side(b, b.card_h), LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_canvas_draw_rect(canvas_, b.ext, b.ext, b.card_w, b.card_h, &b.dsc);
+    cache.noteBuildTime(now_us() - start_us);
+}
+
+void on_draw_part_begin(lv_event_t *e) {
+    lv_obj_draw_part_dsc_t *part = lv_event_get_draw_part_dsc(e);
+    if (part->class_p != &lv_obj_class || part->type != LV_OBJ_DRAW_PART_RECTANGLE ||
+        part->part != LV_PART_MAIN || !part->rect_dsc || !part->draw_area) {
+        return;
+    }
+    lv_draw_rect_dsc_t *rect = part->rect_dsc;
+    if (!worth_caching(*rect)) {
+        return;
+    }
+    UiCardCache &cache = UiCardCache::instance();
+    if (!cache.enabled() || cache.probeFrame()) {
+        cache.noteDirectDraw();
+        return;
+    }
+    Backdrop backdrop;
+    if (!describe(*part->draw_area, *rect, backdrop)) {
+        return;
+    }
+    const uint8_t *pixels = cache.find(backdrop.key);
+    if (!pixels) {
+        queue(backdrop);
+        cache.noteDirectDraw();
+        return;
+    }
+
+    lv_img_dsc_t img;
+    memset(&img, 0, sizeof(img));
+    img.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img.header.w = side(backdrop, backdrop.card_w);
+    img.header.h = side(backdrop, backdrop.card_h);
+    img.data_size = image_bytes(backdrop);
+    img.data = pixels;
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    lv_area_t area = *part->draw_area;
+    lv_area_increase(&area, backdrop.ext, backdrop.ext);
+    lv_draw_img(part->draw_ctx, &img_dsc, &area, &img);
+
+    // The outline, and a border drawn after the children, stay with LVGL.
+    rect->bg_opa = LV_OPA_TRANSP;
+    rect->shadow_opa = LV_OPA_TRANSP;
+    if (!rect->border_post) {
+        rect->border_opa = LV_OPA_TRANSP;
+    }
+}
+
+bool uses_card_style(const lv_obj_t *obj, const lv_style_t *card_style) {
+    for (uint32_t i = 0; i < obj->style_cnt; ++i) {
+        if (obj->styles[i].style == card_style) {
+            return true;
+        }
+    }
+    return false;
+}
+
+lv_obj_tree_walk_res_t attach_card(lv_obj_t *obj, void *user_data) {
+    if (uses_card_style(obj, static_cast<const lv_style_t *>(user_data))) {
+        lv_obj_remove_event_cb(obj, on_draw_part_begin);
+        lv_obj_add_event_cb(obj, on_draw_part_begin, LV_EVENT_DRAW_PART_BEGIN, nullptr);
+    }
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+} // namespace
+
+namespace UiCardBackdrop {
+
+void attach(lv_obj_t *root) {
+#if LV_COLOR_SCREEN_TRANSP
+    // Drawing an alpha canvas needs LV_COLOR_SCREEN_TRANSP; without it cards are drawn directly.
+    if (root) {
+        lv_obj_tree_walk(root, attach_card, get_style_style_card_base_MAIN_DEFAULT());
+    }
+#else
+    (void)root;
+#endif
+}
+
+void endFrame(uint32_t frame_us) {
+    UiCardCache::instance().noteFrame(frame_us);
+    size_t built = 0;
+    while (pending_count_ > 0 && built < kBuildsPerFrame) {
+        build(pending_[0]);
+        pending_count_--;
+        memmove(&pending_[0], &pending_[1], pending_count_ * sizeof(pending_[0]));
+        built++;
+    }
+}
+
+} // namespace UiCardBackdrop
@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdint.h>
+
+// Draws theme cards from UiCardCache. A card whose theme adds a shadow or a gradient costs a
+// blur and a per-line colour ramp every time anything inside it changes; with the hook attached
+// LVGL blits the pre-rendered background instead and only draws what sits on top of it.
+//
+// A card without a cached background is drawn normally and its background is queued; endFrame()
+// renders the queue into PSRAM once the refresh is over, so a build never runs inside a draw.
+//
+// LVGL thread only.
+namespace UiCardBackdrop {
+
+// Hooks every object under `root` that uses the card base style. Safe to call again.
+void attach(lv_obj_t *root);
+// After a refresh that flushed pixels: records the frame time and builds queued backgrounds.
+void endFrame(uint32_t frame_us);
+
+} // namespace UiCardBackdrop
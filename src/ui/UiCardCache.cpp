@@ -0,0 +1,284 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "ui/UiCardCache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef UNIT_TEST
+#include <esp_heap_caps.h>
+#endif
+
+namespace {
+
+constexpr uint32_t kAverageWeight = 16;
+
+uint8_t *pixel_alloc(uint32_t bytes) {
+#ifdef UNIT_TEST
+    return static_cast<uint8_t *>(malloc(bytes));
+#else
+    // PSRAM only: internal RAM is worth more to the draw buffers than to a cache.
+    return static_cast<uint8_t *>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+#endif
+}
+
+void pixel_free(uint8_t *pixels) {
+#ifdef UNIT_TEST
+    free(pixels);
+#else
+    heap_caps_free(pixels);
+#endif
+}
+
+} // namespace
+
+UiCardCache &UiCardCache::instance() {
+    static UiCardCache cache;
+    return cache;
+}
+
+UiCardCache::UiCardCache() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+void UiCardCache::reset() {
+    lock();
+    for (Entry &entry : entries_) {
+        dropEntry(entry);
+    }
+    enabled_ = true;
+    probe_ = false;
+    use_seq_ = 0;
+    card_frames_ = 0;
+    probe_frames_left_ = 0;
+    frame_cached_draws_ = 0;
+    frame_direct_draws_ = 0;
+    hits_ = 0;
+    builds_ = 0;
+    evictions_ = 0;
+    invalidations_ = 0;
+    build_us_max_ = 0;
+    frames_cached_ = 0;
+    frames_direct_ = 0;
+    frame_us_cached_ = 0;
+    frame_us_direct_ = 0;
+    unlock();
+}
+
+void UiCardCache::setEnabled(bool enabled) {
+    lock();
+    enabled_ = enabled;
+    if (!enabled) {
+        probe_ = false;
+        for (Entry &entry : entries_) {
+            dropEntry(entry);
+        }
+    }
+    unlock();
+}
+
+bool UiCardCache::enabled() const {
+    lock();
+    const bool enabled = enabled_;
+    unlock();
+    return enabled;
+}
+
+void UiCardCache::invalidate() {
+    lock();
+    for (Entry &entry : entries_) {
+        dropEntry(entry);
+    }
+    invalidations_++;
+    unlock();
+}
+
+const uint8_t *UiCardCache::find(const Key &key) {
+    lock();
+    const uint8_t *pixels = nullptr;
+    for (Entry &entry : entries_) {
+        if (entry.pixels && sameKey(entry.key, key)) {
+            entry.last_used = ++use_seq_;
+            pixels = entry.pixels;
+            hits_++;
+            frame_cached_draws_++;
+            break;
+        }
+    }
+    unlock();
+    return pixels;
+}
+
+uint8_t *UiCardCache::insert(const Key &key, uint32_t bytes) {
+    if (bytes == 0 || bytes > kBudgetBytes) {
+        return nullptr;
+    }
+    lock();
+    if (!enabled_) {
+        unlock();
+        return nullptr;
+    }
+    Entry *slot = nullptr;
+    for (Entry &entry : entries_) {
+        if (entry.pixels && sameKey(entry.key, key)) {
+            dropEntry(entry);
+        }
+        if (!entry.pixels && !slot) {
+            slot = &entry;
+        }
+    }
+    while (!slot || bytes_ + bytes > kBudgetBytes) {
+        Entry *oldest = victim();
+        if (!oldest) {
+            break;
+        }
+        dropEntry(*oldest);
+        evictions_++;
+        if (!slot) {
+            slot = oldest;
+        }
+    }
+    uint8_t *pixels = nullptr;
+    if (slot && bytes_ + bytes <= kBudgetBytes) {
+        pixels = pixel_alloc(bytes);
+    }
+    if (pixels) {
+        slot->key = key;
+        slot->pixels = pixels;
+        slot->bytes = bytes;
+        slot->last_used = ++use_seq_;
+        bytes_ += bytes;
+        builds_++;
+    }
+    unlock();
+    return pixels;
+}
+
+void UiCardCache::noteBuildTime(uint32_t build_us) {
+    lock();
+    if (build_us > build_us_max_) {
+        build_us_max_ = build_us;
+    }
+    unlock();
+}
+
+void UiCardCache::startProbing() {
+    lock();
+    card_frames_ = 0;
+    probe_frames_left_ = kProbeWindowFrames;
+    unlock();
+}
+
+bool UiCardCache::probeFrame() const {
+    lock();
+    const bool probe = probe_;
+    unlock();
+    return probe;
+}
+
+void UiCardCache::noteDirectDraw() {
+    lock();
+    frame_direct_draws_++;
+    unlock();
+}
+
+void UiCardCache::noteFrame(uint32_t frame_us) {
+    lock();
+    if (probe_ && frame_direct_draws_ > 0) {
+        frames_direct_++;
+        frame_us_direct_ = average(frame_us_direct_, frame_us, frames_direct_);
+    } else if (!probe_ && frame_cached_draws_ > 0 && frame_direct_draws_ == 0) {
+        frames_cached_++;
+        frame_us_cached_ = average(frame_us_cached_, frame_us, frames_cached_);
+    }
+    // A probe waits for a frame that actually redraws a card.
+    if (frame_cached_draws_ > 0 || frame_direct_draws_ > 0) {
+        if (probe_frames_left_ > 0) {
+            probe_frames_left_--;
+            card_frames_++;
+        }
+        probe_ = enabled_ && probe_frames_left_ > 0 && (card_frames_ % kProbeEvery) == 0;
+    }
+    frame_cached_draws_ = 0;
+    frame_direct_draws_ = 0;
+    unlock();
+}
+
+void UiCardCache::stats(Stats &out) const {
+    out = Stats{};
+    lock();
+    for (const Entry &entry : entries_) {
+        if (entry.pixels) {
+            out.entries++;
+        }
+    }
+    out.enabled = enabled_;
+    out.bytes = bytes_;
+    out.hits = hits_;
+    out.builds = builds_;
+    out.evictions = evictions_;
+    out.invalidations = invalidations_;
+    out.build_us_max = build_us_max_;
+    out.frames_cached = frames_cached_;
+    out.frames_direct = frames_direct_;
+    out.frame_us_cached = frame_us_cached_;
+    out.frame_us_direct = frame_us_direct_;
+    unlock();
+}
+
+bool UiCardCache::sameKey(const Key &a, const Key &b) {
+    return memcmp(a.words, b.words, sizeof(a.words)) == 0;
+}
+
+uint32_t UiCardCache::average(uint32_t avg, uint32_t sample, uint32_t count) {
+    if (count <= 1) {
+        return sample;
+    }
+    const int64_t delta = static_cast<int64_t>(sample) - static_cast<int64_t>(avg);
+    return static_cast<uint32_t>(static_cast<int64_t>(avg) + delta / kAverageWeight);
+}
+
+void UiCardCache::dropEntry(Entry &entry) {
+    if (!entry.pixels) {
+        return;
+    }
+    pixel_free(entry.pixels);
+    bytes_ -= entry.bytes;
+    entry = Entry{};
+}
+
+UiCardCache::Entry *UiCardCache::victim() {
+    Entry *oldest = nullptr;
+    for (Entry &entry : entries_) {
+        if (entry.pixels && (!oldest || entry.last_used < oldest->last_used)) {
+            oldest = &entry;
+        }
+    }
+    return oldest;
+}
+
+void UiCardCache::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void UiCardCache::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// Pre-rendered card backgrounds (fill, gradient, border and shadow) kept in PSRAM, keyed by
+// everything that changes how a card looks, size included. UiCardBackdrop does the LVGL side;
+// this class owns the pixel buffers, the byte budget and the frame-time comparison.
+//
+// To see what the cache buys, startProbing() opens a window of kProbeWindowFrames frames that
+// redraw a card, in which every kProbeEvery-th frame draws all cards directly. Outside a window
+// every card is blitted. Frames served from the cache and probe frames are averaged separately;
+// frames that had to queue a build count in neither.
+//
+// Driven from the LVGL thread; stats() may be called from any task.
+class UiCardCache {
+public:
+    static constexpr size_t kKeyWords = 10;
+    static constexpr size_t kMaxEntries = 24;
+    static constexpr uint32_t kBudgetBytes = 1536u * 1024u;
+    static constexpr uint32_t kProbeEvery = 32;
+    static constexpr uint32_t kProbeWindowFrames = 8 * kProbeEvery;
+
+    struct Key {
+        uint32_t words[kKeyWords] = {};
+    };
+
+    struct Stats {
+        bool enabled = true;
+        uint8_t entries = 0;
+        uint32_t bytes = 0;
+        uint32_t budget_bytes = kBudgetBytes;
+        uint32_t hits = 0;          // card draws served by a blit
+        uint32_t builds = 0;
+        uint32_t evictions = 0;
+        uint32_t invalidations = 0; // theme changes that dropped every entry
+        uint32_t build_us_max = 0;
+        uint32_t frames_cached = 0;
+        uint32_t frames_direct = 0;
+        uint32_t frame_us_cached = 0; // running averages of the frames each side
+        uint32_t frame_us_direct = 0;
+    };
+
+    static UiCardCache &instance();
+
+    void reset();
+    void setEnabled(bool enabled);
+    bool enabled() const;
+    // Drops every entry; the next draw of each card queues a new build.
+    void invalidate();
+
+    // Pixels of a built background, nullptr when there is none. A hit counts as a cached draw.
+    const uint8_t *find(const Key &key);
+    // Buffer for a new background of `bytes`, evicting the least recently drawn entries to
+    // make room. nullptr when it cannot fit.
+    uint8_t *insert(const Key &key, uint32_t bytes);
+    void noteBuildTime(uint32_t build_us);
+
+    // Called when the main theme is applied, the one time the comparison is worth its frames.
+    void startProbing();
+    // True while the current frame draws every card directly for the comparison.
+    bool probeFrame() const;
+    void noteDirectDraw();
+    // One refresh that flushed pixels finished after frame_us.
+    void noteFrame(uint32_t frame_us);
+
+    void stats(Stats &out) const;
+
+private:
+    struct Entry {
+        Key key{};
+        uint8_t *pixels = nullptr;
+        uint32_t bytes = 0;
+        uint32_t last_used = 0;
+    };
+
+    UiCardCache();
+
+    static bool sameKey(const Key &a, const Key &b);
+    static uint32_t average(uint32_t avg, uint32_t sample, uint32_t count);
+    void dropEntry(Entry &entry);
+    Entry *victim();
+    void lock() const;
+    void unlock() const;
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    Entry entries_[kMaxEntries]{};
+    bool enabled_ = true;
+    bool probe_ = false;
+    uint32_t use_seq_ = 0;
+    uint32_t bytes_ = 0;
+    uint32_t card_frames_ = 0;
+    uint32_t probe_frames_left_ = 0;
+    uint32_t frame_cached_draws_ = 0;
+    uint32_t frame_direct_draws_ = 0;
+    uint32_t hits_ = 0;
+    uint32_t builds_ = 0;
+    uint32_t evictions_ = 0;
+    uint32_t invalidations_ = 0;
+    uint32_t build_us_max_ = 0;
+    uint32_t frames_cached_ = 0;
+    uint32_t frames_direct_ = 0;
+    uint32_t frame_us_cached_ = 0;
+    uint32_t frame_us_direct_ = 0;
+};
@@ -0,0 +1,12 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+// The linked Noto Sans SC 14 px font under another name, drawn by UiPackedFonts when the
+// LittleFS pack is missing or lacks a glyph (see AURA_CJK_LINKED_FALLBACK in platformio.ini).
+#if AURA_CJK_LINKED_FALLBACK
+#define ui_font_noto_sans_sc_reg_14 ui_font_noto_sans_sc_reg_14_linked
+#include "ui_font_noto_sans_sc_reg_14.c"
+#endif
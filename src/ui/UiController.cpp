@@ -6,12 +6,15 @@
 
 #include "ui/UiController.h"
 #include "ui/BootDiagPolicy.h"
+#include "ui/UiCardBackdrop.h"
 #include "ui/UiLocalization.h"
 #include "ui/UiRenderLoop.h"
+#include "ui/UiScreenCache.h"
 #include "ui/UiScreenFlow.h"
 #include "ui/UiText.h"
 
 #include <ctype.h>
+#include <stdarg.h>
 #include <math.h>
 #include <string.h>
 #include <time.h>
@@ -24,11 +27,14 @@
 #include "ui/images.h"
 #include "ui/StatusMessages.h"
 #include "config/AppConfig.h"
+#include "core/BootProfiler.h"
 #include "core/BootState.h"
 #include "core/AppVersion.h"
 #include "core/AirQualityEngine.h"
 #include "core/Logger.h"
 #include "core/SafeRestart.h"
+#include "core/SensorCommandQueue.h"
+#include "core/TaskProfiler.h"
 #include "web/WebRuntime.h"
 #include "core/SystemLogFilter.h"
 #include "modules/StorageManager.h"
@@ -41,6 +47,7 @@
 #include "ui/BacklightManager.h"
 #include "ui/NightModeManager.h"
 #include "ui/UiEventBinder.h"
+#include "ui/UiWidgetBinding.h"
 
 using namespace Config;
 
@@ -64,11 +71,17 @@ constexpr uint32_t UI_POOR_GAS_BG_HEX = 0xEB0000;
 constexpr uint32_t UI_HIGH_CO2_BG_HEX = 0xB36B00;
 constexpr float UI_POOR_GAS_BG_HYSTERESIS_RATIO = 0.05f;
 constexpr int UI_HIGH_CO2_BG_ON_PPM = 3000;
-constexpr size_t UI_DIAG_LOG_MAX_LINES = 17;
+constexpr size_t UI_DIAG_LOG_MAX_LINES = 12;
 constexpr size_t UI_DIAG_LOG_RECENT_MAX = 32;
 constexpr size_t UI_DIAG_LOG_TEXT_CAPACITY = 2048;
 constexpr size_t UI_DIAG_LOG_LINE_CAPACITY = 128;
 constexpr size_t UI_DIAG_LOG_MESSAGE_MAX_CHARS = 54;
+// The task and heap profile sits under the log inside card_diag.
+constexpr lv_coord_t UI_DIAG_LOG_HEIGHT = 256;
+constexpr lv_coord_t UI_DIAG_PROFILE_Y = 270;
+constexpr lv_coord_t UI_DIAG_PROFILE_HEIGHT = 96;
+constexpr size_t UI_DIAG_PROFILE_TEXT_CAPACITY = 512;
+constexpr size_t UI_DIAG_PROFILE_TOP_TASKS = 3;
 
 String trim_copy(const String &value) {
     const char *begin = value.c_str();
@@ -95,6 +108,7 @@ String trim_copy(const String &value) {
 }
 
 Logger::RecentEntry g_diag_log_snapshot[UI_DIAG_LOG_RECENT_MAX];
+TaskProfiler::Snapshot g_diag_profile_snapshot;
 
 enum class SettingsLogSeverity : uint8_t {
     Ok = 0,
@@ -163,14 +177,7 @@ char diag_log_level_char(Logger::Level level) {
 }
 
 void set_label_hidden(lv_obj_t *label, bool hidden) {
-    if (!label) {
-        return;
-    }
-    if (hidden) {
-        lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
-    } else {
-        lv_obj_clear_flag(label, LV_OBJ_FLAG_HIDDEN);
-    }
+    UiWidgetBinding::setVisible(label, !hidden);
 }
 
 void format_clock_time_label(const tm &local_tm,
@@ -296,6 +303,102 @@ bool append_diag_log_line(char *text,
     return true;
 }
 
+void append_text(char *text, size_t capacity, size_t &used, const char *fmt, ...) {
+    if (used + 1 >= capacity) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    const int written = vsnprintf(text + used, capacity - used, fmt, args);
+    va_end(args);
+    if (written > 0) {
+        used += static_cast<size_t>(written);
+        if (used >= capacity) {
+            used = capacity - 1;
+        }
+    }
+}
+
+// "512", "84.2k", "7.9M"
+void format_bytes_short(uint32_t bytes, char *out, size_t out_size) {
+    if (bytes >= 1024UL * 1024UL) {
+        snprintf(out, out_size, "%.1fM", bytes / (1024.0f * 1024.0f));
+    } else if (bytes >= 1024UL) {
+        snprintf(out, out_size, "%.1fk", bytes / 1024.0f);
+    } else {
+        snprintf(out, out_size, "%lu", static_cast<unsigned long>(bytes));
+    }
+}
+
+void format_diag_profile(const TaskProfiler::Snapshot &profile, char *text, size_t capacity) {
+    size_t used = 0;
+    text[0] = '\0';
+    char a[12];
+    char b[12];
+
+    append_text(text, capacity, used, "CPU ");
+    bool has_cpu = false;
+    for (size_t c = 0; c < TaskProfiler::kCores; ++c) {
+        if (profile.core_busy_permille[c] != TaskProfiler::kNoCpu) {
+            append_text(text, capacity, used, " core%u %u%%", static_cast<unsigned>(c),
+                        static_cast<unsigned>((profile.core_busy_permille[c] + 5) / 10));
+            has_cpu = true;
+        }
+    }
+    if (has_cpu) {
+        append_text(text, capacity, used, "  |");
+        size_t shown = 0;
+        for (size_t i = 0; i < profile.task_count && shown < UI_DIAG_PROFILE_TOP_TASKS; ++i) {
+            const TaskProfiler::Task &task = profile.tasks[i];
+            if (task.idle || task.cpu_permille == TaskProfiler::kNoCpu) {
+                continue;
+            }
+            const char *name = strcmp(task.name, "loopTask") == 0 ? "main" : task.name;
+            append_text(text, capacity, used, "  %s %u%%", name,
+                        static_cast<unsigned>((task.cpu_permille + 5) / 10));
+            shown++;
+        }
+    } else {
+        append_text(text, capacity, used, " --");
+    }
+
+    append_text(text, capacity, used, "\nStack free");
+    for (size_t w = 0; w < TaskProfiler::kWatchedCount; ++w) {
+        if (profile.watched_stack_free[w] == TaskProfiler::kNoStack) {
+            continue;
+        }
+        format_bytes_short(profile.watched_stack_free[w], a, sizeof(a));
+        append_text(text, capacity, used, "  %s %s", TaskProfiler::watchedName(w), a);
+    }
+
+    format_bytes_short(profile.heap.internal_free, a, sizeof(a));
+    format_bytes_short(profile.heap.internal_largest, b, sizeof(b));
+    append_text(text, capacity, used, "\nHeap  int %s, block %s (%u%% frag)", a, b,
+                static_cast<unsigned>(profile.internal_frag_pct));
+    if (profile.heap.psram_free > 0) {
+        format_bytes_short(profile.heap.psram_free, a, sizeof(a));
+        format_bytes_short(profile.heap.psram_largest, b, sizeof(b));
+        append_text(text, capacity, used, "   psram %s, block %s (%u%% frag)", a, b,
+                    static_cast<unsigned>(profile.psram_frag_pct));
+    }
+
+    append_text(text, capacity, used, "\nAlerts");
+    if (profile.alerts == 0) {
+        append_text(text, capacity, used, "  none");
+    }
+    for (size_t w = 0; w < TaskProfiler::kWatchedCount; ++w) {
+        if (profile.alerts & (1u << w)) {
+            append_text(text, capacity, used, "  %s stack", TaskProfiler::watchedName(w));
+        }
+    }
+    if (profile.alerts & TaskProfiler::AlertInternalHeap) {
+        append_text(text, capacity, used, "  internal heap");
+    }
+    if (profile.alerts & TaskProfiler::AlertInternalBlock) {
+        append_text(text, capacity, used, "  fragmentation");
+    }
+}
+
 SettingsLogSeverity summarize_settings_log_severity(uint32_t acknowledged_alert_seq) {
     Logger::RecentEntry recent[8];
     const size_t count = Logger::copyRecentAlerts(recent, sizeof(recent) / sizeof(recent[0]));
@@ -327,7 +430,7 @@ UiController::UiController(const UiContext &context)
       webUiBridge(context.webUiBridge),
       networkCommandQueue(context.networkCommandQueue),
       sensorManager(context.sensorManager),
-      chartsHistory(context.chartsHistory),
+      chartsRuntimeState(context.chartsRuntimeState),
       timeManager(context.timeManager),
       themeManager(context.themeManager),
       backlightManager(context.backlightManager),
@@ -807,7 +910,8 @@ void UiController::bind_screen_events_once(int screen_id) {
     if (screen_id <= 0 || screen_id >= static_cast<int>(kScreenSlotCount)) {
         return;
     }
-    if (!UiEventBinder::screenRootById(screen_id)) {
+    lv_obj_t *root = UiEventBinder::screenRootById(screen_id);
+    if (!root) {
         return;
     }
     if (screen_events_bound_[screen_id]) {
@@ -815,6 +919,7 @@ void UiController::bind_screen_events_once(int screen_id) {
     }
 
     bind_available_events(screen_id);
+    UiCardBackdrop::attach(root);
     apply_toggle_styles_for_available_objects(screen_id);
     apply_checked_states_for_available_objects(screen_id);
     refresh_texts_for_screen(screen_id);
@@ -839,12 +944,16 @@ void UiController::begin() {
         LOGE("UI", "LVGL lock failed in begin");
         return;
     }
+    BootProfiler &profiler = BootProfiler::instance();
+    uint8_t stage = profiler.begin("screens");
     ui_init();
+    profiler.end(stage);
+    stage = profiler.begin("theme");
     themeManager.initAfterUi(storage, night_mode, datetime_ui_dirty);
+    profiler.end(stage);
     if (night_mode) {
         night_mode_on_enter();
     }
-    init_ui_defaults();
     if (objects.label_boot_ver) {
         char version_text[32];
         snprintf(version_text, sizeof(version_text), "v%s", AppVersion::fullVersion());
@@ -864,13 +973,13 @@ void UiController::begin() {
     lvgl_diag_stall_since_ms = 0;
     boot_release_at_ms = 0;
     boot_ui_released = false;
-    deferred_unload_.reset();
-    reset_dynamic_url_caches();
-    wifi_icon_state = -1;
-    mqtt_icon_state = -1;
-    wifi_icon_state_main = -1;
-    mqtt_icon_state_main = -1;
-    last_dac_ui_update_ms = 0;
+    UiScreenCache &screen_cache = UiScreenCache::instance();
+    screen_cache.reset();
+    screen_cache.setPinned(SCREEN_ID_PAGE_BOOT_LOGO, true);
+    screen_cache.setPinned(SCREEN_ID_PAGE_BOOT_DIAG, true);
+    screen_cache.setPinned(SCREEN_ID_PAGE_MAIN_PRO, true);
+    screen_cache.setPinned(SCREEN_ID_PAGE_SETTINGS, true);
+    screen_cache.setHint(SCREEN_ID_PAGE_MAIN_PRO, SCREEN_ID_PAGE_SENSORS_INFO);
     if (objects.page_boot_logo) {
         loadScreen(SCREEN_ID_PAGE_BOOT_LOGO);
         bind_screen_events_once(SCREEN_ID_PAGE_BOOT_LOGO);
@@ -887,6 +996,26 @@ void UiController::begin() {
         LOGW("UI", "LVGL unlock failed in begin");
     }
     last_clock_tick_ms = millis();
+}
+
+void UiController::bindInitialData() {
+    if (!lvgl_ready) {
+        return;
+    }
+    if (!lvgl_port_lock(-1)) {
+        LOGE("UI", "LVGL lock failed in bindInitialData");
+        return;
+    }
+    init_ui_defaults();
+    reset_dynamic_url_caches();
+    wifi_icon_state = -1;
+    mqtt_icon_state = -1;
+    wifi_icon_state_main = -1;
+    mqtt_icon_state_main = -1;
+    last_dac_ui_update_ms = 0;
+    if (!lvgl_port_unlock()) {
+        LOGW("UI", "LVGL unlock failed in bindInitialData");
+    }
     publishWebUiSnapshot();
 }
 
@@ -1028,7 +1157,7 @@ bool UiController::webSetOffsets(float temp_offset_c, float hum_offset_pct) {
     bool changed = (temp_next != temp_offset) || (hum_next != hum_offset);
     temp_offset = temp_next;
     hum_offset = hum_next;
-    sensorManager.setOffsets(temp_offset, hum_offset);
+    apply_sensor_offsets();
     temp_offset_ui_dirty = true;
     hum_offset_ui_dirty = true;
 
@@ -1051,7 +1180,7 @@ bool UiController::webSetOffsets(float temp_offset_c, float hum_offset_pct) {
         hum_offset_dirty = prev_hum_offset_dirty;
         storage.config().temp_offset = prev_cfg_temp_offset;
         storage.config().hum_offset = prev_cfg_hum_offset;
-        sensorManager.setOffsets(temp_offset, hum_offset);
+        apply_sensor_offsets();
         temp_offset_ui_dirty = true;
         hum_offset_ui_dirty = true;
         LOGE("UI", "failed to persist sensor offsets");
@@ -1073,7 +1202,7 @@ void UiController::apply_pending_screen_now_from_web() {
     }
     const uint32_t now = millis();
     UiScreenFlow::processPendingScreen(*this, now);
-    UiScreenFlow::processDeferredUnloads(*this, now);
+    UiScreenFlow::processResidentScreens(*this, now);
     lvgl_port_unlock();
 }
 
@@ -1166,6 +1295,8 @@ void UiController::poll(uint32_t now) {
         return;
     }
 
+    poll_sensor_command_results();
+
     lvgl_port_diagnostics_t lvgl_diag = {};
     if (lvgl_port_get_diagnostics(&lvgl_diag)) {
         if ((now - lvgl_diag_last_heartbeat_ms) >= UI_LVGL_DIAG_HEARTBEAT_MS) {
@@ -1190,7 +1321,7 @@ void UiController::poll(uint32_t now) {
                 (!suppress_expected_lock_fail_warning && lock_fail_delta > 0) ||
                 touch_err_delta >= UI_LVGL_DIAG_TOUCH_WARN_DELTA) {
                 LOGW("UI",
-                     "LVGL heartbeat: handler=%lu(age=%lu ms), flush=%lu(age=%lu ms), vsync=%lu(age=%lu ms), lock_fail=%lu(+%lu), touch_err=%lu(+%lu), paused=%s",
+                     "LVGL heartbeat: handler=%lu(age=%lu ms), flush=%lu(age=%lu ms), vsync=%lu(age=%lu ms), lock_fail=%lu(+%lu), touch_err=%lu(+%lu), frame=%lu us(max %lu, cards cached=%lu direct=%lu), paused=%s",
                      static_cast<unsigned long>(lvgl_diag.timer_handler_count),
                      static_cast<unsigned long>(lvgl_diag.timer_handler_age_ms),
                      static_cast<unsigned long>(lvgl_diag.flush_count),
@@ -1201,6 +1332,10 @@ void UiController::poll(uint32_t now) {
                      static_cast<unsigned long>(lock_fail_delta),
                      static_cast<unsigned long>(lvgl_diag.touch_read_error_count),
                      static_cast<unsigned long>(touch_err_delta),
+                     static_cast<unsigned long>(lvgl_diag.frame_us_avg),
+                     static_cast<unsigned long>(lvgl_diag.frame_us_max),
+                     static_cast<unsigned long>(lvgl_diag.card_frame_us_cached),
+                     static_cast<unsigned long>(lvgl_diag.card_frame_us_direct),
                      lvgl_diag.paused ? "YES" : "NO");
             }
         }
@@ -1278,19 +1413,21 @@ void UiController::poll(uint32_t now) {
         }
     }
 
+    // The diagnostics screen is not built yet: navigating to it builds it.
     if (boot_logo_active &&
-        (now - boot_logo_start_ms) >= Config::BOOT_LOGO_MS &&
         current_screen_id == SCREEN_ID_PAGE_BOOT_LOGO &&
-        pending_screen_id == 0) {
-        if (objects.page_boot_diag) {
-            pending_screen_id = SCREEN_ID_PAGE_BOOT_DIAG;
-            boot_diag_active = true;
-            boot_diag_has_error = false;
-            boot_diag_start_ms = now;
-            last_boot_diag_update_ms = 0;
-        } else {
-            pending_screen_id = SCREEN_ID_PAGE_MAIN_PRO;
-        }
+        pending_screen_id == 0 &&
+        BootDiagPolicy::nextStage(BootDiagPolicy::Stage::Logo,
+                                  now - boot_logo_start_ms,
+                                  Config::BOOT_LOGO_MS,
+                                  false,
+                                  false,
+                                  Config::BOOT_DIAG_MS) == BootDiagPolicy::Stage::Diag) {
+        pending_screen_id = SCREEN_ID_PAGE_BOOT_DIAG;
+        boot_diag_active = true;
+        boot_diag_has_error = false;
+        boot_diag_start_ms = now;
+        last_boot_diag_update_ms = 0;
         boot_logo_active = false;
         data_dirty = true;
     }
@@ -1298,13 +1435,15 @@ void UiController::poll(uint32_t now) {
     if (boot_diag_active &&
         current_screen_id == SCREEN_ID_PAGE_BOOT_DIAG &&
         pending_screen_id == 0 &&
-        BootDiagPolicy::shouldAutoAdvance(boot_diag_has_error,
-                                          BootDiagPolicy::sen66Pending(sensorManager.isOk(),
-                                                                       sensorManager.isBusy(),
-                                                                       sensorManager.retryAtMs(),
-                                                                       now),
-                                          now - boot_diag_start_ms,
-                                          Config::BOOT_DIAG_MS)) {
+        BootDiagPolicy::nextStage(BootDiagPolicy::Stage::Diag,
+                                  now - boot_diag_start_ms,
+                                  Config::BOOT_LOGO_MS,
+                                  boot_diag_has_error,
+                                  BootDiagPolicy::sen66Pending(sensorManager.isOk(),
+                                                               sensorManager.isBusy(),
+                                                               sensorManager.retryAtMs(),
+                                                               now),
+                                  Config::BOOT_DIAG_MS) == BootDiagPolicy::Stage::Main) {
         pending_screen_id = SCREEN_ID_PAGE_MAIN_PRO;
         boot_diag_active = false;
         data_dirty = true;
@@ -1336,7 +1475,8 @@ void UiController::poll(uint32_t now) {
     update_status_icons();
     UiScreenFlow::processPendingScreen(*this, now);
     UiScreenFlow::processBootRelease(*this, now);
-    UiScreenFlow::processDeferredUnloads(*this, now);
+    UiScreenFlow::processResidentScreens(*this, now);
+    UiScreenFlow::processPrewarm(*this, now);
 
     UiRenderLoop::process(*this, now);
     lvgl_port_unlock();
@@ -1344,10 +1484,7 @@ void UiController::poll(uint32_t now) {
 }
 
 void UiController::safe_label_set_text(lv_obj_t *obj, const char *new_text) {
-    if (!obj) return;
-    const char *current = lv_label_get_text(obj);
-    if (current && strcmp(current, new_text) == 0) return;
-    lv_label_set_text(obj, new_text);
+    UiWidgetBinding::setText(obj, new_text);
 }
 
 void UiController::safe_label_set_text_static(lv_obj_t *obj, const char *new_text) {
@@ -1428,6 +1565,8 @@ void UiController::update_diag_log_ui() {
         emitted++;
     }
 
+    update_diag_profile_panel();
+
     if (emitted == 0) {
         safe_label_set_text_static(objects.system_logs, UiText::DiagNoWarningsOrErrors());
         return;
@@ -1436,6 +1575,46 @@ void UiController::update_diag_log_ui() {
     safe_label_set_text(objects.system_logs, text);
 }
 
+void UiController::ensure_diag_profile_panel() {
+    if (!objects.card_diag || !objects.system_logs) {
+        return;
+    }
+    if (diag_profile_label_ && lv_obj_is_valid(diag_profile_label_) &&
+        lv_obj_get_parent(diag_profile_label_) == objects.card_diag) {
+        return;
+    }
+    lv_obj_set_height(objects.system_logs, UI_DIAG_LOG_HEIGHT);
+    diag_profile_label_ = lv_label_create(objects.card_diag);
+    lv_obj_set_pos(diag_profile_label_, 9, UI_DIAG_PROFILE_Y);
+    lv_obj_set_size(diag_profile_label_, 739, UI_DIAG_PROFILE_HEIGHT);
+    lv_obj_clear_flag(diag_profile_label_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    add_style_style_text_primary(diag_profile_label_);
+    lv_obj_set_style_text_font(diag_profile_label_, &ui_font_jet_reg_14, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_align(diag_profile_label_, LV_TEXT_ALIGN_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_border_side(diag_profile_label_, LV_BORDER_SIDE_TOP, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_border_width(diag_profile_label_, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_pad_top(diag_profile_label_, 8, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_label_set_long_mode(diag_profile_label_, LV_LABEL_LONG_CLIP);
+}
+
+void UiController::update_diag_profile_panel() {
+    ensure_diag_profile_panel();
+    if (!diag_profile_label_ || !lv_obj_is_valid(diag_profile_label_)) {
+        return;
+    }
+    // Follows the theme, which can change while the page is open.
+    UiWidgetBinding::setBorderColor(diag_profile_label_,
+                                    lv_obj_get_style_border_color(objects.card_diag, LV_PART_MAIN),
+                                    LV_PART_MAIN | LV_STATE_DEFAULT);
+    if (!TaskProfiler::instance().snapshot(g_diag_profile_snapshot)) {
+        safe_label_set_text_static(diag_profile_label_, "CPU  --");
+        return;
+    }
+    char text[UI_DIAG_PROFILE_TEXT_CAPACITY];
+    format_diag_profile(g_diag_profile_snapshot, text, sizeof(text));
+    safe_label_set_text(diag_profile_label_, text);
+}
+
 lv_color_t UiController::color_inactive() { return lv_color_hex(0x3a3a3a); }
 
 lv_color_t UiController::color_green() { return lv_color_hex(0x00c853); }
@@ -1684,12 +1863,12 @@ void UiController::update_main_screen_background_alert() {
 
 void UiController::set_dot_color(lv_obj_t *obj, lv_color_t color) {
     if (!obj) return;
-    lv_obj_set_style_bg_color(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_color(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBgColor(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setShadowColor(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
     if (color.full == color_inactive().full) {
-        lv_obj_set_style_shadow_opa(obj, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowOpa(obj, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
     } else {
-        lv_obj_set_style_shadow_opa(obj, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowOpa(obj, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
     }
 }
 
@@ -1755,8 +1934,8 @@ void UiController::compute_header_style(const AirQuality &aq,
 
 void UiController::apply_toggle_style(lv_obj_t *btn) {
     if (!btn) return;
-    lv_obj_set_style_border_color(btn, color_green(), LV_PART_MAIN | LV_STATE_CHECKED);
-    lv_obj_set_style_shadow_color(btn, color_green(), LV_PART_MAIN | LV_STATE_CHECKED);
+    UiWidgetBinding::setBorderColor(btn, color_green(), LV_PART_MAIN | LV_STATE_CHECKED);
+    UiWidgetBinding::setShadowColor(btn, color_green(), LV_PART_MAIN | LV_STATE_CHECKED);
 }
 
 bool UiController::pressure_altitude_is_set() const {
@@ -1829,15 +2008,15 @@ void UiController::style_accent_button(lv_obj_t *btn, lv_obj_t *label, lv_color_
     }
     const lv_color_t bg = lv_color_mix(accent, lv_color_black(), 84);
     const lv_color_t bg_grad = lv_color_mix(accent, lv_color_black(), 44);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(btn, bg, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBgOpa(btn, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBgColor(btn, bg, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_bg_grad_color(btn, bg_grad, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_bg_grad_dir(btn, LV_GRAD_DIR_VER, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(btn, accent, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_color(btn, accent, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_opa(btn, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBorderColor(btn, accent, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setShadowColor(btn, accent, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setShadowOpa(btn, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
     if (label) {
-        lv_obj_set_style_text_color(label, lv_color_white(), LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(label, lv_color_white(), LV_PART_MAIN | LV_STATE_DEFAULT);
     }
 }
 
@@ -2034,15 +2213,46 @@ void UiController::set_co2_asc_progress_visible(bool visible, bool enabling) {
     update_co2_calib_overlay_ui();
 }
 
-void UiController::flush_ui_now() {
-    lv_disp_t *disp = lv_disp_get_default();
-    if (!disp) {
-        return;
+void UiController::apply_sensor_offsets() {
+    SensorCommandQueue::instance().postOffsets(temp_offset, hum_offset);
+}
+
+void UiController::poll_sensor_command_results() {
+    SensorCommandQueue &queue = SensorCommandQueue::instance();
+
+    SensorCommandQueue::AscResult asc;
+    if (co2_asc_apply_pending_ && queue.takeAscResult(asc)) {
+        co2_asc_apply_pending_ = false;
+        const UiCo2Workflow::AscApplyPlan finish_plan =
+            UiCo2Workflow::finishAscApply(co2_asc_apply_previous_,
+                                          asc.requested_enabled,
+                                          asc.ok);
+        co2_asc_enabled = finish_plan.runtime_enabled;
+        storage.config().asc_enabled = finish_plan.config_enabled;
+        if (!asc.ok) {
+            LOGW("UI", "Failed to apply CO2 ASC (%s)",
+                 asc.requested_enabled ? "enable" : "disable");
+        } else {
+            if (finish_plan.persist_now) {
+                persist_ui_config(storage, "CO2 ASC");
+                data_dirty = true;
+            }
+            LOGI("UI", "CO2 ASC %s", asc.requested_enabled ? "enabled" : "disabled");
+        }
+        sync_co2_asc_toggle_ui();
     }
-    if (objects.overlay_co2_calib_confirm) {
-        lv_obj_update_layout(objects.overlay_co2_calib_confirm);
+
+    SensorCommandQueue::FrcResult frc;
+    if (queue.takeFrcResult(frc)) {
+        if (!frc.ok) {
+            LOGW("UI", "CO2 calibration failed");
+        } else if (frc.correction == 0xFFFF) {
+            LOGW("UI", "CO2 calibration finished but correction is invalid");
+        } else {
+            LOGI("UI", "CO2 calibration complete. correction: %u",
+                 static_cast<unsigned>(frc.correction));
+        }
     }
-    lv_refr_now(disp);
 }
 
 void UiController::set_pressure_altitude_overlay_visible(bool visible) {
@@ -2468,11 +2678,7 @@ void UiController::update_hum_offset_label() {
 void UiController::update_led_indicators() {
     const bool visible = led_indicators_enabled;
     auto set_indicator_visible = [visible](lv_obj_t *obj) {
-        if (!obj) {
-            return;
-        }
-        visible ? lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN)
-                : lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(obj, visible);
     };
 
     set_indicator_visible(objects.dot_co2_1);
@@ -2497,12 +2703,12 @@ void UiController::update_led_indicators() {
 
 void UiController::set_chip_color(lv_obj_t *obj, lv_color_t color) {
     if (!obj) return;
-    lv_obj_set_style_border_color(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_color(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBorderColor(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setShadowColor(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
     if (color.full == color_inactive().full) {
-        lv_obj_set_style_shadow_opa(obj, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowOpa(obj, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
     } else {
-        lv_obj_set_style_shadow_opa(obj, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowOpa(obj, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
     }
 }
 
@@ -2559,14 +2765,14 @@ void UiController::update_ui() {
         header_shadow = (header_col.full == color_red().full) ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
     if (objects.container_header_pro) {
-        lv_obj_set_style_border_color(objects.container_header_pro, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_shadow_color(objects.container_header_pro, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_shadow_opa(objects.container_header_pro, header_shadow, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBorderColor(objects.container_header_pro, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowColor(objects.container_header_pro, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowOpa(objects.container_header_pro, header_shadow, LV_PART_MAIN | LV_STATE_DEFAULT);
     }
     if (objects.container_settings_header) {
-        lv_obj_set_style_border_color(objects.container_settings_header, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_shadow_color(objects.container_settings_header, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_shadow_opa(objects.container_settings_header, header_shadow, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBorderColor(objects.container_settings_header, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowColor(objects.container_settings_header, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowOpa(objects.container_settings_header, header_shadow, LV_PART_MAIN | LV_STATE_DEFAULT);
     }
 
     update_main_screen_background_alert();
@@ -2591,9 +2797,9 @@ void UiController::update_settings_header() {
         header_col = (co_alert_active || status_red) ? color_red() : color_inactive();
         header_shadow = (header_col.full == color_red().full) ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
-    lv_obj_set_style_border_color(objects.container_settings_header, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_color(objects.container_settings_header, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_opa(objects.container_settings_header, header_shadow, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBorderColor(objects.container_settings_header, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setShadowColor(objects.container_settings_header, header_col, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setShadowOpa(objects.container_settings_header, header_shadow, LV_PART_MAIN | LV_STATE_DEFAULT);
     if (objects.label_log_status || objects.log_status) {
         const SettingsLogSeverity log_severity = summarize_settings_log_severity(diag_ack_alert_seq_);
         const char *log_label = UiText::StatusOk();
@@ -2851,52 +3057,52 @@ void UiController::init_ui_defaults() {
     if (objects.mqtt_status_icon_4) lv_obj_add_flag(objects.mqtt_status_icon_4, LV_OBJ_FLAG_HIDDEN);
 
     if (objects.btn_mqtt) {
-        lv_obj_set_style_bg_color(objects.btn_mqtt, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_border_color(objects.btn_mqtt, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_shadow_color(objects.btn_mqtt, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBgColor(objects.btn_mqtt, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBorderColor(objects.btn_mqtt, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setShadowColor(objects.btn_mqtt, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
     }
     if (objects.label_btn_mqtt) {
-        lv_obj_set_style_text_color(objects.label_btn_mqtt, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setTextColor(objects.label_btn_mqtt, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
     }
     if (objects.btn_wifi_reconnect) {
-        lv_obj_set_style_bg_color(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_border_color(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_shadow_color(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_bg_color(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
-        lv_obj_set_style_border_color(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
-        lv_obj_set_style_shadow_color(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setBgColor(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBorderColor(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setShadowColor(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBgColor(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setBorderColor(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setShadowColor(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
     }
     if (objects.label_btn_wifi_reconnect) {
-        lv_obj_set_style_text_color(objects.label_btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_text_color(objects.label_btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setTextColor(objects.label_btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setTextColor(objects.label_btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
     }
     if (objects.btn_wifi_start_ap) {
-        lv_obj_set_style_bg_color(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_border_color(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_shadow_color(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_bg_color(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
-        lv_obj_set_style_border_color(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
-        lv_obj_set_style_shadow_color(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setBgColor(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBorderColor(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setShadowColor(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBgColor(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setBorderColor(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setShadowColor(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
     }
     if (objects.label_btn_wifi_start_ap) {
-        lv_obj_set_style_text_color(objects.label_btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_text_color(objects.label_btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setTextColor(objects.label_btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setTextColor(objects.label_btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
     }
     if (objects.btn_dac_settings) {
-        lv_obj_set_style_bg_color(objects.btn_dac_settings, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_border_color(objects.btn_dac_settings, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_shadow_color(objects.btn_dac_settings, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBgColor(objects.btn_dac_settings, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBorderColor(objects.btn_dac_settings, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setShadowColor(objects.btn_dac_settings, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
     }
     if (objects.label_dac_settings) {
-        lv_obj_set_style_text_color(objects.label_dac_settings, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setTextColor(objects.label_dac_settings, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
     }
     if (objects.btn_night_mode) {
-        lv_obj_set_style_bg_color(objects.btn_night_mode, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_border_color(objects.btn_night_mode, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_shadow_color(objects.btn_night_mode, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBgColor(objects.btn_night_mode, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBorderColor(objects.btn_night_mode, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setShadowColor(objects.btn_night_mode, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
     }
     if (objects.label_btn_night_mode) {
-        lv_obj_set_style_text_color(objects.label_btn_night_mode, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setTextColor(objects.label_btn_night_mode, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
     }
     ui_language = storage.config().language;
     date_units_mdy = storage.config().units_mdy;
@@ -13,7 +13,6 @@
 #include "core/MqttRuntimeState.h"
 #include "core/NetworkCommandQueue.h"
 #include "ui/UiCo2Workflow.h"
-#include "ui/UiDeferredUnload.h"
 #include "web/WebUiBridge.h"
 #include <lvgl.h>
 #include "modules/SensorManager.h"
@@ -22,7 +21,7 @@
 class StorageManager;
 class AuraNetworkManager;
 class MqttManager;
-class ChartsHistory;
+class ChartsRuntimeState;
 class ThemeManager;
 class BacklightManager;
 class NightModeManager;
@@ -42,7 +41,7 @@ struct UiContext {
     WebUiBridge &webUiBridge;
     NetworkCommandQueue &networkCommandQueue;
     SensorManager &sensorManager;
-    ChartsHistory &chartsHistory;
+    const ChartsRuntimeState &chartsRuntimeState;
     TimeManager &timeManager;
     ThemeManager &themeManager;
     BacklightManager &backlightManager;
@@ -63,7 +62,10 @@ public:
     explicit UiController(const UiContext &context);
 
     void setLvglReady(bool ready);
+    // begin() builds the screens and shows the boot logo; bindInitialData() fills them from the
+    // restored histories, clock and sensor state once boot has joined.
     void begin();
+    void bindInitialData();
     void onSensorPoll(const SensorManager::PollResult &poll);
     void onTimePoll(const TimeManager::PollResult &poll);
     void markDatetimeDirty();
@@ -188,6 +190,7 @@ private:
     void select_pm_info(InfoSensor sensor);
     void select_pressure_info(InfoSensor sensor);
     void sync_info_graph_button_state();
+    bool current_info_graph_mode() const;
     bool should_show_threshold_dots() const;
     void sync_threshold_dots_visibility();
     void set_temperature_info_mode(bool graph_mode);
@@ -357,6 +360,8 @@ private:
     void update_web_page_panel();
     void update_status_message(uint32_t now_ms, bool gas_warmup);
     void update_diag_log_ui();
+    void ensure_diag_profile_panel();
+    void update_diag_profile_panel();
     void update_clock_labels();
     bool pressure_altitude_is_set() const;
     int pressure_altitude_meters() const;
@@ -376,7 +381,8 @@ private:
     void update_co2_calib_overlay_ui();
     void clear_co2_calib_overlay_timer();
     void arm_co2_calib_overlay_autohide(uint32_t delay_ms);
-    void flush_ui_now();
+    void apply_sensor_offsets();
+    void poll_sensor_command_results();
     void reset_pressure_altitude_pending();
     void set_pressure_altitude_overlay_visible(bool visible);
     void sync_pressure_altitude_ui();
@@ -852,7 +858,7 @@ private:
     WebUiBridge &webUiBridge;
     NetworkCommandQueue &networkCommandQueue;
     SensorManager &sensorManager;
-    ChartsHistory &chartsHistory;
+    const ChartsRuntimeState &chartsRuntimeState;
     TimeManager &timeManager;
     ThemeManager &themeManager;
     BacklightManager &backlightManager;
@@ -915,6 +921,9 @@ private:
     Co2CalibOverlayMode co2_calib_overlay_mode_ = Co2CalibOverlayMode::Hidden;
     lv_timer_t *co2_calib_overlay_timer_ = nullptr;
     bool co2_asc_progress_enabling_ = true;
+    // Set while the sensor task applies an ASC change posted from the toggle.
+    bool co2_asc_apply_pending_ = false;
+    bool co2_asc_apply_previous_ = false;
     int pressure_altitude_pending_m_ = Config::PRESSURE_ALTITUDE_DEFAULT_M;
     bool pressure_altitude_overlay_open_ = false;
     Config::Language ui_language = Config::Language::EN;
@@ -927,6 +936,7 @@ private:
     uint32_t last_dac_ui_update_ms = 0;
     uint32_t diag_ack_alert_seq_ = 0;
     uint32_t last_diag_log_update_ms = 0;
+    lv_obj_t *diag_profile_label_ = nullptr;
     uint32_t last_settings_header_update_ms = 0;
     uint32_t last_ui_tick_ms = 0;
     uint32_t status_msg_last_ms = 0;
@@ -952,7 +962,6 @@ private:
     uint32_t lvgl_diag_stall_since_ms = 0;
     bool firmware_update_screen_active_ = false;
     int firmware_update_return_screen_id_ = 0;
-    UiDeferredUnload deferred_unload_;
     bool boot_logo_active = false;
     uint32_t boot_logo_start_ms = 0;
     bool boot_diag_active = false;
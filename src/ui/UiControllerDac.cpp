@@ -14,6 +14,7 @@
 #include "modules/NetworkManager.h"
 #include "modules/StorageManager.h"
 #include "ui/UiText.h"
+#include "ui/UiWidgetBinding.h"
 #include "ui/ui.h"
 
 namespace {
@@ -33,9 +34,9 @@ void set_button_accent(lv_obj_t *obj, lv_color_t color, lv_opa_t shadow_opa) {
     if (!obj) {
         return;
     }
-    lv_obj_set_style_border_color(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_color(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_opa(obj, shadow_opa, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBorderColor(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setShadowColor(obj, color, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setShadowOpa(obj, shadow_opa, LV_PART_MAIN | LV_STATE_DEFAULT);
 }
 
 uint32_t hash_text(uint32_t seed, const String &text) {
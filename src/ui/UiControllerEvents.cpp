@@ -13,6 +13,7 @@
 #include "config/AppConfig.h"
 #include "core/Logger.h"
 #include "core/SafeRestart.h"
+#include "core/SensorCommandQueue.h"
 #include "web/WebRuntime.h"
 #include "lvgl_v8_port.h"
 #include "modules/NetworkManager.h"
@@ -696,20 +697,10 @@ void UiController::on_confirm_ok_event(lv_event_t *e) {
     confirm_hide();
     if (action == CONFIRM_VOC_RESET) {
         LOGI("UI", "VOC state reset requested");
-        sensorManager.clearVocState(storage);
+        SensorCommandQueue::instance().postVocReset();
         currentData.voc_valid = false;
         currentData.nox_valid = false;
         data_dirty = true;
-        if (!sensorManager.isOk()) {
-            LOGW("UI", "SEN66 not ready for VOC reset");
-            return;
-        }
-        if (!sensorManager.deviceReset()) {
-            LOGW("UI", "SEN66 device reset failed");
-            return;
-        }
-        sensorManager.scheduleRetry(SEN66_START_RETRY_MS);
-        LOGI("UI", "SEN66 device reset done");
     } else if (action == CONFIRM_RESTART) {
         LOGW("UI", "restart requested");
         WebHandlersRequestRestart();
@@ -948,6 +939,20 @@ void UiController::on_dp_info_event(lv_event_t *e) {
     }
 }
 
+bool UiController::current_info_graph_mode() const {
+    return (info_sensor == INFO_TEMP) ? temp_graph_mode_ :
+           (info_sensor == INFO_RH) ? rh_graph_mode_ :
+           (info_sensor == INFO_VOC) ? voc_graph_mode_ :
+           (info_sensor == INFO_NOX) ? nox_graph_mode_ :
+           (info_sensor == INFO_HCHO) ? hcho_graph_mode_ :
+           (info_sensor == INFO_CO2) ? co2_graph_mode_ :
+           (info_sensor == INFO_PM05) ? pm05_graph_mode_ :
+           ((info_sensor == INFO_PM25 || info_sensor == INFO_PM4) ? pm25_4_graph_mode_ :
+            ((info_sensor == INFO_PM1 || info_sensor == INFO_PM10) ? pm1_10_graph_mode_ :
+             ((info_sensor == INFO_CO) ? co_graph_mode_ :
+              ((info_sensor == INFO_PRESSURE_3H || info_sensor == INFO_PRESSURE_24H) ? pressure_graph_mode_ : false))));
+}
+
 void UiController::on_info_graph_event(lv_event_t *e) {
     const lv_event_code_t code = lv_event_get_code(e);
     if (code != LV_EVENT_VALUE_CHANGED) {
@@ -969,18 +974,7 @@ void UiController::on_info_graph_event(lv_event_t *e) {
          co_graph_mode_ ? 1 : 0,
          pressure_graph_mode_ ? 1 : 0);
 
-    const bool was_graph_mode =
-        (info_sensor == INFO_TEMP) ? temp_graph_mode_ :
-        (info_sensor == INFO_RH) ? rh_graph_mode_ :
-        (info_sensor == INFO_VOC) ? voc_graph_mode_ :
-        (info_sensor == INFO_NOX) ? nox_graph_mode_ :
-        (info_sensor == INFO_HCHO) ? hcho_graph_mode_ :
-        (info_sensor == INFO_CO2) ? co2_graph_mode_ :
-        (info_sensor == INFO_PM05) ? pm05_graph_mode_ :
-        ((info_sensor == INFO_PM25 || info_sensor == INFO_PM4) ? pm25_4_graph_mode_ :
-         ((info_sensor == INFO_PM1 || info_sensor == INFO_PM10) ? pm1_10_graph_mode_ :
-          ((info_sensor == INFO_CO) ? co_graph_mode_ :
-           ((info_sensor == INFO_PRESSURE_3H || info_sensor == INFO_PRESSURE_24H) ? pressure_graph_mode_ : false))));
+    const bool was_graph_mode = current_info_graph_mode();
 
     if (info_sensor == INFO_TEMP) {
         set_temperature_info_mode(!temp_graph_mode_);
@@ -1756,6 +1750,10 @@ void UiController::on_co2_calib_asc_event(lv_event_t *e) {
     if (requested_enabled == co2_asc_enabled) {
         return;
     }
+    if (co2_asc_apply_pending_) {
+        sync_co2_asc_toggle_ui();
+        return;
+    }
 
     const bool previous_enabled = co2_asc_enabled;
     const UiCo2Workflow::AscApplyPlan begin_plan =
@@ -1779,30 +1777,12 @@ void UiController::on_co2_calib_asc_event(lv_event_t *e) {
 
     set_co2_asc_progress_visible(true, requested_enabled);
     arm_co2_calib_overlay_autohide(kCo2CalibOverlayHoldMs);
-    flush_ui_now();
 
+    // The sensor task applies it between polls; poll_sensor_command_results() finishes up.
     LOGI("UI", "Applying CO2 ASC: %s", requested_enabled ? "enable" : "disable");
-    const bool live_apply_ok = sensorManager.setAscEnabled(requested_enabled);
-    const UiCo2Workflow::AscApplyPlan finish_plan =
-        UiCo2Workflow::finishAscApply(previous_enabled,
-                                      requested_enabled,
-                                      live_apply_ok);
-    co2_asc_enabled = finish_plan.runtime_enabled;
-    storage.config().asc_enabled = finish_plan.config_enabled;
-
-    if (!live_apply_ok) {
-        sync_co2_asc_toggle_ui();
-        LOGW("UI", "Failed to apply CO2 ASC (%s)",
-             requested_enabled ? "enable" : "disable");
-        return;
-    }
-
-    if (finish_plan.persist_now) {
-        persist_ui_config(storage, "CO2 ASC");
-        data_dirty = true;
-    }
-    sync_co2_asc_toggle_ui();
-    LOGI("UI", "CO2 ASC %s", requested_enabled ? "enabled" : "disabled");
+    co2_asc_apply_pending_ = true;
+    co2_asc_apply_previous_ = previous_enabled;
+    SensorCommandQueue::instance().postAsc(requested_enabled);
 }
 
 void UiController::on_co2_calib_start_event(lv_event_t *e) {
@@ -1826,25 +1806,14 @@ void UiController::on_co2_calib_confirm_ok_event(lv_event_t *e) {
 
     set_co2_calib_progress_visible(true);
     arm_co2_calib_overlay_autohide(kCo2CalibOverlayHoldMs);
-    flush_ui_now();
 
     LOGI("UI", "CO2 calibration started (420 ppm reference)");
 
-    uint16_t correction = 0;
-    if (!sensorManager.calibrateFrc(SEN66_FRC_REF_PPM,
-                                    currentData.pressure_valid,
-                                    currentData.pressure,
-                                    correction)) {
-        LOGW("UI", "CO2 calibration failed");
-        return;
-    }
-
-    if (correction == 0xFFFF) {
-        LOGW("UI", "CO2 calibration finished but correction is invalid");
-        return;
-    }
-
-    LOGI("UI", "CO2 calibration complete. correction: %u", static_cast<unsigned>(correction));
+    SensorCommandQueue::Frc request;
+    request.ref_ppm = SEN66_FRC_REF_PPM;
+    request.has_pressure = currentData.pressure_valid;
+    request.pressure_hpa = currentData.pressure;
+    SensorCommandQueue::instance().postFrc(request);
 }
 
 void UiController::on_co2_calib_confirm_cancel_event(lv_event_t *e) {
@@ -2301,7 +2270,7 @@ void UiController::on_temp_offset_minus(lv_event_t *e) {
     }
     temp_offset_dirty = true;
     temp_offset_ui_dirty = true;
-    sensorManager.setOffsets(temp_offset, hum_offset);
+    apply_sensor_offsets();
 }
 
 void UiController::on_temp_offset_plus(lv_event_t *e) {
@@ -2323,7 +2292,7 @@ void UiController::on_temp_offset_plus(lv_event_t *e) {
     }
     temp_offset_dirty = true;
     temp_offset_ui_dirty = true;
-    sensorManager.setOffsets(temp_offset, hum_offset);
+    apply_sensor_offsets();
 }
 
 void UiController::on_hum_offset_minus(lv_event_t *e) {
@@ -2337,7 +2306,7 @@ void UiController::on_hum_offset_minus(lv_event_t *e) {
     }
     hum_offset_dirty = true;
     hum_offset_ui_dirty = true;
-    sensorManager.setOffsets(temp_offset, hum_offset);
+    apply_sensor_offsets();
 }
 
 void UiController::on_hum_offset_plus(lv_event_t *e) {
@@ -2351,7 +2320,7 @@ void UiController::on_hum_offset_plus(lv_event_t *e) {
     }
     hum_offset_dirty = true;
     hum_offset_ui_dirty = true;
-    sensorManager.setOffsets(temp_offset, hum_offset);
+    apply_sensor_offsets();
 }
 
 void UiController::on_boot_diag_continue(lv_event_t *e) {
@@ -12,8 +12,10 @@
 #include <time.h>
 
 #include "config/AppConfig.h"
+#include "core/ChartsRuntimeState.h"
 #include "modules/ChartsHistory.h"
 #include "ui/UiText.h"
+#include "ui/UiWidgetBinding.h"
 #include "ui/ui.h"
 
 #include "ui/UiControllerGraphsShared.h"
@@ -128,8 +130,8 @@ void UiController::release_all_sensor_graph_runtime_objects() {
 
 bool UiController::should_refresh_active_graph(InfoSensor sensor, TempGraphRange range, uint16_t points) {
     constexpr uint32_t kGraphRefreshHeartbeatMs = 5000UL;
-    const uint16_t history_count = chartsHistory.count();
-    const uint32_t history_epoch = chartsHistory.latestEpoch();
+    const uint16_t history_count = chartsRuntimeState.count();
+    const uint32_t history_epoch = chartsRuntimeState.latestEpoch();
     const uint32_t theme_sig = active_graph_theme_signature();
     const uint32_t now_ms = millis();
 
@@ -154,8 +156,8 @@ void UiController::mark_active_graph_refreshed(InfoSensor sensor, TempGraphRange
     graph_refresh_sensor_ = sensor;
     graph_refresh_range_ = range;
     graph_refresh_points_ = points;
-    graph_refresh_history_count_ = chartsHistory.count();
-    graph_refresh_epoch_ = chartsHistory.latestEpoch();
+    graph_refresh_history_count_ = chartsRuntimeState.count();
+    graph_refresh_epoch_ = chartsRuntimeState.latestEpoch();
     graph_refresh_units_c_ = temp_units_c;
     graph_refresh_night_mode_ = night_mode;
     graph_refresh_theme_sig_ = active_graph_theme_signature();
@@ -268,16 +270,16 @@ void UiController::apply_standard_info_chart_theme(lv_obj_t *chart, uint8_t hori
     lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SHIFT);
     lv_chart_set_div_line_count(chart, horizontal_divisions, vertical_divisions);
 
-    lv_obj_set_style_bg_color(chart, card_bg, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(chart, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(chart, border_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBgColor(chart, card_bg, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBgOpa(chart, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setBorderColor(chart, border_color, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_border_width(chart, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_radius(chart, 12, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(chart, grid_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+    UiWidgetBinding::setLineColor(chart, grid_color, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_line_opa(chart, LV_OPA_50, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_line_width(chart, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
 
-    lv_obj_set_style_line_color(chart, line_color, LV_PART_ITEMS | LV_STATE_DEFAULT);
+    UiWidgetBinding::setLineColor(chart, line_color, LV_PART_ITEMS | LV_STATE_DEFAULT);
     lv_obj_set_style_line_width(chart, 3, LV_PART_ITEMS | LV_STATE_DEFAULT);
     lv_obj_set_style_line_opa(chart, LV_OPA_COVER, LV_PART_ITEMS | LV_STATE_DEFAULT);
     lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
@@ -325,7 +327,7 @@ UiController::GraphSeriesStats UiController::populate_info_chart_series(lv_obj_t
         return stats;
     }
 
-    const uint16_t total_count = chartsHistory.count();
+    const uint16_t total_count = chartsRuntimeState.count();
     const uint16_t available = (total_count < points) ? total_count : points;
     const uint16_t missing_prefix = points - available;
     const uint16_t start_offset = total_count - available;
@@ -337,7 +339,7 @@ UiController::GraphSeriesStats UiController::populate_info_chart_series(lv_obj_t
             const uint16_t offset = start_offset + (i - missing_prefix);
             float raw_value = 0.0f;
             bool valid = false;
-            if (chartsHistory.metricValueFromOldest(offset, metric, raw_value, valid) &&
+            if (chartsRuntimeState.metricValueFromOldest(offset, metric, raw_value, valid) &&
                 valid && isfinite(raw_value)) {
                 float display_value = raw_value;
                 if (convert_temperature_to_display) {
@@ -442,7 +444,7 @@ void UiController::ensure_graph_time_labels(lv_obj_t *graph_container,
             label = lv_label_create(graph_container);
             lv_obj_clear_flag(label, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
             lv_obj_set_style_text_font(label, &ui_font_jet_reg_14, LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_bg_opa(label, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+            UiWidgetBinding::setBgOpa(label, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
             lv_obj_set_style_border_width(label, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
             lv_obj_set_style_pad_left(label, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
             lv_obj_set_style_pad_right(label, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -463,8 +465,8 @@ void UiController::ensure_graph_time_labels(lv_obj_t *graph_container,
         if (!label) {
             continue;
         }
-        lv_obj_set_style_text_color(label, text, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_text_opa(label, LV_OPA_80, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(label, text, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextOpa(label, LV_OPA_80, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_move_foreground(label);
     }
 }
@@ -503,7 +505,7 @@ void UiController::update_graph_time_labels(lv_obj_t *graph_container,
     }
 
     bool absolute_time = timeManager.isSystemTimeValid();
-    time_t end_epoch = static_cast<time_t>(chartsHistory.latestEpoch());
+    time_t end_epoch = static_cast<time_t>(chartsRuntimeState.latestEpoch());
     if (!absolute_time || end_epoch <= Config::TIME_VALID_EPOCH) {
         end_epoch = time(nullptr);
         if (end_epoch <= Config::TIME_VALID_EPOCH) {
@@ -596,7 +598,7 @@ void UiController::ensure_graph_stat_overlays(lv_obj_t *chart,
             lv_obj_set_style_pad_bottom(label, 3, LV_PART_MAIN | LV_STATE_DEFAULT);
             lv_obj_set_style_radius(label, 8, LV_PART_MAIN | LV_STATE_DEFAULT);
             lv_obj_set_style_border_width(label, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_bg_opa(label, LV_OPA_70, LV_PART_MAIN | LV_STATE_DEFAULT);
+            UiWidgetBinding::setBgOpa(label, LV_OPA_70, LV_PART_MAIN | LV_STATE_DEFAULT);
         }
         lv_obj_align(label, align, x_ofs, y_ofs);
         lv_obj_move_foreground(label);
@@ -625,9 +627,9 @@ void UiController::style_graph_stat_overlays(lv_obj_t *chart,
         if (!label) {
             continue;
         }
-        lv_obj_set_style_text_color(label, text, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_color(label, badge_bg, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_border_color(label, border, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(label, text, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(label, badge_bg, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBorderColor(label, border, LV_PART_MAIN | LV_STATE_DEFAULT);
     }
 }
 
@@ -14,6 +14,7 @@
 #include "config/AppConfig.h"
 #include "modules/ChartsHistory.h"
 #include "ui/UiText.h"
+#include "ui/UiWidgetBinding.h"
 #include "ui/ui.h"
 
 #include "ui/UiControllerGraphsShared.h"
@@ -93,7 +94,7 @@ void UiController::ensure_temperature_zone_overlay() {
         lv_obj_get_parent(temp_graph_zone_overlay_) != objects.temperature_info_graph) {
         temp_graph_zone_overlay_ = lv_obj_create(objects.temperature_info_graph);
         lv_obj_clear_flag(temp_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(temp_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(temp_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(temp_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(temp_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(temp_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -211,8 +212,8 @@ void UiController::update_temperature_zone_overlay(const SensorGraphProfile &pro
         lv_obj_set_pos(band, 0, top);
         lv_obj_set_size(band, width, static_cast<lv_coord_t>(bottom - top));
         lv_color_t zone_color = resolve_graph_zone_color(profile.zone_tones[i], chart_bg);
-        lv_obj_set_style_bg_color(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
@@ -292,7 +293,7 @@ void UiController::ensure_humidity_zone_overlay() {
         lv_obj_get_parent(rh_graph_zone_overlay_) != objects.rh_info_graph) {
         rh_graph_zone_overlay_ = lv_obj_create(objects.rh_info_graph);
         lv_obj_clear_flag(rh_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(rh_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(rh_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(rh_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(rh_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(rh_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -403,8 +404,8 @@ void UiController::update_humidity_zone_overlay(float y_min_display, float y_max
         lv_obj_set_pos(band, 0, top);
         lv_obj_set_size(band, width, static_cast<lv_coord_t>(bottom - top));
         lv_color_t zone_color = resolve_graph_zone_color(kRhZoneTones[i], chart_bg);
-        lv_obj_set_style_bg_color(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
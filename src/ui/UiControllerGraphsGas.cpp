@@ -14,6 +14,7 @@
 #include "config/AppConfig.h"
 #include "modules/ChartsHistory.h"
 #include "ui/UiText.h"
+#include "ui/UiWidgetBinding.h"
 #include "ui/ui.h"
 
 #include "ui/UiControllerGraphsShared.h"
@@ -71,7 +72,7 @@ void UiController::ensure_voc_zone_overlay() {
         lv_obj_get_parent(voc_graph_zone_overlay_) != objects.voc_info_graph) {
         voc_graph_zone_overlay_ = lv_obj_create(objects.voc_info_graph);
         lv_obj_clear_flag(voc_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(voc_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(voc_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(voc_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(voc_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(voc_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -190,8 +191,8 @@ void UiController::update_voc_zone_overlay(float y_min_display, float y_max_disp
         lv_obj_set_pos(band, 0, top);
         lv_obj_set_size(band, width, static_cast<lv_coord_t>(bottom - top));
         const lv_color_t zone_color = resolve_graph_zone_color(kVocZoneTones[i], chart_bg);
-        lv_obj_set_style_bg_color(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
@@ -350,7 +351,7 @@ void UiController::ensure_nox_zone_overlay() {
         lv_obj_get_parent(nox_graph_zone_overlay_) != objects.nox_info_graph) {
         nox_graph_zone_overlay_ = lv_obj_create(objects.nox_info_graph);
         lv_obj_clear_flag(nox_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(nox_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(nox_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(nox_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(nox_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(nox_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -469,8 +470,8 @@ void UiController::update_nox_zone_overlay(float y_min_display, float y_max_disp
         lv_obj_set_pos(band, 0, top);
         lv_obj_set_size(band, width, static_cast<lv_coord_t>(bottom - top));
         const lv_color_t zone_color = resolve_graph_zone_color(kNoxZoneTones[i], chart_bg);
-        lv_obj_set_style_bg_color(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
@@ -629,7 +630,7 @@ void UiController::ensure_hcho_zone_overlay() {
         lv_obj_get_parent(hcho_graph_zone_overlay_) != objects.hcho_info_graph) {
         hcho_graph_zone_overlay_ = lv_obj_create(objects.hcho_info_graph);
         lv_obj_clear_flag(hcho_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(hcho_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(hcho_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(hcho_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(hcho_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(hcho_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -748,8 +749,8 @@ void UiController::update_hcho_zone_overlay(float y_min_display, float y_max_dis
         lv_obj_set_pos(band, 0, top);
         lv_obj_set_size(band, width, static_cast<lv_coord_t>(bottom - top));
         const lv_color_t zone_color = resolve_graph_zone_color(kHchoZoneTones[i], chart_bg);
-        lv_obj_set_style_bg_color(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
@@ -911,7 +912,7 @@ void UiController::ensure_co2_zone_overlay() {
         lv_obj_get_parent(co2_graph_zone_overlay_) != objects.co2_info_graph) {
         co2_graph_zone_overlay_ = lv_obj_create(objects.co2_info_graph);
         lv_obj_clear_flag(co2_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(co2_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(co2_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(co2_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(co2_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(co2_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -1030,8 +1031,8 @@ void UiController::update_co2_zone_overlay(float y_min_display, float y_max_disp
         lv_obj_set_pos(band, 0, top);
         lv_obj_set_size(band, width, static_cast<lv_coord_t>(bottom - top));
         const lv_color_t zone_color = resolve_graph_zone_color(kCo2ZoneTones[i], chart_bg);
-        lv_obj_set_style_bg_color(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
@@ -1190,7 +1191,7 @@ void UiController::ensure_co_zone_overlay() {
         lv_obj_get_parent(co_graph_zone_overlay_) != objects.co_info_graph) {
         co_graph_zone_overlay_ = lv_obj_create(objects.co_info_graph);
         lv_obj_clear_flag(co_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(co_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(co_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(co_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(co_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(co_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -1310,8 +1311,8 @@ void UiController::update_co_zone_overlay(float y_min_display, float y_max_displ
         lv_obj_set_pos(band, 0, top);
         lv_obj_set_size(band, width, static_cast<lv_coord_t>(bottom - top));
         const lv_color_t zone_color = resolve_graph_zone_color(kCoZoneTones[i], chart_bg);
-        lv_obj_set_style_bg_color(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
@@ -14,6 +14,7 @@
 #include "config/AppConfig.h"
 #include "modules/ChartsHistory.h"
 #include "ui/UiText.h"
+#include "ui/UiWidgetBinding.h"
 #include "ui/ui.h"
 
 #include "ui/UiControllerGraphsShared.h"
@@ -71,7 +72,7 @@ void UiController::ensure_pm05_zone_overlay() {
         lv_obj_get_parent(pm05_graph_zone_overlay_) != objects.pm05_info_graph) {
         pm05_graph_zone_overlay_ = lv_obj_create(objects.pm05_info_graph);
         lv_obj_clear_flag(pm05_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(pm05_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(pm05_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(pm05_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(pm05_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(pm05_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -175,8 +176,8 @@ void UiController::update_pm05_zone_overlay(float y_min_display, float y_max_dis
 
         lv_obj_set_pos(band, 0, y1);
         lv_obj_set_size(band, width, y2 - y1);
-        lv_obj_set_style_bg_color(band, resolve_graph_zone_color(kZoneTones[i], chart_bg), LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, resolve_graph_zone_color(kZoneTones[i], chart_bg), LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
@@ -344,7 +345,7 @@ void UiController::ensure_pm25_4_zone_overlay() {
         lv_obj_get_parent(pm25_4_graph_zone_overlay_) != objects.pm25_4_graph) {
         pm25_4_graph_zone_overlay_ = lv_obj_create(objects.pm25_4_graph);
         lv_obj_clear_flag(pm25_4_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(pm25_4_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(pm25_4_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(pm25_4_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(pm25_4_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(pm25_4_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -473,8 +474,8 @@ void UiController::update_pm25_4_zone_overlay(float y_min_display, float y_max_d
         lv_obj_set_pos(band, 0, top);
         lv_obj_set_size(band, width, static_cast<lv_coord_t>(bottom - top));
         const lv_color_t zone_color = resolve_graph_zone_color(kPmZoneTones[i], chart_bg);
-        lv_obj_set_style_bg_color(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
@@ -641,7 +642,7 @@ void UiController::ensure_pm1_10_zone_overlay() {
         lv_obj_get_parent(pm1_10_graph_zone_overlay_) != objects.pm1_10_info_graph) {
         pm1_10_graph_zone_overlay_ = lv_obj_create(objects.pm1_10_info_graph);
         lv_obj_clear_flag(pm1_10_graph_zone_overlay_, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_bg_opa(pm1_10_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(pm1_10_graph_zone_overlay_, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(pm1_10_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_left(pm1_10_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_pad_right(pm1_10_graph_zone_overlay_, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -768,8 +769,8 @@ void UiController::update_pm1_10_zone_overlay(float y_min_display, float y_max_d
         lv_obj_set_pos(band, 0, top);
         lv_obj_set_size(band, width, static_cast<lv_coord_t>(bottom - top));
         const lv_color_t zone_color = resolve_graph_zone_color(kPmZoneTones[i], chart_bg);
-        lv_obj_set_style_bg_color(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_opa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgColor(band, zone_color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setBgOpa(band, LV_OPA_30, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
         lv_obj_move_background(band);
     }
@@ -12,6 +12,7 @@
 #include <time.h>
 
 #include "config/AppConfig.h"
+#include "core/ChartsRuntimeState.h"
 #include "modules/ChartsHistory.h"
 #include "ui/UiText.h"
 #include "ui/ui.h"
@@ -104,7 +105,7 @@ void UiController::update_pressure_info_graph() {
     stats.latest_value = NAN;
 
     const float point_scale = pressure_display_uses_inhg() ? 100.0f : 10.0f;
-    const uint16_t total_count = chartsHistory.count();
+    const uint16_t total_count = chartsRuntimeState.count();
     const uint16_t available = (total_count < points) ? total_count : points;
     const uint16_t missing_prefix = points - available;
     const uint16_t start_offset = total_count - available;
@@ -115,7 +116,7 @@ void UiController::update_pressure_info_graph() {
             const uint16_t offset = start_offset + (i - missing_prefix);
             float raw_value = 0.0f;
             bool valid = false;
-            if (chartsHistory.metricValueFromOldest(offset,
+            if (chartsRuntimeState.metricValueFromOldest(offset,
                                                     ChartsHistory::METRIC_PRESSURE,
                                                     raw_value,
                                                     valid) &&
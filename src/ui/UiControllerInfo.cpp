@@ -15,6 +15,7 @@
 #include "core/MathUtils.h"
 #include "modules/ChartsHistory.h"
 #include "ui/UiText.h"
+#include "ui/UiWidgetBinding.h"
 #include "ui/ui.h"
 
 namespace {
@@ -758,14 +759,7 @@ void UiController::select_pressure_info(InfoSensor sensor) {
 }
 
 void UiController::set_visible(lv_obj_t *obj, bool visible) {
-    if (!obj) {
-        return;
-    }
-    if (visible) {
-        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
-    } else {
-        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
-    }
+    UiWidgetBinding::setVisible(obj, visible);
 }
 
 void UiController::hide_all_sensor_info_containers() {
@@ -15,6 +15,7 @@
 #include "modules/MqttManager.h"
 #include "ui/ui.h"
 #include "ui/images.h"
+#include "ui/UiWidgetBinding.h"
 #include "web/WebWifiUtils.h"
 using namespace Config;
 
@@ -65,14 +66,7 @@ const char *format_ampm_token(int hour24) {
 }
 
 void set_hidden_if_present(lv_obj_t *obj, bool hidden) {
-    if (!obj) {
-        return;
-    }
-    if (hidden) {
-        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
-    } else {
-        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
-    }
+    UiWidgetBinding::setVisible(obj, !hidden);
 }
 
 WebUiBridge::ApplyResult finalize_network_bridge_result(bool success,
@@ -124,28 +118,28 @@ void UiController::update_datetime_ui() {
     set_button_enabled(objects.btn_datetime_apply, controls_enabled);
 
     if (objects.label_set_time_hours_value) {
-        lv_obj_set_style_text_color(objects.label_set_time_hours_value, controls_enabled ? text_on : text_off,
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(objects.label_set_time_hours_value, controls_enabled ? text_on : text_off,
+                                      LV_PART_MAIN | LV_STATE_DEFAULT);
     }
     if (objects.label_set_time_minutes_value) {
-        lv_obj_set_style_text_color(objects.label_set_time_minutes_value, controls_enabled ? text_on : text_off,
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(objects.label_set_time_minutes_value, controls_enabled ? text_on : text_off,
+                                      LV_PART_MAIN | LV_STATE_DEFAULT);
     }
     if (objects.label_set_time_ampm_value) {
-        lv_obj_set_style_text_color(objects.label_set_time_ampm_value, controls_enabled ? text_on : text_off,
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(objects.label_set_time_ampm_value, controls_enabled ? text_on : text_off,
+                                      LV_PART_MAIN | LV_STATE_DEFAULT);
     }
     if (objects.label_set_date_day_value) {
-        lv_obj_set_style_text_color(objects.label_set_date_day_value, controls_enabled ? text_on : text_off,
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(objects.label_set_date_day_value, controls_enabled ? text_on : text_off,
+                                      LV_PART_MAIN | LV_STATE_DEFAULT);
     }
     if (objects.label_set_date_month_value) {
-        lv_obj_set_style_text_color(objects.label_set_date_month_value, controls_enabled ? text_on : text_off,
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(objects.label_set_date_month_value, controls_enabled ? text_on : text_off,
+                                      LV_PART_MAIN | LV_STATE_DEFAULT);
     }
     if (objects.label_set_date_year_value) {
-        lv_obj_set_style_text_color(objects.label_set_date_year_value, controls_enabled ? text_on : text_off,
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(objects.label_set_date_year_value, controls_enabled ? text_on : text_off,
+                                      LV_PART_MAIN | LV_STATE_DEFAULT);
     }
 
     char buf[8];
@@ -389,9 +383,9 @@ void UiController::update_rtc_detection_ui() {
                      TimeManager::rtcModeLabel(rtc_detection_pending_mode_));
         }
         safe_label_set_text(objects.label_rtc_detection_title_2, line);
-        lv_obj_set_style_text_color(objects.label_rtc_detection_title_2,
-                                    active_text_color(),
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(objects.label_rtc_detection_title_2,
+                                      active_text_color(),
+                                      LV_PART_MAIN | LV_STATE_DEFAULT);
     }
 
     if (objects.label_rtc_detection_title_3) {
@@ -403,9 +397,9 @@ void UiController::update_rtc_detection_ui() {
                                             ? color_yellow()
                                             : rtc_runtime_status_color(timeManager);
         safe_label_set_text(objects.label_rtc_detection_title_3, status_text);
-        lv_obj_set_style_text_color(objects.label_rtc_detection_title_3,
-                                    status_color,
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setTextColor(objects.label_rtc_detection_title_3,
+                                      status_color,
+                                      LV_PART_MAIN | LV_STATE_DEFAULT);
     }
 }
 
@@ -440,37 +434,37 @@ void UiController::update_wifi_ui() {
     // applied here (not only in init_ui_defaults()) once objects actually exist.
     if (objects.btn_wifi_reconnect) {
         lv_obj_clear_flag(objects.btn_wifi_reconnect, LV_OBJ_FLAG_CHECKABLE);
-        lv_obj_set_style_bg_color(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_border_color(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_shadow_color(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_bg_color(objects.btn_wifi_reconnect, color_inactive(),
-                                  LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
-        lv_obj_set_style_border_color(objects.btn_wifi_reconnect, color_inactive(),
-                                      LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
-        lv_obj_set_style_shadow_color(objects.btn_wifi_reconnect, color_inactive(),
-                                      LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setBgColor(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBorderColor(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setShadowColor(objects.btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBgColor(objects.btn_wifi_reconnect, color_inactive(),
+                                    LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setBorderColor(objects.btn_wifi_reconnect, color_inactive(),
+                                        LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setShadowColor(objects.btn_wifi_reconnect, color_inactive(),
+                                        LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
     }
     if (objects.label_btn_wifi_reconnect) {
-        lv_obj_set_style_text_color(objects.label_btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_text_color(objects.label_btn_wifi_reconnect, color_inactive(),
-                                    LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setTextColor(objects.label_btn_wifi_reconnect, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setTextColor(objects.label_btn_wifi_reconnect, color_inactive(),
+                                      LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
     }
     if (objects.btn_wifi_start_ap) {
         lv_obj_clear_flag(objects.btn_wifi_start_ap, LV_OBJ_FLAG_CHECKABLE);
-        lv_obj_set_style_bg_color(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_border_color(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_shadow_color(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_bg_color(objects.btn_wifi_start_ap, color_inactive(),
-                                  LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
-        lv_obj_set_style_border_color(objects.btn_wifi_start_ap, color_inactive(),
-                                      LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
-        lv_obj_set_style_shadow_color(objects.btn_wifi_start_ap, color_inactive(),
-                                      LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setBgColor(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBorderColor(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setShadowColor(objects.btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setBgColor(objects.btn_wifi_start_ap, color_inactive(),
+                                    LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setBorderColor(objects.btn_wifi_start_ap, color_inactive(),
+                                        LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setShadowColor(objects.btn_wifi_start_ap, color_inactive(),
+                                        LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
     }
     if (objects.label_btn_wifi_start_ap) {
-        lv_obj_set_style_text_color(objects.label_btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
-        lv_obj_set_style_text_color(objects.label_btn_wifi_start_ap, color_inactive(),
-                                    LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
+        UiWidgetBinding::setTextColor(objects.label_btn_wifi_start_ap, color_inactive(), LV_PART_MAIN | LV_STATE_DISABLED);
+        UiWidgetBinding::setTextColor(objects.label_btn_wifi_start_ap, color_inactive(),
+                                      LV_PART_MAIN | LV_STATE_DISABLED | LV_STATE_CHECKED);
     }
 
     if (objects.label_wifi_status_value) {
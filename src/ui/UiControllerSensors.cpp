@@ -8,6 +8,7 @@
 #include "ui/UiText.h"
 #include "ui/ui.h"
 #include "ui/fonts.h"
+#include "ui/UiWidgetBinding.h"
 #include "core/MathUtils.h"
 
 #include <math.h>
@@ -96,8 +97,7 @@ void UiController::update_sensor_cards(const AirQuality &aq, bool gas_warmup, bo
         safe_label_set_text_static(objects.label_co2_value_1, UiText::ValueMissing());
     }
     if (objects.co2_bar_wrap_1) {
-        show_co2_bar ? lv_obj_clear_flag(objects.co2_bar_wrap_1, LV_OBJ_FLAG_HIDDEN)
-                     : lv_obj_add_flag(objects.co2_bar_wrap_1, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.co2_bar_wrap_1, show_co2_bar);
     }
     lv_color_t co2_col = currentData.co2_valid ? getCO2Color(currentData.co2) : color_inactive();
     set_dot_color(objects.dot_co2_1, alert_color_for_mode(co2_col));
@@ -305,16 +305,13 @@ void UiController::update_sensor_cards(const AirQuality &aq, bool gas_warmup, bo
         safe_label_set_text_static(objects.label_voc_value_1, UiText::ValueMissing());
     }
     if (objects.label_voc_warmup_1) {
-        gas_warmup ? lv_obj_clear_flag(objects.label_voc_warmup_1, LV_OBJ_FLAG_HIDDEN)
-                   : lv_obj_add_flag(objects.label_voc_warmup_1, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.label_voc_warmup_1, gas_warmup);
     }
     if (objects.label_voc_value_1) {
-        gas_warmup ? lv_obj_add_flag(objects.label_voc_value_1, LV_OBJ_FLAG_HIDDEN)
-                   : lv_obj_clear_flag(objects.label_voc_value_1, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.label_voc_value_1, !gas_warmup);
     }
     if (objects.label_voc_unit_1) {
-        gas_warmup ? lv_obj_add_flag(objects.label_voc_unit_1, LV_OBJ_FLAG_HIDDEN)
-                   : lv_obj_clear_flag(objects.label_voc_unit_1, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.label_voc_unit_1, !gas_warmup);
     }
     lv_color_t voc_col = gas_warmup ? color_blue()
                                     : (currentData.voc_valid ? getVOCColor(currentData.voc_index) : color_inactive());
@@ -366,16 +363,13 @@ void UiController::update_sensor_cards(const AirQuality &aq, bool gas_warmup, bo
     if (objects.label_nox_unit_1) {
         safe_label_set_text_static(objects.label_nox_unit_1,
                                    nox_card_is_optional_gas ? "ppm" : UiText::UnitIndex());
-        nox_card_warmup ? lv_obj_add_flag(objects.label_nox_unit_1, LV_OBJ_FLAG_HIDDEN)
-                        : lv_obj_clear_flag(objects.label_nox_unit_1, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.label_nox_unit_1, !nox_card_warmup);
     }
     if (objects.label_nox_warmup_1) {
-        nox_card_warmup ? lv_obj_clear_flag(objects.label_nox_warmup_1, LV_OBJ_FLAG_HIDDEN)
-                        : lv_obj_add_flag(objects.label_nox_warmup_1, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.label_nox_warmup_1, nox_card_warmup);
     }
     if (objects.label_nox_value_1) {
-        nox_card_warmup ? lv_obj_add_flag(objects.label_nox_value_1, LV_OBJ_FLAG_HIDDEN)
-                        : lv_obj_clear_flag(objects.label_nox_value_1, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.label_nox_value_1, !nox_card_warmup);
         if (nox_card_is_optional_gas) {
             if (optional_gas_available) {
                 format_optional_gas_value(currentData, buf, sizeof(buf));
@@ -441,16 +435,13 @@ void UiController::update_sensor_cards(const AirQuality &aq, bool gas_warmup, bo
         safe_label_set_text_static(objects.label_co_unit, co_sensor_present ? "ppm" : "ug/m\xC2\xB3");
     }
     if (objects.label_co_warmup) {
-        co_warmup ? lv_obj_clear_flag(objects.label_co_warmup, LV_OBJ_FLAG_HIDDEN)
-                  : lv_obj_add_flag(objects.label_co_warmup, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.label_co_warmup, co_warmup);
     }
     if (objects.label_co_value) {
-        co_warmup ? lv_obj_add_flag(objects.label_co_value, LV_OBJ_FLAG_HIDDEN)
-                  : lv_obj_clear_flag(objects.label_co_value, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.label_co_value, !co_warmup);
     }
     if (objects.label_co_unit) {
-        co_warmup ? lv_obj_add_flag(objects.label_co_unit, LV_OBJ_FLAG_HIDDEN)
-                  : lv_obj_clear_flag(objects.label_co_unit, LV_OBJ_FLAG_HIDDEN);
+        UiWidgetBinding::setVisible(objects.label_co_unit, !co_warmup);
     }
     if (objects.label_co_value) {
         if (co_sensor_present) {
@@ -488,12 +479,12 @@ void UiController::update_sensor_cards(const AirQuality &aq, bool gas_warmup, bo
     // PRO divider lines follow active theme border color, no shadow.
     const lv_color_t divider_col = color_card_border();
     if (objects.line_1) {
-        lv_obj_set_style_line_color(objects.line_1, divider_col, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_shadow_opa(objects.line_1, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setLineColor(objects.line_1, divider_col, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowOpa(objects.line_1, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
     }
     if (objects.line_2) {
-        lv_obj_set_style_line_color(objects.line_2, divider_col, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_shadow_opa(objects.line_2, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setLineColor(objects.line_2, divider_col, LV_PART_MAIN | LV_STATE_DEFAULT);
+        UiWidgetBinding::setShadowOpa(objects.line_2, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
     }
 
     const bool pressure_prompt_altitude =
@@ -273,6 +273,7 @@ void UiController::update_boot_diag_texts() {
     if (objects.lbl_diag_reason_label) safe_label_set_text(objects.lbl_diag_reason_label, UiText::LabelBootDiagResetLabel());
     if (objects.lbl_diag_heap_label) safe_label_set_text(objects.lbl_diag_heap_label, UiText::LabelBootDiagHeapLabel());
     if (objects.lbl_diag_storage_label) safe_label_set_text(objects.lbl_diag_storage_label, UiText::LabelBootDiagStorageLabel());
+    if (objects.lbl_diag_boot_label) safe_label_set_text(objects.lbl_diag_boot_label, UiText::LabelBootDiagBootLabel());
     if (objects.lbl_diag_i2c_label) safe_label_set_text(objects.lbl_diag_i2c_label, UiText::LabelBootDiagI2cLabel());
     if (objects.lbl_diag_touch_label) safe_label_set_text(objects.lbl_diag_touch_label, UiText::LabelBootDiagTouchLabel());
     if (objects.lbl_diag_sen_label) safe_label_set_text(objects.lbl_diag_sen_label, UiText::LabelBootDiagSenLabel());
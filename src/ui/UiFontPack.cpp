@@ -0,0 +1,356 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "ui/UiFontPack.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <utility>
+
+#ifndef UNIT_TEST
+#include <esp_heap_caps.h>
+#endif
+
+namespace {
+
+void *pack_alloc(size_t bytes) {
+#ifdef UNIT_TEST
+    return malloc(bytes);
+#else
+    return heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#endif
+}
+
+void pack_free(void *ptr) {
+#ifdef UNIT_TEST
+    free(ptr);
+#else
+    heap_caps_free(ptr);
+#endif
+}
+
+uint16_t rd16(const uint8_t *p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t rd32(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+} // namespace
+
+UiFontPack::UiFontPack() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+UiFontPack::~UiFontPack() {
+    close();
+}
+
+uint32_t UiFontPack::glyphTableHash(const uint8_t *table, size_t len) {
+    uint32_t hash = 0x811C9DC5u;
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ table[i]) * 0x01000193u;
+    }
+    return hash;
+}
+
+uint16_t UiFontPack::fileVersion(Source &source) {
+    uint8_t head[6];
+    if (source.size() < sizeof(head) || !source.read(0, head, sizeof(head)) || rd32(head) != kMagic) {
+        return 0;
+    }
+    return rd16(head + 4);
+}
+
+bool UiFontPack::open(std::unique_ptr<Source> source) {
+    close();
+    if (!source) {
+        return false;
+    }
+
+    uint8_t header[kHeaderBytes];
+    if (source->size() < kHeaderBytes || !source->read(0, header, sizeof(header)) ||
+        rd32(header) != kMagic || rd16(header + 4) != kVersion) {
+        return false;
+    }
+    const uint16_t count = rd16(header + 6);
+    Metrics metrics;
+    metrics.line_height = static_cast<int16_t>(rd16(header + 8));
+    metrics.base_line = static_cast<int16_t>(rd16(header + 10));
+    metrics.underline_position = static_cast<int8_t>(header[12]);
+    metrics.underline_thickness = static_cast<int8_t>(header[13]);
+    metrics.bpp = header[14];
+    metrics.kern_scale = rd16(header + 16);
+    const uint8_t left_classes = header[18];
+    const uint8_t right_classes = header[19];
+    const uint32_t bitmap_bytes = rd32(header + 20);
+    metrics.glyph_hash = rd32(header + 24);
+
+    const uint32_t table_bytes = static_cast<uint32_t>(count) * kGlyphBytes;
+    const uint32_t kern_bytes = static_cast<uint32_t>(left_classes) * right_classes;
+    const uint32_t bitmap_base = kHeaderBytes + table_bytes + kern_bytes;
+    if (count == 0 || metrics.bpp == 0 || metrics.bpp > 8 ||
+        source->size() != bitmap_base + bitmap_bytes) {
+        return false;
+    }
+
+    uint8_t *raw = static_cast<uint8_t *>(pack_alloc(table_bytes));
+    Glyph *glyphs = static_cast<Glyph *>(pack_alloc(sizeof(Glyph) * count));
+    Slot *slots = static_cast<Slot *>(pack_alloc(sizeof(Slot) * count));
+    int8_t *kern = kern_bytes ? static_cast<int8_t *>(pack_alloc(kern_bytes)) : nullptr;
+    bool ok = raw && glyphs && slots && (kern || kern_bytes == 0) &&
+              source->read(kHeaderBytes, raw, table_bytes) &&
+              (kern_bytes == 0 || source->read(kHeaderBytes + table_bytes, kern, kern_bytes));
+    for (uint16_t i = 0; ok && i < count; ++i) {
+        const uint8_t *g = raw + static_cast<size_t>(i) * kGlyphBytes;
+        Glyph glyph;
+        glyph.codepoint = rd32(g);
+        glyph.bitmap_offset = rd32(g + 4);
+        glyph.bitmap_size = rd16(g + 8);
+        glyph.adv_w = rd16(g + 10);
+        glyph.box_w = g[12];
+        glyph.box_h = g[13];
+        glyph.ofs_x = static_cast<int8_t>(g[14]);
+        glyph.ofs_y = static_cast<int8_t>(g[15]);
+        glyph.kern_left = g[16];
+        glyph.kern_right = g[17];
+        glyph.languages = g[18];
+        ok = (i == 0 || glyph.codepoint > glyphs[i - 1].codepoint) &&
+             glyph.bitmap_offset + glyph.bitmap_size <= bitmap_bytes &&
+             glyph.kern_left <= left_classes && glyph.kern_right <= right_classes;
+        glyphs[i] = glyph;
+        slots[i] = Slot{};
+    }
+    ok = ok && glyphTableHash(raw, table_bytes) == metrics.glyph_hash;
+    pack_free(raw);
+    if (!ok) {
+        pack_free(glyphs);
+        pack_free(slots);
+        pack_free(kern);
+        return false;
+    }
+
+    lock();
+    source_ = std::move(source);
+    metrics_ = metrics;
+    glyphs_ = glyphs;
+    slots_ = slots;
+    kern_values_ = kern;
+    glyph_count_ = count;
+    left_classes_ = left_classes;
+    right_classes_ = right_classes;
+    bitmap_base_ = bitmap_base;
+    unlock();
+    return true;
+}
+
+void UiFontPack::close() {
+    lock();
+    for (uint16_t i = 0; i < glyph_count_; ++i) {
+        dropSlot(slots_[i]);
+    }
+    pack_free(glyphs_);
+    pack_free(slots_);
+    pack_free(kern_values_);
+    glyphs_ = nullptr;
+    slots_ = nullptr;
+    kern_values_ = nullptr;
+    glyph_count_ = 0;
+    left_classes_ = 0;
+    right_classes_ = 0;
+    bitmap_base_ = 0;
+    metrics_ = Metrics{};
+    source_.reset();
+    unlock();
+}
+
+bool UiFontPack::loaded() const {
+    lock();
+    const bool loaded = glyph_count_ > 0;
+    unlock();
+    return loaded;
+}
+
+const UiFontPack::Glyph *UiFontPack::find(uint32_t codepoint) const {
+    lock();
+    const Glyph *found = nullptr;
+    size_t lo = 0;
+    size_t hi = glyph_count_;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (glyphs_[mid].codepoint < codepoint) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < glyph_count_ && glyphs_[lo].codepoint == codepoint) {
+        found = &glyphs_[lo];
+    }
+    unlock();
+    return found;
+}
+
+int8_t UiFontPack::kerning(const Glyph &left, const Glyph &right) const {
+    lock();
+    int8_t value = 0;
+    // Class 0 means "no kerning pair", as in lv_font_fmt_txt.
+    if (kern_values_ && left.kern_left > 0 && right.kern_right > 0) {
+        value = kern_values_[static_cast<size_t>(left.kern_left - 1) * right_classes_ + (right.kern_right - 1)];
+    }
+    unlock();
+    return value;
+}
+
+const uint8_t *UiFontPack::bitmap(const Glyph &glyph) {
+    lock();
+    const uint8_t *bitmap = nullptr;
+    if (glyphs_ && &glyph >= glyphs_ && &glyph < glyphs_ + glyph_count_) {
+        bitmap = load(static_cast<size_t>(&glyph - glyphs_), true);
+    }
+    unlock();
+    return bitmap;
+}
+
+uint32_t UiFontPack::preload(uint8_t language) {
+    if (language >= 8) {
+        return 0;
+    }
+    const uint8_t bit = static_cast<uint8_t>(1u << language);
+    uint32_t loaded = 0;
+    lock();
+    for (uint16_t i = 0; i < glyph_count_; ++i) {
+        const Glyph &glyph = glyphs_[i];
+        if (!(glyph.languages & bit) || glyph.bitmap_size == 0 || slots_[i].bitmap) {
+            continue;
+        }
+        if (cache_bytes_ + glyph.bitmap_size > kCacheBytes) {
+            break;
+        }
+        if (!load(i, false)) {
+            break;
+        }
+        loaded++;
+    }
+    preloaded_ += loaded;
+    unlock();
+    return loaded;
+}
+
+void UiFontPack::trim() {
+    lock();
+    for (uint16_t i = 0; i < glyph_count_; ++i) {
+        dropSlot(slots_[i]);
+    }
+    unlock();
+}
+
+void UiFontPack::stats(Stats &out) const {
+    out = Stats{};
+    lock();
+    out.loaded = glyph_count_ > 0;
+    out.glyphs = glyph_count_;
+    out.cached = cached_;
+    out.cache_bytes = cache_bytes_;
+    out.hits = hits_;
+    out.misses = misses_;
+    out.preloaded = preloaded_;
+    out.evictions = evictions_;
+    out.read_errors = read_errors_;
+    unlock();
+}
+
+const uint8_t *UiFontPack::load(size_t index, bool evict) {
+    const Glyph &glyph = glyphs_[index];
+    Slot &slot = slots_[index];
+    if (glyph.bitmap_size == 0) {
+        return nullptr;
+    }
+    if (slot.bitmap) {
+        slot.last_used = ++use_seq_;
+        if (evict) {
+            hits_++;
+        }
+        return slot.bitmap;
+    }
+    if (evict ? !makeRoom(glyph.bitmap_size) : cache_bytes_ + glyph.bitmap_size > kCacheBytes) {
+        return nullptr;
+    }
+    uint8_t *bitmap = static_cast<uint8_t *>(pack_alloc(glyph.bitmap_size));
+    if (!bitmap) {
+        return nullptr;
+    }
+    if (!source_->read(bitmap_base_ + glyph.bitmap_offset, bitmap, glyph.bitmap_size)) {
+        pack_free(bitmap);
+        read_errors_++;
+        return nullptr;
+    }
+    slot.bitmap = bitmap;
+    slot.last_used = ++use_seq_;
+    cache_bytes_ += glyph.bitmap_size;
+    cached_++;
+    if (evict) {
+        misses_++;
+    }
+    return bitmap;
+}
+
+bool UiFontPack::makeRoom(uint32_t bytes) {
+    if (bytes > kCacheBytes) {
+        return false;
+    }
+    while (cache_bytes_ + bytes > kCacheBytes) {
+        Slot *oldest = nullptr;
+        for (uint16_t i = 0; i < glyph_count_; ++i) {
+            Slot &slot = slots_[i];
+            if (slot.bitmap && (!oldest || slot.last_used < oldest->last_used)) {
+                oldest = &slot;
+            }
+        }
+        if (!oldest) {
+            return false;
+        }
+        dropSlot(*oldest);
+        evictions_++;
+    }
+    return true;
+}
+
+void UiFontPack::dropSlot(Slot &slot) {
+    if (!slot.bitmap) {
+        return;
+    }
+    const size_t index = static_cast<size_t>(&slot - slots_);
+    pack_free(slot.bitmap);
+    cache_bytes_ -= glyphs_[index].bitmap_size;
+    cached_--;
+    slot = Slot{};
+}
+
+void UiFontPack::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void UiFontPack::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// One font from a pack file written by scripts/generate_font_packs.py. open() keeps the
+// header, glyph table and kerning classes in PSRAM; glyph bitmaps are read from the file on
+// first use and kept in an LRU cache of kCacheBytes. preload() reads every glyph one
+// language's UiStrings table uses, in file order, while it fits the cache.
+//
+// A bitmap pointer stays valid until the next bitmap() or trim() call on the same pack, which
+// is what LVGL needs to draw one glyph.
+//
+// The header carries a hash of the glyph table; open() checks it against the table it reads,
+// and UiPackedFonts compares it with the hash the firmware was built with.
+class UiFontPack {
+public:
+    static constexpr uint32_t kMagic = 0x544E4641; // "AFNT"
+    static constexpr uint16_t kVersion = 2;
+    static constexpr size_t kHeaderBytes = 28;
+    static constexpr size_t kGlyphBytes = 20;
+    // Holds the whole Chinese set of the 18 px pack (~90 KB) with room for table growth.
+    static constexpr uint32_t kCacheBytes = 96u * 1024u;
+
+    // Random access to the pack file.
+    class Source {
+    public:
+        virtual ~Source() = default;
+        virtual bool read(uint32_t offset, void *out, size_t len) = 0;
+        virtual uint32_t size() const = 0;
+    };
+
+    struct Metrics {
+        int16_t line_height = 0;
+        int16_t base_line = 0;
+        int8_t underline_position = 0;
+        int8_t underline_thickness = 0;
+        uint8_t bpp = 0;
+        uint16_t kern_scale = 0;
+        uint32_t glyph_hash = 0;
+    };
+
+    struct Glyph {
+        uint32_t codepoint = 0;
+        uint32_t bitmap_offset = 0;
+        uint16_t bitmap_size = 0;
+        uint16_t adv_w = 0; // 1/16 px, before kerning
+        uint8_t box_w = 0;
+        uint8_t box_h = 0;
+        int8_t ofs_x = 0;
+        int8_t ofs_y = 0;
+        uint8_t kern_left = 0;
+        uint8_t kern_right = 0;
+        uint8_t languages = 0; // bit per Config::Language whose strings use the glyph
+    };
+
+    struct Stats {
+        bool loaded = false;
+        uint16_t glyphs = 0;
+        uint16_t cached = 0;
+        uint32_t cache_bytes = 0;
+        uint32_t hits = 0;
+        uint32_t misses = 0;   // bitmaps read from the file on demand
+        uint32_t preloaded = 0;
+        uint32_t evictions = 0;
+        uint32_t read_errors = 0;
+    };
+
+    UiFontPack();
+    ~UiFontPack();
+    UiFontPack(const UiFontPack &) = delete;
+    UiFontPack &operator=(const UiFontPack &) = delete;
+
+    // 32-bit FNV-1a, as scripts/generate_font_packs.py computes it over the glyph table.
+    static uint32_t glyphTableHash(const uint8_t *table, size_t len);
+    // The format version in the header, 0 when the source does not start like a pack.
+    static uint16_t fileVersion(Source &source);
+
+    // Takes the source; false (and nothing loaded) when the file is missing or malformed.
+    bool open(std::unique_ptr<Source> source);
+    void close();
+    bool loaded() const;
+    const Metrics &metrics() const { return metrics_; }
+
+    // Binary search; nullptr when the pack has no such glyph.
+    const Glyph *find(uint32_t codepoint) const;
+    // In the font's kern_scale units, as lv_font_fmt_txt stores it.
+    int8_t kerning(const Glyph &left, const Glyph &right) const;
+    const uint8_t *bitmap(const Glyph &glyph);
+
+    // Reads the glyphs of `language` (Config::Language value) ahead of drawing them.
+    uint32_t preload(uint8_t language);
+    // Drops every cached bitmap.
+    void trim();
+
+    void stats(Stats &out) const;
+
+private:
+    struct Slot {
+        uint8_t *bitmap = nullptr;
+        uint32_t last_used = 0;
+    };
+
+    const uint8_t *load(size_t index, bool evict);
+    bool makeRoom(uint32_t bytes);
+    void dropSlot(Slot &slot);
+    void lock() const;
+    void unlock() const;
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    std::unique_ptr<Source> source_;
+    Metrics metrics_{};
+    Glyph *glyphs_ = nullptr;
+    Slot *slots_ = nullptr;
+    int8_t *kern_values_ = nullptr;
+    uint16_t glyph_count_ = 0;
+    uint8_t left_classes_ = 0;
+    uint8_t right_classes_ = 0;
+    uint32_t bitmap_base_ = 0;
+    uint32_t use_seq_ = 0;
+    uint32_t cache_bytes_ = 0;
+    uint16_t cached_ = 0;
+    uint32_t hits_ = 0;
+    uint32_t misses_ = 0;
+    uint32_t preloaded_ = 0;
+    uint32_t evictions_ = 0;
+    uint32_t read_errors_ = 0;
+};
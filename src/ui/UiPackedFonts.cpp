@@ -0,0 +1,346 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "ui/UiPackedFonts.h"
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+
+#include "core/Logger.h"
+#include "ui/UiFontPack.h"
+#include "ui/fonts.h"
+
+#if AURA_CJK_LINKED_FALLBACK
+extern "C" {
+extern const lv_font_t ui_font_noto_sans_sc_reg_14_linked;
+extern const lv_font_t ui_font_noto_sans_sc_reg_18_linked;
+}
+#endif
+
+namespace {
+
+#include "ui/generated/UiFontPackHashes.inc"
+
+class LittleFsFontSource final : public UiFontPack::Source {
+public:
+    explicit LittleFsFontSource(File file) : file_(file), size_(file.size()) {}
+    ~LittleFsFontSource() override { file_.close(); }
+
+    bool read(uint32_t offset, void *out, size_t len) override {
+        if (offset > size_ || len > size_ - offset || !file_.seek(offset)) {
+            return false;
+        }
+        return file_.read(static_cast<uint8_t *>(out), len) == len;
+    }
+
+    uint32_t size() const override { return size_; }
+
+private:
+    File file_;
+    uint32_t size_;
+};
+
+enum class PackState : uint8_t {
+    Unopened,
+    Loaded,
+    Missing,
+    Invalid,
+    Stale,
+};
+
+#if AURA_CJK_LINKED_FALLBACK
+constexpr char kFallbackName[] = "linked CJK";
+#else
+constexpr char kFallbackName[] = "Latin";
+#endif
+
+struct PackedFont {
+    const char *path;
+    int16_t line_height;
+    int16_t base_line;
+    uint32_t glyph_hash;
+    UiFontPack pack;
+    std::atomic<PackState> state{PackState::Unopened};
+    std::atomic<uint32_t> found_hash{0};
+};
+
+// Metrics of the lv_font_conv output the packs are made from; open() rejects a pack that
+// disagrees, since LVGL lays text out with these before any glyph is read.
+PackedFont font_14{"/fonts/noto_sans_sc_14.bin", 17, 4, kNotoSansSc14GlyphHash};
+PackedFont font_18{"/fonts/noto_sans_sc_18.bin", 21, 5, kNotoSansSc18GlyphHash};
+PackedFont *const kFonts[UiPackedFonts::kPackCount] = {&font_14, &font_18};
+
+// Loaded when `file` opens as the pack this build generated, Stale when it is a pack for
+// another glyph set (it stays open if its format is current), Invalid otherwise.
+PackState open_pack(UiFontPack &pack, const PackedFont &font, File file, uint32_t &found_hash) {
+    found_hash = 0;
+    LittleFsFontSource *source = new LittleFsFontSource(file);
+    const uint16_t version = UiFontPack::fileVersion(*source);
+    if (!pack.open(std::unique_ptr<UiFontPack::Source>(source))) {
+        return (version != 0 && version < UiFontPack::kVersion) ? PackState::Stale
+                                                                : PackState::Invalid;
+    }
+    if (pack.metrics().line_height != font.line_height ||
+        pack.metrics().base_line != font.base_line) {
+        pack.close();
+        return PackState::Invalid;
+    }
+    found_hash = pack.metrics().glyph_hash;
+    return found_hash == font.glyph_hash ? PackState::Loaded : PackState::Stale;
+}
+
+void note_state(PackedFont &font, PackState state) {
+    if (font.state.exchange(state) == state) {
+        return;
+    }
+    switch (state) {
+        case PackState::Missing:
+            LOGW("Fonts", "%s missing, CJK text falls back to the %s font", font.path, kFallbackName);
+            break;
+        case PackState::Invalid:
+            LOGE("Fonts", "%s is not a font pack for this firmware", font.path);
+            break;
+        case PackState::Stale:
+            LOGE("Fonts", "%s is stale (glyph hash %08lx, this firmware needs %08lx); upload the pack from this build",
+                 font.path, static_cast<unsigned long>(font.found_hash.load()),
+                 static_cast<unsigned long>(font.glyph_hash));
+            break;
+        case PackState::Unopened:
+        case PackState::Loaded:
+            break;
+    }
+}
+
+bool open_font(PackedFont &font) {
+    if (font.pack.loaded()) {
+        return true;
+    }
+    File file = LittleFS.open(font.path, FILE_READ);
+    if (!file || file.isDirectory()) {
+        note_state(font, PackState::Missing);
+        return false;
+    }
+    uint32_t found_hash = 0;
+    const PackState state = open_pack(font.pack, font, file, found_hash);
+    font.found_hash.store(found_hash);
+    note_state(font, state);
+    return font.pack.loaded();
+}
+
+// Header and table check only, for a language that does not draw with the pack.
+void check_font(PackedFont &font) {
+    if (font.pack.loaded() || font.state.load() != PackState::Unopened) {
+        return;
+    }
+    File file = LittleFS.open(font.path, FILE_READ);
+    if (!file || file.isDirectory()) {
+        return;
+    }
+    UiFontPack probe;
+    uint32_t found_hash = 0;
+    const PackState state = open_pack(probe, font, file, found_hash);
+    font.found_hash.store(found_hash);
+    note_state(font, state);
+}
+
+#if AURA_CJK_LINKED_FALLBACK
+const lv_font_t *linked_of(const lv_font_t *font) {
+    return static_cast<const lv_font_t *>(font->user_data);
+}
+#endif
+
+UiFontPack *pack_of(const lv_font_t *font) {
+    return static_cast<UiFontPack *>(const_cast<void *>(font->dsc));
+}
+
+// Same rounding as lv_font_get_glyph_dsc_fmt_txt, so text measures as it did when linked.
+bool get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc_out, uint32_t letter,
+                   uint32_t letter_next) {
+    UiFontPack *pack = pack_of(font);
+    const bool is_tab = (letter == '\t');
+    const UiFontPack::Glyph *glyph = pack->find(is_tab ? ' ' : letter);
+    if (!glyph) {
+#if AURA_CJK_LINKED_FALLBACK
+        // Answered here rather than through .fallback so the Latin font still follows.
+        const lv_font_t *linked = linked_of(font);
+        return linked->get_glyph_dsc(linked, dsc_out, letter, letter_next);
+#else
+        return false;
+#endif
+    }
+    int32_t kv = 0;
+    if (letter_next != 0) {
+        const UiFontPack::Glyph *next = pack->find(letter_next);
+        if (next) {
+            kv = (static_cast<int32_t>(pack->kerning(*glyph, *next)) * pack->metrics().kern_scale) >> 4;
+        }
+    }
+    uint32_t adv_w = glyph->adv_w;
+    if (is_tab) {
+        adv_w *= 2;
+    }
+    adv_w += kv;
+    adv_w = (adv_w + (1 << 3)) >> 4;
+
+    dsc_out->adv_w = static_cast<uint16_t>(adv_w);
+    dsc_out->box_h = glyph->box_h;
+    dsc_out->box_w = glyph->box_w;
+    dsc_out->ofs_x = glyph->ofs_x;
+    dsc_out->ofs_y = glyph->ofs_y;
+    dsc_out->bpp = pack->metrics().bpp;
+    dsc_out->is_placeholder = false;
+    if (is_tab) {
+        dsc_out->box_w = static_cast<uint16_t>(dsc_out->box_w * 2);
+    }
+    return true;
+}
+
+const uint8_t *get_glyph_bitmap(const lv_font_t *font, uint32_t letter) {
+    UiFontPack *pack = pack_of(font);
+    const UiFontPack::Glyph *glyph = pack->find(letter == '\t' ? ' ' : letter);
+#if AURA_CJK_LINKED_FALLBACK
+    if (!glyph) {
+        const lv_font_t *linked = linked_of(font);
+        return linked->get_glyph_bitmap(linked, letter);
+    }
+#endif
+    return glyph ? pack->bitmap(*glyph) : nullptr;
+}
+
+} // namespace
+
+const lv_font_t ui_font_noto_sans_sc_reg_14 = {
+    .get_glyph_dsc = get_glyph_dsc,
+    .get_glyph_bitmap = get_glyph_bitmap,
+    .line_height = 17,
+    .base_line = 4,
+    .subpx = LV_FONT_SUBPX_NONE,
+    .underline_position = -2,
+    .underline_thickness = 1,
+    .dsc = &font_14.pack,
+    .fallback = &ui_font_jet_reg_14,
+#if AURA_CJK_LINKED_FALLBACK
+    .user_data = const_cast<lv_font_t *>(&ui_font_noto_sans_sc_reg_14_linked),
+#else
+    .user_data = nullptr,
+#endif
+};
+
+const lv_font_t ui_font_noto_sans_sc_reg_18 = {
+    .get_glyph_dsc = get_glyph_dsc,
+    .get_glyph_bitmap = get_glyph_bitmap,
+    .line_height = 21,
+    .base_line = 5,
+    .subpx = LV_FONT_SUBPX_NONE,
+    .underline_position = -2,
+    .underline_thickness = 1,
+    .dsc = &font_18.pack,
+    .fallback = &ui_font_jet_reg_18,
+#if AURA_CJK_LINKED_FALLBACK
+    .user_data = const_cast<lv_font_t *>(&ui_font_noto_sans_sc_reg_18_linked),
+#else
+    .user_data = nullptr,
+#endif
+};
+
+namespace UiPackedFonts {
+
+void preloadLanguage(Config::Language language) {
+    if (language != Config::Language::ZH) {
+        for (PackedFont *font : kFonts) {
+            font->pack.trim();
+            check_font(*font);
+        }
+        return;
+    }
+    for (PackedFont *font : kFonts) {
+        if (!open_font(*font)) {
+            continue;
+        }
+        const uint32_t loaded = font->pack.preload(static_cast<uint8_t>(language));
+        UiFontPack::Stats stats;
+        font->pack.stats(stats);
+        LOGI("Fonts", "%s: %u glyphs, %u preloaded (%u bytes cached)", font->path,
+             static_cast<unsigned>(stats.glyphs), static_cast<unsigned>(loaded),
+             static_cast<unsigned>(stats.cache_bytes));
+    }
+}
+
+void status(PackStatus (&out)[kPackCount]) {
+    for (size_t i = 0; i < kPackCount; ++i) {
+        const PackedFont &font = *kFonts[i];
+        const PackState state = font.state.load();
+        UiFontPack::Stats stats;
+        font.pack.stats(stats);
+        out[i] = PackStatus{};
+        out[i].path = font.path;
+        out[i].loaded = stats.loaded;
+        out[i].missing = state == PackState::Missing;
+        out[i].invalid = state == PackState::Invalid;
+        out[i].stale = state == PackState::Stale;
+        out[i].glyph_hash = font.found_hash.load();
+        out[i].expected_hash = font.glyph_hash;
+        out[i].glyphs = stats.glyphs;
+        out[i].cache_bytes = stats.cache_bytes;
+    }
+}
+
+const char *packPath(const char *file_name) {
+    if (!file_name) {
+        return nullptr;
+    }
+    // Browsers send the bare name; strip a directory anyway.
+    const char *base = strrchr(file_name, '/');
+    base = base ? base + 1 : file_name;
+    for (const PackedFont *font : kFonts) {
+        if (strcmp(base, strrchr(font->path, '/') + 1) == 0) {
+            return font->path;
+        }
+    }
+    return nullptr;
+}
+
+InstallResult installPack(const char *temp_path, const char *path) {
+    const PackedFont *target = nullptr;
+    for (const PackedFont *font : kFonts) {
+        if (path && strcmp(font->path, path) == 0) {
+            target = font;
+        }
+    }
+    PackState state = PackState::Invalid;
+    uint32_t found_hash = 0;
+    if (target) {
+        File file = LittleFS.open(temp_path, FILE_READ);
+        if (file && !file.isDirectory()) {
+            UiFontPack probe;
+            state = open_pack(probe, *target, file, found_hash);
+        }
+    }
+    if (state != PackState::Loaded) {
+        LittleFS.remove(temp_path);
+        if (state == PackState::Stale) {
+            LOGE("Fonts", "uploaded %s is stale (glyph hash %08lx, this firmware needs %08lx)", path,
+                 static_cast<unsigned long>(found_hash), static_cast<unsigned long>(target->glyph_hash));
+            return InstallResult::Stale;
+        }
+        LOGE("Fonts", "uploaded %s is not a font pack for this firmware", path ? path : "file");
+        return InstallResult::Invalid;
+    }
+    LittleFS.remove(path);
+    if (!LittleFS.rename(temp_path, path)) {
+        LittleFS.remove(temp_path);
+        LOGE("Fonts", "could not move the upload to %s", path);
+        return InstallResult::WriteFailed;
+    }
+    LOGI("Fonts", "%s installed", path);
+    return InstallResult::Installed;
+}
+
+} // namespace UiPackedFonts
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "config/AppConfig.h"
+
+// The Noto Sans SC fonts (ui_font_noto_sans_sc_reg_14/18 from fonts.h) are not linked into the
+// firmware; they are defined in UiPackedFonts.cpp on top of the packs in /fonts on LittleFS
+// (scripts/generate_font_packs.py). The packs reach the device with `pio run -t uploadfs` on a
+// fresh install, and through the web firmware upload afterwards: a pack file sent there is
+// installed instead of flashed. Glyphs the pack lacks, or every glyph while the pack cannot be
+// read, come from the linked Noto Sans SC font while AURA_CJK_LINKED_FALLBACK is set (a device
+// updated over the web from a build without packs has none until they are uploaded), and from
+// the matching JetBrains Mono font otherwise; /api/diag reports the pack missing.
+//
+// Each pack carries the hash of its glyph table and the build compiles in the hashes of the
+// packs it generated. A pack from another build is refused by installPack() and reported
+// stale at boot; a stale pack that still opens keeps drawing the glyphs it has.
+namespace UiPackedFonts {
+
+static constexpr size_t kPackCount = 2;
+
+struct PackStatus {
+    const char *path = nullptr;
+    bool loaded = false;
+    bool missing = false; // the selected language needs it and it is not on LittleFS
+    bool invalid = false; // on LittleFS but not a pack for this firmware
+    bool stale = false;   // a pack, but for another build's glyph set
+    uint32_t glyph_hash = 0;    // of the pack on LittleFS, 0 when unknown
+    uint32_t expected_hash = 0; // of the pack this build generated
+    uint16_t glyphs = 0;
+    uint32_t cache_bytes = 0;
+};
+
+enum class InstallResult : uint8_t {
+    Installed = 0,
+    Invalid,
+    Stale,
+    WriteFailed,
+};
+
+// Opens the packs and reads the glyphs of `language` ahead of the first draw; for a language
+// that does not use the packs it drops their cached bitmaps instead and only checks the
+// headers, so a stale pack is reported from boot on.
+void preloadLanguage(Config::Language language);
+
+// Any task.
+void status(PackStatus (&out)[kPackCount]);
+// /fonts path of the pack an uploaded file named `file_name` replaces, nullptr when the name
+// is not one of the packs.
+const char *packPath(const char *file_name);
+// Moves the upload at `temp_path` over `path` once it opens as the pack this build generated;
+// otherwise the upload is removed. Takes effect on the next boot.
+InstallResult installPack(const char *temp_path, const char *path);
+
+} // namespace UiPackedFonts
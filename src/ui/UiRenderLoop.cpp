@@ -7,6 +7,7 @@
 #include "ui/UiRenderLoop.h"
 
 #include "config/AppConfig.h"
+#include "core/SensorPollRate.h"
 #include "modules/NetworkManager.h"
 #include "ui/BacklightManager.h"
 #include "ui/NightModeManager.h"
@@ -24,6 +25,9 @@ constexpr uint32_t SETTINGS_HEADER_UPDATE_MS = 750;
 } // namespace
 
 void UiRenderLoop::process(UiController &owner, uint32_t now_ms) {
+    SensorPollRates::instance().setDemand(SensorPollRates::DEMAND_GRAPH,
+                                          owner.current_screen_id == SCREEN_ID_PAGE_SENSORS_INFO &&
+                                              owner.current_info_graph_mode());
     bool allow_ui_update = true;
     if (owner.connectivity_.wifi_state == static_cast<int>(AuraNetworkManager::WIFI_STATE_AP_CONFIG) &&
         (now_ms - owner.last_ui_update_ms) < WIFI_UI_UPDATE_MS) {
@@ -0,0 +1,256 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "ui/UiScreenCache.h"
+
+UiScreenCache &UiScreenCache::instance() {
+    static UiScreenCache cache;
+    return cache;
+}
+
+UiScreenCache::UiScreenCache() {
+#ifndef UNIT_TEST
+    mutex_ = xSemaphoreCreateMutexStatic(&mutex_buffer_);
+#endif
+}
+
+void UiScreenCache::reset() {
+    lock();
+    state_ = State{};
+    unlock();
+}
+
+void UiScreenCache::setPinned(int screen_id, bool pinned) {
+    if (!validId(screen_id)) {
+        return;
+    }
+    lock();
+    state_.pinned[screen_id] = pinned;
+    unlock();
+}
+
+void UiScreenCache::setHint(int from_screen_id, int to_screen_id) {
+    if (!validId(from_screen_id) || !validId(to_screen_id)) {
+        return;
+    }
+    lock();
+    state_.hint[from_screen_id] = static_cast<uint8_t>(to_screen_id);
+    unlock();
+}
+
+void UiScreenCache::noteBuilt(int screen_id, uint32_t bytes, uint32_t build_us, bool prewarmed, uint32_t now_ms) {
+    if (!validId(screen_id)) {
+        return;
+    }
+    lock();
+    State &s = state_;
+    if (s.pinned[screen_id]) {
+        unlock();
+        return;
+    }
+    if (s.resident[screen_id]) {
+        s.resident_bytes -= s.bytes[screen_id];
+    }
+    s.resident[screen_id] = true;
+    s.bytes[screen_id] = bytes;
+    s.resident_bytes += bytes;
+    s.last_used_ms[screen_id] = now_ms;
+    s.hold_until_ms[screen_id] = 0;
+
+    if (prewarmed) {
+        s.prewarms++;
+    } else {
+        s.misses++;
+        s.build_us_last = build_us;
+        s.build_us_total += build_us;
+        if (build_us >= s.build_us_max) {
+            s.build_us_max = build_us;
+            s.slowest_screen = static_cast<uint8_t>(screen_id);
+        }
+    }
+    unlock();
+}
+
+void UiScreenCache::noteShown(int previous_screen_id, int screen_id, bool was_resident, uint32_t now_ms) {
+    lock();
+    State &s = state_;
+    if (validId(previous_screen_id) && previous_screen_id != screen_id) {
+        s.last_used_ms[previous_screen_id] = now_ms;
+        s.hold_until_ms[previous_screen_id] = now_ms + kSettleMs;
+        if (validId(screen_id)) {
+            uint8_t *row = s.transitions[previous_screen_id];
+            if (row[screen_id] == UINT8_MAX) {
+                // Age the whole row so recent habits outweigh old ones.
+                for (size_t i = 0; i < kSlotCount; ++i) {
+                    row[i] /= 2;
+                }
+            }
+            row[screen_id]++;
+        }
+    }
+    if (validId(screen_id)) {
+        s.last_used_ms[screen_id] = now_ms;
+        s.hold_until_ms[screen_id] = 0;
+        if (was_resident && !s.pinned[screen_id]) {
+            s.hits++;
+        }
+    }
+    s.prewarm_attempted = false;
+    unlock();
+}
+
+void UiScreenCache::noteReleased(int screen_id) {
+    if (!validId(screen_id)) {
+        return;
+    }
+    lock();
+    State &s = state_;
+    if (s.resident[screen_id]) {
+        // bytes is kept: it is the best guess of what building the screen again will cost.
+        s.resident[screen_id] = false;
+        s.resident_bytes -= s.bytes[screen_id];
+        s.hold_until_ms[screen_id] = 0;
+        s.releases++;
+    }
+    unlock();
+}
+
+void UiScreenCache::deferRelease(int screen_id, uint32_t now_ms) {
+    if (!validId(screen_id)) {
+        return;
+    }
+    lock();
+    state_.hold_until_ms[screen_id] = now_ms + kRetryMs;
+    unlock();
+}
+
+void UiScreenCache::notePrewarmAttempt() {
+    lock();
+    state_.prewarm_attempted = true;
+    unlock();
+}
+
+int UiScreenCache::releaseCandidate(int current_screen_id, int pending_screen_id, uint32_t now_ms) const {
+    if (pending_screen_id != 0) {
+        return 0;
+    }
+    lock();
+    const State &s = state_;
+    int oldest = 0;
+    uint32_t oldest_age_ms = 0;
+    for (int id = 1; id < static_cast<int>(kSlotCount); ++id) {
+        if (!s.resident[id] || s.pinned[id] || id == current_screen_id ||
+            !reached(now_ms, s.hold_until_ms[id])) {
+            continue;
+        }
+        const uint32_t age_ms = now_ms - s.last_used_ms[id];
+        if (oldest == 0 || age_ms > oldest_age_ms) {
+            oldest = id;
+            oldest_age_ms = age_ms;
+        }
+    }
+    const bool release = oldest != 0 &&
+                         (s.resident_bytes > kBudgetBytes || oldest_age_ms >= kIdleReleaseMs);
+    unlock();
+    return release ? oldest : 0;
+}
+
+int UiScreenCache::prewarmCandidate(int current_screen_id, int pending_screen_id) const {
+    if (pending_screen_id != 0 || !validId(current_screen_id)) {
+        return 0;
+    }
+    lock();
+    const State &s = state_;
+    if (s.prewarm_attempted) {
+        unlock();
+        return 0;
+    }
+    int best = 0;
+    const uint8_t *row = s.transitions[current_screen_id];
+    for (int id = 1; id < static_cast<int>(kSlotCount); ++id) {
+        if (row[id] == 0 || id == current_screen_id || s.resident[id] || s.pinned[id]) {
+            continue;
+        }
+        if (best == 0 || row[id] > row[best]) {
+            best = id;
+        }
+    }
+    if (best == 0) {
+        best = s.hint[current_screen_id];
+        if (!validId(best) || s.resident[best] || s.pinned[best]) {
+            best = 0;
+        }
+    }
+    if (best != 0) {
+        const uint32_t cost = s.bytes[best];
+        const bool fits = cost != 0 ? s.resident_bytes + cost <= kBudgetBytes
+                                    : s.resident_bytes < kBudgetBytes;
+        if (!fits) {
+            best = 0;
+        }
+    }
+    unlock();
+    return best;
+}
+
+bool UiScreenCache::isResident(int screen_id) const {
+    if (!validId(screen_id)) {
+        return false;
+    }
+    lock();
+    const bool resident = state_.resident[screen_id];
+    unlock();
+    return resident;
+}
+
+void UiScreenCache::stats(Stats &out) const {
+    out = Stats{};
+    lock();
+    const State &s = state_;
+    for (size_t i = 0; i < kSlotCount; ++i) {
+        if (s.resident[i]) {
+            out.resident++;
+        }
+    }
+    out.resident_bytes = s.resident_bytes;
+    out.hits = s.hits;
+    out.misses = s.misses;
+    out.prewarms = s.prewarms;
+    out.releases = s.releases;
+    out.build_us_last = s.build_us_last;
+    out.build_us_max = s.build_us_max;
+    out.build_us_avg = s.misses == 0 ? 0 : static_cast<uint32_t>(s.build_us_total / s.misses);
+    out.slowest_screen = s.slowest_screen;
+    unlock();
+}
+
+bool UiScreenCache::validId(int screen_id) {
+    return screen_id > 0 && screen_id < static_cast<int>(kSlotCount);
+}
+
+bool UiScreenCache::reached(uint32_t now_ms, uint32_t at_ms) {
+    return at_ms == 0 || static_cast<int32_t>(now_ms - at_ms) >= 0;
+}
+
+void UiScreenCache::lock() const {
+#ifdef UNIT_TEST
+    mutex_.lock();
+#else
+    if (mutex_) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+#endif
+}
+
+void UiScreenCache::unlock() const {
+#ifdef UNIT_TEST
+    mutex_.unlock();
+#else
+    if (mutex_) {
+        xSemaphoreGive(mutex_);
+    }
+#endif
+}
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// Decides which lazily built screens stay resident. A screen is built on first navigation (or
+// ahead of it while the UI is idle, see prewarmCandidate) and kept while the bytes LVGL handed
+// out to build it fit kBudgetBytes; past the budget the least recently shown one is released,
+// and a screen nobody opened for kIdleReleaseMs goes as well. Pinned screens are owned by
+// ui_init and the boot flow and are never counted or released here.
+//
+// Driven from the LVGL thread by UiScreenFlow; stats() may be called from any task.
+class UiScreenCache {
+public:
+    static constexpr size_t kSlotCount = 16; // screen ids are 1..15
+    static constexpr uint32_t kBudgetBytes = 96u * 1024u;
+    static constexpr uint32_t kSettleMs = 300;   // a screen just left is kept while the switch settles
+    static constexpr uint32_t kRetryMs = 100;
+    static constexpr uint32_t kIdleReleaseMs = 10u * 60u * 1000u;
+    static constexpr uint32_t kPrewarmIdleMs = 2000; // no touch input for this long before prewarming
+
+    struct Stats {
+        uint8_t resident = 0;
+        uint32_t resident_bytes = 0;
+        uint32_t budget_bytes = kBudgetBytes;
+        uint32_t hits = 0;      // navigations to a screen that was already built
+        uint32_t misses = 0;    // navigations that had to build the screen first
+        uint32_t prewarms = 0;
+        uint32_t releases = 0;
+        uint32_t build_us_last = 0; // build time of the last miss, as seen by the user
+        uint32_t build_us_max = 0;
+        uint32_t build_us_avg = 0;
+        uint8_t slowest_screen = 0;
+    };
+
+    static UiScreenCache &instance();
+
+    void reset();
+    void setPinned(int screen_id, bool pinned);
+    // Screen to prewarm from `from_screen_id` until navigation history says otherwise.
+    void setHint(int from_screen_id, int to_screen_id);
+
+    void noteBuilt(int screen_id, uint32_t bytes, uint32_t build_us, bool prewarmed, uint32_t now_ms);
+    void noteShown(int previous_screen_id, int screen_id, bool was_resident, uint32_t now_ms);
+    void noteReleased(int screen_id);
+    // The unload did not take (screen still active); try again shortly.
+    void deferRelease(int screen_id, uint32_t now_ms);
+    void notePrewarmAttempt();
+
+    // Next resident screen to release, 0 when everything may stay.
+    int releaseCandidate(int current_screen_id, int pending_screen_id, uint32_t now_ms) const;
+    // Likely next screen that is not built yet and fits the budget, 0 when there is none.
+    // At most one attempt per visit of the current screen.
+    int prewarmCandidate(int current_screen_id, int pending_screen_id) const;
+
+    bool isResident(int screen_id) const;
+    void stats(Stats &out) const;
+
+private:
+    struct State {
+        bool pinned[kSlotCount] = {};
+        bool resident[kSlotCount] = {};
+        uint32_t bytes[kSlotCount] = {};
+        uint32_t last_used_ms[kSlotCount] = {};
+        uint32_t hold_until_ms[kSlotCount] = {};
+        uint8_t hint[kSlotCount] = {};
+        uint8_t transitions[kSlotCount][kSlotCount] = {};
+        bool prewarm_attempted = false;
+        uint32_t resident_bytes = 0;
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t prewarms = 0;
+        uint32_t releases = 0;
+        uint32_t build_us_last = 0;
+        uint32_t build_us_max = 0;
+        uint64_t build_us_total = 0;
+        uint8_t slowest_screen = 0;
+    };
+
+    UiScreenCache();
+
+    static bool validId(int screen_id);
+    static bool reached(uint32_t now_ms, uint32_t at_ms);
+    void lock() const;
+    void unlock() const;
+
+#ifdef UNIT_TEST
+    mutable std::mutex mutex_{};
+#else
+    mutable StaticSemaphore_t mutex_buffer_{};
+    mutable SemaphoreHandle_t mutex_ = nullptr;
+#endif
+    State state_{};
+};
@@ -9,16 +9,19 @@
 #include "core/Logger.h"
 #include "modules/NetworkManager.h"
 #include "ui/BacklightManager.h"
+#include "ui/LvglMemPool.h"
 #include "ui/NightModeManager.h"
 #include "ui/UiBootFlow.h"
 #include "ui/UiController.h"
 #include "ui/UiEventBinder.h"
+#include "ui/UiScreenCache.h"
 #include "ui/ThemeManager.h"
 #include "ui/ui.h"
 
 #if !defined(EEZ_FOR_LVGL)
 extern "C" void loadScreen(enum ScreensEnum screenId);
 extern "C" void unloadScreen(enum ScreensEnum screenId);
+extern "C" void prepareScreen(enum ScreensEnum screenId);
 #endif
 
 void UiScreenFlow::processPendingScreen(UiController &owner, uint32_t now_ms) {
@@ -27,6 +30,8 @@ void UiScreenFlow::processPendingScreen(UiController &owner, uint32_t now_ms) {
         int next_screen = owner.pending_screen_id;
         int previous_screen = owner.current_screen_id;
         ScreensEnum next_screen_enum = static_cast<ScreensEnum>(next_screen);
+        const bool was_resident = UiEventBinder::screenRootById(next_screen) != nullptr;
+        const uint32_t switch_start_us = micros();
         loadScreen(next_screen_enum);
         if (!UiEventBinder::screenRootById(next_screen)) {
             if (next_screen == SCREEN_ID_PAGE_MQTT) {
@@ -46,9 +51,21 @@ void UiScreenFlow::processPendingScreen(UiController &owner, uint32_t now_ms) {
             owner.pending_screen_id = 0;
             owner.reset_dynamic_url_caches();
 
-            // Lazily rebuilt screens can be released on exit.
-            // Delay unload slightly to avoid racing with screen activation.
-            owner.deferred_unload_.scheduleOnSwitch(previous_screen, owner.current_screen_id, now_ms);
+            UiScreenCache &screen_cache = UiScreenCache::instance();
+            if (!was_resident) {
+                // First navigation: building and binding the screen is the latency the user sees.
+                const uint32_t build_us = micros() - switch_start_us;
+                const uint32_t bytes = LvglMemPool::instance().arenaBytes(static_cast<uint8_t>(next_screen));
+                screen_cache.noteBuilt(next_screen, bytes, build_us, false, now_ms);
+                LOGD("UI", "screen %d built on navigation in %lu us (%lu B)",
+                     next_screen,
+                     static_cast<unsigned long>(build_us),
+                     static_cast<unsigned long>(bytes));
+            } else if (was_bound && next_screen == SCREEN_ID_PAGE_SENSORS_INFO) {
+                // Kept resident across the visit: its graph runtime objects were released on exit.
+                owner.restore_sensor_info_selection();
+            }
+            screen_cache.noteShown(previous_screen, owner.current_screen_id, was_resident, now_ms);
 
             if (previous_screen == SCREEN_ID_PAGE_SENSORS_INFO &&
                 owner.current_screen_id != SCREEN_ID_PAGE_SENSORS_INFO) {
@@ -104,13 +121,14 @@ void UiScreenFlow::processBootRelease(UiController &owner, uint32_t now_ms) {
     }
 }
 
-void UiScreenFlow::processDeferredUnloads(UiController &owner, uint32_t now_ms) {
-    for (size_t i = 0; i < owner.deferred_unload_.count(); ++i) {
-        if (!owner.deferred_unload_.ready(i, now_ms, owner.pending_screen_id, owner.current_screen_id)) {
-            continue;
+void UiScreenFlow::processResidentScreens(UiController &owner, uint32_t now_ms) {
+    UiScreenCache &screen_cache = UiScreenCache::instance();
+    for (size_t attempt = 0; attempt < UiScreenCache::kSlotCount; ++attempt) {
+        const int unload_screen_id =
+            screen_cache.releaseCandidate(owner.current_screen_id, owner.pending_screen_id, now_ms);
+        if (unload_screen_id == 0) {
+            return;
         }
-
-        const int unload_screen_id = owner.deferred_unload_.screenId(i);
         unloadScreen(static_cast<ScreensEnum>(unload_screen_id));
         if (!UiEventBinder::screenRootById(unload_screen_id)) {
             if (unload_screen_id > 0 &&
@@ -121,10 +139,36 @@ void UiScreenFlow::processDeferredUnloads(UiController &owner, uint32_t now_ms)
                 // Theme screen is rebuilt lazily, so its swatch callbacks must be rebound.
                 owner.theme_events_bound_ = false;
             }
-            owner.deferred_unload_.clear(i);
+            screen_cache.noteReleased(unload_screen_id);
         } else {
             // Screen switch may still be settling; retry shortly.
-            owner.deferred_unload_.retry(i, now_ms);
+            screen_cache.deferRelease(unload_screen_id, now_ms);
         }
     }
 }
+
+void UiScreenFlow::processPrewarm(UiController &owner, uint32_t now_ms) {
+    if (!owner.boot_ui_released || owner.pending_screen_id != 0 ||
+        lv_disp_get_inactive_time(nullptr) < UiScreenCache::kPrewarmIdleMs) {
+        return;
+    }
+    UiScreenCache &screen_cache = UiScreenCache::instance();
+    const int screen_id = screen_cache.prewarmCandidate(owner.current_screen_id, owner.pending_screen_id);
+    if (screen_id == 0) {
+        return;
+    }
+    screen_cache.notePrewarmAttempt();
+    const uint32_t start_us = micros();
+    prepareScreen(static_cast<ScreensEnum>(screen_id));
+    if (!UiEventBinder::screenRootById(screen_id)) {
+        return;
+    }
+    // Events are bound on first load, as for a screen built on navigation.
+    const uint32_t build_us = micros() - start_us;
+    const uint32_t bytes = LvglMemPool::instance().arenaBytes(static_cast<uint8_t>(screen_id));
+    screen_cache.noteBuilt(screen_id, bytes, build_us, true, now_ms);
+    LOGD("UI", "screen %d prewarmed in %lu us (%lu B)",
+         screen_id,
+         static_cast<unsigned long>(build_us),
+         static_cast<unsigned long>(bytes));
+}
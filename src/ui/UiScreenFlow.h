@@ -14,6 +14,7 @@ class UiScreenFlow {
 public:
     static void processPendingScreen(UiController &owner, uint32_t now_ms);
     static void processBootRelease(UiController &owner, uint32_t now_ms);
-    static void processDeferredUnloads(UiController &owner, uint32_t now_ms);
+    static void processResidentScreens(UiController &owner, uint32_t now_ms);
+    static void processPrewarm(UiController &owner, uint32_t now_ms);
 };
 
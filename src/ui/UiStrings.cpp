@@ -8,6 +8,8 @@
 
 #include <stddef.h>
 
+#include "ui/UiPackedFonts.h"
+
 namespace UiStrings {
 
 namespace {
@@ -88,6 +90,7 @@ const char *const *tableFor(Language lang) {
 
 void setLanguage(Language lang) {
     g_language = lang;
+    UiPackedFonts::preloadLanguage(lang);
 }
 
 Language language() {
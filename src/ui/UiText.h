@@ -186,6 +186,7 @@ inline const char *LabelBootDiagMacLabel() { return UiStrings::text(UiStrings::T
 inline const char *LabelBootDiagResetLabel() { return UiStrings::text(UiStrings::TextId::LabelBootDiagResetLabel); }
 inline const char *LabelBootDiagHeapLabel() { return UiStrings::text(UiStrings::TextId::LabelBootDiagHeapLabel); }
 inline const char *LabelBootDiagStorageLabel() { return UiStrings::text(UiStrings::TextId::LabelBootDiagStorageLabel); }
+inline const char *LabelBootDiagBootLabel() { return UiStrings::text(UiStrings::TextId::LabelBootDiagBootLabel); }
 inline const char *LabelBootDiagI2cLabel() { return UiStrings::text(UiStrings::TextId::LabelBootDiagI2cLabel); }
 inline const char *LabelBootDiagTouchLabel() { return UiStrings::text(UiStrings::TextId::LabelBootDiagTouchLabel); }
 inline const char *LabelBootDiagSenLabel() { return UiStrings::text(UiStrings::TextId::LabelBootDiagSenLabel); }
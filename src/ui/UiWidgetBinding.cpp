@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#include "ui/UiWidgetBinding.h"
+
+#include <atomic>
+#include <string.h>
+
+namespace {
+
+std::atomic<uint32_t> g_applied{0};
+std::atomic<uint32_t> g_skipped{0};
+
+bool count(bool applied) {
+    (applied ? g_applied : g_skipped).fetch_add(1, std::memory_order_relaxed);
+    return applied;
+}
+
+bool set_color(lv_obj_t *obj, lv_style_prop_t prop, lv_color_t color, lv_style_selector_t selector) {
+    if (!obj) {
+        return false;
+    }
+    lv_style_value_t current;
+    if (lv_obj_get_local_style_prop(obj, prop, &current, selector) == LV_RES_OK &&
+        current.color.full == color.full) {
+        return count(false);
+    }
+    lv_style_value_t value;
+    value.color = color;
+    lv_obj_set_local_style_prop(obj, prop, value, selector);
+    return count(true);
+}
+
+bool set_opa(lv_obj_t *obj, lv_style_prop_t prop, lv_opa_t opa, lv_style_selector_t selector) {
+    if (!obj) {
+        return false;
+    }
+    lv_style_value_t current;
+    if (lv_obj_get_local_style_prop(obj, prop, &current, selector) == LV_RES_OK &&
+        current.num == static_cast<int32_t>(opa)) {
+        return count(false);
+    }
+    lv_style_value_t value;
+    value.num = static_cast<int32_t>(opa);
+    lv_obj_set_local_style_prop(obj, prop, value, selector);
+    return count(true);
+}
+
+} // namespace
+
+namespace UiWidgetBinding {
+
+bool setText(lv_obj_t *label, const char *text) {
+    if (!label || !text) {
+        return false;
+    }
+    const char *current = lv_label_get_text(label);
+    if (current && strcmp(current, text) == 0) {
+        return count(false);
+    }
+    lv_label_set_text(label, text);
+    return count(true);
+}
+
+bool setVisible(lv_obj_t *obj, bool visible) {
+    if (!obj) {
+        return false;
+    }
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) != visible) {
+        return count(false);
+    }
+    if (visible) {
+        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+    return count(true);
+}
+
+bool setBgColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector) {
+    return set_color(obj, LV_STYLE_BG_COLOR, color, selector);
+}
+
+bool setBgOpa(lv_obj_t *obj, lv_opa_t opa, lv_style_selector_t selector) {
+    return set_opa(obj, LV_STYLE_BG_OPA, opa, selector);
+}
+
+bool setBorderColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector) {
+    return set_color(obj, LV_STYLE_BORDER_COLOR, color, selector);
+}
+
+bool setShadowColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector) {
+    return set_color(obj, LV_STYLE_SHADOW_COLOR, color, selector);
+}
+
+bool setShadowOpa(lv_obj_t *obj, lv_opa_t opa, lv_style_selector_t selector) {
+    return set_opa(obj, LV_STYLE_SHADOW_OPA, opa, selector);
+}
+
+bool setTextColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector) {
+    return set_color(obj, LV_STYLE_TEXT_COLOR, color, selector);
+}
+
+bool setTextOpa(lv_obj_t *obj, lv_opa_t opa, lv_style_selector_t selector) {
+    return set_opa(obj, LV_STYLE_TEXT_OPA, opa, selector);
+}
+
+bool setLineColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector) {
+    return set_color(obj, LV_STYLE_LINE_COLOR, color, selector);
+}
+
+void stats(Stats &out) {
+    out.applied = g_applied.load(std::memory_order_relaxed);
+    out.skipped = g_skipped.load(std::memory_order_relaxed);
+}
+
+} // namespace UiWidgetBinding
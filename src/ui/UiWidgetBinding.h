@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2025-2026 Volodymyr Papush (21CNCStudio)
+// SPDX-License-Identifier: GPL-3.0-or-later
+// GPL-3.0-or-later: https://www.gnu.org/licenses/gpl-3.0.html
+// Want to use this code in a commercial product while keeping modifications proprietary?
+// Purchase a Commercial License: see COMMERCIAL_LICENSE_SUMMARY.md
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdint.h>
+
+// Setters for the widget properties the UI refreshes on every tick. LVGL invalidates an object
+// on each style or flag write, even one that repeats the current value, and the header and chip
+// shadows are the most expensive things on this panel to redraw. Each setter compares against
+// what the object already holds (its local style, label text or hidden flag) and skips the
+// write when nothing changes. Reading the object rather than a side cache keeps this correct
+// when a theme or the generated screen code sets the same property directly.
+//
+// LVGL thread only. Every setter returns true when it wrote.
+namespace UiWidgetBinding {
+
+struct Stats {
+    uint32_t applied = 0;
+    uint32_t skipped = 0;
+};
+
+bool setText(lv_obj_t *label, const char *text);
+bool setVisible(lv_obj_t *obj, bool visible);
+
+bool setBgColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector);
+bool setBgOpa(lv_obj_t *obj, lv_opa_t opa, lv_style_selector_t selector);
+bool setBorderColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector);
+bool setShadowColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector);
+bool setShadowOpa(lv_obj_t *obj, lv_opa_t opa, lv_style_selector_t selector);
+bool setTextColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector);
+bool setTextOpa(lv_obj_t *obj, lv_opa_t opa, lv_style_selector_t selector);
+bool setLineColor(lv_obj_t *obj, lv_color_t color, lv_style_selector_t selector);
+
+// Any thread.
+void stats(Stats &out);
+
+} // namespace UiWidgetBinding
@@ -34,11 +34,13 @@ typedef struct _objects_t {
     lv_obj_t *lbl_diag_reason_label;
     lv_obj_t *lbl_diag_heap_label;
     lv_obj_t *lbl_diag_storage_label;
+    lv_obj_t *lbl_diag_boot_label;
     lv_obj_t *lbl_diag_app_ver;
     lv_obj_t *lbl_diag_mac;
     lv_obj_t *lbl_diag_reason;
     lv_obj_t *lbl_diag_heap;
     lv_obj_t *lbl_diag_storage;
+    lv_obj_t *lbl_diag_boot;
     lv_obj_t *lbl_diag_sensors_title;
     lv_obj_t *lbl_diag_i2c_label;
     lv_obj_t *lbl_diag_touch_label;
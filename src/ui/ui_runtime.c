@@ -25,6 +25,8 @@ void ui_tick() {
 #include <stddef.h>
 #include <string.h>
 
+#include "lvgl_mem_pool.h"
+
 enum { UI_KNOWN_SCREEN_COUNT = SCREEN_ID_PAGE_DIAG };
 enum { UI_PAGE_SLOT_COUNT = (int)(offsetof(objects_t, label_boot_ver) / sizeof(lv_obj_t *)) };
 enum { UI_OBJECT_SLOT_COUNT = (int)(sizeof(objects_t) / sizeof(lv_obj_t *)) };
@@ -145,14 +147,16 @@ static void createScreenById(enum ScreensEnum screenId) {
     }
     create_screen_func_t create_fn = screen_create_funcs[screenId];
     if (create_fn) {
+        lvgl_mem_pool_begin_screen(screenId);
         create_fn();
+        lvgl_mem_pool_end_screen();
     }
 }
 
+// Boot diagnostics are built by the navigation that follows the logo (BootDiagPolicy).
 static bool isScreenEager(enum ScreensEnum screenId) {
     switch (screenId) {
         case SCREEN_ID_PAGE_BOOT_LOGO:
-        case SCREEN_ID_PAGE_BOOT_DIAG:
         case SCREEN_ID_PAGE_MAIN_PRO:
         case SCREEN_ID_PAGE_SETTINGS:
             return true;
@@ -187,6 +191,10 @@ static void ensureScreenCreated(enum ScreensEnum screenId) {
     }
 }
 
+void prepareScreen(enum ScreensEnum screenId) {
+    ensureScreenCreated(screenId);
+}
+
 void loadScreen(enum ScreensEnum screenId) {
     if (!isScreenIdValid(screenId)) {
         return;
@@ -227,6 +235,7 @@ void unloadScreen(enum ScreensEnum screenId) {
     clearObjectRefsForScreen(screen);
     createdScreens[screenId] = 0;
     lv_obj_del_async(screen);
+    lvgl_mem_pool_close_screen(screenId);
 }
 
 void ui_init() {
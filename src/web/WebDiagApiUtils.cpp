@@ -6,10 +6,28 @@
 
 #include "web/WebDiagApiUtils.h"
 
+#include <stdio.h>
+
+#include "web/WebApiUtils.h"
 #include "web/WebEventsUtils.h"
 #include "web/WebNetworkUtils.h"
 #include "web/WebStreamPolicy.h"
 
+namespace {
+
+// null for a core without a CPU figure yet.
+void add_core_busy(ArduinoJson::JsonArray out, const uint16_t (&permille)[TaskProfiler::kCores]) {
+    for (size_t c = 0; c < TaskProfiler::kCores; ++c) {
+        if (permille[c] == TaskProfiler::kNoCpu) {
+            out.add(nullptr);
+        } else {
+            out.add(permille[c] / 10.0f);
+        }
+    }
+}
+
+} // namespace
+
 namespace WebDiagApiUtils {
 
 bool accessAllowed(bool ap_mode, bool sta_connected) {
@@ -58,6 +76,372 @@ void fillJson(ArduinoJson::JsonObject root,
     }
     web_stream["last_max_write_ms"] = web_stream_snapshot.stats.last_max_write_ms;
     web_stream["last_uri"] = web_stream_snapshot.stats.last_uri;
+
+    if (payload.has_mqtt_publish) {
+        const MqttPublishStats &stats = payload.mqtt_publish;
+        ArduinoJson::JsonObject mqtt_publish = root["mqtt_publish"].to<ArduinoJson::JsonObject>();
+        mqtt_publish["tokens"] = stats.tokens;
+        mqtt_publish["bucket_capacity"] = stats.bucket_capacity;
+        mqtt_publish["throttled"] = stats.throttled;
+        for (size_t i = 0; i < kMqttPublishClassCount; ++i) {
+            const MqttPublishClassStats &entry = stats.classes[i];
+            ArduinoJson::JsonObject cls = mqtt_publish[MqttPublishScheduler::className(
+                static_cast<MqttPublishClass>(i))].to<ArduinoJson::JsonObject>();
+            cls["depth"] = entry.depth;
+            cls["sent"] = entry.sent;
+            cls["coalesced"] = entry.coalesced;
+            cls["paused"] = entry.paused;
+            cls["last_latency_ms"] = entry.last_latency_ms;
+            cls["max_latency_ms"] = entry.max_latency_ms;
+        }
+    }
+
+    if (payload.has_i2c) {
+        const I2cTelemetrySnapshot &stats = payload.i2c;
+        ArduinoJson::JsonObject i2c = root["i2c"].to<ArduinoJson::JsonObject>();
+        i2c["busy_permille"] = stats.busy_permille;
+        i2c["busy_peak_permille"] = stats.busy_peak_permille;
+        i2c["busy_total_ms"] = stats.busy_total_ms;
+        i2c["untracked_transactions"] = stats.untracked_transactions;
+        ArduinoJson::JsonArray bounds = i2c["latency_bounds_us"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i + 1 < I2cDeviceStats::kLatencyBuckets; ++i) {
+            bounds.add(I2cTelemetry::latencyBucketLimitUs(i));
+        }
+        ArduinoJson::JsonArray devices = i2c["devices"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < stats.device_count; ++i) {
+            const I2cDeviceStats &entry = stats.devices[i];
+            ArduinoJson::JsonObject device = devices.add<ArduinoJson::JsonObject>();
+            char address[5];
+            snprintf(address, sizeof(address), "0x%02X", entry.address);
+            device["address"] = address;
+            device["transactions"] = entry.transactions;
+            device["bytes"] = entry.bytes;
+            device["nacks"] = entry.nacks;
+            device["timeouts"] = entry.timeouts;
+            device["errors"] = entry.errors;
+            device["crc_failures"] = entry.crc_failures;
+            device["max_latency_us"] = entry.max_latency_us;
+            ArduinoJson::JsonArray hist = device["latency_hist"].to<ArduinoJson::JsonArray>();
+            for (size_t b = 0; b < I2cDeviceStats::kLatencyBuckets; ++b) {
+                hist.add(entry.latency_hist[b]);
+            }
+        }
+    }
+
+    if (payload.has_sensor_poll) {
+        const SensorPollRates::Snapshot &rates = payload.sensor_poll;
+        ArduinoJson::JsonObject poll = root["sensor_poll"].to<ArduinoJson::JsonObject>();
+        poll["high_rate"] = rates.demand != 0;
+        ArduinoJson::JsonArray demand = poll["demand"].to<ArduinoJson::JsonArray>();
+        for (uint8_t bit = 1; bit != 0 && bit <= SensorPollRates::kDemandAll; bit <<= 1) {
+            if ((rates.demand & bit) != 0) {
+                demand.add(SensorPollRates::demandName(static_cast<SensorPollRates::Demand>(bit)));
+            }
+        }
+        ArduinoJson::JsonArray sensors = poll["sensors"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < SensorPollRates::SENSOR_COUNT; ++i) {
+            const SensorPollRates::Entry &entry = rates.sensors[i];
+            if (!entry.active) {
+                continue;
+            }
+            ArduinoJson::JsonObject sensor = sensors.add<ArduinoJson::JsonObject>();
+            sensor["name"] = SensorPollRates::sensorName(static_cast<SensorPollRates::Sensor>(i));
+            sensor["interval_ms"] = entry.interval_ms;
+            sensor["fast_ms"] = entry.fast_ms;
+            sensor["slow_ms"] = entry.slow_ms;
+        }
+    }
+
+    if (payload.has_sensor_filter) {
+        ArduinoJson::JsonObject filter = root["sensor_filter"].to<ArduinoJson::JsonObject>();
+        ArduinoJson::JsonArray metrics = filter["metrics"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < SensorFilters::METRIC_COUNT; ++i) {
+            const SensorFilters::Entry &entry = payload.sensor_filter.metrics[i];
+            if (!entry.valid) {
+                continue;
+            }
+            ArduinoJson::JsonObject metric = metrics.add<ArduinoJson::JsonObject>();
+            metric["name"] = SensorFilters::metricName(static_cast<SensorFilters::Metric>(i));
+            metric["raw"] = entry.raw;
+            metric["value"] = entry.value;
+        }
+    }
+
+    if (payload.has_sensor_fusion) {
+        ArduinoJson::JsonObject fusion = root["sensor_fusion"].to<ArduinoJson::JsonObject>();
+        ArduinoJson::JsonArray quantities = fusion["quantities"].to<ArduinoJson::JsonArray>();
+        for (size_t q = 0; q < SensorFusion::QUANTITY_COUNT; ++q) {
+            const SensorFusion::Snapshot::Entry &entry = payload.sensor_fusion.quantities[q];
+            if (entry.source_count == 0) {
+                continue;
+            }
+            ArduinoJson::JsonObject quantity = quantities.add<ArduinoJson::JsonObject>();
+            quantity["name"] = SensorFusion::quantityName(static_cast<SensorFusion::Quantity>(q));
+            quantity["valid"] = entry.valid;
+            quantity["value"] = entry.value;
+            ArduinoJson::JsonArray sources = quantity["sources"].to<ArduinoJson::JsonArray>();
+            for (size_t i = 0; i < entry.source_count && i < FusedQuantity::kMaxSources; ++i) {
+                const FusedQuantity::SourceState &state = entry.sources[i];
+                ArduinoJson::JsonObject source = sources.add<ArduinoJson::JsonObject>();
+                source["name"] = state.name ? state.name : "";
+                source["fresh"] = state.fresh;
+                source["weight"] = state.weight;
+                source["bias"] = state.bias;
+                source["sigma"] = state.sigma;
+                source["faults"] = state.faults;
+            }
+        }
+    }
+
+    if (payload.has_sensor_timing) {
+        ArduinoJson::JsonObject timing = root["sensor_timing"].to<ArduinoJson::JsonObject>();
+        ArduinoJson::JsonArray sources = timing["sources"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < SENSOR_SOURCE_COUNT; ++i) {
+            const SensorTiming::IntervalStats &entry = payload.sensor_timing.intervals[i];
+            if (entry.count == 0) {
+                continue;
+            }
+            ArduinoJson::JsonObject source = sources.add<ArduinoJson::JsonObject>();
+            source["name"] = SensorTiming::sourceName(static_cast<SensorSource>(i));
+            source["samples"] = entry.count;
+            source["interval_us"] = entry.last_us;
+            source["min_us"] = entry.min_us;
+            source["max_us"] = entry.max_us;
+            source["avg_us"] = entry.avg_us;
+            source["jitter_us"] = entry.jitter_us;
+        }
+        ArduinoJson::JsonArray stages = timing["latency"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < SensorTiming::STAGE_COUNT; ++i) {
+            const SensorTiming::LatencyStats &entry = payload.sensor_timing.latency[i];
+            ArduinoJson::JsonObject stage = stages.add<ArduinoJson::JsonObject>();
+            stage["name"] = SensorTiming::stageName(static_cast<SensorTiming::Stage>(i));
+            stage["samples"] = entry.count;
+            stage["last_us"] = entry.last_us;
+            stage["max_us"] = entry.max_us;
+            stage["avg_us"] = entry.avg_us;
+        }
+    }
+
+    if (payload.has_storage_writer) {
+        ArduinoJson::JsonObject writer = root["storage_writer"].to<ArduinoJson::JsonObject>();
+        const StorageWriter::Stats &stats = payload.storage_writer;
+        writer["pending"] = stats.pending;
+        writer["submitted"] = stats.submitted;
+        writer["coalesced"] = stats.coalesced;
+        writer["rejected"] = stats.rejected;
+        writer["written"] = stats.written;
+        writer["failed"] = stats.failed;
+        writer["last_write_ms"] = stats.last_write_ms;
+        writer["max_write_ms"] = stats.max_write_ms;
+    }
+
+    if (payload.has_record_store) {
+        ArduinoJson::JsonObject records = root["record_store"].to<ArduinoJson::JsonObject>();
+        const RecordStore::Stats &stats = payload.record_store;
+        records["file_bytes"] = stats.file_bytes;
+        records["live_bytes"] = stats.live_bytes;
+        records["keys"] = stats.keys;
+        records["sequence"] = stats.sequence;
+        records["records_written"] = stats.records_written;
+        records["bytes_written"] = stats.bytes_written;
+        records["lifetime_bytes"] = stats.lifetime_bytes;
+        records["compactions"] = stats.compactions;
+        records["crc_errors"] = stats.crc_errors;
+        records["dropped_tail_bytes"] = stats.dropped_tail_bytes;
+    }
+
+    if (payload.boot_traces && payload.boot_trace_count > 0) {
+        ArduinoJson::JsonArray traces = root["boot_traces"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < payload.boot_trace_count; ++i) {
+            const BootProfiler::Trace &trace = payload.boot_traces[i];
+            ArduinoJson::JsonObject entry = traces.add<ArduinoJson::JsonObject>();
+            entry["boot_count"] = trace.boot_count;
+            entry["reset_reason"] = trace.reset_reason;
+            entry["complete"] = trace.complete;
+            entry["total_us"] = trace.total_us;
+            entry["dropped_stages"] = trace.dropped_stages;
+            entry["first_frame_us"] = trace.first_frame_us;
+            entry["first_reading_us"] = trace.first_reading_us;
+            ArduinoJson::JsonArray stages = entry["stages"].to<ArduinoJson::JsonArray>();
+            for (size_t s = 0; s < trace.stage_count && s < BootProfiler::kMaxStages; ++s) {
+                const BootProfiler::Stage &stage = trace.stages[s];
+                ArduinoJson::JsonObject item = stages.add<ArduinoJson::JsonObject>();
+                item["name"] = static_cast<const char *>(stage.name);
+                item["depth"] = stage.depth;
+                item["core"] = stage.core;
+                item["start_us"] = stage.start_us;
+                item["duration_us"] = stage.duration_us;
+            }
+        }
+    }
+
+    if (payload.previous_boot) {
+        const RetainedLog::Previous &prev = *payload.previous_boot;
+        ArduinoJson::JsonObject previous = root["previous_boot"].to<ArduinoJson::JsonObject>();
+        previous["reset_reason"] = static_cast<int>(prev.ended_by);
+        previous["crashed"] = prev.crashed;
+        ArduinoJson::JsonArray logs = previous["logs"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < prev.line_count && i < RetainedLog::kLineCapacity; ++i) {
+            const RetainedLog::Line &line = prev.lines[i];
+            ArduinoJson::JsonObject item = logs.add<ArduinoJson::JsonObject>();
+            item["ts_ms"] = line.ms;
+            item["level"] = WebApiUtils::eventLevelText(line.level);
+            item["tag"] = static_cast<const char *>(line.tag);
+            item["message"] = static_cast<const char *>(line.message);
+        }
+        ArduinoJson::JsonArray telemetry = previous["telemetry"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < prev.telemetry_count && i < RetainedLog::kTelemetryCapacity; ++i) {
+            const RetainedLog::Telemetry &sample = prev.telemetry[i];
+            ArduinoJson::JsonObject item = telemetry.add<ArduinoJson::JsonObject>();
+            item["uptime_ms"] = sample.uptime_ms;
+            item["heap_free"] = sample.heap_free;
+            item["heap_min_free"] = sample.heap_min_free;
+            item["loop_max_us"] = sample.loop_max_us;
+            item["sensor_age_ms"] = sample.sensor_age_ms;
+        }
+    }
+
+    if (payload.task_profile) {
+        const TaskProfiler::Snapshot &prof = *payload.task_profile;
+        ArduinoJson::JsonObject profile = root["task_profile"].to<ArduinoJson::JsonObject>();
+        profile["sample_ms"] = prof.ms;
+        profile["samples"] = prof.sample_count;
+        add_core_busy(profile["core_busy_pct"].to<ArduinoJson::JsonArray>(), prof.core_busy_permille);
+        ArduinoJson::JsonArray tasks = profile["tasks"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < prof.task_count && i < TaskProfiler::kMaxTasks; ++i) {
+            const TaskProfiler::Task &task = prof.tasks[i];
+            ArduinoJson::JsonObject item = tasks.add<ArduinoJson::JsonObject>();
+            item["name"] = static_cast<const char *>(task.name);
+            item["core"] = task.core;
+            if (task.cpu_permille != TaskProfiler::kNoCpu) {
+                item["cpu_pct"] = task.cpu_permille / 10.0f;
+            }
+            item["stack_free"] = task.stack_free;
+        }
+        ArduinoJson::JsonObject stacks = profile["stacks"].to<ArduinoJson::JsonObject>();
+        for (size_t w = 0; w < TaskProfiler::kWatchedCount; ++w) {
+            if (prof.watched_stack_free[w] != TaskProfiler::kNoStack) {
+                stacks[TaskProfiler::watchedName(w)] = prof.watched_stack_free[w];
+            }
+        }
+        ArduinoJson::JsonObject heap_profile = profile["heap"].to<ArduinoJson::JsonObject>();
+        heap_profile["internal_free"] = prof.heap.internal_free;
+        heap_profile["internal_min_free"] = prof.heap.internal_min_free;
+        heap_profile["internal_largest"] = prof.heap.internal_largest;
+        heap_profile["internal_frag_pct"] = prof.internal_frag_pct;
+        heap_profile["psram_free"] = prof.heap.psram_free;
+        heap_profile["psram_largest"] = prof.heap.psram_largest;
+        heap_profile["psram_frag_pct"] = prof.psram_frag_pct;
+        ArduinoJson::JsonArray alerts = profile["alerts"].to<ArduinoJson::JsonArray>();
+        for (size_t w = 0; w < TaskProfiler::kWatchedCount; ++w) {
+            if (prof.alerts & (1u << w)) {
+                char alert[32];
+                snprintf(alert, sizeof(alert), "stack:%s", TaskProfiler::watchedName(w));
+                alerts.add(alert);
+            }
+        }
+        if (prof.alerts & TaskProfiler::AlertInternalHeap) {
+            alerts.add("internal_heap");
+        }
+        if (prof.alerts & TaskProfiler::AlertInternalBlock) {
+            alerts.add("internal_block");
+        }
+        ArduinoJson::JsonArray window = profile["window"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < prof.window_count && i < TaskProfiler::kWindowDepth; ++i) {
+            const TaskProfiler::Point &point = prof.window[i];
+            ArduinoJson::JsonObject item = window.add<ArduinoJson::JsonObject>();
+            item["ms"] = point.ms;
+            add_core_busy(item["core_busy_pct"].to<ArduinoJson::JsonArray>(), point.core_busy_permille);
+            item["internal_free"] = point.internal_free;
+            item["internal_largest"] = point.internal_largest;
+            item["psram_free"] = point.psram_free;
+            if (point.stack_min != TaskProfiler::kNoStack) {
+                item["stack_min"] = point.stack_min;
+            }
+        }
+    }
+
+    if (payload.has_ui_updates) {
+        ArduinoJson::JsonObject ui_updates = root["ui_updates"].to<ArduinoJson::JsonObject>();
+        ui_updates["applied"] = payload.ui_updates_applied;
+        ui_updates["skipped"] = payload.ui_updates_skipped;
+    }
+
+    if (payload.has_lvgl_pool) {
+        const LvglMemPool::Stats &pool = payload.lvgl_pool;
+        ArduinoJson::JsonObject lvgl = root["lvgl_pool"].to<ArduinoJson::JsonObject>();
+        lvgl["slab_bytes_internal"] = pool.slab_bytes_internal;
+        lvgl["slab_bytes_psram"] = pool.slab_bytes_psram;
+        lvgl["slab_free_pct"] = pool.frag_pct;
+        lvgl["allocs"] = pool.allocs;
+        lvgl["heap_live"] = pool.heap_live;
+        lvgl["slab_misses"] = pool.slab_misses;
+        lvgl["slabs_released"] = pool.slabs_released;
+        ArduinoJson::JsonArray classes = lvgl["classes"].to<ArduinoJson::JsonArray>();
+        for (size_t i = 0; i < LvglMemPool::kClassCount; ++i) {
+            const LvglMemPool::ClassStats &cls = pool.classes[i];
+            ArduinoJson::JsonObject item = classes.add<ArduinoJson::JsonObject>();
+            item["size"] = cls.block_size;
+            item["slabs"] = cls.slabs;
+            item["internal_slabs"] = cls.internal_slabs;
+            item["used"] = cls.used;
+            item["free"] = cls.free;
+            item["peak"] = cls.peak_used;
+        }
+    }
+
+    if (payload.has_ui_screens) {
+        const UiScreenCache::Stats &cache = payload.ui_screens;
+        ArduinoJson::JsonObject screens = root["ui_screens"].to<ArduinoJson::JsonObject>();
+        screens["resident"] = cache.resident;
+        screens["resident_bytes"] = cache.resident_bytes;
+        screens["budget_bytes"] = cache.budget_bytes;
+        screens["hits"] = cache.hits;
+        screens["misses"] = cache.misses;
+        screens["prewarms"] = cache.prewarms;
+        screens["releases"] = cache.releases;
+        screens["build_us_last"] = cache.build_us_last;
+        screens["build_us_avg"] = cache.build_us_avg;
+        screens["build_us_max"] = cache.build_us_max;
+        screens["slowest_screen"] = cache.slowest_screen;
+    }
+
+    if (payload.has_card_cache) {
+        const UiCardCache::Stats &cache = payload.card_cache;
+        ArduinoJson::JsonObject cards = root["card_cache"].to<ArduinoJson::JsonObject>();
+        cards["enabled"] = cache.enabled;
+        cards["entries"] = cache.entries;
+        cards["bytes"] = cache.bytes;
+        cards["budget_bytes"] = cache.budget_bytes;
+        cards["hits"] = cache.hits;
+        cards["builds"] = cache.builds;
+        cards["evictions"] = cache.evictions;
+        cards["invalidations"] = cache.invalidations;
+        cards["build_us_max"] = cache.build_us_max;
+        cards["frames_cached"] = cache.frames_cached;
+        cards["frames_direct"] = cache.frames_direct;
+        cards["frame_us_cached"] = cache.frame_us_cached;
+        cards["frame_us_direct"] = cache.frame_us_direct;
+    }
+
+    if (payload.has_font_packs) {
+        ArduinoJson::JsonArray packs = root["font_packs"].to<ArduinoJson::JsonArray>();
+        for (const UiPackedFonts::PackStatus &status : payload.font_packs) {
+            if (!status.path) {
+                continue;
+            }
+            ArduinoJson::JsonObject pack = packs.add<ArduinoJson::JsonObject>();
+            pack["path"] = status.path;
+            pack["loaded"] = status.loaded;
+            pack["missing"] = status.missing;
+            pack["invalid"] = status.invalid;
+            pack["stale"] = status.stale;
+            pack["glyph_hash"] = status.glyph_hash;
+            pack["expected_hash"] = status.expected_hash;
+            pack["glyphs"] = status.glyphs;
+            pack["cache_bytes"] = status.cache_bytes;
+        }
+    }
 }
 
 } // namespace WebDiagApiUtils
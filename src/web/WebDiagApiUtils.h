@@ -10,7 +10,22 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "core/BootProfiler.h"
+#include "core/I2cTelemetry.h"
 #include "core/Logger.h"
+#include "core/MqttPublishScheduler.h"
+#include "core/RecordStore.h"
+#include "core/RetainedLog.h"
+#include "core/SensorFilter.h"
+#include "core/SensorFusion.h"
+#include "core/SensorPollRate.h"
+#include "core/SensorTiming.h"
+#include "core/StorageWriter.h"
+#include "core/TaskProfiler.h"
+#include "ui/LvglMemPool.h"
+#include "ui/UiCardCache.h"
+#include "ui/UiPackedFonts.h"
+#include "ui/UiScreenCache.h"
 #include "web/WebNetworkUtils.h"
 #include "web/WebStreamState.h"
 
@@ -23,6 +38,41 @@ struct Payload {
     uint32_t heap_min_free = 0;
     WebNetworkUtils::Snapshot network{};
     WebTransferSnapshot web_stream{};
+    bool has_mqtt_publish = false;
+    MqttPublishStats mqtt_publish{};
+    bool has_i2c = false;
+    I2cTelemetrySnapshot i2c{};
+    bool has_sensor_poll = false;
+    SensorPollRates::Snapshot sensor_poll{};
+    bool has_sensor_filter = false;
+    SensorFilters::Snapshot sensor_filter{};
+    bool has_sensor_fusion = false;
+    SensorFusion::Snapshot sensor_fusion{};
+    bool has_sensor_timing = false;
+    SensorTiming::Snapshot sensor_timing{};
+    bool has_storage_writer = false;
+    StorageWriter::Stats storage_writer{};
+    bool has_record_store = false;
+    RecordStore::Stats record_store{};
+    // This boot first, then earlier ones; not owned.
+    const BootProfiler::Trace *boot_traces = nullptr;
+    size_t boot_trace_count = 0;
+    // What the previous boot left in retained memory, if anything; not owned.
+    const RetainedLog::Previous *previous_boot = nullptr;
+    // Latest task and heap profile with its window, once sampled; not owned.
+    const TaskProfiler::Snapshot *task_profile = nullptr;
+    // Widget property writes made and skipped as unchanged since boot (UiWidgetBinding).
+    bool has_ui_updates = false;
+    uint32_t ui_updates_applied = 0;
+    uint32_t ui_updates_skipped = 0;
+    bool has_lvgl_pool = false;
+    LvglMemPool::Stats lvgl_pool{};
+    bool has_ui_screens = false;
+    UiScreenCache::Stats ui_screens{};
+    bool has_card_cache = false;
+    UiCardCache::Stats card_cache{};
+    bool has_font_packs = false;
+    UiPackedFonts::PackStatus font_packs[UiPackedFonts::kPackCount]{};
 };
 
 bool accessAllowed(bool ap_mode, bool sta_connected);
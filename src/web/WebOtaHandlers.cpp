@@ -8,10 +8,12 @@
 
 #include <Update.h>
 #include <WiFi.h>
+#include <LittleFS.h>
 #include <ArduinoJson.h>
 #include <esp_ota_ops.h>
 
 #include "core/Logger.h"
+#include "ui/UiPackedFonts.h"
 #include "web/WebOtaApiUtils.h"
 #include "web/WebResponseUtils.h"
 #include "web/WebTextUtils.h"
@@ -23,6 +25,18 @@ constexpr const char kApiErrorOtaBusyJson[] =
     "\"error_code\":\"OTA_BUSY\",\"ota_busy\":true}";
 constexpr size_t kOtaAbortDrainMaxBytes = 32UL * 1024UL;
 constexpr uint32_t kOtaAbortDrainTimeoutMs = 1500;
+constexpr size_t kFontPackMaxBytes = 512UL * 1024UL;
+constexpr char kFontPackTempPath[] = "/fonts/upload.part";
+
+// A CJK font pack sent through the firmware upload (recognised by its file name) is written to
+// LittleFS instead of the OTA slot, so a device updated over the web can get the packs without
+// `uploadfs`, which would also wipe the record log. The restart that follows opens it.
+struct FontPackUpload {
+    const char *path = nullptr;
+    File file;
+};
+
+FontPackUpload font_pack_upload;
 
 void send_ota_busy_json(WebRequest &server) {
     WebResponseUtils::sendNoStoreHeaders(server);
@@ -115,6 +129,11 @@ void abort_update_if_running() {
     if (Update.isRunning()) {
         Update.abort();
     }
+    if (font_pack_upload.path) {
+        font_pack_upload.file.close();
+        LittleFS.remove(kFontPackTempPath);
+        font_pack_upload.path = nullptr;
+    }
 }
 
 void fail_upload(WebOtaHandlers::Runtime &runtime, const String &error) {
@@ -124,6 +143,33 @@ void fail_upload(WebOtaHandlers::Runtime &runtime, const String &error) {
     }
 }
 
+void begin_font_pack_upload(WebOtaHandlers::Runtime &runtime, const char *path) {
+    runtime.ota_state.setSlotSize(kFontPackMaxBytes);
+    const WebOtaSnapshot ota = runtime.ota_state.snapshot();
+    if (ota.size_known && ota.expected_size > kFontPackMaxBytes) {
+        fail_upload(runtime,
+                    String("Font pack too large: ") + String(ota.expected_size) + " > " +
+                        String(kFontPackMaxBytes));
+        LOGW("OTA", "reject oversized font pack: %u", static_cast<unsigned>(ota.expected_size));
+        return;
+    }
+    if (!LittleFS.exists("/fonts")) {
+        LittleFS.mkdir("/fonts");
+    }
+    font_pack_upload.file = LittleFS.open(kFontPackTempPath, FILE_WRITE);
+    if (!font_pack_upload.file) {
+        fail_upload(runtime, "Font pack could not be written to LittleFS");
+        LOGE("OTA", "cannot open %s", kFontPackTempPath);
+        return;
+    }
+    font_pack_upload.path = path;
+    LOGI("OTA", "font pack upload started (session=%u, target=%s, expected=%u, known=%s)",
+         static_cast<unsigned>(ota.session_id),
+         path,
+         static_cast<unsigned>(ota.expected_size),
+         ota.size_known ? "YES" : "NO");
+}
+
 void cleanup_after_update_response(WebOtaHandlers::Runtime &runtime, bool success) {
     if (!success && runtime.set_ui_screen) {
         runtime.set_ui_screen(false);
@@ -255,6 +301,13 @@ void handleUpload(Runtime &runtime, bool ota_busy) {
             runtime.set_ui_screen(true);
         }
 
+        const char *font_pack_path = UiPackedFonts::packPath(upload.filename.c_str());
+        if (font_pack_path) {
+            runtime.ota_state.setExpectedSize(size_known, expected_size);
+            begin_font_pack_upload(runtime, font_pack_path);
+            return;
+        }
+
         const esp_partition_t *target_partition = esp_ota_get_next_update_partition(nullptr);
         if (!target_partition) {
             fail_upload(runtime, "OTA partition unavailable");
@@ -340,7 +393,13 @@ void handleUpload(Runtime &runtime, bool ota_busy) {
             LOGW("OTA", "upload exceeded slot size");
             return;
         }
-        if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) {
+        if (font_pack_upload.path) {
+            if (font_pack_upload.file.write(upload.buf, upload.currentSize) != upload.currentSize) {
+                fail_upload(runtime, "Font pack write failed: LittleFS full?");
+                LOGE("OTA", "%s", runtime.ota_state.snapshot().error.c_str());
+                return;
+            }
+        } else if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) {
             fail_upload(runtime, ota_error_prefixed("Update write failed"));
             LOGE("OTA", "%s", runtime.ota_state.snapshot().error.c_str());
             return;
@@ -373,6 +432,32 @@ void handleUpload(Runtime &runtime, bool ota_busy) {
             return;
         }
         const uint32_t finalize_start_ms = millis();
+        if (font_pack_upload.path) {
+            const char *path = font_pack_upload.path;
+            font_pack_upload.file.close();
+            font_pack_upload.path = nullptr;
+            const UiPackedFonts::InstallResult installed =
+                UiPackedFonts::installPack(kFontPackTempPath, path);
+            runtime.ota_state.markFinalizeDuration(millis() - finalize_start_ms);
+            if (installed == UiPackedFonts::InstallResult::Stale) {
+                fail_upload(runtime,
+                            String("Font pack is from another firmware build, use the one built with this firmware: ") +
+                                path);
+                return;
+            }
+            if (installed == UiPackedFonts::InstallResult::WriteFailed) {
+                fail_upload(runtime, String("Font pack could not be moved into place: ") + path);
+                return;
+            }
+            if (installed != UiPackedFonts::InstallResult::Installed) {
+                fail_upload(runtime, String("Not a font pack for this firmware: ") + path);
+                return;
+            }
+            runtime.ota_state.markSuccess(millis());
+            LOGI("OTA", "font pack %s installed (%u bytes)", path,
+                 static_cast<unsigned>(runtime.ota_state.snapshot().written_size));
+            return;
+        }
         if (!Update.end(true)) {
             runtime.ota_state.markFinalizeDuration(millis() - finalize_start_ms);
             fail_upload(runtime, ota_error_prefixed("Update finalize failed"));
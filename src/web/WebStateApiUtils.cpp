@@ -9,6 +9,7 @@
 #include <math.h>
 
 #include "core/MathUtils.h"
+#include "core/SensorTiming.h"
 #include "web/WebApiUtils.h"
 #include "web/WebOtaApiUtils.h"
 #include "web/WebJsonUtils.h"
@@ -80,6 +81,25 @@ void fill_ota_json(ArduinoJson::JsonObject root, const Payload &payload) {
     root["error_code"] = result.error_code;
 }
 
+void fill_samples_json(ArduinoJson::JsonObject root, const Payload &payload) {
+    for (size_t i = 0; i < SENSOR_SOURCE_COUNT; ++i) {
+        const SensorSource source = static_cast<SensorSource>(i);
+        const SampleStamp &stamp = payload.data.stamps[i];
+        const char *name = SensorTiming::sourceName(source);
+        if (stamp.ready_us == 0 || payload.now_us < stamp.ready_us) {
+            root[name] = nullptr;
+            continue;
+        }
+        ArduinoJson::JsonObject sample = root[name].to<ArduinoJson::JsonObject>();
+        sample["age_ms"] = static_cast<uint32_t>((payload.now_us - stamp.ready_us) / 1000ULL);
+        if (stamp.epoch != 0) {
+            sample["ts"] = stamp.epoch;
+        } else {
+            sample["ts"] = nullptr;
+        }
+    }
+}
+
 }  // namespace
 
 void fillJson(ArduinoJson::JsonObject root, const Payload &payload) {
@@ -120,6 +140,9 @@ void fillJson(ArduinoJson::JsonObject root, const Payload &payload) {
     sensors["nh3_warmup"] = data.nh3_warmup;
     sensors["gas_warmup"] = payload.gas_warmup;
 
+    ArduinoJson::JsonObject samples = root["samples"].to<ArduinoJson::JsonObject>();
+    fill_samples_json(samples, payload);
+
     ArduinoJson::JsonObject derived = root["derived"].to<ArduinoJson::JsonObject>();
     const bool climate_valid = data.temp_valid && data.hum_valid;
     const float dew_point =
@@ -22,6 +22,7 @@ struct Payload {
     bool gas_warmup = false;
     uint32_t uptime_s = 0;
     uint32_t timestamp_ms = 0;
+    uint64_t now_us = 0; // SensorTiming::nowUs() when the response was built; ages the stamps
     bool has_time_epoch = false;
     int64_t time_epoch_s = 0;
     WebNetworkUtils::Snapshot network{};
@@ -11,9 +11,25 @@
 #include <ArduinoJson.h>
 
 #include "core/AppVersion.h"
+#include "core/BootProfiler.h"
 #include "core/ConnectivityRuntime.h"
+#include "core/I2cTelemetry.h"
 #include "core/Logger.h"
+#include "core/RetainedLog.h"
+#include "core/SensorFilter.h"
+#include "core/SensorFusion.h"
+#include "core/SensorPollRate.h"
+#include "core/SensorTiming.h"
+#include "core/StorageWriter.h"
+#include "core/TaskProfiler.h"
 #include "core/WebRuntimeState.h"
+#include "modules/MqttRuntime.h"
+#include "modules/StorageManager.h"
+#include "ui/LvglMemPool.h"
+#include "ui/UiCardCache.h"
+#include "ui/UiPackedFonts.h"
+#include "ui/UiScreenCache.h"
+#include "ui/UiWidgetBinding.h"
 #include "web/WebDiagApiUtils.h"
 #include "web/WebEventsApiUtils.h"
 #include "web/WebResponseUtils.h"
@@ -31,6 +47,8 @@ constexpr const char kApiErrorOtaBusyJson[] =
     "{\"success\":false,\"error\":\"OTA upload in progress\","
     "\"error_code\":\"OTA_BUSY\",\"ota_busy\":true}";
 Logger::RecentEntry g_events_snapshot[kEventsApiMaxEntries];
+BootProfiler::Trace g_boot_traces[BootProfiler::kHistoryDepth];
+TaskProfiler::Snapshot g_task_profile;
 
 void send_ota_busy_json(WebRequest &server) {
     WebResponseUtils::sendNoStoreHeaders(server);
@@ -84,6 +102,52 @@ void handleDiagData(WebHandlerContext &context,
     payload.heap_min_free = ESP.getMinFreeHeap();
     payload.network = WebRuntimeCapture::captureNetworkSnapshot(context);
     payload.web_stream = web_stream_snapshot;
+    if (context.mqtt_runtime) {
+        payload.has_mqtt_publish = true;
+        payload.mqtt_publish = context.mqtt_runtime->publishStats();
+    }
+    payload.has_i2c = true;
+    I2cTelemetry::instance().snapshot(payload.i2c);
+    payload.has_sensor_poll = true;
+    SensorPollRates::instance().snapshot(payload.sensor_poll, millis());
+    payload.has_sensor_filter = true;
+    SensorFilters::instance().snapshot(payload.sensor_filter);
+    payload.has_sensor_fusion = true;
+    SensorFusion::instance().snapshot(payload.sensor_fusion);
+    payload.has_sensor_timing = true;
+    SensorTiming::instance().snapshot(payload.sensor_timing);
+    payload.has_storage_writer = StorageWriter::instance().isRunning();
+    StorageWriter::instance().stats(payload.storage_writer);
+    if (context.storage && context.storage->isMounted()) {
+        payload.has_record_store = true;
+        context.storage->recordStats(payload.record_store);
+    }
+    BootProfiler &profiler = BootProfiler::instance();
+    profiler.current(g_boot_traces[0]);
+    size_t boot_trace_count = 1;
+    while (boot_trace_count < BootProfiler::kHistoryDepth &&
+           profiler.previous(boot_trace_count - 1, g_boot_traces[boot_trace_count])) {
+        boot_trace_count++;
+    }
+    payload.boot_traces = g_boot_traces;
+    payload.boot_trace_count = boot_trace_count;
+    payload.previous_boot = RetainedLog::instance().previous();
+    if (TaskProfiler::instance().snapshot(g_task_profile)) {
+        payload.task_profile = &g_task_profile;
+    }
+    UiWidgetBinding::Stats ui_updates;
+    UiWidgetBinding::stats(ui_updates);
+    payload.has_ui_updates = true;
+    payload.ui_updates_applied = ui_updates.applied;
+    payload.ui_updates_skipped = ui_updates.skipped;
+    payload.has_lvgl_pool = true;
+    LvglMemPool::instance().stats(payload.lvgl_pool);
+    payload.has_ui_screens = true;
+    UiScreenCache::instance().stats(payload.ui_screens);
+    payload.has_card_cache = true;
+    UiCardCache::instance().stats(payload.card_cache);
+    payload.has_font_packs = true;
+    UiPackedFonts::status(payload.font_packs);
     WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(),
                               payload,
                               g_events_snapshot,
@@ -101,6 +165,8 @@ void handleStateData(WebHandlerContext &context, bool ota_busy, const WebOtaSnap
         return;
     }
 
+    // The dashboard polls this endpoint; while it does, keep the sensors at full rate.
+    SensorPollRates::instance().noteWebLive(millis());
     const WebRuntimeSnapshot runtime = context.web_runtime->snapshot();
     const uint32_t uptime_s = millis() / 1000UL;
     const time_t now_epoch = time(nullptr);
@@ -111,6 +177,7 @@ void handleStateData(WebHandlerContext &context, bool ota_busy, const WebOtaSnap
     payload.gas_warmup = runtime.gas_warmup;
     payload.uptime_s = uptime_s;
     payload.timestamp_ms = millis();
+    payload.now_us = SensorTiming::nowUs();
     payload.has_time_epoch = now_epoch > 0;
     payload.time_epoch_s = static_cast<int64_t>(now_epoch);
     payload.network = WebRuntimeCapture::captureNetworkSnapshot(context);
@@ -128,6 +195,8 @@ void handleStateData(WebHandlerContext &context, bool ota_busy, const WebOtaSnap
     payload.build_date = __DATE__;
     payload.build_time = __TIME__;
     WebStateApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload);
+    SensorTiming::instance().noteDelivered(SensorTiming::STAGE_WEB, payload.data,
+                                           payload.now_us);
 
     String json;
     serializeJson(doc, json);
@@ -681,6 +681,67 @@ static const char kDiagPageTemplate[] PROGMEM = R"HTML(
                 <h3>Web Stream</h3>
                 <div id="webRows" class="rows"></div>
             </section>
+            <section class="card">
+                <h3>I2C Bus</h3>
+                <div id="i2cRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Sensor Polling</h3>
+                <div id="pollRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Sensor Filters</h3>
+                <div id="filterRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Sensor Fusion</h3>
+                <div id="fusionRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Sample Timing</h3>
+                <div id="timingRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Storage Writer</h3>
+                <div id="storageRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Record Log</h3>
+                <div id="recordRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Tasks &amp; Heap</h3>
+                <div id="profileRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Display Updates</h3>
+                <div id="uiUpdateRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>LVGL Memory</h3>
+                <div id="lvglPoolRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Screens</h3>
+                <div id="uiScreenRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Card Backgrounds</h3>
+                <div id="cardCacheRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Font Packs</h3>
+                <div id="fontPackRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Boot Timing</h3>
+                <div id="bootRows" class="rows"></div>
+            </section>
+            <section class="card">
+                <h3>Previous Boot</h3>
+                <div id="previousBootRows" class="rows"></div>
+                <pre id="previousBootLog" class="mono">Nothing retained.</pre>
+            </section>
             <section class="card">
                 <h3>Last Errors</h3>
                 <pre id="errors" class="mono">No warnings or errors yet.</pre>
@@ -722,6 +783,289 @@ static const char kDiagPageTemplate[] PROGMEM = R"HTML(
             if (el) el.innerHTML = html;
         }
 
+        function permilleText(value) {
+            return (typeof value === 'number') ? (value / 10).toFixed(1) + '%' : '--';
+        }
+
+        function i2cRows(i2c) {
+            var html = row('Busy (last second)', permilleText(i2c.busy_permille)) +
+                row('Busy peak', permilleText(i2c.busy_peak_permille)) +
+                row('Busy total', (typeof i2c.busy_total_ms === 'number' ? i2c.busy_total_ms : 0) + ' ms');
+            var devices = Array.isArray(i2c.devices) ? i2c.devices : [];
+            devices.forEach(function(dev) {
+                var faults = (dev.nacks || 0) + (dev.timeouts || 0) + (dev.errors || 0) + (dev.crc_failures || 0);
+                var text = (dev.transactions || 0) + ' tx, ' +
+                    'nack ' + (dev.nacks || 0) + ', timeout ' + (dev.timeouts || 0) +
+                    ', crc ' + (dev.crc_failures || 0) + ', max ' +
+                    ((dev.max_latency_us || 0) / 1000).toFixed(1) + ' ms';
+                html += row(dev.address || '--', faults > 0 ? badge(text, 'warn') : esc(text));
+            });
+            return html;
+        }
+
+        function pollRows(poll) {
+            var demand = Array.isArray(poll.demand) ? poll.demand : [];
+            var html = row('Rate', poll.high_rate ? badge('Fast: ' + demand.join(', '), 'ok') : esc('Adaptive'));
+            var sensors = Array.isArray(poll.sensors) ? poll.sensors : [];
+            sensors.forEach(function(s) {
+                var interval = s.interval_ms || 0;
+                var text = (interval / 1000).toFixed(1) + ' s (' +
+                    ((s.fast_ms || 0) / 1000).toFixed(1) + '-' + ((s.slow_ms || 0) / 1000).toFixed(1) + ' s)';
+                html += row(s.name || '--', interval > (s.fast_ms || 0) ? badge(text, 'ok') : esc(text));
+            });
+            return html;
+        }
+
+        function filterRows(filter) {
+            var metrics = Array.isArray(filter.metrics) ? filter.metrics : [];
+            if (!metrics.length) {
+                return row('Status', esc('No data'));
+            }
+            var html = '';
+            metrics.forEach(function(m) {
+                var value = Number(m.value || 0);
+                var raw = Number(m.raw || 0);
+                html += row(m.name || '--', esc(value.toFixed(2) + ' (raw ' + raw.toFixed(2) + ')'));
+            });
+            return html;
+        }
+
+        function fusionRows(fusion) {
+            var quantities = Array.isArray(fusion.quantities) ? fusion.quantities : [];
+            if (!quantities.length) {
+                return row('Status', esc('No data'));
+            }
+            var html = '';
+            quantities.forEach(function(q) {
+                var value = q.valid ? Number(q.value || 0).toFixed(2) : 'invalid';
+                html += row(q.name || '--', q.valid ? esc(value) : badge(value, 'err'));
+                var sources = Array.isArray(q.sources) ? q.sources : [];
+                sources.forEach(function(s) {
+                    var text = Math.round(Number(s.weight || 0) * 100) + '%' +
+                        ' bias ' + Number(s.bias || 0).toFixed(2) +
+                        (s.faults ? ' faults ' + s.faults : '');
+                    html += row((q.name || '--') + ' / ' + (s.name || '--'),
+                        s.fresh ? esc(text) : badge('stale', 'warn'));
+                });
+            });
+            return html;
+        }
+
+        function msText(us) {
+            return (Number(us || 0) / 1000).toFixed(1) + ' ms';
+        }
+
+        function timingRows(timing) {
+            var sources = Array.isArray(timing.sources) ? timing.sources : [];
+            var stages = Array.isArray(timing.latency) ? timing.latency : [];
+            var html = '';
+            sources.forEach(function(s) {
+                html += row((s.name || '--') + ' interval',
+                    esc(msText(s.avg_us) + ' avg, jitter ' + msText(s.jitter_us) +
+                        ' (' + msText(s.min_us) + '-' + msText(s.max_us) + ')'));
+            });
+            stages.forEach(function(st) {
+                html += row('ready to ' + (st.name || '--'),
+                    st.samples ? esc(msText(st.avg_us) + ' avg, max ' + msText(st.max_us)) : esc('--'));
+            });
+            return html || row('Status', esc('No data'));
+        }
+
+        function storageRows(writer) {
+            if (typeof writer.written !== 'number') {
+                return row('Status', esc('Synchronous'));
+            }
+            return row('Pending', String(writer.pending || 0)) +
+                row('Written', String(writer.written) + (writer.failed ? ' (' + writer.failed + ' failed)' : '')) +
+                row('Coalesced', String(writer.coalesced || 0)) +
+                row('Queue full', String(writer.rejected || 0)) +
+                row('Write time', esc((writer.last_write_ms || 0) + ' ms, max ' + (writer.max_write_ms || 0) + ' ms'));
+        }
+
+        function kbText(bytes) {
+            return (Math.round((bytes || 0) / 102.4) / 10) + ' KB';
+        }
+
+        function recordRows(log) {
+            if (typeof log.file_bytes !== 'number') {
+                return row('Status', esc('Not mounted'));
+            }
+            return row('Size', esc(kbText(log.file_bytes) + ' (' + kbText(log.live_bytes) + ' live)')) +
+                row('Keys', String(log.keys || 0)) +
+                row('Written since boot', esc((log.records_written || 0) + ' records, ' + kbText(log.bytes_written))) +
+                row('Lifetime writes', esc(kbText(log.lifetime_bytes))) +
+                row('Compactions', String(log.compactions || 0)) +
+                row('CRC errors', log.crc_errors ? badge(String(log.crc_errors), 'warn') : '0') +
+                row('Dropped at mount', esc((log.dropped_tail_bytes || 0) + ' B'));
+        }
+
+        function pctText(value) {
+            return typeof value === 'number' ? value.toFixed(1) + ' %' : '--';
+        }
+
+        function profileRows(profile) {
+            if (!profile || typeof profile !== 'object') {
+                return row('Status', esc('Not sampled yet'));
+            }
+            var alerts = Array.isArray(profile.alerts) ? profile.alerts : [];
+            var html = row('Alerts', alerts.length ? badge(alerts.join(', '), 'warn') : badge('none', 'ok'));
+            var cores = Array.isArray(profile.core_busy_pct) ? profile.core_busy_pct : [];
+            html += row('CPU busy', esc(cores.map(function(v, i) { return 'core ' + i + ' ' + pctText(v); }).join(', ')));
+            var heap = profile.heap || {};
+            html += row('Internal heap', esc(kbText(heap.internal_free) + ' (min ' + kbText(heap.internal_min_free) +
+                ', largest ' + kbText(heap.internal_largest) + ', ' + (heap.internal_frag_pct || 0) + ' % fragmented)'));
+            if (heap.psram_free) {
+                html += row('PSRAM', esc(kbText(heap.psram_free) + ' (largest ' + kbText(heap.psram_largest) + ', ' +
+                    (heap.psram_frag_pct || 0) + ' % fragmented)'));
+            }
+            var points = Array.isArray(profile.window) ? profile.window : [];
+            if (points.length > 1) {
+                var lowHeap = Math.min.apply(null, points.map(function(p) { return p.internal_free || 0; }));
+                var stacks = points.filter(function(p) { return typeof p.stack_min === 'number'; })
+                    .map(function(p) { return p.stack_min; });
+                html += row('Last ' + Math.round((points[points.length - 1].ms - points[0].ms) / 1000) + ' s',
+                    esc('internal low ' + kbText(lowHeap) + (stacks.length ? ', stack low ' + Math.min.apply(null, stacks) + ' B' : '')));
+            }
+            var tasks = Array.isArray(profile.tasks) ? profile.tasks : [];
+            tasks.forEach(function(t) {
+                var core = t.core >= 0 ? ', core ' + t.core : '';
+                html += row(t.name || '--', esc(pctText(t.cpu_pct) + ', ' + (t.stack_free || 0) + ' B stack free' + core));
+            });
+            return html;
+        }
+
+        function uiUpdateRows(updates) {
+            if (!updates || typeof updates !== 'object') {
+                return row('Status', esc('No data'));
+            }
+            var applied = updates.applied || 0;
+            var skipped = updates.skipped || 0;
+            var total = applied + skipped;
+            return row('Applied', esc(String(applied))) +
+                row('Skipped unchanged', esc(String(skipped) + (total ? ' (' + Math.round(skipped * 100 / total) + ' %)' : '')));
+        }
+
+        function lvglPoolRows(pool) {
+            if (!pool || typeof pool !== 'object') {
+                return row('Status', esc('No data'));
+            }
+            var html = row('Slabs', esc(kbText(pool.slab_bytes_internal) + ' internal, ' +
+                kbText(pool.slab_bytes_psram) + ' PSRAM, ' + (pool.slab_free_pct || 0) + ' % free'));
+            html += row('Heap blocks', esc(String(pool.heap_live || 0) +
+                (pool.slab_misses ? ' (' + pool.slab_misses + ' slab misses)' : '')));
+            html += row('Slabs released', esc(String(pool.slabs_released || 0)));
+            var classes = Array.isArray(pool.classes) ? pool.classes : [];
+            classes.forEach(function(c) {
+                html += row(c.size + ' B', esc((c.used || 0) + ' used / ' + ((c.used || 0) + (c.free || 0)) +
+                    ' (peak ' + (c.peak || 0) + ', ' + (c.slabs || 0) + ' slabs)'));
+            });
+            return html;
+        }
+
+        function uiScreenRows(screens) {
+            if (!screens || typeof screens !== 'object') {
+                return row('Status', esc('No data'));
+            }
+            var html = row('Resident', esc((screens.resident || 0) + ' screens, ' +
+                kbText(screens.resident_bytes) + ' of ' + kbText(screens.budget_bytes)));
+            html += row('Opened built', esc(String(screens.hits || 0) + ' (' + (screens.prewarms || 0) + ' prewarmed)'));
+            html += row('Built on open', esc(String(screens.misses || 0) + ', ' + (screens.releases || 0) + ' released'));
+            if (screens.misses) {
+                html += row('First open', esc('last ' + msText(screens.build_us_last) + ', avg ' +
+                    msText(screens.build_us_avg) + ', max ' + msText(screens.build_us_max) +
+                    ' (screen ' + (screens.slowest_screen || 0) + ')'));
+            }
+            return html;
+        }
+
+        function cardCacheRows(cards) {
+            if (!cards || typeof cards !== 'object') {
+                return row('Status', esc('No data'));
+            }
+            if (!cards.enabled) {
+                return row('Status', badge('off', 'warn'));
+            }
+            var html = row('Cached', esc((cards.entries || 0) + ' backgrounds, ' +
+                kbText(cards.bytes) + ' of ' + kbText(cards.budget_bytes)));
+            html += row('Blits', esc(String(cards.hits || 0) + ', ' + (cards.builds || 0) + ' built (max ' +
+                msText(cards.build_us_max) + '), ' + (cards.evictions || 0) + ' evicted'));
+            html += row('Frame cached', cards.frames_cached ? esc(msText(cards.frame_us_cached) + ' over ' +
+                cards.frames_cached + ' frames') : badge('pending', 'warn'));
+            html += row('Frame direct', cards.frames_direct ? esc(msText(cards.frame_us_direct) + ' over ' +
+                cards.frames_direct + ' probes') : badge('pending', 'warn'));
+            return html;
+        }
+
+        function fontPackRows(packs) {
+            if (!Array.isArray(packs) || !packs.length) {
+                return row('Status', esc('No data'));
+            }
+            var html = '';
+            packs.forEach(function (pack) {
+                var name = String(pack.path || '').replace(/^.*\//, '');
+                if (pack.missing) {
+                    html += row(name, badge('missing: upload it under Firmware OTA', 'err'));
+                } else if (pack.invalid) {
+                    html += row(name, badge('not for this firmware: upload it again', 'err'));
+                } else if (pack.stale) {
+                    html += row(name, badge('stale: upload the pack built with this firmware', 'warn'));
+                } else if (pack.loaded) {
+                    html += row(name, esc((pack.glyphs || 0) + ' glyphs, ' + kbText(pack.cache_bytes) + ' cached'));
+                } else {
+                    html += row(name, esc('not in use'));
+                }
+            });
+            return html;
+        }
+
+        function bootRows(traces) {
+            if (!Array.isArray(traces) || !traces.length) {
+                return row('Status', esc('No data'));
+            }
+            var current = traces[0] || {};
+            var html = row('This boot', current.complete ? esc(msText(current.total_us)) : badge('in progress', 'warn'));
+            html += row('First frame', current.first_frame_us ? esc(msText(current.first_frame_us)) : badge('pending', 'warn'));
+            html += row('First reading', current.first_reading_us ? esc(msText(current.first_reading_us)) : badge('pending', 'warn'));
+            var stages = Array.isArray(current.stages) ? current.stages : [];
+            stages.forEach(function(st) {
+                var indent = new Array((st.depth || 0) + 1).join('\u00a0\u00a0');
+                html += row(indent + (st.name || '--'),
+                    st.duration_us ? esc(msText(st.duration_us) + ' @ ' + msText(st.start_us) + ' (core ' + (st.core || 0) + ')') : badge('open', 'warn'));
+            });
+            if (current.dropped_stages) {
+                html += row('Not recorded', badge(String(current.dropped_stages) + ' stages', 'warn'));
+            }
+            traces.slice(1).forEach(function(t) {
+                var firsts = t.first_frame_us ? ', frame ' + msText(t.first_frame_us) : '';
+                firsts += t.first_reading_us ? ', reading ' + msText(t.first_reading_us) : '';
+                html += row('Boot #' + (t.boot_count || 0), esc(msText(t.total_us) + firsts));
+            });
+            return html;
+        }
+
+        var resetReasonNames = ['unknown', 'power-on', 'external', 'restart', 'panic', 'interrupt watchdog',
+            'task watchdog', 'watchdog', 'deep sleep', 'brownout', 'SDIO'];
+
+        function previousBootRows(prev) {
+            if (!prev || typeof prev !== 'object') {
+                return row('Status', esc('Nothing retained'));
+            }
+            var reason = resetReasonNames[prev.reset_reason] || ('reason ' + prev.reset_reason);
+            var html = row('Ended by', prev.crashed ? badge(reason, 'err') : esc(reason));
+            var telemetry = Array.isArray(prev.telemetry) ? prev.telemetry : [];
+            telemetry.forEach(function(t) {
+                html += row('At ' + Math.round((t.uptime_ms || 0) / 1000) + ' s',
+                    esc('heap ' + kbText(t.heap_free) + ' (min ' + kbText(t.heap_min_free) + '), loop max ' +
+                        msText(t.loop_max_us) + ', sensor age ' + ((t.sensor_age_ms || 0) / 1000).toFixed(1) + ' s'));
+            });
+            return html;
+        }
+
+        function previousBootLog(prev) {
+            var logs = (prev && Array.isArray(prev.logs)) ? prev.logs : [];
+            return logs.length ? formatErrors(logs) : 'Nothing retained.';
+        }
+
         var diagPollOkDelayMs = 3000;
         var diagPollRetryDelayMs = 6000;
         var diagPollRetryMaxMs = 10000;
@@ -746,6 +1090,13 @@ static const char kDiagPageTemplate[] PROGMEM = R"HTML(
                 var heap = data.heap || {};
                 var otaBusy = !!data.ota_busy;
                 var web = data.web_stream || {};
+                var i2c = data.i2c || {};
+                var poll = data.sensor_poll || {};
+                var filter = data.sensor_filter || {};
+                var fusion = data.sensor_fusion || {};
+                var timing = data.sensor_timing || {};
+                var storageWriter = data.storage_writer || {};
+                var recordLog = data.record_store || {};
 
                 setRows('networkRows',
                     row('Mode', esc(net.mode || '--').toUpperCase()) +
@@ -789,6 +1140,26 @@ static const char kDiagPageTemplate[] PROGMEM = R"HTML(
                     row('Last URI', '<span class="mono">' + esc(web.last_uri || '--') + '</span>')
                 );
 
+                setRows('i2cRows', i2cRows(i2c));
+                setRows('pollRows', pollRows(poll));
+                setRows('filterRows', filterRows(filter));
+                setRows('fusionRows', fusionRows(fusion));
+                setRows('timingRows', timingRows(timing));
+                setRows('storageRows', storageRows(storageWriter));
+                setRows('recordRows', recordRows(recordLog));
+                setRows('profileRows', profileRows(data.task_profile));
+                setRows('uiUpdateRows', uiUpdateRows(data.ui_updates));
+                setRows('lvglPoolRows', lvglPoolRows(data.lvgl_pool));
+                setRows('uiScreenRows', uiScreenRows(data.ui_screens));
+                setRows('cardCacheRows', cardCacheRows(data.card_cache));
+                setRows('fontPackRows', fontPackRows(data.font_packs));
+                setRows('bootRows', bootRows(data.boot_traces));
+                setRows('previousBootRows', previousBootRows(data.previous_boot));
+                var previousLogEl = document.getElementById('previousBootLog');
+                if (previousLogEl) {
+                    previousLogEl.textContent = previousBootLog(data.previous_boot);
+                }
+
                 var errorsEl = document.getElementById('errors');
                 if (errorsEl) {
                     errorsEl.textContent = formatErrors(data.last_errors);
@@ -801,6 +1172,21 @@ static const char kDiagPageTemplate[] PROGMEM = R"HTML(
                 if (stamp) stamp.textContent = 'diag fetch failed: ' + (err && err.message ? err.message : 'error');
                 setRows('otaRows', row('Status', badge('No data', 'err')));
                 setRows('webRows', row('Status', badge('No data', 'err')));
+                setRows('i2cRows', row('Status', badge('No data', 'err')));
+                setRows('pollRows', row('Status', badge('No data', 'err')));
+                setRows('filterRows', row('Status', badge('No data', 'err')));
+                setRows('fusionRows', row('Status', badge('No data', 'err')));
+                setRows('timingRows', row('Status', badge('No data', 'err')));
+                setRows('storageRows', row('Status', badge('No data', 'err')));
+                setRows('recordRows', row('Status', badge('No data', 'err')));
+                setRows('profileRows', row('Status', badge('No data', 'err')));
+                setRows('uiUpdateRows', row('Status', badge('No data', 'err')));
+                setRows('lvglPoolRows', row('Status', badge('No data', 'err')));
+                setRows('uiScreenRows', row('Status', badge('No data', 'err')));
+                setRows('cardCacheRows', row('Status', badge('No data', 'err')));
+                setRows('fontPackRows', row('Status', badge('No data', 'err')));
+                setRows('bootRows', row('Status', badge('No data', 'err')));
+                setRows('previousBootRows', row('Status', badge('No data', 'err')));
                 var nextRetryMs = diagPollRetryDelayMs;
                 diagPollRetryDelayMs = Math.min(diagPollRetryMaxMs, diagPollRetryDelayMs + 2000);
                 scheduleDiagRefresh(nextRetryMs);
@@ -686,7 +686,7 @@ const char kDashboardPageTemplateAp[] PROGMEM = R"HTML_DASH_AP(
           <div class="sg-rows">
             <div id="otaPrecheck" class="ota-precheck warn">Waiting for device state before OTA.</div>
             <div class="text-field-row">
-              <label class="text-field-lbl" for="otaFile">Firmware file (.bin)</label>
+              <label class="text-field-lbl" for="otaFile">Firmware or font pack file (.bin)</label>
               <input class="file-input" type="file" id="otaFile" accept=".bin,application/octet-stream" />
             </div>
             <button class="btn" type="button" id="otaUploadBtn">Upload firmware</button>
@@ -7,6 +7,7 @@
 using String = std::string;
 
 uint32_t millis();
+uint32_t micros();
 void delay(uint32_t ms);
 
 class HardwareSerial {
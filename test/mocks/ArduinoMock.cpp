@@ -1,7 +1,9 @@
 #include "Arduino.h"
 #include "ArduinoMock.h"
+#include "esp_timer.h"
 
 static uint32_t g_millis = 0;
+static uint32_t g_extra_micros = 0;
 
 HardwareSerial Serial;
 
@@ -9,12 +11,21 @@ uint32_t millis() {
     return g_millis;
 }
 
+uint32_t micros() {
+    return g_millis * 1000U + g_extra_micros;
+}
+
+int64_t esp_timer_get_time() {
+    return static_cast<int64_t>(g_millis) * 1000 + g_extra_micros;
+}
+
 void delay(uint32_t ms) {
     g_millis += ms;
 }
 
 void setMillis(uint32_t ms) {
     g_millis = ms;
+    g_extra_micros = 0;
 }
 
 void advanceMillis(uint32_t delta) {
@@ -24,3 +35,9 @@ void advanceMillis(uint32_t delta) {
 uint32_t getMillis() {
     return g_millis;
 }
+
+void advanceMicros(uint32_t delta) {
+    g_extra_micros += delta;
+    g_millis += g_extra_micros / 1000U;
+    g_extra_micros %= 1000U;
+}
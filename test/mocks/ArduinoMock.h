@@ -5,3 +5,5 @@
 void setMillis(uint32_t ms);
 void advanceMillis(uint32_t delta);
 uint32_t getMillis();
+// Advances micros(); whole milliseconds carry into millis(). setMillis() clears the remainder.
+void advanceMicros(uint32_t delta);
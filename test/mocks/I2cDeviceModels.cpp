@@ -0,0 +1,966 @@
+#include "I2cDeviceModels.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "Arduino.h"
+#include "ArduinoMock.h"
+#include "config/AppConfig.h"
+#include "driver/i2c.h"
+
+namespace I2cModels {
+
+namespace {
+
+bool elapsed(uint32_t now, uint32_t deadline) {
+    return static_cast<int32_t>(now - deadline) >= 0;
+}
+
+uint16_t unsignedField(float value, float scale) {
+    if (std::isnan(value)) {
+        return 0xFFFF;
+    }
+    const float raw = std::round(value * scale);
+    if (raw <= 0.0f) {
+        return 0;
+    }
+    return raw >= 65534.0f ? 0xFFFE : static_cast<uint16_t>(raw);
+}
+
+uint16_t signedField(float value, float scale) {
+    if (std::isnan(value)) {
+        return 0x7FFF;
+    }
+    float raw = std::round(value * scale);
+    if (raw < -32768.0f) {
+        raw = -32768.0f;
+    } else if (raw > 32766.0f) {
+        raw = 32766.0f;
+    }
+    return static_cast<uint16_t>(static_cast<int16_t>(raw));
+}
+
+void putLe24(uint8_t *out, int32_t value) {
+    out[0] = static_cast<uint8_t>(value & 0xFF);
+    out[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    out[2] = static_cast<uint8_t>((value >> 16) & 0xFF);
+}
+
+void putBe24(uint8_t *out, int32_t value) {
+    out[0] = static_cast<uint8_t>((value >> 16) & 0xFF);
+    out[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    out[2] = static_cast<uint8_t>(value & 0xFF);
+}
+
+uint8_t dfrChecksum(const uint8_t *frame) {
+    uint8_t sum = 0;
+    for (size_t i = 1; i <= 7; ++i) {
+        sum = static_cast<uint8_t>(sum + frame[i]);
+    }
+    return static_cast<uint8_t>(~sum + 1);
+}
+
+} // namespace
+
+uint8_t sensirionCrc(const uint8_t *data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x31)
+                               : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// ---- Model ----
+
+Model::~Model() {
+    detach();
+}
+
+void Model::attach() {
+    I2cMock::attachModel(address_, this);
+}
+
+void Model::detach() {
+    if (I2cMock::attachedModel(address_) == this) {
+        I2cMock::attachModel(address_, nullptr);
+    }
+}
+
+void Model::clearFaults() {
+    nack_budget_ = 0;
+    timeout_budget_ = 0;
+    corrupt_budget_ = 0;
+}
+
+int Model::onWrite(const uint8_t *data, size_t len) {
+    if (!present_) {
+        chargeBusTime(0);
+        return ESP_FAIL;
+    }
+    const int fault = injectedFault();
+    if (fault != ESP_OK) {
+        return fault;
+    }
+    chargeBusTime(len);
+    writes_++;
+    return handleWrite(data, len);
+}
+
+int Model::onRead(uint8_t *data, size_t len) {
+    if (!present_) {
+        chargeBusTime(0);
+        return ESP_FAIL;
+    }
+    const int fault = injectedFault();
+    if (fault != ESP_OK) {
+        return fault;
+    }
+    chargeBusTime(len);
+    reads_++;
+    const int err = handleRead(data, len);
+    if (err == ESP_OK && corrupt_budget_ > 0) {
+        corrupt_budget_--;
+        corrupt(data, len);
+    }
+    return err;
+}
+
+void Model::corrupt(uint8_t *data, size_t len) {
+    data[len - 1] ^= 0x01;
+}
+
+int Model::injectedFault() {
+    if (timeout_budget_ > 0) {
+        timeout_budget_--;
+        advanceMillis(kTimeoutStallMs);
+        return ESP_ERR_TIMEOUT;
+    }
+    if (nack_budget_ > 0) {
+        nack_budget_--;
+        chargeBusTime(0);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void Model::chargeBusTime(size_t len) {
+    if (bus_timing_) {
+        advanceMicros(static_cast<uint32_t>((len + 1) * kByteTimeUs));
+    }
+}
+
+// ---- SensirionModel ----
+
+bool SensirionModel::busy() const {
+    return !elapsed(millis(), busy_until_ms_);
+}
+
+void SensirionModel::respond(const uint16_t *words, size_t count) {
+    if (count > kMaxWords) {
+        count = kMaxWords;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t *out = &response_[i * 3];
+        out[0] = static_cast<uint8_t>(words[i] >> 8);
+        out[1] = static_cast<uint8_t>(words[i] & 0xFF);
+        out[2] = sensirionCrc(out, 2);
+    }
+    response_len_ = count * 3;
+}
+
+int SensirionModel::handleWrite(const uint8_t *data, size_t len) {
+    if (busy()) {
+        return ESP_FAIL;
+    }
+    if (len == 0) {
+        return ESP_OK;
+    }
+    if (len < 2 || (len - 2) % 3 != 0 || (len - 2) / 3 > kMaxWords) {
+        return ESP_FAIL;
+    }
+    uint16_t params[kMaxWords] = {};
+    const size_t count = (len - 2) / 3;
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t *word = &data[2 + i * 3];
+        // The parts NACK the CRC byte of a damaged parameter word.
+        if (sensirionCrc(word, 2) != word[2]) {
+            return ESP_FAIL;
+        }
+        params[i] = static_cast<uint16_t>((word[0] << 8) | word[1]);
+    }
+
+    const uint16_t cmd = static_cast<uint16_t>((data[0] << 8) | data[1]);
+    response_len_ = 0;
+    uint32_t exec_ms = 0;
+    if (!execute(cmd, params, count, exec_ms)) {
+        return ESP_FAIL;
+    }
+    last_cmd_ = cmd;
+    busy_until_ms_ = millis() + exec_ms;
+    return ESP_OK;
+}
+
+int SensirionModel::handleRead(uint8_t *data, size_t len) {
+    if (busy() || response_len_ == 0) {
+        return ESP_FAIL;
+    }
+    for (size_t i = 0; i < len; ++i) {
+        // Clocking past the staged words reads the idle-high bus.
+        data[i] = i < response_len_ ? response_[i] : 0xFF;
+    }
+    response_len_ = 0;
+    return ESP_OK;
+}
+
+void SensirionModel::corrupt(uint8_t *data, size_t len) {
+    if (len >= 3) {
+        data[2] ^= 0x5A;
+    } else {
+        Model::corrupt(data, len);
+    }
+}
+
+// ---- Sen66Model ----
+
+Sen66Model::Sen66Model() : SensirionModel(Config::SEN66_ADDR) {}
+
+uint32_t Sen66Model::sampleIndex() const {
+    if (!measuring_) {
+        return 0;
+    }
+    return (millis() - measure_start_ms_) / kSampleIntervalMs;
+}
+
+bool Sen66Model::execute(uint16_t cmd, const uint16_t *params, size_t count, uint32_t &exec_ms) {
+    exec_ms = Config::SEN66_CMD_DELAY_MS;
+    switch (cmd) {
+        case Config::SEN66_CMD_START:
+            if (measuring_ || count != 0) {
+                return false;
+            }
+            measuring_ = true;
+            measure_start_ms_ = millis();
+            consumed_sample_ = 0;
+            exec_ms = 50;
+            return true;
+        case Config::SEN66_CMD_STOP:
+            measuring_ = false;
+            exec_ms = 1000;
+            return true;
+        case Config::SEN66_CMD_DATA_READY: {
+            const uint16_t ready = sampleIndex() > consumed_sample_ ? 0x0001 : 0x0000;
+            respond(&ready, 1);
+            return true;
+        }
+        case Config::SEN66_CMD_READ_VALUES: {
+            if (!measuring_) {
+                return false;
+            }
+            consumed_sample_ = sampleIndex();
+            samples_read_++;
+            const uint16_t words[9] = {
+                unsignedField(values_.pm1, 10.0f),
+                unsignedField(values_.pm25, 10.0f),
+                unsignedField(values_.pm4, 10.0f),
+                unsignedField(values_.pm10, 10.0f),
+                signedField(values_.humidity, 100.0f),
+                signedField(values_.temperature, 200.0f),
+                signedField(values_.voc, 10.0f),
+                signedField(values_.nox, 10.0f),
+                unsignedField(values_.co2, 1.0f),
+            };
+            respond(words, 9);
+            return true;
+        }
+        case Config::SEN66_CMD_READ_NUM_CONC: {
+            if (!measuring_) {
+                return false;
+            }
+            // Only the PM0.5 count is modelled; the larger bins repeat it.
+            const uint16_t count_raw = unsignedField(values_.pm05, 10.0f);
+            const uint16_t words[5] = {count_raw, count_raw, count_raw, count_raw, count_raw};
+            respond(words, 5);
+            return true;
+        }
+        case Config::SEN66_CMD_READ_STATUS: {
+            const uint16_t words[2] = {
+                static_cast<uint16_t>(status_ >> 16),
+                static_cast<uint16_t>(status_ & 0xFFFF),
+            };
+            respond(words, 2);
+            return true;
+        }
+        case Config::SEN66_CMD_ASC:
+            if (count == 0) {
+                const uint16_t word = asc_enabled_ ? 1 : 0;
+                respond(&word, 1);
+                return true;
+            }
+            if (count != 1 || measuring_) {
+                return false;
+            }
+            asc_enabled_ = params[0] != 0;
+            return true;
+        case Config::SEN66_CMD_AMBIENT_PRESSURE:
+            if (count == 0) {
+                respond(&ambient_pressure_hpa_, 1);
+                return true;
+            }
+            if (count != 1) {
+                return false;
+            }
+            ambient_pressure_hpa_ = params[0];
+            return true;
+        case Config::SEN66_CMD_VOC_STATE:
+            if (count == 0) {
+                respond(voc_state_, 4);
+                return true;
+            }
+            if (count != 4 || measuring_) {
+                return false;
+            }
+            memcpy(voc_state_, params, sizeof(voc_state_));
+            return true;
+        case Config::SEN66_CMD_TEMP_OFFSET:
+            if (count != 4) {
+                return false;
+            }
+            memcpy(temp_offset_, params, sizeof(temp_offset_));
+            return true;
+        case Config::SEN66_CMD_DEVICE_RESET:
+            measuring_ = false;
+            asc_enabled_ = true;
+            ambient_pressure_hpa_ = 1013;
+            memset(voc_state_, 0, sizeof(voc_state_));
+            memset(temp_offset_, 0, sizeof(temp_offset_));
+            exec_ms = 1200;
+            return true;
+        case Config::SEN66_CMD_FRC: {
+            if (count != 1 || measuring_) {
+                return false;
+            }
+            const int32_t delta = static_cast<int32_t>(params[0]) -
+                                  static_cast<int32_t>(std::lround(values_.co2));
+            const uint16_t correction = static_cast<uint16_t>(0x8000 + delta);
+            respond(&correction, 1);
+            exec_ms = 500;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// ---- Sfa30Model ----
+
+Sfa30Model::Sfa30Model() : SensirionModel(Config::SFA3X_ADDR) {}
+
+void Sfa30Model::setClimate(float humidity, float temperature) {
+    humidity_ = humidity;
+    temperature_ = temperature;
+}
+
+bool Sfa30Model::execute(uint16_t cmd, const uint16_t *, size_t count, uint32_t &exec_ms) {
+    if (count != 0) {
+        return false;
+    }
+    switch (cmd) {
+        case Config::SFA3X_CMD_START:
+            measuring_ = true;
+            exec_ms = 1;
+            return true;
+        case Config::SFA3X_CMD_STOP:
+            measuring_ = false;
+            exec_ms = 50;
+            return true;
+        case Config::SFA3X_CMD_READ_VALUES: {
+            if (!measuring_) {
+                return false;
+            }
+            const uint16_t words[3] = {
+                signedField(hcho_ppb_, 5.0f),
+                signedField(humidity_, 100.0f),
+                signedField(temperature_, 200.0f),
+            };
+            respond(words, 3);
+            exec_ms = 5;
+            return true;
+        }
+        case Config::SFA30_CMD_GET_DEVICE_MARKING: {
+            static const char kMarking[] = "SFA30-0F3A2C71";
+            uint8_t bytes[32] = {};
+            memcpy(bytes, kMarking, sizeof(kMarking));
+            uint16_t words[16];
+            for (size_t i = 0; i < 16; ++i) {
+                words[i] = static_cast<uint16_t>((bytes[i * 2] << 8) | bytes[i * 2 + 1]);
+            }
+            respond(words, 16);
+            exec_ms = 5;
+            return true;
+        }
+        default:
+            // SFA40 commands land here, which is how the driver tells the parts apart.
+            return false;
+    }
+}
+
+// ---- Sfa40Model ----
+
+Sfa40Model::Sfa40Model() : SensirionModel(Config::SFA3X_ADDR) {}
+
+bool Sfa40Model::execute(uint16_t cmd, const uint16_t *, size_t count, uint32_t &exec_ms) {
+    if (count != 0) {
+        return false;
+    }
+    exec_ms = 0;
+    const uint32_t now = millis();
+    switch (cmd) {
+        case Config::SFA40_CMD_START:
+            measuring_ = true;
+            measure_start_ms_ = now;
+            exec_ms = 1;
+            return true;
+        case Config::SFA40_CMD_STOP:
+            measuring_ = false;
+            selftest_running_ = false;
+            exec_ms = 50;
+            return true;
+        case Config::SFA40_CMD_READ_VALUES: {
+            if (selftest_running_) {
+                uint16_t result = Config::SFA40_SELFTEST_RUNNING_RAW;
+                if (now - selftest_start_ms_ >= kSelftestMs) {
+                    result = selftest_result_;
+                    selftest_running_ = false;
+                }
+                respond(&result, 1);
+                return true;
+            }
+            if (!measuring_) {
+                return false;
+            }
+            const uint32_t age = now - measure_start_ms_;
+            uint8_t status = 0x00;
+            if (age < kNotReadyMs) {
+                status = 0x03;
+            } else if (age < warmup_ms_) {
+                status = 0x02;
+            }
+            const uint16_t words[4] = {
+                unsignedField(hcho_ppb_, 10.0f),
+                0,
+                0,
+                static_cast<uint16_t>(status << 8),
+            };
+            respond(words, 4);
+            return true;
+        }
+        case Config::SFA40_CMD_ID: {
+            const uint16_t words[3] = {0x5346, 0x4134, 0x0C21};
+            respond(words, 3);
+            return true;
+        }
+        case Config::SFA40_CMD_START_SELFTEST:
+            if (measuring_) {
+                return false;
+            }
+            selftest_running_ = true;
+            selftest_start_ms_ = now;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// ---- DfrGasModel ----
+
+DfrGasModel::DfrGasModel(uint8_t address, uint8_t gas_type) : Model(address), gas_type_(gas_type) {}
+
+int DfrGasModel::handleWrite(const uint8_t *data, size_t len) {
+    if (len <= 1) {
+        // Address probe, or the register pointer ahead of a read.
+        return ESP_OK;
+    }
+    if (len != kFrameLen + 1 || data[0] != 0x00) {
+        return ESP_OK;
+    }
+    const uint8_t *frame = &data[1];
+    if (frame[0] != 0xFF || frame[8] != dfrChecksum(frame)) {
+        // The firmware drops damaged frames silently; the next read returns the old answer.
+        return ESP_OK;
+    }
+
+    uint8_t reply[kFrameLen] = {0xFF, frame[2]};
+    switch (frame[2]) {
+        case Config::DFR_GAS_CMD_CHANGE_MODE:
+            passive_ = frame[3] == Config::DFR_GAS_MODE_PASSIVE;
+            reply[2] = 0x01;
+            break;
+        case Config::DFR_GAS_CMD_READ_GAS: {
+            float scaled = ppm_;
+            for (uint8_t i = 0; i < decimals_; ++i) {
+                scaled *= 10.0f;
+            }
+            long raw = std::lround(scaled);
+            if (raw < 0) {
+                raw = 0;
+            } else if (raw > 0xFFFF) {
+                raw = 0xFFFF;
+            }
+            reply[2] = static_cast<uint8_t>(raw >> 8);
+            reply[3] = static_cast<uint8_t>(raw & 0xFF);
+            reply[4] = gas_type_;
+            reply[5] = decimals_;
+            break;
+        }
+        default:
+            return ESP_OK;
+    }
+    reply[8] = dfrChecksum(reply);
+    memcpy(pending_, reply, sizeof(pending_));
+    has_pending_ = true;
+    ready_at_ms_ = millis() + kProcessMs;
+    return ESP_OK;
+}
+
+int DfrGasModel::handleRead(uint8_t *data, size_t len) {
+    if (has_pending_ && elapsed(millis(), ready_at_ms_)) {
+        memcpy(current_, pending_, sizeof(current_));
+        has_pending_ = false;
+    }
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = i < kFrameLen ? current_[i] : 0;
+    }
+    return ESP_OK;
+}
+
+void DfrGasModel::corrupt(uint8_t *data, size_t len) {
+    if (len >= kFrameLen) {
+        data[kFrameLen - 1] ^= 0x5A;
+    } else {
+        Model::corrupt(data, len);
+    }
+}
+
+// ---- RegisterModel ----
+
+uint8_t RegisterModel::next(uint8_t reg) const {
+    if (wrap_ && reg == wrap_last_reg_) {
+        return 0x00;
+    }
+    return static_cast<uint8_t>(reg + 1);
+}
+
+int RegisterModel::handleWrite(const uint8_t *data, size_t len) {
+    if (len == 0) {
+        return ESP_OK;
+    }
+    pointer_ = data[0];
+    if (len == 1) {
+        return ESP_OK;
+    }
+    const uint8_t first = pointer_;
+    beginWrite();
+    for (size_t i = 1; i < len; ++i) {
+        writeRegister(pointer_, data[i]);
+        pointer_ = next(pointer_);
+    }
+    endWrite(first, len - 1);
+    return ESP_OK;
+}
+
+int RegisterModel::handleRead(uint8_t *data, size_t len) {
+    beginRead();
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = readRegister(pointer_);
+        pointer_ = next(pointer_);
+    }
+    return ESP_OK;
+}
+
+// ---- Bmp580Model ----
+
+Bmp580Model::Bmp580Model(uint8_t address, uint8_t chip_id) : RegisterModel(address), chip_id_(chip_id) {
+    powerOn();
+}
+
+void Bmp580Model::powerOn() {
+    memset(regs_, 0, sizeof(regs_));
+    regs_[Config::BMP580_REG_CHIP_ID] = chip_id_;
+    regs_[Config::BMP580_REG_ODR_CONFIG] = 0x70;
+    memset(sample_, 0, sizeof(sample_));
+    reset_at_ms_ = millis();
+}
+
+void Bmp580Model::beginRead() {
+    // Standby (power mode 0) leaves the data registers at their reset value.
+    if ((regs_[Config::BMP580_REG_ODR_CONFIG] & 0x03) == 0) {
+        memset(sample_, 0, sizeof(sample_));
+        return;
+    }
+    putLe24(&sample_[0], static_cast<int32_t>(std::lround(temperature_c_ * 65536.0f)));
+    putLe24(&sample_[3], static_cast<int32_t>(std::lround(pressure_hpa_ * 100.0f * 64.0f)));
+}
+
+uint8_t Bmp580Model::readRegister(uint8_t reg) {
+    if (reg >= Config::BMP580_REG_TEMP_XLSB && reg < Config::BMP580_REG_TEMP_XLSB + 6) {
+        return sample_[reg - Config::BMP580_REG_TEMP_XLSB];
+    }
+    if (reg == Config::BMP580_REG_STATUS) {
+        return elapsed(millis(), reset_at_ms_ + kResetMs) ? Config::BMP580_STATUS_NVM_RDY : 0;
+    }
+    return regs_[reg];
+}
+
+void Bmp580Model::writeRegister(uint8_t reg, uint8_t value) {
+    if (reg == Config::BMP580_REG_CMD) {
+        if (value == Config::BMP580_SOFT_RESET_CMD) {
+            powerOn();
+        }
+        return;
+    }
+    if (reg == Config::BMP580_REG_CHIP_ID || reg == Config::BMP580_REG_STATUS) {
+        return;
+    }
+    regs_[reg] = value;
+}
+
+// ---- Bmp3xxModel ----
+
+Bmp3xxModel::Bmp3xxModel(uint8_t address, uint8_t chip_id) : RegisterModel(address), chip_id_(chip_id) {
+    powerOn();
+}
+
+void Bmp3xxModel::powerOn() {
+    memset(regs_, 0, sizeof(regs_));
+    regs_[Config::BMP3XX_REG_CHIP_ID] = chip_id_;
+    // par_t1 = 0x4000 * 256 and par_t2 = 2^-16 give T = (raw - 4194304) / 65536;
+    // par_p1 = 2^-7 with every other pressure term at zero gives P = raw / 128 Pa.
+    uint8_t *calib = &regs_[Config::BMP3XX_REG_CALIB_DATA];
+    calib[0] = 0x00;
+    calib[1] = 0x40;
+    calib[2] = 0x00;
+    calib[3] = 0x40;
+    calib[5] = 0x00;
+    calib[6] = 0x60;
+    calib[7] = 0x00;
+    calib[8] = 0x40;
+    memset(sample_, 0, sizeof(sample_));
+}
+
+void Bmp3xxModel::beginRead() {
+    const uint8_t mode = (regs_[Config::BMP3XX_REG_PWR_CTRL] >> 4) & 0x03;
+    if (mode != Config::BMP3XX_MODE_NORMAL) {
+        return;
+    }
+    putLe24(&sample_[0], static_cast<int32_t>(std::lround(pressure_hpa_ * 100.0f * 128.0f)));
+    putLe24(&sample_[3], static_cast<int32_t>(std::lround(temperature_c_ * 65536.0f)) + 4194304);
+}
+
+uint8_t Bmp3xxModel::readRegister(uint8_t reg) {
+    if (reg >= Config::BMP3XX_REG_DATA && reg < Config::BMP3XX_REG_DATA + 6) {
+        return sample_[reg - Config::BMP3XX_REG_DATA];
+    }
+    if (reg == Config::BMP3XX_REG_STATUS) {
+        uint8_t status = Config::BMP3XX_STATUS_CMD_RDY;
+        if (((regs_[Config::BMP3XX_REG_PWR_CTRL] >> 4) & 0x03) == Config::BMP3XX_MODE_NORMAL) {
+            status |= Config::BMP3XX_STATUS_DRDY_PRESS | Config::BMP3XX_STATUS_DRDY_TEMP;
+        }
+        return status;
+    }
+    return regs_[reg];
+}
+
+void Bmp3xxModel::writeRegister(uint8_t reg, uint8_t value) {
+    if (reg == Config::BMP3XX_REG_CMD) {
+        if (value == Config::BMP3XX_CMD_SOFT_RESET) {
+            powerOn();
+        }
+        return;
+    }
+    if (reg < Config::BMP3XX_REG_PWR_CTRL || reg >= Config::BMP3XX_REG_CALIB_DATA) {
+        return;
+    }
+    regs_[reg] = value;
+}
+
+// ---- Dps310Model ----
+
+namespace {
+
+constexpr float kDpsScale[8] = {
+    524288.0f, 1572864.0f, 3670016.0f, 7864320.0f, 253952.0f, 516096.0f, 1040384.0f, 2088960.0f,
+};
+// Synthetic coefficients: T = Tsc * c1 and P = Psc * c10, everything else zero.
+constexpr float kDpsC1 = 2000.0f;
+constexpr float kDpsC10 = 200000.0f;
+
+} // namespace
+
+Dps310Model::Dps310Model(uint8_t address) : RegisterModel(address) {
+    powerOn();
+}
+
+void Dps310Model::powerOn() {
+    memset(regs_, 0, sizeof(regs_));
+    regs_[Config::DPS310_PRODREVID] = 0x10;
+    regs_[Config::DPS310_TMPCOEFSRCE] = 0x80;
+    uint8_t *coef = &regs_[0x10];
+    coef[1] = 0x07; // c1 = 0x7D0
+    coef[2] = 0xD0;
+    coef[5] = 0x03; // c10 = 0x30D40
+    coef[6] = 0x0D;
+    coef[7] = 0x40;
+    memset(sample_, 0, sizeof(sample_));
+    reset_at_ms_ = millis();
+}
+
+void Dps310Model::beginRead() {
+    if ((regs_[Config::DPS310_MEASCFG] & 0x07) != Config::DPS310_MODE_CONT_PRESTEMP) {
+        return;
+    }
+    const float p_scale = kDpsScale[regs_[Config::DPS310_PRSCFG] & 0x07];
+    const float t_scale = kDpsScale[regs_[Config::DPS310_TMPCFG] & 0x07];
+    putBe24(&sample_[0], static_cast<int32_t>(std::lround(pressure_hpa_ * 100.0f / kDpsC10 * p_scale)));
+    putBe24(&sample_[3], static_cast<int32_t>(std::lround(temperature_c_ / kDpsC1 * t_scale)));
+}
+
+uint8_t Dps310Model::readRegister(uint8_t reg) {
+    if (reg < 6) {
+        return sample_[reg];
+    }
+    if (reg == Config::DPS310_MEASCFG) {
+        const uint32_t now = millis();
+        uint8_t value = regs_[reg] & 0x07;
+        if (elapsed(now, reset_at_ms_ + kCoefReadyMs)) {
+            value |= 0x80;
+        }
+        if (elapsed(now, reset_at_ms_ + kSensorReadyMs)) {
+            value |= 0x40;
+        }
+        if (value & 0x40 && (value & 0x07) == Config::DPS310_MODE_CONT_PRESTEMP) {
+            value |= 0x30;
+        }
+        return value;
+    }
+    return regs_[reg];
+}
+
+void Dps310Model::writeRegister(uint8_t reg, uint8_t value) {
+    if (reg == Config::DPS310_RESET) {
+        if ((value & 0x0F) == 0x09) {
+            powerOn();
+        }
+        return;
+    }
+    if (reg == Config::DPS310_MEASCFG) {
+        regs_[reg] = value & 0x07;
+        return;
+    }
+    if (reg < Config::DPS310_PRSCFG || reg > Config::DPS310_CFGREG) {
+        return;
+    }
+    regs_[reg] = value;
+}
+
+// ---- RtcModel ----
+
+RtcModel::RtcModel(uint8_t address, uint8_t time_reg, uint8_t last_reg)
+    : RegisterModel(address), time_reg_(time_reg) {
+    setWrap(last_reg);
+    base_ms_ = millis();
+}
+
+void RtcModel::setEpoch(uint32_t epoch) {
+    epoch_base_ = epoch;
+    base_ms_ = millis();
+}
+
+uint32_t RtcModel::epoch() const {
+    return epoch_base_ + (millis() - base_ms_) / 1000;
+}
+
+uint8_t RtcModel::readRegister(uint8_t reg) {
+    if (reg >= time_reg_ && reg < time_reg_ + 7) {
+        return latched_[reg - time_reg_];
+    }
+    return regs_[reg];
+}
+
+void RtcModel::writeRegister(uint8_t reg, uint8_t value) {
+    if (reg >= time_reg_ && reg < time_reg_ + 7) {
+        written_[reg - time_reg_] = value;
+        return;
+    }
+    regs_[reg] = value;
+}
+
+void RtcModel::beginRead() {
+    encode(epoch(), latched_);
+}
+
+void RtcModel::beginWrite() {
+    encode(epoch(), written_);
+}
+
+void RtcModel::endWrite(uint8_t first_reg, size_t count) {
+    if (first_reg >= time_reg_ + 7 || first_reg + count <= time_reg_) {
+        return;
+    }
+    uint32_t decoded = 0;
+    if (decode(written_, decoded)) {
+        setEpoch(decoded);
+    }
+}
+
+uint8_t RtcModel::toBcd(uint32_t value) {
+    return static_cast<uint8_t>(((value / 10) << 4) | (value % 10));
+}
+
+uint32_t RtcModel::fromBcd(uint8_t value) {
+    return (value >> 4) * 10 + (value & 0x0F);
+}
+
+void RtcModel::civilFromEpoch(uint32_t epoch, uint32_t &year, uint32_t &month, uint32_t &day,
+                              uint32_t &hour, uint32_t &minute, uint32_t &second,
+                              uint32_t &weekday) {
+    const uint32_t days = epoch / 86400;
+    const uint32_t rem = epoch % 86400;
+    hour = rem / 3600;
+    minute = (rem % 3600) / 60;
+    second = rem % 60;
+    weekday = (days + 4) % 7; // 1970-01-01 was a Thursday; 0 = Sunday
+
+    // Howard Hinnant's civil_from_days, restricted to dates after 1970.
+    const uint32_t z = days + 719468;
+    const uint32_t era = z / 146097;
+    const uint32_t doe = z - era * 146097;
+    const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const uint32_t mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+uint32_t RtcModel::epochFromCivil(uint32_t year, uint32_t month, uint32_t day,
+                                  uint32_t hour, uint32_t minute, uint32_t second) {
+    const uint32_t y = month <= 2 ? year - 1 : year;
+    const uint32_t era = y / 400;
+    const uint32_t yoe = y - era * 400;
+    const uint32_t mp = month > 2 ? month - 3 : month + 9;
+    const uint32_t doy = (153 * mp + 2) / 5 + day - 1;
+    const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    const uint32_t days = era * 146097 + doe - 719468;
+    return days * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+// ---- Pcf8523Model ----
+
+Pcf8523Model::Pcf8523Model()
+    : RtcModel(Config::PCF8523_ADDR, Config::PCF8523_REG_SECONDS, Config::PCF8523_REG_TMR_B_REG) {
+    regs_[Config::PCF8523_REG_CONTROL_3] = 0xE0;
+    regs_[Config::PCF8523_REG_TMR_A_FREQ_CTRL] = Config::PCF8523_TMR_FREQ_RESET;
+    regs_[Config::PCF8523_REG_TMR_B_FREQ_CTRL] = Config::PCF8523_TMR_FREQ_RESET;
+}
+
+void Pcf8523Model::setOscillatorStopped(bool stopped) {
+    os_flag_ = stopped;
+}
+
+void Pcf8523Model::writeRegister(uint8_t reg, uint8_t value) {
+    if (reg == Config::PCF8523_REG_SECONDS) {
+        os_flag_ = (value & 0x80) != 0;
+    }
+    RtcModel::writeRegister(reg, value);
+}
+
+void Pcf8523Model::encode(uint32_t epoch, uint8_t *out) const {
+    uint32_t year, month, day, hour, minute, second, weekday;
+    civilFromEpoch(epoch, year, month, day, hour, minute, second, weekday);
+    out[0] = static_cast<uint8_t>(toBcd(second) | (os_flag_ ? 0x80 : 0x00));
+    out[1] = toBcd(minute);
+    out[2] = toBcd(hour);
+    out[3] = toBcd(day);
+    out[4] = static_cast<uint8_t>(weekday);
+    out[5] = toBcd(month);
+    out[6] = toBcd(year % 100);
+}
+
+bool Pcf8523Model::decode(const uint8_t *in, uint32_t &epoch) const {
+    const uint32_t month = fromBcd(in[5] & 0x1F);
+    const uint32_t day = fromBcd(in[3] & 0x3F);
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    epoch = epochFromCivil(2000 + fromBcd(in[6]), month, day, fromBcd(in[2] & 0x3F),
+                           fromBcd(in[1] & 0x7F), fromBcd(in[0] & 0x7F));
+    return true;
+}
+
+// ---- Ds3231Model ----
+
+Ds3231Model::Ds3231Model()
+    : RtcModel(Config::DS3231_ADDR, Config::DS3231_REG_SECONDS, Config::DS3231_REG_TEMP_LSB) {
+    regs_[Config::DS3231_REG_CONTROL] = 0x1C;
+    regs_[Config::DS3231_REG_STATUS] = 0x88;
+    regs_[Config::DS3231_REG_TEMP_MSB] = 25;
+    regs_[Config::DS3231_REG_TEMP_LSB] = 0x40;
+}
+
+void Ds3231Model::setOscillatorStopped(bool stopped) {
+    if (stopped) {
+        regs_[Config::DS3231_REG_STATUS] |= Config::DS3231_STATUS_OSF;
+    } else {
+        regs_[Config::DS3231_REG_STATUS] &= static_cast<uint8_t>(~Config::DS3231_STATUS_OSF);
+    }
+}
+
+void Ds3231Model::encode(uint32_t epoch, uint8_t *out) const {
+    uint32_t year, month, day, hour, minute, second, weekday;
+    civilFromEpoch(epoch, year, month, day, hour, minute, second, weekday);
+    out[0] = toBcd(second);
+    out[1] = toBcd(minute);
+    out[2] = toBcd(hour);
+    out[3] = static_cast<uint8_t>(weekday + 1);
+    out[4] = toBcd(day);
+    out[5] = toBcd(month);
+    out[6] = toBcd(year % 100);
+}
+
+bool Ds3231Model::decode(const uint8_t *in, uint32_t &epoch) const {
+    const uint32_t month = fromBcd(in[5] & 0x1F);
+    const uint32_t day = fromBcd(in[4] & 0x3F);
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    uint32_t hour = 0;
+    if (in[2] & 0x40) {
+        // 12-hour mode: bit 5 is PM.
+        hour = fromBcd(in[2] & 0x1F) % 12 + ((in[2] & 0x20) ? 12 : 0);
+    } else {
+        hour = fromBcd(in[2] & 0x3F);
+    }
+    epoch = epochFromCivil(2000 + fromBcd(in[6]), month, day, hour,
+                           fromBcd(in[1] & 0x7F), fromBcd(in[0] & 0x7F));
+    return true;
+}
+
+// ---- Gp8403Model ----
+
+Gp8403Model::Gp8403Model(uint8_t address) : RegisterModel(address) {}
+
+uint8_t Gp8403Model::outputRange() const {
+    return regs_[Config::DAC_REG_OUTPUT_RANGE];
+}
+
+uint16_t Gp8403Model::channelRaw12(uint8_t channel) const {
+    const uint8_t reg = channel == 0 ? Config::DAC_REG_CHANNEL_0 : Config::DAC_REG_CHANNEL_1;
+    const uint16_t packed = static_cast<uint16_t>(regs_[reg] | (regs_[reg + 1] << 8));
+    return static_cast<uint16_t>(packed >> 4);
+}
+
+} // namespace I2cModels
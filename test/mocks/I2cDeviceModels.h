@@ -0,0 +1,395 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "I2cMock.h"
+
+// Behavioural models of the boards' I2C peripherals, driven by the mock millis() clock.
+// They answer the same bytes the parts put on the wire: Sensirion command/CRC framing
+// and execution times, DFRobot checksummed frames, Bosch/Infineon register files and BCD
+// RTC calendars. Each model can be told to NACK, stall or corrupt its next transfers.
+namespace I2cModels {
+
+uint8_t sensirionCrc(const uint8_t *data, size_t len);
+
+class Model : public I2cMock::DeviceModel {
+public:
+    // Standard-mode clock: nine bit times per byte including the ACK, plus the address byte.
+    static constexpr uint32_t kByteTimeUs = 90;
+    // Matches Config::I2C_TIMEOUT_MS: a stretched clock holds the bus until the master gives up.
+    static constexpr uint32_t kTimeoutStallMs = 50;
+
+    explicit Model(uint8_t address) : address_(address) {}
+    ~Model() override;
+    Model(const Model &) = delete;
+    Model &operator=(const Model &) = delete;
+
+    uint8_t address() const { return address_; }
+    void attach();
+    void detach();
+
+    // An absent device NACKs its address, exactly like an empty socket.
+    void setPresent(bool present) { present_ = present; }
+    bool present() const { return present_; }
+    // Charges kByteTimeUs per byte to the mock clock; on by default so telemetry sees latency.
+    void setBusTiming(bool enabled) { bus_timing_ = enabled; }
+
+    // Each counter covers the next N transfers (one write or one read each).
+    void injectNack(uint32_t transfers) { nack_budget_ += transfers; }
+    void injectTimeout(uint32_t transfers) { timeout_budget_ += transfers; }
+    void injectCorruption(uint32_t reads) { corrupt_budget_ += reads; }
+    void clearFaults();
+
+    uint32_t writes() const { return writes_; }
+    uint32_t reads() const { return reads_; }
+
+    int onWrite(const uint8_t *data, size_t len) final;
+    int onRead(uint8_t *data, size_t len) final;
+
+protected:
+    virtual int handleWrite(const uint8_t *data, size_t len) = 0;
+    virtual int handleRead(uint8_t *data, size_t len) = 0;
+    // Damages a successful read the way line noise would. Devices with a checksum override
+    // this to hit the checksum, so the driver's integrity check is what has to catch it.
+    virtual void corrupt(uint8_t *data, size_t len);
+
+private:
+    int injectedFault();
+    void chargeBusTime(size_t len);
+
+    uint8_t address_;
+    bool present_ = true;
+    bool bus_timing_ = true;
+    uint32_t nack_budget_ = 0;
+    uint32_t timeout_budget_ = 0;
+    uint32_t corrupt_budget_ = 0;
+    uint32_t writes_ = 0;
+    uint32_t reads_ = 0;
+};
+
+// Sensirion framing: a 16-bit command, optional parameter words each followed by a CRC-8,
+// then an execution time during which the part NACKs everything.
+class SensirionModel : public Model {
+public:
+    using Model::Model;
+
+    bool busy() const;
+    uint16_t lastCommand() const { return last_cmd_; }
+
+protected:
+    // Runs one command with its CRC-checked parameters. Return false to NACK it (unknown
+    // command, or not allowed in the current state); exec_ms is how long the part stays busy.
+    virtual bool execute(uint16_t cmd, const uint16_t *params, size_t count, uint32_t &exec_ms) = 0;
+    // Stages the words the next read returns, each followed by its CRC.
+    void respond(const uint16_t *words, size_t count);
+
+    int handleWrite(const uint8_t *data, size_t len) override;
+    int handleRead(uint8_t *data, size_t len) override;
+    void corrupt(uint8_t *data, size_t len) override;
+
+private:
+    static constexpr size_t kMaxWords = 32;
+
+    uint8_t response_[kMaxWords * 3] = {};
+    size_t response_len_ = 0;
+    uint32_t busy_until_ms_ = 0;
+    uint16_t last_cmd_ = 0;
+};
+
+class Sen66Model : public SensirionModel {
+public:
+    // NaN reports the field as invalid (0xFFFF, or 0x7FFF for signed fields).
+    struct Values {
+        float pm1 = 3.0f;
+        float pm25 = 4.0f;
+        float pm4 = 4.5f;
+        float pm10 = 5.0f;
+        float pm05 = 20.0f;
+        float humidity = 45.0f;
+        float temperature = 23.0f;
+        float voc = 100.0f;
+        float nox = 1.0f;
+        float co2 = 600.0f;
+    };
+
+    // A new sample every second once measurement has run for this long.
+    static constexpr uint32_t kSampleIntervalMs = 1000;
+
+    Sen66Model();
+
+    Values &values() { return values_; }
+    void setStatus(uint32_t status) { status_ = status; }
+    bool measuring() const { return measuring_; }
+    bool ascEnabled() const { return asc_enabled_; }
+    uint16_t ambientPressureHpa() const { return ambient_pressure_hpa_; }
+    uint32_t samplesRead() const { return samples_read_; }
+
+protected:
+    bool execute(uint16_t cmd, const uint16_t *params, size_t count, uint32_t &exec_ms) override;
+
+private:
+    uint32_t sampleIndex() const;
+
+    Values values_{};
+    bool measuring_ = false;
+    uint32_t measure_start_ms_ = 0;
+    uint32_t consumed_sample_ = 0;
+    uint32_t samples_read_ = 0;
+    uint32_t status_ = 0;
+    bool asc_enabled_ = true;
+    uint16_t ambient_pressure_hpa_ = 1013;
+    uint16_t voc_state_[4] = {};
+    uint16_t temp_offset_[4] = {};
+};
+
+class Sfa30Model : public SensirionModel {
+public:
+    Sfa30Model();
+
+    void setHchoPpb(float ppb) { hcho_ppb_ = ppb; }
+    void setClimate(float humidity, float temperature);
+    bool measuring() const { return measuring_; }
+
+protected:
+    bool execute(uint16_t cmd, const uint16_t *params, size_t count, uint32_t &exec_ms) override;
+
+private:
+    float hcho_ppb_ = 12.0f;
+    float humidity_ = 45.0f;
+    float temperature_ = 23.0f;
+    bool measuring_ = false;
+};
+
+class Sfa40Model : public SensirionModel {
+public:
+    // Status in the high byte of the fourth word: 0x03 not ready, 0x02 warming up, 0x00 in spec.
+    static constexpr uint32_t kNotReadyMs = 500;
+
+    Sfa40Model();
+
+    void setHchoPpb(float ppb) { hcho_ppb_ = ppb; }
+    void setWarmupMs(uint32_t ms) { warmup_ms_ = ms; }
+    void setSelftestResult(uint16_t raw) { selftest_result_ = raw; }
+    bool measuring() const { return measuring_; }
+
+protected:
+    bool execute(uint16_t cmd, const uint16_t *params, size_t count, uint32_t &exec_ms) override;
+
+private:
+    static constexpr uint32_t kSelftestMs = 2000;
+
+    float hcho_ppb_ = 12.0f;
+    uint32_t warmup_ms_ = 60000;
+    uint16_t selftest_result_ = 0;
+    bool measuring_ = false;
+    uint32_t measure_start_ms_ = 0;
+    bool selftest_running_ = false;
+    uint32_t selftest_start_ms_ = 0;
+};
+
+// DFRobot gas boards (SEN0466 CO and the SEN0467..SEN0472 family): a 9-byte frame written
+// to register 0x00, answered after the on-board MCU processes it. Reading too early returns
+// the previous answer, as the real firmware does.
+class DfrGasModel : public Model {
+public:
+    static constexpr uint32_t kProcessMs = 10;
+
+    DfrGasModel(uint8_t address, uint8_t gas_type);
+
+    void setConcentration(float ppm) { ppm_ = ppm; }
+    void setDecimals(uint8_t decimals) { decimals_ = decimals; }
+    bool passive() const { return passive_; }
+
+protected:
+    int handleWrite(const uint8_t *data, size_t len) override;
+    int handleRead(uint8_t *data, size_t len) override;
+    void corrupt(uint8_t *data, size_t len) override;
+
+private:
+    static constexpr size_t kFrameLen = 9;
+
+    uint8_t gas_type_;
+    float ppm_ = 0.0f;
+    uint8_t decimals_ = 2;
+    bool passive_ = false;
+    uint8_t pending_[kFrameLen] = {};
+    uint8_t current_[kFrameLen] = {};
+    bool has_pending_ = false;
+    uint32_t ready_at_ms_ = 0;
+};
+
+// Byte-addressed register file with an auto-incrementing pointer. Reads past last_reg wrap
+// to zero when wrap is set, as on the RTCs.
+class RegisterModel : public Model {
+public:
+    using Model::Model;
+
+    void setRegister(uint8_t reg, uint8_t value) { regs_[reg] = value; }
+    uint8_t registerValue(uint8_t reg) const { return regs_[reg]; }
+
+protected:
+    void setWrap(uint8_t last_reg) { wrap_last_reg_ = last_reg; wrap_ = true; }
+    virtual uint8_t readRegister(uint8_t reg) { return regs_[reg]; }
+    virtual void writeRegister(uint8_t reg, uint8_t value) { regs_[reg] = value; }
+    // Called around each burst, after the register pointer byte has been taken.
+    virtual void beginRead() {}
+    virtual void beginWrite() {}
+    virtual void endWrite(uint8_t first_reg, size_t count) { (void)first_reg; (void)count; }
+
+    int handleWrite(const uint8_t *data, size_t len) override;
+    int handleRead(uint8_t *data, size_t len) override;
+
+    uint8_t regs_[256] = {};
+
+private:
+    uint8_t next(uint8_t reg) const;
+
+    uint8_t pointer_ = 0;
+    uint8_t wrap_last_reg_ = 0xFF;
+    bool wrap_ = false;
+};
+
+class Bmp580Model : public RegisterModel {
+public:
+    static constexpr uint32_t kResetMs = 2;
+
+    explicit Bmp580Model(uint8_t address = 0x46, uint8_t chip_id = 0x50);
+
+    void setPressureHpa(float hpa) { pressure_hpa_ = hpa; }
+    void setTemperature(float celsius) { temperature_c_ = celsius; }
+
+protected:
+    uint8_t readRegister(uint8_t reg) override;
+    void writeRegister(uint8_t reg, uint8_t value) override;
+    void beginRead() override;
+
+private:
+    void powerOn();
+
+    uint8_t chip_id_;
+    float pressure_hpa_ = 1013.25f;
+    float temperature_c_ = 23.0f;
+    uint32_t reset_at_ms_ = 0;
+    uint8_t sample_[6] = {};
+};
+
+// BMP388/BMP390. The calibration block is synthetic: coefficients that reduce Bosch's
+// compensation polynomial to a linear scale, so injected values come back out exactly.
+class Bmp3xxModel : public RegisterModel {
+public:
+    explicit Bmp3xxModel(uint8_t address = 0x77, uint8_t chip_id = 0x60);
+
+    void setPressureHpa(float hpa) { pressure_hpa_ = hpa; }
+    void setTemperature(float celsius) { temperature_c_ = celsius; }
+
+protected:
+    uint8_t readRegister(uint8_t reg) override;
+    void writeRegister(uint8_t reg, uint8_t value) override;
+    void beginRead() override;
+
+private:
+    void powerOn();
+
+    uint8_t chip_id_;
+    float pressure_hpa_ = 1013.25f;
+    float temperature_c_ = 23.0f;
+    uint8_t sample_[6] = {};
+};
+
+// DPS310 with the same synthetic-calibration approach; the raw scale follows the
+// oversampling the driver programs into PRS_CFG/TMP_CFG.
+class Dps310Model : public RegisterModel {
+public:
+    static constexpr uint32_t kCoefReadyMs = 12;
+    static constexpr uint32_t kSensorReadyMs = 40;
+
+    explicit Dps310Model(uint8_t address = 0x77);
+
+    void setPressureHpa(float hpa) { pressure_hpa_ = hpa; }
+    void setTemperature(float celsius) { temperature_c_ = celsius; }
+
+protected:
+    uint8_t readRegister(uint8_t reg) override;
+    void writeRegister(uint8_t reg, uint8_t value) override;
+    void beginRead() override;
+
+private:
+    void powerOn();
+
+    float pressure_hpa_ = 1013.25f;
+    float temperature_c_ = 23.0f;
+    uint32_t reset_at_ms_ = 0;
+    uint8_t sample_[6] = {};
+};
+
+// Shared calendar for the BCD RTCs: time advances with the mock clock and is latched at
+// the start of each read burst so a multi-byte read never tears across a second.
+class RtcModel : public RegisterModel {
+public:
+    RtcModel(uint8_t address, uint8_t time_reg, uint8_t last_reg);
+
+    void setEpoch(uint32_t epoch);
+    uint32_t epoch() const;
+    virtual void setOscillatorStopped(bool stopped) = 0;
+
+protected:
+    uint8_t readRegister(uint8_t reg) override;
+    void writeRegister(uint8_t reg, uint8_t value) override;
+    void beginRead() override;
+    void beginWrite() override;
+    void endWrite(uint8_t first_reg, size_t count) override;
+
+    // Layout hooks: seven calendar bytes starting at time_reg.
+    virtual void encode(uint32_t epoch, uint8_t *out) const = 0;
+    virtual bool decode(const uint8_t *in, uint32_t &epoch) const = 0;
+
+    static uint8_t toBcd(uint32_t value);
+    static uint32_t fromBcd(uint8_t value);
+    static void civilFromEpoch(uint32_t epoch, uint32_t &year, uint32_t &month, uint32_t &day,
+                               uint32_t &hour, uint32_t &minute, uint32_t &second,
+                               uint32_t &weekday);
+    static uint32_t epochFromCivil(uint32_t year, uint32_t month, uint32_t day,
+                                   uint32_t hour, uint32_t minute, uint32_t second);
+
+private:
+    uint8_t time_reg_;
+    uint32_t epoch_base_ = 946684800; // 2000-01-01
+    uint32_t base_ms_ = 0;
+    uint8_t latched_[7] = {};
+    uint8_t written_[7] = {};
+};
+
+class Pcf8523Model : public RtcModel {
+public:
+    Pcf8523Model();
+    void setOscillatorStopped(bool stopped) override;
+
+protected:
+    void writeRegister(uint8_t reg, uint8_t value) override;
+    void encode(uint32_t epoch, uint8_t *out) const override;
+    bool decode(const uint8_t *in, uint32_t &epoch) const override;
+
+private:
+    bool os_flag_ = true;
+};
+
+class Ds3231Model : public RtcModel {
+public:
+    Ds3231Model();
+    void setOscillatorStopped(bool stopped) override;
+
+protected:
+    void encode(uint32_t epoch, uint8_t *out) const override;
+    bool decode(const uint8_t *in, uint32_t &epoch) const override;
+};
+
+class Gp8403Model : public RegisterModel {
+public:
+    explicit Gp8403Model(uint8_t address = 0x58);
+
+    uint8_t outputRange() const;
+    uint16_t channelRaw12(uint8_t channel) const;
+};
+
+} // namespace I2cModels
@@ -25,6 +25,7 @@ struct DeviceState {
     uint16_t read_wrap_last_reg = 0xFF;
     uint16_t last_sensor_cmd = 0;
     bool has_last_sensor_cmd = false;
+    I2cMock::DeviceModel *model = nullptr;
 };
 
 std::array<DeviceState, 256> g_devices{};
@@ -41,6 +42,14 @@ void reset() {
     g_devices = {};
 }
 
+void attachModel(uint8_t addr, DeviceModel *model) {
+    device(addr).model = model;
+}
+
+DeviceModel *attachedModel(uint8_t addr) {
+    return device(addr).model;
+}
+
 void setDevicePresent(uint8_t addr, bool present) {
     device(addr).present = present;
 }
@@ -135,6 +144,9 @@ esp_err_t i2c_master_cmd_begin(i2c_port_t, i2c_cmd_handle_t cmd, TickType_t) {
     if (!cmd || !cmd->has_address) {
         return ESP_ERR_INVALID_ARG;
     }
+    if (I2cMock::DeviceModel *model = device(cmd->addr).model) {
+        return model->onWrite(cmd->payload.data(), cmd->payload.size());
+    }
     if (!device(cmd->addr).present) {
         return ESP_FAIL;
     }
@@ -157,6 +169,13 @@ esp_err_t i2c_master_write_read_device(i2c_port_t,
                                        uint8_t *read_buffer,
                                        size_t read_size,
                                        TickType_t) {
+    if (I2cMock::DeviceModel *model = device(addr).model) {
+        if (!write_buffer || write_size == 0 || !read_buffer || read_size == 0) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        const esp_err_t err = model->onWrite(write_buffer, write_size);
+        return err == ESP_OK ? model->onRead(read_buffer, read_size) : err;
+    }
     if (!device(addr).present || !write_buffer || write_size == 0 ||
         !read_buffer || read_size == 0) {
         return ESP_FAIL;
@@ -195,6 +214,12 @@ esp_err_t i2c_master_write_to_device(i2c_port_t,
                                      const uint8_t *write_buffer,
                                      size_t write_size,
                                      TickType_t) {
+    if (I2cMock::DeviceModel *model = device(addr).model) {
+        if (!write_buffer || write_size == 0) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        return model->onWrite(write_buffer, write_size);
+    }
     if (!device(addr).present || !write_buffer || write_size == 0) {
         return ESP_FAIL;
     }
@@ -221,6 +246,12 @@ esp_err_t i2c_master_read_from_device(i2c_port_t,
                                       uint8_t *read_buffer,
                                       size_t read_size,
                                       TickType_t) {
+    if (I2cMock::DeviceModel *model = device(addr).model) {
+        if (!read_buffer || read_size == 0) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        return model->onRead(read_buffer, read_size);
+    }
     if (!device(addr).present || !read_buffer || read_size == 0) {
         return ESP_FAIL;
     }
@@ -5,7 +5,20 @@
 
 namespace I2cMock {
 
+// Behavioural stand-in for one device. While attached, every transfer to its address goes
+// to the model instead of the register and command tables below. Results are esp_err_t.
+class DeviceModel {
+public:
+    virtual ~DeviceModel() = default;
+    // An empty write is an address-only probe.
+    virtual int onWrite(const uint8_t *data, size_t len) = 0;
+    virtual int onRead(uint8_t *data, size_t len) = 0;
+};
+
 void reset();
+// Pass nullptr to detach. reset() detaches every model.
+void attachModel(uint8_t addr, DeviceModel *model);
+DeviceModel *attachedModel(uint8_t addr);
 void setDevicePresent(uint8_t addr, bool present);
 void setCommandFailure(uint8_t addr, uint16_t cmd, bool fail);
 void setCommandRead(uint8_t addr, uint16_t cmd, const uint8_t *data, size_t len);
@@ -0,0 +1,245 @@
+#include "MqttBrokerStub.h"
+
+#include <cstring>
+#include <utility>
+
+#include "Arduino.h"
+#include "MqttTransportHost.h"
+
+void MqttBrokerStub::reset() {
+    sessions_.clear();
+    pending_.clear();
+    retained_.clear();
+    stats_ = Stats{};
+    latency_ms_ = 0;
+    refuse_code_ = 0;
+    online_ = true;
+}
+
+void MqttBrokerStub::setOnline(bool online) {
+    if (!online && online_) {
+        for (Session &session : sessions_) {
+            if (session.connected) {
+                session.connected = false;
+                enqueue(session.client, MqttTransportEventType::Disconnected);
+            }
+        }
+    }
+    online_ = online;
+}
+
+size_t MqttBrokerStub::pump() {
+    size_t delivered = 0;
+    for (;;) {
+        const uint32_t now = millis();
+        size_t next = pending_.size();
+        for (size_t i = 0; i < pending_.size(); ++i) {
+            if (static_cast<int32_t>(now - pending_[i].due_ms) < 0) {
+                continue;
+            }
+            if (next == pending_.size() ||
+                static_cast<int32_t>(pending_[i].due_ms - pending_[next].due_ms) < 0) {
+                next = i;
+            }
+        }
+        if (next == pending_.size()) {
+            break;
+        }
+
+        Pending item = std::move(pending_[next]);
+        pending_.erase(pending_.begin() + static_cast<std::ptrdiff_t>(next));
+
+        MqttTransportEvent event{};
+        event.type = item.type;
+        event.error_rc = item.error_rc;
+        if (item.type == MqttTransportEventType::Message) {
+            event.topic = item.topic.c_str();
+            event.payload = reinterpret_cast<const uint8_t *>(item.payload.data());
+            event.payload_len = item.payload.size();
+        }
+        item.client->deliver(event);
+        delivered++;
+    }
+    return delivered;
+}
+
+size_t MqttBrokerStub::connectedCount() const {
+    size_t count = 0;
+    for (const Session &session : sessions_) {
+        if (session.connected) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool MqttBrokerStub::retained(const char *topic, std::string &payload) const {
+    auto it = retained_.find(topic ? topic : "");
+    if (it == retained_.end()) {
+        return false;
+    }
+    payload = it->second;
+    return true;
+}
+
+bool MqttBrokerStub::topicMatches(const char *filter, const char *topic) {
+    if (!filter || !topic) {
+        return false;
+    }
+    while (*filter) {
+        if (filter[0] == '#') {
+            return filter[1] == '\0';
+        }
+        if (filter[0] == '+') {
+            while (*topic && *topic != '/') {
+                ++topic;
+            }
+            ++filter;
+            continue;
+        }
+        if (filter[0] == '/' && filter[1] == '#' && filter[2] == '\0' && *topic == '\0') {
+            // "a/#" also matches the parent level "a".
+            return true;
+        }
+        if (*filter != *topic) {
+            return false;
+        }
+        ++filter;
+        ++topic;
+    }
+    return *topic == '\0';
+}
+
+void MqttBrokerStub::connect(MqttTransportHost *client) {
+    stats_.connect_attempts++;
+    Session *session = findSession(client);
+    if (!session) {
+        sessions_.push_back(Session{});
+        session = &sessions_.back();
+        session->client = client;
+    }
+    session->connected = false;
+    session->filters.clear();
+
+    if (!online_ || refuse_code_ != 0) {
+        stats_.connects_rejected++;
+        enqueue(client, MqttTransportEventType::Error, online_ ? refuse_code_ : kOfflineErrorRc);
+        enqueue(client, MqttTransportEventType::Disconnected);
+        return;
+    }
+    stats_.connects_accepted++;
+    session->connected = true;
+    enqueue(client, MqttTransportEventType::Connected);
+}
+
+void MqttBrokerStub::disconnect(MqttTransportHost *client) {
+    Session *session = findSession(client);
+    if (!session || !session->connected) {
+        return;
+    }
+    session->connected = false;
+    enqueue(client, MqttTransportEventType::Disconnected);
+}
+
+void MqttBrokerStub::detach(MqttTransportHost *client, bool publish_will) {
+    for (size_t i = 0; i < sessions_.size(); ++i) {
+        if (sessions_[i].client != client) {
+            continue;
+        }
+        const bool was_connected = sessions_[i].connected;
+        sessions_.erase(sessions_.begin() + static_cast<std::ptrdiff_t>(i));
+        if (publish_will && was_connected && online_ && !client->willTopic().empty()) {
+            if (client->willRetain()) {
+                retained_[client->willTopic()] = client->willPayload();
+            }
+            route(client->willTopic(), client->willPayload());
+        }
+        break;
+    }
+    for (size_t i = 0; i < pending_.size();) {
+        if (pending_[i].client == client) {
+            pending_.erase(pending_.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            ++i;
+        }
+    }
+}
+
+bool MqttBrokerStub::publish(MqttTransportHost *client,
+                             const char *topic,
+                             const uint8_t *payload,
+                             size_t length,
+                             bool retain) {
+    Session *session = findSession(client);
+    if (!session || !session->connected || !topic) {
+        return false;
+    }
+    stats_.publishes++;
+    std::string body;
+    if (payload && length > 0) {
+        body.assign(reinterpret_cast<const char *>(payload), length);
+    }
+    if (retain) {
+        if (body.empty()) {
+            retained_.erase(topic);
+        } else {
+            retained_[topic] = body;
+        }
+    }
+    route(topic, body);
+    return true;
+}
+
+bool MqttBrokerStub::subscribe(MqttTransportHost *client, const char *filter) {
+    Session *session = findSession(client);
+    if (!session || !session->connected || !filter) {
+        return false;
+    }
+    session->filters.push_back(filter);
+    for (const auto &entry : retained_) {
+        if (topicMatches(filter, entry.first.c_str())) {
+            stats_.deliveries++;
+            enqueue(client, MqttTransportEventType::Message, 0, entry.first, entry.second);
+        }
+    }
+    return true;
+}
+
+MqttBrokerStub::Session *MqttBrokerStub::findSession(MqttTransportHost *client) {
+    for (Session &session : sessions_) {
+        if (session.client == client) {
+            return &session;
+        }
+    }
+    return nullptr;
+}
+
+void MqttBrokerStub::enqueue(MqttTransportHost *client,
+                             MqttTransportEventType type,
+                             int error_rc,
+                             const std::string &topic,
+                             const std::string &payload) {
+    Pending item;
+    item.due_ms = millis() + latency_ms_;
+    item.client = client;
+    item.type = type;
+    item.error_rc = error_rc;
+    item.topic = topic;
+    item.payload = payload;
+    pending_.push_back(std::move(item));
+}
+
+void MqttBrokerStub::route(const std::string &topic, const std::string &payload) {
+    for (const Session &session : sessions_) {
+        if (!session.connected) {
+            continue;
+        }
+        for (const std::string &filter : session.filters) {
+            if (topicMatches(filter.c_str(), topic.c_str())) {
+                stats_.deliveries++;
+                enqueue(session.client, MqttTransportEventType::Message, 0, topic, payload);
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "modules/MqttTransport.h"
+
+class MqttTransportHost;
+
+// In-process stand-in for a broker. Everything runs on the mock millis() clock: each
+// connect, publish and subscribe queues its consequences `latency_ms` ahead, and pump()
+// delivers whatever is due in FIFO order.
+class MqttBrokerStub {
+public:
+    struct Stats {
+        uint32_t connect_attempts = 0;
+        uint32_t connects_accepted = 0;
+        uint32_t connects_rejected = 0;
+        uint32_t publishes = 0;
+        uint32_t deliveries = 0;
+    };
+
+    static constexpr int kOfflineErrorRc = -111; // negated ECONNREFUSED, as esp-mqtt reports it
+
+    void reset();
+    void setLatencyMs(uint32_t latency_ms) { latency_ms_ = latency_ms; }
+    // Going offline drops every live session; connects fail until it comes back.
+    void setOnline(bool online);
+    // Non-zero makes the broker answer CONNACK with this return code.
+    void setRefuseCode(int rc) { refuse_code_ = rc; }
+
+    size_t pump();
+    size_t pendingCount() const { return pending_.size(); }
+    size_t connectedCount() const;
+    const Stats &stats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+    bool retained(const char *topic, std::string &payload) const;
+
+    static bool topicMatches(const char *filter, const char *topic);
+
+    // Client side, called by MqttTransportHost only.
+    void connect(MqttTransportHost *client);
+    void disconnect(MqttTransportHost *client);
+    void detach(MqttTransportHost *client, bool publish_will);
+    bool publish(MqttTransportHost *client,
+                 const char *topic,
+                 const uint8_t *payload,
+                 size_t length,
+                 bool retain);
+    bool subscribe(MqttTransportHost *client, const char *filter);
+
+private:
+    struct Session {
+        MqttTransportHost *client = nullptr;
+        bool connected = false;
+        std::vector<std::string> filters;
+    };
+
+    struct Pending {
+        uint32_t due_ms = 0;
+        MqttTransportHost *client = nullptr;
+        MqttTransportEventType type = MqttTransportEventType::Error;
+        int error_rc = 0;
+        std::string topic;
+        std::string payload;
+    };
+
+    Session *findSession(MqttTransportHost *client);
+    void enqueue(MqttTransportHost *client, MqttTransportEventType type, int error_rc = 0,
+                 const std::string &topic = std::string(),
+                 const std::string &payload = std::string());
+    void route(const std::string &topic, const std::string &payload);
+
+    std::vector<Session> sessions_;
+    std::vector<Pending> pending_;
+    std::map<std::string, std::string> retained_;
+    Stats stats_;
+    uint32_t latency_ms_ = 0;
+    int refuse_code_ = 0;
+    bool online_ = true;
+};
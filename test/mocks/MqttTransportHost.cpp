@@ -0,0 +1,52 @@
+#include "MqttTransportHost.h"
+
+bool MqttTransportHost::start(const MqttTransportConfig &config,
+                              EventCallback callback,
+                              void *context) {
+    destroy();
+    callback_ = callback;
+    context_ = context;
+    client_id_ = config.client_id ? config.client_id : "";
+    will_topic_ = config.will_topic ? config.will_topic : "";
+    will_payload_ = config.will_payload ? config.will_payload : "";
+    will_retain_ = config.will_retain;
+    active_ = true;
+    start_count_++;
+    broker_.connect(this);
+    return true;
+}
+
+void MqttTransportHost::disconnect() {
+    if (active_) {
+        broker_.disconnect(this);
+    }
+}
+
+void MqttTransportHost::stop() {
+    if (active_) {
+        broker_.detach(this, true);
+    }
+}
+
+void MqttTransportHost::destroy() {
+    if (active_) {
+        broker_.detach(this, true);
+    }
+    active_ = false;
+    callback_ = nullptr;
+    context_ = nullptr;
+}
+
+bool MqttTransportHost::publish(const char *topic, const uint8_t *payload, size_t length, bool retain) {
+    return active_ && broker_.publish(this, topic, payload, length, retain);
+}
+
+bool MqttTransportHost::subscribe(const char *topic) {
+    return active_ && broker_.subscribe(this, topic);
+}
+
+void MqttTransportHost::deliver(const MqttTransportEvent &event) {
+    if (active_ && callback_) {
+        callback_(context_, event);
+    }
+}
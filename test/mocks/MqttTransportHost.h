@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+#include "MqttBrokerStub.h"
+#include "modules/MqttTransport.h"
+
+// MqttTransport backed by MqttBrokerStub; events arrive from MqttBrokerStub::pump().
+class MqttTransportHost final : public MqttTransport {
+public:
+    explicit MqttTransportHost(MqttBrokerStub &broker) : broker_(broker) {}
+    ~MqttTransportHost() override { destroy(); }
+
+    bool start(const MqttTransportConfig &config, EventCallback callback, void *context) override;
+    void disconnect() override;
+    void stop() override;
+    void destroy() override;
+    bool isActive() const override { return active_; }
+    bool publish(const char *topic, const uint8_t *payload, size_t length, bool retain) override;
+    bool subscribe(const char *topic) override;
+    const char *name() const override { return "host-stub"; }
+
+    const std::string &clientId() const { return client_id_; }
+    const std::string &willTopic() const { return will_topic_; }
+    const std::string &willPayload() const { return will_payload_; }
+    bool willRetain() const { return will_retain_; }
+    uint32_t startCount() const { return start_count_; }
+
+    void deliver(const MqttTransportEvent &event);
+
+private:
+    MqttBrokerStub &broker_;
+    EventCallback callback_ = nullptr;
+    void *context_ = nullptr;
+    std::string client_id_;
+    std::string will_topic_;
+    std::string will_payload_;
+    bool will_retain_ = false;
+    bool active_ = false;
+    uint32_t start_count_ = 0;
+};
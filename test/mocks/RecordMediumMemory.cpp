@@ -0,0 +1,70 @@
+#include "RecordMediumMemory.h"
+
+#include <string.h>
+
+bool RecordMediumMemory::open() {
+    rewriting_ = false;
+    rewrite_.clear();
+    return !fail_open_;
+}
+
+bool RecordMediumMemory::read(size_t offset, void *out, size_t len) {
+    if (offset > bytes_.size() || len > bytes_.size() - offset) {
+        return false;
+    }
+    if (len > 0) {
+        memcpy(out, bytes_.data() + offset, len);
+    }
+    return true;
+}
+
+bool RecordMediumMemory::append(const void *data, size_t len) {
+    std::vector<uint8_t> &target = rewriting_ ? rewrite_ : bytes_;
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    if (fail_armed_ && len > fail_after_) {
+        target.insert(target.end(), bytes, bytes + fail_after_);
+        fail_armed_ = false;
+        return false;
+    }
+    if (fail_armed_) {
+        fail_after_ -= len;
+    }
+    target.insert(target.end(), bytes, bytes + len);
+    return true;
+}
+
+bool RecordMediumMemory::sync() {
+    sync_count_++;
+    return true;
+}
+
+bool RecordMediumMemory::beginRewrite() {
+    rewrite_.clear();
+    rewriting_ = true;
+    return true;
+}
+
+bool RecordMediumMemory::commitRewrite() {
+    if (!rewriting_) {
+        return false;
+    }
+    bytes_.swap(rewrite_);
+    rewrite_.clear();
+    rewriting_ = false;
+    rewrite_count_++;
+    return true;
+}
+
+void RecordMediumMemory::abortRewrite() {
+    rewrite_.clear();
+    rewriting_ = false;
+}
+
+void RecordMediumMemory::failAfter(size_t bytes) {
+    fail_armed_ = true;
+    fail_after_ = bytes;
+}
+
+std::unique_ptr<RecordMedium> createDefaultRecordMedium() {
+    return std::unique_ptr<RecordMedium>(new RecordMediumMemory());
+}
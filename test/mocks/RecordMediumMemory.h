@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/RecordStore.h"
+
+// RecordMedium over a byte vector. The bytes outlive RecordStore::begin() calls, so a test can
+// "reboot" by mounting a fresh store on the same medium, and can inject torn or failed writes.
+class RecordMediumMemory final : public RecordMedium {
+public:
+    bool open() override;
+    size_t size() const override { return bytes_.size(); }
+    bool read(size_t offset, void *out, size_t len) override;
+    bool append(const void *data, size_t len) override;
+    bool sync() override;
+
+    bool beginRewrite() override;
+    bool commitRewrite() override;
+    void abortRewrite() override;
+
+    std::vector<uint8_t> &bytes() { return bytes_; }
+    // The next append stores only `bytes` more bytes and then fails, like a power cut mid-write.
+    void failAfter(size_t bytes);
+    void failOpen(bool fail) { fail_open_ = fail; }
+    uint32_t syncCount() const { return sync_count_; }
+    uint32_t rewriteCount() const { return rewrite_count_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    std::vector<uint8_t> rewrite_;
+    bool rewriting_ = false;
+    bool fail_armed_ = false;
+    size_t fail_after_ = 0;
+    bool fail_open_ = false;
+    uint32_t sync_count_ = 0;
+    uint32_t rewrite_count_ = 0;
+};
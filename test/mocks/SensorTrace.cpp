@@ -0,0 +1,196 @@
+#include "SensorTrace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+#include "I2cDeviceModels.h"
+
+namespace {
+
+bool parseEvent(const std::string &token, SensorTrace::Event &event) {
+    const size_t eq = token.find('=');
+    if (eq == std::string::npos || eq == 0 || eq + 1 >= token.size()) {
+        return false;
+    }
+    event.key = token.substr(0, eq);
+    const std::string value = token.substr(eq + 1);
+    char *end = nullptr;
+    event.value = std::strtof(value.c_str(), &end);
+    return end && *end == '\0';
+}
+
+} // namespace
+
+bool SensorTrace::load(const char *text, std::string *error) {
+    events_.clear();
+    next_ = 0;
+    skipped_ = 0;
+    if (!text) {
+        return true;
+    }
+
+    std::istringstream lines(text);
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(lines, line)) {
+        ++line_no;
+        const size_t hash = line.find('#');
+        if (hash != std::string::npos) {
+            line.erase(hash);
+        }
+        std::istringstream fields(line);
+        std::string time_field;
+        if (!(fields >> time_field)) {
+            continue;
+        }
+
+        Event event;
+        char *end = nullptr;
+        const unsigned long t_ms = std::strtoul(time_field.c_str(), &end, 10);
+        std::string token;
+        bool ok = end && *end == '\0' && static_cast<bool>(fields >> event.device);
+        size_t pairs = 0;
+        while (ok && fields >> token) {
+            event.t_ms = static_cast<uint32_t>(t_ms);
+            ok = parseEvent(token, event);
+            if (ok) {
+                events_.push_back(event);
+                ++pairs;
+            }
+        }
+        if (!ok || pairs == 0) {
+            if (error) {
+                *error = "line " + std::to_string(line_no) + ": " + line;
+            }
+            events_.clear();
+            return false;
+        }
+    }
+    // Recorded logs are usually ordered already; keep same-time events in file order.
+    std::stable_sort(events_.begin(), events_.end(), [](const Event &a, const Event &b) {
+        return a.t_ms < b.t_ms;
+    });
+    return true;
+}
+
+void SensorTrace::bind(const char *device, I2cModels::Model *model) {
+    for (Binding &binding : bindings_) {
+        if (binding.device == device) {
+            binding.model = model;
+            return;
+        }
+    }
+    bindings_.push_back(Binding{device, model});
+}
+
+void SensorTrace::start(uint32_t now_ms) {
+    start_ms_ = now_ms;
+    next_ = 0;
+    skipped_ = 0;
+}
+
+size_t SensorTrace::applyDue(uint32_t now_ms) {
+    const uint32_t offset = now_ms - start_ms_;
+    size_t applied = 0;
+    while (next_ < events_.size() && events_[next_].t_ms <= offset) {
+        if (apply(events_[next_])) {
+            ++applied;
+        } else {
+            ++skipped_;
+        }
+        ++next_;
+    }
+    return applied;
+}
+
+I2cModels::Model *SensorTrace::find(const std::string &device) const {
+    for (const Binding &binding : bindings_) {
+        if (binding.device == device) {
+            return binding.model;
+        }
+    }
+    return nullptr;
+}
+
+bool SensorTrace::apply(const Event &event) {
+    using namespace I2cModels;
+
+    Model *model = find(event.device);
+    if (!model) {
+        return false;
+    }
+    const std::string &key = event.key;
+    const float value = event.value;
+    const uint32_t count = value > 0.0f ? static_cast<uint32_t>(value) : 0;
+    if (key == "nack") {
+        model->injectNack(count);
+        return true;
+    }
+    if (key == "timeout") {
+        model->injectTimeout(count);
+        return true;
+    }
+    if (key == "corrupt") {
+        model->injectCorruption(count);
+        return true;
+    }
+    if (key == "present") {
+        model->setPresent(value != 0.0f);
+        return true;
+    }
+
+    if (auto *sen66 = dynamic_cast<Sen66Model *>(model)) {
+        Sen66Model::Values &values = sen66->values();
+        float *field = nullptr;
+        if (key == "pm1") field = &values.pm1;
+        else if (key == "pm25") field = &values.pm25;
+        else if (key == "pm4") field = &values.pm4;
+        else if (key == "pm10") field = &values.pm10;
+        else if (key == "pm05") field = &values.pm05;
+        else if (key == "rh") field = &values.humidity;
+        else if (key == "t") field = &values.temperature;
+        else if (key == "voc") field = &values.voc;
+        else if (key == "nox") field = &values.nox;
+        else if (key == "co2") field = &values.co2;
+        if (!field) {
+            return false;
+        }
+        *field = value;
+        return true;
+    }
+    if (key == "hcho") {
+        if (auto *sfa40 = dynamic_cast<Sfa40Model *>(model)) {
+            sfa40->setHchoPpb(value);
+            return true;
+        }
+        if (auto *sfa30 = dynamic_cast<Sfa30Model *>(model)) {
+            sfa30->setHchoPpb(value);
+            return true;
+        }
+        return false;
+    }
+    if (key == "ppm") {
+        if (auto *gas = dynamic_cast<DfrGasModel *>(model)) {
+            gas->setConcentration(value);
+            return true;
+        }
+        return false;
+    }
+    if (key == "pressure" || key == "t") {
+        const bool pressure = key == "pressure";
+        if (auto *bmp580 = dynamic_cast<Bmp580Model *>(model)) {
+            pressure ? bmp580->setPressureHpa(value) : bmp580->setTemperature(value);
+            return true;
+        }
+        if (auto *bmp3xx = dynamic_cast<Bmp3xxModel *>(model)) {
+            pressure ? bmp3xx->setPressureHpa(value) : bmp3xx->setTemperature(value);
+            return true;
+        }
+        if (auto *dps310 = dynamic_cast<Dps310Model *>(model)) {
+            pressure ? dps310->setPressureHpa(value) : dps310->setTemperature(value);
+            return true;
+        }
+    }
+    return false;
+}
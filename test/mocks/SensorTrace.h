@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace I2cModels {
+class Model;
+}
+
+// Replays recorded field data onto bound device models as the mock clock advances.
+// One event per line, times relative to start():
+//
+//   # comment
+//   <t_ms> <device> <key>=<value> [<key>=<value> ...]
+//
+// Measurement keys: pm1 pm25 pm4 pm10 pm05 rh t voc nox co2 (sen66), hcho (sfa30/sfa40),
+// ppm (DFR gas boards), pressure t (bmp580/bmp3xx/dps310). "nan" marks an invalid reading.
+// Fault keys on any device: nack=N timeout=N corrupt=N present=0|1.
+class SensorTrace {
+public:
+    struct Event {
+        uint32_t t_ms = 0;
+        std::string device;
+        std::string key;
+        float value = 0.0f;
+    };
+
+    // Replaces any loaded trace. On failure error names the offending line.
+    bool load(const char *text, std::string *error = nullptr);
+    void bind(const char *device, I2cModels::Model *model);
+
+    void start(uint32_t now_ms);
+    // Applies every event due at now_ms; returns how many were applied.
+    size_t applyDue(uint32_t now_ms);
+    bool finished() const { return next_ >= events_.size(); }
+    uint32_t durationMs() const { return events_.empty() ? 0 : events_.back().t_ms; }
+    size_t eventCount() const { return events_.size(); }
+    // Events whose device was never bound or whose key the bound model does not take.
+    size_t skipped() const { return skipped_; }
+
+private:
+    struct Binding {
+        std::string device;
+        I2cModels::Model *model = nullptr;
+    };
+
+    bool apply(const Event &event);
+    I2cModels::Model *find(const std::string &device) const;
+
+    std::vector<Event> events_;
+    std::vector<Binding> bindings_;
+    size_t next_ = 0;
+    size_t skipped_ = 0;
+    uint32_t start_ms_ = 0;
+};
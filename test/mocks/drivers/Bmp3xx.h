@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Arduino.h"
+#include "core/SensorHealth.h"
 
 struct Bmp3xxTestState {
     bool ok = true;
@@ -11,6 +12,8 @@ struct Bmp3xxTestState {
     float pressure = 0.0f;
     float temperature = 0.0f;
     uint32_t last_data_ms = 0;
+    uint32_t poll_interval_ms = 0;
+    SensorHealth health{0, 0, 0};
 };
 
 class Bmp3xx {
@@ -34,6 +37,7 @@ public:
     bool begin() { return true; }
     bool start() { return state().start_ok; }
     void poll() {}
+    void setPollIntervalMs(uint32_t interval_ms) { state().poll_interval_ms = interval_ms; }
     bool takeNewData(float &pressure_hpa, float &temperature_c) {
         if (!state().has_new_data) {
             return false;
@@ -48,6 +52,7 @@ public:
     bool isOk() const { return state().ok; }
     bool isPressureValid() const { return state().pressure_valid; }
     uint32_t lastDataMs() const { return state().last_data_ms; }
+    const SensorHealth &health() const { return state().health; }
     Variant variant() const { return variant_state(); }
     const char *variantLabel() const {
         switch (variant_state()) {
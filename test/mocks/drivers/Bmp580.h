@@ -5,6 +5,7 @@
 #else
 
 #include "Arduino.h"
+#include "core/SensorHealth.h"
 
 struct Bmp580TestState {
     bool ok = true;
@@ -15,6 +16,8 @@ struct Bmp580TestState {
     float pressure = 0.0f;
     float temperature = 0.0f;
     uint32_t last_data_ms = 0;
+    uint32_t poll_interval_ms = 0;
+    SensorHealth health{0, 0, 0};
 };
 
 class Bmp580 {
@@ -33,6 +36,7 @@ public:
     bool begin() { return true; }
     bool start() { return state().start_ok; }
     void poll() {}
+    void setPollIntervalMs(uint32_t interval_ms) { state().poll_interval_ms = interval_ms; }
     bool takeNewData(float &pressure_hpa, float &temperature_c) {
         if (!state().has_new_data) {
             return false;
@@ -47,6 +51,7 @@ public:
     bool isOk() const { return state().ok; }
     bool isPressureValid() const { return state().pressure_valid; }
     uint32_t lastDataMs() const { return state().last_data_ms; }
+    const SensorHealth &health() const { return state().health; }
     Variant variant() const { return variant_state(); }
     const char *variantLabel() const {
         switch (variant_state()) {
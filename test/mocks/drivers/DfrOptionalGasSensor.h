@@ -21,6 +21,7 @@ struct DfrOptionalGasSensorTestState {
     float ppm = 0.0f;
     uint32_t last_data_ms = 0;
     OptionalGasType gas_type = OptionalGasType::None;
+    uint32_t poll_interval_ms = 0;
 };
 
 class DfrOptionalGasSensor {
@@ -40,6 +41,7 @@ public:
         return state().start_ok;
     }
     void poll() {}
+    void setPollIntervalMs(uint32_t interval_ms) { state().poll_interval_ms = interval_ms; }
     bool isPresent() const { return state().present; }
     bool isDataValid() const { return state().data_valid; }
     bool isWarmupActive() const { return state().warmup; }
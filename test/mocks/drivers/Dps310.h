@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Arduino.h"
+#include "core/SensorHealth.h"
 
 struct Dps310TestState {
     bool ok = true;
@@ -11,6 +12,8 @@ struct Dps310TestState {
     float pressure = 0.0f;
     float temperature = 0.0f;
     uint32_t last_data_ms = 0;
+    uint32_t poll_interval_ms = 0;
+    SensorHealth health{0, 0, 0};
 };
 
 class Dps310 {
@@ -23,6 +26,7 @@ public:
     bool begin() { return true; }
     bool start() { return state().start_ok; }
     void poll() {}
+    void setPollIntervalMs(uint32_t interval_ms) { state().poll_interval_ms = interval_ms; }
     bool takeNewData(float &pressure_hpa, float &temperature_c) {
         if (!state().has_new_data) {
             return false;
@@ -37,6 +41,7 @@ public:
     bool isOk() const { return state().ok; }
     bool isPressureValid() const { return state().pressure_valid; }
     uint32_t lastDataMs() const { return state().last_data_ms; }
+    const SensorHealth &health() const { return state().health; }
     void invalidate() {
         state().pressure_valid = false;
         state().has_new_data = false;
@@ -11,6 +11,7 @@ struct Sen0466TestState {
     bool invalidate_called = false;
     float co_ppm = 0.0f;
     uint32_t last_data_ms = 0;
+    uint32_t poll_interval_ms = 0;
 };
 
 class Sen0466 {
@@ -32,6 +33,7 @@ public:
         return state().start_ok;
     }
     void poll() {}
+    void setPollIntervalMs(uint32_t interval_ms) { state().poll_interval_ms = interval_ms; }
     bool isPresent() const { return state().present; }
     bool isDataValid() const { return state().data_valid; }
     bool isWarmupActive() const { return state().warmup; }
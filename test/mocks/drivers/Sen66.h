@@ -13,6 +13,7 @@ struct Sen66TestState {
     bool update_last_data_on_poll = false;
     bool start_ok = true;
     bool start_called = false;
+    uint8_t start_result = 0;
     bool update_pressure_called = false;
     bool clear_voc_called = false;
     bool load_voc_called = false;
@@ -23,6 +24,7 @@ struct Sen66TestState {
     uint32_t retry_at_ms = 0;
     float last_pressure = 0.0f;
     SensorData poll_data;
+    uint32_t poll_interval_ms = 0;
 };
 
 class Sen66 {
@@ -40,13 +42,27 @@ public:
     void scheduleRetry(uint32_t delay_ms) { state().retry_at_ms = millis() + delay_ms; }
     uint32_t retryAtMs() const { return state().retry_at_ms; }
 
-    bool start(bool asc_enabled) {
+    enum class StartResult : uint8_t {
+        None = 0,
+        Started,
+        Failed,
+    };
+
+    bool beginStart(bool asc_enabled) {
         state().start_called = true;
         state().asc_enabled = asc_enabled;
         state().ok = state().start_ok;
-        return state().start_ok;
+        state().start_result =
+            static_cast<uint8_t>(state().start_ok ? StartResult::Started : StartResult::Failed);
+        return true;
+    }
+    StartResult takeStartResult() {
+        const StartResult result = static_cast<StartResult>(state().start_result);
+        state().start_result = 0;
+        return result;
     }
     bool stop() { return true; }
+    void setPollIntervalMs(uint32_t interval_ms) { state().poll_interval_ms = interval_ms; }
     void poll(SensorData &data, bool &changed) {
         changed = state().poll_changed;
         if (state().provide_data) {
@@ -19,6 +19,7 @@ struct Sfa30TestState {
     bool warmup_active = false;
     float hcho_ppb = 0.0f;
     uint32_t last_data_ms = 0;
+    uint32_t poll_interval_ms = 0;
 };
 
 class Sfa30 {
@@ -39,6 +40,7 @@ public:
     void stop() {}
     bool readData(float &) { return false; }
     void poll() {}
+    void setPollIntervalMs(uint32_t interval_ms) { state().poll_interval_ms = interval_ms; }
     bool isDataValid() const { return state().data_valid; }
     bool isOk() const { return state().status == Status::Ok; }
     bool isPresent() const { return state().status != Status::Absent; }
@@ -18,6 +18,7 @@ struct Sfa40TestState {
     bool start_called = false;
     float hcho_ppb = 0.0f;
     uint32_t last_data_ms = 0;
+    uint32_t poll_interval_ms = 0;
 };
 
 class Sfa40 {
@@ -47,6 +48,7 @@ public:
         return SelfTestStatus::Idle;
     }
     void poll() {}
+    void setPollIntervalMs(uint32_t interval_ms) { state().poll_interval_ms = interval_ms; }
     bool isDataValid() const { return state().data_valid; }
     bool isOk() const { return state().status == Status::Ok; }
     bool isPresent() const { return state().status != Status::Absent; }
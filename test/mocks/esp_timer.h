@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstdint>
+
+// Backed by the ArduinoMock clock: millis() * 1000 plus the advanceMicros() remainder.
+int64_t esp_timer_get_time();
@@ -7,6 +7,7 @@ mocks_path = os.path.join(project_dir, "test", "mocks")
 prefer_real_headers = env["PIOENV"] == "native_test_sfa40_driver"
 prefer_real_headers = prefer_real_headers or env["PIOENV"] == "native_test_sfa30_driver"
 prefer_real_headers = prefer_real_headers or env["PIOENV"] == "native_test_dfr_optional_gas_driver"
+prefer_real_headers = prefer_real_headers or env["PIOENV"] == "native_sensor_bench"
 
 # Most native tests rely on mock headers shadowing src/, but the dedicated
 # SFA40 driver test needs the real driver headers while still seeing shared
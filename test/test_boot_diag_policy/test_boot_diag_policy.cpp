@@ -36,6 +36,22 @@ void test_auto_advance_runs_only_after_timeout_without_blocks() {
     TEST_ASSERT_TRUE(BootDiagPolicy::shouldAutoAdvance(false, false, 3000, 3000));
 }
 
+void test_logo_hands_over_to_diagnostics() {
+    using BootDiagPolicy::Stage;
+    TEST_ASSERT_TRUE(Stage::Logo == BootDiagPolicy::nextStage(Stage::Logo, 1999, 2000, false, false, 3000));
+    TEST_ASSERT_TRUE(Stage::Diag == BootDiagPolicy::nextStage(Stage::Logo, 2000, 2000, false, false, 3000));
+    // Errors or a pending sensor only hold the diagnostics screen, never skip it.
+    TEST_ASSERT_TRUE(Stage::Diag == BootDiagPolicy::nextStage(Stage::Logo, 2000, 2000, true, true, 3000));
+}
+
+void test_diagnostics_hand_over_to_main_when_clear() {
+    using BootDiagPolicy::Stage;
+    TEST_ASSERT_TRUE(Stage::Diag == BootDiagPolicy::nextStage(Stage::Diag, 2999, 2000, false, false, 3000));
+    TEST_ASSERT_TRUE(Stage::Diag == BootDiagPolicy::nextStage(Stage::Diag, 9000, 2000, false, true, 3000));
+    TEST_ASSERT_TRUE(Stage::Diag == BootDiagPolicy::nextStage(Stage::Diag, 9000, 2000, true, false, 3000));
+    TEST_ASSERT_TRUE(Stage::Main == BootDiagPolicy::nextStage(Stage::Diag, 3000, 2000, false, false, 3000));
+}
+
 int main(int, char **) {
     UNITY_BEGIN();
     RUN_TEST(test_sen66_pending_during_retry_window);
@@ -45,5 +61,7 @@ int main(int, char **) {
     RUN_TEST(test_auto_advance_blocks_while_sensor_pending);
     RUN_TEST(test_auto_advance_blocks_on_errors);
     RUN_TEST(test_auto_advance_runs_only_after_timeout_without_blocks);
+    RUN_TEST(test_logo_hands_over_to_diagnostics);
+    RUN_TEST(test_diagnostics_hand_over_to_main_when_clear);
     return UNITY_END();
 }
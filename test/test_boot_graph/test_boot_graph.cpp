@@ -0,0 +1,188 @@
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "ArduinoMock.h"
+#include "core/BootGraph.h"
+#include "core/BootProfiler.h"
+
+namespace {
+
+struct Recorder {
+    std::mutex mutex;
+    std::vector<int> order;
+    std::thread::id main_thread;
+    std::thread::id aux_thread;
+
+    void note(int step) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(step);
+    }
+    size_t position(int step) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (order[i] == step) {
+                return i;
+            }
+        }
+        return order.size();
+    }
+};
+
+struct Step {
+    Recorder *recorder;
+    int id;
+    bool aux;
+};
+
+void record_step(void *arg) {
+    Step *step = static_cast<Step *>(arg);
+    if (step->aux) {
+        step->recorder->aux_thread = std::this_thread::get_id();
+    }
+    // Long enough for the other lane to get ahead if nothing held it back.
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    step->recorder->note(step->id);
+}
+
+struct Rendezvous {
+    std::atomic<bool> main_started{false};
+    std::atomic<bool> aux_saw_main{false};
+};
+
+void main_side(void *arg) {
+    static_cast<Rendezvous *>(arg)->main_started.store(true);
+}
+
+void aux_side(void *arg) {
+    Rendezvous *rendezvous = static_cast<Rendezvous *>(arg);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!rendezvous->main_started.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    rendezvous->aux_saw_main.store(rendezvous->main_started.load());
+}
+
+void nested_stage(void *) {
+    BootProfiler::Scope inner("inner");
+}
+
+} // namespace
+
+void setUp() {
+    setMillis(0);
+    BootProfiler::instance().reset();
+}
+
+void tearDown() {}
+
+void test_nodes_wait_for_dependencies_across_lanes() {
+    Recorder recorder;
+    recorder.main_thread = std::this_thread::get_id();
+    Step storage{&recorder, 0, true};
+    Step i2c{&recorder, 1, false};
+    Step board{&recorder, 2, false};
+    Step histories{&recorder, 3, true};
+    Step sensors{&recorder, 4, true};
+    Step ui{&recorder, 5, false};
+
+    BootGraph graph;
+    const uint8_t s = graph.add("storage", BootGraph::Lane::Aux, 0, record_step, &storage);
+    const uint8_t i = graph.add("i2c", BootGraph::Lane::Main, 0, record_step, &i2c);
+    const uint8_t b = graph.add("board", BootGraph::Lane::Main, BootGraph::bit(i), record_step, &board);
+    const uint8_t h = graph.add("histories", BootGraph::Lane::Aux, BootGraph::bit(s), record_step,
+                                &histories);
+    const uint8_t n = graph.add("sensors", BootGraph::Lane::Aux, BootGraph::bit(b), record_step,
+                                &sensors);
+    graph.add("ui", BootGraph::Lane::Main, BootGraph::bit(b) | BootGraph::bit(s), record_step, &ui);
+    TEST_ASSERT_NOT_EQUAL(BootGraph::kInvalid, h);
+    TEST_ASSERT_NOT_EQUAL(BootGraph::kInvalid, n);
+
+    TEST_ASSERT_TRUE(graph.run());
+    TEST_ASSERT_EQUAL_UINT32(6, recorder.order.size());
+    TEST_ASSERT_TRUE(recorder.position(0) < recorder.position(3));
+    TEST_ASSERT_TRUE(recorder.position(1) < recorder.position(2));
+    TEST_ASSERT_TRUE(recorder.position(2) < recorder.position(4));
+    TEST_ASSERT_TRUE(recorder.position(3) < recorder.position(4));
+    TEST_ASSERT_TRUE(recorder.position(2) < recorder.position(5));
+    TEST_ASSERT_TRUE(recorder.position(0) < recorder.position(5));
+    TEST_ASSERT_TRUE(recorder.aux_thread != recorder.main_thread);
+}
+
+void test_lanes_run_concurrently() {
+    Rendezvous rendezvous;
+    BootGraph graph;
+    graph.add("aux", BootGraph::Lane::Aux, 0, aux_side, &rendezvous);
+    graph.add("main", BootGraph::Lane::Main, 0, main_side, &rendezvous);
+    TEST_ASSERT_TRUE(graph.run());
+    TEST_ASSERT_TRUE(rendezvous.aux_saw_main.load());
+}
+
+void test_later_dependencies_and_overflow_are_rejected() {
+    Recorder recorder;
+    Step step{&recorder, 0, false};
+    BootGraph graph;
+    TEST_ASSERT_EQUAL_UINT8(BootGraph::kInvalid,
+                            graph.add("self", BootGraph::Lane::Main, BootGraph::bit(0), record_step, &step));
+    TEST_ASSERT_EQUAL_UINT8(BootGraph::kInvalid,
+                            graph.add("null", BootGraph::Lane::Main, 0, nullptr, nullptr));
+    for (size_t i = 0; i < BootGraph::kMaxNodes; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(i, graph.add("n", BootGraph::Lane::Main, 0, record_step, &step));
+    }
+    TEST_ASSERT_EQUAL_UINT8(BootGraph::kInvalid,
+                            graph.add("extra", BootGraph::Lane::Main, 0, record_step, &step));
+    TEST_ASSERT_EQUAL_UINT32(0, BootGraph::bit(BootGraph::kInvalid));
+}
+
+void test_aux_lane_falls_back_to_insertion_order() {
+    Recorder recorder;
+    recorder.main_thread = std::this_thread::get_id();
+    Step first{&recorder, 0, true};
+    Step second{&recorder, 1, false};
+    Step third{&recorder, 2, true};
+
+    BootGraph graph;
+    graph.add("first", BootGraph::Lane::Aux, 0, record_step, &first);
+    graph.add("second", BootGraph::Lane::Main, 0, record_step, &second);
+    graph.add("third", BootGraph::Lane::Aux, BootGraph::bit(1), record_step, &third);
+    graph.failAuxStartForTest();
+
+    TEST_ASSERT_FALSE(graph.run());
+    TEST_ASSERT_EQUAL_UINT32(3, recorder.order.size());
+    TEST_ASSERT_EQUAL_INT(0, recorder.order[0]);
+    TEST_ASSERT_EQUAL_INT(1, recorder.order[1]);
+    TEST_ASSERT_EQUAL_INT(2, recorder.order[2]);
+    TEST_ASSERT_TRUE(recorder.aux_thread == recorder.main_thread);
+}
+
+void test_each_lane_nests_its_own_stages() {
+    BootGraph graph;
+    graph.add("aux_node", BootGraph::Lane::Aux, 0, nested_stage, nullptr);
+    graph.add("main_node", BootGraph::Lane::Main, 0, nested_stage, nullptr);
+    TEST_ASSERT_TRUE(graph.run());
+
+    BootProfiler::Trace trace;
+    BootProfiler::instance().current(trace);
+    TEST_ASSERT_EQUAL_UINT8(4, trace.stage_count);
+    for (size_t i = 0; i < trace.stage_count; ++i) {
+        const BootProfiler::Stage &stage = trace.stages[i];
+        const bool node = strcmp(stage.name, "inner") != 0;
+        TEST_ASSERT_EQUAL_UINT8(node ? 0 : 1, stage.depth);
+        TEST_ASSERT_TRUE(stage.duration_us > 0);
+    }
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_nodes_wait_for_dependencies_across_lanes);
+    RUN_TEST(test_lanes_run_concurrently);
+    RUN_TEST(test_later_dependencies_and_overflow_are_rejected);
+    RUN_TEST(test_aux_lane_falls_back_to_insertion_order);
+    RUN_TEST(test_each_lane_nests_its_own_stages);
+    return UNITY_END();
+}
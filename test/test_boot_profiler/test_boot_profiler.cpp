@@ -0,0 +1,209 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include "ArduinoMock.h"
+#include "core/BootProfiler.h"
+
+namespace {
+
+void run_boot(uint32_t boot_count, uint32_t stage_us) {
+    BootProfiler &profiler = BootProfiler::instance();
+    {
+        BootProfiler::Scope stage("storage");
+        advanceMicros(stage_us);
+    }
+    profiler.finish(boot_count, 1);
+}
+
+} // namespace
+
+void setUp() {
+    setMillis(0);
+    BootProfiler::instance().reset();
+}
+
+void tearDown() {}
+
+void test_nested_stages_record_depth_and_duration() {
+    BootProfiler &profiler = BootProfiler::instance();
+    setMillis(100);
+    {
+        BootProfiler::Scope outer("peripherals");
+        advanceMicros(250);
+        {
+            BootProfiler::Scope inner("sensors");
+            advanceMicros(1500);
+        }
+        const uint8_t rtc = profiler.begin("rtc");
+        advanceMicros(40);
+        profiler.end(rtc);
+    }
+    profiler.finish(7, 3);
+
+    BootProfiler::Trace trace;
+    profiler.current(trace);
+    TEST_ASSERT_TRUE(trace.complete);
+    TEST_ASSERT_EQUAL_UINT32(7, trace.boot_count);
+    TEST_ASSERT_EQUAL_UINT8(3, trace.reset_reason);
+    TEST_ASSERT_EQUAL_UINT32(101790, trace.total_us);
+    TEST_ASSERT_EQUAL_UINT8(3, trace.stage_count);
+
+    TEST_ASSERT_EQUAL_STRING("peripherals", trace.stages[0].name);
+    TEST_ASSERT_EQUAL_UINT8(0, trace.stages[0].depth);
+    TEST_ASSERT_EQUAL_UINT32(100000, trace.stages[0].start_us);
+    TEST_ASSERT_EQUAL_UINT32(1790, trace.stages[0].duration_us);
+    TEST_ASSERT_EQUAL_STRING("sensors", trace.stages[1].name);
+    TEST_ASSERT_EQUAL_UINT8(1, trace.stages[1].depth);
+    TEST_ASSERT_EQUAL_UINT32(1500, trace.stages[1].duration_us);
+    TEST_ASSERT_EQUAL_STRING("rtc", trace.stages[2].name);
+    TEST_ASSERT_EQUAL_UINT8(1, trace.stages[2].depth);
+    TEST_ASSERT_EQUAL_UINT32(40, trace.stages[2].duration_us);
+}
+
+void test_long_names_are_truncated_and_instant_stages_read_closed() {
+    BootProfiler &profiler = BootProfiler::instance();
+    profiler.end(profiler.begin("a_very_long_stage_name"));
+
+    BootProfiler::Trace trace;
+    profiler.current(trace);
+    TEST_ASSERT_EQUAL_UINT32(BootProfiler::kNameLength - 1, strlen(trace.stages[0].name));
+    TEST_ASSERT_EQUAL_UINT32(1, trace.stages[0].duration_us);
+}
+
+void test_full_or_finished_trace_takes_no_more_stages() {
+    BootProfiler &profiler = BootProfiler::instance();
+    for (size_t i = 0; i < BootProfiler::kMaxStages; ++i) {
+        profiler.end(profiler.begin("stage"));
+    }
+    TEST_ASSERT_EQUAL_UINT8(BootProfiler::kNoStage, profiler.begin("overflow"));
+    profiler.end(BootProfiler::kNoStage);
+    profiler.finish(1, 1);
+    TEST_ASSERT_EQUAL_UINT8(BootProfiler::kNoStage, profiler.begin("late"));
+
+    BootProfiler::Trace trace;
+    profiler.current(trace);
+    TEST_ASSERT_EQUAL_UINT8(BootProfiler::kMaxStages, trace.stage_count);
+    TEST_ASSERT_EQUAL_UINT8(1, trace.dropped_stages);
+}
+
+void test_history_keeps_the_most_recent_boots() {
+    BootProfiler &profiler = BootProfiler::instance();
+    BootProfiler::HistoryBlob blob;
+    // Each boot restores what the previous one saved, then saves its own trace first.
+    for (uint32_t boot = 1; boot <= BootProfiler::kHistoryDepth + 2; ++boot) {
+        profiler.reset();
+        if (boot > 1) {
+            TEST_ASSERT_TRUE(profiler.restore(blob));
+        }
+        setMillis(0);
+        run_boot(boot, boot * 1000);
+        profiler.fill(blob);
+    }
+    TEST_ASSERT_EQUAL_UINT16(BootProfiler::kHistoryDepth, blob.count);
+    TEST_ASSERT_EQUAL_UINT32(BootProfiler::kHistoryDepth - 1, profiler.previousCount());
+
+    BootProfiler::Trace trace;
+    TEST_ASSERT_TRUE(profiler.previous(0, trace));
+    TEST_ASSERT_EQUAL_UINT32(BootProfiler::kHistoryDepth + 1, trace.boot_count);
+    TEST_ASSERT_EQUAL_UINT32((BootProfiler::kHistoryDepth + 1) * 1000, trace.stages[0].duration_us);
+    TEST_ASSERT_TRUE(profiler.previous(BootProfiler::kHistoryDepth - 2, trace));
+    TEST_ASSERT_EQUAL_UINT32(3, trace.boot_count);
+    TEST_ASSERT_FALSE(profiler.previous(BootProfiler::kHistoryDepth - 1, trace));
+
+    BootProfiler::Summary summary;
+    profiler.summary(summary);
+    TEST_ASSERT_TRUE(summary.finished);
+    TEST_ASSERT_EQUAL_UINT32((BootProfiler::kHistoryDepth + 2) * 1000, summary.total_us);
+    TEST_ASSERT_TRUE(summary.has_previous);
+    TEST_ASSERT_EQUAL_UINT32((BootProfiler::kHistoryDepth + 1) * 1000, summary.previous_total_us);
+}
+
+void test_unfinished_trace_is_not_persisted() {
+    BootProfiler &profiler = BootProfiler::instance();
+    profiler.end(profiler.begin("storage"));
+    BootProfiler::HistoryBlob blob;
+    profiler.fill(blob);
+    TEST_ASSERT_EQUAL_UINT16(0, blob.count);
+}
+
+void test_foreign_blob_is_rejected() {
+    BootProfiler &profiler = BootProfiler::instance();
+    run_boot(1, 10);
+    BootProfiler::HistoryBlob blob;
+    profiler.fill(blob);
+
+    BootProfiler::HistoryBlob bad = blob;
+    bad.magic ^= 1;
+    TEST_ASSERT_FALSE(profiler.restore(bad));
+    bad = blob;
+    bad.version++;
+    TEST_ASSERT_FALSE(profiler.restore(bad));
+    bad = blob;
+    bad.count = BootProfiler::kHistoryDepth + 1;
+    TEST_ASSERT_FALSE(profiler.restore(bad));
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.previousCount());
+
+    // A torn trace inside an otherwise valid blob is skipped on its own.
+    bad = blob;
+    bad.traces[0].stage_count = BootProfiler::kMaxStages + 1;
+    TEST_ASSERT_TRUE(profiler.restore(bad));
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.previousCount());
+    TEST_ASSERT_TRUE(profiler.restore(blob));
+    TEST_ASSERT_EQUAL_UINT32(1, profiler.previousCount());
+}
+
+void test_milestones_are_recorded_once_and_persisted() {
+    BootProfiler &profiler = BootProfiler::instance();
+    setMillis(50);
+    profiler.noteFrame(); // not armed yet: the empty default screen
+    run_boot(2, 100);
+    const uint32_t finished_revision = profiler.revision();
+
+    profiler.armFirstFrame();
+    setMillis(120);
+    profiler.noteFrame();
+    setMillis(130);
+    profiler.noteFrame();
+    setMillis(900);
+    profiler.noteFirstReading();
+    setMillis(950);
+    profiler.noteFirstReading();
+    TEST_ASSERT_NOT_EQUAL(finished_revision, profiler.revision());
+
+    BootProfiler::Trace trace;
+    profiler.current(trace);
+    TEST_ASSERT_EQUAL_UINT32(120000, trace.first_frame_us);
+    TEST_ASSERT_EQUAL_UINT32(900000, trace.first_reading_us);
+
+    // Arming again after the first frame does not move it.
+    const uint32_t revision = profiler.revision();
+    profiler.armFirstFrame();
+    setMillis(2000);
+    profiler.noteFrame();
+    TEST_ASSERT_EQUAL_UINT32(revision, profiler.revision());
+
+    BootProfiler::HistoryBlob blob;
+    profiler.fill(blob);
+    TEST_ASSERT_EQUAL_UINT32(120000, blob.traces[0].first_frame_us);
+    TEST_ASSERT_EQUAL_UINT32(900000, blob.traces[0].first_reading_us);
+    profiler.reset();
+    TEST_ASSERT_TRUE(profiler.restore(blob));
+    TEST_ASSERT_TRUE(profiler.previous(0, trace));
+    TEST_ASSERT_EQUAL_UINT32(900000, trace.first_reading_us);
+    profiler.current(trace);
+    TEST_ASSERT_EQUAL_UINT32(0, trace.first_frame_us);
+    TEST_ASSERT_EQUAL_UINT32(0, trace.first_reading_us);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_nested_stages_record_depth_and_duration);
+    RUN_TEST(test_long_names_are_truncated_and_instant_stages_read_closed);
+    RUN_TEST(test_full_or_finished_trace_takes_no_more_stages);
+    RUN_TEST(test_history_keeps_the_most_recent_boots);
+    RUN_TEST(test_unfinished_trace_is_not_persisted);
+    RUN_TEST(test_foreign_blob_is_rejected);
+    RUN_TEST(test_milestones_are_recorded_once_and_persisted);
+    return UNITY_END();
+}
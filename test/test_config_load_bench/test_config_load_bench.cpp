@@ -0,0 +1,103 @@
+#include <unity.h>
+
+#include <ArduinoJson.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "config/AppConfig.h"
+#include "core/ConfigSnapshot.h"
+
+// Boot-time config load: the binary snapshot StorageManager reads now against parsing the JSON
+// document it used to read. The JSON side only counts deserialization, not the field-by-field
+// copy into StoredConfig, so it is a lower bound on what the old path cost.
+
+namespace {
+
+constexpr int kIterations = 2000;
+
+// Same shape and sizes as the document StorageManager writes for the last-known-good copy.
+const char kConfigJson[] = R"({"wifi":{"enabled":true,"ssid":"Workshop","pass":"correct horse battery staple"},)"
+    R"("mqtt":{"host":"broker.lan","port":1883,"user":"sensor","pass":"secret","base":"home/aura",)"
+    R"("name":"Aura Living Room","enabled":true,"discovery":true,"anonymous":false,"state_encoding":0},)"
+    R"("ui":{"temp_offset":-1.25,"hum_offset":3.5,"units_c":true,"units_mdy":false,"night_mode":false,)"
+    R"("header_status_enabled":true,"led_indicators":true,"alert_blink":true,"asc_enabled":true,)"
+    R"("pressure_altitude_set":true,"pressure_altitude_m":120,"display_name":"Living room","lang":6},)"
+    R"("backlight":{"timeout_s":300,"schedule_enabled":true,"alarm_wake":true,"sleep_hour":23,)"
+    R"("sleep_minute":0,"wake_hour":6,"wake_minute":30},)"
+    R"("auto_night":{"enabled":true,"start_hour":21,"start_minute":0,"end_hour":7,"end_minute":0},)"
+    R"("time":{"ntp_enabled":true,"ntp_server":"pool.ntp.org","tz_name":"Europe/Amsterdam",)"
+    R"("tz_idx":17,"format_24h":true,"rtc_mode":0},"dac":{"auto_mode":false,"auto_armed":false},)"
+    R"("theme":{"valid":true,"screen_bg":0,"card_bg":1981000,"card_border":3359829,)"
+    R"("text_primary":16777215,"shadow_color":0,"shadow_enabled":true,"gradient_enabled":false,)"
+    R"("gradient_color":0,"gradient_direction":0,"screen_gradient_enabled":false,)"
+    R"("screen_gradient_color":0,"screen_gradient_direction":0}})";
+
+Config::StoredConfig sample_config() {
+    Config::StoredConfig config;
+    config.wifi_ssid = "Workshop";
+    config.wifi_pass = "correct horse battery staple";
+    config.mqtt_host = "broker.lan";
+    config.mqtt_user = "sensor";
+    config.mqtt_pass = "secret";
+    config.mqtt_base_topic = "home/aura";
+    config.mqtt_device_name = "Aura Living Room";
+    config.web_display_name = "Living room";
+    config.ntp_server = "pool.ntp.org";
+    config.tz_name = "Europe/Amsterdam";
+    config.theme.valid = true;
+    return config;
+}
+
+template <typename Fn>
+double mean_us(Fn fn) {
+    const auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        fn();
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started)
+               .count() /
+           kIterations;
+}
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_snapshot_load_beats_json_parse() {
+    const Config::StoredConfig config = sample_config();
+    std::vector<uint8_t> snapshot(ConfigSnapshot::encodedSize(config));
+    TEST_ASSERT_EQUAL_UINT32(snapshot.size(),
+                             ConfigSnapshot::encode(config, snapshot.data(), snapshot.size()));
+
+    bool decoded_ok = true;
+    const double snapshot_us = mean_us([&]() {
+        Config::StoredConfig loaded;
+        decoded_ok = decoded_ok && ConfigSnapshot::decode(snapshot.data(), snapshot.size(), loaded);
+    });
+    bool parsed_ok = true;
+    const double json_us = mean_us([&]() {
+        ArduinoJson::JsonDocument doc;
+        parsed_ok = parsed_ok && !ArduinoJson::deserializeJson(doc, kConfigJson);
+    });
+    TEST_ASSERT_TRUE(decoded_ok);
+    TEST_ASSERT_TRUE(parsed_ok);
+
+    char report[160];
+    snprintf(report, sizeof(report),
+             "config load: snapshot %u B %.2fus, json %u B %.2fus (parse only)",
+             static_cast<unsigned>(snapshot.size()), snapshot_us,
+             static_cast<unsigned>(sizeof(kConfigJson) - 1), json_us);
+    TEST_MESSAGE(report);
+
+    TEST_ASSERT_TRUE(snapshot.size() < sizeof(kConfigJson) - 1);
+    TEST_ASSERT_TRUE(snapshot_us < json_us);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_snapshot_load_beats_json_parse);
+    return UNITY_END();
+}
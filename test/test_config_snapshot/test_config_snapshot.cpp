@@ -0,0 +1,165 @@
+#include <unity.h>
+
+#include <string.h>
+#include <vector>
+
+#include "config/AppConfig.h"
+#include "core/ConfigSnapshot.h"
+
+namespace {
+
+Config::StoredConfig customized() {
+    Config::StoredConfig config;
+    config.wifi_ssid = "Workshop";
+    config.wifi_pass = "correct horse battery staple";
+    config.wifi_enabled = false;
+    config.mqtt_host = "broker.lan";
+    config.mqtt_port = 8883;
+    config.mqtt_user = "sensor";
+    config.mqtt_pass = "";
+    config.mqtt_state_encoding = Config::MqttStateEncoding::JsonCbor;
+    config.temp_offset = -1.25f;
+    config.hum_offset = 3.5f;
+    config.units_c = false;
+    config.pressure_altitude_set = true;
+    config.pressure_altitude_m = -120;
+    config.web_display_name = "Living room";
+    config.language = Config::Language::NL;
+    config.backlight_timeout_s = 300;
+    config.backlight_sleep_hour = 22;
+    config.auto_night_enabled = true;
+    config.ntp_server = "pool.ntp.org";
+    config.tz_name = "Europe/Amsterdam";
+    config.tz_index = 17;
+    config.rtc_mode = Config::RtcMode::Ds3231;
+    config.dac_auto_armed = true;
+    config.theme.valid = true;
+    config.theme.card_bg = 0x1E2A38;
+    config.theme.screen_gradient_direction = 3;
+    return config;
+}
+
+std::vector<uint8_t> encode(const Config::StoredConfig &config) {
+    std::vector<uint8_t> bytes(ConfigSnapshot::encodedSize(config));
+    const size_t written = ConfigSnapshot::encode(config, bytes.data(), bytes.size());
+    TEST_ASSERT_EQUAL_UINT32(bytes.size(), written);
+    return bytes;
+}
+
+// Hand-built record: header followed by the given raw entries.
+std::vector<uint8_t> record(const std::vector<uint8_t> &entries, uint16_t count) {
+    std::vector<uint8_t> bytes = {'C', 'F', 'G', 'S',
+                                  static_cast<uint8_t>(ConfigSnapshot::kVersion), 0,
+                                  static_cast<uint8_t>(count), 0};
+    bytes.insert(bytes.end(), entries.begin(), entries.end());
+    return bytes;
+}
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_round_trip_keeps_every_field() {
+    const Config::StoredConfig original = customized();
+    const std::vector<uint8_t> bytes = encode(original);
+
+    Config::StoredConfig loaded;
+    TEST_ASSERT_TRUE(ConfigSnapshot::decode(bytes.data(), bytes.size(), loaded));
+    TEST_ASSERT_EQUAL_STRING("Workshop", loaded.wifi_ssid.c_str());
+    TEST_ASSERT_EQUAL_STRING("correct horse battery staple", loaded.wifi_pass.c_str());
+    TEST_ASSERT_FALSE(loaded.wifi_enabled);
+    TEST_ASSERT_EQUAL_STRING("broker.lan", loaded.mqtt_host.c_str());
+    TEST_ASSERT_EQUAL_UINT16(8883, loaded.mqtt_port);
+    TEST_ASSERT_EQUAL_STRING("", loaded.mqtt_pass.c_str());
+    TEST_ASSERT_TRUE(loaded.mqtt_state_encoding == Config::MqttStateEncoding::JsonCbor);
+    TEST_ASSERT_EQUAL_FLOAT(-1.25f, loaded.temp_offset);
+    TEST_ASSERT_EQUAL_FLOAT(3.5f, loaded.hum_offset);
+    TEST_ASSERT_FALSE(loaded.units_c);
+    TEST_ASSERT_EQUAL_INT16(-120, loaded.pressure_altitude_m);
+    TEST_ASSERT_EQUAL_STRING("Living room", loaded.web_display_name.c_str());
+    TEST_ASSERT_TRUE(loaded.language == Config::Language::NL);
+    TEST_ASSERT_EQUAL_UINT32(300, loaded.backlight_timeout_s);
+    TEST_ASSERT_EQUAL_INT(22, loaded.backlight_sleep_hour);
+    TEST_ASSERT_TRUE(loaded.auto_night_enabled);
+    TEST_ASSERT_EQUAL_STRING("Europe/Amsterdam", loaded.tz_name.c_str());
+    TEST_ASSERT_EQUAL_INT(17, loaded.tz_index);
+    TEST_ASSERT_TRUE(loaded.rtc_mode == Config::RtcMode::Ds3231);
+    TEST_ASSERT_TRUE(loaded.dac_auto_armed);
+    TEST_ASSERT_TRUE(loaded.theme.valid);
+    TEST_ASSERT_EQUAL_HEX32(0x1E2A38, loaded.theme.card_bg);
+    TEST_ASSERT_EQUAL_UINT32(3, loaded.theme.screen_gradient_direction);
+}
+
+void test_missing_fields_keep_defaults() {
+    // tag 1 (wifi_ssid) = "ab", tag 11 (mqtt_port) = 1884
+    const std::vector<uint8_t> bytes = record({1, 2, 0, 'a', 'b', 11, 2, 0, 0x5C, 0x07}, 2);
+    Config::StoredConfig loaded;
+    loaded.tz_index = 5;
+    TEST_ASSERT_TRUE(ConfigSnapshot::decode(bytes.data(), bytes.size(), loaded));
+    TEST_ASSERT_EQUAL_STRING("ab", loaded.wifi_ssid.c_str());
+    TEST_ASSERT_EQUAL_UINT16(1884, loaded.mqtt_port);
+    TEST_ASSERT_EQUAL_INT(5, loaded.tz_index);
+    TEST_ASSERT_TRUE(loaded.ntp_enabled);
+}
+
+void test_unknown_tags_and_changed_widths_are_skipped() {
+    // tag 250 from a newer firmware, then mqtt_port stored with a width we do not expect,
+    // then units_mdy out of order.
+    const std::vector<uint8_t> bytes =
+        record({250, 3, 0, 9, 9, 9, 11, 4, 0, 1, 2, 3, 4, 33, 1, 0, 1}, 3);
+    Config::StoredConfig loaded;
+    TEST_ASSERT_TRUE(ConfigSnapshot::decode(bytes.data(), bytes.size(), loaded));
+    TEST_ASSERT_EQUAL_UINT16(Config::StoredConfig{}.mqtt_port, loaded.mqtt_port);
+    TEST_ASSERT_TRUE(loaded.units_mdy);
+}
+
+void test_out_of_range_enums_are_clamped() {
+    // tag 42 (language) = 200, tag 75 (rtc_mode) = 9
+    const std::vector<uint8_t> bytes = record({42, 1, 0, 200, 75, 1, 0, 9}, 2);
+    Config::StoredConfig loaded;
+    loaded.language = Config::Language::DE;
+    TEST_ASSERT_TRUE(ConfigSnapshot::decode(bytes.data(), bytes.size(), loaded));
+    TEST_ASSERT_TRUE(loaded.language == Config::Language::EN);
+    TEST_ASSERT_TRUE(loaded.rtc_mode == Config::RtcMode::Auto);
+}
+
+void test_malformed_records_leave_config_untouched() {
+    Config::StoredConfig loaded;
+    loaded.wifi_ssid = "keep";
+
+    std::vector<uint8_t> bad_magic = record({1, 1, 0, 'x'}, 1);
+    bad_magic[0] = 'X';
+    std::vector<uint8_t> newer = record({1, 1, 0, 'x'}, 1);
+    newer[4] = static_cast<uint8_t>(ConfigSnapshot::kVersion + 1);
+    const std::vector<uint8_t> truncated = record({1, 5, 0, 'x'}, 1);
+    const std::vector<uint8_t> short_count = record({1, 1, 0, 'x', 2, 1, 0, 'y'}, 1);
+    const std::vector<uint8_t> long_count = record({1, 1, 0, 'x'}, 2);
+
+    TEST_ASSERT_FALSE(ConfigSnapshot::decode(bad_magic.data(), bad_magic.size(), loaded));
+    TEST_ASSERT_FALSE(ConfigSnapshot::decode(newer.data(), newer.size(), loaded));
+    TEST_ASSERT_FALSE(ConfigSnapshot::decode(truncated.data(), truncated.size(), loaded));
+    TEST_ASSERT_FALSE(ConfigSnapshot::decode(short_count.data(), short_count.size(), loaded));
+    TEST_ASSERT_FALSE(ConfigSnapshot::decode(long_count.data(), long_count.size(), loaded));
+    TEST_ASSERT_FALSE(ConfigSnapshot::decode(bad_magic.data(), 4, loaded));
+    TEST_ASSERT_EQUAL_STRING("keep", loaded.wifi_ssid.c_str());
+}
+
+void test_encode_reports_short_buffer() {
+    const Config::StoredConfig config = customized();
+    std::vector<uint8_t> bytes(ConfigSnapshot::encodedSize(config) - 1);
+    TEST_ASSERT_EQUAL_UINT32(0, ConfigSnapshot::encode(config, bytes.data(), bytes.size()));
+    TEST_ASSERT_EQUAL_UINT32(0, ConfigSnapshot::encode(config, bytes.data(), 4));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_keeps_every_field);
+    RUN_TEST(test_missing_fields_keep_defaults);
+    RUN_TEST(test_unknown_tags_and_changed_widths_are_skipped);
+    RUN_TEST(test_out_of_range_enums_are_clamped);
+    RUN_TEST(test_malformed_records_leave_config_untouched);
+    RUN_TEST(test_encode_reports_short_buffer);
+    return UNITY_END();
+}
@@ -4,6 +4,7 @@
 #include "ArduinoMock.h"
 #include "I2cMock.h"
 #include "config/AppConfig.h"
+#include "core/I2cScheduler.h"
 #include "core/Logger.h"
 #include "drivers/DfrOptionalGasSensor.h"
 
@@ -44,6 +45,14 @@ void setReadGasResponse(uint16_t raw_ppm, uint8_t gas_type, uint8_t decimals) {
     setCommandResponse(Config::DFR_GAS_CMD_READ_GAS, frame, sizeof(frame));
 }
 
+// Reads are scheduled: the first poll sends the command, the response is read once
+// DFR_GAS_CMD_DELAY_MS has passed.
+void pollRead(DfrOptionalGasSensor &sensor) {
+    sensor.poll();
+    advanceMillis(Config::DFR_GAS_CMD_DELAY_MS);
+    sensor.poll();
+}
+
 } // namespace
 
 static_assert(Config::DFR_GAS_TYPE_NH3 == 0x02, "DFR NH3 gas type drifted");
@@ -55,6 +64,7 @@ static_assert(Config::DFR_GAS_TYPE_NO2 == 0x2C, "DFR NO2 gas type drifted");
 void setUp() {
     setMillis(0);
     I2cMock::reset();
+    I2cScheduler::instance().reset();
     Logger::begin(Serial, Logger::Debug);
     Logger::setSerialOutputEnabled(false);
     Logger::setSensorsSerialOutputEnabled(false);
@@ -73,7 +83,7 @@ void test_optional_gas_detects_nh3_after_warmup() {
 
     setReadGasResponse(123, Config::DFR_GAS_TYPE_NH3, 1);
     setMillis(Config::DFR_GAS_WARMUP_MS + Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
 
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::NH3),
                       static_cast<int>(sensor.optionalGasType()));
@@ -92,7 +102,7 @@ void test_optional_gas_detects_so2_after_warmup() {
 
     setReadGasResponse(75, Config::DFR_GAS_TYPE_SO2, 1);
     setMillis(Config::DFR_GAS_WARMUP_MS + Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
 
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::SO2),
                       static_cast<int>(sensor.optionalGasType()));
@@ -111,7 +121,7 @@ void test_optional_gas_detects_o3_after_warmup() {
 
     setReadGasResponse(42, Config::DFR_GAS_TYPE_O3, 1);
     setMillis(Config::DFR_GAS_WARMUP_MS + Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
 
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::O3),
                       static_cast<int>(sensor.optionalGasType()));
@@ -130,7 +140,7 @@ void test_optional_gas_detects_h2s_after_warmup() {
 
     setReadGasResponse(84, Config::DFR_GAS_TYPE_H2S, 1);
     setMillis(Config::DFR_GAS_WARMUP_MS + Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
 
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::H2S),
                       static_cast<int>(sensor.optionalGasType()));
@@ -149,7 +159,7 @@ void test_optional_gas_detects_no2_after_warmup() {
 
     setReadGasResponse(55, Config::DFR_GAS_TYPE_NO2, 1);
     setMillis(Config::DFR_GAS_WARMUP_MS + Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
 
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::NO2),
                       static_cast<int>(sensor.optionalGasType()));
@@ -158,6 +168,23 @@ void test_optional_gas_detects_no2_after_warmup() {
     TEST_ASSERT_EQUAL_STRING("NO2", sensor.optionalGasLabel());
 }
 
+void test_optional_gas_start_does_not_wait_for_passive_mode_ack() {
+    setMillis(1000);
+    I2cMock::setDevicePresent(Config::DFR_OPTIONAL_GAS_ADDR, true);
+    setPassiveModeAck();
+
+    DfrOptionalGasSensor sensor;
+    TEST_ASSERT_TRUE(sensor.begin());
+    TEST_ASSERT_TRUE(sensor.start());
+    TEST_ASSERT_EQUAL_UINT32(1000u, getMillis());
+    TEST_ASSERT_TRUE(I2cScheduler::instance().isAddressBusy(Config::DFR_OPTIONAL_GAS_ADDR));
+
+    advanceMillis(Config::DFR_GAS_CMD_DELAY_MS);
+    sensor.poll();
+    TEST_ASSERT_TRUE(sensor.isPresent());
+    TEST_ASSERT_EQUAL_UINT32(1000u + Config::DFR_GAS_CMD_DELAY_MS, getMillis());
+}
+
 void test_optional_gas_rejects_unsupported_gas_type() {
     I2cMock::setDevicePresent(Config::DFR_OPTIONAL_GAS_ADDR, true);
     setPassiveModeAck();
@@ -168,7 +195,7 @@ void test_optional_gas_rejects_unsupported_gas_type() {
 
     setReadGasResponse(42, Config::DFR_GAS_TYPE_CO, 1);
     setMillis(Config::DFR_GAS_WARMUP_MS + Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
 
     TEST_ASSERT_FALSE(sensor.isDataValid());
     TEST_ASSERT_EQUAL(static_cast<int>(DfrMultiGasSensor::GasType::CO),
@@ -187,7 +214,7 @@ void test_optional_gas_clamps_detected_type_range() {
 
     setReadGasResponse(999, Config::DFR_GAS_TYPE_O3, 1);
     setMillis(Config::DFR_GAS_WARMUP_MS + Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
     TEST_ASSERT_TRUE(sensor.isDataValid());
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::O3),
                       static_cast<int>(sensor.optionalGasType()));
@@ -195,7 +222,7 @@ void test_optional_gas_clamps_detected_type_range() {
 
     setReadGasResponse(500, Config::DFR_GAS_TYPE_SO2, 1);
     advanceMillis(Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
     TEST_ASSERT_TRUE(sensor.isDataValid());
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::SO2),
                       static_cast<int>(sensor.optionalGasType()));
@@ -203,7 +230,7 @@ void test_optional_gas_clamps_detected_type_range() {
 
     setReadGasResponse(500, Config::DFR_GAS_TYPE_NO2, 1);
     advanceMillis(Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
     TEST_ASSERT_TRUE(sensor.isDataValid());
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::NO2),
                       static_cast<int>(sensor.optionalGasType()));
@@ -221,7 +248,7 @@ void test_optional_gas_keeps_known_type_when_recovery_fails_but_address_acks() {
 
     setReadGasResponse(123, Config::DFR_GAS_TYPE_NH3, 1);
     setMillis(1000 + Config::DFR_GAS_WARMUP_MS + Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
     TEST_ASSERT_TRUE(sensor.isPresent());
     TEST_ASSERT_TRUE(sensor.isDataValid());
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::NH3),
@@ -257,7 +284,7 @@ void test_optional_gas_marks_absent_when_recovery_fails_after_startup_grace_and_
 
     setReadGasResponse(123, Config::DFR_GAS_TYPE_NH3, 1);
     setMillis(1000 + Config::DFR_GAS_WARMUP_MS + Config::DFR_GAS_POLL_MS);
-    sensor.poll();
+    pollRead(sensor);
     TEST_ASSERT_TRUE(sensor.isPresent());
     TEST_ASSERT_EQUAL(static_cast<int>(DfrOptionalGasSensor::OptionalGasType::NH3),
                       static_cast<int>(sensor.optionalGasType()));
@@ -333,6 +360,7 @@ int main(int, char **) {
     RUN_TEST(test_optional_gas_detects_o3_after_warmup);
     RUN_TEST(test_optional_gas_detects_h2s_after_warmup);
     RUN_TEST(test_optional_gas_detects_no2_after_warmup);
+    RUN_TEST(test_optional_gas_start_does_not_wait_for_passive_mode_ack);
     RUN_TEST(test_optional_gas_rejects_unsupported_gas_type);
     RUN_TEST(test_optional_gas_clamps_detected_type_range);
     RUN_TEST(test_optional_gas_keeps_known_type_when_recovery_fails_but_address_acks);
@@ -0,0 +1,184 @@
+#include <unity.h>
+
+#include "ArduinoMock.h"
+#include "I2cMock.h"
+#include "config/AppConfig.h"
+
+#include "core/I2CHelper.h"
+#include "../../src/core/I2cScheduler.cpp"
+
+namespace {
+
+constexpr uint8_t kAddrA = 0x6B;
+constexpr uint8_t kAddrB = 0x5D;
+constexpr uint16_t kCmdRead = 0x0300;
+constexpr uint16_t kCmdOther = 0x0202;
+
+void encodeWords(const uint16_t *words, size_t word_count, uint8_t *out) {
+    for (size_t i = 0; i < word_count; ++i) {
+        out[i * 3] = static_cast<uint8_t>(words[i] >> 8);
+        out[i * 3 + 1] = static_cast<uint8_t>(words[i] & 0xFF);
+        out[i * 3 + 2] = I2C::crc8(&out[i * 3], 2);
+    }
+}
+
+void buildRead(I2cTransaction &txn, uint8_t addr, uint16_t cmd, uint32_t wait_ms, size_t words) {
+    txn.reset(addr);
+    TEST_ASSERT_TRUE(txn.addCommand(cmd));
+    TEST_ASSERT_TRUE(txn.addWait(wait_ms));
+    TEST_ASSERT_TRUE(txn.addRead(words * 3));
+}
+
+} // namespace
+
+void setUp() {
+    setMillis(1000);
+    I2cMock::reset();
+    I2cScheduler::instance().reset();
+}
+
+void tearDown() {}
+
+void test_i2c_scheduler_runs_command_wait_read_without_blocking() {
+    I2cMock::setDevicePresent(kAddrA, true);
+    const uint16_t words[2] = {0x1234, 0xBEEF};
+    uint8_t frame[6] = {};
+    encodeWords(words, 2, frame);
+    I2cMock::setCommandRead(kAddrA, kCmdRead, frame, sizeof(frame));
+
+    I2cScheduler &bus = I2cScheduler::instance();
+    I2cTransaction txn;
+    buildRead(txn, kAddrA, kCmdRead, 20, 2);
+    TEST_ASSERT_TRUE(bus.submit(txn, millis()));
+    TEST_ASSERT_EQUAL_UINT32(1000u, getMillis());
+    TEST_ASSERT_TRUE(txn.isPending());
+
+    bus.poll(1019);
+    TEST_ASSERT_TRUE(txn.isPending());
+
+    bus.poll(1020);
+    TEST_ASSERT_TRUE(txn.succeeded());
+    TEST_ASSERT_EQUAL_UINT32(0u, bus.activeCount());
+    uint16_t out[2] = {};
+    TEST_ASSERT_TRUE(txn.decodeWords(out, 2));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, out[0]);
+    TEST_ASSERT_EQUAL_HEX16(0xBEEF, out[1]);
+}
+
+void test_i2c_scheduler_interleaves_devices_but_serializes_one_address() {
+    I2cMock::setDevicePresent(kAddrA, true);
+    I2cMock::setDevicePresent(kAddrB, true);
+    const uint16_t words[1] = {7};
+    uint8_t frame[3] = {};
+    encodeWords(words, 1, frame);
+    I2cMock::setCommandRead(kAddrA, kCmdRead, frame, sizeof(frame));
+    I2cMock::setCommandRead(kAddrA, kCmdOther, frame, sizeof(frame));
+    I2cMock::setCommandRead(kAddrB, kCmdRead, frame, sizeof(frame));
+
+    I2cScheduler &bus = I2cScheduler::instance();
+    I2cTransaction first;
+    I2cTransaction second;
+    I2cTransaction other_device;
+    buildRead(first, kAddrA, kCmdRead, 20, 1);
+    buildRead(second, kAddrA, kCmdOther, 20, 1);
+    buildRead(other_device, kAddrB, kCmdRead, 5, 1);
+    TEST_ASSERT_TRUE(bus.submit(first, 1000));
+    TEST_ASSERT_TRUE(bus.submit(second, 1000));
+    TEST_ASSERT_TRUE(bus.submit(other_device, 1000));
+    TEST_ASSERT_TRUE(bus.isAddressBusy(kAddrA));
+
+    bus.poll(1005);
+    TEST_ASSERT_TRUE(other_device.succeeded());
+    TEST_ASSERT_TRUE(first.isPending());
+    TEST_ASSERT_TRUE(second.isPending());
+
+    // The second command only goes out once the first exchange has read its response.
+    bus.poll(1020);
+    TEST_ASSERT_TRUE(first.succeeded());
+    TEST_ASSERT_TRUE(second.isPending());
+    bus.poll(1039);
+    TEST_ASSERT_TRUE(second.isPending());
+    bus.poll(1040);
+    TEST_ASSERT_TRUE(second.succeeded());
+    TEST_ASSERT_FALSE(bus.isAddressBusy(kAddrA));
+}
+
+void test_i2c_scheduler_reports_write_and_read_failures() {
+    I2cMock::setDevicePresent(kAddrA, true);
+    I2cMock::setCommandFailure(kAddrA, kCmdRead, true);
+
+    I2cScheduler &bus = I2cScheduler::instance();
+    I2cTransaction txn;
+    buildRead(txn, kAddrA, kCmdRead, 20, 1);
+    TEST_ASSERT_TRUE(bus.submit(txn, 1000));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2cTransaction::State::Failed),
+                      static_cast<int>(txn.state()));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2cTransaction::Error::Write),
+                      static_cast<int>(txn.error()));
+    TEST_ASSERT_EQUAL_UINT32(0u, bus.activeCount());
+
+    I2cMock::setCommandFailure(kAddrA, kCmdRead, false);
+    txn.release();
+    buildRead(txn, kAddrA, kCmdRead, 20, 1);
+    TEST_ASSERT_TRUE(bus.submit(txn, 1000));
+    I2cMock::setDevicePresent(kAddrA, false);
+    bus.poll(1020);
+    TEST_ASSERT_EQUAL(static_cast<int>(I2cTransaction::Error::Read),
+                      static_cast<int>(txn.error()));
+}
+
+void test_i2c_scheduler_decode_rejects_crc_mismatch() {
+    I2cMock::setDevicePresent(kAddrA, true);
+    const uint16_t words[1] = {0x0101};
+    uint8_t frame[3] = {};
+    encodeWords(words, 1, frame);
+    frame[2] ^= 0xFF;
+    I2cMock::setCommandRead(kAddrA, kCmdRead, frame, sizeof(frame));
+
+    I2cScheduler &bus = I2cScheduler::instance();
+    I2cTransaction txn;
+    buildRead(txn, kAddrA, kCmdRead, 0, 1);
+    TEST_ASSERT_TRUE(bus.submit(txn, 1000));
+    TEST_ASSERT_TRUE(txn.succeeded());
+    uint16_t out = 0;
+    TEST_ASSERT_FALSE(txn.decodeWords(&out, 1));
+}
+
+void test_i2c_scheduler_cancel_releases_address() {
+    I2cMock::setDevicePresent(kAddrA, true);
+
+    I2cScheduler &bus = I2cScheduler::instance();
+    I2cTransaction txn;
+    buildRead(txn, kAddrA, kCmdRead, 1400, 1);
+    TEST_ASSERT_TRUE(bus.submit(txn, 1000));
+    TEST_ASSERT_TRUE(bus.isAddressBusy(kAddrA));
+
+    bus.cancel(txn);
+    TEST_ASSERT_FALSE(bus.isAddressBusy(kAddrA));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2cTransaction::Error::Cancelled),
+                      static_cast<int>(txn.error()));
+    txn.release();
+    TEST_ASSERT_EQUAL(static_cast<int>(I2cTransaction::State::Idle),
+                      static_cast<int>(txn.state()));
+}
+
+void test_i2c_transaction_rejects_oversized_steps() {
+    I2cTransaction txn;
+    txn.reset(kAddrA);
+    uint8_t params[I2cTransaction::kMaxWriteBytes] = {};
+    TEST_ASSERT_FALSE(txn.addCommand(kCmdRead, params, sizeof(params)));
+    TEST_ASSERT_FALSE(txn.addRead(I2cTransaction::kMaxReadBytes + 1));
+    TEST_ASSERT_TRUE(txn.addRead(3));
+    TEST_ASSERT_FALSE(txn.addReadRegister(0x00, 3));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_i2c_scheduler_runs_command_wait_read_without_blocking);
+    RUN_TEST(test_i2c_scheduler_interleaves_devices_but_serializes_one_address);
+    RUN_TEST(test_i2c_scheduler_reports_write_and_read_failures);
+    RUN_TEST(test_i2c_scheduler_decode_rejects_crc_mismatch);
+    RUN_TEST(test_i2c_scheduler_cancel_releases_address);
+    RUN_TEST(test_i2c_transaction_rejects_oversized_steps);
+    return UNITY_END();
+}
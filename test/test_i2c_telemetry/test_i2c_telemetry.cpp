@@ -0,0 +1,167 @@
+#include <unity.h>
+
+#include <Arduino.h>
+
+#include "ArduinoMock.h"
+#include "I2cMock.h"
+#include "core/I2CHelper.h"
+#include "core/I2cTelemetry.h"
+
+namespace {
+
+constexpr uint8_t kAddrA = 0x77;
+constexpr uint8_t kAddrB = 0x6B;
+
+const I2cDeviceStats *findDevice(const I2cTelemetrySnapshot &snapshot, uint8_t address) {
+    for (size_t i = 0; i < snapshot.device_count; ++i) {
+        if (snapshot.devices[i].address == address) {
+            return &snapshot.devices[i];
+        }
+    }
+    return nullptr;
+}
+
+// Records a transaction that took latency_us by backdating its start.
+void recordWithLatency(uint8_t address, size_t bytes, int err, uint32_t latency_us) {
+    I2cTelemetry::instance().record(address, bytes, err, micros() - latency_us);
+}
+
+} // namespace
+
+void setUp() {
+    setMillis(1000);
+    I2cMock::reset();
+    I2cTelemetry::instance().reset();
+}
+
+void tearDown() {}
+
+void test_record_classifies_results_per_address() {
+    recordWithLatency(kAddrA, 4, ESP_OK, 100);
+    recordWithLatency(kAddrA, 4, ESP_FAIL, 100);
+    recordWithLatency(kAddrA, 4, ESP_ERR_TIMEOUT, 100);
+    recordWithLatency(kAddrA, 4, ESP_ERR_INVALID_ARG, 100);
+    recordWithLatency(kAddrB, 9, ESP_OK, 100);
+    I2cTelemetry::instance().recordCrcFailure(kAddrB);
+
+    I2cTelemetrySnapshot snapshot;
+    I2cTelemetry::instance().snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(2u, static_cast<uint32_t>(snapshot.device_count));
+
+    const I2cDeviceStats *a = findDevice(snapshot, kAddrA);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_UINT32(4u, a->transactions);
+    TEST_ASSERT_EQUAL_UINT32(4u, a->bytes);
+    TEST_ASSERT_EQUAL_UINT32(1u, a->nacks);
+    TEST_ASSERT_EQUAL_UINT32(1u, a->timeouts);
+    TEST_ASSERT_EQUAL_UINT32(1u, a->errors);
+    TEST_ASSERT_EQUAL_UINT32(0u, a->crc_failures);
+
+    const I2cDeviceStats *b = findDevice(snapshot, kAddrB);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_UINT32(1u, b->transactions);
+    TEST_ASSERT_EQUAL_UINT32(9u, b->bytes);
+    TEST_ASSERT_EQUAL_UINT32(1u, b->crc_failures);
+}
+
+void test_latency_lands_in_histogram_buckets() {
+    recordWithLatency(kAddrA, 1, ESP_OK, 100);
+    recordWithLatency(kAddrA, 1, ESP_OK, 700);
+    recordWithLatency(kAddrA, 1, ESP_OK, 700);
+    recordWithLatency(kAddrA, 1, ESP_OK, 40000);
+
+    I2cTelemetrySnapshot snapshot;
+    I2cTelemetry::instance().snapshot(snapshot);
+    const I2cDeviceStats *a = findDevice(snapshot, kAddrA);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_UINT32(1u, a->latency_hist[0]);
+    TEST_ASSERT_EQUAL_UINT32(0u, a->latency_hist[1]);
+    TEST_ASSERT_EQUAL_UINT32(2u, a->latency_hist[2]);
+    TEST_ASSERT_EQUAL_UINT32(1u, a->latency_hist[I2cDeviceStats::kLatencyBuckets - 1]);
+    TEST_ASSERT_EQUAL_UINT32(40000u, a->max_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(250u, I2cTelemetry::latencyBucketLimitUs(0));
+    TEST_ASSERT_EQUAL_UINT32(0u, I2cTelemetry::latencyBucketLimitUs(I2cDeviceStats::kLatencyBuckets - 1));
+}
+
+void test_bus_busy_time_is_reported_per_second() {
+    recordWithLatency(kAddrA, 1, ESP_OK, 30000);
+    recordWithLatency(kAddrB, 1, ESP_OK, 20000);
+
+    I2cTelemetrySnapshot snapshot;
+    I2cTelemetry::instance().snapshot(snapshot);
+    // The first window is still open.
+    TEST_ASSERT_EQUAL_UINT32(0u, snapshot.busy_permille);
+
+    advanceMillis(1000);
+    I2cTelemetry::instance().snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(50u, snapshot.busy_permille);
+    TEST_ASSERT_EQUAL_UINT32(50u, snapshot.busy_peak_permille);
+    TEST_ASSERT_EQUAL_UINT32(50u, snapshot.busy_total_ms);
+
+    recordWithLatency(kAddrA, 1, ESP_OK, 10000);
+    advanceMillis(1000);
+    I2cTelemetry::instance().snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(10u, snapshot.busy_permille);
+    TEST_ASSERT_EQUAL_UINT32(50u, snapshot.busy_peak_permille);
+
+    // A silent second reads as an idle bus rather than repeating the last value.
+    advanceMillis(2500);
+    I2cTelemetry::instance().snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(0u, snapshot.busy_permille);
+    TEST_ASSERT_EQUAL_UINT32(60u, snapshot.busy_total_ms);
+}
+
+void test_full_table_counts_untracked_transactions() {
+    for (size_t i = 0; i < I2cTelemetrySnapshot::kMaxDevices; ++i) {
+        recordWithLatency(static_cast<uint8_t>(0x10 + i), 1, ESP_OK, 10);
+    }
+    recordWithLatency(0x70, 1, ESP_OK, 10);
+    recordWithLatency(0x10, 1, ESP_OK, 10);
+
+    I2cTelemetrySnapshot snapshot;
+    I2cTelemetry::instance().snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(I2cTelemetrySnapshot::kMaxDevices),
+                             static_cast<uint32_t>(snapshot.device_count));
+    TEST_ASSERT_EQUAL_UINT32(1u, snapshot.untracked_transactions);
+    TEST_ASSERT_NULL(findDevice(snapshot, 0x70));
+    TEST_ASSERT_EQUAL_UINT32(2u, findDevice(snapshot, 0x10)->transactions);
+}
+
+void test_i2c_helpers_feed_telemetry() {
+    I2cMock::setDevicePresent(kAddrA, true);
+    uint8_t value = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, I2C::read_register(kAddrA, 0x00, &value, 1));
+    const uint8_t payload[2] = {0x10, 0x20};
+    TEST_ASSERT_EQUAL(ESP_OK, I2C::write_bytes(kAddrA, payload, sizeof(payload)));
+    TEST_ASSERT_EQUAL(ESP_FAIL, I2C::read_bytes(kAddrB, &value, 1));
+
+    uint8_t word[3] = {0xBE, 0xEF, 0x00};
+    word[2] = I2C::crc8(word, 2);
+    TEST_ASSERT_TRUE(I2C::check_crc(kAddrA, word));
+    word[2] ^= 0xFF;
+    TEST_ASSERT_FALSE(I2C::check_crc(kAddrA, word));
+
+    I2cTelemetrySnapshot snapshot;
+    I2cTelemetry::instance().snapshot(snapshot);
+    const I2cDeviceStats *a = findDevice(snapshot, kAddrA);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_UINT32(2u, a->transactions);
+    TEST_ASSERT_EQUAL_UINT32(4u, a->bytes);
+    TEST_ASSERT_EQUAL_UINT32(1u, a->crc_failures);
+
+    const I2cDeviceStats *b = findDevice(snapshot, kAddrB);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_UINT32(1u, b->transactions);
+    TEST_ASSERT_EQUAL_UINT32(1u, b->nacks);
+    TEST_ASSERT_EQUAL_UINT32(0u, b->bytes);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_record_classifies_results_per_address);
+    RUN_TEST(test_latency_lands_in_histogram_buckets);
+    RUN_TEST(test_bus_busy_time_is_reported_per_second);
+    RUN_TEST(test_full_table_counts_untracked_transactions);
+    RUN_TEST(test_i2c_helpers_feed_telemetry);
+    return UNITY_END();
+}
@@ -14,6 +14,7 @@ void setUp() {
 }
 
 void tearDown() {
+    Logger::setDeferredForTest(false);
     Logger::resetRecentForTest();
     MqttEventQueue::instance().clear();
 }
@@ -57,10 +58,27 @@ void test_capture_pause_prevents_recursive_mqtt_feedback() {
     TEST_ASSERT_EQUAL_UINT32(0, MqttEventQueue::instance().size());
 }
 
+void test_capture_state_is_taken_when_the_record_is_made() {
+    Logger::setDeferredForTest(true);
+    {
+        MqttEventQueue::CapturePause capture_pause;
+        Logger::log(Logger::Warn, "MQTT", "event publish failed, reconnecting");
+    }
+    Logger::log(Logger::Info, "WiFi", "connected");
+    TEST_ASSERT_EQUAL_UINT32(0, MqttEventQueue::instance().size());
+
+    Logger::drain();
+    Logger::RecentEntry entry{};
+    TEST_ASSERT_EQUAL_UINT32(1, MqttEventQueue::instance().size());
+    TEST_ASSERT_TRUE(MqttEventQueue::instance().pop(entry));
+    TEST_ASSERT_EQUAL_STRING("WiFi", entry.tag);
+}
+
 int main(int, char **) {
     UNITY_BEGIN();
     RUN_TEST(test_logger_mirrors_only_web_dashboard_events_to_mqtt_queue);
     RUN_TEST(test_logger_mirroring_respects_recent_dedup_window);
     RUN_TEST(test_capture_pause_prevents_recursive_mqtt_feedback);
+    RUN_TEST(test_capture_state_is_taken_when_the_record_is_made);
     return UNITY_END();
 }
\ No newline at end of file
@@ -1,5 +1,10 @@
 #include <unity.h>
 
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
 #include "ArduinoMock.h"
 #include "core/Logger.h"
 
@@ -12,6 +17,7 @@ void setUp() {
 }
 
 void tearDown() {
+    Logger::setDeferredForTest(false);
     Logger::resetRecentForTest();
 }
 
@@ -141,6 +147,100 @@ void test_alert_buffer_excludes_optional_absence_but_keeps_faults() {
     TEST_ASSERT_EQUAL_STRING("DAC init failed: range write failed", alerts[0].message);
 }
 
+void test_deferred_records_format_when_read() {
+    Logger::setDeferredForTest(true);
+    char name[16];
+    strcpy(name, "sen66");
+    Logger::log(Logger::Info, "Sensors", "%s ready in %lu ms", name, 1234UL);
+    strcpy(name, "clobbered");
+    advanceMillis(5);
+    Logger::log(Logger::Warn, "WiFi", "rssi %d dBm, %lld bytes, %5.1f%%", -71, 5000000000LL, 42.25);
+    Logger::log(Logger::Info, "UI", "[%.*s] %c %x %u", 3, "abcdef", 'z', 0xbeefU, 7U);
+    Logger::log(Logger::Info, "UI", "missing %d and %s", 1);
+
+    Logger::Stats stats{};
+    Logger::stats(stats);
+    const uint32_t recorded = stats.recorded;
+
+    Logger::RecentEntry recent[8];
+    const size_t count = Logger::copyRecent(recent, 8);
+    TEST_ASSERT_EQUAL_UINT32(4, count);
+    TEST_ASSERT_EQUAL_STRING("sen66 ready in 1234 ms", recent[0].message);
+    TEST_ASSERT_EQUAL_STRING("rssi -71 dBm, 5000000000 bytes,  42.2%", recent[1].message);
+    TEST_ASSERT_EQUAL_STRING("[abc] z beef 7", recent[2].message);
+    TEST_ASSERT_EQUAL_STRING("missing 1 and ?", recent[3].message);
+
+    Logger::stats(stats);
+    TEST_ASSERT_EQUAL_UINT32(recorded, stats.recorded);
+}
+
+void test_deferred_overflow_counts_drops_and_keeps_newest() {
+    Logger::Stats before{};
+    Logger::stats(before);
+    Logger::setDeferredForTest(true);
+    for (unsigned i = 0; i < 40; ++i) {
+        Logger::log(Logger::Info, "Sensors", "sample %u", i);
+    }
+    Logger::drain();
+
+    Logger::Stats after{};
+    Logger::stats(after);
+    TEST_ASSERT_EQUAL_UINT32(40, after.recorded - before.recorded);
+    TEST_ASSERT_EQUAL_UINT32(8, after.dropped - before.dropped);
+
+    Logger::RecentEntry recent[40];
+    const size_t count = Logger::copyRecent(recent, 40);
+    TEST_ASSERT_EQUAL_UINT32(33, count);
+    TEST_ASSERT_EQUAL_STRING("sample 8", recent[0].message);
+    TEST_ASSERT_EQUAL_STRING("sample 39", recent[31].message);
+    TEST_ASSERT_EQUAL(Logger::Warn, recent[32].level);
+    TEST_ASSERT_EQUAL_STRING("Log", recent[32].tag);
+    TEST_ASSERT_EQUAL_STRING("8 log records dropped", recent[32].message);
+}
+
+void test_long_string_argument_is_cut_but_later_arguments_survive() {
+    char long_text[160];
+    memset(long_text, 'x', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+    Logger::log(Logger::Info, "Web", "%s=%d", long_text, 9);
+
+    Logger::RecentEntry recent[1];
+    TEST_ASSERT_EQUAL_UINT32(1, Logger::copyRecent(recent, 1));
+    const char *message = recent[0].message;
+    const size_t length = strlen(message);
+    TEST_ASSERT_TRUE(length > 60 && length < Logger::kArgBytes);
+    TEST_ASSERT_EQUAL_STRING("=9", message + length - 2);
+}
+
+void test_concurrent_producers_never_mix_records() {
+    Logger::setDeferredForTest(true);
+    constexpr unsigned kThreads = 4;
+    constexpr unsigned kPerThread = 8;
+    std::vector<std::thread> producers;
+    for (unsigned t = 0; t < kThreads; ++t) {
+        producers.emplace_back([t]() {
+            for (unsigned i = 0; i < kPerThread; ++i) {
+                Logger::log(Logger::Info, "Sensors", "w%u n%u w%u", t, i, t);
+            }
+        });
+    }
+    for (std::thread &producer : producers) {
+        producer.join();
+    }
+    Logger::drain();
+
+    Logger::RecentEntry recent[kThreads * kPerThread];
+    TEST_ASSERT_EQUAL_UINT32(kThreads * kPerThread, Logger::copyRecent(recent, kThreads * kPerThread));
+    for (const Logger::RecentEntry &entry : recent) {
+        unsigned first = 0;
+        unsigned index = 0;
+        unsigned last = 0;
+        TEST_ASSERT_EQUAL_INT(3, sscanf(entry.message, "w%u n%u w%u", &first, &index, &last));
+        TEST_ASSERT_EQUAL_UINT32(first, last);
+        TEST_ASSERT_TRUE(index < kPerThread);
+    }
+}
+
 int main(int, char **) {
     UNITY_BEGIN();
     RUN_TEST(test_alert_buffer_keeps_only_warn_and_error);
@@ -150,6 +250,10 @@ int main(int, char **) {
     RUN_TEST(test_alert_buffer_preserves_hard_errors_during_soft_sensor_warn_churn);
     RUN_TEST(test_alert_buffer_keeps_sen66_internal_faults);
     RUN_TEST(test_alert_buffer_excludes_optional_absence_but_keeps_faults);
+    RUN_TEST(test_deferred_records_format_when_read);
+    RUN_TEST(test_deferred_overflow_counts_drops_and_keeps_newest);
+    RUN_TEST(test_long_string_argument_is_cut_but_later_arguments_survive);
+    RUN_TEST(test_concurrent_producers_never_mix_records);
     return UNITY_END();
 }
 
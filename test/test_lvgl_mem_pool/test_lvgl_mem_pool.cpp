@@ -0,0 +1,234 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include "ui/LvglMemPool.h"
+
+namespace {
+
+LvglMemPool::Stats pool_stats() {
+    LvglMemPool::Stats stats;
+    LvglMemPool::instance().stats(stats);
+    return stats;
+}
+
+uint32_t total_slabs(const LvglMemPool::Stats &stats) {
+    uint32_t slabs = 0;
+    for (const LvglMemPool::ClassStats &cls : stats.classes) {
+        slabs += cls.slabs;
+    }
+    return slabs;
+}
+
+} // namespace
+
+void setUp() {
+    LvglMemPool::instance().resetForTest();
+}
+
+void tearDown() {}
+
+void test_requests_round_up_to_size_classes() {
+    TEST_ASSERT_EQUAL_UINT32(16, LvglMemPool::classSize(1));
+    TEST_ASSERT_EQUAL_UINT32(16, LvglMemPool::classSize(16));
+    TEST_ASSERT_EQUAL_UINT32(32, LvglMemPool::classSize(17));
+    TEST_ASSERT_EQUAL_UINT32(256, LvglMemPool::classSize(LvglMemPool::kMaxBlockSize));
+    TEST_ASSERT_EQUAL_UINT32(0, LvglMemPool::classSize(LvglMemPool::kMaxBlockSize + 1));
+}
+
+void test_small_blocks_share_a_slab_and_are_reused() {
+    LvglMemPool &pool = LvglMemPool::instance();
+    void *a = pool.alloc(40);
+    void *b = pool.alloc(60);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_PTR(static_cast<uint8_t *>(a) + 64, b);
+    memset(a, 0xAA, 64);
+    memset(b, 0xBB, 64);
+
+    LvglMemPool::Stats stats = pool_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.classes[2].slabs);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.classes[2].internal_slabs);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.classes[2].used);
+    TEST_ASSERT_EQUAL_UINT32(LvglMemPool::kSlabBytes / 64 - 2, stats.classes[2].free);
+    TEST_ASSERT_EQUAL_UINT32(LvglMemPool::kSlabBytes, stats.slab_bytes_internal);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.heap_live);
+
+    pool.free(a);
+    TEST_ASSERT_EQUAL_PTR(a, pool.alloc(50));
+    stats = pool_stats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.classes[2].peak_used);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.allocs);
+}
+
+void test_large_blocks_go_to_the_heap() {
+    LvglMemPool &pool = LvglMemPool::instance();
+    void *big = pool.alloc(4096);
+    TEST_ASSERT_NOT_NULL(big);
+    LvglMemPool::Stats stats = pool_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.heap_live);
+    TEST_ASSERT_EQUAL_UINT32(0, total_slabs(stats));
+    pool.free(big);
+    TEST_ASSERT_EQUAL_UINT32(0, pool_stats().heap_live);
+}
+
+void test_realloc_keeps_contents_across_classes() {
+    LvglMemPool &pool = LvglMemPool::instance();
+    char *text = static_cast<char *>(pool.alloc(8));
+    strcpy(text, "CO2 612");
+    // Same class: the block stays where it is.
+    TEST_ASSERT_EQUAL_PTR(text, pool.realloc(text, 12));
+
+    char *grown = static_cast<char *>(pool.realloc(text, 100));
+    TEST_ASSERT_EQUAL_STRING("CO2 612", grown);
+    LvglMemPool::Stats stats = pool_stats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.classes[0].used);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.classes[3].used);
+
+    char *large = static_cast<char *>(pool.realloc(grown, 1000));
+    TEST_ASSERT_EQUAL_STRING("CO2 612", large);
+    stats = pool_stats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.classes[3].used);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.heap_live);
+    pool.free(large);
+}
+
+void test_closed_screen_arena_hands_its_slabs_back() {
+    LvglMemPool &pool = LvglMemPool::instance();
+    void *shared = pool.alloc(24);
+
+    pool.beginArena(5);
+    void *blocks[80];
+    for (size_t i = 0; i < 80; ++i) {
+        blocks[i] = pool.alloc(i % 2 ? 24 : 100);
+    }
+    pool.endArena();
+    // Allocated after the screen was built: shared, not part of the arena.
+    void *later = pool.alloc(24);
+
+    LvglMemPool::Stats stats = pool_stats();
+    // 128-byte blocks: 40 in slabs of 16. 32-byte blocks: one shared slab, one arena slab.
+    TEST_ASSERT_EQUAL_UINT32(3, stats.classes[3].slabs);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.classes[1].slabs);
+
+    pool.closeArena(5);
+    TEST_ASSERT_EQUAL_UINT32(5, total_slabs(pool_stats()));
+    for (size_t i = 0; i < 80; ++i) {
+        pool.free(blocks[i]);
+    }
+    stats = pool_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, total_slabs(stats));
+    TEST_ASSERT_EQUAL_UINT32(4, stats.slabs_released);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.classes[1].used);
+
+    // Reopening the screen starts fresh slabs for it.
+    pool.beginArena(5);
+    void *again = pool.alloc(24);
+    pool.endArena();
+    TEST_ASSERT_EQUAL_UINT32(2, pool_stats().classes[1].slabs);
+    pool.free(again);
+    pool.free(later);
+    pool.free(shared);
+    // The arena is open again, so its empty slab stays for the next build.
+    TEST_ASSERT_EQUAL_UINT32(2, total_slabs(pool_stats()));
+}
+
+void test_arena_bytes_measure_the_last_build() {
+    LvglMemPool &pool = LvglMemPool::instance();
+    pool.beginArena(7);
+    void *label = pool.alloc(20);
+    void *canvas = pool.alloc(1000);
+    pool.endArena();
+    void *shared = pool.alloc(20);
+    TEST_ASSERT_EQUAL_UINT32(32 + 1000, pool.arenaBytes(7));
+    TEST_ASSERT_EQUAL_UINT32(0, pool.arenaBytes(LvglMemPool::kSharedArena));
+
+    pool.closeArena(7);
+    pool.free(label);
+    pool.free(canvas);
+    pool.beginArena(7);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.arenaBytes(7));
+    pool.endArena();
+    pool.free(shared);
+}
+
+void test_arena_bytes_follow_frees_and_reallocs() {
+    LvglMemPool &pool = LvglMemPool::instance();
+    pool.beginArena(9);
+    void *label = pool.alloc(20);
+    char *text = static_cast<char *>(pool.alloc(40));
+    void *canvas = pool.alloc(1000);
+    pool.endArena();
+    TEST_ASSERT_EQUAL_UINT32(32 + 64 + 1000, pool.arenaBytes(9));
+
+    pool.free(label);
+    TEST_ASSERT_EQUAL_UINT32(64 + 1000, pool.arenaBytes(9));
+
+    // Reallocated after the build: the block stays with the screen, counted once.
+    strcpy(text, "PM2.5");
+    text = static_cast<char *>(pool.realloc(text, 200));
+    TEST_ASSERT_EQUAL_STRING("PM2.5", text);
+    TEST_ASSERT_EQUAL_UINT32(256 + 1000, pool.arenaBytes(9));
+    TEST_ASSERT_EQUAL_UINT32(0, pool.arenaBytes(LvglMemPool::kSharedArena));
+
+    text = static_cast<char *>(pool.realloc(text, 600));
+    TEST_ASSERT_EQUAL_STRING("PM2.5", text);
+    TEST_ASSERT_EQUAL_UINT32(600 + 1000, pool.arenaBytes(9));
+    canvas = pool.realloc(canvas, 1500);
+    TEST_ASSERT_EQUAL_UINT32(600 + 1500, pool.arenaBytes(9));
+
+    // A heap block shrinks in place on the heap.
+    text = static_cast<char *>(pool.realloc(text, 10));
+    TEST_ASSERT_EQUAL_STRING("PM2.5", text);
+    TEST_ASSERT_EQUAL_UINT32(10 + 1500, pool.arenaBytes(9));
+
+    pool.free(canvas);
+    pool.free(text);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.arenaBytes(9));
+    TEST_ASSERT_EQUAL_UINT32(0, pool_stats().heap_live);
+}
+
+void test_slabs_move_to_psram_past_the_internal_budget() {
+    LvglMemPool &pool = LvglMemPool::instance();
+    const size_t internal_slabs = LvglMemPool::kInternalBudgetBytes / LvglMemPool::kSlabBytes;
+    const size_t per_slab = LvglMemPool::kSlabBytes / LvglMemPool::kMaxBlockSize;
+    for (size_t i = 0; i < (internal_slabs + 1) * per_slab; ++i) {
+        TEST_ASSERT_NOT_NULL(pool.alloc(200));
+    }
+    LvglMemPool::Stats stats = pool_stats();
+    TEST_ASSERT_EQUAL_UINT32(internal_slabs + 1, stats.classes[4].slabs);
+    TEST_ASSERT_EQUAL_UINT32(internal_slabs, stats.classes[4].internal_slabs);
+    TEST_ASSERT_EQUAL_UINT32(LvglMemPool::kInternalBudgetBytes, stats.slab_bytes_internal);
+    TEST_ASSERT_EQUAL_UINT32(LvglMemPool::kSlabBytes, stats.slab_bytes_psram);
+    // Every block handed out, so nothing is left idle in the slabs.
+    TEST_ASSERT_EQUAL_UINT8(0, stats.frag_pct);
+}
+
+void test_small_requests_fall_back_to_the_heap_when_slabs_run_out() {
+    LvglMemPool &pool = LvglMemPool::instance();
+    const size_t per_slab = LvglMemPool::kSlabBytes / LvglMemPool::kMaxBlockSize;
+    for (size_t i = 0; i < LvglMemPool::kMaxSlabs * per_slab; ++i) {
+        pool.alloc(256);
+    }
+    void *spill = pool.alloc(256);
+    TEST_ASSERT_NOT_NULL(spill);
+    LvglMemPool::Stats stats = pool_stats();
+    TEST_ASSERT_EQUAL_UINT32(LvglMemPool::kMaxSlabs, stats.classes[4].slabs);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.slab_misses);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.heap_live);
+    pool.free(spill);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_requests_round_up_to_size_classes);
+    RUN_TEST(test_small_blocks_share_a_slab_and_are_reused);
+    RUN_TEST(test_large_blocks_go_to_the_heap);
+    RUN_TEST(test_realloc_keeps_contents_across_classes);
+    RUN_TEST(test_closed_screen_arena_hands_its_slabs_back);
+    RUN_TEST(test_arena_bytes_measure_the_last_build);
+    RUN_TEST(test_arena_bytes_follow_frees_and_reallocs);
+    RUN_TEST(test_slabs_move_to_psram_past_the_internal_budget);
+    RUN_TEST(test_small_requests_fall_back_to_the_heap_when_slabs_run_out);
+    return UNITY_END();
+}
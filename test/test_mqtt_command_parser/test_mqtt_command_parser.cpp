@@ -0,0 +1,119 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include "config/AppConfig.h"
+#include "core/MqttCommandParser.h"
+
+namespace {
+
+MqttCommandParser::Result parse(const char *topic,
+                                const char *payload,
+                                MqttPendingCommands &out,
+                                bool auto_night_enabled = false) {
+    return MqttCommandParser::parse(topic,
+                                    reinterpret_cast<const uint8_t *>(payload),
+                                    payload ? strlen(payload) : 0,
+                                    "aura/a1",
+                                    auto_night_enabled,
+                                    out);
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_ignores_foreign_and_non_command_topics() {
+    MqttPendingCommands out;
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Ignored, parse("aura/b2/command/fan", "ON", out));
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Ignored, parse("aura/a1/state", "ON", out));
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Ignored, parse("aura/a1/command/unknown", "ON", out));
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Ignored, parse(nullptr, "ON", out));
+    TEST_ASSERT_FALSE(out.fan_mode);
+}
+
+void test_switch_payloads_are_trimmed_and_case_insensitive() {
+    MqttPendingCommands out;
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/backlight", " off\n", out));
+    TEST_ASSERT_TRUE(out.backlight);
+    TEST_ASSERT_FALSE(out.backlight_value);
+
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/alert_blink", "true", out));
+    TEST_ASSERT_TRUE(out.alert_blink);
+    TEST_ASSERT_TRUE(out.alert_blink_value);
+
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Ignored, parse("aura/a1/command/backlight", "maybe", out));
+}
+
+void test_night_mode_locked_by_auto_night() {
+    MqttPendingCommands out;
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::NightModeLocked,
+                      parse("aura/a1/command/night_mode", "ON", out, true));
+    TEST_ASSERT_FALSE(out.night_mode);
+
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/night_mode", "ON", out));
+    TEST_ASSERT_TRUE(out.night_mode);
+    TEST_ASSERT_TRUE(out.night_mode_value);
+}
+
+void test_fan_mode_and_speed_commands() {
+    MqttPendingCommands out;
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/fan_mode", "manual", out));
+    TEST_ASSERT_EQUAL(FanHaMode::Manual, out.fan_mode_value);
+
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/fan_auto", "AUTO", out));
+    TEST_ASSERT_EQUAL(FanHaMode::Auto, out.fan_mode_value);
+
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/fan_stop", "STOP", out));
+    TEST_ASSERT_EQUAL(FanHaMode::Stopped, out.fan_mode_value);
+
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/fan_manual_percent", "70", out));
+    TEST_ASSERT_EQUAL_UINT8(7, out.fan_manual_speed_value);
+    MqttPendingCommands rejected;
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Ignored,
+                      parse("aura/a1/command/fan_manual_percent", "75", rejected));
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Ignored,
+                      parse("aura/a1/command/fan_manual_speed", "11", rejected));
+    TEST_ASSERT_FALSE(rejected.fan_manual_speed);
+}
+
+void test_fan_percentage_rounds_up_to_step() {
+    MqttPendingCommands out;
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/fan_percentage", "41", out));
+    TEST_ASSERT_EQUAL_UINT8(5, out.fan_manual_speed_value);
+
+    MqttPendingCommands stop;
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/fan_percentage", "0", stop));
+    TEST_ASSERT_TRUE(stop.fan_mode);
+    TEST_ASSERT_EQUAL(FanHaMode::Stopped, stop.fan_mode_value);
+    TEST_ASSERT_FALSE(stop.fan_manual_speed);
+}
+
+void test_fan_timer_accepts_select_options() {
+    MqttPendingCommands out;
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/fan_timer", "2 h", out));
+    TEST_ASSERT_EQUAL_UINT32(7200u, out.fan_timer_seconds);
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/fan_timer", "off", out));
+    TEST_ASSERT_EQUAL_UINT32(Config::DAC_TIMER_NONE_S, out.fan_timer_seconds);
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Ignored, parse("aura/a1/command/fan_timer", "3 h", out));
+}
+
+void test_restart_requires_press() {
+    MqttPendingCommands out;
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Ignored, parse("aura/a1/command/restart", "OFF", out));
+    TEST_ASSERT_EQUAL(MqttCommandParser::Result::Pending, parse("aura/a1/command/restart", "PRESS", out));
+    TEST_ASSERT_TRUE(out.restart);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ignores_foreign_and_non_command_topics);
+    RUN_TEST(test_switch_payloads_are_trimmed_and_case_insensitive);
+    RUN_TEST(test_night_mode_locked_by_auto_night);
+    RUN_TEST(test_fan_mode_and_speed_commands);
+    RUN_TEST(test_fan_percentage_rounds_up_to_step);
+    RUN_TEST(test_fan_timer_accepts_select_options);
+    RUN_TEST(test_restart_requires_press);
+    return UNITY_END();
+}
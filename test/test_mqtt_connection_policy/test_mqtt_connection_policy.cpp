@@ -0,0 +1,56 @@
+#include <unity.h>
+
+#include "config/AppConfig.h"
+#include "core/MqttConnectionPolicy.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_retry_stages_follow_attempt_budget() {
+    const uint32_t short_limit = Config::MQTT_RETRY_SHORT_ATTEMPTS;
+    const uint32_t medium_limit = short_limit + Config::MQTT_RETRY_MEDIUM_ATTEMPTS;
+
+    TEST_ASSERT_EQUAL_UINT8(0, MqttConnectionPolicy::retryStageForAttempts(0));
+    TEST_ASSERT_EQUAL_UINT8(0, MqttConnectionPolicy::retryStageForAttempts(short_limit));
+    TEST_ASSERT_EQUAL_UINT8(1, MqttConnectionPolicy::retryStageForAttempts(short_limit + 1));
+    TEST_ASSERT_EQUAL_UINT8(1, MqttConnectionPolicy::retryStageForAttempts(medium_limit));
+    TEST_ASSERT_EQUAL_UINT8(2, MqttConnectionPolicy::retryStageForAttempts(medium_limit + 1));
+
+    TEST_ASSERT_EQUAL_UINT32(Config::MQTT_RETRY_MS, MqttConnectionPolicy::retryDelayMsForAttempts(1));
+    TEST_ASSERT_EQUAL_UINT32(Config::MQTT_RETRY_MEDIUM_MS,
+                             MqttConnectionPolicy::retryDelayMsForAttempts(short_limit + 1));
+    TEST_ASSERT_EQUAL_UINT32(Config::MQTT_RETRY_LONG_MS,
+                             MqttConnectionPolicy::retryDelayMsForAttempts(medium_limit + 1));
+}
+
+void test_long_stage_failures_are_logged_sparsely() {
+    const uint32_t medium_limit =
+        static_cast<uint32_t>(Config::MQTT_RETRY_SHORT_ATTEMPTS) + Config::MQTT_RETRY_MEDIUM_ATTEMPTS;
+
+    TEST_ASSERT_TRUE(MqttConnectionPolicy::shouldLogConnectFailure(medium_limit));
+    TEST_ASSERT_TRUE(MqttConnectionPolicy::shouldLogConnectFailure(medium_limit + 1));
+    TEST_ASSERT_FALSE(MqttConnectionPolicy::shouldLogConnectFailure(medium_limit + 2));
+    TEST_ASSERT_TRUE(MqttConnectionPolicy::shouldLogConnectFailure(medium_limit + 6));
+}
+
+void test_connect_attempt_due_after_retry_delay() {
+    TEST_ASSERT_TRUE(MqttConnectionPolicy::connectAttemptDue(0, 0, 5));
+    TEST_ASSERT_FALSE(MqttConnectionPolicy::connectAttemptDue(1, 1000, 1000 + Config::MQTT_RETRY_MS - 1));
+    TEST_ASSERT_TRUE(MqttConnectionPolicy::connectAttemptDue(1, 1000, 1000 + Config::MQTT_RETRY_MS));
+    TEST_ASSERT_TRUE(MqttConnectionPolicy::connectAttemptDue(1, 0xFFFFFF00u, Config::MQTT_RETRY_MS));
+}
+
+void test_state_publish_due_on_request_or_interval() {
+    TEST_ASSERT_TRUE(MqttConnectionPolicy::statePublishDue(true, 1000, 1000));
+    TEST_ASSERT_FALSE(MqttConnectionPolicy::statePublishDue(false, 1000, 1000 + Config::MQTT_PUBLISH_MS - 1));
+    TEST_ASSERT_TRUE(MqttConnectionPolicy::statePublishDue(false, 1000, 1000 + Config::MQTT_PUBLISH_MS));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_retry_stages_follow_attempt_budget);
+    RUN_TEST(test_long_stage_failures_are_logged_sparsely);
+    RUN_TEST(test_connect_attempt_due_after_retry_delay);
+    RUN_TEST(test_state_publish_due_on_request_or_interval);
+    return UNITY_END();
+}
@@ -73,10 +73,33 @@ void test_queue_capture_pause_suppresses_enqueue_if_capturing() {
     TEST_ASSERT_EQUAL_UINT32(1, MqttEventQueue::instance().size());
 }
 
+void test_queue_discard_at_keeps_remaining_order() {
+    for (uint32_t i = 0; i < 26; ++i) {
+        MqttEventQueue::instance().enqueue(make_entry(i, Logger::Info, "WiFi", "wrap"));
+    }
+
+    Logger::RecentEntry entry{};
+    TEST_ASSERT_TRUE(MqttEventQueue::instance().peekAt(3, entry));
+    TEST_ASSERT_EQUAL_UINT32(5, entry.ms);
+    TEST_ASSERT_TRUE(MqttEventQueue::instance().discardAt(3));
+    TEST_ASSERT_FALSE(MqttEventQueue::instance().discardAt(23));
+    TEST_ASSERT_EQUAL_UINT32(23, MqttEventQueue::instance().size());
+
+    MqttEventQueue::instance().enqueue(make_entry(100, Logger::Warn, "MQTT", "newest"));
+    const uint32_t expected[] = {2, 3, 4, 6, 7};
+    for (uint32_t ms : expected) {
+        TEST_ASSERT_TRUE(MqttEventQueue::instance().pop(entry));
+        TEST_ASSERT_EQUAL_UINT32(ms, entry.ms);
+    }
+    TEST_ASSERT_TRUE(MqttEventQueue::instance().peekAt(MqttEventQueue::instance().size() - 1, entry));
+    TEST_ASSERT_EQUAL_UINT32(100, entry.ms);
+}
+
 int main(int, char **) {
     UNITY_BEGIN();
     RUN_TEST(test_queue_keeps_fifo_order);
     RUN_TEST(test_queue_overwrites_oldest_when_full);
     RUN_TEST(test_queue_capture_pause_suppresses_enqueue_if_capturing);
+    RUN_TEST(test_queue_discard_at_keeps_remaining_order);
     return UNITY_END();
 }
\ No newline at end of file
@@ -16,6 +16,198 @@ void assert_contains(const String &text, const char *needle) {
     TEST_ASSERT_NOT_NULL_MESSAGE(strstr(text.c_str(), needle), needle);
 }
 
+// Minimal CBOR reader for the state document: decodes each map entry and renders it back
+// with the JSON formatting rules, so a round trip must reproduce the JSON payload exactly.
+class CborStateReader {
+public:
+    CborStateReader(const uint8_t *data, size_t len) : data_(data), len_(len) {}
+
+    bool toJson(String &out, uint32_t &version) {
+        uint8_t map_head = 0;
+        if (!readByte(map_head) || map_head != 0xBF) {
+            return false;
+        }
+        out = "{";
+        bool first = true;
+        while (true) {
+            uint8_t head = 0;
+            if (!peekByte(head)) {
+                return false;
+            }
+            if (head == 0xFF) {
+                ++pos_;
+                break;
+            }
+            uint32_t tag = 0;
+            if (!readUnsigned(0, tag)) {
+                return false;
+            }
+            if (tag == static_cast<uint32_t>(MqttPayloadBuilder::StateField::Version)) {
+                if (!readUnsigned(0, version)) {
+                    return false;
+                }
+                continue;
+            }
+            const char *key =
+                MqttPayloadBuilder::stateFieldKey(static_cast<MqttPayloadBuilder::StateField>(tag));
+            if (!key) {
+                return false;
+            }
+            out += first ? "\"" : ",\"";
+            first = false;
+            out += key;
+            out += "\":";
+            if (!appendValue(out)) {
+                return false;
+            }
+        }
+        out += "}";
+        return pos_ == len_;
+    }
+
+private:
+    bool readByte(uint8_t &out) {
+        if (pos_ >= len_) {
+            return false;
+        }
+        out = data_[pos_++];
+        return true;
+    }
+
+    bool peekByte(uint8_t &out) const {
+        if (pos_ >= len_) {
+            return false;
+        }
+        out = data_[pos_];
+        return true;
+    }
+
+    bool readArgument(uint8_t info, uint32_t &out) {
+        if (info < 24) {
+            out = info;
+            return true;
+        }
+        size_t bytes = 0;
+        if (info == 24) {
+            bytes = 1;
+        } else if (info == 25) {
+            bytes = 2;
+        } else if (info == 26) {
+            bytes = 4;
+        } else {
+            return false;
+        }
+        out = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            uint8_t b = 0;
+            if (!readByte(b)) {
+                return false;
+            }
+            out = (out << 8) | b;
+        }
+        return true;
+    }
+
+    bool readUnsigned(uint8_t major, uint32_t &out) {
+        uint8_t head = 0;
+        if (!readByte(head) || (head >> 5) != major) {
+            return false;
+        }
+        return readArgument(head & 0x1F, out);
+    }
+
+    bool appendValue(String &out) {
+        uint8_t head = 0;
+        if (!readByte(head)) {
+            return false;
+        }
+        const uint8_t major = head >> 5;
+        char buf[48];
+        uint32_t arg = 0;
+        switch (major) {
+            case 0:
+                if (!readArgument(head & 0x1F, arg)) {
+                    return false;
+                }
+                snprintf(buf, sizeof(buf), "%d", static_cast<int>(arg));
+                out += buf;
+                return true;
+            case 1:
+                if (!readArgument(head & 0x1F, arg)) {
+                    return false;
+                }
+                snprintf(buf, sizeof(buf), "%d", -1 - static_cast<int>(arg));
+                out += buf;
+                return true;
+            case 3:
+                if (!readArgument(head & 0x1F, arg) || pos_ + arg > len_) {
+                    return false;
+                }
+                out += "\"";
+                out.append(reinterpret_cast<const char *>(data_ + pos_), arg);
+                out += "\"";
+                pos_ += arg;
+                return true;
+            case 7:
+                break;
+            default:
+                return false;
+        }
+        if (head == 0xF4 || head == 0xF5) {
+            out += head == 0xF5 ? "\"ON\"" : "\"OFF\"";
+            return true;
+        }
+        if (head == 0xF6) {
+            out += "null";
+            return true;
+        }
+        if (head == 0xFA) {
+            if (!readArgument(26, arg)) {
+                return false;
+            }
+            float value = 0.0f;
+            memcpy(&value, &arg, sizeof(value));
+            snprintf(buf, sizeof(buf), "%.1f", static_cast<double>(value));
+            out += buf;
+            return true;
+        }
+        return false;
+    }
+
+    const uint8_t *data_ = nullptr;
+    size_t len_ = 0;
+    size_t pos_ = 0;
+};
+
+void assert_cbor_round_trips_to_json(const SensorData &data,
+                                     const FanStateSnapshot &fan,
+                                     bool gas_warmup,
+                                     bool night_mode,
+                                     bool alert_blink,
+                                     bool backlight_on,
+                                     bool pressure_altitude_set,
+                                     int16_t pressure_altitude_m) {
+    char json[Config::MQTT_BUFFER_SIZE] = {};
+    const size_t json_len = MqttPayloadBuilder::buildStatePayload(
+        json, sizeof(json), data, fan, gas_warmup, night_mode, alert_blink, backlight_on,
+        pressure_altitude_set, pressure_altitude_m);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, static_cast<uint32_t>(json_len));
+
+    uint8_t cbor[Config::MQTT_STATE_CBOR_BUFFER_SIZE] = {};
+    const size_t cbor_len = MqttPayloadBuilder::buildStatePayloadCbor(
+        cbor, sizeof(cbor), data, fan, gas_warmup, night_mode, alert_blink, backlight_on,
+        pressure_altitude_set, pressure_altitude_m);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, static_cast<uint32_t>(cbor_len));
+    TEST_ASSERT_TRUE(cbor_len < json_len);
+
+    String decoded;
+    uint32_t version = 0;
+    CborStateReader reader(cbor, cbor_len);
+    TEST_ASSERT_TRUE(reader.toJson(decoded, version));
+    TEST_ASSERT_EQUAL_UINT32(MqttPayloadBuilder::kStateCborVersion, version);
+    TEST_ASSERT_EQUAL_STRING(json, decoded.c_str());
+}
+
 } // namespace
 
 void setUp() {}
@@ -50,6 +242,91 @@ void test_state_payload_includes_pm05_pm1_pm4_and_co_null_without_sensor() {
     assert_contains(payload, "\"backlight\":\"ON\"");
 }
 
+void test_state_payload_includes_newest_sample_timestamp_when_clock_was_set() {
+    SensorData data{};
+    String payload = MqttPayloadBuilder::buildStatePayload(data, false, false, false, false);
+    assert_contains(payload, "\"sample_ts\":null");
+
+    data.stamps[SENSOR_SOURCE_SEN66].ready_us = 5000000;
+    data.stamps[SENSOR_SOURCE_SEN66].epoch = 1767225600;
+    data.stamps[SENSOR_SOURCE_HCHO].ready_us = 5900000;
+    data.stamps[SENSOR_SOURCE_HCHO].epoch = 1767225601;
+    // Sampled before the clock was set.
+    data.stamps[SENSOR_SOURCE_PRESSURE].ready_us = 5000400;
+
+    payload = MqttPayloadBuilder::buildStatePayload(data, false, false, false, false);
+    assert_contains(payload, "\"sample_ts\":1767225601");
+}
+
+void test_state_payload_fits_buffer_with_every_field_at_max_width() {
+    setMillis(1000);
+    SensorData data{};
+    data.temp_valid = true;
+    data.temperature = -40.0f;
+    data.hum_valid = true;
+    data.humidity = 100.0f;
+    data.co2_valid = true;
+    data.co2 = 40000;
+    data.voc_valid = true;
+    data.voc_index = 500;
+    data.nox_valid = true;
+    data.nox_index = 500;
+    data.hcho_valid = true;
+    data.hcho = 5000.0f;
+    data.pm05_valid = true;
+    data.pm05 = 65535.0f;
+    data.pm1_valid = true;
+    data.pm1 = 65535.0f;
+    data.pm25_valid = true;
+    data.pm25 = 65535.0f;
+    data.pm4_valid = true;
+    data.pm4 = 65535.0f;
+    data.pm10_valid = true;
+    data.pm10 = 65535.0f;
+    data.pressure_valid = true;
+    data.pressure = 1100.0f;
+    data.pressure_delta_3h_valid = true;
+    data.pressure_delta_3h = -100.0f;
+    data.pressure_delta_24h_valid = true;
+    data.pressure_delta_24h = -100.0f;
+    data.co_sensor_present = true;
+    data.co_valid = true;
+    data.co_ppm = 1000.0f;
+    data.optional_gas_sensor_present = true;
+    data.optional_gas_valid = true;
+    data.optional_gas_ppm = 1000.0f;
+    data.optional_gas_type = static_cast<uint8_t>(DfrOptionalGasSensor::OptionalGasType::NH3);
+    for (size_t i = 0; i < SENSOR_SOURCE_COUNT; ++i) {
+        data.stamps[i].ready_us = UINT64_MAX;
+        data.stamps[i].epoch = UINT32_MAX;
+    }
+
+    FanStateSnapshot fan{};
+    fan.present = true;
+    fan.available = true;
+    fan.running = true;
+    fan.manual_override_active = true;
+    fan.mode = FanMode::Manual;
+    fan.manual_step = 10;
+    fan.selected_timer_s = 28800U;
+    fan.stop_at_ms = 1000UL + 28799UL * 1000UL;
+    fan.output_known = true;
+    fan.output_mv = 10000;
+
+    char json[Config::MQTT_BUFFER_SIZE] = {};
+    const size_t json_len = MqttPayloadBuilder::buildStatePayload(
+        json, sizeof(json), data, fan, false, true, true, true, true, -500);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, static_cast<uint32_t>(json_len));
+    TEST_ASSERT_TRUE(json_len < sizeof(json));
+    assert_contains(String(json), "\"main_issue\":\"Particles\"");
+    assert_contains(String(json), "\"fan_timer_remaining\":\"7 h 59 min\"");
+
+    uint8_t cbor[Config::MQTT_STATE_CBOR_BUFFER_SIZE] = {};
+    TEST_ASSERT_GREATER_THAN_UINT32(
+        0, static_cast<uint32_t>(MqttPayloadBuilder::buildStatePayloadCbor(
+               cbor, sizeof(cbor), data, fan, false, true, true, true, true, -500)));
+}
+
 void test_state_payload_includes_co_when_sensor_present_and_valid() {
     SensorData data{};
     data.co_sensor_present = true;
@@ -379,9 +656,96 @@ void test_discovery_entity_object_id_sanitizes_base_topic() {
     TEST_ASSERT_EQUAL_STRING("project_aura_kitchen_1_fan_auto", object_id.c_str());
 }
 
+void test_state_payload_cbor_round_trips_sparse_data() {
+    setMillis(0);
+    SensorData data{};
+    data.co2_valid = true;
+    data.co2 = 612;
+
+    assert_cbor_round_trips_to_json(data, FanStateSnapshot{}, true, false, true, false, false, 0);
+}
+
+void test_state_payload_cbor_round_trips_full_data_and_fan() {
+    setMillis(1000);
+    SensorData data{};
+    data.temp_valid = true;
+    data.temperature = -3.25f;
+    data.hum_valid = true;
+    data.humidity = 61.7f;
+    data.co2_valid = true;
+    data.co2 = 1432;
+    data.voc_valid = true;
+    data.voc_index = 181;
+    data.nox_valid = true;
+    data.nox_index = 3;
+    data.hcho_valid = true;
+    data.hcho = 18.4f;
+    data.pm05_valid = true;
+    data.pm05 = 4321.5f;
+    data.pm1_valid = true;
+    data.pm1 = 3.1f;
+    data.pm25_valid = true;
+    data.pm25 = 7.9f;
+    data.pm4_valid = true;
+    data.pm4 = 9.0f;
+    data.pm10_valid = true;
+    data.pm10 = 11.6f;
+    data.pressure_valid = true;
+    data.pressure = 987.6f;
+    data.pressure_delta_3h_valid = true;
+    data.pressure_delta_3h = -1.4f;
+    data.co_sensor_present = true;
+    data.co_valid = true;
+    data.co_ppm = 2.2f;
+    data.optional_gas_sensor_present = true;
+    data.optional_gas_valid = true;
+    data.optional_gas_ppm = 0.8f;
+    data.optional_gas_type = static_cast<uint8_t>(DfrOptionalGasSensor::OptionalGasType::NO2);
+    for (size_t i = 0; i < SENSOR_SOURCE_COUNT; ++i) {
+        data.stamps[i].ready_us = 1000000ULL + i;
+        data.stamps[i].epoch = 1767225600U + static_cast<uint32_t>(i);
+    }
+
+    FanStateSnapshot fan{};
+    fan.present = true;
+    fan.available = true;
+    fan.running = true;
+    fan.manual_override_active = true;
+    fan.mode = FanMode::Manual;
+    fan.manual_step = 7;
+    fan.selected_timer_s = 7200U;
+    fan.stop_at_ms = 2UL * 60UL * 60UL * 1000UL;
+    fan.output_known = true;
+    fan.output_mv = 7000;
+
+    assert_cbor_round_trips_to_json(data, fan, false, true, false, true, true, 350);
+}
+
+void test_state_payload_cbor_reports_overflow() {
+    SensorData data{};
+    uint8_t cbor[32] = {};
+    const size_t written = MqttPayloadBuilder::buildStatePayloadCbor(
+        cbor, sizeof(cbor), data, FanStateSnapshot{}, false, false, false, false, false, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, static_cast<uint32_t>(written));
+}
+
+void test_state_field_keys_cover_every_tag() {
+    for (uint8_t tag = 0; tag < static_cast<uint8_t>(MqttPayloadBuilder::StateField::Count); ++tag) {
+        TEST_ASSERT_NOT_NULL(
+            MqttPayloadBuilder::stateFieldKey(static_cast<MqttPayloadBuilder::StateField>(tag)));
+    }
+    TEST_ASSERT_NULL(MqttPayloadBuilder::stateFieldKey(MqttPayloadBuilder::StateField::Count));
+    TEST_ASSERT_EQUAL_STRING("temp",
+                             MqttPayloadBuilder::stateFieldKey(MqttPayloadBuilder::StateField::Temp));
+    TEST_ASSERT_EQUAL_STRING("backlight",
+                             MqttPayloadBuilder::stateFieldKey(MqttPayloadBuilder::StateField::Backlight));
+}
+
 int main(int, char **) {
     UNITY_BEGIN();
     RUN_TEST(test_state_payload_includes_pm05_pm1_pm4_and_co_null_without_sensor);
+    RUN_TEST(test_state_payload_includes_newest_sample_timestamp_when_clock_was_set);
+    RUN_TEST(test_state_payload_fits_buffer_with_every_field_at_max_width);
     RUN_TEST(test_state_payload_includes_co_when_sensor_present_and_valid);
     RUN_TEST(test_state_payload_buffer_builder_matches_string_payload);
     RUN_TEST(test_state_payload_pressure_defaults_to_absolute_without_altitude);
@@ -398,6 +762,10 @@ int main(int, char **) {
     RUN_TEST(test_state_payload_reports_no_issue_when_air_is_good);
     RUN_TEST(test_state_payload_includes_fan_fields_when_present);
     RUN_TEST(test_state_payload_reports_fan_timer_remaining_when_manual_timer_is_active);
+    RUN_TEST(test_state_payload_cbor_round_trips_sparse_data);
+    RUN_TEST(test_state_payload_cbor_round_trips_full_data_and_fan);
+    RUN_TEST(test_state_payload_cbor_reports_overflow);
+    RUN_TEST(test_state_field_keys_cover_every_tag);
     RUN_TEST(test_discovery_sensor_payload_contains_pm05_template_and_topics);
     RUN_TEST(test_discovery_entity_object_id_sanitizes_base_topic);
     return UNITY_END();
@@ -0,0 +1,126 @@
+#include <unity.h>
+
+#include "core/MqttPublishScheduler.h"
+
+namespace {
+
+MqttPublishScheduler make_scheduler(uint16_t capacity, uint32_t refill_ms) {
+    MqttPublishScheduler scheduler;
+    scheduler.configure(capacity, refill_ms);
+    scheduler.reset(0);
+    return scheduler;
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_priority_order_alert_state_discovery_backfill() {
+    MqttPublishScheduler scheduler = make_scheduler(8, 100);
+    scheduler.setDepth(MqttPublishClass::Backfill, 1, 0);
+    scheduler.setDepth(MqttPublishClass::Discovery, 1, 0);
+    scheduler.requestLatest(MqttPublishClass::State, 0);
+    scheduler.setDepth(MqttPublishClass::Alert, 1, 0);
+
+    const MqttPublishClass expected[] = {
+        MqttPublishClass::Alert,
+        MqttPublishClass::State,
+        MqttPublishClass::Discovery,
+        MqttPublishClass::Backfill,
+    };
+    for (MqttPublishClass cls : expected) {
+        MqttPublishClass next = MqttPublishClass::Count;
+        TEST_ASSERT_TRUE(scheduler.next(0, false, next));
+        TEST_ASSERT_EQUAL(cls, next);
+        scheduler.markSent(next, 0);
+    }
+    MqttPublishClass next = MqttPublishClass::Count;
+    TEST_ASSERT_FALSE(scheduler.next(0, false, next));
+}
+
+void test_token_bucket_limits_burst_and_refills() {
+    MqttPublishScheduler scheduler = make_scheduler(3, 100);
+    scheduler.setDepth(MqttPublishClass::Discovery, 10, 0);
+
+    MqttPublishClass next = MqttPublishClass::Count;
+    for (int i = 0; i < 3; ++i) {
+        TEST_ASSERT_TRUE(scheduler.next(0, false, next));
+        scheduler.markSent(next, 0);
+    }
+    TEST_ASSERT_FALSE(scheduler.next(99, false, next));
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.stats().throttled);
+
+    TEST_ASSERT_TRUE(scheduler.next(250, false, next));
+    TEST_ASSERT_EQUAL_UINT16(2, scheduler.tokens());
+    scheduler.markSent(next, 250, 2);
+    TEST_ASSERT_EQUAL_UINT16(0, scheduler.tokens());
+    TEST_ASSERT_EQUAL_UINT16(5, scheduler.depth(MqttPublishClass::Discovery));
+
+    TEST_ASSERT_TRUE(scheduler.next(10000, false, next));
+    TEST_ASSERT_EQUAL_UINT16(3, scheduler.tokens());
+}
+
+void test_state_requests_coalesce_while_waiting() {
+    MqttPublishScheduler scheduler = make_scheduler(1, 1000);
+    scheduler.setDepth(MqttPublishClass::Alert, 1, 0);
+    scheduler.requestLatest(MqttPublishClass::State, 0);
+
+    MqttPublishClass next = MqttPublishClass::Count;
+    TEST_ASSERT_TRUE(scheduler.next(0, false, next));
+    scheduler.markSent(next, 0);
+
+    scheduler.requestLatest(MqttPublishClass::State, 400);
+    scheduler.requestLatest(MqttPublishClass::State, 800);
+    TEST_ASSERT_EQUAL_UINT16(1, scheduler.depth(MqttPublishClass::State));
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.stats().classes[1].coalesced);
+
+    TEST_ASSERT_TRUE(scheduler.next(1000, false, next));
+    TEST_ASSERT_EQUAL(MqttPublishClass::State, next);
+    scheduler.markSent(next, 1000);
+    TEST_ASSERT_EQUAL_UINT32(1000, scheduler.stats().classes[1].last_latency_ms);
+}
+
+void test_pause_holds_only_low_priority_classes() {
+    MqttPublishScheduler scheduler = make_scheduler(8, 100);
+    scheduler.setDepth(MqttPublishClass::Discovery, 4, 0);
+    scheduler.setDepth(MqttPublishClass::Backfill, 2, 0);
+
+    MqttPublishClass next = MqttPublishClass::Count;
+    TEST_ASSERT_FALSE(scheduler.next(0, true, next));
+    TEST_ASSERT_FALSE(scheduler.next(10, true, next));
+    TEST_ASSERT_TRUE(scheduler.hasLowPriorityPending());
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.stats().classes[2].paused);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.stats().classes[3].paused);
+
+    scheduler.requestLatest(MqttPublishClass::State, 20);
+    TEST_ASSERT_TRUE(scheduler.next(20, true, next));
+    TEST_ASSERT_EQUAL(MqttPublishClass::State, next);
+    scheduler.markSent(next, 20);
+
+    TEST_ASSERT_TRUE(scheduler.next(30, false, next));
+    TEST_ASSERT_EQUAL(MqttPublishClass::Discovery, next);
+}
+
+void test_reset_clears_depth_and_refills() {
+    MqttPublishScheduler scheduler = make_scheduler(2, 100);
+    scheduler.setDepth(MqttPublishClass::Alert, 5, 0);
+    MqttPublishClass next = MqttPublishClass::Count;
+    TEST_ASSERT_TRUE(scheduler.next(0, false, next));
+    scheduler.markSent(next, 0, 2);
+
+    scheduler.reset(50);
+    TEST_ASSERT_EQUAL_UINT16(0, scheduler.depth(MqttPublishClass::Alert));
+    TEST_ASSERT_EQUAL_UINT16(2, scheduler.tokens());
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.stats().classes[0].sent);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_priority_order_alert_state_discovery_backfill);
+    RUN_TEST(test_token_bucket_limits_burst_and_refills);
+    RUN_TEST(test_state_requests_coalesce_while_waiting);
+    RUN_TEST(test_pause_holds_only_low_priority_classes);
+    RUN_TEST(test_reset_clears_depth_and_refills);
+    return UNITY_END();
+}
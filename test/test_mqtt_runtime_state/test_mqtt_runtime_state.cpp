@@ -3,42 +3,61 @@
 #include "core/MqttRuntimeState.h"
 
 #include "../../src/core/MqttRuntimeState.cpp"
+#include "../../src/core/SensorSnapshot.cpp"
 
 void setUp() {}
 void tearDown() {}
 
 void test_request_publish_is_released_only_after_update() {
-    MqttRuntimeState state;
+    SensorSnapshot sensors;
+    MqttRuntimeState state(sensors);
 
     state.requestPublish();
     TEST_ASSERT_FALSE(state.consumePublishRequest());
 
-    SensorData data{};
     FanStateSnapshot fan{};
-    state.update(data, fan, false, true, false, true, false);
+    state.update(fan, true, false, true, false);
 
     TEST_ASSERT_TRUE(state.consumePublishRequest());
     TEST_ASSERT_FALSE(state.consumePublishRequest());
 }
 
 void test_multiple_publish_requests_collapse_until_next_update() {
-    MqttRuntimeState state;
+    SensorSnapshot sensors;
+    MqttRuntimeState state(sensors);
 
     state.requestPublish();
     state.requestPublish();
     state.requestPublish();
 
-    SensorData data{};
     FanStateSnapshot fan{};
-    state.update(data, fan, false, false, false, false, false);
+    state.update(fan, false, false, false, false);
 
     TEST_ASSERT_TRUE(state.consumePublishRequest());
     TEST_ASSERT_FALSE(state.consumePublishRequest());
 }
 
+void test_snapshot_reads_sensor_data_without_update() {
+    SensorSnapshot sensors;
+    MqttRuntimeState state(sensors);
+    state.update(FanStateSnapshot{}, true, false, true, false);
+
+    SensorData data{};
+    data.co2 = 845;
+    data.co2_valid = true;
+    sensors.publish(data, true);
+
+    const MqttRuntimeSnapshot snapshot = state.snapshot();
+    TEST_ASSERT_EQUAL_INT(845, snapshot.data.co2);
+    TEST_ASSERT_TRUE(snapshot.gas_warmup);
+    TEST_ASSERT_TRUE(snapshot.night_mode);
+    TEST_ASSERT_EQUAL_UINT32(sensors.generation(), snapshot.sensor_generation);
+}
+
 int main(int, char **) {
     UNITY_BEGIN();
     RUN_TEST(test_request_publish_is_released_only_after_update);
     RUN_TEST(test_multiple_publish_requests_collapse_until_next_update);
+    RUN_TEST(test_snapshot_reads_sensor_data_without_update);
     return UNITY_END();
 }
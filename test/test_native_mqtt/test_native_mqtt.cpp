@@ -0,0 +1,643 @@
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "ArduinoMock.h"
+#include "MqttBrokerStub.h"
+#include "MqttTransportHost.h"
+#include "config/AppConfig.h"
+#include "core/MqttCommandParser.h"
+#include "core/MqttConnectionPolicy.h"
+#include "core/MqttPublishScheduler.h"
+#include "core/MqttRuntimeState.h"
+#include "modules/MqttPayloadBuilder.h"
+
+namespace {
+
+MqttBrokerStub g_broker;
+
+// Device side of the harness: the same connect/publish/command loop MqttManager::poll()
+// runs, driven through MqttTransport so it works against the broker stub. Topics come from
+// the MqttPayloadBuilder helpers MqttManager uses.
+class HarnessDevice {
+public:
+    explicit HarnessDevice(const std::string &id)
+        : transport_(new MqttTransportHost(g_broker)),
+          runtime_(sensors_),
+          id_(id),
+          base_topic_("aura/" + id) {
+        scheduler_.configure(Config::MQTT_PUBLISH_BUCKET_CAPACITY,
+                             Config::MQTT_PUBLISH_TOKEN_REFILL_MS);
+    }
+
+    void poll() {
+        const uint32_t now = millis();
+        const uint8_t signal = signal_.exchange(kSignalNone);
+        if (signal == kSignalConnected) {
+            connected_ = true;
+            connecting_ = false;
+            attempts_ = 0;
+            scheduler_.reset(now);
+            char topic[kTopicBufferSize];
+            MqttPayloadBuilder::buildCommandTopic(topic, sizeof(topic), base_topic_, "#");
+            transport_->subscribe(topic);
+            MqttPayloadBuilder::buildAvailabilityTopic(topic, sizeof(topic), base_topic_);
+            publish(topic, Config::MQTT_AVAIL_ONLINE, true);
+            publish_requested_ = true;
+        } else if (signal == kSignalDisconnected) {
+            if (connecting_) {
+                attempts_++;
+            }
+            connected_ = false;
+            connecting_ = false;
+            transport_->destroy();
+        }
+
+        if (runtime_.consumePublishRequest()) {
+            publish_requested_ = true;
+        }
+        applyPendingCommands(now);
+
+        if (!connected_) {
+            if (!connecting_ &&
+                MqttConnectionPolicy::connectAttemptDue(attempts_, last_attempt_ms_, now)) {
+                last_attempt_ms_ = now;
+                connect();
+            }
+            return;
+        }
+        if (publish_requested_) {
+            publish_requested_ = false;
+            scheduler_.requestLatest(MqttPublishClass::State, now);
+        } else if (scheduler_.depth(MqttPublishClass::State) == 0 &&
+                   MqttConnectionPolicy::statePublishDue(false, last_publish_ms_, now)) {
+            scheduler_.requestLatest(MqttPublishClass::State, now);
+        }
+        scheduler_.setDepth(MqttPublishClass::Discovery, discovery_remaining, now);
+
+        MqttPublishClass next = MqttPublishClass::Count;
+        while (scheduler_.next(now, web_pause_publish, next)) {
+            if (next == MqttPublishClass::State) {
+                publishState(now);
+            } else {
+                char topic[kTopicBufferSize];
+                const std::string object_id = "s" + std::to_string(discovery_remaining);
+                MqttPayloadBuilder::buildDiscoveryTopic(topic, sizeof(topic), "sensor", id_,
+                                                        object_id.c_str());
+                publish(topic, "{}", true);
+                discovery_remaining--;
+                if (discovery_remaining == 0) {
+                    discovery_done_ms = now;
+                }
+            }
+            scheduler_.markSent(next, now);
+        }
+        if (web_pause_publish && scheduler_.hasLowPriorityPending()) {
+            if (!publish_deferred_) {
+                publish_deferred_ = true;
+                deferred_count++;
+            }
+        } else {
+            publish_deferred_ = false;
+        }
+    }
+
+    void crash() {
+        // Drop the socket without a DISCONNECT so the broker fires the last will.
+        transport_->stop();
+        transport_->destroy();
+        connected_ = false;
+        connecting_ = false;
+    }
+
+    MqttRuntimeState &runtime() { return runtime_; }
+    SensorSnapshot &sensors() { return sensors_; }
+    const std::string &baseTopic() const { return base_topic_; }
+    bool connected() const { return connected_; }
+    uint32_t attempts() const { return attempts_; }
+    int lastErrorRc() const { return last_error_rc_.load(); }
+    uint32_t publishCount() const { return publish_count_; }
+    uint32_t lastPublishMs() const { return last_publish_ms_; }
+    const MqttPublishStats &publishStats() const { return scheduler_.stats(); }
+
+    bool web_pause_publish = false;
+    uint32_t deferred_count = 0;
+    uint16_t discovery_remaining = 0;
+    uint32_t discovery_done_ms = 0;
+
+    FanHaMode fan_mode = FanHaMode::Stopped;
+    uint8_t fan_speed = 1;
+    uint32_t fan_timer_s = 0;
+    bool night_mode = false;
+    bool backlight_on = true;
+    uint32_t effect_count = 0;
+    uint32_t last_effect_ms = 0;
+    uint32_t night_mode_locked_count = 0;
+
+private:
+    static constexpr size_t kTopicBufferSize = 256;
+    static constexpr uint8_t kSignalNone = 0;
+    static constexpr uint8_t kSignalConnected = 1;
+    static constexpr uint8_t kSignalDisconnected = 2;
+
+    static void onEvent(void *context, const MqttTransportEvent &event) {
+        static_cast<HarnessDevice *>(context)->handleEvent(event);
+    }
+
+    void handleEvent(const MqttTransportEvent &event) {
+        switch (event.type) {
+            case MqttTransportEventType::Connected:
+                signal_.store(kSignalConnected);
+                break;
+            case MqttTransportEventType::Disconnected:
+                signal_.store(kSignalDisconnected);
+                break;
+            case MqttTransportEventType::Error:
+                last_error_rc_.store(event.error_rc);
+                break;
+            case MqttTransportEventType::Message: {
+                MqttPendingCommands pending;
+                const MqttCommandParser::Result result = MqttCommandParser::parse(
+                    event.topic, event.payload, event.payload_len, base_topic_.c_str(),
+                    runtime_.snapshot().auto_night_enabled, pending);
+                if (result == MqttCommandParser::Result::NightModeLocked) {
+                    night_mode_locked_count++;
+                } else if (result == MqttCommandParser::Result::Pending) {
+                    runtime_.mergePendingCommands(pending);
+                }
+                break;
+            }
+        }
+    }
+
+    void connect() {
+        char will_topic[kTopicBufferSize];
+        MqttPayloadBuilder::buildAvailabilityTopic(will_topic, sizeof(will_topic), base_topic_);
+        MqttTransportConfig config;
+        config.host = "broker.local";
+        config.port = Config::MQTT_DEFAULT_PORT;
+        config.client_id = id_.c_str();
+        config.will_topic = will_topic;
+        config.will_payload = Config::MQTT_AVAIL_OFFLINE;
+        config.will_retain = true;
+        config.timeout_ms = MqttConnectionPolicy::connectTimeoutMsForAttempts(attempts_);
+        config.buffer_size = Config::MQTT_BUFFER_SIZE;
+        connecting_ = transport_->start(config, &HarnessDevice::onEvent, this);
+    }
+
+    bool publish(const char *topic, const char *payload, bool retain) {
+        return transport_->publish(topic, reinterpret_cast<const uint8_t *>(payload),
+                                   strlen(payload), retain);
+    }
+
+    void publishState(uint32_t now) {
+        const MqttRuntimeSnapshot snapshot = runtime_.snapshot();
+        char payload[Config::MQTT_BUFFER_SIZE];
+        const size_t len = MqttPayloadBuilder::buildStatePayload(
+            payload, sizeof(payload), snapshot.data, snapshot.fan, snapshot.gas_warmup,
+            snapshot.night_mode, snapshot.alert_blink, snapshot.backlight_on);
+        if (len == 0) {
+            return;
+        }
+        char topic[kTopicBufferSize];
+        MqttPayloadBuilder::buildStateTopic(topic, sizeof(topic), base_topic_);
+        if (transport_->publish(topic, reinterpret_cast<const uint8_t *>(payload), len,
+                                false)) {
+            publish_count_++;
+        }
+        last_publish_ms_ = now;
+    }
+
+    void applyPendingCommands(uint32_t now) {
+        MqttPendingCommands pending;
+        if (!runtime_.takePendingCommands(pending)) {
+            return;
+        }
+        if (pending.fan_mode) {
+            fan_mode = pending.fan_mode_value;
+        }
+        if (pending.fan_manual_speed) {
+            fan_mode = FanHaMode::Manual;
+            fan_speed = pending.fan_manual_speed_value;
+        }
+        if (pending.fan_timer) {
+            fan_timer_s = pending.fan_timer_seconds;
+        }
+        if (pending.night_mode) {
+            night_mode = pending.night_mode_value;
+        }
+        if (pending.backlight) {
+            backlight_on = pending.backlight_value;
+        }
+        effect_count++;
+        last_effect_ms = now;
+        publish_requested_ = true;
+    }
+
+    std::unique_ptr<MqttTransport> transport_;
+    SensorSnapshot sensors_;
+    MqttRuntimeState runtime_;
+    MqttPublishScheduler scheduler_;
+    std::string id_;
+    std::string base_topic_;
+    std::atomic<uint8_t> signal_{kSignalNone};
+    std::atomic<int> last_error_rc_{0};
+    bool connected_ = false;
+    bool connecting_ = false;
+    bool publish_requested_ = false;
+    bool publish_deferred_ = false;
+    uint32_t attempts_ = 0;
+    uint32_t last_attempt_ms_ = 0;
+    uint32_t last_publish_ms_ = 0;
+    uint32_t publish_count_ = 0;
+};
+
+// Home Assistant side: records every message with the mock time it arrived.
+class HarnessObserver {
+public:
+    struct Received {
+        std::string topic;
+        std::string payload;
+        uint32_t at_ms = 0;
+    };
+
+    HarnessObserver() : transport_(new MqttTransportHost(g_broker)) {}
+
+    void start() {
+        MqttTransportConfig config;
+        config.client_id = "observer";
+        transport_->start(config, &HarnessObserver::onEvent, this);
+    }
+
+    bool subscribe(const char *filter) { return transport_->subscribe(filter); }
+
+    bool publish(const std::string &topic, const char *payload) {
+        return transport_->publish(topic.c_str(), reinterpret_cast<const uint8_t *>(payload),
+                                   strlen(payload), false);
+    }
+
+    bool connected() const { return connected_; }
+    std::vector<Received> received;
+
+private:
+    static void onEvent(void *context, const MqttTransportEvent &event) {
+        HarnessObserver *self = static_cast<HarnessObserver *>(context);
+        if (event.type == MqttTransportEventType::Connected) {
+            self->connected_ = true;
+        } else if (event.type == MqttTransportEventType::Message) {
+            Received item;
+            item.topic = event.topic;
+            item.payload.assign(reinterpret_cast<const char *>(event.payload), event.payload_len);
+            item.at_ms = millis();
+            self->received.push_back(item);
+        }
+    }
+
+    std::unique_ptr<MqttTransport> transport_;
+    bool connected_ = false;
+};
+
+void run_for(std::vector<HarnessDevice *> devices, uint32_t duration_ms, uint32_t step_ms) {
+    for (uint32_t elapsed = 0; elapsed < duration_ms; elapsed += step_ms) {
+        advanceMillis(step_ms);
+        g_broker.pump();
+        for (HarnessDevice *device : devices) {
+            device->poll();
+        }
+    }
+}
+
+void connect_observer(HarnessObserver &observer, const char *filter) {
+    observer.start();
+    while (!observer.connected()) {
+        advanceMillis(1);
+        g_broker.pump();
+    }
+    TEST_ASSERT_TRUE(observer.subscribe(filter));
+}
+
+void report(const char *label, double value, const char *unit) {
+    char line[96];
+    snprintf(line, sizeof(line), "%s: %.2f %s", label, value, unit);
+    TEST_MESSAGE(line);
+}
+
+} // namespace
+
+void setUp() {
+    g_broker.reset();
+    setMillis(1000);
+}
+
+void tearDown() {}
+
+void test_broker_topic_filters() {
+    TEST_ASSERT_TRUE(MqttBrokerStub::topicMatches("aura/+/state", "aura/a1/state"));
+    TEST_ASSERT_TRUE(MqttBrokerStub::topicMatches("aura/a1/command/#", "aura/a1/command/fan"));
+    TEST_ASSERT_TRUE(MqttBrokerStub::topicMatches("aura/a1/command/#", "aura/a1/command"));
+    TEST_ASSERT_TRUE(MqttBrokerStub::topicMatches("#", "aura/a1/state"));
+    TEST_ASSERT_FALSE(MqttBrokerStub::topicMatches("aura/+/state", "aura/a1/b/state"));
+    TEST_ASSERT_FALSE(MqttBrokerStub::topicMatches("aura/a1/state", "aura/a1/state/cbor"));
+}
+
+void test_connect_publishes_availability_and_will_on_crash() {
+    HarnessDevice device("a1");
+    run_for({&device}, 10, 1);
+    TEST_ASSERT_TRUE(device.connected());
+
+    // The firmware's availability (and last will) topic, which Home Assistant discovery points at.
+    std::string availability;
+    TEST_ASSERT_TRUE(g_broker.retained("aura/a1/status", availability));
+    TEST_ASSERT_EQUAL_STRING(Config::MQTT_AVAIL_ONLINE, availability.c_str());
+
+    device.crash();
+    TEST_ASSERT_TRUE(g_broker.retained("aura/a1/status", availability));
+    TEST_ASSERT_EQUAL_STRING(Config::MQTT_AVAIL_OFFLINE, availability.c_str());
+}
+
+void test_publish_latency_tracks_broker_latency() {
+    const uint32_t latency_ms = 5;
+    g_broker.setLatencyMs(latency_ms);
+    HarnessObserver observer;
+    connect_observer(observer, "aura/a1/state");
+
+    HarnessDevice device("a1");
+    SensorData data{};
+    data.co2 = 612;
+    data.co2_valid = true;
+    device.sensors().publish(data, false);
+    device.runtime().update(FanStateSnapshot{}, false, false, true, false);
+
+    run_for({&device}, Config::MQTT_PUBLISH_MS * 3 + 100, 1);
+
+    TEST_ASSERT_TRUE(device.connected());
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3u, device.publishCount());
+    TEST_ASSERT_EQUAL_UINT32(device.publishCount(), observer.received.size());
+    TEST_ASSERT_TRUE(observer.received.back().payload.find("\"co2\":612") != std::string::npos);
+    TEST_ASSERT_EQUAL_UINT32(device.lastPublishMs() + latency_ms, observer.received.back().at_ms);
+
+    const size_t iterations = 2000;
+    const auto started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        device.runtime().requestPublish();
+        device.runtime().update(FanStateSnapshot{}, false, false, true, false);
+        device.poll();
+        advanceMillis(latency_ms);
+        g_broker.pump();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    TEST_ASSERT_EQUAL_UINT32(device.publishCount(), observer.received.size());
+    report("host publish round trip",
+           std::chrono::duration<double, std::micro>(elapsed).count() / iterations, "us/msg");
+}
+
+void test_web_pause_holds_discovery_but_not_state() {
+    HarnessObserver observer;
+    connect_observer(observer, "aura/a1/state");
+    HarnessDevice device("a1");
+    run_for({&device}, 10, 1);
+    const uint32_t published = device.publishCount();
+    TEST_ASSERT_EQUAL_UINT32(1u, published);
+
+    device.web_pause_publish = true;
+    device.discovery_remaining = 20;
+    run_for({&device}, Config::MQTT_PUBLISH_MS * 2, 100);
+    TEST_ASSERT_EQUAL_UINT32(published + 2u, device.publishCount());
+    TEST_ASSERT_EQUAL_UINT16(20u, device.discovery_remaining);
+    TEST_ASSERT_EQUAL_UINT32(1u, device.deferred_count);
+
+    device.web_pause_publish = false;
+    run_for({&device}, 2000, 100);
+    TEST_ASSERT_EQUAL_UINT16(0u, device.discovery_remaining);
+    TEST_ASSERT_EQUAL_UINT32(published + 2u, observer.received.size());
+}
+
+void test_discovery_burst_does_not_delay_state() {
+    const uint16_t kDiscoveryMessages = 48;
+    HarnessObserver observer;
+    connect_observer(observer, "aura/a1/state");
+    HarnessDevice device("a1");
+    device.discovery_remaining = kDiscoveryMessages;
+    run_for({&device}, 5, 1);
+    TEST_ASSERT_TRUE(device.connected());
+
+    const uint32_t connected_at = millis();
+    run_for({&device}, 10000, 10);
+    TEST_ASSERT_EQUAL_UINT16(0u, device.discovery_remaining);
+
+    const MqttPublishClassStats &state =
+        device.publishStats().classes[static_cast<size_t>(MqttPublishClass::State)];
+    const MqttPublishClassStats &discovery =
+        device.publishStats().classes[static_cast<size_t>(MqttPublishClass::Discovery)];
+    TEST_ASSERT_EQUAL_UINT32(0u, state.max_latency_ms);
+    TEST_ASSERT_EQUAL_UINT32(kDiscoveryMessages, discovery.sent);
+
+    // The bucket allows one burst, then discovery drains at the refill rate.
+    const uint32_t expected_drain_ms =
+        (kDiscoveryMessages - Config::MQTT_PUBLISH_BUCKET_CAPACITY) *
+        Config::MQTT_PUBLISH_TOKEN_REFILL_MS;
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(expected_drain_ms + 100u, device.discovery_done_ms - connected_at);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(expected_drain_ms - 100u, device.discovery_done_ms - connected_at);
+
+    // A state request during the drain is served ahead of the remaining discovery.
+    device.discovery_remaining = kDiscoveryMessages;
+    run_for({&device}, 200, 10);
+    device.runtime().update(FanStateSnapshot{}, false, false, true, false);
+    device.runtime().requestPublish();
+    device.runtime().update(FanStateSnapshot{}, false, false, true, false);
+    run_for({&device}, 100, 10);
+    TEST_ASSERT_TRUE(device.discovery_remaining > 0u);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(Config::MQTT_PUBLISH_TOKEN_REFILL_MS, state.last_latency_ms);
+    report("discovery drain", device.discovery_done_ms - connected_at, "ms");
+}
+
+void test_reconnect_storm_follows_backoff_schedule() {
+    constexpr size_t kDevices = 50;
+    constexpr uint32_t kOutageMs = 30UL * 60UL * 1000UL;
+    constexpr uint32_t kStepMs = 1000;
+
+    g_broker.setLatencyMs(20);
+    g_broker.setOnline(false);
+
+    std::vector<std::unique_ptr<HarnessDevice>> owned;
+    std::vector<HarnessDevice *> devices;
+    for (size_t i = 0; i < kDevices; ++i) {
+        owned.emplace_back(new HarnessDevice("storm" + std::to_string(i)));
+        devices.push_back(owned.back().get());
+    }
+
+    // Walk the policy schedule for one device: attempt, fail, wait retryDelay(failures).
+    uint32_t expected_per_device = 0;
+    for (uint32_t at = 0; at < kOutageMs;) {
+        expected_per_device++;
+        at += MqttConnectionPolicy::retryDelayMsForAttempts(expected_per_device);
+    }
+
+    uint32_t peak_per_step = 0;
+    for (uint32_t elapsed = 0; elapsed < kOutageMs; elapsed += kStepMs) {
+        const uint32_t before = g_broker.stats().connect_attempts;
+        run_for(devices, kStepMs, kStepMs);
+        const uint32_t burst = g_broker.stats().connect_attempts - before;
+        if (burst > peak_per_step) {
+            peak_per_step = burst;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(expected_per_device * kDevices, g_broker.stats().connect_attempts);
+    TEST_ASSERT_EQUAL_UINT32(0u, g_broker.stats().connects_accepted);
+    TEST_ASSERT_EQUAL_INT(MqttBrokerStub::kOfflineErrorRc, devices.front()->lastErrorRc());
+    TEST_ASSERT_EQUAL_UINT8(2u, MqttConnectionPolicy::retryStageForAttempts(devices.front()->attempts()));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(kDevices, peak_per_step);
+
+    g_broker.setOnline(true);
+    g_broker.resetStats();
+    uint32_t recovered_after_ms = 0;
+    while (g_broker.connectedCount() < kDevices && recovered_after_ms <= Config::MQTT_RETRY_LONG_MS) {
+        run_for(devices, kStepMs, kStepMs);
+        recovered_after_ms += kStepMs;
+    }
+    run_for(devices, kStepMs, kStepMs);
+
+    TEST_ASSERT_EQUAL_UINT32(kDevices, g_broker.connectedCount());
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(Config::MQTT_RETRY_LONG_MS, recovered_after_ms);
+    TEST_ASSERT_EQUAL_UINT32(kDevices, g_broker.stats().connect_attempts);
+    for (HarnessDevice *device : devices) {
+        TEST_ASSERT_TRUE(device->connected());
+        TEST_ASSERT_EQUAL_UINT32(0u, device->attempts());
+    }
+
+    report("storm attempts per device", expected_per_device, "in 30 min outage");
+    report("storm peak connects", peak_per_step, "per second");
+    report("storm recovery", recovered_after_ms / 1000.0, "s");
+}
+
+void test_refused_connect_reports_connack_code() {
+    g_broker.setRefuseCode(5);
+    HarnessDevice device("a1");
+    run_for({&device}, 10, 1);
+    TEST_ASSERT_FALSE(device.connected());
+    TEST_ASSERT_EQUAL_UINT32(1u, device.attempts());
+    TEST_ASSERT_EQUAL_INT(5, device.lastErrorRc());
+
+    g_broker.setRefuseCode(0);
+    run_for({&device}, Config::MQTT_RETRY_MS + 200, 100);
+    TEST_ASSERT_TRUE(device.connected());
+}
+
+void test_command_to_effect_latency() {
+    const uint32_t latency_ms = 15;
+    const uint32_t poll_ms = 50;
+    g_broker.setLatencyMs(latency_ms);
+    HarnessObserver controller;
+    connect_observer(controller, "aura/a1/state");
+    HarnessDevice device("a1");
+    run_for({&device}, latency_ms * 4, 1);
+    TEST_ASSERT_TRUE(device.connected());
+
+    struct Case {
+        const char *command;
+        const char *payload;
+    };
+    const Case cases[] = {
+        {"fan_mode", "Manual"},
+        {"fan_manual_speed", "7"},
+        {"fan_timer", "30 min"},
+        {"night_mode", "ON"},
+        {"backlight", "OFF"},
+        {"fan_percentage", "0"},
+    };
+
+    uint32_t worst_ms = 0;
+    for (const Case &item : cases) {
+        const uint32_t effects = device.effect_count;
+        const uint32_t sent_at = millis();
+        TEST_ASSERT_TRUE(controller.publish(device.baseTopic() + "/command/" + item.command,
+                                            item.payload));
+        for (uint32_t waited = 0; device.effect_count == effects && waited < 1000; waited += poll_ms) {
+            run_for({&device}, poll_ms, poll_ms);
+        }
+        TEST_ASSERT_EQUAL_UINT32(effects + 1u, device.effect_count);
+        const uint32_t effect_ms = device.last_effect_ms - sent_at;
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(latency_ms + poll_ms, effect_ms);
+        if (effect_ms > worst_ms) {
+            worst_ms = effect_ms;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(FanHaMode::Stopped, device.fan_mode);
+    TEST_ASSERT_EQUAL_UINT8(7u, device.fan_speed);
+    TEST_ASSERT_EQUAL_UINT32(1800u, device.fan_timer_s);
+    TEST_ASSERT_TRUE(device.night_mode);
+    TEST_ASSERT_FALSE(device.backlight_on);
+    report("command to effect (worst)", worst_ms, "ms");
+
+    // Each effect requests a state publish, which the controller sees one hop later.
+    run_for({&device}, latency_ms + poll_ms, poll_ms);
+    TEST_ASSERT_TRUE(controller.received.size() >= 2u);
+}
+
+void test_night_mode_command_ignored_with_auto_night() {
+    HarnessObserver controller;
+    connect_observer(controller, "unused");
+    HarnessDevice device("a1");
+    device.runtime().update(FanStateSnapshot{}, false, false, true, true);
+    run_for({&device}, 10, 1);
+
+    TEST_ASSERT_TRUE(controller.publish("aura/a1/command/night_mode", "ON"));
+    run_for({&device}, 10, 1);
+    TEST_ASSERT_EQUAL_UINT32(1u, device.night_mode_locked_count);
+    TEST_ASSERT_EQUAL_UINT32(0u, device.effect_count);
+    TEST_ASSERT_FALSE(device.night_mode);
+}
+
+void test_command_parser_throughput() {
+    const char *base = "aura/a1";
+    const char *topics[] = {
+        "aura/a1/command/fan_mode",
+        "aura/a1/command/fan_percentage",
+        "aura/a1/command/night_mode",
+        "aura/a1/command/backlight",
+        "aura/other/command/fan",
+    };
+    const char *payloads[] = {"Auto", "45", "OFF", " on ", "ON"};
+    const size_t kinds = sizeof(topics) / sizeof(topics[0]);
+    const size_t iterations = 200000;
+
+    size_t pending = 0;
+    const auto started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        const size_t k = i % kinds;
+        MqttPendingCommands out;
+        if (MqttCommandParser::parse(topics[k], reinterpret_cast<const uint8_t *>(payloads[k]),
+                                     strlen(payloads[k]), base, false, out) ==
+            MqttCommandParser::Result::Pending) {
+            pending++;
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    TEST_ASSERT_EQUAL_UINT32(iterations / kinds * (kinds - 1), pending);
+    report("command parse",
+           std::chrono::duration<double, std::nano>(elapsed).count() / iterations, "ns/msg");
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_broker_topic_filters);
+    RUN_TEST(test_connect_publishes_availability_and_will_on_crash);
+    RUN_TEST(test_publish_latency_tracks_broker_latency);
+    RUN_TEST(test_web_pause_holds_discovery_but_not_state);
+    RUN_TEST(test_discovery_burst_does_not_delay_state);
+    RUN_TEST(test_reconnect_storm_follows_backoff_schedule);
+    RUN_TEST(test_refused_connect_reports_connack_code);
+    RUN_TEST(test_command_to_effect_latency);
+    RUN_TEST(test_night_mode_command_ignored_with_auto_night);
+    RUN_TEST(test_command_parser_throughput);
+    return UNITY_END();
+}
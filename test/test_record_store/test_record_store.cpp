@@ -0,0 +1,239 @@
+#include <unity.h>
+
+#include <string.h>
+#include <vector>
+
+#include "RecordMediumMemory.h"
+#include "core/RecordStore.h"
+
+namespace {
+
+constexpr size_t kFileHeaderBytes = 8;
+constexpr size_t kRecordOverheadBytes = 16;
+
+bool put_text(RecordStore &store, const char *key, const char *text) {
+    return store.put(key, text, strlen(text));
+}
+
+bool read_text(RecordStore &store, const char *key, const char *expected) {
+    size_t len = 0;
+    if (!store.length(key, len) || len != strlen(expected)) {
+        return false;
+    }
+    std::vector<char> buffer(len + 1, '\0');
+    return store.read(key, buffer.data(), len) && strcmp(buffer.data(), expected) == 0;
+}
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_put_and_read_survive_a_remount() {
+    RecordMediumMemory medium;
+    {
+        RecordStore store;
+        TEST_ASSERT_TRUE(store.begin(medium));
+        TEST_ASSERT_TRUE(put_text(store, "/config.json", "{\"a\":1}"));
+        TEST_ASSERT_TRUE(put_text(store, "/voc_state.bin", "voc"));
+        TEST_ASSERT_TRUE(put_text(store, "/config.json", "{\"a\":2}"));
+        // Exact-size reads only.
+        char small[2];
+        TEST_ASSERT_FALSE(store.read("/voc_state.bin", small, sizeof(small)));
+    }
+    RecordStore store;
+    TEST_ASSERT_TRUE(store.begin(medium));
+    TEST_ASSERT_TRUE(read_text(store, "/config.json", "{\"a\":2}"));
+    TEST_ASSERT_TRUE(read_text(store, "/voc_state.bin", "voc"));
+    TEST_ASSERT_FALSE(store.contains("/charts.bin"));
+
+    RecordStore::Stats stats;
+    store.stats(stats);
+    TEST_ASSERT_TRUE(stats.mounted);
+    TEST_ASSERT_EQUAL_UINT16(2, stats.keys);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.sequence);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dropped_tail_bytes);
+}
+
+void test_each_commit_is_one_sync() {
+    RecordMediumMemory medium;
+    RecordStore store;
+    store.begin(medium);
+    const uint32_t before = medium.syncCount();
+    RecordStore::Batch batch;
+    TEST_ASSERT_TRUE(batch.put("/a", "1", 1));
+    TEST_ASSERT_TRUE(batch.put("/b", "2", 1));
+    TEST_ASSERT_TRUE(batch.put("/c", "3", 1));
+    TEST_ASSERT_TRUE(store.commit(batch));
+    TEST_ASSERT_EQUAL_UINT32(before + 1, medium.syncCount());
+    TEST_ASSERT_EQUAL_UINT32(kFileHeaderBytes + 3 * (kRecordOverheadBytes + 2 + 1),
+                             medium.size());
+}
+
+void test_torn_batch_is_dropped_whole_at_mount() {
+    RecordMediumMemory medium;
+    {
+        RecordStore store;
+        store.begin(medium);
+        TEST_ASSERT_TRUE(put_text(store, "/a", "old-a"));
+        TEST_ASSERT_TRUE(put_text(store, "/b", "old-b"));
+
+        // Power fails halfway through the second record of the batch.
+        RecordStore::Batch batch;
+        batch.put("/a", "new-a", 5);
+        batch.put("/b", "new-b", 5);
+        medium.failAfter(kRecordOverheadBytes + 2 + 5 + 6);
+        TEST_ASSERT_FALSE(store.commit(batch));
+    }
+    RecordStore store;
+    TEST_ASSERT_TRUE(store.begin(medium));
+    TEST_ASSERT_TRUE(read_text(store, "/a", "old-a"));
+    TEST_ASSERT_TRUE(read_text(store, "/b", "old-b"));
+
+    RecordStore::Stats stats;
+    store.stats(stats);
+    TEST_ASSERT_TRUE(stats.dropped_tail_bytes > 0);
+    // The tail was rewritten away, so later appends are reachable again.
+    TEST_ASSERT_EQUAL_UINT32(1, medium.rewriteCount());
+    TEST_ASSERT_TRUE(put_text(store, "/c", "c"));
+    RecordStore remounted;
+    remounted.begin(medium);
+    TEST_ASSERT_TRUE(read_text(remounted, "/c", "c"));
+    TEST_ASSERT_TRUE(read_text(remounted, "/a", "old-a"));
+}
+
+void test_failed_append_is_repaired_before_the_next_commit() {
+    RecordMediumMemory medium;
+    RecordStore store;
+    store.begin(medium);
+    TEST_ASSERT_TRUE(put_text(store, "/a", "one"));
+    medium.failAfter(4);
+    TEST_ASSERT_FALSE(put_text(store, "/a", "two"));
+    TEST_ASSERT_TRUE(read_text(store, "/a", "one"));
+
+    TEST_ASSERT_TRUE(put_text(store, "/a", "three"));
+    TEST_ASSERT_EQUAL_UINT32(1, medium.rewriteCount());
+    RecordStore remounted;
+    remounted.begin(medium);
+    TEST_ASSERT_TRUE(read_text(remounted, "/a", "three"));
+}
+
+void test_corrupted_record_fails_crc() {
+    RecordMediumMemory medium;
+    {
+        RecordStore store;
+        store.begin(medium);
+        TEST_ASSERT_TRUE(put_text(store, "/a", "payload"));
+    }
+    // Flip one data bit: header and length still parse, only the CRC catches it.
+    const size_t data_offset = kFileHeaderBytes + 12 + 2;
+    medium.bytes()[data_offset + 3] ^= 0x01;
+    RecordStore store;
+    TEST_ASSERT_TRUE(store.begin(medium));
+    TEST_ASSERT_FALSE(store.contains("/a"));
+
+    RecordStore::Stats stats;
+    store.stats(stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.crc_errors);
+    TEST_ASSERT_TRUE(stats.dropped_tail_bytes > 0);
+
+    // Damage after mount is caught on read.
+    TEST_ASSERT_TRUE(put_text(store, "/b", "payload"));
+    medium.bytes()[medium.size() - 6] ^= 0x01;
+    char loaded[7];
+    TEST_ASSERT_FALSE(store.read("/b", loaded, sizeof(loaded)));
+    store.stats(stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.crc_errors);
+}
+
+void test_remove_writes_a_tombstone() {
+    RecordMediumMemory medium;
+    {
+        RecordStore store;
+        store.begin(medium);
+        put_text(store, "/a", "a");
+        put_text(store, "/b", "b");
+        TEST_ASSERT_TRUE(store.remove("/a"));
+        TEST_ASSERT_FALSE(store.remove("/a"));
+        TEST_ASSERT_FALSE(store.contains("/a"));
+    }
+    RecordStore store;
+    store.begin(medium);
+    TEST_ASSERT_FALSE(store.contains("/a"));
+    TEST_ASSERT_TRUE(read_text(store, "/b", "b"));
+}
+
+void test_compaction_reclaims_space_and_keeps_wear_counters() {
+    RecordMediumMemory medium;
+    std::vector<uint8_t> blob(4096, 0x5A);
+    uint64_t lifetime = 0;
+    {
+        RecordStore store;
+        store.begin(medium);
+        TEST_ASSERT_FALSE(store.needsCompaction());
+        for (int i = 0; i < 40; ++i) {
+            blob[0] = static_cast<uint8_t>(i);
+            TEST_ASSERT_TRUE(store.put("/charts.bin", blob.data(), blob.size()));
+        }
+        TEST_ASSERT_TRUE(store.needsCompaction());
+        TEST_ASSERT_TRUE(store.compact());
+        TEST_ASSERT_FALSE(store.needsCompaction());
+
+        RecordStore::Stats stats;
+        store.stats(stats);
+        TEST_ASSERT_TRUE(stats.file_bytes < 2 * blob.size());
+        TEST_ASSERT_EQUAL_UINT32(1, stats.compactions);
+        lifetime = stats.lifetime_bytes;
+        TEST_ASSERT_TRUE(lifetime > 40 * blob.size());
+    }
+    RecordStore store;
+    store.begin(medium);
+    std::vector<uint8_t> loaded(blob.size());
+    TEST_ASSERT_TRUE(store.read("/charts.bin", loaded.data(), loaded.size()));
+    TEST_ASSERT_EQUAL_UINT8(39, loaded[0]);
+
+    RecordStore::Stats stats;
+    store.stats(stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.compactions);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.keys);
+    TEST_ASSERT_EQUAL_UINT64(lifetime, stats.lifetime_bytes);
+}
+
+void test_index_and_key_limits() {
+    RecordMediumMemory medium;
+    RecordStore store;
+    store.begin(medium);
+    char key[16];
+    for (size_t i = 0; i < RecordStore::kMaxKeys; ++i) {
+        snprintf(key, sizeof(key), "/k%u", static_cast<unsigned>(i));
+        TEST_ASSERT_TRUE(put_text(store, key, "x"));
+    }
+    TEST_ASSERT_FALSE(put_text(store, "/one-too-many", "x"));
+    TEST_ASSERT_TRUE(put_text(store, "/k0", "updated"));
+    TEST_ASSERT_FALSE(put_text(store, "#wear", "x"));
+    TEST_ASSERT_FALSE(put_text(store, "/a/key/that/is/longer/than/the/limit", "x"));
+}
+
+void test_unreadable_medium_is_not_mounted() {
+    RecordMediumMemory medium;
+    medium.failOpen(true);
+    RecordStore store;
+    TEST_ASSERT_FALSE(store.begin(medium));
+    TEST_ASSERT_FALSE(store.isMounted());
+    TEST_ASSERT_FALSE(put_text(store, "/a", "x"));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_put_and_read_survive_a_remount);
+    RUN_TEST(test_each_commit_is_one_sync);
+    RUN_TEST(test_torn_batch_is_dropped_whole_at_mount);
+    RUN_TEST(test_failed_append_is_repaired_before_the_next_commit);
+    RUN_TEST(test_corrupted_record_fails_crc);
+    RUN_TEST(test_remove_writes_a_tombstone);
+    RUN_TEST(test_compaction_reclaims_space_and_keeps_wear_counters);
+    RUN_TEST(test_index_and_key_limits);
+    RUN_TEST(test_unreadable_medium_is_not_mounted);
+    return UNITY_END();
+}
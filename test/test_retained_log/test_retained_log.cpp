@@ -0,0 +1,155 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include "ArduinoMock.h"
+#include "core/Logger.h"
+#include "core/MqttEventQueue.h"
+#include "core/RetainedLog.h"
+
+void setUp() {
+    setMillis(0);
+    MqttEventQueue::instance().clear();
+    // Start every test from an empty region, as after a reboot with nothing logged.
+    RetainedLog::instance().begin(ESP_RST_POWERON);
+    RetainedLog::instance().begin(ESP_RST_POWERON);
+}
+
+void tearDown() {
+    MqttEventQueue::instance().clear();
+}
+
+void test_nothing_to_recover_after_an_empty_boot() {
+    TEST_ASSERT_NULL(RetainedLog::instance().previous());
+    TEST_ASSERT_EQUAL_UINT32(0, RetainedLog::instance().queuePreviousEvents(0));
+}
+
+void test_lines_and_samples_survive_a_crash_in_order() {
+    RetainedLog &log = RetainedLog::instance();
+    log.append(Logger::Info, "WiFi", "connected", 100);
+    log.append(Logger::Debug, "UI", "noise", 150);
+    log.append(Logger::Error, "Sensors", "SEN66 read failed", 200);
+    log.noteLoop(1000);
+    log.noteLoop(4000);
+    log.noteLoop(4500);
+    log.pollTelemetry(5000, 90000, 70000, 1200);
+    log.pollTelemetry(6000, 1, 1, 1); // inside the interval
+    log.pollTelemetry(5000 + RetainedLog::kTelemetryIntervalMs, 85000, 65000, 300);
+
+    log.begin(ESP_RST_TASK_WDT);
+    const RetainedLog::Previous *previous = log.previous();
+    TEST_ASSERT_NOT_NULL(previous);
+    TEST_ASSERT_TRUE(previous->crashed);
+    TEST_ASSERT_EQUAL(ESP_RST_TASK_WDT, previous->ended_by);
+    TEST_ASSERT_EQUAL_UINT32(2, previous->line_count);
+    TEST_ASSERT_EQUAL_STRING("connected", previous->lines[0].message);
+    TEST_ASSERT_EQUAL(Logger::Error, previous->lines[1].level);
+    TEST_ASSERT_EQUAL_STRING("Sensors", previous->lines[1].tag);
+    TEST_ASSERT_EQUAL_UINT32(200, previous->lines[1].ms);
+    TEST_ASSERT_EQUAL_UINT32(2, previous->telemetry_count);
+    TEST_ASSERT_EQUAL_UINT32(5000, previous->telemetry[0].uptime_ms);
+    TEST_ASSERT_EQUAL_UINT32(3000, previous->telemetry[0].loop_max_us);
+    TEST_ASSERT_EQUAL_UINT32(1200, previous->telemetry[0].sensor_age_ms);
+    TEST_ASSERT_EQUAL_UINT32(0, previous->telemetry[1].loop_max_us);
+    TEST_ASSERT_EQUAL_UINT32(65000, previous->telemetry[1].heap_min_free);
+
+    // The region was handed over: the boot after this one starts empty again.
+    log.begin(ESP_RST_SW);
+    TEST_ASSERT_NULL(log.previous());
+}
+
+void test_ring_keeps_the_newest_lines_and_skips_torn_ones() {
+    RetainedLog &log = RetainedLog::instance();
+    char message[16];
+    for (uint32_t i = 1; i <= RetainedLog::kLineCapacity + 4; ++i) {
+        snprintf(message, sizeof(message), "line %lu", static_cast<unsigned long>(i));
+        log.append(Logger::Warn, "Test", message, i);
+    }
+    log.corruptLineForTest(RetainedLog::kLineCapacity + 2);
+
+    log.begin(ESP_RST_PANIC);
+    const RetainedLog::Previous *previous = log.previous();
+    TEST_ASSERT_NOT_NULL(previous);
+    TEST_ASSERT_EQUAL_UINT32(RetainedLog::kLineCapacity - 1, previous->line_count);
+    TEST_ASSERT_EQUAL_STRING("line 5", previous->lines[0].message);
+    TEST_ASSERT_EQUAL_STRING("line 17", previous->lines[12].message);
+    TEST_ASSERT_EQUAL_STRING("line 19", previous->lines[13].message);
+    TEST_ASSERT_EQUAL_STRING("line 20", previous->lines[14].message);
+}
+
+void test_crash_queues_a_summary_and_the_warnings_as_events() {
+    RetainedLog &log = RetainedLog::instance();
+    log.append(Logger::Info, "WiFi", "connected", 100);
+    log.append(Logger::Warn, "MQTT", "publish delayed", 42000);
+    log.pollTelemetry(40000, 90000, 51200, 800);
+
+    log.begin(ESP_RST_PANIC);
+    TEST_ASSERT_EQUAL_UINT32(2, log.queuePreviousEvents(7));
+    MqttEventQueue &queue = MqttEventQueue::instance();
+    TEST_ASSERT_EQUAL_UINT32(2, queue.size());
+    Logger::RecentEntry entry{};
+    TEST_ASSERT_TRUE(queue.pop(entry));
+    TEST_ASSERT_EQUAL(Logger::Error, entry.level);
+    TEST_ASSERT_EQUAL_STRING("PrevBoot", entry.tag);
+    TEST_ASSERT_EQUAL_UINT32(7, entry.ms);
+    TEST_ASSERT_EQUAL_STRING("previous boot ended by panic after 42 s; heap min 51200 B, loop max 0 ms",
+                             entry.message);
+    TEST_ASSERT_TRUE(queue.pop(entry));
+    TEST_ASSERT_EQUAL(Logger::Warn, entry.level);
+    TEST_ASSERT_EQUAL_STRING("MQTT: publish delayed", entry.message);
+}
+
+void test_clean_restart_is_shown_but_not_published() {
+    RetainedLog &log = RetainedLog::instance();
+    log.append(Logger::Error, "OTA", "write failed", 100);
+    log.begin(ESP_RST_SW);
+    const RetainedLog::Previous *previous = log.previous();
+    TEST_ASSERT_NOT_NULL(previous);
+    TEST_ASSERT_FALSE(previous->crashed);
+    TEST_ASSERT_EQUAL_UINT32(0, log.queuePreviousEvents(0));
+    TEST_ASSERT_EQUAL_UINT32(0, MqttEventQueue::instance().size());
+}
+
+void test_error_is_retained_before_the_drain_runs() {
+    RetainedLog &log = RetainedLog::instance();
+    Logger::setDeferredForTest(true);
+    LOGI("WiFi", "connected to %s", "home");
+    LOGE("Sensors", "SEN66 read failed (%d)", -3);
+    // No drain: the task watchdog fires while the records are still in the per-core rings.
+    log.begin(ESP_RST_TASK_WDT);
+    Logger::setDeferredForTest(false);
+    Logger::resetRecentForTest();
+
+    const RetainedLog::Previous *previous = log.previous();
+    TEST_ASSERT_NOT_NULL(previous);
+    TEST_ASSERT_EQUAL_UINT32(1, previous->line_count);
+    TEST_ASSERT_EQUAL(Logger::Error, previous->lines[0].level);
+    TEST_ASSERT_EQUAL_STRING("Sensors", previous->lines[0].tag);
+    TEST_ASSERT_EQUAL_STRING("SEN66 read failed (-3)", previous->lines[0].message);
+}
+
+void test_drained_info_lines_are_recovered_in_time_order() {
+    RetainedLog &log = RetainedLog::instance();
+    // The warning is retained as it is logged, the info line before it only when drained.
+    log.append(Logger::Warn, "MQTT", "publish delayed", 200);
+    log.append(Logger::Info, "WiFi", "connected", 100);
+
+    log.begin(ESP_RST_PANIC);
+    const RetainedLog::Previous *previous = log.previous();
+    TEST_ASSERT_NOT_NULL(previous);
+    TEST_ASSERT_EQUAL_UINT32(2, previous->line_count);
+    TEST_ASSERT_EQUAL_STRING("connected", previous->lines[0].message);
+    TEST_ASSERT_EQUAL_STRING("publish delayed", previous->lines[1].message);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_to_recover_after_an_empty_boot);
+    RUN_TEST(test_lines_and_samples_survive_a_crash_in_order);
+    RUN_TEST(test_ring_keeps_the_newest_lines_and_skips_torn_ones);
+    RUN_TEST(test_crash_queues_a_summary_and_the_warnings_as_events);
+    RUN_TEST(test_clean_restart_is_shown_but_not_published);
+    RUN_TEST(test_error_is_retained_before_the_drain_runs);
+    RUN_TEST(test_drained_info_lines_are_recovered_in_time_order);
+    return UNITY_END();
+}
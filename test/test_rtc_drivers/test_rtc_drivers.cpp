@@ -178,6 +178,22 @@ void test_ds3231_no_longer_matches_pcf8523_fallback_shape() {
     TEST_ASSERT_TRUE(ds3231.probe());
 }
 
+void test_ds3231_read_temperature_decodes_quarter_degrees() {
+    seedDs3231Signature();
+    const uint8_t warm[] = {0x19, 0x40};
+    I2cMock::setRegisters(Config::DS3231_ADDR, Config::DS3231_REG_TEMP_MSB, warm, sizeof(warm));
+
+    Ds3231 ds3231;
+    float celsius = 0.0f;
+    TEST_ASSERT_TRUE(ds3231.readTemperature(celsius));
+    TEST_ASSERT_EQUAL_FLOAT(25.25f, celsius);
+
+    const uint8_t cold[] = {0xFE, 0xC0};
+    I2cMock::setRegisters(Config::DS3231_ADDR, Config::DS3231_REG_TEMP_MSB, cold, sizeof(cold));
+    TEST_ASSERT_TRUE(ds3231.readTemperature(celsius));
+    TEST_ASSERT_EQUAL_FLOAT(-1.25f, celsius);
+}
+
 void test_ds3231_read_time_reports_osf_and_valid_time() {
     seedDs3231Signature();
     const uint8_t time_regs[] = {
@@ -254,6 +270,7 @@ int main(int, char **) {
     RUN_TEST(test_ds3231_probe_accepts_dirty_calendar_after_power_loss);
     RUN_TEST(test_pcf8523_can_only_match_weak_ds3231_signature_when_wrap_shape_collides);
     RUN_TEST(test_ds3231_no_longer_matches_pcf8523_fallback_shape);
+    RUN_TEST(test_ds3231_read_temperature_decodes_quarter_degrees);
     RUN_TEST(test_ds3231_read_time_reports_osf_and_valid_time);
     RUN_TEST(test_ds3231_read_time_rejects_malformed_bcd);
     RUN_TEST(test_pcf8523_read_time_rejects_malformed_bcd);
@@ -11,25 +11,17 @@
 #include "../../src/drivers/Sen66.h"
 #undef private
 
-#include "../../src/core/I2CHelper.cpp"
+#include "core/I2CHelper.h"
+#include "../../src/core/I2cScheduler.cpp"
 #include "../../src/drivers/Sen66.cpp"
 #undef Sen66
 
-namespace {
-
-void encodeWords(const uint16_t *words, size_t word_count, uint8_t *out) {
-    for (size_t i = 0; i < word_count; ++i) {
-        out[i * 3] = static_cast<uint8_t>(words[i] >> 8);
-        out[i * 3 + 1] = static_cast<uint8_t>(words[i] & 0xFF);
-        out[i * 3 + 2] = I2C::crc8(&out[i * 3], 2);
-    }
-}
-
-} // namespace
+// encodeWords() comes from the included Sen66.cpp.
 
 void setUp() {
     setMillis(0);
     I2cMock::reset();
+    I2cScheduler::instance().reset();
     Logger::begin(Serial, Logger::Debug);
     Logger::setSerialOutputEnabled(false);
     Logger::setSensorsSerialOutputEnabled(false);
@@ -38,28 +30,6 @@ void setUp() {
 
 void tearDown() {}
 
-void test_real_sen66_device_reset_clears_co2_smoother_ring() {
-    I2cMock::setDevicePresent(Config::SEN66_ADDR, true);
-
-    RealSen66 sen66;
-    TEST_ASSERT_TRUE(sen66.begin());
-
-    sen66.co2_first_ = false;
-    sen66.co2_idx_ = 3;
-    sen66.co2_readings_[0] = 1111;
-    sen66.co2_readings_[1] = 1222;
-    sen66.co2_readings_[2] = 1333;
-    sen66.co2_readings_[3] = 1444;
-    sen66.co2_readings_[4] = 1555;
-
-    TEST_ASSERT_TRUE(sen66.deviceReset());
-    TEST_ASSERT_TRUE(sen66.co2_first_);
-    TEST_ASSERT_EQUAL(0, sen66.co2_idx_);
-    for (int reading : sen66.co2_readings_) {
-        TEST_ASSERT_EQUAL(400, reading);
-    }
-}
-
 void test_real_sen66_apply_temp_offset_params_includes_base_self_heating() {
     I2cMock::setDevicePresent(Config::SEN66_ADDR, true);
 
@@ -125,11 +95,154 @@ void test_real_sen66_read_values_applies_remaining_temp_correction_when_hw_offse
     TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, data.humidity);
 }
 
+void test_real_sen66_poll_reads_values_without_blocking_the_caller() {
+    I2cMock::setDevicePresent(Config::SEN66_ADDR, true);
+
+    const uint16_t ready_words[1] = {0x0001};
+    uint8_t ready_buf[3] = {};
+    encodeWords(ready_words, 1, ready_buf);
+    I2cMock::setCommandRead(Config::SEN66_ADDR, Config::SEN66_CMD_DATA_READY,
+                            ready_buf, sizeof(ready_buf));
+    const uint16_t status_words[2] = {0, 0};
+    uint8_t status_buf[6] = {};
+    encodeWords(status_words, 2, status_buf);
+    I2cMock::setCommandRead(Config::SEN66_ADDR, Config::SEN66_CMD_READ_STATUS,
+                            status_buf, sizeof(status_buf));
+    const uint16_t value_words[9] = {100, 120, 130, 140, 4500, 4400, 1000, 200, 650};
+    uint8_t value_buf[27] = {};
+    encodeWords(value_words, 9, value_buf);
+    I2cMock::setCommandRead(Config::SEN66_ADDR, Config::SEN66_CMD_READ_VALUES,
+                            value_buf, sizeof(value_buf));
+    const uint16_t num_words[5] = {55, 0, 0, 0, 0};
+    uint8_t num_buf[15] = {};
+    encodeWords(num_words, 5, num_buf);
+    I2cMock::setCommandRead(Config::SEN66_ADDR, Config::SEN66_CMD_READ_NUM_CONC,
+                            num_buf, sizeof(num_buf));
+
+    RealSen66 sen66;
+    TEST_ASSERT_TRUE(sen66.begin());
+    sen66.ok_ = true;
+    sen66.measuring_ = true;
+
+    const uint32_t start_ms = Config::SEN66_STATUS_MS;
+    setMillis(start_ms);
+    SensorData data{};
+    bool changed = false;
+    uint32_t polls = 0;
+    while (!changed && polls < 100) {
+        sen66.poll(data, changed);
+        ++polls;
+        if (!changed) {
+            advanceMillis(5);
+        }
+    }
+
+    // Status, data-ready, values and number concentration each wait SEN66_CMD_DELAY_MS
+    // between command and read; the caller only ever sees the 5 ms steps it took itself.
+    TEST_ASSERT_TRUE(changed);
+    TEST_ASSERT_EQUAL_UINT32(start_ms + 4 * Config::SEN66_CMD_DELAY_MS, getMillis());
+    TEST_ASSERT_EQUAL_UINT32(start_ms, sen66.lastDataMs());
+    TEST_ASSERT_TRUE(data.co2_valid);
+    TEST_ASSERT_EQUAL(650, data.co2);
+    TEST_ASSERT_TRUE(data.pm05_valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 5.5f, data.pm05);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.0f, data.pm25);
+    TEST_ASSERT_EQUAL(100, data.voc_index);
+}
+
+void test_real_sen66_blocking_command_cancels_pending_poll_read() {
+    I2cMock::setDevicePresent(Config::SEN66_ADDR, true);
+
+    RealSen66 sen66;
+    TEST_ASSERT_TRUE(sen66.begin());
+    sen66.ok_ = true;
+    sen66.measuring_ = true;
+    sen66.last_status_ms_ = 0;
+
+    setMillis(Config::SEN66_POLL_MS);
+    SensorData data{};
+    bool changed = false;
+    sen66.poll(data, changed);
+    TEST_ASSERT_TRUE(I2cScheduler::instance().isAddressBusy(Config::SEN66_ADDR));
+
+    TEST_ASSERT_TRUE(sen66.deviceReset());
+    TEST_ASSERT_FALSE(I2cScheduler::instance().isAddressBusy(Config::SEN66_ADDR));
+    TEST_ASSERT_EQUAL_UINT32(0u, I2cScheduler::instance().activeCount());
+}
+
+void test_real_sen66_start_sequence_runs_on_the_scheduler() {
+    I2cMock::setDevicePresent(Config::SEN66_ADDR, true);
+    const uint16_t asc_words[1] = {0};
+    uint8_t asc_buf[3] = {};
+    encodeWords(asc_words, 1, asc_buf);
+    I2cMock::setCommandRead(Config::SEN66_ADDR, Config::SEN66_CMD_ASC, asc_buf, sizeof(asc_buf));
+
+    // A warm restart leaves the measurement state unknown, so the sequence starts with STOP.
+    boot_reset_reason = ESP_RST_SW;
+    RealSen66 sen66;
+    TEST_ASSERT_TRUE(sen66.begin());
+
+    const uint32_t start_ms = 1000;
+    setMillis(start_ms);
+    TEST_ASSERT_TRUE(sen66.beginStart(false));
+    TEST_ASSERT_TRUE(sen66.isBusy());
+    TEST_ASSERT_FALSE(sen66.beginStart(false));
+
+    SensorData data{};
+    bool changed = false;
+    RealSen66::StartResult result = RealSen66::StartResult::None;
+    uint32_t polls = 0;
+    while (result == RealSen66::StartResult::None && polls < 1000) {
+        advanceMillis(5);
+        sen66.poll(data, changed);
+        result = sen66.takeStartResult();
+        ++polls;
+    }
+
+    // STOP, temperature offset, ASC readback (already disabled) and START; the caller only
+    // ever sees its own 5 ms steps.
+    TEST_ASSERT_TRUE(result == RealSen66::StartResult::Started);
+    TEST_ASSERT_EQUAL_UINT32(start_ms + Config::SEN66_STOP_DELAY_MS + Config::SEN66_CMD_DELAY_MS +
+                                 Config::SEN66_CMD_DELAY_MS + Config::SEN66_START_DELAY_MS,
+                             getMillis());
+    TEST_ASSERT_TRUE(sen66.isOk());
+    TEST_ASSERT_TRUE(sen66.isMeasuring());
+    TEST_ASSERT_FALSE(sen66.isBusy());
+    TEST_ASSERT_TRUE(sen66.temp_offset_hw_active_);
+    TEST_ASSERT_TRUE(sen66.takeStartResult() == RealSen66::StartResult::None);
+}
+
+void test_real_sen66_start_sequence_reports_missing_sensor() {
+    I2cMock::setDevicePresent(Config::SEN66_ADDR, false);
+
+    RealSen66 sen66;
+    TEST_ASSERT_TRUE(sen66.begin());
+    setMillis(1000);
+    TEST_ASSERT_TRUE(sen66.beginStart(true));
+
+    SensorData data{};
+    bool changed = false;
+    RealSen66::StartResult result = sen66.takeStartResult();
+    for (uint32_t polls = 0; result == RealSen66::StartResult::None && polls < 100; ++polls) {
+        advanceMillis(5);
+        sen66.poll(data, changed);
+        result = sen66.takeStartResult();
+    }
+
+    TEST_ASSERT_TRUE(result == RealSen66::StartResult::Failed);
+    TEST_ASSERT_FALSE(sen66.isOk());
+    TEST_ASSERT_FALSE(sen66.isBusy());
+    TEST_ASSERT_EQUAL_UINT32(0u, I2cScheduler::instance().activeCount());
+}
+
 int main(int, char **) {
     UNITY_BEGIN();
-    RUN_TEST(test_real_sen66_device_reset_clears_co2_smoother_ring);
     RUN_TEST(test_real_sen66_apply_temp_offset_params_includes_base_self_heating);
     RUN_TEST(test_real_sen66_read_values_applies_remaining_temp_correction_when_hw_offset_is_stale);
+    RUN_TEST(test_real_sen66_poll_reads_values_without_blocking_the_caller);
+    RUN_TEST(test_real_sen66_blocking_command_cancels_pending_poll_read);
+    RUN_TEST(test_real_sen66_start_sequence_runs_on_the_scheduler);
+    RUN_TEST(test_real_sen66_start_sequence_reports_missing_sensor);
     return UNITY_END();
 }
 
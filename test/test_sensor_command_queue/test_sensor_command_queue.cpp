@@ -0,0 +1,119 @@
+#include <unity.h>
+
+#include <thread>
+
+#include "core/SensorCommandQueue.h"
+
+void setUp() {
+    SensorCommandQueue::instance().clear();
+}
+
+void tearDown() {
+    SensorCommandQueue::instance().clear();
+}
+
+void test_offsets_keep_only_latest_request() {
+    SensorCommandQueue &queue = SensorCommandQueue::instance();
+    queue.postOffsets(1.0f, 2.0f);
+    queue.postOffsets(-0.5f, 3.0f);
+
+    SensorCommandQueue::Offsets offsets;
+    TEST_ASSERT_TRUE(queue.takeOffsets(offsets));
+    TEST_ASSERT_EQUAL_FLOAT(-0.5f, offsets.temp_offset);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, offsets.hum_offset);
+    TEST_ASSERT_FALSE(queue.takeOffsets(offsets));
+}
+
+void test_voc_reset_is_taken_once() {
+    SensorCommandQueue &queue = SensorCommandQueue::instance();
+    TEST_ASSERT_FALSE(queue.takeVocReset());
+    queue.postVocReset();
+    queue.postVocReset();
+    TEST_ASSERT_TRUE(queue.takeVocReset());
+    TEST_ASSERT_FALSE(queue.takeVocReset());
+}
+
+void test_asc_result_is_handed_back_once() {
+    SensorCommandQueue &queue = SensorCommandQueue::instance();
+    queue.postAsc(true);
+
+    SensorCommandQueue::AscResult result;
+    TEST_ASSERT_FALSE(queue.takeAscResult(result));
+
+    bool enabled = false;
+    TEST_ASSERT_TRUE(queue.takeAsc(enabled));
+    TEST_ASSERT_TRUE(enabled);
+    queue.publishAscResult({true, true});
+
+    TEST_ASSERT_TRUE(queue.takeAscResult(result));
+    TEST_ASSERT_TRUE(result.requested_enabled);
+    TEST_ASSERT_TRUE(result.ok);
+    TEST_ASSERT_FALSE(queue.takeAscResult(result));
+}
+
+void test_newer_asc_request_supersedes_running_result() {
+    SensorCommandQueue &queue = SensorCommandQueue::instance();
+    bool enabled = false;
+    queue.postAsc(true);
+    TEST_ASSERT_TRUE(queue.takeAsc(enabled));
+    queue.postAsc(false);
+    queue.publishAscResult({true, true});
+
+    SensorCommandQueue::AscResult result;
+    TEST_ASSERT_FALSE(queue.takeAscResult(result));
+    TEST_ASSERT_TRUE(queue.takeAsc(enabled));
+    TEST_ASSERT_FALSE(enabled);
+    queue.publishAscResult({false, false});
+    TEST_ASSERT_TRUE(queue.takeAscResult(result));
+    TEST_ASSERT_FALSE(result.requested_enabled);
+    TEST_ASSERT_FALSE(result.ok);
+}
+
+void test_frc_request_and_result_round_trip() {
+    SensorCommandQueue &queue = SensorCommandQueue::instance();
+    SensorCommandQueue::Frc request;
+    request.ref_ppm = 420;
+    request.has_pressure = true;
+    request.pressure_hpa = 1009.5f;
+    queue.postFrc(request);
+
+    SensorCommandQueue::Frc taken;
+    TEST_ASSERT_TRUE(queue.takeFrc(taken));
+    TEST_ASSERT_EQUAL_UINT16(420, taken.ref_ppm);
+    TEST_ASSERT_TRUE(taken.has_pressure);
+    TEST_ASSERT_EQUAL_FLOAT(1009.5f, taken.pressure_hpa);
+    TEST_ASSERT_FALSE(queue.takeFrc(taken));
+
+    queue.publishFrcResult({true, 32768});
+    SensorCommandQueue::FrcResult result;
+    TEST_ASSERT_TRUE(queue.takeFrcResult(result));
+    TEST_ASSERT_TRUE(result.ok);
+    TEST_ASSERT_EQUAL_UINT16(32768, result.correction);
+}
+
+void test_posting_does_not_wait_for_a_running_command() {
+    // The acquisition side only holds the lock to take a request, never while it runs it,
+    // so a post from another thread lands while the command is still in progress.
+    SensorCommandQueue &queue = SensorCommandQueue::instance();
+    queue.postAsc(true);
+    bool enabled = false;
+    TEST_ASSERT_TRUE(queue.takeAsc(enabled));
+
+    std::thread poster([&queue]() { queue.postOffsets(0.5f, 1.0f); });
+    poster.join();
+
+    SensorCommandQueue::Offsets offsets;
+    TEST_ASSERT_TRUE(queue.takeOffsets(offsets));
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, offsets.temp_offset);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_offsets_keep_only_latest_request);
+    RUN_TEST(test_voc_reset_is_taken_once);
+    RUN_TEST(test_asc_result_is_handed_back_once);
+    RUN_TEST(test_newer_asc_request_supersedes_running_result);
+    RUN_TEST(test_frc_request_and_result_round_trip);
+    RUN_TEST(test_posting_does_not_wait_for_a_running_command);
+    return UNITY_END();
+}
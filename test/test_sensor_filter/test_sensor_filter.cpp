@@ -0,0 +1,189 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "config/AppConfig.h"
+#include "core/SensorFilter.h"
+
+namespace {
+
+constexpr Config::MetricFilterConfig kMedianOnly = {3, 0, 0.0f, 0.0f, 0.0f};
+constexpr Config::MetricFilterConfig kEmaHalf = {1, 16384, 0.0f, 0.0f, 0.0f};
+constexpr Config::MetricFilterConfig kKalmanOnly = {1, 0, 0.0004f, 0.01f, 0.0f};
+
+// Deterministic +/-amplitude noise so the statistics do not depend on a random seed.
+float noise(int i, float amplitude) {
+    static const float kPattern[] = {0.9f, -0.4f, 0.1f, -1.0f, 0.6f, -0.2f, 0.8f, -0.7f};
+    return kPattern[i % 8] * amplitude;
+}
+
+} // namespace
+
+void setUp() {
+    SensorFilters::instance().reset();
+}
+
+void tearDown() {}
+
+void test_first_sample_passes_through() {
+    MetricFilter filter;
+    filter.configure(Config::METRIC_FILTER_CO2);
+    TEST_ASSERT_FALSE(filter.primed());
+    TEST_ASSERT_EQUAL_FLOAT(812.0f, filter.apply(812.0f));
+    TEST_ASSERT_TRUE(filter.primed());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 812.0f, filter.value());
+}
+
+void test_median_rejects_single_spike() {
+    MetricFilter filter;
+    filter.configure(kMedianOnly);
+    filter.apply(10.0f);
+    filter.apply(10.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f, filter.apply(90.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 11.0f, filter.apply(11.0f));
+
+    // Two in a row are a real change and get through.
+    filter.apply(40.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f, filter.apply(40.0f));
+}
+
+void test_ema_moves_by_alpha_and_converges() {
+    MetricFilter filter;
+    filter.configure(kEmaHalf);
+    filter.apply(0.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 5.0f, filter.apply(10.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 7.5f, filter.apply(10.0f));
+    float value = 0.0f;
+    for (int i = 0; i < 30; ++i) {
+        value = filter.apply(10.0f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f, value);
+}
+
+void test_ema_handles_negative_values() {
+    MetricFilter filter;
+    filter.configure(kEmaHalf);
+    filter.apply(-4.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -7.0f, filter.apply(-10.0f));
+}
+
+void test_kalman_reduces_noise() {
+    MetricFilter filter;
+    filter.configure(kKalmanOnly);
+    constexpr float kTruth = 22.5f;
+    double raw_error = 0.0;
+    double filtered_error = 0.0;
+    for (int i = 0; i < 400; ++i) {
+        const float raw = kTruth + noise(i, 0.1f);
+        const float value = filter.apply(raw);
+        if (i >= 50) {
+            raw_error += std::fabs(raw - kTruth);
+            filtered_error += std::fabs(value - kTruth);
+        }
+    }
+    TEST_ASSERT_TRUE(filtered_error < raw_error * 0.5);
+}
+
+void test_step_above_reset_threshold_restarts_chain() {
+    MetricFilter filter;
+    filter.configure(Config::METRIC_FILTER_CO2);
+    for (int i = 0; i < 10; ++i) {
+        filter.apply(600.0f);
+    }
+    // The median needs two samples to accept the step; then the chain jumps straight there.
+    filter.apply(1200.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 1200.0f, filter.apply(1200.0f));
+
+    // A small step below the threshold is smoothed instead.
+    filter.apply(1250.0f);
+    const float smoothed = filter.apply(1250.0f);
+    TEST_ASSERT_TRUE(smoothed > 1200.0f && smoothed < 1250.0f);
+}
+
+void test_reset_forgets_history() {
+    MetricFilter filter;
+    filter.configure(kEmaHalf);
+    filter.apply(100.0f);
+    filter.reset();
+    TEST_ASSERT_FALSE(filter.primed());
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, filter.apply(3.0f));
+}
+
+void test_non_finite_sample_is_returned_without_touching_state() {
+    MetricFilter filter;
+    filter.configure(kEmaHalf);
+    filter.apply(8.0f);
+    TEST_ASSERT_TRUE(std::isnan(filter.apply(NAN)));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 8.0f, filter.value());
+}
+
+void test_off_config_is_identity_within_fixed_point_step() {
+    MetricFilter filter;
+    filter.configure(Config::METRIC_FILTER_OFF);
+    filter.apply(1013.25f);
+    TEST_ASSERT_FLOAT_WITHIN(0.004f, 1009.71f, filter.apply(1009.71f));
+}
+
+void test_snapshot_reports_raw_and_filtered_values() {
+    SensorFilters &filters = SensorFilters::instance();
+    filters.publish(SensorFilters::METRIC_CO2, true, 905.0f, 880.0f);
+
+    SensorFilters::Snapshot snapshot;
+    filters.snapshot(snapshot);
+    const SensorFilters::Entry &co2 = snapshot.metrics[SensorFilters::METRIC_CO2];
+    TEST_ASSERT_TRUE(co2.valid);
+    TEST_ASSERT_EQUAL_FLOAT(905.0f, co2.raw);
+    TEST_ASSERT_EQUAL_FLOAT(880.0f, co2.value);
+    TEST_ASSERT_FALSE(snapshot.metrics[SensorFilters::METRIC_PM25].valid);
+    TEST_ASSERT_EQUAL_STRING("co2", SensorFilters::metricName(SensorFilters::METRIC_CO2));
+    TEST_ASSERT_EQUAL_FLOAT(Config::METRIC_FILTER_HUM.kalman_r,
+                            SensorFilters::defaultConfig(SensorFilters::METRIC_HUMIDITY).kalman_r);
+}
+
+void test_per_sample_cost() {
+    struct Case {
+        const char *name;
+        Config::MetricFilterConfig config;
+    };
+    const Case cases[] = {
+        {"median3+ema", Config::METRIC_FILTER_CO2},
+        {"kalman", Config::METRIC_FILTER_TEMP},
+        {"median5+kalman+ema", {5, 9830, 0.01f, 0.25f, 5.0f}},
+    };
+    constexpr int kSamples = 200000;
+    for (const Case &c : cases) {
+        MetricFilter filter;
+        filter.configure(c.config);
+        float sink = 0.0f;
+        const auto started = std::chrono::steady_clock::now();
+        for (int i = 0; i < kSamples; ++i) {
+            sink += filter.apply(500.0f + noise(i, 3.0f));
+        }
+        const double ns = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - started).count() / kSamples;
+
+        char report[120];
+        snprintf(report, sizeof(report), "%s: %.1f ns/sample (sink=%.0f)", c.name, ns, sink);
+        TEST_MESSAGE(report);
+        // Generous bound; the point is the report, not host speed.
+        TEST_ASSERT_TRUE(ns < 2000.0);
+    }
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_sample_passes_through);
+    RUN_TEST(test_median_rejects_single_spike);
+    RUN_TEST(test_ema_moves_by_alpha_and_converges);
+    RUN_TEST(test_ema_handles_negative_values);
+    RUN_TEST(test_kalman_reduces_noise);
+    RUN_TEST(test_step_above_reset_threshold_restarts_chain);
+    RUN_TEST(test_reset_forgets_history);
+    RUN_TEST(test_non_finite_sample_is_returned_without_touching_state);
+    RUN_TEST(test_off_config_is_identity_within_fixed_point_step);
+    RUN_TEST(test_snapshot_reports_raw_and_filtered_values);
+    RUN_TEST(test_per_sample_cost);
+    return UNITY_END();
+}
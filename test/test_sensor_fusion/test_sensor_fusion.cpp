@@ -0,0 +1,227 @@
+#include <unity.h>
+
+#include "config/AppConfig.h"
+#include "core/SensorFusion.h"
+#include "core/SensorHealth.h"
+
+namespace {
+
+constexpr uint32_t kStaleMs = 1000;
+
+FusedQuantity::SourceConfig source(const char *name, float sigma, bool needs_reference) {
+    return {name, sigma, kStaleMs, needs_reference};
+}
+
+} // namespace
+
+void setUp() {
+    SensorFusion::instance().reset();
+}
+
+void tearDown() {}
+
+void test_health_goes_stale_after_stale_ms() {
+    SensorHealth health(100, 300, 1000);
+    TEST_ASSERT_FALSE(health.isStale(5000));
+    health.noteSample(1000);
+    TEST_ASSERT_FALSE(health.isStale(1100));
+    TEST_ASSERT_TRUE(health.isStale(1101));
+    TEST_ASSERT_EQUAL_UINT32(1000, health.lastSampleMs());
+}
+
+void test_health_requests_recovery_after_no_data_streak_with_cooldown() {
+    SensorHealth health(100, 300, 1000);
+    health.noteSample(0);
+    TEST_ASSERT_FALSE(health.noteMiss(100));
+    TEST_ASSERT_FALSE(health.noteMiss(399));
+    TEST_ASSERT_TRUE(health.noteMiss(400));
+    TEST_ASSERT_EQUAL_UINT16(3, health.missCount());
+
+    TEST_ASSERT_TRUE(health.takeRecoverSlot(1400));
+    TEST_ASSERT_FALSE(health.takeRecoverSlot(1500));
+    TEST_ASSERT_TRUE(health.takeRecoverSlot(2400));
+    TEST_ASSERT_EQUAL_UINT16(2, health.recoverCount());
+
+    // A sample ends the streak; restart() keeps the counters for diagnostics.
+    health.noteSample(2500);
+    TEST_ASSERT_FALSE(health.noteMiss(2600));
+    health.restart();
+    TEST_ASSERT_FALSE(health.hasSample());
+    TEST_ASSERT_EQUAL_UINT16(4, health.missCount());
+    health.reset();
+    TEST_ASSERT_EQUAL_UINT16(0, health.missCount());
+}
+
+void test_single_source_passes_through() {
+    FusedQuantity fused;
+    const size_t ref = fused.addSource(source("ref", 0.1f, false));
+    float value = 0.0f;
+    TEST_ASSERT_FALSE(fused.fuse(0, value));
+
+    fused.update(ref, 21.5f, 100);
+    TEST_ASSERT_TRUE(fused.fuse(150, value));
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, value);
+}
+
+void test_weights_follow_sigma() {
+    FusedQuantity fused;
+    const size_t a = fused.addSource(source("a", 0.1f, false));
+    const size_t b = fused.addSource(source("b", 0.2f, false));
+    fused.update(a, 10.0f, 0);
+    // b is calibrated against a on its first sample, so feed it a consistent offset first.
+    fused.update(b, 10.0f, 0);
+    fused.update(a, 10.0f, 10);
+    fused.update(b, 10.0f, 10);
+
+    FusedQuantity::SourceState state;
+    fused.sourceState(a, 10, state);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.8f, state.weight);
+    fused.sourceState(b, 10, state);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, state.weight);
+}
+
+void test_secondary_bias_is_learned_and_removed_on_failover() {
+    FusedQuantity fused;
+    const size_t ref = fused.addSource(source("sen66", 0.1f, false));
+    const size_t chip = fused.addSource(source("chip", 0.3f, true));
+
+    fused.update(ref, 21.0f, 0);
+    fused.update(chip, 24.0f, 0);
+    float value = 0.0f;
+    TEST_ASSERT_TRUE(fused.fuse(0, value));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 21.0f, value);
+
+    // The reference stops; the chip keeps the output where it was and follows its own trend.
+    fused.update(chip, 24.5f, kStaleMs + 1);
+    TEST_ASSERT_TRUE(fused.fuse(kStaleMs + 1, value));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 21.5f, value);
+
+    FusedQuantity::SourceState state;
+    fused.sourceState(ref, kStaleMs + 1, state);
+    TEST_ASSERT_FALSE(state.fresh);
+    fused.sourceState(chip, kStaleMs + 1, state);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, state.weight);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.0f, state.bias);
+}
+
+void test_uncalibrated_secondary_is_ignored_when_reference_is_required() {
+    FusedQuantity fused;
+    fused.addSource(source("sen66", 0.1f, false));
+    const size_t chip = fused.addSource(source("chip", 0.3f, true));
+    fused.update(chip, 30.0f, 0);
+    float value = 0.0f;
+    TEST_ASSERT_FALSE(fused.fuse(0, value));
+}
+
+void test_faults_scale_weight_and_decay_on_good_samples() {
+    FusedQuantity fused;
+    const size_t a = fused.addSource(source("a", 0.1f, false));
+    const size_t b = fused.addSource(source("b", 0.1f, false));
+    fused.update(a, 5.0f, 0);
+    fused.update(b, 5.0f, 0);
+
+    fused.noteFaults(b, 2);
+    FusedQuantity::SourceState state;
+    fused.sourceState(b, 0, state);
+    TEST_ASSERT_EQUAL_UINT16(2, state.faults);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, state.weight);
+
+    fused.noteFaults(b, 1000);
+    fused.sourceState(b, 0, state);
+    TEST_ASSERT_EQUAL_UINT16(Config::FUSION_MAX_FAULTS, state.faults);
+
+    fused.update(b, 5.0f, 10);
+    fused.sourceState(b, 10, state);
+    TEST_ASSERT_EQUAL_UINT16(Config::FUSION_MAX_FAULTS - 1, state.faults);
+}
+
+void test_dropped_source_leaves_fusion_immediately() {
+    FusedQuantity fused;
+    const size_t a = fused.addSource(source("a", 0.1f, false));
+    const size_t b = fused.addSource(source("b", 0.1f, false));
+    fused.update(a, 1000.0f, 0);
+    fused.update(b, 1001.0f, 0);
+    fused.drop(b);
+
+    float value = 0.0f;
+    TEST_ASSERT_TRUE(fused.fuse(0, value));
+    TEST_ASSERT_EQUAL_FLOAT(1000.0f, value);
+    fused.drop(a);
+    TEST_ASSERT_FALSE(fused.fuse(0, value));
+}
+
+void test_noisy_source_loses_weight() {
+    FusedQuantity fused;
+    const size_t steady = fused.addSource(source("steady", 0.1f, false));
+    const size_t noisy = fused.addSource(source("noisy", 0.1f, false));
+    float value = 0.0f;
+    for (uint32_t i = 0; i < 40; ++i) {
+        fused.update(steady, 50.0f, i);
+        fused.update(noisy, (i % 2) ? 51.0f : 49.0f, i);
+        fused.fuse(i, value);
+    }
+    FusedQuantity::SourceState state;
+    fused.sourceState(noisy, 39, state);
+    TEST_ASSERT_TRUE(state.weight < 0.1f);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 50.0f, value);
+}
+
+void test_source_table_is_bounded() {
+    FusedQuantity fused;
+    for (size_t i = 0; i < FusedQuantity::kMaxSources; ++i) {
+        TEST_ASSERT_EQUAL_UINT32(i, fused.addSource(source("s", 1.0f, false)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(FusedQuantity::kMaxSources, fused.addSource(source("s", 1.0f, false)));
+    fused.update(FusedQuantity::kMaxSources, 1.0f, 0);
+    fused.noteFaults(FusedQuantity::kMaxSources);
+}
+
+void test_rtc_inbox_delivers_latest_sample_once() {
+    SensorFusion &fusion = SensorFusion::instance();
+    float celsius = 0.0f;
+    uint32_t sample_ms = 0;
+    TEST_ASSERT_FALSE(fusion.takeRtcTemperature(celsius, sample_ms));
+
+    fusion.postRtcTemperature(24.0f, 100);
+    fusion.postRtcTemperature(24.25f, 200);
+    TEST_ASSERT_TRUE(fusion.takeRtcTemperature(celsius, sample_ms));
+    TEST_ASSERT_EQUAL_FLOAT(24.25f, celsius);
+    TEST_ASSERT_EQUAL_UINT32(200, sample_ms);
+    TEST_ASSERT_FALSE(fusion.takeRtcTemperature(celsius, sample_ms));
+}
+
+void test_snapshot_reports_published_sources() {
+    FusedQuantity fused;
+    const size_t ref = fused.addSource(source("bmp58x", 0.05f, false));
+    fused.update(ref, 1003.2f, 0);
+    SensorFusion::instance().publish(SensorFusion::QUANTITY_PRESSURE, fused, true, 1003.2f, 0);
+
+    SensorFusion::Snapshot snapshot;
+    SensorFusion::instance().snapshot(snapshot);
+    const SensorFusion::Snapshot::Entry &pressure =
+        snapshot.quantities[SensorFusion::QUANTITY_PRESSURE];
+    TEST_ASSERT_TRUE(pressure.valid);
+    TEST_ASSERT_EQUAL_UINT32(1, pressure.source_count);
+    TEST_ASSERT_EQUAL_STRING("bmp58x", pressure.sources[0].name);
+    TEST_ASSERT_TRUE(pressure.sources[0].fresh);
+    TEST_ASSERT_FALSE(snapshot.quantities[SensorFusion::QUANTITY_TEMPERATURE].valid);
+    TEST_ASSERT_EQUAL_STRING("pressure",
+                             SensorFusion::quantityName(SensorFusion::QUANTITY_PRESSURE));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_health_goes_stale_after_stale_ms);
+    RUN_TEST(test_health_requests_recovery_after_no_data_streak_with_cooldown);
+    RUN_TEST(test_single_source_passes_through);
+    RUN_TEST(test_weights_follow_sigma);
+    RUN_TEST(test_secondary_bias_is_learned_and_removed_on_failover);
+    RUN_TEST(test_uncalibrated_secondary_is_ignored_when_reference_is_required);
+    RUN_TEST(test_faults_scale_weight_and_decay_on_good_samples);
+    RUN_TEST(test_dropped_source_leaves_fusion_immediately);
+    RUN_TEST(test_noisy_source_loses_weight);
+    RUN_TEST(test_source_table_is_bounded);
+    RUN_TEST(test_rtc_inbox_delivers_latest_sample_once);
+    RUN_TEST(test_snapshot_reports_published_sources);
+    return UNITY_END();
+}
@@ -6,6 +6,10 @@
 #include "config/AppConfig.h"
 #include "core/BootState.h"
 #include "core/Logger.h"
+#include "core/SensorFilter.h"
+#include "core/SensorFusion.h"
+#include "core/SensorPollRate.h"
+#include "core/SensorTiming.h"
 #include "modules/PressureHistory.h"
 #include "modules/SensorManager.h"
 #include "modules/StorageManager.h"
@@ -41,6 +45,10 @@ void setUp() {
     Logger::resetRecentForTest();
     boot_reset_reason = ESP_RST_POWERON;
     resetDriverStates();
+    SensorPollRates::instance().reset();
+    SensorFilters::instance().reset();
+    SensorFusion::instance().reset();
+    SensorTiming::instance().reset();
 }
 
 void tearDown() {
@@ -104,6 +112,56 @@ void test_sensor_manager_poll_updates_data() {
     TEST_ASSERT_FLOAT_WITHIN(0.01f, 1012.5f, Sen66::state().last_pressure);
 }
 
+void test_sensor_manager_stamps_fresh_samples_per_source() {
+    setMillis(Config::PRESSURE_HISTORY_STEP_MS);
+
+    StorageManager storage;
+    storage.begin();
+    PressureHistory history;
+    SensorManager manager;
+    SensorData data;
+
+    Bmp580::state().start_ok = false;
+    Bmp3xx::state().start_ok = false;
+    manager.begin(storage, 0.0f, 0.0f);
+
+    auto &sen = Sen66::state();
+    sen.provide_data = true;
+    sen.update_last_data_on_poll = true;
+    sen.poll_data.co2_valid = true;
+    sen.poll_data.co2 = 600;
+    auto &dps = Dps310::state();
+    dps.has_new_data = true;
+    dps.pressure = 1001.0f;
+    dps.temperature = 22.0f;
+
+    advanceMicros(250);
+    const uint64_t ready_us =
+        static_cast<uint64_t>(Config::PRESSURE_HISTORY_STEP_MS) * 1000ULL + 250ULL;
+    manager.poll(data, storage, history, true);
+
+    const SampleStamp &sen66 = data.stamps[SENSOR_SOURCE_SEN66];
+    TEST_ASSERT_TRUE(sen66.ready_us == ready_us);
+    TEST_ASSERT_EQUAL_UINT32(Config::TIME_VALID_EPOCH + 1000, sen66.epoch);
+    TEST_ASSERT_TRUE(data.stamps[SENSOR_SOURCE_PRESSURE].ready_us == ready_us);
+    TEST_ASSERT_TRUE(data.stamps[SENSOR_SOURCE_CO].ready_us == 0);
+    TEST_ASSERT_EQUAL_UINT32(0, data.stamps[SENSOR_SOURCE_CO].epoch);
+
+    // Without a valid wall clock the sample still gets its monotonic stamp.
+    setNowEpoch(0);
+    advanceMillis(1000);
+    dps.has_new_data = true;
+    dps.pressure = 1001.2f;
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_TRUE(data.stamps[SENSOR_SOURCE_PRESSURE].ready_us == ready_us + 1000000ULL);
+    TEST_ASSERT_EQUAL_UINT32(0, data.stamps[SENSOR_SOURCE_PRESSURE].epoch);
+
+    SensorTiming::Snapshot timing;
+    SensorTiming::instance().snapshot(timing);
+    TEST_ASSERT_EQUAL_UINT32(1, timing.intervals[SENSOR_SOURCE_PRESSURE].count);
+    TEST_ASSERT_EQUAL_UINT32(1000000, timing.intervals[SENSOR_SOURCE_PRESSURE].last_us);
+}
+
 void test_sensor_manager_warmup_change() {
     StorageManager storage;
     storage.begin();
@@ -793,9 +851,236 @@ void test_sensor_manager_stale_resets_temp_warning_state() {
     TEST_ASSERT_TRUE(recentContainsMessagePrefix("Temperature outside recommended range:"));
 }
 
+void test_sensor_manager_backs_off_stable_sen66_and_snaps_back_on_demand() {
+    StorageManager storage;
+    storage.begin();
+    PressureHistory history;
+    SensorManager manager;
+    SensorData data;
+
+    manager.begin(storage, 0.0f, 0.0f);
+
+    auto &sen = Sen66::state();
+    sen.provide_data = true;
+    sen.poll_changed = true;
+    sen.update_last_data_on_poll = true;
+    sen.poll_data.co2_valid = true;
+    sen.poll_data.co2 = 650;
+    sen.poll_data.temp_valid = true;
+    sen.poll_data.temperature = 22.0f;
+
+    uint32_t now = 1000;
+    for (int i = 0; i < 1 + Config::ADAPTIVE_POLL_STABLE_SAMPLES; ++i) {
+        setMillis(now);
+        manager.poll(data, storage, history, true);
+        now += Config::SEN66_POLL_MS;
+    }
+    TEST_ASSERT_EQUAL_UINT32(Config::SEN66_POLL_MS, sen.poll_interval_ms);
+    setMillis(now);
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_EQUAL_UINT32(Config::SEN66_POLL_MS * 2, sen.poll_interval_ms);
+
+    SensorPollRates::Snapshot snapshot;
+    SensorPollRates::instance().snapshot(snapshot, now);
+    TEST_ASSERT_TRUE(snapshot.sensors[SensorPollRates::SENSOR_SEN66].active);
+    TEST_ASSERT_EQUAL_UINT32(Config::SEN66_POLL_MS * 2,
+                             snapshot.sensors[SensorPollRates::SENSOR_SEN66].interval_ms);
+
+    SensorPollRates::instance().setDemand(SensorPollRates::DEMAND_GRAPH, true);
+    now += Config::SEN66_POLL_MS * 2;
+    setMillis(now);
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_EQUAL_UINT32(Config::SEN66_POLL_MS, sen.poll_interval_ms);
+    SensorPollRates::instance().setDemand(SensorPollRates::DEMAND_GRAPH, false);
+
+    // A real change after backing off again goes straight back to the fast rate.
+    for (int i = 0; i < Config::ADAPTIVE_POLL_STABLE_SAMPLES + 1; ++i) {
+        now += Config::SEN66_POLL_MS;
+        setMillis(now);
+        manager.poll(data, storage, history, true);
+    }
+    TEST_ASSERT_EQUAL_UINT32(Config::SEN66_POLL_MS * 2, sen.poll_interval_ms);
+    // The step needs two samples to clear the CO2 median stage; the new interval reaches the
+    // driver on the pass after that.
+    sen.poll_data.co2 = 900;
+    for (int i = 0; i < 2; ++i) {
+        now += Config::SEN66_POLL_MS * 2;
+        setMillis(now);
+        manager.poll(data, storage, history, true);
+    }
+    TEST_ASSERT_EQUAL(900, data.co2);
+    now += Config::SEN66_POLL_MS;
+    setMillis(now);
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_EQUAL_UINT32(Config::SEN66_POLL_MS, sen.poll_interval_ms);
+}
+
+void test_sensor_manager_filters_sen66_spike_and_publishes_raw_value() {
+    StorageManager storage;
+    storage.begin();
+    PressureHistory history;
+    SensorManager manager;
+    SensorData data;
+
+    manager.begin(storage, 0.0f, 0.0f);
+
+    auto &sen = Sen66::state();
+    sen.provide_data = true;
+    sen.update_last_data_on_poll = true;
+    sen.poll_data.co2_valid = true;
+    sen.poll_data.co2 = 800;
+
+    uint32_t now = 1000;
+    for (int i = 0; i < 3; ++i) {
+        setMillis(now);
+        manager.poll(data, storage, history, true);
+        now += Config::SEN66_POLL_MS;
+    }
+    TEST_ASSERT_EQUAL(800, data.co2);
+
+    sen.poll_data.co2 = 1400;
+    setMillis(now);
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_EQUAL(800, data.co2);
+
+    SensorFilters::Snapshot snapshot;
+    SensorFilters::instance().snapshot(snapshot);
+    const SensorFilters::Entry &co2 = snapshot.metrics[SensorFilters::METRIC_CO2];
+    TEST_ASSERT_TRUE(co2.valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1400.0f, co2.raw);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 800.0f, co2.value);
+
+    // A device reset drops the history, so the next sample is taken as is.
+    TEST_ASSERT_TRUE(manager.deviceReset());
+    sen.poll_data.co2 = 900;
+    now += Config::SEN66_POLL_MS;
+    setMillis(now);
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_EQUAL(900, data.co2);
+}
+
+void test_sensor_manager_holds_filtered_co_between_samples() {
+    StorageManager storage;
+    storage.begin();
+    PressureHistory history;
+    SensorManager manager;
+    SensorData data;
+
+    auto &co = Sen0466::state();
+    co.start_ok = true;
+    co.data_valid = true;
+    co.co_ppm = 2.0f;
+    co.last_data_ms = 1000;
+
+    manager.begin(storage, 0.0f, 0.0f);
+    setMillis(1000);
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_TRUE(data.co_valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.0f, data.co_ppm);
+
+    // One outlying sample is rejected by the median stage...
+    co.co_ppm = 6.0f;
+    co.last_data_ms = 4000;
+    setMillis(4000);
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.0f, data.co_ppm);
+
+    // ...and the filtered value stays put while the driver keeps reporting the raw one.
+    setMillis(4500);
+    SensorManager::PollResult result = manager.poll(data, storage, history, true);
+    TEST_ASSERT_FALSE(result.data_changed);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.0f, data.co_ppm);
+}
+
+void test_sensor_manager_pressure_fails_over_without_gap() {
+    StorageManager storage;
+    storage.begin();
+    PressureHistory history;
+    SensorManager manager;
+    SensorData data;
+
+    setMillis(1000);
+    Bmp3xx::state().start_ok = false;
+    manager.begin(storage, 0.0f, 0.0f);
+    TEST_ASSERT_EQUAL(SensorManager::PRESSURE_BMP58X, manager.pressureSensorType());
+
+    auto &bmp = Bmp580::state();
+    auto &dps = Dps310::state();
+    bmp.has_new_data = true;
+    bmp.pressure = 1000.0f;
+    dps.has_new_data = true;
+    dps.pressure = 1000.6f;
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_TRUE(data.pressure_valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1000.0f, data.pressure);
+
+    // The BMP580 goes quiet; the DPS310 carries on with its learned offset removed and the
+    // reading never drops out, including after the BMP580 sample expires.
+    for (uint32_t step = 1; step <= 4; ++step) {
+        setMillis(1000 + step * Config::DPS310_POLL_MS);
+        dps.has_new_data = true;
+        manager.poll(data, storage, history, true);
+        TEST_ASSERT_TRUE(data.pressure_valid);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, 1000.0f, data.pressure);
+    }
+
+    SensorFusion::Snapshot snapshot;
+    SensorFusion::instance().snapshot(snapshot);
+    const SensorFusion::Snapshot::Entry &pressure =
+        snapshot.quantities[SensorFusion::QUANTITY_PRESSURE];
+    TEST_ASSERT_EQUAL_UINT32(2, pressure.source_count);
+    TEST_ASSERT_EQUAL_STRING("bmp58x", pressure.sources[0].name);
+    TEST_ASSERT_FALSE(pressure.sources[0].fresh);
+    TEST_ASSERT_TRUE(pressure.sources[1].fresh);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, pressure.sources[1].weight);
+}
+
+void test_sensor_manager_temperature_survives_stale_sen66() {
+    StorageManager storage;
+    storage.begin();
+    PressureHistory history;
+    SensorManager manager;
+    SensorData data;
+
+    Bmp580::state().start_ok = false;
+    Bmp3xx::state().start_ok = false;
+    manager.begin(storage, 0.0f, 0.0f);
+
+    auto &sen = Sen66::state();
+    sen.provide_data = true;
+    sen.poll_changed = true;
+    sen.update_last_data_on_poll = true;
+    sen.poll_data.temp_valid = true;
+    sen.poll_data.temperature = 21.0f;
+    sen.poll_data.co2_valid = true;
+    sen.poll_data.co2 = 600;
+    auto &dps = Dps310::state();
+    dps.pressure = 1005.0f;
+    dps.temperature = 24.0f;
+
+    setMillis(Config::SEN66_POLL_MS);
+    dps.has_new_data = true;
+    manager.poll(data, storage, history, true);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 21.0f, data.temperature);
+
+    sen.provide_data = false;
+    sen.poll_changed = false;
+    sen.update_last_data_on_poll = false;
+    setMillis(sen.last_data_ms + Config::SEN66_STALE_MS + 1);
+    dps.has_new_data = true;
+    dps.temperature = 24.2f;
+    SensorManager::PollResult result = manager.poll(data, storage, history, true);
+
+    TEST_ASSERT_TRUE(result.data_changed);
+    TEST_ASSERT_FALSE(data.co2_valid);
+    TEST_ASSERT_TRUE(data.temp_valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 21.2f, data.temperature);
+}
+
 int main(int, char **) {
     UNITY_BEGIN();
     RUN_TEST(test_sensor_manager_poll_updates_data);
+    RUN_TEST(test_sensor_manager_stamps_fresh_samples_per_source);
     RUN_TEST(test_sensor_manager_warmup_change);
     RUN_TEST(test_sensor_manager_stale_preserves_other_sensor_data);
     RUN_TEST(test_sensor_manager_pm05_clamps_to_sensor_limit);
@@ -824,5 +1109,10 @@ int main(int, char **) {
     RUN_TEST(test_sensor_manager_bmp3xx_label_reports_bmp390);
     RUN_TEST(test_sensor_manager_falls_back_to_dps310_after_bmp_families_fail);
     RUN_TEST(test_sensor_manager_stale_resets_temp_warning_state);
+    RUN_TEST(test_sensor_manager_backs_off_stable_sen66_and_snaps_back_on_demand);
+    RUN_TEST(test_sensor_manager_filters_sen66_spike_and_publishes_raw_value);
+    RUN_TEST(test_sensor_manager_holds_filtered_co_between_samples);
+    RUN_TEST(test_sensor_manager_pressure_fails_over_without_gap);
+    RUN_TEST(test_sensor_manager_temperature_survives_stale_sen66);
     return UNITY_END();
 }
@@ -0,0 +1,178 @@
+#include <unity.h>
+
+#include <math.h>
+
+#include "config/AppConfig.h"
+#include "core/SensorPollRate.h"
+
+namespace {
+
+constexpr float kBand = 1.0f;
+
+// Feeds the same single-channel value count times; returns how many calls changed the rate.
+int feed(AdaptivePollRate &rate, float value, int count) {
+    int changes = 0;
+    for (int i = 0; i < count; ++i) {
+        if (rate.observe(&value, &kBand, 1)) {
+            ++changes;
+        }
+    }
+    return changes;
+}
+
+} // namespace
+
+void setUp() {
+    SensorPollRates::instance().reset();
+}
+
+void tearDown() {}
+
+void test_stable_readings_double_interval_up_to_slow_limit() {
+    AdaptivePollRate rate;
+    rate.configure(1000, 4000);
+    TEST_ASSERT_EQUAL_UINT32(1000, rate.intervalMs());
+
+    // The first sample only sets the reference.
+    feed(rate, 10.0f, 1);
+    TEST_ASSERT_EQUAL_UINT32(1000, rate.intervalMs());
+
+    feed(rate, 10.5f, Config::ADAPTIVE_POLL_STABLE_SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(2000, rate.intervalMs());
+    TEST_ASSERT_TRUE(rate.backedOff());
+
+    feed(rate, 9.5f, Config::ADAPTIVE_POLL_STABLE_SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(4000, rate.intervalMs());
+
+    feed(rate, 10.0f, Config::ADAPTIVE_POLL_STABLE_SAMPLES * 3);
+    TEST_ASSERT_EQUAL_UINT32(4000, rate.intervalMs());
+}
+
+void test_slow_limit_that_is_not_a_power_of_two_is_reached() {
+    AdaptivePollRate rate;
+    rate.configure(700, 4200);
+    feed(rate, 5.0f, 1 + Config::ADAPTIVE_POLL_STABLE_SAMPLES * 4);
+    TEST_ASSERT_EQUAL_UINT32(4200, rate.intervalMs());
+}
+
+void test_change_outside_band_snaps_back_to_fast() {
+    AdaptivePollRate rate;
+    rate.configure(1000, 4000);
+    feed(rate, 10.0f, 1 + Config::ADAPTIVE_POLL_STABLE_SAMPLES * 2);
+    TEST_ASSERT_EQUAL_UINT32(4000, rate.intervalMs());
+
+    TEST_ASSERT_EQUAL_INT(1, feed(rate, 12.0f, 1));
+    TEST_ASSERT_EQUAL_UINT32(1000, rate.intervalMs());
+    TEST_ASSERT_FALSE(rate.backedOff());
+}
+
+void test_slow_drift_trips_band_against_last_reference() {
+    AdaptivePollRate rate;
+    rate.configure(1000, 4000);
+    feed(rate, 10.0f, 1 + Config::ADAPTIVE_POLL_STABLE_SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(2000, rate.intervalMs());
+
+    // Each step is inside the band, but the total drift is not.
+    feed(rate, 10.4f, 1);
+    feed(rate, 10.8f, 1);
+    TEST_ASSERT_EQUAL_UINT32(2000, rate.intervalMs());
+    feed(rate, 11.2f, 1);
+    TEST_ASSERT_EQUAL_UINT32(1000, rate.intervalMs());
+}
+
+void test_validity_change_counts_as_change() {
+    AdaptivePollRate rate;
+    rate.configure(1000, 4000);
+    feed(rate, 10.0f, 1 + Config::ADAPTIVE_POLL_STABLE_SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(2000, rate.intervalMs());
+
+    feed(rate, NAN, 1);
+    TEST_ASSERT_EQUAL_UINT32(1000, rate.intervalMs());
+
+    // A sensor that stays invalid is as stable as one that stays put.
+    feed(rate, NAN, Config::ADAPTIVE_POLL_STABLE_SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(2000, rate.intervalMs());
+    feed(rate, 10.0f, 1);
+    TEST_ASSERT_EQUAL_UINT32(1000, rate.intervalMs());
+}
+
+void test_any_channel_outside_its_band_resets_all() {
+    AdaptivePollRate rate;
+    rate.configure(1000, 4000);
+    const float bands[] = {1.0f, 15.0f};
+    float values[] = {5.0f, 600.0f};
+    for (int i = 0; i < 1 + Config::ADAPTIVE_POLL_STABLE_SAMPLES; ++i) {
+        rate.observe(values, bands, 2);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2000, rate.intervalMs());
+
+    values[1] = 610.0f;
+    TEST_ASSERT_FALSE(rate.observe(values, bands, 2));
+    values[1] = 620.0f;
+    TEST_ASSERT_TRUE(rate.observe(values, bands, 2));
+    TEST_ASSERT_EQUAL_UINT32(1000, rate.intervalMs());
+}
+
+void test_boost_returns_to_fast_and_restarts_backoff() {
+    AdaptivePollRate rate;
+    rate.configure(1000, 4000);
+    feed(rate, 10.0f, 1 + Config::ADAPTIVE_POLL_STABLE_SAMPLES);
+    TEST_ASSERT_TRUE(rate.boost());
+    TEST_ASSERT_EQUAL_UINT32(1000, rate.intervalMs());
+    TEST_ASSERT_FALSE(rate.boost());
+
+    // The reference survives a boost, so stable readings back off again.
+    feed(rate, 10.0f, Config::ADAPTIVE_POLL_STABLE_SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(2000, rate.intervalMs());
+}
+
+void test_demand_bits_and_web_lease() {
+    SensorPollRates &rates = SensorPollRates::instance();
+    TEST_ASSERT_EQUAL_UINT8(0, rates.demand(1000));
+
+    rates.setDemand(SensorPollRates::DEMAND_GRAPH, true);
+    rates.setDemand(SensorPollRates::DEMAND_FAN_AUTO, true);
+    TEST_ASSERT_EQUAL_UINT8(SensorPollRates::DEMAND_GRAPH | SensorPollRates::DEMAND_FAN_AUTO,
+                            rates.demand(1000));
+    rates.setDemand(SensorPollRates::DEMAND_GRAPH, false);
+    TEST_ASSERT_EQUAL_UINT8(SensorPollRates::DEMAND_FAN_AUTO, rates.demand(1000));
+    rates.setDemand(SensorPollRates::DEMAND_FAN_AUTO, false);
+
+    rates.noteWebLive(5000);
+    TEST_ASSERT_EQUAL_UINT8(SensorPollRates::DEMAND_WEB_LIVE, rates.demand(5000));
+    TEST_ASSERT_EQUAL_UINT8(SensorPollRates::DEMAND_WEB_LIVE,
+                            rates.demand(5000 + Config::SENSOR_POLL_WEB_LEASE_MS - 1));
+    TEST_ASSERT_EQUAL_UINT8(0, rates.demand(5000 + Config::SENSOR_POLL_WEB_LEASE_MS));
+}
+
+void test_snapshot_reports_published_rates() {
+    SensorPollRates &rates = SensorPollRates::instance();
+    AdaptivePollRate rate;
+    rate.configure(3000, 9000);
+    feed(rate, 1.0f, 1 + Config::ADAPTIVE_POLL_STABLE_SAMPLES);
+    rates.publish(SensorPollRates::SENSOR_CO, true, rate);
+
+    SensorPollRates::Snapshot snapshot;
+    rates.snapshot(snapshot, 0);
+    const SensorPollRates::Entry &co = snapshot.sensors[SensorPollRates::SENSOR_CO];
+    TEST_ASSERT_TRUE(co.active);
+    TEST_ASSERT_EQUAL_UINT32(6000, co.interval_ms);
+    TEST_ASSERT_EQUAL_UINT32(3000, co.fast_ms);
+    TEST_ASSERT_EQUAL_UINT32(9000, co.slow_ms);
+    TEST_ASSERT_FALSE(snapshot.sensors[SensorPollRates::SENSOR_SEN66].active);
+    TEST_ASSERT_EQUAL_STRING("co", SensorPollRates::sensorName(SensorPollRates::SENSOR_CO));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_stable_readings_double_interval_up_to_slow_limit);
+    RUN_TEST(test_slow_limit_that_is_not_a_power_of_two_is_reached);
+    RUN_TEST(test_change_outside_band_snaps_back_to_fast);
+    RUN_TEST(test_slow_drift_trips_band_against_last_reference);
+    RUN_TEST(test_validity_change_counts_as_change);
+    RUN_TEST(test_any_channel_outside_its_band_resets_all);
+    RUN_TEST(test_boost_returns_to_fast_and_restarts_backoff);
+    RUN_TEST(test_demand_bits_and_web_lease);
+    RUN_TEST(test_snapshot_reports_published_rates);
+    return UNITY_END();
+}
@@ -0,0 +1,117 @@
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+
+#include "core/SensorSnapshot.h"
+
+#include "../../src/core/SensorSnapshot.cpp"
+
+void setUp() {}
+void tearDown() {}
+
+void test_snapshot_starts_at_generation_zero_with_defaults() {
+    SensorSnapshot snapshot;
+    SensorSample sample;
+    sample.data.co2 = 123;
+
+    TEST_ASSERT_EQUAL_UINT32(0u, snapshot.generation());
+    TEST_ASSERT_EQUAL_UINT32(0u, snapshot.read(sample));
+    TEST_ASSERT_EQUAL_INT(0, sample.data.co2);
+    TEST_ASSERT_FALSE(sample.gas_warmup);
+}
+
+void test_publish_bumps_generation_and_exposes_sample() {
+    SensorSnapshot snapshot;
+    SensorData data{};
+    data.co2 = 700;
+    data.co2_valid = true;
+    snapshot.publish(data, true);
+
+    SensorSample sample;
+    TEST_ASSERT_EQUAL_UINT32(1u, snapshot.read(sample));
+    TEST_ASSERT_EQUAL_INT(700, sample.data.co2);
+    TEST_ASSERT_TRUE(sample.data.co2_valid);
+    TEST_ASSERT_TRUE(sample.gas_warmup);
+
+    data.co2 = 710;
+    snapshot.publish(data, false);
+    TEST_ASSERT_EQUAL_UINT32(2u, snapshot.generation());
+}
+
+void test_read_if_newer_skips_seen_generation() {
+    SensorSnapshot snapshot;
+    SensorData data{};
+    data.voc_index = 90;
+    snapshot.publish(data, false);
+
+    uint32_t seen = 0;
+    SensorSample sample;
+    TEST_ASSERT_TRUE(snapshot.readIfNewer(sample, seen));
+    TEST_ASSERT_EQUAL_UINT32(1u, seen);
+    TEST_ASSERT_EQUAL_INT(90, sample.data.voc_index);
+
+    sample.data.voc_index = -1;
+    TEST_ASSERT_FALSE(snapshot.readIfNewer(sample, seen));
+    TEST_ASSERT_EQUAL_INT(-1, sample.data.voc_index);
+
+    data.voc_index = 95;
+    snapshot.publish(data, false);
+    TEST_ASSERT_TRUE(snapshot.readIfNewer(sample, seen));
+    TEST_ASSERT_EQUAL_UINT32(2u, seen);
+    TEST_ASSERT_EQUAL_INT(95, sample.data.voc_index);
+}
+
+void test_concurrent_reader_never_sees_a_torn_sample() {
+    SensorSnapshot snapshot;
+    std::atomic<bool> done{false};
+    constexpr int kPublishes = 20000;
+
+    // Every field of a published sample carries the same counter value.
+    std::thread writer([&]() {
+        SensorData data{};
+        for (int i = 1; i <= kPublishes; ++i) {
+            data.co2 = i;
+            data.voc_index = i;
+            data.nox_index = i;
+            data.temperature = static_cast<float>(i);
+            data.pm25 = static_cast<float>(i);
+            snapshot.publish(data, (i & 1) != 0);
+        }
+        done.store(true);
+    });
+
+    uint32_t torn = 0;
+    uint32_t last_generation = 0;
+    bool went_backwards = false;
+    SensorSample sample;
+    while (!done.load()) {
+        const uint32_t generation = snapshot.read(sample);
+        const int value = sample.data.co2;
+        if (sample.data.voc_index != value || sample.data.nox_index != value ||
+            sample.data.temperature != static_cast<float>(value) ||
+            sample.data.pm25 != static_cast<float>(value) ||
+            sample.gas_warmup != ((value & 1) != 0) ||
+            generation != static_cast<uint32_t>(value)) {
+            torn++;
+        }
+        if (generation < last_generation) {
+            went_backwards = true;
+        }
+        last_generation = generation;
+    }
+    writer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0u, torn);
+    TEST_ASSERT_FALSE(went_backwards);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(kPublishes), snapshot.generation());
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_snapshot_starts_at_generation_zero_with_defaults);
+    RUN_TEST(test_publish_bumps_generation_and_exposes_sample);
+    RUN_TEST(test_read_if_newer_skips_seen_generation);
+    RUN_TEST(test_concurrent_reader_never_sees_a_torn_sample);
+    return UNITY_END();
+}
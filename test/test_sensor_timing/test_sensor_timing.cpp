@@ -0,0 +1,131 @@
+#include <unity.h>
+
+#include "ArduinoMock.h"
+#include "TimeMock.h"
+#include "config/AppConfig.h"
+#include "core/SensorTiming.h"
+
+void setUp() {
+    setMillis(0);
+    setNowEpoch(0);
+    SensorTiming::instance().reset();
+}
+
+void tearDown() {}
+
+void test_clock_is_monotonic_microseconds() {
+    setMillis(5000);
+    advanceMicros(42);
+    TEST_ASSERT_TRUE(SensorTiming::nowUs() == 5000042ULL);
+}
+
+void test_epoch_is_zero_until_clock_is_valid() {
+    setNowEpoch(Config::TIME_VALID_EPOCH);
+    TEST_ASSERT_EQUAL_UINT32(0, SensorTiming::nowEpoch());
+    setNowEpoch(Config::TIME_VALID_EPOCH + 1);
+    TEST_ASSERT_EQUAL_UINT32(Config::TIME_VALID_EPOCH + 1, SensorTiming::nowEpoch());
+}
+
+void test_stamp_records_ready_time_and_epoch() {
+    SensorData data{};
+    SensorTiming::instance().stamp(data, SENSOR_SOURCE_CO, 123456, 1700000000);
+    TEST_ASSERT_TRUE(data.stamps[SENSOR_SOURCE_CO].ready_us == 123456ULL);
+    TEST_ASSERT_EQUAL_UINT32(1700000000, data.stamps[SENSOR_SOURCE_CO].epoch);
+    TEST_ASSERT_TRUE(data.stamps[SENSOR_SOURCE_SEN66].ready_us == 0ULL);
+
+    SensorTiming::instance().stamp(data, SENSOR_SOURCE_COUNT, 1, 1);
+}
+
+void test_intervals_track_min_max_and_jitter() {
+    SensorTiming &timing = SensorTiming::instance();
+    SensorData data{};
+    timing.stamp(data, SENSOR_SOURCE_SEN66, 1000000, 0);
+    timing.stamp(data, SENSOR_SOURCE_SEN66, 2000000, 0);
+    timing.stamp(data, SENSOR_SOURCE_SEN66, 3000000, 0);
+
+    SensorTiming::Snapshot snapshot;
+    timing.snapshot(snapshot);
+    const SensorTiming::IntervalStats &steady = snapshot.intervals[SENSOR_SOURCE_SEN66];
+    TEST_ASSERT_EQUAL_UINT32(2, steady.count);
+    TEST_ASSERT_EQUAL_UINT32(1000000, steady.avg_us);
+    TEST_ASSERT_EQUAL_UINT32(0, steady.jitter_us);
+
+    // One late sample: the deviation enters the jitter at 1/16 gain.
+    timing.stamp(data, SENSOR_SOURCE_SEN66, 4160000, 0);
+    timing.snapshot(snapshot);
+    const SensorTiming::IntervalStats &late = snapshot.intervals[SENSOR_SOURCE_SEN66];
+    TEST_ASSERT_EQUAL_UINT32(3, late.count);
+    TEST_ASSERT_EQUAL_UINT32(1160000, late.last_us);
+    TEST_ASSERT_EQUAL_UINT32(1000000, late.min_us);
+    TEST_ASSERT_EQUAL_UINT32(1160000, late.max_us);
+    TEST_ASSERT_EQUAL_UINT32(10000, late.jitter_us);
+    TEST_ASSERT_EQUAL_UINT32(1010000, late.avg_us);
+}
+
+void test_latency_counts_each_stamp_once_per_stage() {
+    SensorTiming &timing = SensorTiming::instance();
+    SensorData data{};
+    timing.stamp(data, SENSOR_SOURCE_SEN66, 1000000, 0);
+    timing.stamp(data, SENSOR_SOURCE_PRESSURE, 1000500, 0);
+
+    timing.noteDelivered(SensorTiming::STAGE_MQTT, data, 1002000);
+    timing.noteDelivered(SensorTiming::STAGE_MQTT, data, 1900000);
+    timing.noteDelivered(SensorTiming::STAGE_WEB, data, 1004000);
+
+    SensorTiming::Snapshot snapshot;
+    timing.snapshot(snapshot);
+    const SensorTiming::LatencyStats &mqtt = snapshot.latency[SensorTiming::STAGE_MQTT];
+    TEST_ASSERT_EQUAL_UINT32(2, mqtt.count);
+    TEST_ASSERT_EQUAL_UINT32(2000, mqtt.max_us);
+    TEST_ASSERT_EQUAL_UINT32(1500, mqtt.last_us);
+    const SensorTiming::LatencyStats &web = snapshot.latency[SensorTiming::STAGE_WEB];
+    TEST_ASSERT_EQUAL_UINT32(2, web.count);
+    TEST_ASSERT_EQUAL_UINT32(4000, web.max_us);
+    TEST_ASSERT_EQUAL_UINT32(0, snapshot.latency[SensorTiming::STAGE_SNAPSHOT].count);
+
+    // A new stamp from one source is a single new observation.
+    timing.stamp(data, SENSOR_SOURCE_SEN66, 2000000, 0);
+    timing.noteDelivered(SensorTiming::STAGE_MQTT, data, 2003000);
+    timing.snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(3, snapshot.latency[SensorTiming::STAGE_MQTT].count);
+    TEST_ASSERT_EQUAL_UINT32(3000, snapshot.latency[SensorTiming::STAGE_MQTT].max_us);
+}
+
+void test_reset_clears_statistics() {
+    SensorTiming &timing = SensorTiming::instance();
+    SensorData data{};
+    timing.stamp(data, SENSOR_SOURCE_HCHO, 1000, 0);
+    timing.stamp(data, SENSOR_SOURCE_HCHO, 2000, 0);
+    timing.noteDelivered(SensorTiming::STAGE_SNAPSHOT, data, 2500);
+    timing.reset();
+
+    SensorTiming::Snapshot snapshot;
+    timing.snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(0, snapshot.intervals[SENSOR_SOURCE_HCHO].count);
+    TEST_ASSERT_EQUAL_UINT32(0, snapshot.latency[SensorTiming::STAGE_SNAPSHOT].count);
+
+    // The same stamp counts again after a reset.
+    timing.noteDelivered(SensorTiming::STAGE_SNAPSHOT, data, 2500);
+    timing.snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.latency[SensorTiming::STAGE_SNAPSHOT].count);
+}
+
+void test_names_cover_sources_and_stages() {
+    TEST_ASSERT_EQUAL_STRING("sen66", SensorTiming::sourceName(SENSOR_SOURCE_SEN66));
+    TEST_ASSERT_EQUAL_STRING("optional_gas", SensorTiming::sourceName(SENSOR_SOURCE_OPTIONAL_GAS));
+    TEST_ASSERT_EQUAL_STRING("unknown", SensorTiming::sourceName(SENSOR_SOURCE_COUNT));
+    TEST_ASSERT_EQUAL_STRING("mqtt", SensorTiming::stageName(SensorTiming::STAGE_MQTT));
+    TEST_ASSERT_EQUAL_STRING("unknown", SensorTiming::stageName(SensorTiming::STAGE_COUNT));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clock_is_monotonic_microseconds);
+    RUN_TEST(test_epoch_is_zero_until_clock_is_valid);
+    RUN_TEST(test_stamp_records_ready_time_and_epoch);
+    RUN_TEST(test_intervals_track_min_max_and_jitter);
+    RUN_TEST(test_latency_counts_each_stamp_once_per_stage);
+    RUN_TEST(test_reset_clears_statistics);
+    RUN_TEST(test_names_cover_sources_and_stages);
+    return UNITY_END();
+}
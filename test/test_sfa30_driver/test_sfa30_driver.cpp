@@ -6,6 +6,7 @@
 #include "config/AppConfig.h"
 #include "core/BootState.h"
 #include "core/I2CHelper.h"
+#include "core/I2cScheduler.h"
 #include "core/Logger.h"
 #include "drivers/Sfa30.h"
 #include "esp_system.h"
@@ -40,6 +41,15 @@ void setValidDeviceMarkingResponse() {
                             sizeof(marking_data));
 }
 
+// The read command is scheduled on the first poll; its response is collected once the
+// datasheet read delay has elapsed.
+void pollReadAt(Sfa30 &sfa, uint32_t now_ms) {
+    setMillis(now_ms);
+    sfa.poll();
+    setMillis(now_ms + Config::SFA3X_READ_DELAY_MS);
+    sfa.poll();
+}
+
 } // namespace
 
 static_assert(Config::SFA3X_CMD_START == 0x0006, "SFA30 start opcode drifted from datasheet");
@@ -51,6 +61,7 @@ static_assert(Config::SFA30_CMD_GET_DEVICE_MARKING == 0xD060,
 void setUp() {
     setMillis(0);
     I2cMock::reset();
+    I2cScheduler::instance().reset();
     Logger::begin(Serial, Logger::Debug);
     Logger::setSerialOutputEnabled(false);
     Logger::setSensorsSerialOutputEnabled(false);
@@ -127,8 +138,7 @@ void test_real_sfa30_reads_hcho_from_valid_frame() {
     sfa.start();
     TEST_ASSERT_TRUE(sfa.isOk());
 
-    setMillis(Config::SFA3X_POLL_MS);
-    sfa.poll();
+    pollReadAt(sfa, Config::SFA3X_POLL_MS);
 
     float hcho_ppb = 0.0f;
     TEST_ASSERT_TRUE(sfa.takeNewData(hcho_ppb));
@@ -156,16 +166,13 @@ void test_real_sfa30_crc_errors_mark_fault_after_three_polls() {
     sfa.start();
     TEST_ASSERT_TRUE(sfa.isOk());
 
-    setMillis(Config::SFA3X_POLL_MS);
-    sfa.poll();
+    pollReadAt(sfa, Config::SFA3X_POLL_MS);
     TEST_ASSERT_FALSE(sfa.hasFault());
 
-    setMillis(Config::SFA3X_POLL_MS * 2U);
-    sfa.poll();
+    pollReadAt(sfa, Config::SFA3X_POLL_MS * 2U);
     TEST_ASSERT_FALSE(sfa.hasFault());
 
-    setMillis(Config::SFA3X_POLL_MS * 3U);
-    sfa.poll();
+    pollReadAt(sfa, Config::SFA3X_POLL_MS * 3U);
     TEST_ASSERT_TRUE(sfa.hasFault());
     TEST_ASSERT_FALSE(sfa.isOk());
     TEST_ASSERT_EQUAL(static_cast<int>(Sfa30::Status::Fault),
@@ -202,8 +209,7 @@ void test_real_sfa30_can_restart_after_runtime_stop_failure_once_bus_recovers()
     TEST_ASSERT_TRUE(sfa.isOk());
     TEST_ASSERT_FALSE(sfa.hasFault());
 
-    setMillis(Config::SFA3X_POLL_MS);
-    sfa.poll();
+    pollReadAt(sfa, Config::SFA3X_POLL_MS);
 
     float hcho_ppb = 0.0f;
     TEST_ASSERT_TRUE(sfa.takeNewData(hcho_ppb));
@@ -0,0 +1,244 @@
+#include <unity.h>
+
+#include <string>
+#include <vector>
+
+#include "ArduinoMock.h"
+#include "core/StorageWriter.h"
+#include "modules/StorageManager.h"
+
+namespace {
+
+struct WriteLog {
+    std::vector<std::string> paths;
+    std::vector<std::string> contents;
+    bool fail = false;
+};
+
+WriteLog g_log;
+
+bool record_write(const char *path, const uint8_t *data, size_t len, void *ctx) {
+    auto *log = static_cast<WriteLog *>(ctx);
+    log->paths.push_back(path);
+    log->contents.push_back(std::string(reinterpret_cast<const char *>(data), len));
+    return !log->fail;
+}
+
+struct Completions {
+    int written = 0;
+    int failed = 0;
+    int superseded = 0;
+    int discarded = 0;
+};
+
+void count_result(const char *, StorageWriter::Result result, void *ctx) {
+    auto *done = static_cast<Completions *>(ctx);
+    switch (result) {
+        case StorageWriter::Result::Written:
+            done->written++;
+            break;
+        case StorageWriter::Result::Failed:
+            done->failed++;
+            break;
+        case StorageWriter::Result::Superseded:
+            done->superseded++;
+            break;
+        case StorageWriter::Result::Discarded:
+            done->discarded++;
+            break;
+    }
+}
+
+bool submit_text(const char *path, const char *text, Completions *done = nullptr) {
+    return StorageWriter::instance().submit(path, text, strlen(text),
+                                            done ? count_result : nullptr, done);
+}
+
+} // namespace
+
+void setUp() {
+    setMillis(0);
+    g_log = WriteLog{};
+    StorageWriter::instance().resetForTest();
+    StorageManager::setTestForceSaveFailure(false);
+}
+
+void tearDown() {
+    StorageWriter::instance().resetForTest();
+}
+
+void test_submit_is_rejected_until_started() {
+    StorageWriter &writer = StorageWriter::instance();
+    TEST_ASSERT_FALSE(writer.isRunning());
+    TEST_ASSERT_FALSE(submit_text("/a.bin", "x"));
+    TEST_ASSERT_FALSE(writer.start(nullptr, nullptr));
+
+    TEST_ASSERT_TRUE(writer.start(record_write, &g_log));
+    TEST_ASSERT_TRUE(submit_text("/a.bin", "x"));
+    TEST_ASSERT_FALSE(submit_text("/a/path/that/does/not/fit/the/slot.bin", "x"));
+}
+
+void test_writes_run_in_submission_order_from_copied_data() {
+    StorageWriter &writer = StorageWriter::instance();
+    writer.start(record_write, &g_log);
+    char buffer[] = "first";
+    TEST_ASSERT_TRUE(writer.submit("/a.bin", buffer, 5));
+    buffer[0] = 'F';
+    TEST_ASSERT_TRUE(submit_text("/b.bin", "second"));
+    TEST_ASSERT_EQUAL_UINT32(0, g_log.paths.size());
+
+    TEST_ASSERT_TRUE(writer.writeNext());
+    TEST_ASSERT_TRUE(writer.writeNext());
+    TEST_ASSERT_FALSE(writer.writeNext());
+    TEST_ASSERT_EQUAL_UINT32(2, g_log.paths.size());
+    TEST_ASSERT_EQUAL_STRING("/a.bin", g_log.paths[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("first", g_log.contents[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("/b.bin", g_log.paths[1].c_str());
+}
+
+void test_same_path_coalesces_to_last_writer() {
+    StorageWriter &writer = StorageWriter::instance();
+    writer.start(record_write, &g_log);
+    Completions first;
+    Completions second;
+    submit_text("/charts.bin", "old", &first);
+    submit_text("/voc.bin", "voc");
+    submit_text("/charts.bin", "newer data", &second);
+
+    TEST_ASSERT_EQUAL_INT(1, first.superseded);
+    TEST_ASSERT_TRUE(writer.flush(0));
+    TEST_ASSERT_EQUAL_UINT32(2, g_log.paths.size());
+    // The replaced request keeps its place in the queue.
+    TEST_ASSERT_EQUAL_STRING("/charts.bin", g_log.paths[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("newer data", g_log.contents[0].c_str());
+    TEST_ASSERT_EQUAL_INT(0, first.written);
+    TEST_ASSERT_EQUAL_INT(1, second.written);
+
+    StorageWriter::Stats stats;
+    writer.stats(stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.submitted);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.coalesced);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.written);
+    TEST_ASSERT_EQUAL_UINT8(0, stats.pending);
+}
+
+void test_full_queue_rejects_new_paths_but_still_coalesces() {
+    StorageWriter &writer = StorageWriter::instance();
+    writer.start(record_write, &g_log);
+    char path[16];
+    for (size_t i = 0; i < StorageWriter::kSlots; ++i) {
+        snprintf(path, sizeof(path), "/f%u.bin", static_cast<unsigned>(i));
+        TEST_ASSERT_TRUE(submit_text(path, "x"));
+    }
+    TEST_ASSERT_FALSE(submit_text("/extra.bin", "x"));
+    TEST_ASSERT_TRUE(submit_text("/f0.bin", "y"));
+
+    StorageWriter::Stats stats;
+    writer.stats(stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.rejected);
+    TEST_ASSERT_EQUAL_UINT8(StorageWriter::kSlots, stats.pending);
+}
+
+void test_failed_write_reports_through_callback() {
+    StorageWriter &writer = StorageWriter::instance();
+    writer.start(record_write, &g_log);
+    g_log.fail = true;
+    Completions done;
+    submit_text("/a.bin", "x", &done);
+    writer.flush(0);
+    TEST_ASSERT_EQUAL_INT(1, done.failed);
+
+    StorageWriter::Stats stats;
+    writer.stats(stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.failed);
+}
+
+void test_discard_drops_queued_requests() {
+    StorageWriter &writer = StorageWriter::instance();
+    writer.start(record_write, &g_log);
+    Completions a;
+    Completions b;
+    Completions c;
+    submit_text("/a.bin", "a", &a);
+    submit_text("/b.bin", "b", &b);
+    submit_text("/c.bin", "c", &c);
+
+    writer.discard("/b.bin");
+    TEST_ASSERT_EQUAL_INT(1, b.discarded);
+    writer.discardAll();
+    TEST_ASSERT_EQUAL_INT(1, a.discarded);
+    TEST_ASSERT_EQUAL_INT(1, c.discarded);
+    TEST_ASSERT_TRUE(writer.flush(0));
+    TEST_ASSERT_EQUAL_UINT32(0, g_log.paths.size());
+}
+
+void test_storage_manager_falls_back_to_synchronous_writes() {
+    StorageManager storage;
+    storage.begin();
+    Completions done;
+    const uint8_t state[4] = {1, 2, 3, 4};
+    TEST_ASSERT_TRUE(storage.saveBlobAsync(StorageManager::kVocStatePath, state, sizeof(state),
+                                           count_result, &done));
+    TEST_ASSERT_EQUAL_INT(1, done.written);
+    uint8_t loaded[4] = {};
+    TEST_ASSERT_TRUE(storage.loadVocState(loaded, sizeof(loaded)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(state, loaded, sizeof(state));
+}
+
+void test_storage_manager_queues_blobs_and_sync_save_wins() {
+    StorageManager storage;
+    storage.begin();
+    TEST_ASSERT_TRUE(storage.startWriter());
+    const uint8_t queued[2] = {1, 1};
+    const uint8_t direct[2] = {2, 2};
+    TEST_ASSERT_TRUE(storage.saveBlobAsync(StorageManager::kPressurePath, queued, 2));
+    uint8_t loaded[2] = {};
+    TEST_ASSERT_FALSE(storage.loadBlob(StorageManager::kPressurePath, loaded, 2));
+
+    TEST_ASSERT_TRUE(storage.saveBlobAtomic(StorageManager::kPressurePath, direct, 2));
+    TEST_ASSERT_TRUE(StorageWriter::instance().flush(0));
+    TEST_ASSERT_TRUE(storage.loadBlob(StorageManager::kPressurePath, loaded, 2));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(direct, loaded, 2);
+}
+
+void test_storage_manager_debounced_config_save_goes_through_writer() {
+    StorageManager storage;
+    storage.begin();
+    TEST_ASSERT_TRUE(storage.startWriter());
+    StorageWriter &writer = StorageWriter::instance();
+    String text;
+    storage.requestSave();
+    storage.poll(2000);
+    TEST_ASSERT_FALSE(storage.loadText(StorageManager::kConfigSnapshotPath, text));
+
+    // A failed background write is noticed by the next poll and retried after the debounce.
+    StorageManager::setTestForceSaveFailure(true);
+    writer.flush(0);
+    StorageManager::setTestForceSaveFailure(false);
+    storage.poll(2100);
+    StorageWriter::Stats stats;
+    writer.stats(stats);
+    TEST_ASSERT_EQUAL_UINT8(0, stats.pending);
+    storage.poll(3200);
+    writer.flush(0);
+    TEST_ASSERT_TRUE(storage.loadText(StorageManager::kConfigSnapshotPath, text));
+
+    // Success arms the last-known-good commit just like a synchronous save.
+    storage.poll(3300);
+    storage.poll(3300 + Config::LAST_GOOD_COMMIT_DELAY_MS);
+    TEST_ASSERT_TRUE(storage.loadText(StorageManager::kLastGoodPath, text));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_submit_is_rejected_until_started);
+    RUN_TEST(test_writes_run_in_submission_order_from_copied_data);
+    RUN_TEST(test_same_path_coalesces_to_last_writer);
+    RUN_TEST(test_full_queue_rejects_new_paths_but_still_coalesces);
+    RUN_TEST(test_failed_write_reports_through_callback);
+    RUN_TEST(test_discard_drops_queued_requests);
+    RUN_TEST(test_storage_manager_falls_back_to_synchronous_writes);
+    RUN_TEST(test_storage_manager_queues_blobs_and_sync_save_wins);
+    RUN_TEST(test_storage_manager_debounced_config_save_goes_through_writer);
+    return UNITY_END();
+}
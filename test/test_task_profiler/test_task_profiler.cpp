@@ -0,0 +1,194 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include "ArduinoMock.h"
+#include "core/Logger.h"
+#include "core/TaskProfiler.h"
+
+namespace {
+
+void add_task(TaskProfiler::Raw &raw, const char *name, uint32_t id, uint32_t runtime,
+              uint32_t stack_free, int8_t core, bool idle = false) {
+    TaskProfiler::RawTask &task = raw.tasks[raw.task_count++];
+    strncpy(task.name, name, TaskProfiler::kNameLength - 1);
+    task.id = id;
+    task.runtime = runtime;
+    task.stack_free = stack_free;
+    task.core = core;
+    task.idle = idle;
+}
+
+TaskProfiler::Raw make_raw(uint32_t total_runtime) {
+    TaskProfiler::Raw raw;
+    raw.has_tasks = true;
+    raw.has_runtime = true;
+    raw.total_runtime = total_runtime;
+    raw.heap.internal_free = 120000;
+    raw.heap.internal_min_free = 90000;
+    raw.heap.internal_largest = 60000;
+    raw.heap.psram_free = 4000000;
+    raw.heap.psram_largest = 3800000;
+    return raw;
+}
+
+size_t count_alerts_tagged(const char *tag) {
+    Logger::RecentEntry entries[32];
+    const size_t count = Logger::copyRecentAlerts(entries, 32);
+    size_t tagged = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (strcmp(entries[i].tag, tag) == 0) {
+            tagged++;
+        }
+    }
+    return tagged;
+}
+
+} // namespace
+
+void setUp() {
+    setMillis(0);
+    Logger::resetRecentForTest();
+    TaskProfiler::instance().resetForTest();
+}
+
+void tearDown() {}
+
+void test_cpu_share_comes_from_runtime_deltas() {
+    TaskProfiler &profiler = TaskProfiler::instance();
+    TaskProfiler::Raw first = make_raw(1000000);
+    add_task(first, "IDLE0", 1, 900000, 800, 0, true);
+    add_task(first, "IDLE1", 2, 950000, 800, 1, true);
+    add_task(first, "lvgl", 3, 100000, 6000, 1);
+    add_task(first, "network", 4, 50000, 3000, 0);
+    profiler.ingest(5000, first);
+
+    TaskProfiler::Snapshot snapshot;
+    TEST_ASSERT_TRUE(profiler.snapshot(snapshot));
+    // Nothing to compare against yet.
+    TEST_ASSERT_EQUAL_UINT16(TaskProfiler::kNoCpu, snapshot.tasks[0].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT16(TaskProfiler::kNoCpu, snapshot.core_busy_permille[0]);
+
+    TaskProfiler::Raw second = make_raw(2000000);
+    add_task(second, "IDLE0", 1, 1600000, 800, 0, true);
+    add_task(second, "IDLE1", 2, 1350000, 800, 1, true);
+    add_task(second, "lvgl", 3, 700000, 5800, 1);
+    add_task(second, "network", 4, 350000, 2900, 0);
+    add_task(second, "httpd", 9, 100000, 7000, -1); // started since the first sample
+    profiler.ingest(10000, second);
+
+    TEST_ASSERT_TRUE(profiler.snapshot(snapshot));
+    TEST_ASSERT_EQUAL_UINT32(5, snapshot.task_count);
+    TEST_ASSERT_EQUAL_STRING("IDLE0", snapshot.tasks[0].name);
+    TEST_ASSERT_EQUAL_UINT16(700, snapshot.tasks[0].cpu_permille);
+    TEST_ASSERT_EQUAL_STRING("lvgl", snapshot.tasks[1].name);
+    TEST_ASSERT_EQUAL_UINT16(600, snapshot.tasks[1].cpu_permille);
+    TEST_ASSERT_EQUAL_STRING("IDLE1", snapshot.tasks[2].name);
+    TEST_ASSERT_EQUAL_STRING("network", snapshot.tasks[3].name);
+    TEST_ASSERT_EQUAL_UINT16(300, snapshot.tasks[3].cpu_permille);
+    TEST_ASSERT_EQUAL_STRING("httpd", snapshot.tasks[4].name);
+    TEST_ASSERT_EQUAL_UINT16(100, snapshot.tasks[4].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT16(300, snapshot.core_busy_permille[0]);
+    TEST_ASSERT_EQUAL_UINT16(600, snapshot.core_busy_permille[1]);
+
+    TEST_ASSERT_EQUAL_UINT32(2900, snapshot.watched_stack_free[TaskProfiler::WatchNetwork]);
+    TEST_ASSERT_EQUAL_UINT32(5800, snapshot.watched_stack_free[TaskProfiler::WatchLvgl]);
+    TEST_ASSERT_EQUAL_UINT32(7000, snapshot.watched_stack_free[TaskProfiler::WatchHttpd]);
+    TEST_ASSERT_EQUAL_UINT32(TaskProfiler::kNoStack, snapshot.watched_stack_free[TaskProfiler::WatchMain]);
+    TEST_ASSERT_EQUAL_UINT32(50, snapshot.internal_frag_pct);
+}
+
+void test_without_runtime_stats_tasks_keep_stacks_only() {
+    TaskProfiler &profiler = TaskProfiler::instance();
+    for (uint32_t i = 0; i < 2; ++i) {
+        TaskProfiler::Raw raw = make_raw(0);
+        raw.has_runtime = false;
+        add_task(raw, "loopTask", 5, 0, 2500, 1);
+        add_task(raw, "log", 6, 0, 1800, 0);
+        profiler.ingest(5000 * (i + 1), raw);
+    }
+    TaskProfiler::Snapshot snapshot;
+    TEST_ASSERT_TRUE(profiler.snapshot(snapshot));
+    TEST_ASSERT_EQUAL_UINT32(2, snapshot.task_count);
+    TEST_ASSERT_EQUAL_STRING("loopTask", snapshot.tasks[0].name);
+    TEST_ASSERT_EQUAL_UINT16(TaskProfiler::kNoCpu, snapshot.tasks[0].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT32(2500, snapshot.watched_stack_free[TaskProfiler::WatchMain]);
+    TEST_ASSERT_EQUAL_UINT32(1800, snapshot.watched_stack_free[TaskProfiler::WatchLog]);
+    TEST_ASSERT_EQUAL_STRING("main", TaskProfiler::watchedName(TaskProfiler::WatchMain));
+}
+
+void test_window_keeps_the_most_recent_samples() {
+    TaskProfiler &profiler = TaskProfiler::instance();
+    for (uint32_t i = 0; i < TaskProfiler::kWindowDepth + 3; ++i) {
+        TaskProfiler::Raw raw = make_raw(i * 1000);
+        raw.heap.internal_free = 100000 + i;
+        add_task(raw, "sensors", 7, 0, 4000 - i, 0);
+        add_task(raw, "lvgl", 3, 0, 6000, 1);
+        profiler.ingest(i * TaskProfiler::kSampleIntervalMs, raw);
+    }
+    TaskProfiler::Snapshot snapshot;
+    TEST_ASSERT_TRUE(profiler.snapshot(snapshot));
+    TEST_ASSERT_EQUAL_UINT32(TaskProfiler::kWindowDepth + 3, snapshot.sample_count);
+    TEST_ASSERT_EQUAL_UINT32(TaskProfiler::kWindowDepth, snapshot.window_count);
+    TEST_ASSERT_EQUAL_UINT32(3 * TaskProfiler::kSampleIntervalMs, snapshot.window[0].ms);
+    TEST_ASSERT_EQUAL_UINT32(100003, snapshot.window[0].internal_free);
+    TEST_ASSERT_EQUAL_UINT32(3997, snapshot.window[0].stack_min);
+    const TaskProfiler::Point &last = snapshot.window[TaskProfiler::kWindowDepth - 1];
+    TEST_ASSERT_EQUAL_UINT32((TaskProfiler::kWindowDepth + 2) * TaskProfiler::kSampleIntervalMs, last.ms);
+    TEST_ASSERT_EQUAL_UINT32(4000 - (TaskProfiler::kWindowDepth + 2), last.stack_min);
+}
+
+void test_alerts_fire_once_and_clear_with_headroom() {
+    TaskProfiler &profiler = TaskProfiler::instance();
+    TaskProfiler::Thresholds thresholds;
+    thresholds.stack_free_bytes = 1000;
+    thresholds.internal_free_bytes = 50000;
+    thresholds.internal_block_bytes = 10000;
+    profiler.setThresholds(thresholds);
+
+    TaskProfiler::Raw raw = make_raw(0);
+    add_task(raw, "httpd", 9, 0, 900, 0);
+    raw.heap.internal_free = 40000;
+    raw.heap.internal_largest = 8000;
+    profiler.ingest(5000, raw);
+    profiler.ingest(10000, raw);
+
+    TaskProfiler::Snapshot snapshot;
+    profiler.snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32((1u << TaskProfiler::WatchHttpd) | TaskProfiler::AlertInternalHeap |
+                                 TaskProfiler::AlertInternalBlock,
+                             snapshot.alerts);
+    TEST_ASSERT_EQUAL_UINT32(3, count_alerts_tagged("Prof"));
+
+    // Above the threshold but inside the headroom: still raised, nothing new logged.
+    raw.heap.internal_free = 60000;
+    raw.heap.internal_largest = 12000;
+    profiler.ingest(15000, raw);
+    profiler.snapshot(snapshot);
+    TEST_ASSERT_TRUE(snapshot.alerts & TaskProfiler::AlertInternalHeap);
+    TEST_ASSERT_TRUE(snapshot.alerts & TaskProfiler::AlertInternalBlock);
+
+    raw.heap.internal_free = 80000;
+    raw.heap.internal_largest = 20000;
+    raw.task_count = 0; // httpd stopped
+    profiler.ingest(20000, raw);
+    profiler.snapshot(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(0, snapshot.alerts);
+    TEST_ASSERT_EQUAL_UINT32(3, count_alerts_tagged("Prof"));
+}
+
+void test_fragmentation_is_the_share_outside_the_largest_block() {
+    TEST_ASSERT_EQUAL_UINT8(0, TaskProfiler::fragmentationPct(0, 0));
+    TEST_ASSERT_EQUAL_UINT8(0, TaskProfiler::fragmentationPct(1000, 1000));
+    TEST_ASSERT_EQUAL_UINT8(75, TaskProfiler::fragmentationPct(1000, 250));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_cpu_share_comes_from_runtime_deltas);
+    RUN_TEST(test_without_runtime_stats_tasks_keep_stacks_only);
+    RUN_TEST(test_window_keeps_the_most_recent_samples);
+    RUN_TEST(test_alerts_fire_once_and_clear_with_headroom);
+    RUN_TEST(test_fragmentation_is_the_share_outside_the_largest_block);
+    return UNITY_END();
+}
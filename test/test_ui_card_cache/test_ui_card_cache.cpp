@@ -0,0 +1,178 @@
+#include <unity.h>
+
+#include "ui/UiCardCache.h"
+
+namespace {
+
+UiCardCache &cache = UiCardCache::instance();
+
+UiCardCache::Key key_for(uint32_t size, uint32_t colour) {
+    UiCardCache::Key key;
+    key.words[0] = size;
+    key.words[2] = colour;
+    return key;
+}
+
+UiCardCache::Stats cache_stats() {
+    UiCardCache::Stats stats;
+    cache.stats(stats);
+    return stats;
+}
+
+// One refresh that draws `cards` cards from the cache, or directly on a probe frame.
+void draw_frame(const UiCardCache::Key &key, uint32_t cards, uint32_t frame_us) {
+    for (uint32_t i = 0; i < cards; ++i) {
+        if (cache.probeFrame()) {
+            cache.noteDirectDraw();
+        } else {
+            TEST_ASSERT_NOT_NULL(cache.find(key));
+        }
+    }
+    cache.noteFrame(frame_us);
+}
+
+} // namespace
+
+void setUp() {
+    cache.reset();
+}
+
+void tearDown() {}
+
+void test_built_background_is_found_by_its_key() {
+    const UiCardCache::Key card = key_for(0x008C00F0, 0x1234);
+    TEST_ASSERT_NULL(cache.find(card));
+    uint8_t *pixels = cache.insert(card, 4000);
+    TEST_ASSERT_NOT_NULL(pixels);
+    cache.noteBuildTime(2500);
+
+    TEST_ASSERT_EQUAL_PTR(pixels, cache.find(card));
+    // Same size, other colour: a different background.
+    TEST_ASSERT_NULL(cache.find(key_for(0x008C00F0, 0x4321)));
+
+    UiCardCache::Stats stats = cache_stats();
+    TEST_ASSERT_EQUAL_UINT8(1, stats.entries);
+    TEST_ASSERT_EQUAL_UINT32(4000, stats.bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.builds);
+    TEST_ASSERT_EQUAL_UINT32(2500, stats.build_us_max);
+}
+
+void test_least_recently_drawn_background_goes_first_past_budget() {
+    const uint32_t third = UiCardCache::kBudgetBytes / 3;
+    const UiCardCache::Key a = key_for(1, 0);
+    const UiCardCache::Key b = key_for(2, 0);
+    const UiCardCache::Key c = key_for(3, 0);
+    TEST_ASSERT_NOT_NULL(cache.insert(a, third));
+    TEST_ASSERT_NOT_NULL(cache.insert(b, third));
+    TEST_ASSERT_NOT_NULL(cache.find(a));
+
+    TEST_ASSERT_NOT_NULL(cache.insert(c, third + 16));
+    TEST_ASSERT_NOT_NULL(cache.find(a));
+    TEST_ASSERT_NULL(cache.find(b));
+    TEST_ASSERT_NOT_NULL(cache.find(c));
+
+    UiCardCache::Stats stats = cache_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.evictions);
+    TEST_ASSERT_TRUE(stats.bytes <= UiCardCache::kBudgetBytes);
+
+    TEST_ASSERT_NULL(cache.insert(key_for(4, 0), UiCardCache::kBudgetBytes + 1));
+}
+
+void test_invalidate_drops_every_background() {
+    const UiCardCache::Key card = key_for(7, 7);
+    TEST_ASSERT_NOT_NULL(cache.insert(card, 1000));
+    cache.invalidate();
+    TEST_ASSERT_NULL(cache.find(card));
+    UiCardCache::Stats stats = cache_stats();
+    TEST_ASSERT_EQUAL_UINT8(0, stats.entries);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.invalidations);
+}
+
+void test_no_probe_frames_until_probing_starts() {
+    const UiCardCache::Key card = key_for(4, 4);
+    TEST_ASSERT_NOT_NULL(cache.insert(card, 1000));
+    for (uint32_t i = 0; i < 4 * UiCardCache::kProbeEvery; ++i) {
+        draw_frame(card, 3, 8000);
+        TEST_ASSERT_FALSE(cache.probeFrame());
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, cache_stats().frames_direct);
+}
+
+void test_probe_frames_are_averaged_apart_from_cached_frames() {
+    const UiCardCache::Key card = key_for(9, 9);
+    TEST_ASSERT_NOT_NULL(cache.insert(card, 1000));
+    cache.startProbing();
+
+    // Frames that do not redraw a card do not move the probe along.
+    for (uint32_t i = 0; i < 3 * UiCardCache::kProbeEvery; ++i) {
+        cache.noteFrame(500);
+    }
+    TEST_ASSERT_FALSE(cache.probeFrame());
+
+    for (uint32_t i = 0; i < UiCardCache::kProbeEvery; ++i) {
+        draw_frame(card, 3, 8000);
+    }
+    TEST_ASSERT_TRUE(cache.probeFrame());
+    draw_frame(card, 3, 20000);
+    TEST_ASSERT_FALSE(cache.probeFrame());
+
+    UiCardCache::Stats stats = cache_stats();
+    TEST_ASSERT_EQUAL_UINT32(UiCardCache::kProbeEvery, stats.frames_cached);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.frames_direct);
+    TEST_ASSERT_EQUAL_UINT32(8000, stats.frame_us_cached);
+    TEST_ASSERT_EQUAL_UINT32(20000, stats.frame_us_direct);
+}
+
+void test_probing_stops_after_its_window() {
+    const UiCardCache::Key card = key_for(6, 6);
+    TEST_ASSERT_NOT_NULL(cache.insert(card, 1000));
+    cache.startProbing();
+    for (uint32_t i = 0; i < UiCardCache::kProbeWindowFrames; ++i) {
+        draw_frame(card, 2, 8000);
+    }
+    const uint32_t probes = cache_stats().frames_direct;
+    TEST_ASSERT_EQUAL_UINT32(UiCardCache::kProbeWindowFrames / UiCardCache::kProbeEvery - 1, probes);
+
+    // Steady state: every frame is served from the cache.
+    for (uint32_t i = 0; i < 2 * UiCardCache::kProbeWindowFrames; ++i) {
+        draw_frame(card, 2, 8000);
+        TEST_ASSERT_FALSE(cache.probeFrame());
+    }
+    TEST_ASSERT_EQUAL_UINT32(probes, cache_stats().frames_direct);
+}
+
+void test_frame_with_a_miss_counts_on_neither_side() {
+    const UiCardCache::Key card = key_for(5, 5);
+    TEST_ASSERT_NOT_NULL(cache.insert(card, 1000));
+    TEST_ASSERT_NOT_NULL(cache.find(card));
+    // Another card had no background yet and was drawn directly while its build was queued.
+    cache.noteDirectDraw();
+    cache.noteFrame(30000);
+
+    UiCardCache::Stats stats = cache_stats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.frames_cached);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.frames_direct);
+}
+
+void test_disabled_cache_builds_nothing() {
+    cache.setEnabled(false);
+    TEST_ASSERT_NULL(cache.insert(key_for(1, 1), 1000));
+    TEST_ASSERT_FALSE(cache_stats().enabled);
+    cache.setEnabled(true);
+    TEST_ASSERT_NOT_NULL(cache.insert(key_for(1, 1), 1000));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_built_background_is_found_by_its_key);
+    RUN_TEST(test_least_recently_drawn_background_goes_first_past_budget);
+    RUN_TEST(test_invalidate_drops_every_background);
+    RUN_TEST(test_no_probe_frames_until_probing_starts);
+    RUN_TEST(test_probe_frames_are_averaged_apart_from_cached_frames);
+    RUN_TEST(test_probing_stops_after_its_window);
+    RUN_TEST(test_frame_with_a_miss_counts_on_neither_side);
+    RUN_TEST(test_disabled_cache_builds_nothing);
+    return UNITY_END();
+}
@@ -0,0 +1,331 @@
+#include <unity.h>
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "ui/UiFontPack.h"
+
+namespace {
+
+constexpr uint8_t kZh = 1u << 7;
+constexpr uint8_t kDe = 1u << 1;
+
+struct TestGlyph {
+    uint32_t codepoint;
+    uint16_t bitmap_size;
+    uint8_t kern_left;
+    uint8_t kern_right;
+    uint8_t languages;
+};
+
+class MemorySource final : public UiFontPack::Source {
+public:
+    MemorySource(std::vector<uint8_t> bytes, uint32_t *reads) : bytes_(std::move(bytes)), reads_(reads) {}
+
+    bool read(uint32_t offset, void *out, size_t len) override {
+        if (reads_) {
+            (*reads_)++;
+        }
+        if (fail_ || offset > bytes_.size() || len > bytes_.size() - offset) {
+            return false;
+        }
+        memcpy(out, bytes_.data() + offset, len);
+        return true;
+    }
+
+    uint32_t size() const override { return static_cast<uint32_t>(bytes_.size()); }
+
+    bool fail_ = false;
+
+private:
+    std::vector<uint8_t> bytes_;
+    uint32_t *reads_;
+};
+
+void put16(std::vector<uint8_t> &out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void put32(std::vector<uint8_t> &out, uint32_t v) {
+    put16(out, static_cast<uint16_t>(v));
+    put16(out, static_cast<uint16_t>(v >> 16));
+}
+
+// Same layout as scripts/generate_font_packs.py; every byte of a glyph's bitmap is the low
+// byte of its code point, and kerning pair (l, r) is -(l * 10 + r).
+std::vector<uint8_t> build_pack(const std::vector<TestGlyph> &glyphs) {
+    const uint8_t left_classes = 2;
+    const uint8_t right_classes = 3;
+    uint32_t bitmap_bytes = 0;
+    for (const TestGlyph &g : glyphs) {
+        bitmap_bytes += g.bitmap_size;
+    }
+    std::vector<uint8_t> out;
+    put32(out, UiFontPack::kMagic);
+    put16(out, UiFontPack::kVersion);
+    put16(out, static_cast<uint16_t>(glyphs.size()));
+    put16(out, 17);
+    put16(out, 4);
+    out.push_back(static_cast<uint8_t>(-2));
+    out.push_back(1);
+    out.push_back(4);
+    out.push_back(0);
+    put16(out, 16);
+    out.push_back(left_classes);
+    out.push_back(right_classes);
+    put32(out, bitmap_bytes);
+    put32(out, 0); // glyph hash, filled in below
+
+    uint32_t offset = 0;
+    for (const TestGlyph &g : glyphs) {
+        put32(out, g.codepoint);
+        put32(out, offset);
+        put16(out, g.bitmap_size);
+        put16(out, 160);
+        out.push_back(g.bitmap_size ? 8 : 0);
+        out.push_back(g.bitmap_size ? 10 : 0);
+        out.push_back(0);
+        out.push_back(static_cast<uint8_t>(-1));
+        out.push_back(g.kern_left);
+        out.push_back(g.kern_right);
+        out.push_back(g.languages);
+        out.push_back(0);
+        offset += g.bitmap_size;
+    }
+    const uint32_t hash = UiFontPack::glyphTableHash(out.data() + UiFontPack::kHeaderBytes,
+                                                     out.size() - UiFontPack::kHeaderBytes);
+    for (size_t i = 0; i < 4; ++i) {
+        out[24 + i] = static_cast<uint8_t>(hash >> (8 * i));
+    }
+    for (uint8_t l = 1; l <= left_classes; ++l) {
+        for (uint8_t r = 1; r <= right_classes; ++r) {
+            out.push_back(static_cast<uint8_t>(-(l * 10 + r)));
+        }
+    }
+    for (const TestGlyph &g : glyphs) {
+        out.insert(out.end(), g.bitmap_size, static_cast<uint8_t>(g.codepoint));
+    }
+    return out;
+}
+
+std::vector<TestGlyph> small_font() {
+    return {
+        {' ', 0, 0, 0, kZh | kDe},
+        {'A', 40, 1, 2, kZh | kDe},
+        {'V', 40, 2, 3, kDe},
+        {0x4E2D, 60, 0, 0, kZh}, // 中
+        {0x6587, 60, 0, 0, kZh}, // 文
+    };
+}
+
+UiFontPack::Stats pack_stats(const UiFontPack &pack) {
+    UiFontPack::Stats stats;
+    pack.stats(stats);
+    return stats;
+}
+
+bool open_pack(UiFontPack &pack, const std::vector<TestGlyph> &glyphs, uint32_t *reads = nullptr) {
+    return pack.open(std::unique_ptr<UiFontPack::Source>(new MemorySource(build_pack(glyphs), reads)));
+}
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_open_loads_metrics_and_finds_glyphs() {
+    UiFontPack pack;
+    TEST_ASSERT_TRUE(open_pack(pack, small_font()));
+    TEST_ASSERT_TRUE(pack.loaded());
+    TEST_ASSERT_EQUAL_INT(17, pack.metrics().line_height);
+    TEST_ASSERT_EQUAL_INT(4, pack.metrics().base_line);
+    TEST_ASSERT_EQUAL_INT(-2, pack.metrics().underline_position);
+    TEST_ASSERT_EQUAL_UINT8(4, pack.metrics().bpp);
+
+    const UiFontPack::Glyph *zhong = pack.find(0x4E2D);
+    TEST_ASSERT_NOT_NULL(zhong);
+    TEST_ASSERT_EQUAL_UINT16(60, zhong->bitmap_size);
+    TEST_ASSERT_EQUAL_INT(-1, zhong->ofs_y);
+    TEST_ASSERT_NOT_NULL(pack.find(' '));
+    TEST_ASSERT_NULL(pack.find('B'));
+    TEST_ASSERT_NULL(pack.find(0x10000));
+
+    TEST_ASSERT_EQUAL_UINT16(5, pack_stats(pack).glyphs);
+}
+
+void test_kerning_uses_class_pairs() {
+    UiFontPack pack;
+    TEST_ASSERT_TRUE(open_pack(pack, small_font()));
+    const UiFontPack::Glyph *a = pack.find('A');
+    const UiFontPack::Glyph *v = pack.find('V');
+    TEST_ASSERT_EQUAL_INT(-13, pack.kerning(*a, *v));
+    TEST_ASSERT_EQUAL_INT(-22, pack.kerning(*v, *a));
+    // Class 0 never kerns.
+    TEST_ASSERT_EQUAL_INT(0, pack.kerning(*a, *pack.find(0x4E2D)));
+}
+
+void test_malformed_pack_is_rejected() {
+    std::vector<uint8_t> bytes = build_pack(small_font());
+    UiFontPack pack;
+
+    std::vector<uint8_t> bad_magic = bytes;
+    bad_magic[0] = 'X';
+    TEST_ASSERT_FALSE(pack.open(std::unique_ptr<UiFontPack::Source>(new MemorySource(bad_magic, nullptr))));
+
+    std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 1);
+    TEST_ASSERT_FALSE(pack.open(std::unique_ptr<UiFontPack::Source>(new MemorySource(truncated, nullptr))));
+
+    std::vector<TestGlyph> unsorted = small_font();
+    std::swap(unsorted[1], unsorted[2]);
+    TEST_ASSERT_FALSE(open_pack(pack, unsorted));
+
+    TEST_ASSERT_FALSE(pack.loaded());
+    TEST_ASSERT_NULL(pack.find('A'));
+}
+
+void test_glyph_hash_is_checked_and_exposed() {
+    std::vector<uint8_t> bytes = build_pack(small_font());
+    UiFontPack pack;
+    TEST_ASSERT_TRUE(pack.open(std::unique_ptr<UiFontPack::Source>(new MemorySource(bytes, nullptr))));
+    const uint32_t hash = pack.metrics().glyph_hash;
+    TEST_ASSERT_EQUAL_HEX32(UiFontPack::glyphTableHash(bytes.data() + UiFontPack::kHeaderBytes,
+                                                       5 * UiFontPack::kGlyphBytes),
+                            hash);
+
+    // A different glyph set hashes differently.
+    std::vector<TestGlyph> fewer = small_font();
+    fewer.pop_back();
+    TEST_ASSERT_TRUE(open_pack(pack, fewer));
+    TEST_ASSERT_NOT_EQUAL(hash, pack.metrics().glyph_hash);
+
+    // A table that does not match its header hash is rejected.
+    std::vector<uint8_t> corrupt = bytes;
+    corrupt[UiFontPack::kHeaderBytes + UiFontPack::kGlyphBytes + 10] ^= 0x01;
+    TEST_ASSERT_FALSE(pack.open(std::unique_ptr<UiFontPack::Source>(new MemorySource(corrupt, nullptr))));
+    TEST_ASSERT_FALSE(pack.loaded());
+}
+
+void test_file_version_reads_old_packs() {
+    std::vector<uint8_t> bytes = build_pack(small_font());
+    MemorySource current(bytes, nullptr);
+    TEST_ASSERT_EQUAL_UINT16(UiFontPack::kVersion, UiFontPack::fileVersion(current));
+
+    // A pack from before the glyph hash: the version alone tells it apart.
+    std::vector<uint8_t> old = bytes;
+    old[4] = 1;
+    MemorySource old_source(old, nullptr);
+    TEST_ASSERT_EQUAL_UINT16(1, UiFontPack::fileVersion(old_source));
+    UiFontPack pack;
+    TEST_ASSERT_FALSE(pack.open(std::unique_ptr<UiFontPack::Source>(new MemorySource(old, nullptr))));
+
+    std::vector<uint8_t> other(bytes.begin(), bytes.begin() + 8);
+    other[0] = 'X';
+    MemorySource other_source(other, nullptr);
+    TEST_ASSERT_EQUAL_UINT16(0, UiFontPack::fileVersion(other_source));
+}
+
+void test_bitmap_is_read_once_then_served_from_cache() {
+    uint32_t reads = 0;
+    UiFontPack pack;
+    TEST_ASSERT_TRUE(open_pack(pack, small_font(), &reads));
+    const uint32_t open_reads = reads;
+
+    const UiFontPack::Glyph *wen = pack.find(0x6587);
+    const uint8_t *bitmap = pack.bitmap(*wen);
+    TEST_ASSERT_NOT_NULL(bitmap);
+    TEST_ASSERT_EQUAL_UINT8(0x87, bitmap[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x87, bitmap[59]);
+    TEST_ASSERT_EQUAL_PTR(bitmap, pack.bitmap(*wen));
+    TEST_ASSERT_EQUAL_UINT32(open_reads + 1, reads);
+    // A space has nothing to draw.
+    TEST_ASSERT_NULL(pack.bitmap(*pack.find(' ')));
+
+    UiFontPack::Stats stats = pack_stats(pack);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hits);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.cached);
+    TEST_ASSERT_EQUAL_UINT32(60, stats.cache_bytes);
+}
+
+void test_least_recently_drawn_glyph_goes_first_past_budget() {
+    const uint16_t big = static_cast<uint16_t>(UiFontPack::kCacheBytes / 2 - 100);
+    UiFontPack pack;
+    TEST_ASSERT_TRUE(open_pack(pack, {{'a', big, 0, 0, kZh}, {'b', big, 0, 0, kZh}, {'c', big, 0, 0, kZh}}));
+    const UiFontPack::Glyph *a = pack.find('a');
+    const UiFontPack::Glyph *b = pack.find('b');
+    const UiFontPack::Glyph *c = pack.find('c');
+    TEST_ASSERT_NOT_NULL(pack.bitmap(*a));
+    TEST_ASSERT_NOT_NULL(pack.bitmap(*b));
+    TEST_ASSERT_NOT_NULL(pack.bitmap(*a));
+
+    TEST_ASSERT_EQUAL_UINT8('c', pack.bitmap(*c)[0]);
+    UiFontPack::Stats stats = pack_stats(pack);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.evictions);
+    TEST_ASSERT_EQUAL_UINT16(2, stats.cached);
+    TEST_ASSERT_TRUE(stats.cache_bytes <= UiFontPack::kCacheBytes);
+
+    // 'a' stayed, 'b' has to be read again.
+    TEST_ASSERT_NOT_NULL(pack.bitmap(*a));
+    TEST_ASSERT_EQUAL_UINT32(3, pack_stats(pack).misses);
+    TEST_ASSERT_NOT_NULL(pack.bitmap(*b));
+    TEST_ASSERT_EQUAL_UINT32(4, pack_stats(pack).misses);
+}
+
+void test_preload_reads_one_language_without_evicting() {
+    UiFontPack pack;
+    TEST_ASSERT_TRUE(open_pack(pack, small_font()));
+    TEST_ASSERT_EQUAL_UINT32(3, pack.preload(7));
+    UiFontPack::Stats stats = pack_stats(pack);
+    TEST_ASSERT_EQUAL_UINT16(3, stats.cached);
+    TEST_ASSERT_EQUAL_UINT32(160, stats.cache_bytes);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.preloaded);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.misses);
+
+    // Already cached glyphs are not read again; 'V' is the only new one for DE.
+    TEST_ASSERT_EQUAL_UINT32(1, pack.preload(1));
+    TEST_ASSERT_NOT_NULL(pack.bitmap(*pack.find(0x4E2D)));
+    TEST_ASSERT_EQUAL_UINT32(0, pack_stats(pack).misses);
+
+    pack.trim();
+    stats = pack_stats(pack);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.cached);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.cache_bytes);
+    TEST_ASSERT_TRUE(stats.loaded);
+
+    const uint16_t big = static_cast<uint16_t>(UiFontPack::kCacheBytes / 2 - 100);
+    TEST_ASSERT_TRUE(open_pack(pack, {{'a', big, 0, 0, kZh}, {'b', big, 0, 0, kZh}, {'c', big, 0, 0, kZh}}));
+    TEST_ASSERT_EQUAL_UINT32(2, pack.preload(7));
+    TEST_ASSERT_EQUAL_UINT32(0, pack_stats(pack).evictions);
+}
+
+void test_failed_read_is_counted_and_not_cached() {
+    MemorySource *source = new MemorySource(build_pack(small_font()), nullptr);
+    UiFontPack pack;
+    TEST_ASSERT_TRUE(pack.open(std::unique_ptr<UiFontPack::Source>(source)));
+    source->fail_ = true;
+    const UiFontPack::Glyph *a = pack.find('A');
+    TEST_ASSERT_NULL(pack.bitmap(*a));
+    TEST_ASSERT_EQUAL_UINT32(1, pack_stats(pack).read_errors);
+    TEST_ASSERT_EQUAL_UINT16(0, pack_stats(pack).cached);
+
+    source->fail_ = false;
+    TEST_ASSERT_EQUAL_UINT8('A', pack.bitmap(*a)[0]);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_open_loads_metrics_and_finds_glyphs);
+    RUN_TEST(test_kerning_uses_class_pairs);
+    RUN_TEST(test_malformed_pack_is_rejected);
+    RUN_TEST(test_glyph_hash_is_checked_and_exposed);
+    RUN_TEST(test_file_version_reads_old_packs);
+    RUN_TEST(test_bitmap_is_read_once_then_served_from_cache);
+    RUN_TEST(test_least_recently_drawn_glyph_goes_first_past_budget);
+    RUN_TEST(test_preload_reads_one_language_without_evicting);
+    RUN_TEST(test_failed_read_is_counted_and_not_cached);
+    return UNITY_END();
+}
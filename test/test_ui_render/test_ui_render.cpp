@@ -0,0 +1,424 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <lvgl.h>
+
+#include "ui/LvglMemPool.h"
+#include "ui/UiCardBackdrop.h"
+#include "ui/UiCardCache.h"
+#include "ui/UiWidgetBinding.h"
+#include "ui/screens.h"
+#include "ui/ui.h"
+
+// The generated screens on real LVGL 8.4 with an in-memory display the size of the panel.
+// Screens are started with ui_init() and opened with loadScreen(), as on the device, so the
+// lazy screens are built on first show in their LvglMemPool arena. Each frame is one pass of
+// lv_timer_handler() after a refresh period of ticks; it reports the host time spent
+// rendering, the pixels flushed (the invalidated area) and the LVGL allocations made while
+// drawing, as counted by LvglMemPool. Host timings are for comparing commits on one machine,
+// not for predicting the ESP32-S3.
+//
+// Golden images live in test/test_ui_render/golden as binary PPM. A screen without one fails
+// the test; record or refresh them with AURA_UI_GOLDEN=update after checking the change is
+// intended. A mismatch leaves <screen>.actual.ppm next to the golden.
+
+namespace {
+
+constexpr lv_coord_t kWidth = 800;
+constexpr lv_coord_t kHeight = 480;
+constexpr lv_coord_t kBufferLines = 20; // LVGL_PORT_BUFFER_SIZE_HEIGHT on the device
+constexpr uint32_t kScreenPixels = static_cast<uint32_t>(kWidth) * kHeight;
+const char kGoldenDir[] = "test/test_ui_render/golden";
+
+struct Frame {
+    double render_us = 0.0;
+    uint32_t flushed_px = 0;
+    uint32_t flushes = 0;
+    uint32_t allocs = 0;
+};
+
+lv_color_t g_framebuffer[kScreenPixels];
+lv_color_t g_draw_buf[kWidth * kBufferLines];
+lv_disp_draw_buf_t g_draw_buf_desc;
+lv_disp_drv_t g_disp_drv;
+Frame g_frame;
+bool g_ui_ready = false;
+
+LvglMemPool::Stats pool_stats() {
+    LvglMemPool::Stats stats;
+    LvglMemPool::instance().stats(stats);
+    return stats;
+}
+
+// Blocks LVGL holds right now, pooled or on the heap.
+uint32_t live_blocks(const LvglMemPool::Stats &stats) {
+    uint32_t blocks = stats.heap_live;
+    for (const LvglMemPool::ClassStats &cls : stats.classes) {
+        blocks += cls.used;
+    }
+    return blocks;
+}
+
+void flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *pixels) {
+    const lv_coord_t width = lv_area_get_width(area);
+    for (lv_coord_t y = area->y1; y <= area->y2; ++y) {
+        memcpy(&g_framebuffer[y * kWidth + area->x1], pixels, width * sizeof(lv_color_t));
+        pixels += width;
+    }
+    g_frame.flushed_px += lv_area_get_size(area);
+    g_frame.flushes++;
+    lv_disp_flush_ready(drv);
+}
+
+void ensure_ui() {
+    if (g_ui_ready) {
+        return;
+    }
+    lv_init();
+    lv_disp_draw_buf_init(&g_draw_buf_desc, g_draw_buf, nullptr, kWidth * kBufferLines);
+    lv_disp_drv_init(&g_disp_drv);
+    g_disp_drv.hor_res = kWidth;
+    g_disp_drv.ver_res = kHeight;
+    g_disp_drv.flush_cb = flush;
+    g_disp_drv.draw_buf = &g_draw_buf_desc;
+    lv_disp_drv_register(&g_disp_drv);
+    ui_init();
+    g_ui_ready = true;
+}
+
+Frame render_frame() {
+    g_frame = Frame{};
+    const uint32_t allocs_before = pool_stats().allocs;
+    lv_tick_inc(LV_DISP_DEF_REFR_PERIOD);
+    const auto start = std::chrono::steady_clock::now();
+    lv_timer_handler();
+    const auto end = std::chrono::steady_clock::now();
+    g_frame.render_us = std::chrono::duration<double, std::micro>(end - start).count();
+    g_frame.allocs = pool_stats().allocs - allocs_before;
+    if (g_frame.flushes > 0) {
+        // As the port task does after every refresh that flushed.
+        UiCardBackdrop::endFrame(static_cast<uint32_t>(g_frame.render_us));
+    }
+    return g_frame;
+}
+
+lv_obj_t *screen_root(ScreensEnum id) {
+    // Page roots are the first slots of objects_t, in ScreensEnum order (see ui_runtime.c).
+    return reinterpret_cast<lv_obj_t **>(&objects)[id - SCREEN_ID_PAGE_BOOT_LOGO];
+}
+
+Frame show_screen(ScreensEnum id) {
+    loadScreen(id);
+    TEST_ASSERT_NOT_NULL(screen_root(id));
+    TEST_ASSERT_EQUAL_PTR(screen_root(id), lv_scr_act());
+    return render_frame();
+}
+
+void pixel_rgb(size_t index, uint8_t out[3]) {
+    lv_color32_t color;
+    color.full = lv_color_to32(g_framebuffer[index]);
+    out[0] = color.ch.red;
+    out[1] = color.ch.green;
+    out[2] = color.ch.blue;
+}
+
+bool golden_update() {
+    const char *mode = getenv("AURA_UI_GOLDEN");
+    return mode && strcmp(mode, "update") == 0;
+}
+
+std::string golden_path(const char *name, const char *suffix) {
+    return std::string(kGoldenDir) + "/" + name + suffix;
+}
+
+bool write_ppm(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", kWidth, kHeight);
+    uint8_t rgb[3];
+    for (size_t i = 0; i < kScreenPixels; ++i) {
+        pixel_rgb(i, rgb);
+        fwrite(rgb, 1, sizeof(rgb), file);
+    }
+    fclose(file);
+    return true;
+}
+
+// -1 when there is no usable golden, else the number of pixels that differ.
+long compare_ppm(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return -1;
+    }
+    int width = 0;
+    int height = 0;
+    int max_value = 0;
+    if (fscanf(file, "P6 %d %d %d", &width, &height, &max_value) != 3 || width != kWidth ||
+        height != kHeight || max_value != 255 || fgetc(file) == EOF) {
+        fclose(file);
+        return -1;
+    }
+    long mismatched = 0;
+    uint8_t expected[3];
+    uint8_t actual[3];
+    for (size_t i = 0; i < kScreenPixels; ++i) {
+        if (fread(expected, 1, sizeof(expected), file) != sizeof(expected)) {
+            fclose(file);
+            return -1;
+        }
+        pixel_rgb(i, actual);
+        if (memcmp(expected, actual, sizeof(actual)) != 0) {
+            mismatched++;
+        }
+    }
+    fclose(file);
+    return mismatched;
+}
+
+struct ScreenCase {
+    ScreensEnum id;
+    const char *name;
+};
+
+const ScreenCase kScreens[] = {
+    {SCREEN_ID_PAGE_BOOT_LOGO, "boot_logo"},
+    {SCREEN_ID_PAGE_BOOT_DIAG, "boot_diag"},
+    {SCREEN_ID_PAGE_MAIN_PRO, "main_pro"},
+    {SCREEN_ID_PAGE_SETTINGS, "settings"},
+    {SCREEN_ID_PAGE_WIFI, "wifi"},
+    {SCREEN_ID_PAGE_THEME, "theme"},
+    {SCREEN_ID_PAGE_CLOCK, "clock"},
+    {SCREEN_ID_PAGE_CO2_CALIB, "co2_calib"},
+    {SCREEN_ID_PAGE_AUTO_NIGHT_MODE, "auto_night_mode"},
+    {SCREEN_ID_PAGE_BACKLIGHT, "backlight"},
+    {SCREEN_ID_PAGE_MQTT, "mqtt"},
+    {SCREEN_ID_PAGE_SENSORS_INFO, "sensors_info"},
+    {SCREEN_ID_PAGE_DAC_SETTINGS, "dac_settings"},
+    {SCREEN_ID_PAGE_FW_UPDATE, "fw_update"},
+    {SCREEN_ID_PAGE_DIAG, "diag"},
+};
+
+// Readings as UiController would show them on the main screen, one row per sensor cycle.
+struct Reading {
+    const char *co2;
+    const char *temp;
+    const char *hum;
+    const char *pm25;
+    uint32_t co2_card; // 0xRRGGBB
+};
+
+const Reading kReadings[] = {
+    {"612", "22.8", "41", "4.1", 0x2E7D32},
+    {"612", "22.8", "41", "4.1", 0x2E7D32},
+    {"655", "22.8", "41", "6.3", 0x2E7D32},
+    {"702", "22.9", "42", "6.3", 0x2E7D32},
+    {"748", "22.9", "42", "12.9", 0xF9A825},
+    {"801", "23.0", "42", "12.9", 0xF9A825},
+    {"801", "23.0", "42", "12.9", 0xF9A825},
+    {"760", "23.0", "43", "8.0", 0xF9A825},
+    {"690", "22.9", "43", "8.0", 0x2E7D32},
+    {"612", "22.8", "41", "4.1", 0x2E7D32},
+};
+
+void apply_reading(const Reading &reading) {
+    UiWidgetBinding::setText(objects.label_co2_value_1, reading.co2);
+    UiWidgetBinding::setText(objects.label_temp_value_1, reading.temp);
+    UiWidgetBinding::setText(objects.label_hum_value_1, reading.hum);
+    UiWidgetBinding::setText(objects.label_pm25_value_1, reading.pm25);
+    UiWidgetBinding::setBgColor(objects.card_co2_pro, lv_color_hex(reading.co2_card),
+                                LV_PART_MAIN | LV_STATE_DEFAULT);
+}
+
+} // namespace
+
+void setUp() {
+    ensure_ui();
+}
+
+void tearDown() {}
+
+void test_every_screen_renders_and_matches_golden() {
+    const bool update = golden_update();
+    std::string missing;
+    std::string mismatched;
+    for (const ScreenCase &screen : kScreens) {
+        const Frame frame = show_screen(screen.id);
+        char report[160];
+        snprintf(report, sizeof(report), "%s: first frame %.0fus, %u flushes, %u allocs",
+                 screen.name, frame.render_us, static_cast<unsigned>(frame.flushes),
+                 static_cast<unsigned>(frame.allocs));
+        TEST_MESSAGE(report);
+        // A newly loaded screen is drawn in full, in strips of the draw buffer.
+        TEST_ASSERT_EQUAL_UINT32(kScreenPixels, frame.flushed_px);
+        TEST_ASSERT_EQUAL_UINT32(kHeight / kBufferLines, frame.flushes);
+
+        const std::string path = golden_path(screen.name, ".ppm");
+        if (update) {
+            TEST_ASSERT_TRUE_MESSAGE(write_ppm(path), path.c_str());
+            continue;
+        }
+        const long diff = compare_ppm(path);
+        if (diff < 0) {
+            missing += std::string(" ") + screen.name;
+        } else if (diff > 0) {
+            write_ppm(golden_path(screen.name, ".actual.ppm"));
+            mismatched += std::string(" ") + screen.name + "(" + std::to_string(diff) + "px)";
+        }
+    }
+    // A screen without a golden image is a failure too: record it with AURA_UI_GOLDEN=update.
+    TEST_ASSERT_TRUE_MESSAGE(missing.empty(), ("no golden image for:" + missing).c_str());
+    TEST_ASSERT_TRUE_MESSAGE(mismatched.empty(), ("differs from golden:" + mismatched).c_str());
+}
+
+void test_unchanged_values_leave_the_screen_alone() {
+    show_screen(SCREEN_ID_PAGE_MAIN_PRO);
+    apply_reading(kReadings[0]);
+    render_frame();
+
+    apply_reading(kReadings[0]);
+    const Frame idle = render_frame();
+    TEST_ASSERT_EQUAL_UINT32(0, idle.flushed_px);
+    TEST_ASSERT_EQUAL_UINT32(0, idle.allocs);
+
+    apply_reading(kReadings[2]);
+    const Frame changed = render_frame();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, changed.flushed_px);
+    // Two value labels changed; nowhere near a full redraw.
+    TEST_ASSERT_LESS_THAN_UINT32(kScreenPixels / 4, changed.flushed_px);
+}
+
+void test_scripted_readings_frame_cost() {
+    show_screen(SCREEN_ID_PAGE_MAIN_PRO);
+    for (const Reading &reading : kReadings) {
+        apply_reading(reading);
+        render_frame();
+    }
+    const uint32_t live_after_first_pass = live_blocks(pool_stats());
+
+    double total_us = 0.0;
+    double worst_us = 0.0;
+    uint64_t total_px = 0;
+    uint32_t worst_px = 0;
+    uint32_t total_allocs = 0;
+    const size_t frames = sizeof(kReadings) / sizeof(kReadings[0]);
+    for (const Reading &reading : kReadings) {
+        apply_reading(reading);
+        const Frame frame = render_frame();
+        total_us += frame.render_us;
+        worst_us = frame.render_us > worst_us ? frame.render_us : worst_us;
+        total_px += frame.flushed_px;
+        worst_px = frame.flushed_px > worst_px ? frame.flushed_px : worst_px;
+        total_allocs += frame.allocs;
+    }
+
+    const LvglMemPool::Stats pool = pool_stats();
+    char report[220];
+    snprintf(report, sizeof(report),
+             "frames=%u render/frame=%.0fus worst=%.0fus px/frame=%u worst=%u allocs/frame=%.1f "
+             "lvgl_blocks=%u slabs=%uKiB+%uKiB slab_free=%u%%",
+             static_cast<unsigned>(frames), total_us / frames, worst_us,
+             static_cast<unsigned>(total_px / frames), static_cast<unsigned>(worst_px),
+             static_cast<double>(total_allocs) / frames, static_cast<unsigned>(live_blocks(pool)),
+             static_cast<unsigned>(pool.slab_bytes_internal / 1024),
+             static_cast<unsigned>(pool.slab_bytes_psram / 1024), static_cast<unsigned>(pool.frag_pct));
+    TEST_MESSAGE(report);
+
+    // The script ends where it starts, so a second pass must not grow LVGL's memory.
+    TEST_ASSERT_EQUAL_UINT32(live_after_first_pass, live_blocks(pool));
+    TEST_ASSERT_LESS_THAN_UINT32(kScreenPixels / 2, worst_px);
+    // Host-side budget; generous so slow CI machines do not flake.
+    TEST_ASSERT_TRUE(worst_us < 200000.0);
+}
+
+// Full redraw of the main screen with card backgrounds drawn by LVGL, then blitted from
+// UiCardCache. Runs last: the cards stay hooked afterwards.
+void test_cached_card_backgrounds_match_direct_drawing() {
+    constexpr size_t kFrames = 5;
+    constexpr int kChannelTolerance = 8; // RGB565 rounding of the pre-blended shadow edge
+    lv_obj_t *root = screen_root(SCREEN_ID_PAGE_MAIN_PRO);
+    show_screen(SCREEN_ID_PAGE_MAIN_PRO);
+    apply_reading(kReadings[0]);
+    UiCardCache &cards = UiCardCache::instance();
+    cards.reset();
+    cards.setEnabled(false);
+    UiCardBackdrop::attach(root);
+
+    double direct_us = 0.0;
+    for (size_t i = 0; i < kFrames; ++i) {
+        lv_obj_invalidate(root);
+        direct_us += render_frame().render_us;
+    }
+    const std::vector<lv_color_t> expected(g_framebuffer, g_framebuffer + kScreenPixels);
+
+    // Backgrounds are built after the frame that first needs them, one per frame.
+    cards.setEnabled(true);
+    UiCardCache::Stats stats;
+    uint32_t builds = UINT32_MAX;
+    for (size_t i = 0; i < 32; ++i) {
+        lv_obj_invalidate(root);
+        render_frame();
+        cards.stats(stats);
+        if (stats.builds == builds) {
+            break;
+        }
+        builds = stats.builds;
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.builds);
+
+    double cached_us = 0.0;
+    size_t cached_frames = 0;
+    while (cached_frames < kFrames) {
+        const bool probe = cards.probeFrame();
+        lv_obj_invalidate(root);
+        const Frame frame = render_frame();
+        if (!probe) {
+            cached_us += frame.render_us;
+            cached_frames++;
+        }
+    }
+    // The last frame counted was drawn from the cache.
+    cards.stats(stats);
+
+    long mismatched = 0;
+    for (size_t i = 0; i < kScreenPixels; ++i) {
+        lv_color32_t color;
+        color.full = lv_color_to32(expected[i]);
+        const uint8_t want[3] = {color.ch.red, color.ch.green, color.ch.blue};
+        uint8_t got[3];
+        pixel_rgb(i, got);
+        for (size_t ch = 0; ch < 3; ++ch) {
+            if (abs(static_cast<int>(want[ch]) - static_cast<int>(got[ch])) > kChannelTolerance) {
+                mismatched++;
+                break;
+            }
+        }
+    }
+
+    char report[200];
+    snprintf(report, sizeof(report),
+             "main_pro full redraw: direct=%.0fus cached=%.0fus, %u backgrounds %uKiB, build max %uus, "
+             "%ld px off",
+             direct_us / kFrames, cached_us / kFrames, static_cast<unsigned>(stats.entries),
+             static_cast<unsigned>(stats.bytes / 1024), static_cast<unsigned>(stats.build_us_max),
+             mismatched);
+    TEST_MESSAGE(report);
+    TEST_ASSERT_TRUE(stats.hits > 0);
+    TEST_ASSERT_LESS_THAN_UINT32(kScreenPixels / 200, static_cast<uint32_t>(mismatched));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_screen_renders_and_matches_golden);
+    RUN_TEST(test_unchanged_values_leave_the_screen_alone);
+    RUN_TEST(test_scripted_readings_frame_cost);
+    RUN_TEST(test_cached_card_backgrounds_match_direct_drawing);
+    return UNITY_END();
+}
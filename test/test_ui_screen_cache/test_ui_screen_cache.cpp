@@ -0,0 +1,144 @@
+#include <unity.h>
+
+#include "ui/UiScreenCache.h"
+
+namespace {
+
+// Mirrors ScreensEnum in src/ui/screens.h.
+constexpr int kBootLogo = 1;
+constexpr int kMain = 3;
+constexpr int kSettings = 4;
+constexpr int kWifi = 5;
+constexpr int kTheme = 6;
+constexpr int kClock = 7;
+constexpr int kSensorsInfo = 12;
+
+constexpr uint32_t kBig = 40u * 1024u;
+
+UiScreenCache &cache = UiScreenCache::instance();
+
+UiScreenCache::Stats cache_stats() {
+    UiScreenCache::Stats stats;
+    cache.stats(stats);
+    return stats;
+}
+
+void navigate(int from, int to, uint32_t bytes, uint32_t build_us, uint32_t now_ms) {
+    const bool was_resident = cache.isResident(to);
+    if (!was_resident) {
+        cache.noteBuilt(to, bytes, build_us, false, now_ms);
+    }
+    cache.noteShown(from, to, was_resident, now_ms);
+}
+
+} // namespace
+
+void setUp() {
+    cache.reset();
+    cache.setPinned(kBootLogo, true);
+    cache.setPinned(kMain, true);
+    cache.setPinned(kSettings, true);
+}
+
+void tearDown() {}
+
+void test_screens_stay_resident_within_budget() {
+    navigate(kMain, kSettings, 0, 0, 1000);
+    navigate(kSettings, kWifi, 8000, 12000, 2000);
+    navigate(kWifi, kSettings, 0, 0, 3000);
+    navigate(kSettings, kWifi, 0, 0, 4000);
+
+    UiScreenCache::Stats stats = cache_stats();
+    TEST_ASSERT_EQUAL_UINT8(1, stats.resident);
+    TEST_ASSERT_EQUAL_UINT32(8000, stats.resident_bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(12000, stats.build_us_max);
+    TEST_ASSERT_EQUAL_UINT8(kWifi, stats.slowest_screen);
+
+    navigate(kWifi, kSettings, 0, 0, 5000);
+    TEST_ASSERT_EQUAL_INT(0, cache.releaseCandidate(kSettings, 0, 60000));
+}
+
+void test_least_recently_shown_screen_goes_first_past_budget() {
+    navigate(kSettings, kWifi, kBig, 1000, 1000);
+    navigate(kWifi, kTheme, kBig, 1000, 2000);
+    navigate(kTheme, kClock, kBig, 1000, 3000);
+
+    // Over budget, but the screen just left is kept while the switch settles.
+    TEST_ASSERT_EQUAL_INT(kWifi, cache.releaseCandidate(kClock, 0, 3100));
+    TEST_ASSERT_EQUAL_INT(0, cache.releaseCandidate(kClock, kSettings, 3100));
+
+    cache.noteReleased(kWifi);
+    TEST_ASSERT_EQUAL_INT(0, cache.releaseCandidate(kClock, 0, 3400));
+    UiScreenCache::Stats stats = cache_stats();
+    TEST_ASSERT_EQUAL_UINT32(2 * kBig, stats.resident_bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.releases);
+}
+
+void test_settle_delay_and_retry_hold_back_a_release() {
+    navigate(kSettings, kWifi, 2 * kBig, 1000, 1000);
+    navigate(kWifi, kTheme, kBig, 1000, 2000);
+
+    TEST_ASSERT_EQUAL_INT(0, cache.releaseCandidate(kTheme, 0, 2000 + UiScreenCache::kSettleMs - 1));
+    TEST_ASSERT_EQUAL_INT(kWifi, cache.releaseCandidate(kTheme, 0, 2000 + UiScreenCache::kSettleMs));
+
+    cache.deferRelease(kWifi, 2400);
+    TEST_ASSERT_EQUAL_INT(0, cache.releaseCandidate(kTheme, 0, 2450));
+    TEST_ASSERT_EQUAL_INT(kWifi, cache.releaseCandidate(kTheme, 0, 2400 + UiScreenCache::kRetryMs));
+}
+
+void test_idle_screens_are_released_even_under_budget() {
+    navigate(kSettings, kWifi, 4000, 1000, 1000);
+    navigate(kWifi, kSettings, 0, 0, 2000);
+    TEST_ASSERT_EQUAL_INT(0, cache.releaseCandidate(kSettings, 0, 2000 + UiScreenCache::kIdleReleaseMs - 1));
+    TEST_ASSERT_EQUAL_INT(kWifi, cache.releaseCandidate(kSettings, 0, 2000 + UiScreenCache::kIdleReleaseMs));
+}
+
+void test_prewarm_follows_navigation_history() {
+    cache.setHint(kMain, kSensorsInfo);
+    TEST_ASSERT_EQUAL_INT(kSensorsInfo, cache.prewarmCandidate(kMain, 0));
+    TEST_ASSERT_EQUAL_INT(0, cache.prewarmCandidate(kMain, kSettings));
+
+    // Main -> settings -> clock twice: from settings, clock is the likely next screen.
+    navigate(kMain, kSettings, 0, 0, 1000);
+    navigate(kSettings, kClock, 6000, 1000, 2000);
+    navigate(kClock, kSettings, 0, 0, 3000);
+    cache.noteReleased(kClock);
+    TEST_ASSERT_EQUAL_INT(kClock, cache.prewarmCandidate(kSettings, 0));
+
+    cache.notePrewarmAttempt();
+    TEST_ASSERT_EQUAL_INT(0, cache.prewarmCandidate(kSettings, 0));
+
+    cache.noteBuilt(kClock, 6000, 900, true, 4000);
+    navigate(kSettings, kClock, 0, 0, 5000);
+    UiScreenCache::Stats stats = cache_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.prewarms);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+    // A prewarm is not a navigation: latency stats only see the first real build.
+    TEST_ASSERT_EQUAL_UINT32(1000, stats.build_us_max);
+}
+
+void test_prewarm_respects_budget() {
+    navigate(kSettings, kWifi, 2 * kBig, 1000, 1000);
+    navigate(kWifi, kSettings, 0, 0, 2000);
+    navigate(kSettings, kClock, kBig, 1000, 3000);
+    navigate(kClock, kSettings, 0, 0, 4000);
+    cache.noteReleased(kClock);
+    // Clock is the most likely next screen but would push residency past the budget.
+    navigate(kSettings, kWifi, 0, 0, 5000);
+    navigate(kWifi, kSettings, 0, 0, 6000);
+    TEST_ASSERT_EQUAL_INT(0, cache.prewarmCandidate(kSettings, 0));
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_screens_stay_resident_within_budget);
+    RUN_TEST(test_least_recently_shown_screen_goes_first_past_budget);
+    RUN_TEST(test_settle_delay_and_retry_hold_back_a_release);
+    RUN_TEST(test_idle_screens_are_released_even_under_budget);
+    RUN_TEST(test_prewarm_follows_navigation_history);
+    RUN_TEST(test_prewarm_respects_budget);
+    return UNITY_END();
+}
@@ -82,11 +82,486 @@ void test_web_diag_api_utils_fill_json_populates_network_errors_and_stream() {
     TEST_ASSERT_EQUAL_STRING("socket_write_error",
                              doc["web_stream"]["last_abort_reason"].as<const char *>());
     TEST_ASSERT_EQUAL_FLOAT(0.9f, doc["web_stream"]["last_sent_ratio"].as<float>());
+    TEST_ASSERT_TRUE(doc["mqtt_publish"].isNull());
+    TEST_ASSERT_TRUE(doc["i2c"].isNull());
+    TEST_ASSERT_TRUE(doc["sensor_poll"].isNull());
+    TEST_ASSERT_TRUE(doc["sensor_filter"].isNull());
+    TEST_ASSERT_TRUE(doc["sensor_fusion"].isNull());
+    TEST_ASSERT_TRUE(doc["sensor_timing"].isNull());
+}
+
+void test_web_diag_api_utils_fill_json_reports_mqtt_publish_classes() {
+    WebDiagApiUtils::Payload payload{};
+    payload.has_mqtt_publish = true;
+    payload.mqtt_publish.tokens = 3;
+    payload.mqtt_publish.bucket_capacity = 8;
+    payload.mqtt_publish.classes[static_cast<size_t>(MqttPublishClass::State)].coalesced = 4;
+    payload.mqtt_publish.classes[static_cast<size_t>(MqttPublishClass::Discovery)].depth = 12;
+    payload.mqtt_publish.classes[static_cast<size_t>(MqttPublishClass::Alert)].max_latency_ms = 40;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(3, doc["mqtt_publish"]["tokens"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(8, doc["mqtt_publish"]["bucket_capacity"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(4, doc["mqtt_publish"]["state"]["coalesced"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(12, doc["mqtt_publish"]["discovery"]["depth"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(40, doc["mqtt_publish"]["alert"]["max_latency_ms"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(0, doc["mqtt_publish"]["backfill"]["sent"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_i2c_devices() {
+    WebDiagApiUtils::Payload payload{};
+    payload.has_i2c = true;
+    payload.i2c.busy_permille = 42;
+    payload.i2c.busy_peak_permille = 90;
+    payload.i2c.device_count = 1;
+    payload.i2c.devices[0].address = 0x6B;
+    payload.i2c.devices[0].transactions = 120;
+    payload.i2c.devices[0].nacks = 2;
+    payload.i2c.devices[0].crc_failures = 1;
+    payload.i2c.devices[0].latency_hist[2] = 118;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(42, doc["i2c"]["busy_permille"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(90, doc["i2c"]["busy_peak_permille"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(I2cDeviceStats::kLatencyBuckets - 1,
+                             doc["i2c"]["latency_bounds_us"].size());
+    TEST_ASSERT_EQUAL_UINT32(1, doc["i2c"]["devices"].size());
+    TEST_ASSERT_EQUAL_STRING("0x6B", doc["i2c"]["devices"][0]["address"].as<const char *>());
+    TEST_ASSERT_EQUAL_UINT32(120, doc["i2c"]["devices"][0]["transactions"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(2, doc["i2c"]["devices"][0]["nacks"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(1, doc["i2c"]["devices"][0]["crc_failures"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(118, doc["i2c"]["devices"][0]["latency_hist"][2].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_sensor_poll_rates() {
+    WebDiagApiUtils::Payload payload{};
+    payload.has_sensor_poll = true;
+    payload.sensor_poll.demand = SensorPollRates::DEMAND_GRAPH | SensorPollRates::DEMAND_WEB_LIVE;
+    SensorPollRates::Entry &sen66 = payload.sensor_poll.sensors[SensorPollRates::SENSOR_SEN66];
+    sen66.active = true;
+    sen66.interval_ms = 2000;
+    sen66.fast_ms = 1000;
+    sen66.slow_ms = 4000;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+
+    TEST_ASSERT_TRUE(doc["sensor_poll"]["high_rate"].as<bool>());
+    TEST_ASSERT_EQUAL_UINT32(2, doc["sensor_poll"]["demand"].size());
+    TEST_ASSERT_EQUAL_STRING("graph", doc["sensor_poll"]["demand"][0].as<const char *>());
+    TEST_ASSERT_EQUAL_STRING("web_live", doc["sensor_poll"]["demand"][1].as<const char *>());
+    TEST_ASSERT_EQUAL_UINT32(1, doc["sensor_poll"]["sensors"].size());
+    TEST_ASSERT_EQUAL_STRING("sen66", doc["sensor_poll"]["sensors"][0]["name"].as<const char *>());
+    TEST_ASSERT_EQUAL_UINT32(2000, doc["sensor_poll"]["sensors"][0]["interval_ms"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(1000, doc["sensor_poll"]["sensors"][0]["fast_ms"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(4000, doc["sensor_poll"]["sensors"][0]["slow_ms"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_sensor_filter_values() {
+    WebDiagApiUtils::Payload payload{};
+    payload.has_sensor_filter = true;
+    SensorFilters::Entry &co2 = payload.sensor_filter.metrics[SensorFilters::METRIC_CO2];
+    co2.valid = true;
+    co2.raw = 905.0f;
+    co2.value = 880.0f;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(1, doc["sensor_filter"]["metrics"].size());
+    TEST_ASSERT_EQUAL_STRING("co2", doc["sensor_filter"]["metrics"][0]["name"].as<const char *>());
+    TEST_ASSERT_EQUAL_FLOAT(905.0f, doc["sensor_filter"]["metrics"][0]["raw"].as<float>());
+    TEST_ASSERT_EQUAL_FLOAT(880.0f, doc["sensor_filter"]["metrics"][0]["value"].as<float>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_sensor_fusion_sources() {
+    WebDiagApiUtils::Payload payload{};
+    payload.has_sensor_fusion = true;
+    SensorFusion::Snapshot::Entry &pressure =
+        payload.sensor_fusion.quantities[SensorFusion::QUANTITY_PRESSURE];
+    pressure.valid = true;
+    pressure.value = 1003.5f;
+    pressure.source_count = 2;
+    pressure.sources[0].name = "bmp58x";
+    pressure.sources[1].name = "dps310";
+    pressure.sources[1].fresh = true;
+    pressure.sources[1].weight = 1.0f;
+    pressure.sources[1].bias = 0.6f;
+    pressure.sources[1].faults = 2;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+
+    ArduinoJson::JsonArray quantities = doc["sensor_fusion"]["quantities"];
+    TEST_ASSERT_EQUAL_UINT32(1, quantities.size());
+    TEST_ASSERT_EQUAL_STRING("pressure", quantities[0]["name"].as<const char *>());
+    TEST_ASSERT_EQUAL_FLOAT(1003.5f, quantities[0]["value"].as<float>());
+    TEST_ASSERT_FALSE(quantities[0]["sources"][0]["fresh"].as<bool>());
+    TEST_ASSERT_EQUAL_STRING("dps310", quantities[0]["sources"][1]["name"].as<const char *>());
+    TEST_ASSERT_EQUAL_FLOAT(0.6f, quantities[0]["sources"][1]["bias"].as<float>());
+    TEST_ASSERT_EQUAL_UINT32(2, quantities[0]["sources"][1]["faults"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_sensor_timing() {
+    WebDiagApiUtils::Payload payload{};
+    payload.has_sensor_timing = true;
+    SensorTiming::IntervalStats &sen66 = payload.sensor_timing.intervals[SENSOR_SOURCE_SEN66];
+    sen66.count = 12;
+    sen66.last_us = 1001000;
+    sen66.avg_us = 1000200;
+    sen66.jitter_us = 800;
+    SensorTiming::LatencyStats &mqtt = payload.sensor_timing.latency[SensorTiming::STAGE_MQTT];
+    mqtt.count = 4;
+    mqtt.max_us = 5400000;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+
+    ArduinoJson::JsonArray sources = doc["sensor_timing"]["sources"];
+    TEST_ASSERT_EQUAL_UINT32(1, sources.size());
+    TEST_ASSERT_EQUAL_STRING("sen66", sources[0]["name"].as<const char *>());
+    TEST_ASSERT_EQUAL_UINT32(800, sources[0]["jitter_us"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(1001000, sources[0]["interval_us"].as<uint32_t>());
+    ArduinoJson::JsonArray latency = doc["sensor_timing"]["latency"];
+    TEST_ASSERT_EQUAL_UINT32(SensorTiming::STAGE_COUNT, latency.size());
+    TEST_ASSERT_EQUAL_STRING("mqtt", latency[SensorTiming::STAGE_MQTT]["name"].as<const char *>());
+    TEST_ASSERT_EQUAL_UINT32(5400000, latency[SensorTiming::STAGE_MQTT]["max_us"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_storage_writer() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument idle;
+    WebDiagApiUtils::fillJson(idle.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(idle["storage_writer"].isNull());
+
+    payload.has_storage_writer = true;
+    payload.storage_writer.pending = 1;
+    payload.storage_writer.submitted = 40;
+    payload.storage_writer.coalesced = 7;
+    payload.storage_writer.written = 32;
+    payload.storage_writer.max_write_ms = 310;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    ArduinoJson::JsonObject writer = doc["storage_writer"];
+    TEST_ASSERT_EQUAL_UINT32(1, writer["pending"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(7, writer["coalesced"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(32, writer["written"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(0, writer["failed"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(310, writer["max_write_ms"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_record_store() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument unmounted;
+    WebDiagApiUtils::fillJson(unmounted.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(unmounted["record_store"].isNull());
+
+    payload.has_record_store = true;
+    payload.record_store.file_bytes = 20480;
+    payload.record_store.live_bytes = 9000;
+    payload.record_store.keys = 5;
+    payload.record_store.lifetime_bytes = 5000000000ULL;
+    payload.record_store.compactions = 12;
+    payload.record_store.crc_errors = 1;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    ArduinoJson::JsonObject records = doc["record_store"];
+    TEST_ASSERT_EQUAL_UINT32(20480, records["file_bytes"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(9000, records["live_bytes"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(5, records["keys"].as<uint32_t>());
+    TEST_ASSERT_TRUE(records["lifetime_bytes"].as<uint64_t>() == 5000000000ULL);
+    TEST_ASSERT_EQUAL_UINT32(12, records["compactions"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(1, records["crc_errors"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(0, records["dropped_tail_bytes"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_boot_traces() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument empty;
+    WebDiagApiUtils::fillJson(empty.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(empty["boot_traces"].isNull());
+
+    BootProfiler::Trace traces[2] = {};
+    traces[0].boot_count = 9;
+    traces[0].total_us = 8400000;
+    traces[0].complete = true;
+    traces[0].first_frame_us = 2100000;
+    traces[0].first_reading_us = 9300000;
+    traces[0].stage_count = 2;
+    strcpy(traces[0].stages[0].name, "peripherals");
+    traces[0].stages[0].start_us = 3200000;
+    traces[0].stages[0].duration_us = 2500000;
+    strcpy(traces[0].stages[1].name, "sensors");
+    traces[0].stages[1].depth = 1;
+    traces[0].stages[0].core = 1;
+    traces[0].stages[1].start_us = 3300000;
+    traces[0].stages[1].duration_us = 1900000;
+    traces[1].boot_count = 8;
+    traces[1].total_us = 9100000;
+    traces[1].complete = true;
+    payload.boot_traces = traces;
+    payload.boot_trace_count = 2;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    ArduinoJson::JsonArray boots = doc["boot_traces"];
+    TEST_ASSERT_EQUAL_UINT32(2, boots.size());
+    TEST_ASSERT_EQUAL_UINT32(9, boots[0]["boot_count"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(8400000, boots[0]["total_us"].as<uint32_t>());
+    TEST_ASSERT_TRUE(boots[0]["complete"].as<bool>());
+    TEST_ASSERT_EQUAL_UINT32(2100000, boots[0]["first_frame_us"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(9300000, boots[0]["first_reading_us"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(0, boots[1]["first_reading_us"].as<uint32_t>());
+    ArduinoJson::JsonArray stages = boots[0]["stages"];
+    TEST_ASSERT_EQUAL_UINT32(1, stages[0]["core"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(2, stages.size());
+    TEST_ASSERT_EQUAL_STRING("sensors", stages[1]["name"].as<const char *>());
+    TEST_ASSERT_EQUAL_UINT32(1, stages[1]["depth"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(3300000, stages[1]["start_us"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(1900000, stages[1]["duration_us"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(0, boots[1]["stages"].as<ArduinoJson::JsonArray>().size());
+}
+
+void test_web_diag_api_utils_fill_json_reports_previous_boot() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument empty;
+    WebDiagApiUtils::fillJson(empty.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(empty["previous_boot"].isNull());
+
+    RetainedLog::Previous previous{};
+    previous.ended_by = ESP_RST_PANIC;
+    previous.crashed = true;
+    previous.line_count = 1;
+    previous.lines[0].ms = 42000;
+    previous.lines[0].level = Logger::Error;
+    strcpy(previous.lines[0].tag, "Sensors");
+    strcpy(previous.lines[0].message, "SEN66 read failed");
+    previous.telemetry_count = 1;
+    previous.telemetry[0].uptime_ms = 40000;
+    previous.telemetry[0].heap_min_free = 51200;
+    previous.telemetry[0].loop_max_us = 3100;
+    payload.previous_boot = &previous;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    ArduinoJson::JsonObject prev = doc["previous_boot"];
+    TEST_ASSERT_EQUAL_INT(ESP_RST_PANIC, prev["reset_reason"].as<int>());
+    TEST_ASSERT_TRUE(prev["crashed"].as<bool>());
+    TEST_ASSERT_EQUAL_UINT32(1, prev["logs"].as<ArduinoJson::JsonArray>().size());
+    TEST_ASSERT_EQUAL_UINT32(42000, prev["logs"][0]["ts_ms"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_STRING("E", prev["logs"][0]["level"].as<const char *>());
+    TEST_ASSERT_EQUAL_STRING("Sensors", prev["logs"][0]["tag"].as<const char *>());
+    TEST_ASSERT_EQUAL_STRING("SEN66 read failed", prev["logs"][0]["message"].as<const char *>());
+    TEST_ASSERT_EQUAL_UINT32(51200, prev["telemetry"][0]["heap_min_free"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(3100, prev["telemetry"][0]["loop_max_us"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_task_profile() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument empty;
+    WebDiagApiUtils::fillJson(empty.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(empty["task_profile"].isNull());
+
+    TaskProfiler::Snapshot profile{};
+    profile.valid = true;
+    profile.ms = 30000;
+    profile.sample_count = 6;
+    profile.task_count = 2;
+    strcpy(profile.tasks[0].name, "lvgl");
+    profile.tasks[0].core = 1;
+    profile.tasks[0].cpu_permille = 425;
+    profile.tasks[0].stack_free = 5200;
+    strcpy(profile.tasks[1].name, "httpd");
+    profile.tasks[1].stack_free = 900;
+    profile.core_busy_permille[0] = 120;
+    profile.watched_stack_free[TaskProfiler::WatchHttpd] = 900;
+    profile.heap.internal_free = 40000;
+    profile.heap.internal_largest = 10000;
+    profile.internal_frag_pct = 75;
+    profile.alerts = (1u << TaskProfiler::WatchHttpd) | TaskProfiler::AlertInternalBlock;
+    profile.window_count = 1;
+    profile.window[0].ms = 30000;
+    profile.window[0].stack_min = 900;
+    payload.task_profile = &profile;
+
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    ArduinoJson::JsonObject prof = doc["task_profile"];
+    TEST_ASSERT_EQUAL_UINT32(6, prof["samples"].as<uint32_t>());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.0f, prof["core_busy_pct"][0].as<float>());
+    TEST_ASSERT_TRUE(prof["core_busy_pct"][1].isNull());
+    TEST_ASSERT_EQUAL_STRING("lvgl", prof["tasks"][0]["name"].as<const char *>());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 42.5f, prof["tasks"][0]["cpu_pct"].as<float>());
+    TEST_ASSERT_TRUE(prof["tasks"][1]["cpu_pct"].isNull());
+    TEST_ASSERT_EQUAL_INT(-1, prof["tasks"][1]["core"].as<int>());
+    TEST_ASSERT_EQUAL_UINT32(900, prof["stacks"]["httpd"].as<uint32_t>());
+    TEST_ASSERT_TRUE(prof["stacks"]["lvgl"].isNull());
+    TEST_ASSERT_EQUAL_UINT32(75, prof["heap"]["internal_frag_pct"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(2, prof["alerts"].as<ArduinoJson::JsonArray>().size());
+    TEST_ASSERT_EQUAL_STRING("stack:httpd", prof["alerts"][0].as<const char *>());
+    TEST_ASSERT_EQUAL_STRING("internal_block", prof["alerts"][1].as<const char *>());
+    TEST_ASSERT_EQUAL_UINT32(900, prof["window"][0]["stack_min"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_ui_updates() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument empty;
+    WebDiagApiUtils::fillJson(empty.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(empty["ui_updates"].isNull());
+
+    payload.has_ui_updates = true;
+    payload.ui_updates_applied = 1200;
+    payload.ui_updates_skipped = 48000;
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(1200, doc["ui_updates"]["applied"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(48000, doc["ui_updates"]["skipped"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_lvgl_pool() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument empty;
+    WebDiagApiUtils::fillJson(empty.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(empty["lvgl_pool"].isNull());
+
+    payload.has_lvgl_pool = true;
+    payload.lvgl_pool.slab_bytes_internal = 40960;
+    payload.lvgl_pool.slab_bytes_psram = 6144;
+    payload.lvgl_pool.frag_pct = 12;
+    payload.lvgl_pool.heap_live = 9;
+    payload.lvgl_pool.slabs_released = 4;
+    payload.lvgl_pool.classes[2].block_size = 64;
+    payload.lvgl_pool.classes[2].slabs = 6;
+    payload.lvgl_pool.classes[2].used = 170;
+    payload.lvgl_pool.classes[2].free = 22;
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    ArduinoJson::JsonObject pool = doc["lvgl_pool"];
+    TEST_ASSERT_EQUAL_UINT32(40960, pool["slab_bytes_internal"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(12, pool["slab_free_pct"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(9, pool["heap_live"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(4, pool["slabs_released"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(LvglMemPool::kClassCount, pool["classes"].as<ArduinoJson::JsonArray>().size());
+    TEST_ASSERT_EQUAL_UINT32(64, pool["classes"][2]["size"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(170, pool["classes"][2]["used"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_ui_screens() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument empty;
+    WebDiagApiUtils::fillJson(empty.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(empty["ui_screens"].isNull());
+
+    payload.has_ui_screens = true;
+    payload.ui_screens.resident = 2;
+    payload.ui_screens.resident_bytes = 52000;
+    payload.ui_screens.hits = 31;
+    payload.ui_screens.misses = 5;
+    payload.ui_screens.prewarms = 3;
+    payload.ui_screens.build_us_max = 184000;
+    payload.ui_screens.slowest_screen = 12;
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    ArduinoJson::JsonObject screens = doc["ui_screens"];
+    TEST_ASSERT_EQUAL_UINT32(2, screens["resident"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(52000, screens["resident_bytes"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(UiScreenCache::kBudgetBytes, screens["budget_bytes"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(31, screens["hits"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(5, screens["misses"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(3, screens["prewarms"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(184000, screens["build_us_max"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(12, screens["slowest_screen"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_card_cache() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument empty;
+    WebDiagApiUtils::fillJson(empty.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(empty["card_cache"].isNull());
+
+    payload.has_card_cache = true;
+    payload.card_cache.entries = 6;
+    payload.card_cache.bytes = 640000;
+    payload.card_cache.hits = 1200;
+    payload.card_cache.builds = 7;
+    payload.card_cache.frames_cached = 90;
+    payload.card_cache.frames_direct = 3;
+    payload.card_cache.frame_us_cached = 9800;
+    payload.card_cache.frame_us_direct = 23500;
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    ArduinoJson::JsonObject cards = doc["card_cache"];
+    TEST_ASSERT_TRUE(cards["enabled"].as<bool>());
+    TEST_ASSERT_EQUAL_UINT32(6, cards["entries"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(640000, cards["bytes"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(UiCardCache::kBudgetBytes, cards["budget_bytes"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(1200, cards["hits"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(7, cards["builds"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(90, cards["frames_cached"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(3, cards["frames_direct"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(9800, cards["frame_us_cached"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(23500, cards["frame_us_direct"].as<uint32_t>());
+}
+
+void test_web_diag_api_utils_fill_json_reports_font_packs() {
+    WebDiagApiUtils::Payload payload{};
+    ArduinoJson::JsonDocument empty;
+    WebDiagApiUtils::fillJson(empty.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    TEST_ASSERT_TRUE(empty["font_packs"].isNull());
+
+    payload.has_font_packs = true;
+    payload.font_packs[0].path = "/fonts/noto_sans_sc_14.bin";
+    payload.font_packs[0].loaded = true;
+    payload.font_packs[0].glyphs = 512;
+    payload.font_packs[0].cache_bytes = 30000;
+    payload.font_packs[0].glyph_hash = 0x11111111u;
+    payload.font_packs[0].expected_hash = 0x8D07B537u;
+    payload.font_packs[0].stale = true;
+    payload.font_packs[1].path = "/fonts/noto_sans_sc_18.bin";
+    payload.font_packs[1].missing = true;
+    ArduinoJson::JsonDocument doc;
+    WebDiagApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload, nullptr, 0, 0);
+    ArduinoJson::JsonArray packs = doc["font_packs"];
+    TEST_ASSERT_EQUAL_UINT32(2, packs.size());
+    TEST_ASSERT_EQUAL_STRING("/fonts/noto_sans_sc_14.bin", packs[0]["path"].as<const char *>());
+    TEST_ASSERT_TRUE(packs[0]["loaded"].as<bool>());
+    TEST_ASSERT_FALSE(packs[0]["missing"].as<bool>());
+    TEST_ASSERT_EQUAL_UINT32(512, packs[0]["glyphs"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(30000, packs[0]["cache_bytes"].as<uint32_t>());
+    TEST_ASSERT_FALSE(packs[1]["loaded"].as<bool>());
+    TEST_ASSERT_TRUE(packs[1]["missing"].as<bool>());
+    TEST_ASSERT_FALSE(packs[1]["invalid"].as<bool>());
+    TEST_ASSERT_TRUE(packs[0]["stale"].as<bool>());
+    TEST_ASSERT_EQUAL_HEX32(0x11111111u, packs[0]["glyph_hash"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_HEX32(0x8D07B537u, packs[0]["expected_hash"].as<uint32_t>());
+    TEST_ASSERT_FALSE(packs[1]["stale"].as<bool>());
 }
 
 int main(int, char **) {
     UNITY_BEGIN();
     RUN_TEST(test_web_diag_api_utils_access_allowed_accepts_ap_or_sta_connectivity);
     RUN_TEST(test_web_diag_api_utils_fill_json_populates_network_errors_and_stream);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_mqtt_publish_classes);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_i2c_devices);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_sensor_poll_rates);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_sensor_filter_values);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_sensor_fusion_sources);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_sensor_timing);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_storage_writer);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_record_store);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_boot_traces);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_previous_boot);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_task_profile);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_ui_updates);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_lvgl_pool);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_ui_screens);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_card_cache);
+    RUN_TEST(test_web_diag_api_utils_fill_json_reports_font_packs);
     return UNITY_END();
 }
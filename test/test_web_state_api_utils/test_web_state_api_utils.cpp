@@ -112,6 +112,7 @@ void test_web_state_api_utils_fill_json_sets_nulls_when_values_are_unavailable()
     TEST_ASSERT_TRUE(doc["time_epoch_s"].isNull());
     TEST_ASSERT_TRUE(doc["sensors"]["temp"].isNull());
     TEST_ASSERT_TRUE(doc["derived"]["mold"].isNull());
+    TEST_ASSERT_TRUE(doc["samples"]["sen66"].isNull());
     TEST_ASSERT_TRUE(doc["network"]["rssi"].isNull());
     TEST_ASSERT_EQUAL_STRING("idle", doc["ota"]["status"].as<const char *>());
     TEST_ASSERT_TRUE(doc["ota"]["session_id"].isNull());
@@ -125,6 +126,23 @@ void test_web_state_api_utils_fill_json_sets_nulls_when_values_are_unavailable()
     TEST_ASSERT_EQUAL_STRING("Aura-AP", doc["network"]["wifi_ssid"].as<const char *>());
 }
 
+void test_web_state_api_utils_reports_sample_age_and_epoch_per_source() {
+    WebStateApiUtils::Payload payload{};
+    payload.now_us = 9500000;
+    payload.data.stamps[SENSOR_SOURCE_SEN66].ready_us = 8000000;
+    payload.data.stamps[SENSOR_SOURCE_SEN66].epoch = 1767225600;
+    payload.data.stamps[SENSOR_SOURCE_PRESSURE].ready_us = 9250000;
+
+    ArduinoJson::JsonDocument doc;
+    WebStateApiUtils::fillJson(doc.to<ArduinoJson::JsonObject>(), payload);
+
+    TEST_ASSERT_EQUAL_UINT32(1500, doc["samples"]["sen66"]["age_ms"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(1767225600, doc["samples"]["sen66"]["ts"].as<uint32_t>());
+    TEST_ASSERT_EQUAL_UINT32(250, doc["samples"]["pressure"]["age_ms"].as<uint32_t>());
+    TEST_ASSERT_TRUE(doc["samples"]["pressure"]["ts"].isNull());
+    TEST_ASSERT_TRUE(doc["samples"]["hcho"].isNull());
+}
+
 void test_web_state_api_utils_hides_reactive_gas_metrics_during_warmup() {
     WebStateApiUtils::Payload payload{};
     payload.gas_warmup = true;
@@ -180,6 +198,7 @@ int main(int, char **) {
     UNITY_BEGIN();
     RUN_TEST(test_web_state_api_utils_fill_json_populates_sensor_network_and_settings_fields);
     RUN_TEST(test_web_state_api_utils_fill_json_sets_nulls_when_values_are_unavailable);
+    RUN_TEST(test_web_state_api_utils_reports_sample_age_and_epoch_per_source);
     RUN_TEST(test_web_state_api_utils_hides_reactive_gas_metrics_during_warmup);
     RUN_TEST(test_web_state_api_utils_hides_hcho_when_only_raw_sample_exists_from_sfa40_warmup_model);
     RUN_TEST(test_web_state_api_utils_reports_failed_ota_with_device_error_code);